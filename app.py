@@ -5,6 +5,18 @@ import plotly.graph_objects as go
 import plotly.express as px
 from scipy.stats import norm
 import math
+import os
+import sys
+
+# Native grid pricer built with `make python`; falls back to NumPy when absent
+try:
+    import blackscholes_native
+except ImportError:
+    blackscholes_native = None
+
+# Zero-copy reader for column files written by the C++ exporters
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "python"))
+from column_file import open_column_file
 
 # Black-Scholes pricing functions
 def black_scholes_call(S, K, T, r, sigma):
@@ -103,7 +115,7 @@ with col2:
     with col2a:
         spot_range = st.slider("Stock Price Range (%)", -80, 80, (-40, 40))
         vol_range = st.slider("Volatility Range (%)", -70, 200, (-30, 50))
-        grid_size = st.slider("Grid Resolution", 15, 100, 30)
+        grid_size = st.slider("Grid Resolution", 15, 500 if blackscholes_native is not None else 100, 30)
     
     with col2b:
         position = st.selectbox("Position", ["Long", "Short"])
@@ -125,25 +137,21 @@ with col2:
     spot_prices = np.linspace(spot_min, spot_max, grid_size)
     volatilities = np.linspace(vol_min, vol_max, grid_size)
     
-    # Calculate matrices
-    pnl_matrix = np.zeros((len(volatilities), len(spot_prices)))
-    price_matrix = np.zeros((len(volatilities), len(spot_prices)))
+    # Calculate matrices (rows: volatilities, columns: spot prices)
+    if blackscholes_native is not None:
+        price_matrix = blackscholes_native.price_grid(spot_prices, volatilities, K, T, r,
+                                                      is_call=(option_type == "call"))
+    else:
+        spot_grid, vol_grid = np.meshgrid(spot_prices, volatilities)
+        if option_type == "call":
+            price_matrix = black_scholes_call(spot_grid, K, T, r, vol_grid)
+        else:
+            price_matrix = black_scholes_put(spot_grid, K, T, r, vol_grid)
     
-    for i, vol in enumerate(volatilities):
-        for j, spot in enumerate(spot_prices):
-            if option_type == "call":
-                new_price = black_scholes_call(spot, K, T, r, vol)
-            else:
-                new_price = black_scholes_put(spot, K, T, r, vol)
-            
-            price_matrix[i, j] = new_price
-            
-            if position == "Long":
-                pnl = new_price - option_price
-            else:
-                pnl = option_price - new_price
-            
-            pnl_matrix[i, j] = pnl
+    if position == "Long":
+        pnl_matrix = price_matrix - option_price
+    else:
+        pnl_matrix = option_price - price_matrix
     
     # Select data based on heatmap type
     if heatmap_type == "P&L":
@@ -204,16 +212,11 @@ with col2:
     # Add breakeven line if selected and P&L heatmap
     if show_breakeven and heatmap_type in ["P&L", "% P&L"]:
         # Find breakeven points (where P&L ≈ 0)
-        breakeven_spots = []
-        breakeven_vols = []
-        
-        for i, vol in enumerate(volatilities):
-            for j, spot in enumerate(spot_prices):
-                if abs(pnl_matrix[i, j]) < 0.01:  # Close to breakeven
-                    breakeven_spots.append(spot)
-                    breakeven_vols.append(vol * 100)
+        vol_index, spot_index = np.nonzero(np.abs(pnl_matrix) < 0.01)  # Close to breakeven
+        breakeven_spots = spot_prices[spot_index]
+        breakeven_vols = volatilities[vol_index] * 100
         
-        if breakeven_spots:
+        if breakeven_spots.size > 0:
             fig.add_scatter(
                 x=breakeven_spots,
                 y=breakeven_vols,
@@ -346,4 +349,31 @@ with col4:
     fig_vol.add_trace(go.Scatter(x=vol_range_analysis * 100, y=vol_prices, mode='lines', name='Option Price'))
     fig_vol.add_vline(x=sigma * 100, line_dash="dash", line_color="red", annotation_text="Current Vol")
     fig_vol.update_layout(xaxis_title="Volatility (%)", yaxis_title="Option Price ($)")
-    st.plotly_chart(fig_vol, use_container_width=True)
\ No newline at end of file
+    st.plotly_chart(fig_vol, use_container_width=True)
+
+# Priced chains and P&L exported by ColumnExport (memory-mapped, no copy until displayed)
+st.header("Exported Results")
+column_file_path = st.text_input("Column file (.qcol) written by ColumnExport", value="")
+if column_file_path:
+    try:
+        results = open_column_file(column_file_path)
+    except (OSError, ValueError) as error:
+        st.error(f"Cannot open {column_file_path}: {error}")
+    else:
+        st.caption(f"{results.rows:,} rows; columns: {', '.join(results.names)}")
+        preview_rows = min(results.rows, 1000)
+        preview = {}
+        for name in results.names:
+            column = results[name]
+            if column.ndim == 1:
+                preview[name] = column[:preview_rows]
+            else:
+                preview[f"{name} (sum of {column.shape[1]})"] = column[:preview_rows].sum(axis=1)
+        st.dataframe(pd.DataFrame(preview), use_container_width=True)
+        if "strike" in results and "implied_vol" in results:
+            smile = go.Figure()
+            smile_rows = min(results.rows, 50000)
+            smile.add_trace(go.Scattergl(x=results["strike"][:smile_rows],
+                                         y=results["implied_vol"][:smile_rows] * 100, mode='markers'))
+            smile.update_layout(xaxis_title="Strike ($)", yaxis_title="Implied Volatility (%)")
+            st.plotly_chart(smile, use_container_width=True)
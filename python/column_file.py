@@ -0,0 +1,86 @@
+"""Zero-copy reader for column files written by Utils::ColumnFileWriter.
+
+The file is memory-mapped read-only and every column is returned as a NumPy
+array viewing the mapping, so opening a file with millions of rows costs a
+few page-table entries rather than a copy. Columns with more than one value
+per row (for example the scenario x position P&L matrix) are returned with
+shape (rows, width).
+
+    chain = open_column_file("chain.qcol")
+    chain["price"][:10]
+    chain.rows, chain.names
+"""
+
+import mmap
+import struct
+
+import numpy as np
+
+MAGIC = b"QLCOLS01"
+VERSION = 1
+ENDIAN_MARK = 0x01020304
+ALIGNMENT = 64
+
+# ColumnFileHeader and ColumnDescriptor in src/utils/column_file.hpp
+_HEADER = struct.Struct("<8sIIQQQ24x")
+_DESCRIPTOR = struct.Struct("<32sIIQQ8x")
+
+_TYPES = {
+    1: np.dtype("<f8"),
+    2: np.dtype("<u4"),
+    3: np.dtype("u1"),
+    4: np.dtype("<u8"),
+}
+
+
+class ColumnFile:
+    """Mapping of one column file; columns stay valid while the object is alive"""
+
+    def __init__(self, path):
+        with open(path, "rb") as handle:
+            self._map = mmap.mmap(handle.fileno(), 0, access=mmap.ACCESS_READ)
+        size = len(self._map)
+        if size < _HEADER.size:
+            raise ValueError(f"{path}: not a column file")
+
+        magic, version, byte_order, rows, count, file_size = _HEADER.unpack_from(self._map, 0)
+        if magic != MAGIC:
+            raise ValueError(f"{path}: bad magic (not a column file, or the writer did not finish)")
+        if version != VERSION:
+            raise ValueError(f"{path}: unsupported version {version}")
+        if byte_order != ENDIAN_MARK:
+            raise ValueError(f"{path}: written with a different byte order")
+        if file_size != size or _HEADER.size + count * _DESCRIPTOR.size > size:
+            raise ValueError(f"{path}: truncated")
+
+        self.rows = rows
+        self._columns = {}
+        for i in range(count):
+            raw_name, kind, width, offset, nbytes = _DESCRIPTOR.unpack_from(
+                self._map, _HEADER.size + i * _DESCRIPTOR.size)
+            name = raw_name.split(b"\0", 1)[0].decode("utf-8")
+            dtype = _TYPES.get(kind)
+            if dtype is None or width == 0 or offset % ALIGNMENT != 0 or offset + nbytes > size \
+                    or nbytes != rows * width * dtype.itemsize:
+                raise ValueError(f"{path}: bad descriptor for column '{name}'")
+            array = np.frombuffer(self._map, dtype=dtype, count=rows * width, offset=offset)
+            self._columns[name] = array.reshape(rows, width) if width > 1 else array
+
+    @property
+    def names(self):
+        return list(self._columns)
+
+    def __getitem__(self, name):
+        return self._columns[name]
+
+    def __contains__(self, name):
+        return name in self._columns
+
+    def to_dict(self):
+        """All columns by name (still views of the mapping)"""
+        return dict(self._columns)
+
+
+def open_column_file(path):
+    """Map a column file; see ColumnFile"""
+    return ColumnFile(path)
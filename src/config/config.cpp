@@ -1,14 +1,297 @@
 #include "config.hpp"
+#include "../utils/metrics.hpp"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <cmath>
 #include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
 #include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace Config {
 
-ConfigManager::ConfigManager() : logger_("ConfigManager") {
-    setDefaults();
+double ConfigValue::parseNumber(const std::string& value) noexcept {
+    const char* begin = value.c_str();
+    char* end = nullptr;
+    const double number = std::strtod(begin, &end);
+    if (end == begin || *end != '\0') {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return number;
+}
+
+std::string ConfigValue::formatDouble(double value) {
+    // Shortest representation that reads back exactly (std::to_string rounds 1e-12 to 0)
+    for (int precision = 15; precision <= 17; ++precision) {
+        std::ostringstream out;
+        out.precision(precision);
+        out << value;
+        if (precision == 17 || std::strtod(out.str().c_str(), nullptr) == value) {
+            return out.str();
+        }
+    }
+    return std::to_string(value);
+}
+
+ConfigValue::operator int() const {
+    if (!isNumeric() || std::abs(number_value_) > static_cast<double>(std::numeric_limits<int>::max())) {
+        throw std::invalid_argument("Configuration value is not an integer: " + string_value_);
+    }
+    return static_cast<int>(number_value_);
+}
+
+ConfigValue::operator double() const {
+    if (!isNumeric()) {
+        throw std::invalid_argument("Configuration value is not a number: " + string_value_);
+    }
+    return number_value_;
+}
+
+namespace {
+
+template<typename T>
+void read_value(const std::map<std::string, ConfigValue>& values, const char* key, T& field) {
+    auto it = values.find(key);
+    if (it == values.end()) {
+        return;
+    }
+    try {
+        field = static_cast<T>(it->second);
+    } catch (const std::invalid_argument&) {
+        // Keep the default; validateConfiguration() reports values that matter
+    }
+}
+
+// Typed value from its text: boolean, integer, floating point (including 1e-6) or string
+ConfigValue parse_scalar(const std::string& value) {
+    if (value == "true" || value == "false") {
+        return ConfigValue(value == "true");
+    }
+    const ConfigValue parsed(value);
+    if (!parsed.isNumeric()) {
+        return parsed;
+    }
+    const double number = static_cast<double>(parsed);
+    const bool integral = value.find_first_of(".eE") == std::string::npos &&
+                          std::abs(number) <= static_cast<double>(std::numeric_limits<int>::max());
+    return integral ? ConfigValue(static_cast<int>(number)) : ConfigValue(number);
+}
+
+// Binary cache layout: CacheHeader, then per value a CacheEntry, the key and the value bytes
+// (int32, double, one byte for booleans, the text for strings), all in host byte order
+constexpr char CACHE_MAGIC[8] = {'Q', 'L', 'C', 'F', 'G', 'C', '1', '\0'};
+constexpr uint32_t CACHE_VERSION = 2;  // version 1 dropped the section of nested keys
+constexpr uint32_t CACHE_BYTE_ORDER = 0x01020304u;
+
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;        // Written as CACHE_BYTE_ORDER, so a foreign-endian cache is rejected
+    uint64_t source_size;       // Size of the JSON it was built from
+    uint64_t source_hash;       // FNV-1a of that JSON
+    uint64_t payload_size;      // Bytes after the header
+    uint64_t payload_hash;      // FNV-1a of those bytes
+    uint32_t entries;
+    uint32_t reserved;
+};
+
+struct CacheEntry {
+    uint8_t type;               // ValueType
+    uint8_t reserved;
+    uint16_t key_size;
+    uint32_t value_size;
+};
+
+uint64_t fnv1a(const char* data, size_t size) noexcept {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ull;
+    }
+    return hash;
+}
+
+bool cache_enabled() noexcept {
+    const char* setting = std::getenv("QUANTLIB_CONFIG_CACHE");
+    return setting == nullptr || (std::strcmp(setting, "0") != 0 && std::strcmp(setting, "false") != 0);
+}
+
+std::string cache_path(const std::string& file_path) {
+    return file_path + ".cache";
+}
+
+// Read-only mapping of a whole file, unmapped on destruction
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) noexcept {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        struct stat info;
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* mapping = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                data_ = static_cast<const char*>(mapping);
+                size_ = static_cast<size_t>(info.st_size);
+                mtime_ns_ = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+            }
+        }
+        ::close(fd);
+    }
+    
+    ~MappedFile() {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+    }
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    bool valid() const noexcept { return data_ != nullptr; }
+    const char* data() const noexcept { return data_; }
+    size_t size() const noexcept { return size_; }
+    int64_t mtime_ns() const noexcept { return mtime_ns_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    int64_t mtime_ns_ = 0;
+};
+
+// Values of a cache payload, or false if any entry is malformed
+bool decode_cache(const char* cursor, const char* end, uint32_t entries,
+                  std::map<std::string, ConfigValue>& values) {
+    for (uint32_t i = 0; i < entries; ++i) {
+        CacheEntry entry;
+        if (static_cast<size_t>(end - cursor) < sizeof(entry)) {
+            return false;
+        }
+        std::memcpy(&entry, cursor, sizeof(entry));
+        cursor += sizeof(entry);
+        if (static_cast<size_t>(end - cursor) < size_t(entry.key_size) + entry.value_size) {
+            return false;
+        }
+        std::string key(cursor, entry.key_size);
+        const char* value = cursor + entry.key_size;
+        cursor = value + entry.value_size;
+        
+        switch (static_cast<ValueType>(entry.type)) {
+            case ValueType::STRING:
+                values[key] = ConfigValue(std::string(value, entry.value_size));
+                break;
+            case ValueType::INTEGER: {
+                int32_t number;
+                if (entry.value_size != sizeof(number)) {
+                    return false;
+                }
+                std::memcpy(&number, value, sizeof(number));
+                values[key] = ConfigValue(static_cast<int>(number));
+                break;
+            }
+            case ValueType::DOUBLE: {
+                double number;
+                if (entry.value_size != sizeof(number)) {
+                    return false;
+                }
+                std::memcpy(&number, value, sizeof(number));
+                values[key] = ConfigValue(number);
+                break;
+            }
+            case ValueType::BOOLEAN:
+                if (entry.value_size != 1) {
+                    return false;
+                }
+                values[key] = ConfigValue(*value != 0);
+                break;
+            default:
+                return false;
+        }
+    }
+    return cursor == end;
+}
+
+} // namespace
+
+ConfigSnapshot ConfigSnapshot::fromValues(std::map<std::string, ConfigValue> values) {
+    ConfigSnapshot snapshot;
+    
+    read_value(values, "monte_carlo.simulations", snapshot.monte_carlo.simulations);
+    read_value(values, "monte_carlo.steps", snapshot.monte_carlo.steps);
+    read_value(values, "monte_carlo.use_antithetic", snapshot.monte_carlo.antithetic);
+    read_value(values, "monte_carlo.random_seed", snapshot.monte_carlo.seed);
+    read_value(values, "monte_carlo.sampling", snapshot.monte_carlo.sampling);
+    read_value(values, "monte_carlo.qmc_replications", snapshot.monte_carlo.qmc_replications);
+    
+    read_value(values, "implied_vol.tolerance", snapshot.implied_vol.tolerance);
+    read_value(values, "implied_vol.max_iterations", snapshot.implied_vol.max_iterations);
+    read_value(values, "implied_vol.initial_guess", snapshot.implied_vol.initial_guess);
+    
+    read_value(values, "logging.level", snapshot.logging.level);
+    read_value(values, "logging.file", snapshot.logging.file);
+    read_value(values, "logging.console", snapshot.logging.console);
+    read_value(values, "logging.file_output", snapshot.logging.file_output);
+    read_value(values, "logging.max_files", snapshot.logging.max_files);
+    read_value(values, "logging.max_file_size_mb", snapshot.logging.max_file_size_mb);
+    read_value(values, "logging.async", snapshot.logging.async);
+    read_value(values, "logging.async_queue_size", snapshot.logging.async_queue_size);
+    read_value(values, "logging.overflow_policy", snapshot.logging.overflow_policy);
+    read_value(values, "logging.flush_interval_ms", snapshot.logging.flush_interval_ms);
+    
+    read_value(values, "performance.enable_logging", snapshot.performance.enable_logging);
+    read_value(values, "performance.enable_profiling", snapshot.performance.enable_profiling);
+    read_value(values, "performance.hot_path", snapshot.performance.hot_path);
+    
+    read_value(values, "threading.enable_safety", snapshot.threading.enable_safety);
+    read_value(values, "threading.max_threads", snapshot.threading.max_threads);
+    read_value(values, "threading.enable_parallel_mc", snapshot.threading.enable_parallel_mc);
+    read_value(values, "threading.affinity", snapshot.threading.affinity);
+    
+    read_value(values, "memory.enable_profiling", snapshot.memory.enable_profiling);
+    read_value(values, "memory.max_usage_mb", snapshot.memory.max_usage_mb);
+    read_value(values, "memory.sample_interval", snapshot.memory.sample_interval);
+    read_value(values, "memory.sample_bytes", snapshot.memory.sample_bytes);
+    
+    read_value(values, "numerical.tolerance", snapshot.numerical.tolerance);
+    read_value(values, "numerical.max_iterations", snapshot.numerical.max_iterations);
+    
+    read_value(values, "risk.var_confidence_95", snapshot.risk.var_confidence_95);
+    read_value(values, "risk.var_confidence_99", snapshot.risk.var_confidence_99);
+    read_value(values, "risk.enable_stress_testing", snapshot.risk.enable_stress_testing);
+    
+    read_value(values, "pricing_cache.capacity", snapshot.pricing_cache.capacity);
+    read_value(values, "pricing_cache.tolerance", snapshot.pricing_cache.tolerance);
+    
+    read_value(values, "pipeline.batch_size", snapshot.pipeline.batch_size);
+    read_value(values, "pipeline.queue_depth", snapshot.pipeline.queue_depth);
+    read_value(values, "pipeline.workers", snapshot.pipeline.workers);
+    read_value(values, "finite_difference.space_steps", snapshot.finite_difference.space_steps);
+    read_value(values, "finite_difference.time_steps", snapshot.finite_difference.time_steps);
+    read_value(values, "finite_difference.std_devs", snapshot.finite_difference.std_devs);
+    
+    read_value(values, "gpu.enabled", snapshot.gpu.enabled);
+    read_value(values, "gpu.device", snapshot.gpu.device);
+    read_value(values, "gpu.min_batch_rows", snapshot.gpu.min_batch_rows);
+    read_value(values, "gpu.min_paths", snapshot.gpu.min_paths);
+    read_value(values, "gpu.chunk_rows", snapshot.gpu.chunk_rows);
+    read_value(values, "gpu.streams", snapshot.gpu.streams);
+    
+    snapshot.values = std::move(values);
+    return snapshot;
+}
+
+ConfigManager::ConfigManager() : snapshot_(nullptr), logger_("ConfigManager") {
+    std::map<std::string, ConfigValue> values;
+    setDefaults(values);
+    std::lock_guard<std::mutex> lock(mutex_);
+    publish(ConfigSnapshot::fromValues(std::move(values)));
 }
 
 ConfigManager& ConfigManager::getInstance() {
@@ -17,119 +300,184 @@ ConfigManager& ConfigManager::getInstance() {
 }
 
 bool ConfigManager::initialize(const std::string& config_file_path) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    LOG_INFO(logger_, "Initializing configuration system with file: {}", config_file_path);
     
-    logger_.info("Initializing configuration system with file: {}", config_file_path);
+    // Built and validated without holding mutex_, then swapped in
+    FileValues file;
+    ConfigSnapshot candidate = load(config_file_path, file);
+    if (!validateConfiguration(candidate)) {
+        LOG_ERROR(logger_, "Configuration validation failed");
+        return false;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        config_file_path_ = config_file_path;
+        publish(std::move(candidate));
+        if (!file.content.empty() && cache_enabled()) {
+            writeCache(config_file_path, file);
+        }
+    }
+    
+    LOG_INFO(logger_, "Configuration system initialized successfully");
+    printConfiguration(Utils::LogLevel::DEBUG);
     
-    config_file_path_ = config_file_path;
+    return true;
+}
+
+ConfigSnapshot ConfigManager::load(const std::string& file_path, FileValues& file) {
+    std::map<std::string, ConfigValue> values;
     
     // Set defaults first
-    setDefaults();
+    setDefaults(values);
     
-    // Try to load from file
-    if (!config_file_path.empty()) {
-        if (!loadFromFile(config_file_path)) {
-            logger_.warning("Failed to load configuration file: {}, using defaults", config_file_path);
+    // Try the binary cache, then the file itself
+    if (!file_path.empty()) {
+        file.from_cache = cache_enabled() && loadFromCache(file_path, file.values);
+        if (!file.from_cache && !loadFromFile(file_path, file.values, file.content)) {
+            LOG_WARNING(logger_, "Failed to load configuration file: {}, using defaults", file_path);
+        }
+        for (const auto& pair : file.values) {
+            values[pair.first] = pair.second;
         }
     }
     
     // Load environment overrides
-    loadEnvironmentOverrides();
+    loadEnvironmentOverrides(values);
     
-    // Validate configuration
-    if (!validateConfiguration()) {
-        logger_.error("Configuration validation failed");
-        return false;
-    }
-    
-    logger_.info("Configuration system initialized successfully");
-    printConfiguration(Utils::LogLevel::DEBUG);
-    
-    return true;
+    ConfigSnapshot snapshot = ConfigSnapshot::fromValues(std::move(values));
+    snapshot.from_cache = file.from_cache;
+    return snapshot;
+}
+
+void ConfigManager::publish(ConfigSnapshot snapshot) {
+    const ConfigSnapshot* current = snapshot_.load(std::memory_order_relaxed);
+    snapshot.version = current != nullptr ? current->version + 1 : 1;
+    snapshots_.push_back(std::make_unique<const ConfigSnapshot>(std::move(snapshot)));
+    snapshot_.store(snapshots_.back().get(), std::memory_order_release);
+    Utils::Metrics::set_enabled(snapshots_.back()->performance.enable_profiling);
 }
 
-void ConfigManager::setDefaults() {
+void ConfigManager::setDefaults(std::map<std::string, ConfigValue>& values) {
     // Monte Carlo settings
-    config_map_["monte_carlo.simulations"] = ConfigValue(100000);
-    config_map_["monte_carlo.steps"] = ConfigValue(252);
-    config_map_["monte_carlo.use_antithetic"] = ConfigValue(true);
-    config_map_["monte_carlo.random_seed"] = ConfigValue(42);
+    values["monte_carlo.simulations"] = ConfigValue(100000);
+    values["monte_carlo.steps"] = ConfigValue(252);
+    values["monte_carlo.use_antithetic"] = ConfigValue(true);
+    values["monte_carlo.random_seed"] = ConfigValue(42);
+    values["monte_carlo.sampling"] = ConfigValue("PSEUDO_RANDOM");
+    values["monte_carlo.qmc_replications"] = ConfigValue(8);
     
     // Implied volatility settings
-    config_map_["implied_vol.tolerance"] = ConfigValue(1e-6);
-    config_map_["implied_vol.max_iterations"] = ConfigValue(100);
-    config_map_["implied_vol.initial_guess"] = ConfigValue(0.2);
+    values["implied_vol.tolerance"] = ConfigValue(1e-6);
+    values["implied_vol.max_iterations"] = ConfigValue(100);
+    values["implied_vol.initial_guess"] = ConfigValue(0.2);
     
     // Logging settings
-    config_map_["logging.level"] = ConfigValue("INFO");
-    config_map_["logging.file"] = ConfigValue("quantlib.log");
-    config_map_["logging.console"] = ConfigValue(true);
-    config_map_["logging.file_output"] = ConfigValue(true);
-    config_map_["logging.max_files"] = ConfigValue(5);
-    config_map_["logging.max_file_size_mb"] = ConfigValue(10);
+    values["logging.level"] = ConfigValue("INFO");
+    values["logging.file"] = ConfigValue("quantlib.log");
+    values["logging.console"] = ConfigValue(true);
+    values["logging.file_output"] = ConfigValue(true);
+    values["logging.max_files"] = ConfigValue(5);
+    values["logging.max_file_size_mb"] = ConfigValue(10);
+    values["logging.async"] = ConfigValue(false);
+    values["logging.async_queue_size"] = ConfigValue(1024);
+    values["logging.overflow_policy"] = ConfigValue(std::string("DROP"));
+    values["logging.flush_interval_ms"] = ConfigValue(50);
     
     // Performance settings
-    config_map_["performance.enable_logging"] = ConfigValue(true);
-    config_map_["performance.enable_profiling"] = ConfigValue(false);
-    config_map_["performance.profile_memory"] = ConfigValue(false);
+    values["performance.enable_logging"] = ConfigValue(true);
+    values["performance.enable_profiling"] = ConfigValue(false);
+    values["performance.profile_memory"] = ConfigValue(false);
+    values["performance.hot_path"] = ConfigValue(false);
     
     // Threading settings
-    config_map_["threading.enable_safety"] = ConfigValue(true);
-    config_map_["threading.max_threads"] = ConfigValue(static_cast<int>(std::thread::hardware_concurrency()));
-    config_map_["threading.enable_parallel_mc"] = ConfigValue(true);
+    values["threading.enable_safety"] = ConfigValue(true);
+    values["threading.max_threads"] = ConfigValue(static_cast<int>(std::thread::hardware_concurrency()));
+    values["threading.enable_parallel_mc"] = ConfigValue(true);
+    values["threading.affinity"] = ConfigValue("NONE");
     
     // Memory management
-    config_map_["memory.enable_profiling"] = ConfigValue(false);
-    config_map_["memory.max_usage_mb"] = ConfigValue(1024);
-    config_map_["memory.enable_leak_detection"] = ConfigValue(false);
+    values["memory.enable_profiling"] = ConfigValue(false);
+    values["memory.max_usage_mb"] = ConfigValue(1024);
+    values["memory.enable_leak_detection"] = ConfigValue(false);
+    values["memory.sample_interval"] = ConfigValue(1);
+    values["memory.sample_bytes"] = ConfigValue(0);
     
     // Numerical precision
-    config_map_["numerical.tolerance"] = ConfigValue(1e-12);
-    config_map_["numerical.max_iterations"] = ConfigValue(1000);
-    config_map_["numerical.use_high_precision"] = ConfigValue(false);
+    values["numerical.tolerance"] = ConfigValue(1e-12);
+    values["numerical.max_iterations"] = ConfigValue(1000);
+    values["numerical.use_high_precision"] = ConfigValue(false);
+    
+    // Pricing result cache
+    values["pricing_cache.capacity"] = ConfigValue(65536);
+    values["pricing_cache.tolerance"] = ConfigValue(1e-9);
+    
+    // Quote ingestion pipeline
+    values["pipeline.batch_size"] = ConfigValue(4096);
+    values["pipeline.queue_depth"] = ConfigValue(8);
+    values["pipeline.workers"] = ConfigValue(0);
+    
+    // Finite-difference engine grid
+    values["finite_difference.space_steps"] = ConfigValue(400);
+    values["finite_difference.time_steps"] = ConfigValue(200);
+    values["finite_difference.std_devs"] = ConfigValue(5.0);
+    
+    // GPU offload (used by CUDA builds only)
+    values["gpu.enabled"] = ConfigValue(false);
+    values["gpu.device"] = ConfigValue(0);
+    values["gpu.min_batch_rows"] = ConfigValue(65536);
+    values["gpu.min_paths"] = ConfigValue(1048576);
+    values["gpu.chunk_rows"] = ConfigValue(262144);
+    values["gpu.streams"] = ConfigValue(3);
     
     // Risk management
-    config_map_["risk.var_confidence_95"] = ConfigValue(0.95);
-    config_map_["risk.var_confidence_99"] = ConfigValue(0.99);
-    config_map_["risk.enable_stress_testing"] = ConfigValue(true);
+    values["risk.var_confidence_95"] = ConfigValue(0.95);
+    values["risk.var_confidence_99"] = ConfigValue(0.99);
+    values["risk.enable_stress_testing"] = ConfigValue(true);
     
     // Market data
-    config_map_["market.default_risk_free_rate"] = ConfigValue(0.05);
-    config_map_["market.default_dividend_yield"] = ConfigValue(0.0);
-    config_map_["market.default_volatility"] = ConfigValue(0.2);
+    values["market.default_risk_free_rate"] = ConfigValue(0.05);
+    values["market.default_dividend_yield"] = ConfigValue(0.0);
+    values["market.default_volatility"] = ConfigValue(0.2);
     
     // Validation settings
-    config_map_["validation.enable_parameter_checks"] = ConfigValue(true);
-    config_map_["validation.warn_extreme_values"] = ConfigValue(true);
-    config_map_["validation.max_volatility"] = ConfigValue(5.0);
-    config_map_["validation.max_time_to_expiry"] = ConfigValue(30.0);
+    values["validation.enable_parameter_checks"] = ConfigValue(true);
+    values["validation.warn_extreme_values"] = ConfigValue(true);
+    values["validation.max_volatility"] = ConfigValue(5.0);
+    values["validation.max_time_to_expiry"] = ConfigValue(30.0);
 }
 
-bool ConfigManager::loadFromFile(const std::string& file_path) {
+bool ConfigManager::loadFromFile(const std::string& file_path, std::map<std::string, ConfigValue>& values,
+                                 std::string& content) {
     std::ifstream file(file_path);
     if (!file.is_open()) {
-        logger_.error("Cannot open configuration file: {}", file_path);
+        LOG_ERROR(logger_, "Cannot open configuration file: {}", file_path);
         return false;
     }
     
     std::ostringstream buffer;
     buffer << file.rdbuf();
-    std::string content = buffer.str();
+    content = buffer.str();
     
     if (content.empty()) {
-        logger_.warning("Configuration file is empty: {}", file_path);
+        LOG_WARNING(logger_, "Configuration file is empty: {}", file_path);
         return false;
     }
     
-    return parseJsonContent(content);
+    return parseJsonContent(content, values);
 }
 
-bool ConfigManager::parseJsonContent(const std::string& json_content) {
-    // Simple JSON parser for basic key-value pairs
+bool ConfigManager::parseJsonContent(const std::string& json_content,
+                                     std::map<std::string, ConfigValue>& values) {
+    // Simple JSON parser for one key per line; nested objects become dotted keys
     // Note: In production, use a proper JSON library like nlohmann/json
     
     std::istringstream stream(json_content);
     std::string line;
+    size_t parsed = 0;
+    
+    // Names of the objects enclosing the current line; keys are stored as "section.key"
+    std::vector<std::string> sections;
     
     while (std::getline(stream, line)) {
         // Remove whitespace
@@ -140,19 +488,27 @@ bool ConfigManager::parseJsonContent(const std::string& json_content) {
             continue;
         }
         
-        // Skip JSON structural characters
-        if (line == "{" || line == "}" || line == "[" || line == "]") {
+        // Remove trailing comma
+        if (line.back() == ',') {
+            line.pop_back();
+        }
+        
+        // Closing an object leaves its section
+        if (line == "}") {
+            if (!sections.empty()) {
+                sections.pop_back();
+            }
             continue;
         }
         
-        // Remove trailing comma
-        if (!line.empty() && line.back() == ',') {
-            line.pop_back();
+        // Skip other JSON structural characters
+        if (line == "{" || line == "[" || line == "]") {
+            continue;
         }
         
         // Find key-value separator
         size_t colon_pos = line.find(':');
-        if (colon_pos == std::string::npos) {
+        if (colon_pos == std::string::npos || colon_pos == 0 || colon_pos + 1 == line.size()) {
             continue;
         }
         
@@ -160,139 +516,349 @@ bool ConfigManager::parseJsonContent(const std::string& json_content) {
         std::string value = line.substr(colon_pos + 1);
         
         // Remove quotes
-        if (key.front() == '"' && key.back() == '"') {
+        if (key.size() >= 2 && key.front() == '"' && key.back() == '"') {
             key = key.substr(1, key.length() - 2);
         }
-        if (value.front() == '"' && value.back() == '"') {
+        
+        // An object opens a section named after its key
+        if (value == "{") {
+            sections.push_back(key);
+            continue;
+        }
+        if (value == "{}") {
+            continue;
+        }
+        
+        if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
             value = value.substr(1, value.length() - 2);
         }
         
+        std::string path;
+        for (const std::string& section : sections) {
+            path += section;
+            path += '.';
+        }
+        path += key;
+        
         // Determine value type and store
-        if (value == "true" || value == "false") {
-            config_map_[key] = ConfigValue(value == "true");
-        } else if (value.find('.') != std::string::npos) {
-            try {
-                config_map_[key] = ConfigValue(std::stod(value));
-            } catch (...) {
-                config_map_[key] = ConfigValue(value);
+        values[path] = parse_scalar(value);
+        ++parsed;
+    }
+    
+    LOG_INFO(logger_, "Loaded {} configuration values from JSON", parsed);
+    return true;
+}
+
+bool ConfigManager::loadFromCache(const std::string& file_path, std::map<std::string, ConfigValue>& values) {
+    const MappedFile cache(cache_path(file_path));
+    if (!cache.valid() || cache.size() < sizeof(CacheHeader)) {
+        return false;
+    }
+    const MappedFile source(file_path);
+    if (!source.valid() || cache.mtime_ns() < source.mtime_ns()) {
+        return false;
+    }
+    
+    CacheHeader header;
+    std::memcpy(&header, cache.data(), sizeof(header));
+    const char* payload = cache.data() + sizeof(header);
+    const size_t payload_size = cache.size() - sizeof(header);
+    
+    // Cheap checks first; hashing the file also catches edits within the mtime resolution
+    std::map<std::string, ConfigValue> cached;
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != CACHE_VERSION ||
+        header.byte_order != CACHE_BYTE_ORDER || header.source_size != source.size() ||
+        header.payload_size != payload_size || header.payload_hash != fnv1a(payload, payload_size) ||
+        header.source_hash != fnv1a(source.data(), source.size()) ||
+        !decode_cache(payload, payload + payload_size, header.entries, cached)) {
+        LOG_DEBUG(logger_, "Configuration cache for {} is stale or damaged, parsing the file", file_path);
+        return false;
+    }
+    
+    for (auto& pair : cached) {
+        values[pair.first] = std::move(pair.second);
+    }
+    LOG_INFO(logger_, "Loaded {} configuration values from cache", cached.size());
+    return true;
+}
+
+void ConfigManager::writeCache(const std::string& file_path, const FileValues& file) {
+    std::string payload;
+    uint32_t entries = 0;
+    for (const auto& pair : file.values) {
+        const ConfigValue& value = pair.second;
+        if (pair.first.size() > UINT16_MAX || value.getString().size() > UINT32_MAX) {
+            return;
+        }
+        std::string bytes;
+        switch (value.getType()) {
+            case ValueType::INTEGER: {
+                const int32_t number = static_cast<int>(value);
+                bytes.assign(reinterpret_cast<const char*>(&number), sizeof(number));
+                break;
             }
-        } else {
-            try {
-                config_map_[key] = ConfigValue(std::stoi(value));
-            } catch (...) {
-                config_map_[key] = ConfigValue(value);
+            case ValueType::DOUBLE: {
+                const double number = static_cast<double>(value);
+                bytes.assign(reinterpret_cast<const char*>(&number), sizeof(number));
+                break;
             }
+            case ValueType::BOOLEAN:
+                bytes.assign(1, static_cast<bool>(value) ? '\1' : '\0');
+                break;
+            default:
+                bytes = value.getString();
+                break;
         }
+        const CacheEntry entry{static_cast<uint8_t>(value.getType()), 0, static_cast<uint16_t>(pair.first.size()),
+                               static_cast<uint32_t>(bytes.size())};
+        payload.append(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        payload += pair.first;
+        payload += bytes;
+        ++entries;
     }
     
-    logger_.info("Loaded {} configuration values from JSON", config_map_.size());
-    return true;
+    CacheHeader header{};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.byte_order = CACHE_BYTE_ORDER;
+    header.source_size = file.content.size();
+    header.source_hash = fnv1a(file.content.data(), file.content.size());
+    header.payload_size = payload.size();
+    header.payload_hash = fnv1a(payload.data(), payload.size());
+    header.entries = entries;
+    
+    // Renamed into place, so a concurrent reader sees the old cache or the new one
+    const std::string path = cache_path(file_path);
+    const std::string temporary = path + ".tmp" + std::to_string(::getpid());
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+        if (!out) {
+            out.close();
+            std::remove(temporary.c_str());
+            LOG_DEBUG(logger_, "Cannot write configuration cache: {}", path);
+            return;
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        LOG_DEBUG(logger_, "Cannot write configuration cache: {}", path);
+        return;
+    }
+    LOG_DEBUG(logger_, "Configuration cache written: {}", path);
 }
 
-void ConfigManager::loadEnvironmentOverrides() {
+void ConfigManager::loadEnvironmentOverrides(std::map<std::string, ConfigValue>& values) {
     // Check for environment variable overrides
     // Format: QUANTLIB_<KEY_WITH_UNDERSCORES>=value
     
     const char* env_vars[] = {
         "QUANTLIB_MONTE_CARLO_SIMULATIONS",
         "QUANTLIB_MONTE_CARLO_STEPS",
+        "QUANTLIB_MONTE_CARLO_SAMPLING",
         "QUANTLIB_LOGGING_LEVEL",
         "QUANTLIB_LOGGING_FILE",
         "QUANTLIB_THREADING_MAX_THREADS",
+        "QUANTLIB_THREADING_AFFINITY",
         "QUANTLIB_MEMORY_MAX_USAGE_MB",
+        "QUANTLIB_MEMORY_SAMPLE_INTERVAL",
+        "QUANTLIB_PRICING_CACHE_CAPACITY",
+        "QUANTLIB_PERFORMANCE_ENABLE_PROFILING",
+        "QUANTLIB_GPU_ENABLED",
         nullptr
     };
     
     const char* config_keys[] = {
         "monte_carlo.simulations",
         "monte_carlo.steps",
+        "monte_carlo.sampling",
         "logging.level",
         "logging.file",
         "threading.max_threads",
+        "threading.affinity",
         "memory.max_usage_mb",
+        "memory.sample_interval",
+        "pricing_cache.capacity",
+        "performance.enable_profiling",
+        "gpu.enabled",
         nullptr
     };
     
     for (int i = 0; env_vars[i] != nullptr; ++i) {
         const char* env_value = std::getenv(env_vars[i]);
         if (env_value != nullptr) {
-            logger_.info("Environment override: {} = {}", config_keys[i], env_value);
+            LOG_INFO(logger_, "Environment override: {} = {}", config_keys[i], env_value);
             
             // Try to parse as different types
-            std::string value_str(env_value);
-            if (value_str == "true" || value_str == "false") {
-                config_map_[config_keys[i]] = ConfigValue(value_str == "true");
-            } else if (value_str.find('.') != std::string::npos) {
-                try {
-                    config_map_[config_keys[i]] = ConfigValue(std::stod(value_str));
-                } catch (...) {
-                    config_map_[config_keys[i]] = ConfigValue(value_str);
-                }
-            } else {
-                try {
-                    config_map_[config_keys[i]] = ConfigValue(std::stoi(value_str));
-                } catch (...) {
-                    config_map_[config_keys[i]] = ConfigValue(value_str);
-                }
-            }
+            values[config_keys[i]] = parse_scalar(env_value);
         }
     }
 }
 
-bool ConfigManager::validateConfiguration() {
+bool ConfigManager::validateConfiguration(const ConfigSnapshot& snapshot) {
     bool is_valid = true;
     
     // Validate Monte Carlo settings
-    if (getInt("monte_carlo.simulations") <= 0) {
-        logger_.error("Invalid monte_carlo.simulations: must be positive");
+    if (snapshot.monte_carlo.simulations <= 0) {
+        LOG_ERROR(logger_, "Invalid monte_carlo.simulations: must be positive");
+        is_valid = false;
+    }
+    
+    if (snapshot.monte_carlo.steps <= 0) {
+        LOG_ERROR(logger_, "Invalid monte_carlo.steps: must be positive");
+        is_valid = false;
+    }
+    
+    const std::string& sampling = snapshot.monte_carlo.sampling;
+    if (sampling != "PSEUDO_RANDOM" && sampling != "SOBOL") {
+        LOG_ERROR(logger_, "Invalid monte_carlo.sampling: must be PSEUDO_RANDOM or SOBOL");
         is_valid = false;
     }
     
-    if (getInt("monte_carlo.steps") <= 0) {
-        logger_.error("Invalid monte_carlo.steps: must be positive");
+    if (snapshot.monte_carlo.qmc_replications < 2) {
+        LOG_ERROR(logger_, "Invalid monte_carlo.qmc_replications: must be at least 2");
         is_valid = false;
     }
     
     // Validate implied volatility settings
-    if (getDouble("implied_vol.tolerance") <= 0.0) {
-        logger_.error("Invalid implied_vol.tolerance: must be positive");
+    if (!(snapshot.implied_vol.tolerance > 0.0)) {
+        LOG_ERROR(logger_, "Invalid implied_vol.tolerance: must be positive");
         is_valid = false;
     }
     
-    if (getInt("implied_vol.max_iterations") <= 0) {
-        logger_.error("Invalid implied_vol.max_iterations: must be positive");
+    if (snapshot.implied_vol.max_iterations <= 0) {
+        LOG_ERROR(logger_, "Invalid implied_vol.max_iterations: must be positive");
         is_valid = false;
     }
     
     // Validate threading settings
-    int max_threads = getInt("threading.max_threads");
+    int max_threads = snapshot.threading.max_threads;
     if (max_threads <= 0 || max_threads > 1000) {
-        logger_.error("Invalid threading.max_threads: must be between 1 and 1000");
+        LOG_ERROR(logger_, "Invalid threading.max_threads: must be between 1 and 1000");
+        is_valid = false;
+    }
+    const std::string& affinity = snapshot.threading.affinity;
+    if (affinity != "NONE" && affinity != "COMPACT" && affinity != "SCATTER") {
+        LOG_ERROR(logger_, "Invalid threading.affinity: must be NONE, COMPACT, or SCATTER");
         is_valid = false;
     }
     
     // Validate memory settings
-    if (getInt("memory.max_usage_mb") <= 0) {
-        logger_.error("Invalid memory.max_usage_mb: must be positive");
+    if (snapshot.memory.max_usage_mb <= 0) {
+        LOG_ERROR(logger_, "Invalid memory.max_usage_mb: must be positive");
+        is_valid = false;
+    }
+    if (snapshot.memory.sample_interval < 0 || snapshot.memory.sample_bytes < 0) {
+        LOG_ERROR(logger_, "Invalid memory sampling: sample_interval and sample_bytes must be non-negative");
+        is_valid = false;
+    }
+    
+    // Validate risk settings
+    const double var_95 = snapshot.risk.var_confidence_95;
+    const double var_99 = snapshot.risk.var_confidence_99;
+    if (!(var_95 > 0.0 && var_95 < 1.0) || !(var_99 > 0.0 && var_99 < 1.0)) {
+        LOG_ERROR(logger_, "Invalid risk.var_confidence_95/99: must be in (0, 1)");
+        is_valid = false;
+    }
+    
+    // Validate pricing cache settings
+    if (snapshot.pricing_cache.capacity < 0) {
+        LOG_ERROR(logger_, "Invalid pricing_cache.capacity: must be non-negative");
+        is_valid = false;
+    }
+    if (!(snapshot.pricing_cache.tolerance >= 0.0 && snapshot.pricing_cache.tolerance < 1.0)) {
+        LOG_ERROR(logger_, "Invalid pricing_cache.tolerance: must be in [0, 1)");
+        is_valid = false;
+    }
+    
+    // Validate quote pipeline settings
+    if (snapshot.pipeline.batch_size < 1 || snapshot.pipeline.queue_depth < 1) {
+        LOG_ERROR(logger_, "Invalid pipeline.batch_size/queue_depth: must be positive");
+        is_valid = false;
+    }
+    if (snapshot.pipeline.workers < 0) {
+        LOG_ERROR(logger_, "Invalid pipeline.workers: must be non-negative");
+        is_valid = false;
+    }
+    
+    // Validate finite-difference grid
+    if (snapshot.finite_difference.space_steps < 4 || snapshot.finite_difference.time_steps < 2) {
+        LOG_ERROR(logger_, "Invalid finite_difference grid: needs at least 4 space steps and 2 time steps");
+        is_valid = false;
+    }
+    if (!(snapshot.finite_difference.std_devs > 0.0)) {
+        LOG_ERROR(logger_, "Invalid finite_difference.std_devs: must be positive");
+        is_valid = false;
+    }
+    
+    // Validate GPU offload settings
+    if (snapshot.gpu.device < 0 || snapshot.gpu.min_batch_rows < 0 || snapshot.gpu.min_paths < 0) {
+        LOG_ERROR(logger_, "Invalid gpu.device/min_batch_rows/min_paths: must be non-negative");
+        is_valid = false;
+    }
+    if (snapshot.gpu.chunk_rows < 1 || snapshot.gpu.streams < 1 || snapshot.gpu.streams > 16) {
+        LOG_ERROR(logger_, "Invalid gpu.chunk_rows/streams: needs a positive chunk and 1 to 16 streams");
         is_valid = false;
     }
     
     // Validate log level
-    std::string log_level = getString("logging.level");
+    const std::string& log_level = snapshot.logging.level;
     if (log_level != "DEBUG" && log_level != "INFO" && log_level != "WARNING" && 
         log_level != "ERROR" && log_level != "CRITICAL") {
-        logger_.error("Invalid logging.level: must be DEBUG, INFO, WARNING, ERROR, or CRITICAL");
+        LOG_ERROR(logger_, "Invalid logging.level: must be DEBUG, INFO, WARNING, ERROR, or CRITICAL");
+        is_valid = false;
+    }
+    
+    // Validate asynchronous logging settings
+    if (snapshot.logging.async_queue_size <= 0) {
+        LOG_ERROR(logger_, "Invalid logging.async_queue_size: must be positive");
+        is_valid = false;
+    }
+    
+    const std::string& overflow_policy = snapshot.logging.overflow_policy;
+    if (overflow_policy != "DROP" && overflow_policy != "BLOCK") {
+        LOG_ERROR(logger_, "Invalid logging.overflow_policy: must be DROP or BLOCK");
+        is_valid = false;
+    }
+    
+    if (snapshot.logging.flush_interval_ms <= 0) {
+        LOG_ERROR(logger_, "Invalid logging.flush_interval_ms: must be positive");
         is_valid = false;
     }
     
     return is_valid;
 }
 
+void ConfigManager::applyLoggingConfiguration() const {
+    const ConfigSnapshot::Logging& logging = snapshot().logging;
+    Utils::LogLevel level = Utils::LogLevel::INFO;
+    if (logging.level == "DEBUG") {
+        level = Utils::LogLevel::DEBUG;
+    } else if (logging.level == "WARNING") {
+        level = Utils::LogLevel::WARNING;
+    } else if (logging.level == "ERROR") {
+        level = Utils::LogLevel::ERROR;
+    } else if (logging.level == "CRITICAL") {
+        level = Utils::LogLevel::CRITICAL;
+    }
+    
+    Utils::Logger::configure(level, logging.console, logging.file_output, logging.file,
+                             static_cast<size_t>(logging.max_file_size_mb) * 1024 * 1024, logging.max_files);
+    
+    Utils::AsyncLogOptions options;
+    options.queue_capacity = static_cast<size_t>(logging.async_queue_size);
+    options.overflow_policy = logging.overflow_policy == "BLOCK" ? Utils::OverflowPolicy::BLOCK
+                                                                 : Utils::OverflowPolicy::DROP;
+    options.flush_interval_ms = logging.flush_interval_ms;
+    Utils::Logger::set_backend(logging.async ? Utils::LogBackend::ASYNC : Utils::LogBackend::SYNC, options);
+}
+
 std::string ConfigManager::getString(const std::string& key, const std::string& default_value) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    const std::map<std::string, ConfigValue>& values = snapshot().values;
     
-    auto it = config_map_.find(key);
-    if (it != config_map_.end()) {
+    auto it = values.find(key);
+    if (it != values.end()) {
         return it->second.getString();
     }
     
@@ -300,14 +866,14 @@ std::string ConfigManager::getString(const std::string& key, const std::string&
 }
 
 int ConfigManager::getInt(const std::string& key, int default_value) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    const std::map<std::string, ConfigValue>& values = snapshot().values;
     
-    auto it = config_map_.find(key);
-    if (it != config_map_.end()) {
+    auto it = values.find(key);
+    if (it != values.end()) {
         try {
             return static_cast<int>(it->second);
         } catch (...) {
-            logger_.warning("Failed to convert config value '{}' to int, using default", key);
+            LOG_WARNING(logger_, "Failed to convert config value '{}' to int, using default", key);
         }
     }
     
@@ -315,14 +881,14 @@ int ConfigManager::getInt(const std::string& key, int default_value) const {
 }
 
 double ConfigManager::getDouble(const std::string& key, double default_value) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    const std::map<std::string, ConfigValue>& values = snapshot().values;
     
-    auto it = config_map_.find(key);
-    if (it != config_map_.end()) {
+    auto it = values.find(key);
+    if (it != values.end()) {
         try {
             return static_cast<double>(it->second);
         } catch (...) {
-            logger_.warning("Failed to convert config value '{}' to double, using default", key);
+            LOG_WARNING(logger_, "Failed to convert config value '{}' to double, using default", key);
         }
     }
     
@@ -330,46 +896,48 @@ double ConfigManager::getDouble(const std::string& key, double default_value) co
 }
 
 bool ConfigManager::getBool(const std::string& key, bool default_value) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    const std::map<std::string, ConfigValue>& values = snapshot().values;
     
-    auto it = config_map_.find(key);
-    if (it != config_map_.end()) {
-        try {
-            return static_cast<bool>(it->second);
-        } catch (...) {
-            logger_.warning("Failed to convert config value '{}' to bool, using default", key);
-        }
+    auto it = values.find(key);
+    if (it != values.end()) {
+        return static_cast<bool>(it->second);
     }
     
     return default_value;
 }
 
 void ConfigManager::set(const std::string& key, const ConfigValue& value) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    config_map_[key] = value;
-    logger_.debug("Configuration updated: {} = {}", key, value.getString());
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::map<std::string, ConfigValue> values = snapshot().values;
+        values[key] = value;
+        publish(ConfigSnapshot::fromValues(std::move(values)));
+    }
+    LOG_DEBUG(logger_, "Configuration updated: {} = {}", key, value.getString());
 }
 
 bool ConfigManager::hasKey(const std::string& key) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return config_map_.find(key) != config_map_.end();
+    const std::map<std::string, ConfigValue>& values = snapshot().values;
+    return values.find(key) != values.end();
 }
 
 bool ConfigManager::saveToFile(const std::string& file_path) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    std::string output_path = file_path.empty() ? config_file_path_ : file_path;
+    std::string output_path;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        output_path = file_path.empty() ? config_file_path_ : file_path;
+    }
     
     std::ofstream file(output_path);
     if (!file.is_open()) {
-        logger_.error("Cannot open configuration file for writing: {}", output_path);
+        LOG_ERROR(logger_, "Cannot open configuration file for writing: {}", output_path);
         return false;
     }
     
     file << "{\n";
     
     bool first = true;
-    for (const auto& pair : config_map_) {
+    for (const auto& pair : snapshot().values) {
         if (!first) {
             file << ",\n";
         }
@@ -388,37 +956,42 @@ bool ConfigManager::saveToFile(const std::string& file_path) const {
     
     file << "\n}\n";
     
-    logger_.info("Configuration saved to: {}", output_path);
+    LOG_INFO(logger_, "Configuration saved to: {}", output_path);
     return true;
 }
 
 bool ConfigManager::reload() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    logger_.info("Reloading configuration from: {}", config_file_path_);
+    std::string file_path;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        file_path = config_file_path_;
+    }
     
-    // Reset to defaults
-    setDefaults();
+    LOG_INFO(logger_, "Reloading configuration from: {}", file_path);
     
-    // Reload from file
-    if (!config_file_path_.empty()) {
-        loadFromFile(config_file_path_);
+    // Readers keep using the current snapshot until the new one is published
+    FileValues file;
+    ConfigSnapshot candidate = load(file_path, file);
+    if (!validateConfiguration(candidate)) {
+        LOG_ERROR(logger_, "Reloaded configuration is invalid, keeping the current one");
+        return false;
     }
     
-    // Reload environment overrides
-    loadEnvironmentOverrides();
-    
-    // Validate
-    return validateConfiguration();
+    std::lock_guard<std::mutex> lock(mutex_);
+    publish(std::move(candidate));
+    if (!file.content.empty() && cache_enabled()) {
+        writeCache(file_path, file);
+    }
+    return true;
 }
 
 std::vector<std::string> ConfigManager::getAllKeys() const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    const std::map<std::string, ConfigValue>& values = snapshot().values;
     
     std::vector<std::string> keys;
-    keys.reserve(config_map_.size());
+    keys.reserve(values.size());
     
-    for (const auto& pair : config_map_) {
+    for (const auto& pair : values) {
         keys.push_back(pair.first);
     }
     
@@ -426,21 +999,20 @@ std::vector<std::string> ConfigManager::getAllKeys() const {
 }
 
 void ConfigManager::printConfiguration(Utils::LogLevel log_level) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
     if (!Utils::Logger::is_enabled(log_level)) {
         return;
     }
     
-    logger_.info("Current Configuration ({} values):", config_map_.size());
+    const std::map<std::string, ConfigValue>& values = snapshot().values;
+    LOG_INFO(logger_, "Current Configuration ({} values):", values.size());
     
-    for (const auto& pair : config_map_) {
+    for (const auto& pair : values) {
         if (log_level == Utils::LogLevel::DEBUG) {
-            logger_.debug("  {} = {}", pair.first, pair.second.getString());
+            LOG_DEBUG(logger_, "  {} = {}", pair.first, pair.second.getString());
         } else if (log_level == Utils::LogLevel::INFO) {
-            logger_.info("  {} = {}", pair.first, pair.second.getString());
+            LOG_INFO(logger_, "  {} = {}", pair.first, pair.second.getString());
         }
     }
 }
 
-} // namespace Config
\ No newline at end of file
+} // namespace Config
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <fstream>
+#include <thread>
+#include <vector>
 #include "../utils/logger.hpp"
 
 /**
@@ -21,6 +25,7 @@
  * - Environment variable overrides
  * - Configuration validation
  * - Default value management
+ * - Lock-free reads through immutable, pre-parsed snapshots
  */
 
 namespace Config {
@@ -37,27 +42,169 @@ enum class ValueType {
 
 /**
  * @brief Configuration value wrapper
+ * 
+ * The numeric value is parsed once, on construction, so conversions are
+ * plain loads.
  */
 class ConfigValue {
 private:
     std::string string_value_;
+    double number_value_;       ///< Parsed value, NaN if the string is not numeric
     ValueType type_;
     
+    static double parseNumber(const std::string& value) noexcept;
+    static std::string formatDouble(double value);
+
 public:
-    ConfigValue() : type_(ValueType::STRING) {}
-    explicit ConfigValue(const std::string& value) : string_value_(value), type_(ValueType::STRING) {}
-    explicit ConfigValue(int value) : string_value_(std::to_string(value)), type_(ValueType::INTEGER) {}
-    explicit ConfigValue(double value) : string_value_(std::to_string(value)), type_(ValueType::DOUBLE) {}
-    explicit ConfigValue(bool value) : string_value_(value ? "true" : "false"), type_(ValueType::BOOLEAN) {}
+    ConfigValue() : number_value_(parseNumber("")), type_(ValueType::STRING) {}
+    explicit ConfigValue(const std::string& value)
+        : string_value_(value), number_value_(parseNumber(value)), type_(ValueType::STRING) {}
+    explicit ConfigValue(const char* value) : ConfigValue(std::string(value)) {}
+    explicit ConfigValue(int value)
+        : string_value_(std::to_string(value)), number_value_(value), type_(ValueType::INTEGER) {}
+    explicit ConfigValue(double value)
+        : string_value_(formatDouble(value)), number_value_(value), type_(ValueType::DOUBLE) {}
+    explicit ConfigValue(bool value)
+        : string_value_(value ? "true" : "false"), number_value_(value ? 1.0 : 0.0), type_(ValueType::BOOLEAN) {}
     
-    // Conversion operators
+    // Conversion operators (int and double throw std::invalid_argument for non-numeric values)
     operator std::string() const { return string_value_; }
-    operator int() const { return std::stoi(string_value_); }
-    operator double() const { return std::stod(string_value_); }
+    operator int() const;
+    operator double() const;
     operator bool() const { return string_value_ == "true" || string_value_ == "1"; }
     
     ValueType getType() const { return type_; }
     const std::string& getString() const { return string_value_; }
+    bool isNumeric() const { return number_value_ == number_value_; }
+};
+
+/**
+ * @brief Immutable, typed view of the configuration at one point in time
+ * 
+ * ConfigManager builds a new snapshot whenever the configuration changes
+ * and publishes it through an atomic pointer. Readers never lock or parse,
+ * and a reader that keeps a reference sees one consistent configuration
+ * even while a reload runs:
+ * 
+ *     const Config::ConfigSnapshot& config = Config::ConfigManager::getInstance().snapshot();
+ *     solve(config.implied_vol.tolerance, config.implied_vol.max_iterations);
+ * 
+ * Snapshots are freed only when the ConfigManager is destroyed, so such
+ * references stay valid however many updates follow, and snapshot() stays
+ * one acquire load with no reference counting on the pricing path. The
+ * price is one retained snapshot (a few KB) per update, which is why
+ * updates are meant to be rare (initialize, reload, set) rather than a
+ * per-request channel.
+ */
+struct ConfigSnapshot {
+    struct MonteCarlo {
+        int simulations = 100000;
+        int steps = 252;
+        bool antithetic = true;
+        int seed = 42;
+        std::string sampling = "PSEUDO_RANDOM";
+        int qmc_replications = 8;
+    };
+    
+    struct ImpliedVol {
+        double tolerance = 1e-6;
+        int max_iterations = 100;
+        double initial_guess = 0.2;
+    };
+    
+    struct Logging {
+        std::string level = "INFO";
+        std::string file = "quantlib.log";
+        bool console = true;
+        bool file_output = true;
+        int max_files = 5;
+        int max_file_size_mb = 10;
+        bool async = false;
+        int async_queue_size = 1024;
+        std::string overflow_policy = "DROP";
+        int flush_interval_ms = 50;
+    };
+    
+    struct Performance {
+        bool enable_logging = true;
+        bool enable_profiling = false;
+        bool hot_path = false;
+    };
+    
+    struct Threading {
+        bool enable_safety = true;
+        int max_threads = static_cast<int>(std::thread::hardware_concurrency());
+        bool enable_parallel_mc = true;
+        std::string affinity = "NONE";  ///< Worker pinning: NONE, COMPACT or SCATTER
+    };
+    
+    struct Memory {
+        bool enable_profiling = false;
+        int max_usage_mb = 1024;
+        int sample_interval = 1;    ///< Leak-table sampling, every Nth allocation (0 = off)
+        int sample_bytes = 0;       ///< Leak-table sampling, one allocation per N bytes (0 = off)
+    };
+    
+    struct Numerical {
+        double tolerance = 1e-12;
+        int max_iterations = 1000;
+    };
+    
+    struct Risk {
+        double var_confidence_95 = 0.95;    ///< Confidence of the first VaR figure
+        double var_confidence_99 = 0.99;    ///< Confidence of the second VaR figure
+        bool enable_stress_testing = true;  ///< Evaluate the standard stress grid in risk reports
+    };
+    
+    struct PricingCache {
+        int capacity = 65536;       ///< Cached results (0 = cache disabled)
+        double tolerance = 1e-9;    ///< Relative quantization step of the cache key
+    };
+    
+    struct Pipeline {
+        int batch_size = 4096;      ///< Quotes per batch
+        int queue_depth = 8;        ///< Batches queued between two stages
+        int workers = 0;            ///< Pricing threads (0 = threading.max_threads - 2)
+    };
+    
+    struct FiniteDifference {
+        int space_steps = 400;      ///< Log-spot grid intervals
+        int time_steps = 200;       ///< Time steps to expiry
+        double std_devs = 5.0;      ///< Grid half-width beyond the quoted spots, in σ√T
+    };
+    
+    struct Gpu {
+        bool enabled = false;           ///< Offload large batches and simulations (CUDA builds only)
+        int device = 0;                 ///< CUDA device ordinal
+        int min_batch_rows = 65536;     ///< Smaller batches are priced on the CPU
+        int min_paths = 1048576;        ///< Smaller simulations run on the CPU
+        int chunk_rows = 262144;        ///< Rows per stream chunk of a batch
+        int streams = 3;                ///< Streams overlapping copy-in, compute and copy-out
+    };
+    
+    MonteCarlo monte_carlo;
+    ImpliedVol implied_vol;
+    Logging logging;
+    Performance performance;
+    Threading threading;
+    Memory memory;
+    Numerical numerical;
+    Risk risk;
+    PricingCache pricing_cache;
+    Pipeline pipeline;
+    FiniteDifference finite_difference;
+    Gpu gpu;
+    
+    std::map<std::string, ConfigValue> values;  ///< Every key, for the generic getters
+    uint64_t version = 0;                       ///< Incremented on every publish
+    bool from_cache = false;                    ///< File values were read from the binary cache
+    
+    /**
+     * @brief Build the typed fields from key/value pairs
+     * @param values Configuration values (missing or malformed keys keep their defaults)
+     * @return Snapshot with version 0
+     */
+    static ConfigSnapshot fromValues(std::map<std::string, ConfigValue> values);
 };
 
 /**
@@ -69,13 +216,28 @@ public:
  * - Runtime configuration updates
  * - Thread-safe access
  * - Configuration validation
+ * 
+ * Values parsed from a file are also written, once validated, to a binary
+ * cache next to it (`<file>.cache`). Later loads map the cache instead of
+ * parsing the JSON while it is newer than the file and records the file's
+ * size and content hash; set QUANTLIB_CONFIG_CACHE=0 to always parse.
  */
 class ConfigManager {
 private:
-    mutable std::mutex mutex_;
-    std::map<std::string, ConfigValue> config_map_;
+    mutable std::mutex mutex_;                          ///< Serializes writers; readers use snapshot_
+    std::atomic<const ConfigSnapshot*> snapshot_;       ///< Current configuration
+    std::vector<std::unique_ptr<const ConfigSnapshot>> snapshots_;  ///< Every published snapshot
     std::string config_file_path_;
-    Utils::Logger logger_;
+    mutable Utils::Logger logger_;
+    
+    /**
+     * @brief Values read from a configuration file, and where they came from
+     */
+    struct FileValues {
+        std::map<std::string, ConfigValue> values;  ///< Keys set by the file only
+        std::string content;                        ///< JSON text, when it was parsed
+        bool from_cache = false;                    ///< Read from the binary cache instead
+    };
     
     // Private constructor for singleton
     ConfigManager();
@@ -83,32 +245,80 @@ private:
     /**
      * @brief Load configuration from JSON file
      * @param file_path Path to configuration file
+     * @param values Values to update
+     * @param content Receives the file content
      * @return true if successful
      */
-    bool loadFromFile(const std::string& file_path);
+    bool loadFromFile(const std::string& file_path, std::map<std::string, ConfigValue>& values,
+                      std::string& content);
+    
+    /**
+     * @brief Load the values of a configuration file from its binary cache
+     * 
+     * Fails, leaving values untouched, when the cache is missing, older
+     * than the file, built from other content, or damaged.
+     * 
+     * @param file_path Path to configuration file
+     * @param values Values to update
+     * @return true if the cache was used
+     */
+    bool loadFromCache(const std::string& file_path, std::map<std::string, ConfigValue>& values);
+    
+    /**
+     * @brief Write the binary cache of a parsed configuration file
+     * 
+     * Written to a temporary file and renamed into place; failures only
+     * cost the next start its shortcut.
+     * 
+     * @param file_path Path to configuration file
+     * @param file Values parsed from it, with its content
+     */
+    void writeCache(const std::string& file_path, const FileValues& file);
     
     /**
      * @brief Load environment variable overrides
+     * @param values Values to update
      */
-    void loadEnvironmentOverrides();
+    void loadEnvironmentOverrides(std::map<std::string, ConfigValue>& values);
     
     /**
      * @brief Parse JSON configuration string
      * @param json_content JSON content as string
+     * @param values Values to update
      * @return true if successful
      */
-    bool parseJsonContent(const std::string& json_content);
+    bool parseJsonContent(const std::string& json_content, std::map<std::string, ConfigValue>& values);
     
     /**
      * @brief Set default configuration values
+     * @param values Values to reset
      */
-    void setDefaults();
+    void setDefaults(std::map<std::string, ConfigValue>& values);
     
     /**
      * @brief Validate configuration values
+     * @param snapshot Candidate configuration
      * @return true if all values are valid
      */
-    bool validateConfiguration();
+    bool validateConfiguration(const ConfigSnapshot& snapshot);
+    
+    /**
+     * @brief Build the configuration from defaults, a file and the environment
+     * @param file_path Configuration file (empty = none)
+     * @param file Receives the values read from the file
+     * @return Candidate snapshot (not yet published)
+     */
+    ConfigSnapshot load(const std::string& file_path, FileValues& file);
+    
+    /**
+     * @brief Make a snapshot current (caller holds mutex_)
+     * 
+     * Also turns Utils::Metrics recording on or off to follow
+     * performance.enable_profiling.
+     * 
+     * @param snapshot New configuration
+     */
+    void publish(ConfigSnapshot snapshot);
 
 public:
     // Singleton access
@@ -125,6 +335,19 @@ public:
      */
     bool initialize(const std::string& config_file_path = "config.json");
     
+    /**
+     * @brief Current configuration, without locking
+     * 
+     * The reference stays valid for the lifetime of the ConfigManager, since
+     * no published snapshot is freed before it; it does not follow later
+     * updates.
+     * 
+     * @return Latest published snapshot
+     */
+    const ConfigSnapshot& snapshot() const noexcept {
+        return *snapshot_.load(std::memory_order_acquire);
+    }
+    
     /**
      * @brief Get configuration value as string
      * @param key Configuration key
@@ -180,6 +403,11 @@ public:
     
     /**
      * @brief Reload configuration from file
+     * 
+     * Builds and validates a new snapshot, then swaps it in atomically.
+     * Running readers see either the old or the new configuration; an
+     * invalid file leaves the old one in place.
+     * 
      * @return true if successful
      */
     bool reload();
@@ -196,33 +424,76 @@ public:
      */
     void printConfiguration(Utils::LogLevel log_level = Utils::LogLevel::INFO) const;
     
-    // Convenience methods for common configuration values
-    int getMonteCarloSimulations() const { return getInt("monte_carlo.simulations", 100000); }
-    int getMonteCarloSteps() const { return getInt("monte_carlo.steps", 252); }
-    double getImpliedVolTolerance() const { return getDouble("implied_vol.tolerance", 1e-6); }
-    int getImpliedVolMaxIterations() const { return getInt("implied_vol.max_iterations", 100); }
-    bool getEnablePerformanceLogging() const { return getBool("performance.enable_logging", true); }
-    std::string getLogLevel() const { return getString("logging.level", "INFO"); }
-    std::string getLogFile() const { return getString("logging.file", "quantlib.log"); }
-    bool getLogToConsole() const { return getBool("logging.console", true); }
-    bool getLogToFile() const { return getBool("logging.file_output", true); }
-    int getMaxLogFiles() const { return getInt("logging.max_files", 5); }
-    size_t getMaxLogFileSize() const { return static_cast<size_t>(getInt("logging.max_file_size_mb", 10)) * 1024 * 1024; }
+    /**
+     * @brief Apply logging.* settings to the global logger
+     * 
+     * Configures level, outputs and rotation, then selects the SYNC or
+     * ASYNC backend with the configured queue size, overflow policy and
+     * flush interval. Call after initialize().
+     */
+    void applyLoggingConfiguration() const;
+    
+    // Convenience methods for common configuration values (lock-free, read the current snapshot)
+    int getMonteCarloSimulations() const { return snapshot().monte_carlo.simulations; }
+    int getMonteCarloSteps() const { return snapshot().monte_carlo.steps; }
+    bool getMonteCarloAntithetic() const { return snapshot().monte_carlo.antithetic; }
+    int getMonteCarloSeed() const { return snapshot().monte_carlo.seed; }
+    std::string getMonteCarloSampling() const { return snapshot().monte_carlo.sampling; }
+    int getMonteCarloQmcReplications() const { return snapshot().monte_carlo.qmc_replications; }
+    double getImpliedVolTolerance() const { return snapshot().implied_vol.tolerance; }
+    int getImpliedVolMaxIterations() const { return snapshot().implied_vol.max_iterations; }
+    bool getEnablePerformanceLogging() const { return snapshot().performance.enable_logging; }
+    bool getEnableProfiling() const { return snapshot().performance.enable_profiling; }
+    bool getHotPathMode() const { return snapshot().performance.hot_path; }
+    std::string getLogLevel() const { return snapshot().logging.level; }
+    std::string getLogFile() const { return snapshot().logging.file; }
+    bool getLogToConsole() const { return snapshot().logging.console; }
+    bool getLogToFile() const { return snapshot().logging.file_output; }
+    int getMaxLogFiles() const { return snapshot().logging.max_files; }
+    size_t getMaxLogFileSize() const { return static_cast<size_t>(snapshot().logging.max_file_size_mb) * 1024 * 1024; }
+    bool getAsyncLogging() const { return snapshot().logging.async; }
+    int getAsyncLogQueueSize() const { return snapshot().logging.async_queue_size; }
+    std::string getLogOverflowPolicy() const { return snapshot().logging.overflow_policy; }
+    int getLogFlushIntervalMs() const { return snapshot().logging.flush_interval_ms; }
     
     // Thread safety settings
-    bool getEnableThreadSafety() const { return getBool("threading.enable_safety", true); }
-    int getMaxThreads() const { return getInt("threading.max_threads", std::thread::hardware_concurrency()); }
+    bool getEnableThreadSafety() const { return snapshot().threading.enable_safety; }
+    int getMaxThreads() const { return snapshot().threading.max_threads; }
+    bool getEnableParallelMC() const { return snapshot().threading.enable_parallel_mc; }
+    std::string getThreadAffinity() const { return snapshot().threading.affinity; }
     
     // Memory management settings
-    bool getEnableMemoryProfiling() const { return getBool("memory.enable_profiling", false); }
-    size_t getMaxMemoryUsageMB() const { return static_cast<size_t>(getInt("memory.max_usage_mb", 1024)); }
+    bool getEnableMemoryProfiling() const { return snapshot().memory.enable_profiling; }
+    size_t getMaxMemoryUsageMB() const { return static_cast<size_t>(snapshot().memory.max_usage_mb); }
+    size_t getMemorySampleInterval() const { return static_cast<size_t>(snapshot().memory.sample_interval); }
+    size_t getMemorySampleBytes() const { return static_cast<size_t>(snapshot().memory.sample_bytes); }
     
     // Numerical precision settings
-    double getNumericalTolerance() const { return getDouble("numerical.tolerance", 1e-12); }
-    int getMaxIterations() const { return getInt("numerical.max_iterations", 1000); }
+    double getNumericalTolerance() const { return snapshot().numerical.tolerance; }
+    int getMaxIterations() const { return snapshot().numerical.max_iterations; }
+    
+    // Risk settings
+    double getVarConfidence95() const { return snapshot().risk.var_confidence_95; }
+    double getVarConfidence99() const { return snapshot().risk.var_confidence_99; }
+    bool getEnableStressTesting() const { return snapshot().risk.enable_stress_testing; }
+    
+    // Pricing cache settings
+    size_t getPricingCacheCapacity() const { return static_cast<size_t>(snapshot().pricing_cache.capacity); }
+    double getPricingCacheTolerance() const { return snapshot().pricing_cache.tolerance; }
+    
+    // Quote pipeline settings
+    size_t getPipelineBatchSize() const { return static_cast<size_t>(snapshot().pipeline.batch_size); }
+    size_t getPipelineQueueDepth() const { return static_cast<size_t>(snapshot().pipeline.queue_depth); }
+    int getPipelineWorkers() const { return snapshot().pipeline.workers; }
+    
+    // Finite-difference engine settings
+    int getFiniteDifferenceSpaceSteps() const { return snapshot().finite_difference.space_steps; }
+    int getFiniteDifferenceTimeSteps() const { return snapshot().finite_difference.time_steps; }
+    double getFiniteDifferenceStdDevs() const { return snapshot().finite_difference.std_devs; }
+    
+    // GPU offload settings
+    bool getGpuEnabled() const { return snapshot().gpu.enabled; }
+    int getGpuDevice() const { return snapshot().gpu.device; }
 };
 
-// Global configuration instance for convenience
-#define Config ConfigManager::getInstance()
-
 } // namespace Config
\ No newline at end of file
@@ -0,0 +1,600 @@
+#include "models/black_scholes.hpp"
+#include "models/implied_volatility.hpp"
+#include "models/monte_carlo.hpp"
+#include "models/portfolio_engine.hpp"
+#include "models/pricing_kernel.hpp"
+#include "models/vector_math.hpp"
+#include "models/volatility_surface.hpp"
+#include "utils/benchmark.hpp"
+#include "utils/logger.hpp"
+#include "utils/memory_profiler.hpp"
+#include "utils/metrics.hpp"
+#include "utils/thread_pool.hpp"
+#include "config/config.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * @file main.cpp
+ * @brief Command-line pricer and benchmark suite
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * Without --benchmark, prices one call and put from --spot, --strike,
+ * --time, --rate, --vol and --div and prints their Greeks. With
+ * --benchmark, runs the benchmark suite (scalar, fused, hot-path, scalar
+ * and SIMD batch pricing, implied volatility and Monte Carlo) and prints a
+ * table; --benchmark-json writes the results for regression tracking.
+ * --metrics-port and --metrics-file turn on the hot-path metrics and
+ * export them in the Prometheus text format. --startup-probe prints the
+ * cold-start timings of the process; the startup benchmarks run it in
+ * fresh processes.
+ */
+
+namespace {
+
+using namespace BlackScholes;
+
+struct CommandLine {
+    bool benchmark = false;
+    bool help = false;
+    bool startup_probe = false;             ///< Print cold-start timings and exit
+    std::string config_file = "config.json";
+    std::string json_file;                  ///< Empty = no JSON; "-" = stdout
+    std::string filter;                     ///< Run benchmarks whose name contains this
+    std::string metrics_file;               ///< Empty = no metrics file
+    int metrics_port = -1;                  ///< -1 = no metrics endpoint; 0 = any free port
+    Utils::BenchmarkOptions bench;
+    double spot = 100.0;
+    double strike = 100.0;
+    double time = 0.25;
+    double rate = 0.05;
+    double vol = 0.20;
+    double dividend = 0.0;
+};
+
+void print_usage(std::ostream& out) {
+    out << "Usage: black_scholes [options]\n"
+           "\n"
+           "Pricing:\n"
+           "  --spot S  --strike K  --time T  --rate r  --vol sigma  --div q\n"
+           "  --config FILE              Configuration file (default: config.json)\n"
+           "\n"
+           "Benchmarks:\n"
+           "  --benchmark                Run the benchmark suite\n"
+           "  --benchmark-filter=TEXT    Only run benchmarks whose name contains TEXT\n"
+           "  --benchmark-runs=N         Timed runs per benchmark (default: 25)\n"
+           "  --benchmark-warmup=N       Untimed warmup runs (default: 3)\n"
+           "  --benchmark-json=FILE      Write JSON results to FILE (- for stdout)\n"
+           "  --no-counters              Do not read hardware performance counters\n"
+           "  --startup-probe            Print this process's cold-start timings (run by --benchmark)\n"
+           "\n"
+           "Metrics (either option enables recording):\n"
+           "  --metrics-port=N           Serve Prometheus metrics on 127.0.0.1:N while running\n"
+           "  --metrics-file=FILE        Write Prometheus metrics to FILE on exit\n";
+}
+
+// Value of "--name=value", or of "--name value" (advancing i)
+bool option_value(const std::vector<std::string>& args, size_t& i, const std::string& name, std::string& value) {
+    const std::string& arg = args[i];
+    if (arg.compare(0, name.size() + 1, name + "=") == 0) {
+        value = arg.substr(name.size() + 1);
+        return true;
+    }
+    if (arg == name && i + 1 < args.size()) {
+        value = args[++i];
+        return true;
+    }
+    return false;
+}
+
+CommandLine parse(const std::vector<std::string>& args) {
+    CommandLine line;
+    for (size_t i = 0; i < args.size(); ++i) {
+        std::string value;
+        if (args[i] == "--help" || args[i] == "-h") {
+            line.help = true;
+        } else if (args[i] == "--benchmark") {
+            line.benchmark = true;
+        } else if (args[i] == "--startup-probe") {
+            line.startup_probe = true;
+        } else if (args[i] == "--no-counters") {
+            line.bench.hardware_counters = false;
+        } else if (option_value(args, i, "--benchmark-filter", value)) {
+            line.filter = value;
+        } else if (option_value(args, i, "--benchmark-runs", value)) {
+            line.bench.runs = std::stoul(value);
+        } else if (option_value(args, i, "--benchmark-warmup", value)) {
+            line.bench.warmup_runs = std::stoul(value);
+        } else if (option_value(args, i, "--benchmark-json", value)) {
+            line.json_file = value;
+        } else if (option_value(args, i, "--metrics-port", value)) {
+            line.metrics_port = std::stoi(value);
+            if (line.metrics_port < 0 || line.metrics_port > 65535) {
+                throw std::invalid_argument("Invalid metrics port: " + value);
+            }
+        } else if (option_value(args, i, "--metrics-file", value)) {
+            line.metrics_file = value;
+        } else if (option_value(args, i, "--config", value)) {
+            line.config_file = value;
+        } else if (option_value(args, i, "--spot", value)) {
+            line.spot = std::stod(value);
+        } else if (option_value(args, i, "--strike", value)) {
+            line.strike = std::stod(value);
+        } else if (option_value(args, i, "--time", value)) {
+            line.time = std::stod(value);
+        } else if (option_value(args, i, "--rate", value)) {
+            line.rate = std::stod(value);
+        } else if (option_value(args, i, "--vol", value)) {
+            line.vol = std::stod(value);
+        } else if (option_value(args, i, "--div", value)) {
+            line.dividend = std::stod(value);
+        } else {
+            throw std::invalid_argument("Unknown option: " + args[i]);
+        }
+    }
+    return line;
+}
+
+int price(const CommandLine& line) {
+    const Parameters params(line.spot, line.strike, line.time, line.rate, line.vol, line.dividend);
+    std::cout << std::fixed << std::setprecision(6);
+    std::cout << "S=" << params.spot_price << " K=" << params.strike_price << " T=" << params.time_to_expiry
+              << " r=" << params.risk_free_rate << " sigma=" << params.volatility
+              << " q=" << params.dividend_yield << "\n\n";
+    std::cout << std::setw(6) << "" << std::setw(13) << "price" << std::setw(13) << "delta"
+              << std::setw(13) << "gamma" << std::setw(13) << "theta" << std::setw(13) << "vega"
+              << std::setw(13) << "rho" << '\n';
+    for (const bool is_call : {true, false}) {
+        const PricingResult result = OptionPricer::evaluate(params, is_call);
+        if (!result.is_valid) {
+            std::cerr << "Pricing failed: " << result.error_msg << '\n';
+            return 1;
+        }
+        std::cout << std::setw(6) << (is_call ? "call" : "put") << std::setw(13) << result.price
+                  << std::setw(13) << result.greeks.delta << std::setw(13) << result.greeks.gamma
+                  << std::setw(13) << result.greeks.theta << std::setw(13) << result.greeks.vega
+                  << std::setw(13) << result.greeks.rho << '\n';
+    }
+    return 0;
+}
+
+/**
+ * @brief Cold-start timings of this process, for the startup benchmarks
+ *
+ * Prints the nanoseconds taken by the first ConfigManager::initialize()
+ * with logging off, by the first record written to a log file (which opens
+ * the file) and by the first MemoryProfiler use, separated by spaces.
+ */
+int startup_probe(const CommandLine& line) {
+    Utils::Logger::configure(Utils::LogLevel::CRITICAL, false, false);
+    uint64_t start = Utils::monotonic_ns();
+    const bool loaded = Config::ConfigManager::getInstance().initialize(line.config_file);
+    const uint64_t config_ns = Utils::monotonic_ns() - start;
+    
+    const std::string log_file =
+        (std::filesystem::temp_directory_path() / ("startup_probe_" + std::to_string(::getpid()) + ".log")).string();
+    Utils::Logger::configure(Utils::LogLevel::INFO, false, true, log_file);
+    Utils::Logger logger("Startup");
+    start = Utils::monotonic_ns();
+    LOG_INFO(logger, "First record");
+    const uint64_t logger_ns = Utils::monotonic_ns() - start;
+    Utils::Logger::configure(Utils::LogLevel::CRITICAL, false, false);
+    std::remove(log_file.c_str());
+    
+    start = Utils::monotonic_ns();
+    Utils::do_not_optimize(Utils::MemoryProfiler::getInstance().isEnabled());
+    const uint64_t profiler_ns = Utils::monotonic_ns() - start;
+    
+    std::cout << config_ns << ' ' << logger_ns << ' ' << profiler_ns << '\n';
+    return loaded ? 0 : 1;
+}
+
+/**
+ * @brief One fresh process running --startup-probe
+ */
+struct StartupSample {
+    double process_ns = 0.0;    ///< fork() to exit, as seen by the parent
+    double config_ns = 0.0;
+    double logger_ns = 0.0;
+    double profiler_ns = 0.0;
+};
+
+// Fork/exec this binary as a startup probe, with the configuration cache on or off
+bool run_startup_probe(const std::string& config_file, bool cache, StartupSample& sample) {
+    // Everything the child needs is built before fork(), which leaves it only async-signal-safe calls
+    const char* const cache_variable = "QUANTLIB_CONFIG_CACHE=";
+    std::vector<std::string> environment;
+    for (char** entry = environ; *entry != nullptr; ++entry) {
+        if (std::strncmp(*entry, cache_variable, std::strlen(cache_variable)) != 0) {
+            environment.emplace_back(*entry);
+        }
+    }
+    environment.push_back(std::string(cache_variable) + (cache ? "1" : "0"));
+    std::vector<char*> envp;
+    for (std::string& entry : environment) {
+        envp.push_back(&entry[0]);
+    }
+    envp.push_back(nullptr);
+    std::string program = "black_scholes", probe = "--startup-probe", config = "--config", file = config_file;
+    char* const argv[] = {&program[0], &probe[0], &config[0], &file[0], nullptr};
+    
+    int fds[2];
+    if (::pipe(fds) != 0) {
+        return false;
+    }
+    const uint64_t start = Utils::monotonic_ns();
+    const pid_t pid = ::fork();
+    if (pid == 0) {
+        ::dup2(fds[1], STDOUT_FILENO);
+        ::close(fds[0]);
+        ::close(fds[1]);
+        ::execve("/proc/self/exe", argv, envp.data());
+        ::_exit(127);
+    }
+    ::close(fds[1]);
+    if (pid < 0) {
+        ::close(fds[0]);
+        return false;
+    }
+    
+    std::string output;
+    char buffer[256];
+    ssize_t n = 0;
+    while ((n = ::read(fds[0], buffer, sizeof(buffer))) > 0) {
+        output.append(buffer, static_cast<size_t>(n));
+    }
+    ::close(fds[0]);
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    sample.process_ns = static_cast<double>(Utils::monotonic_ns() - start);
+    
+    std::istringstream in(output);
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0 &&
+           static_cast<bool>(in >> sample.config_ns >> sample.logger_ns >> sample.profiler_ns);
+}
+
+/**
+ * @brief Deterministic option chain used by every benchmark
+ *
+ * Spots 80-120 around a strike of 100, expiries 0.1-2 years grouped by
+ * expiry as in a real chain, volatilities 10-50%, alternating call/put.
+ */
+struct BenchmarkData {
+    std::vector<double> spot, strike, expiry, rate, vol, dividend, price;
+    std::vector<uint8_t> is_call;
+    
+    explicit BenchmarkData(size_t n)
+        : spot(n), strike(n, 100.0), expiry(n), rate(n, 0.03), vol(n), dividend(n, 0.01), price(n), is_call(n) {
+        for (size_t i = 0; i < n; ++i) {
+            const double u = static_cast<double>((i * 2654435761u) % 1000) / 1000.0;
+            spot[i] = 80.0 + 40.0 * u;
+            expiry[i] = 0.1 + 0.1 * static_cast<double>((i * 20) / n);
+            vol[i] = 0.1 + 0.4 * static_cast<double>((i * 7919) % 1000) / 1000.0;
+            is_call[i] = static_cast<uint8_t>(i % 2);
+        }
+        BatchInput input{spot.data(), strike.data(), expiry.data(), rate.data(),
+                         vol.data(), dividend.data(), is_call.data(), n};
+        BatchOutput output;
+        output.price = price.data();
+        OptionPricer::price_batch(input, output);
+    }
+    
+    BatchInput batch_input() const {
+        return BatchInput{spot.data(), strike.data(), expiry.data(), rate.data(),
+                          vol.data(), dividend.data(), is_call.data(), spot.size()};
+    }
+};
+
+int benchmark(const CommandLine& line) {
+    constexpr size_t SCALAR_OPTIONS = 4096;
+    constexpr size_t BATCH_OPTIONS = 65536;
+    constexpr size_t MONTE_CARLO_PATHS = 65536;
+    
+    const BenchmarkData data(BATCH_OPTIONS);
+    std::vector<Parameters> params;
+    params.reserve(SCALAR_OPTIONS);
+    for (size_t i = 0; i < SCALAR_OPTIONS; ++i) {
+        params.emplace_back(data.spot[i], data.strike[i], data.expiry[i], data.rate[i], data.vol[i], data.dividend[i]);
+    }
+    std::vector<double> price(BATCH_OPTIONS), delta(BATCH_OPTIONS), gamma(BATCH_OPTIONS),
+        theta(BATCH_OPTIONS), vega(BATCH_OPTIONS), rho(BATCH_OPTIONS), implied_vol(BATCH_OPTIONS);
+    const BatchInput input = data.batch_input();
+    const BatchOutput prices_only{price.data(), nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+    const BatchOutput all_outputs{price.data(), delta.data(), gamma.data(), theta.data(),
+                                  vega.data(), rho.data(), nullptr};
+    
+    Utils::BenchmarkRunner runner(line.bench);
+    const auto wanted = [&](const std::string& name) {
+        return line.filter.empty() || name.find(line.filter) != std::string::npos;
+    };
+    const auto run = [&](const std::string& name, size_t items, const std::function<void()>& body) {
+        if (wanted(name)) {
+            runner.run(name, items, body);
+        }
+    };
+    
+    run("scalar/price_call", SCALAR_OPTIONS, [&]() {
+        for (const Parameters& p : params) {
+            Utils::do_not_optimize(OptionPricer::price_call(p).price);
+        }
+    });
+    run("scalar/evaluate_all", SCALAR_OPTIONS, [&]() {
+        for (size_t i = 0; i < SCALAR_OPTIONS; ++i) {
+            Utils::do_not_optimize(OptionPricer::evaluate(params[i], data.is_call[i] != 0).price);
+        }
+    });
+    run("scalar/quote_all", SCALAR_OPTIONS, [&]() {
+        for (size_t i = 0; i < SCALAR_OPTIONS; ++i) {
+            Utils::do_not_optimize(OptionPricer::quote(data.spot[i], data.strike[i], data.expiry[i], data.rate[i],
+                                                       data.vol[i], data.dividend[i], data.is_call[i] != 0).price);
+        }
+    });
+    
+    // Compile-time kernel specializations against the runtime-dispatched quote() on the same options
+    const bool call_flag = data.is_call[1] != 0;
+    const bool put_flag = data.is_call[0] != 0;
+    const auto kernels = [&](const std::string& outputs_name, auto outputs) {
+        constexpr uint32_t OUTPUTS = decltype(outputs)::value;
+        run("scalar/quote/call/" + outputs_name, SCALAR_OPTIONS, [&]() {
+            for (size_t i = 0; i < SCALAR_OPTIONS; ++i) {
+                Utils::do_not_optimize(OptionPricer::quote(data.spot[i], data.strike[i], data.expiry[i], data.rate[i],
+                                                           data.vol[i], data.dividend[i], call_flag, OUTPUTS).price);
+            }
+        });
+        run("kernel/call/" + outputs_name, SCALAR_OPTIONS, [&]() {
+            for (size_t i = 0; i < SCALAR_OPTIONS; ++i) {
+                Utils::do_not_optimize(Kernel::quote<OptionType::CALL, OUTPUTS>(
+                    data.spot[i], data.strike[i], data.expiry[i], data.rate[i], data.vol[i], data.dividend[i]).price);
+            }
+        });
+        run("scalar/quote/put/" + outputs_name, SCALAR_OPTIONS, [&]() {
+            for (size_t i = 0; i < SCALAR_OPTIONS; ++i) {
+                Utils::do_not_optimize(OptionPricer::quote(data.spot[i], data.strike[i], data.expiry[i], data.rate[i],
+                                                           data.vol[i], data.dividend[i], put_flag, OUTPUTS).price);
+            }
+        });
+        run("kernel/put/" + outputs_name, SCALAR_OPTIONS, [&]() {
+            for (size_t i = 0; i < SCALAR_OPTIONS; ++i) {
+                Utils::do_not_optimize(Kernel::quote<OptionType::PUT, OUTPUTS>(
+                    data.spot[i], data.strike[i], data.expiry[i], data.rate[i], data.vol[i], data.dividend[i]).price);
+            }
+        });
+    };
+    kernels("price", std::integral_constant<uint32_t, OutputFlags::PRICE>{});
+    kernels("price_delta", std::integral_constant<uint32_t, OutputFlags::PRICE_DELTA>{});
+    kernels("all", std::integral_constant<uint32_t, OutputFlags::ALL>{});
+    
+    // The same batch on every instruction set this CPU supports
+    const VectorMath::SimdLevel detected = VectorMath::detect_simd_level();
+    for (const VectorMath::SimdLevel level : {VectorMath::SimdLevel::SCALAR, VectorMath::SimdLevel::NEON,
+                                              VectorMath::SimdLevel::AVX2, VectorMath::SimdLevel::AVX512}) {
+        if (VectorMath::set_simd_level(level) != level) {
+            continue;
+        }
+        const std::string isa = VectorMath::to_string(level);
+        run("batch/price/" + isa, BATCH_OPTIONS, [&]() {
+            OptionPricer::price_batch(input, prices_only);
+            Utils::do_not_optimize(price[0]);
+        });
+        run("batch/all/" + isa, BATCH_OPTIONS, [&]() {
+            OptionPricer::price_batch(input, all_outputs);
+            Utils::do_not_optimize(rho[0]);
+        });
+    }
+    VectorMath::set_simd_level(detected);
+    
+    run("batch/all/parallel", BATCH_OPTIONS, [&]() {
+        OptionPricer::price_batch_parallel(input, all_outputs);
+        Utils::do_not_optimize(rho[0]);
+    });
+    
+    // σ per row from a fitted surface instead of a volatility column
+    std::vector<double> surface_strikes, surface_expiries, smile_vols;
+    for (int k = 0; k <= 32; ++k) {
+        surface_strikes.push_back(60.0 + 2.5 * k);
+    }
+    for (int t = 1; t <= 20; ++t) {
+        surface_expiries.push_back(0.1 * t);
+    }
+    VolatilitySurface surface(surface_strikes, surface_expiries);
+    for (size_t slice = 0; slice < surface_expiries.size(); ++slice) {
+        smile_vols.clear();
+        for (const double K : surface_strikes) {
+            const double m = std::log(K / 100.0);
+            smile_vols.push_back(0.2 + 0.1 * m * m + 0.02 * std::sqrt(surface_expiries[slice]));
+        }
+        surface.fit_slice(slice, surface_strikes.data(), smile_vols.data(), surface_strikes.size());
+    }
+    run("surface/lookup", BATCH_OPTIONS, [&]() {
+        surface.volatility(data.strike.data(), data.expiry.data(), implied_vol.data(), BATCH_OPTIONS);
+        Utils::do_not_optimize(implied_vol[0]);
+    });
+    run("batch/price/surface", BATCH_OPTIONS, [&]() {
+        OptionPricer::price_batch(input, surface, prices_only);
+        Utils::do_not_optimize(price[0]);
+    });
+    
+    run("iv/solve", SCALAR_OPTIONS, [&]() {
+        for (size_t i = 0; i < SCALAR_OPTIONS; ++i) {
+            Utils::do_not_optimize(ImpliedVolatilitySolver::solve(data.price[i], data.spot[i], data.strike[i],
+                                                                  data.expiry[i], data.rate[i], data.dividend[i],
+                                                                  data.is_call[i] != 0).implied_vol);
+        }
+    });
+    IVBatchInput quotes;
+    quotes.market_price = data.price.data();
+    quotes.spot_price = data.spot.data();
+    quotes.strike_price = data.strike.data();
+    quotes.time_to_expiry = data.expiry.data();
+    quotes.risk_free_rate = data.rate.data();
+    quotes.dividend_yield = data.dividend.data();
+    quotes.is_call = data.is_call.data();
+    quotes.count = BATCH_OPTIONS;
+    IVBatchOutput solved;
+    solved.implied_vol = implied_vol.data();
+    run("iv/solve_batch", BATCH_OPTIONS, [&]() {
+        ImpliedVolatilitySolver::solve_batch(quotes, solved);
+        Utils::do_not_optimize(implied_vol[0]);
+    });
+    run("iv/solve_batch_parallel", BATCH_OPTIONS, [&]() {
+        ImpliedVolatilitySolver::solve_batch_parallel(quotes, solved);
+        Utils::do_not_optimize(implied_vol[0]);
+    });
+    
+    // Netted Greeks of a 16-underlying book: full refresh against one underlying's spot tick
+    constexpr size_t BOOK_UNDERLYINGS = 16;
+    std::vector<Position> book;
+    std::vector<std::string> book_underlyings;
+    book.reserve(BATCH_OPTIONS);
+    for (size_t i = 0; i < BATCH_OPTIONS; ++i) {
+        book.emplace_back(Parameters(data.spot[i], data.strike[i], data.expiry[i], data.rate[i], data.vol[i],
+                                     data.dividend[i]), data.is_call[i] != 0, 1.0);
+        book_underlyings.push_back("U" + std::to_string(i % BOOK_UNDERLYINGS));
+    }
+    run("portfolio/build", BATCH_OPTIONS, [&]() {
+        Utils::do_not_optimize(PortfolioEngine(book, book_underlyings).total().delta);
+    });
+    PortfolioEngine portfolio(book, book_underlyings);
+    double tick = 100.0;
+    run("portfolio/spot_tick", BATCH_OPTIONS / BOOK_UNDERLYINGS, [&]() {
+        tick = tick == 100.0 ? 100.5 : 100.0;
+        portfolio.set_spot(0, tick);
+        portfolio.refresh();
+        Utils::do_not_optimize(portfolio.total().delta);
+    });
+    
+    MonteCarloOptions mc;
+    mc.simulations = MONTE_CARLO_PATHS;
+    mc.steps = 1;
+    for (const bool parallel : {false, true}) {
+        mc.parallel = parallel;
+        const MonteCarloEngine engine(mc);
+        run(parallel ? "monte_carlo/european_parallel" : "monte_carlo/european", MONTE_CARLO_PATHS, [&]() {
+            Utils::do_not_optimize(engine.price(params[0], PathContract()).price);
+        });
+    }
+    
+    // Cold start in fresh processes: the configuration parsed from the JSON against mapped from
+    // its binary cache, then the first log file write and first profiler use of the same processes
+    const auto record = [&](const std::string& name, std::vector<double> samples) {
+        if (wanted(name) && !samples.empty()) {
+            runner.record(Utils::BenchmarkResult::from_samples(name, 1, std::move(samples)));
+        }
+    };
+    std::vector<double> logger_ns, profiler_ns;
+    for (const bool cache : {false, true}) {
+        const std::string source = cache ? "cache" : "json";
+        if (!wanted("startup/process_" + source) && !wanted("startup/config_" + source) &&
+            !wanted("startup/logger_first_write") && !wanted("startup/profiler_first_use")) {
+            continue;
+        }
+        // At least one untimed start, so the cached runs find a cache
+        const size_t warmup = std::max<size_t>(line.bench.warmup_runs, 1);
+        std::vector<double> process_ns, config_ns;
+        for (size_t i = 0; i < warmup + line.bench.runs; ++i) {
+            StartupSample sample;
+            if (!run_startup_probe(line.config_file, cache, sample)) {
+                std::cerr << "Startup probe failed for " << line.config_file << '\n';
+                return 1;
+            }
+            if (i >= warmup) {
+                process_ns.push_back(sample.process_ns);
+                config_ns.push_back(sample.config_ns);
+                logger_ns.push_back(sample.logger_ns);
+                profiler_ns.push_back(sample.profiler_ns);
+            }
+        }
+        record("startup/process_" + source, std::move(process_ns));
+        record("startup/config_" + source, std::move(config_ns));
+    }
+    record("startup/logger_first_write", std::move(logger_ns));
+    record("startup/profiler_first_use", std::move(profiler_ns));
+    
+    std::cout << "Benchmarks: " << line.bench.warmup_runs << " warmup + " << line.bench.runs
+              << " timed runs, SIMD " << VectorMath::to_string(detected) << ", "
+              << Utils::ThreadPool::shared().size() + 1 << " threads, hardware counters "
+              << (runner.counters_available() ? "on" : "off") << "\n\n";
+    runner.write_table(std::cout);
+    
+    if (!line.json_file.empty()) {
+        const std::map<std::string, std::string> context = {
+            {"simd", VectorMath::to_string(detected)},
+            {"threads", std::to_string(Utils::ThreadPool::shared().size() + 1)},
+            {"hardware_concurrency", std::to_string(std::thread::hardware_concurrency())},
+            {"hardware_counters", runner.counters_available() ? "true" : "false"},
+            {"compiler", __VERSION__},
+        };
+        if (line.json_file == "-") {
+            runner.write_json(std::cout, context);
+        } else {
+            std::ofstream file(line.json_file);
+            if (!file) {
+                std::cerr << "Cannot write " << line.json_file << '\n';
+                return 1;
+            }
+            runner.write_json(file, context);
+            std::cout << "\nResults written to " << line.json_file << '\n';
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        const CommandLine line = parse(std::vector<std::string>(argv + 1, argv + argc));
+        if (line.help) {
+            print_usage(std::cout);
+            return 0;
+        }
+        if (line.startup_probe) {
+            return startup_probe(line);
+        }
+        
+        // Keep per-call pricing logs out of the output and the timings
+        Utils::Logger::configure(Utils::LogLevel::WARNING, true, false);
+        Config::ConfigManager::getInstance().initialize(line.config_file);
+        
+        std::unique_ptr<Utils::MetricsServer> metrics;
+        if (line.metrics_port >= 0 || !line.metrics_file.empty()) {
+            Utils::Metrics::set_enabled(true);
+        }
+        if (line.metrics_port >= 0) {
+            metrics = std::make_unique<Utils::MetricsServer>(static_cast<uint16_t>(line.metrics_port));
+            std::cerr << "Serving metrics on http://127.0.0.1:" << metrics->port() << "/metrics\n";
+        }
+        
+        const int status = line.benchmark ? benchmark(line) : price(line);
+        if (!line.metrics_file.empty()) {
+            Utils::Metrics::write_prometheus(line.metrics_file);
+        }
+        return status;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n\n";
+        print_usage(std::cerr);
+        return 1;
+    }
+}
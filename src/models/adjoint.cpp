@@ -0,0 +1,46 @@
+#include "adjoint.hpp"
+#include <stdexcept>
+
+namespace BlackScholes {
+namespace AD {
+
+Tape::Tape() : arena_(4 * BLOCK_NODES * sizeof(Node)) {
+    // Adjoints sent to constants land here and are never read
+    record(0.0, CONSTANT, 0.0, CONSTANT);
+}
+
+void Tape::add_block() {
+    if (capacity_ + BLOCK_NODES > UINT32_MAX) {
+        throw std::length_error("AD tape is full");
+    }
+    blocks_.reserve(blocks_.size() + 1);
+    blocks_.push_back(static_cast<Node*>(arena_.allocate(BLOCK_NODES * sizeof(Node), alignof(Node))));
+    capacity_ += BLOCK_NODES;
+}
+
+void Tape::backward(const Real& output) {
+    adjoints_.assign(size_, 0.0);
+    const size_t last = output.node();
+    if (last == CONSTANT || last >= size_) {
+        return;
+    }
+    
+    adjoints_[last] = 1.0;
+    for (size_t i = last; i > CONSTANT; --i) {
+        const double adjoint = adjoints_[i];
+        if (adjoint == 0.0) {
+            continue;
+        }
+        const Node& node = blocks_[i / BLOCK_NODES][i % BLOCK_NODES];
+        adjoints_[node.parent[0]] += node.partial[0] * adjoint;
+        adjoints_[node.parent[1]] += node.partial[1] * adjoint;
+    }
+}
+
+double Tape::adjoint(const Real& x) const noexcept {
+    const size_t node = x.node();
+    return node != CONSTANT && node < adjoints_.size() ? adjoints_[node] : 0.0;
+}
+
+} // namespace AD
+} // namespace BlackScholes
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "black_scholes.hpp"
+#include "../utils/arena.hpp"
+
+/**
+ * @file adjoint.hpp
+ * @brief Tape-based reverse-mode automatic differentiation
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * AD::Real carries a value and the index of the tape node that produced
+ * it. Every arithmetic operation on a Real appends one node holding the
+ * partial derivatives with respect to its (at most two) operands; a
+ * single Tape::backward() sweep from an output then gives the derivative
+ * of that output with respect to every variable on the tape, so a
+ * Monte Carlo path yields delta, vega, rho, theta and the rest for the
+ * cost of a few path evaluations instead of one rerun per Greek.
+ *
+ * Operations with constant operands only are not recorded. Nodes are
+ * kept in fixed-size blocks allocated from the tape's own Utils::Arena:
+ * rewind() drops the nodes recorded since a mark() but keeps the blocks,
+ * so a loop that records and rewinds one path at a time reuses the same
+ * memory for every path. Typical use:
+ *
+ *   AD::TapeScope scope;                       // this thread's tape
+ *   AD::Tape& tape = scope.tape();
+ *   const AD::Real spot = tape.variable(100.0);
+ *   const AD::Real value = ...;                // any expression of spot
+ *   tape.backward(value);
+ *   const double delta = tape.adjoint(spot);
+ *
+ * Tapes are not thread-safe; Tape::local() gives each thread its own.
+ */
+
+namespace BlackScholes {
+namespace AD {
+
+class Real;
+
+/**
+ * @brief Record of the operations on AD::Real values
+ */
+class Tape {
+public:
+    /// Node of constants; it absorbs the adjoints sent to them
+    static constexpr uint32_t CONSTANT = 0;
+    
+    /// Nodes per storage block
+    static constexpr size_t BLOCK_NODES = 4096;
+    
+    /**
+     * @brief One recorded operation
+     */
+    struct Node {
+        double partial[2];      ///< Derivative of the result with respect to each operand
+        uint32_t parent[2];     ///< Operand nodes (CONSTANT if unused)
+    };
+    
+    Tape();
+    
+    Tape(const Tape&) = delete;
+    Tape& operator=(const Tape&) = delete;
+    
+    /**
+     * @brief Get the calling thread's tape
+     * @return Tape owned by the current thread
+     */
+    static Tape& local() {
+        static thread_local Tape tape;
+        return tape;
+    }
+    
+    /**
+     * @brief Record an independent variable
+     * @param value Value of the variable
+     * @return Variable whose adjoint backward() computes
+     */
+    Real variable(double value);
+    
+    /**
+     * @brief Append an operation
+     * @return Index of the new node
+     * @throws std::length_error if the tape holds 2^32 nodes
+     */
+    uint32_t record(double partial_0, uint32_t parent_0, double partial_1, uint32_t parent_1) {
+        if (size_ == capacity_) {
+            add_block();
+        }
+        blocks_[size_ / BLOCK_NODES][size_ % BLOCK_NODES] = Node{{partial_0, partial_1}, {parent_0, parent_1}};
+        return static_cast<uint32_t>(size_++);
+    }
+    
+    /**
+     * @brief Current position, for rewind()
+     * @return Number of nodes recorded
+     */
+    size_t mark() const noexcept { return size_; }
+    
+    /**
+     * @brief Drop the nodes recorded since `marker`, keeping their storage
+     * @param marker Value returned by mark() on this tape
+     */
+    void rewind(size_t marker) noexcept { size_ = marker > 1 ? marker : 1; }
+    
+    /**
+     * @brief Propagate adjoints from an output to every node recorded before it
+     *
+     * Replaces the adjoints of the previous sweep.
+     *
+     * @param output Value to differentiate
+     */
+    void backward(const Real& output);
+    
+    /**
+     * @brief Derivative of the last backward() output with respect to x
+     * @param x Variable or intermediate value on this tape
+     * @return ∂output/∂x (0 for constants and values recorded after the output)
+     */
+    double adjoint(const Real& x) const noexcept;
+    
+    /**
+     * @brief Nodes recorded, including the constant node
+     */
+    size_t size() const noexcept { return size_; }
+    
+    /**
+     * @brief Nodes the retained blocks can hold
+     */
+    size_t capacity() const noexcept { return capacity_; }
+
+private:
+    Utils::Arena arena_;
+    std::vector<Node*> blocks_;
+    std::vector<double> adjoints_;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+    
+    void add_block();
+};
+
+/**
+ * @brief RAII scope over a tape: everything recorded inside is dropped on exit
+ */
+class TapeScope {
+public:
+    /**
+     * @brief Enter a scope
+     * @param tape Tape to use (default: this thread's tape)
+     */
+    explicit TapeScope(Tape& tape = Tape::local()) noexcept : tape_(tape), marker_(tape.mark()) {}
+    
+    ~TapeScope() { tape_.rewind(marker_); }
+    
+    TapeScope(const TapeScope&) = delete;
+    TapeScope& operator=(const TapeScope&) = delete;
+    
+    Tape& tape() noexcept { return tape_; }
+
+private:
+    Tape& tape_;
+    size_t marker_;
+};
+
+/**
+ * @brief Differentiable double recorded on the calling thread's tape
+ *
+ * Converts implicitly from double (as a constant), so expressions mix
+ * Real and double freely.
+ */
+class Real {
+public:
+    Real(double value = 0.0) noexcept : value_(value), node_(Tape::CONSTANT) {}
+    Real(double value, uint32_t node) noexcept : value_(value), node_(node) {}
+    
+    double value() const noexcept { return value_; }
+    uint32_t node() const noexcept { return node_; }
+    
+    Real& operator+=(const Real& other);
+    Real& operator-=(const Real& other);
+    Real& operator*=(const Real& other);
+    Real& operator/=(const Real& other);
+
+private:
+    double value_;
+    uint32_t node_;
+};
+
+/**
+ * @brief Result of an operation with the given partial derivatives
+ *
+ * Not recorded when both operands are constants.
+ */
+inline Real apply(double value, const Real& a, double partial_a, const Real& b = Real(), double partial_b = 0.0) {
+    if (a.node() == Tape::CONSTANT && b.node() == Tape::CONSTANT) {
+        return Real(value);
+    }
+    return Real(value, Tape::local().record(partial_a, a.node(), partial_b, b.node()));
+}
+
+inline Real Tape::variable(double value) {
+    return Real(value, record(0.0, CONSTANT, 0.0, CONSTANT));
+}
+
+inline Real operator+(const Real& a, const Real& b) {
+    return apply(a.value() + b.value(), a, 1.0, b, 1.0);
+}
+
+inline Real operator-(const Real& a, const Real& b) {
+    return apply(a.value() - b.value(), a, 1.0, b, -1.0);
+}
+
+inline Real operator*(const Real& a, const Real& b) {
+    return apply(a.value() * b.value(), a, b.value(), b, a.value());
+}
+
+inline Real operator/(const Real& a, const Real& b) {
+    const double value = a.value() / b.value();
+    return apply(value, a, 1.0 / b.value(), b, -value / b.value());
+}
+
+inline Real operator-(const Real& a) {
+    return apply(-a.value(), a, -1.0);
+}
+
+inline Real& Real::operator+=(const Real& other) { return *this = *this + other; }
+inline Real& Real::operator-=(const Real& other) { return *this = *this - other; }
+inline Real& Real::operator*=(const Real& other) { return *this = *this * other; }
+inline Real& Real::operator/=(const Real& other) { return *this = *this / other; }
+
+// Comparisons look at values only
+inline bool operator<(const Real& a, const Real& b) noexcept { return a.value() < b.value(); }
+inline bool operator>(const Real& a, const Real& b) noexcept { return a.value() > b.value(); }
+inline bool operator<=(const Real& a, const Real& b) noexcept { return a.value() <= b.value(); }
+inline bool operator>=(const Real& a, const Real& b) noexcept { return a.value() >= b.value(); }
+
+inline Real exp(const Real& x) {
+    const double value = std::exp(x.value());
+    return apply(value, x, value);
+}
+
+inline Real log(const Real& x) {
+    return apply(std::log(x.value()), x, 1.0 / x.value());
+}
+
+inline Real sqrt(const Real& x) {
+    const double value = std::sqrt(x.value());
+    return apply(value, x, 0.5 / value);
+}
+
+inline Real normal_cdf(const Real& x) {
+    return apply(MathUtils::normal_cdf(x.value()), x, MathUtils::normal_pdf(x.value()));
+}
+
+// The derivative follows the larger (smaller) operand; ties pick the first
+inline Real max(const Real& a, const Real& b) { return a >= b ? a : b; }
+inline Real min(const Real& a, const Real& b) { return a <= b ? a : b; }
+
+} // namespace AD
+} // namespace BlackScholes
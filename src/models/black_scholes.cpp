@@ -1,12 +1,28 @@
 #include "black_scholes.hpp"
+#include "implied_volatility.hpp"
+#include "pricing_kernel.hpp"
+#include "vector_math.hpp"
+#include "volatility_surface.hpp"
+#include "../utils/metrics.hpp"
+#include "../utils/thread_pool.hpp"
 #include <cmath>
 #include <sstream>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <utility>
 
 namespace BlackScholes {
 
 // Thread-local logger initialization
-thread_local Logger OptionPricer::logger_("BlackScholes::OptionPricer");
+thread_local Utils::Logger OptionPricer::logger_("BlackScholes::OptionPricer");
+
+namespace {
+
+thread_local Utils::Logger parameters_logger("BlackScholes::Parameters");
+
+} // namespace
 
 // Parameters implementation
 Parameters::Parameters(double S, double K, double T, double r, double sigma, double q)
@@ -14,12 +30,14 @@ Parameters::Parameters(double S, double K, double T, double r, double sigma, dou
       risk_free_rate(r), volatility(sigma), dividend_yield(q) {
     
     if (!is_valid()) {
-        logger_.error("Invalid Black-Scholes parameters: {}", validation_error());
+        LOG_ERROR(parameters_logger, "Invalid Black-Scholes parameters: {}", validation_error());
         throw std::invalid_argument(validation_error());
     }
     
-    logger_.debug("Created Black-Scholes parameters: S={}, K={}, T={}, r={}, σ={}, q={}", 
-                  S, K, T, r, sigma, q);
+    if (!OptionPricer::hot_path_enabled()) {
+        LOG_DEBUG(parameters_logger, "Created Black-Scholes parameters: S={}, K={}, T={}, r={}, σ={}, q={}", 
+                      S, K, T, r, sigma, q);
+    }
 }
 
 bool Parameters::is_valid() const noexcept {
@@ -58,140 +76,187 @@ double OptionPricer::calculate_d2(const Parameters& params, double d1) noexcept
     return d1 - params.volatility * std::sqrt(params.time_to_expiry);
 }
 
-PricingResult OptionPricer::price_call(const Parameters& params) {
-    logger_.debug("Pricing call option with S={}, K={}, T={}", 
-                  params.spot_price, params.strike_price, params.time_to_expiry);
-    
+namespace {
+
+// 0/1 after set_hot_path(), -1 to follow performance.hot_path; read on every price_call() so kept lock-free
+std::atomic<int> g_hot_path_override{-1};
+
+// Every (option type, outputs) specialization of Kernel::evaluate(), calls first
+constexpr size_t OUTPUT_MASKS = OutputFlags::ALL + 1;
+
+template <size_t... Masks>
+constexpr std::array<Kernel::EvaluateFn, 2 * OUTPUT_MASKS> make_kernel_table(std::index_sequence<Masks...>) noexcept {
+    return {{&Kernel::evaluate<OptionType::CALL, static_cast<uint32_t>(Masks)>...,
+             &Kernel::evaluate<OptionType::PUT, static_cast<uint32_t>(Masks)>...}};
+}
+
+constexpr std::array<Kernel::EvaluateFn, 2 * OUTPUT_MASKS> KERNELS =
+    make_kernel_table(std::make_index_sequence<OUTPUT_MASKS>{});
+
+/**
+ * Shared kernel behind evaluate() and both quote() overloads, given the
+ * term-structure factors of the expiry. Writes only the requested outputs
+ * and returns false if any of them is not finite.
+ */
+inline bool evaluate_terms(double S, double K, double T, double r, double sigma, double q,
+                           double sqrt_T, double discount_factor, double dividend_factor,
+                           bool is_call, uint32_t outputs, double& price, Greeks& greeks) noexcept {
+    return Kernel::select(is_call, outputs)(S, K, T, r, sigma, q, sqrt_T, discount_factor, dividend_factor,
+                                            price, greeks);
+}
+
+// Single-option kernel: computes the term-structure factors, then evaluates
+bool evaluate_fused(double S, double K, double T, double r, double sigma, double q,
+                    bool is_call, uint32_t outputs, double& price, Greeks& greeks) noexcept {
+    const double sqrt_T = std::sqrt(T);
+    const double dividend_factor = std::exp(-q * T);
+    const double discount_factor = Kernel::needs_N_d2(outputs) ? std::exp(-r * T) : 0.0;
+    return evaluate_terms(S, K, T, r, sigma, q, sqrt_T, discount_factor, dividend_factor,
+                          is_call, outputs, price, greeks);
+}
+
+// Hot-path counters for one call
+inline void count_rows(size_t rows, size_t priced) noexcept {
+    Utils::Metrics::add(Utils::MetricCounter::OPTIONS_PRICED, priced);
+    Utils::Metrics::add(Utils::MetricCounter::OPTIONS_REJECTED, rows - priced);
+}
+
+} // namespace
+
+const char* to_string(OptionType type) noexcept {
+    switch (type) {
+        case OptionType::CALL: return "CALL";
+        case OptionType::PUT:  return "PUT";
+        default:               return "UNKNOWN";
+    }
+}
+
+Kernel::EvaluateFn Kernel::select(bool is_call, uint32_t outputs) noexcept {
+    return KERNELS[(is_call ? 0 : OUTPUT_MASKS) + (outputs & OutputFlags::ALL)];
+}
+
+ExpirySlice::ExpirySlice(double T, double r, double q) noexcept
+    : time_to_expiry(T), risk_free_rate(r), dividend_yield(q),
+      sqrt_T(std::sqrt(T)), discount_factor(std::exp(-r * T)), dividend_factor(std::exp(-q * T)),
+      status(OptionPricer::validate_row(1.0, 1.0, T, r, 1.0, q)) {}
+
+PricingResult OptionPricer::evaluate(const Parameters& params, bool is_call, uint32_t outputs) noexcept {
     PricingResult result;
-    
-    try {
-        const double d1 = calculate_d1(params);
-        const double d2 = calculate_d2(params, d1);
-        
-        const double N_d1 = MathUtils::normal_cdf(d1);
-        const double N_d2 = MathUtils::normal_cdf(d2);
-        
-        const double discount_factor = std::exp(-params.risk_free_rate * params.time_to_expiry);
-        const double dividend_factor = std::exp(-params.dividend_yield * params.time_to_expiry);
-        
-        result.price = params.spot_price * dividend_factor * N_d1 - 
-                      params.strike_price * discount_factor * N_d2;
-        
-        result.greeks = calculate_call_greeks(params);
-        result.is_valid = true;
-        
-        logger_.info("Call option priced successfully: ${:.4f}", result.price);
-        
-    } catch (const std::exception& e) {
-        result.is_valid = false;
-        result.error_msg = e.what();
-        logger_.error("Failed to price call option: {}", e.what());
+    result.is_valid = evaluate_fused(params.spot_price, params.strike_price, params.time_to_expiry,
+                                     params.risk_free_rate, params.volatility, params.dividend_yield,
+                                     is_call, outputs, result.price, result.greeks);
+    count_rows(1, result.is_valid ? 1 : 0);
+    return result;
+}
+
+QuoteResult OptionPricer::quote(double S, double K, double T, double r, double sigma, double q,
+                                bool is_call, uint32_t outputs) noexcept {
+    QuoteResult result;
+    result.status = validate_row(S, K, T, r, sigma, q);
+    
+    if (result.status != BatchStatus::OK) {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        result.price = nan;
+        result.greeks = Greeks(nan, nan, nan, nan, nan);
+        count_rows(1, 0);
+        return result;
     }
     
+    if (!evaluate_fused(S, K, T, r, sigma, q, is_call, outputs, result.price, result.greeks)) {
+        result.status = BatchStatus::NUMERICAL_ERROR;
+    }
+    count_rows(1, result.status == BatchStatus::OK ? 1 : 0);
     return result;
 }
 
-PricingResult OptionPricer::price_put(const Parameters& params) {
-    logger_.debug("Pricing put option with S={}, K={}, T={}", 
-                  params.spot_price, params.strike_price, params.time_to_expiry);
-    
-    PricingResult result;
-    
-    try {
-        const double d1 = calculate_d1(params);
-        const double d2 = calculate_d2(params, d1);
-        
-        const double N_minus_d1 = MathUtils::normal_cdf(-d1);
-        const double N_minus_d2 = MathUtils::normal_cdf(-d2);
-        
-        const double discount_factor = std::exp(-params.risk_free_rate * params.time_to_expiry);
-        const double dividend_factor = std::exp(-params.dividend_yield * params.time_to_expiry);
-        
-        result.price = params.strike_price * discount_factor * N_minus_d2 - 
-                      params.spot_price * dividend_factor * N_minus_d1;
-        
-        result.greeks = calculate_put_greeks(params);
-        result.is_valid = true;
-        
-        logger_.info("Put option priced successfully: ${:.4f}", result.price);
-        
-    } catch (const std::exception& e) {
-        result.is_valid = false;
-        result.error_msg = e.what();
-        logger_.error("Failed to price put option: {}", e.what());
+QuoteResult OptionPricer::quote(const ExpirySlice& slice, double S, double K, double sigma,
+                                bool is_call, uint32_t outputs) noexcept {
+    QuoteResult result;
+    result.status = validate_row(S, K, slice.time_to_expiry, slice.risk_free_rate, sigma,
+                                 slice.dividend_yield);
+    
+    if (result.status != BatchStatus::OK) {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        result.price = nan;
+        result.greeks = Greeks(nan, nan, nan, nan, nan);
+        count_rows(1, 0);
+        return result;
     }
     
+    if (!evaluate_terms(S, K, slice.time_to_expiry, slice.risk_free_rate, sigma, slice.dividend_yield,
+                        slice.sqrt_T, slice.discount_factor, slice.dividend_factor,
+                        is_call, outputs, result.price, result.greeks)) {
+        result.status = BatchStatus::NUMERICAL_ERROR;
+    }
+    count_rows(1, result.status == BatchStatus::OK ? 1 : 0);
     return result;
 }
 
-Greeks OptionPricer::calculate_call_greeks(const Parameters& params) {
-    const double d1 = calculate_d1(params);
-    const double d2 = calculate_d2(params, d1);
-    
-    const double N_d1 = MathUtils::normal_cdf(d1);
-    const double N_d2 = MathUtils::normal_cdf(d2);
-    const double phi_d1 = MathUtils::normal_pdf(d1);
-    
-    const double sqrt_T = std::sqrt(params.time_to_expiry);
-    const double discount_factor = std::exp(-params.risk_free_rate * params.time_to_expiry);
-    const double dividend_factor = std::exp(-params.dividend_yield * params.time_to_expiry);
-    
-    Greeks greeks;
+void OptionPricer::set_hot_path(bool enabled) noexcept {
+    g_hot_path_override.store(enabled ? 1 : 0, std::memory_order_relaxed);
+}
+
+void OptionPricer::reset_hot_path() noexcept {
+    g_hot_path_override.store(-1, std::memory_order_relaxed);
+}
+
+bool OptionPricer::hot_path_enabled() {
+#ifdef BLACKSCHOLES_HOT_PATH
+    return true;
+#else
+    const int state = g_hot_path_override.load(std::memory_order_relaxed);
+    if (state >= 0) {
+        return state != 0;
+    }
+    // One acquire load of the current snapshot, so set() and reload() take effect
+    return Config::ConfigManager::getInstance().snapshot().performance.hot_path;
+#endif
+}
+
+PricingResult OptionPricer::price_call(const Parameters& params) {
+    if (hot_path_enabled()) {
+        return evaluate(params, true, OutputFlags::ALL);
+    }
     
-    // Delta: ∂V/∂S
-    greeks.delta = dividend_factor * N_d1;
+    LOG_DEBUG(logger_, "Pricing call option with S={}, K={}, T={}", 
+                  params.spot_price, params.strike_price, params.time_to_expiry);
     
-    // Gamma: ∂²V/∂S²
-    greeks.gamma = dividend_factor * phi_d1 / (params.spot_price * params.volatility * sqrt_T);
+    PricingResult result = evaluate(params, true, OutputFlags::ALL);
+    if (result.is_valid) {
+        LOG_INFO(logger_, "Call option priced successfully: ${:.4f}", result.price);
+    } else {
+        result.error_msg = "Non-finite call price or Greeks";
+        LOG_ERROR(logger_, "Failed to price call option: {}", result.error_msg);
+    }
     
-    // Theta: ∂V/∂T (per day)
-    const double theta_term1 = -params.spot_price * dividend_factor * phi_d1 * params.volatility / (2 * sqrt_T);
-    const double theta_term2 = params.dividend_yield * params.spot_price * dividend_factor * N_d1;
-    const double theta_term3 = -params.risk_free_rate * params.strike_price * discount_factor * N_d2;
-    greeks.theta = (theta_term1 + theta_term2 + theta_term3) / 365.0;  // Per day
+    return result;
+}
+
+PricingResult OptionPricer::price_put(const Parameters& params) {
+    if (hot_path_enabled()) {
+        return evaluate(params, false, OutputFlags::ALL);
+    }
     
-    // Vega: ∂V/∂σ (per 1%)
-    greeks.vega = params.spot_price * dividend_factor * phi_d1 * sqrt_T / 100.0;
+    LOG_DEBUG(logger_, "Pricing put option with S={}, K={}, T={}", 
+                  params.spot_price, params.strike_price, params.time_to_expiry);
     
-    // Rho: ∂V/∂r (per 1%)
-    greeks.rho = params.strike_price * params.time_to_expiry * discount_factor * N_d2 / 100.0;
+    PricingResult result = evaluate(params, false, OutputFlags::ALL);
+    if (result.is_valid) {
+        LOG_INFO(logger_, "Put option priced successfully: ${:.4f}", result.price);
+    } else {
+        result.error_msg = "Non-finite put price or Greeks";
+        LOG_ERROR(logger_, "Failed to price put option: {}", result.error_msg);
+    }
     
-    return greeks;
+    return result;
+}
+
+Greeks OptionPricer::calculate_call_greeks(const Parameters& params) {
+    return evaluate(params, true, OutputFlags::GREEKS).greeks;
 }
 
 Greeks OptionPricer::calculate_put_greeks(const Parameters& params) {
-    const double d1 = calculate_d1(params);
-    const double d2 = calculate_d2(params, d1);
-    
-    const double N_minus_d1 = MathUtils::normal_cdf(-d1);
-    const double N_minus_d2 = MathUtils::normal_cdf(-d2);
-    const double phi_d1 = MathUtils::normal_pdf(d1);
-    
-    const double sqrt_T = std::sqrt(params.time_to_expiry);
-    const double discount_factor = std::exp(-params.risk_free_rate * params.time_to_expiry);
-    const double dividend_factor = std::exp(-params.dividend_yield * params.time_to_expiry);
-    
-    Greeks greeks;
-    
-    // Delta: ∂V/∂S
-    greeks.delta = -dividend_factor * N_minus_d1;
-    
-    // Gamma: ∂²V/∂S² (same as call)
-    greeks.gamma = dividend_factor * phi_d1 / (params.spot_price * params.volatility * sqrt_T);
-    
-    // Theta: ∂V/∂T (per day)
-    const double theta_term1 = -params.spot_price * dividend_factor * phi_d1 * params.volatility / (2 * sqrt_T);
-    const double theta_term2 = -params.dividend_yield * params.spot_price * dividend_factor * N_minus_d1;
-    const double theta_term3 = params.risk_free_rate * params.strike_price * discount_factor * N_minus_d2;
-    greeks.theta = (theta_term1 + theta_term2 + theta_term3) / 365.0;  // Per day
-    
-    // Vega: ∂V/∂σ (per 1%, same as call)
-    greeks.vega = params.spot_price * dividend_factor * phi_d1 * sqrt_T / 100.0;
-    
-    // Rho: ∂V/∂r (per 1%)
-    greeks.rho = -params.strike_price * params.time_to_expiry * discount_factor * N_minus_d2 / 100.0;
-    
-    return greeks;
+    return evaluate(params, false, OutputFlags::GREEKS).greeks;
 }
 
 double OptionPricer::calculate_implied_volatility(
@@ -201,86 +266,517 @@ double OptionPricer::calculate_implied_volatility(
     int max_iterations,
     double tolerance) {
     
-    // Use config defaults if not specified
-    if (max_iterations == 0) {
-        max_iterations = Config::getInstance().getImpliedVolMaxIterations();
+    // Use config defaults if not specified (one snapshot, so both come from the same configuration)
+    if (max_iterations == 0 || tolerance == 0.0) {
+        const auto& config = Config::ConfigManager::getInstance().snapshot();
+        if (max_iterations == 0) {
+            max_iterations = config.implied_vol.max_iterations;
+        }
+        if (tolerance == 0.0) {
+            tolerance = config.implied_vol.tolerance;
+        }
     }
-    if (tolerance == 0.0) {
-        tolerance = Config::getInstance().getImpliedVolTolerance();
+    
+    LOG_DEBUG(logger_, "Calculating implied volatility for market price ${:.4f}", market_price);
+    
+    IVSolverOptions options;
+    options.max_iterations = max_iterations;
+    options.price_tolerance = tolerance;
+    
+    const IVResult result = ImpliedVolatilitySolver::solve(
+        market_price, params.spot_price, params.strike_price, params.time_to_expiry,
+        params.risk_free_rate, params.dividend_yield, is_call, options);
+    
+    if (result.failure != IVFailure::NONE) {
+        LOG_WARNING(logger_, "Implied volatility failed ({}) after {} iterations",
+                    to_string(result.failure), result.iterations);
+        return std::numeric_limits<double>::quiet_NaN();
     }
     
-    logger_.debug("Calculating implied volatility for market price ${:.4f}", market_price);
+    LOG_DEBUG(logger_, "Implied volatility converged: {:.4f} after {} iterations",
+              result.implied_vol, result.iterations);
+    return result.implied_vol;
+}
+
+uint32_t OptionPricer::validate_row(double S, double K, double T, double r,
+                                   double sigma, double q) noexcept {
+    // Negated comparisons so that NaN inputs are flagged as well
+    uint32_t status = BatchStatus::OK;
+    if (!(S > 0.0)) status |= BatchStatus::INVALID_SPOT;
+    if (!(K > 0.0)) status |= BatchStatus::INVALID_STRIKE;
+    if (!(T > 0.0)) status |= BatchStatus::INVALID_EXPIRY;
+    if (!(r >= 0.0)) status |= BatchStatus::INVALID_RATE;
+    if (!(sigma > 0.0)) status |= BatchStatus::INVALID_VOLATILITY;
+    if (!(q >= 0.0)) status |= BatchStatus::INVALID_DIVIDEND;
+    return status;
+}
+
+namespace {
+
+// Rows per price_batch() block; sized so the scratch columns stay in L1
+constexpr size_t BATCH_BLOCK_SIZE = 64;
+
+// Rows per price_batch_parallel() task; amortizes the scheduling cost
+constexpr size_t PARALLEL_BATCH_GRAIN = 4096;
+
+// Column shifted to start at row `begin` (null stays null)
+template <typename T>
+inline T* offset(T* column, size_t begin) noexcept {
+    return column != nullptr ? column + begin : nullptr;
+}
+
+// Rows [begin, begin + count) of a batch
+BatchInput rows(const BatchInput& input, size_t begin, size_t count) noexcept {
+    BatchInput part;
+    part.spot_price = offset(input.spot_price, begin);
+    part.strike_price = offset(input.strike_price, begin);
+    part.time_to_expiry = offset(input.time_to_expiry, begin);
+    part.risk_free_rate = offset(input.risk_free_rate, begin);
+    part.volatility = offset(input.volatility, begin);
+    part.dividend_yield = offset(input.dividend_yield, begin);
+    part.is_call = offset(input.is_call, begin);
+    part.count = count;
+    return part;
+}
+
+// Output columns starting at row `begin`
+BatchOutput rows(const BatchOutput& output, size_t begin) noexcept {
+    BatchOutput out;
+    out.price = offset(output.price, begin);
+    out.delta = offset(output.delta, begin);
+    out.gamma = offset(output.gamma, begin);
+    out.theta = offset(output.theta, begin);
+    out.vega = offset(output.vega, begin);
+    out.rho = offset(output.rho, begin);
+    out.status = offset(output.status, begin);
+    return out;
+}
+
+// Write a value to an optional output column
+inline void store(double* column, size_t i, double value) noexcept {
+    if (column != nullptr) {
+        column[i] = value;
+    }
+}
+
+void store_invalid_row(const BatchOutput& output, size_t i, uint32_t status) noexcept {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    store(output.price, i, nan);
+    store(output.delta, i, nan);
+    store(output.gamma, i, nan);
+    store(output.theta, i, nan);
+    store(output.vega, i, nan);
+    store(output.rho, i, nan);
+    if (output.status != nullptr) {
+        output.status[i] = status;
+    }
+}
+
+inline bool wants_greeks(const BatchOutput& output) noexcept {
+    return output.delta != nullptr || output.gamma != nullptr || output.theta != nullptr ||
+           output.vega != nullptr || output.rho != nullptr;
+}
+
+// Per-row input columns shared by price_batch() and price_slice()
+struct BlockColumns {
+    const double* spot_price;
+    const double* strike_price;
+    const double* volatility;
+    const uint8_t* is_call;
+};
+
+// Distinct (T, r, q) of one block with their √T, e^{-rT} and e^{-qT}
+struct BlockTerms {
+    double T[BATCH_BLOCK_SIZE];
+    double r[BATCH_BLOCK_SIZE];
+    double q[BATCH_BLOCK_SIZE];
+    double sqrt_T[BATCH_BLOCK_SIZE];
+    double discount_factor[BATCH_BLOCK_SIZE];
+    double dividend_factor[BATCH_BLOCK_SIZE];
+    uint8_t slot[BATCH_BLOCK_SIZE];     // Term slot of each row
+};
+
+// S/K of a row, or a harmless placeholder for an invalid row
+inline double moneyness(const BlockColumns& input, size_t i, uint32_t status) noexcept {
+    return status == BatchStatus::OK ? input.spot_price[i] / input.strike_price[i] : 1.0;
+}
+
+/**
+ * Price rows [base, base + n) from their validation flags, S/K ratios
+ * (replaced by ln(S/K) in place) and term slots. Rows are processed as one
+ * block so each transcendental runs as one VectorMath call over contiguous
+ * stack buffers.
+ */
+template <bool WantGreeks>
+size_t price_block(const BlockColumns& input, size_t base, size_t n, const uint32_t* row_status,
+                   double* log_moneyness, const BlockTerms& terms, const BatchOutput& output) noexcept {
+    double d1[BATCH_BLOCK_SIZE];
+    double N_d1[BATCH_BLOCK_SIZE];
+    double N_d2[BATCH_BLOCK_SIZE];
+    double phi_d1[BATCH_BLOCK_SIZE];
+    
+    VectorMath::log(log_moneyness, log_moneyness, n);
+    
+    // N(±d1), N(±d2) with the sign chosen by option type
+    for (size_t j = 0; j < n; ++j) {
+        const size_t i = base + j;
+        const size_t e = terms.slot[j];
+        const bool valid = row_status[j] == BatchStatus::OK;
+        const double T = valid ? terms.T[e] : 1.0;
+        const double sigma = valid ? input.volatility[i] : 1.0;
+        const double r = valid ? terms.r[e] : 0.0;
+        const double q = valid ? terms.q[e] : 0.0;
+        const double sign = input.is_call[i] != 0 ? 1.0 : -1.0;
+        const double sigma_sqrt_T = sigma * (valid ? terms.sqrt_T[e] : 1.0);
+        
+        d1[j] = (log_moneyness[j] + (r - q + 0.5 * sigma * sigma) * T) / sigma_sqrt_T;
+        N_d1[j] = sign * d1[j];
+        N_d2[j] = sign * (d1[j] - sigma_sqrt_T);
+    }
     
-    // Initial guess
-    double vol = 0.2;
+    VectorMath::normal_cdf(N_d1, N_d1, n);
+    VectorMath::normal_cdf(N_d2, N_d2, n);
+    if constexpr (WantGreeks) {
+        VectorMath::normal_pdf(d1, phi_d1, n);
+    }
     
-    for (int i = 0; i < max_iterations; ++i) {
-        // Create temporary parameters with current volatility guess
-        Parameters temp_params = params;
-        temp_params.volatility = vol;
+    size_t priced = 0;
+    for (size_t j = 0; j < n; ++j) {
+        const size_t i = base + j;
+        if (row_status[j] != BatchStatus::OK) {
+            store_invalid_row(output, i, row_status[j]);
+            continue;
+        }
         
-        // Calculate theoretical price and vega
-        PricingResult result = is_call ? price_call(temp_params) : price_put(temp_params);
+        const size_t e = terms.slot[j];
+        const double S = input.spot_price[i];
+        const double K = input.strike_price[i];
+        const double T = terms.T[e];
+        const double r = terms.r[e];
+        const double sigma = input.volatility[i];
+        const double q = terms.q[e];
+        const double sqrt_T = terms.sqrt_T[e];
+        const double discount_factor = terms.discount_factor[e];
+        const double dividend_factor = terms.dividend_factor[e];
+        const double sign = input.is_call[i] != 0 ? 1.0 : -1.0;
         
-        if (!result.is_valid) {
-            logger_.error("Failed to calculate theoretical price during IV calculation");
-            return std::numeric_limits<double>::quiet_NaN();
+        const double price = sign * (S * dividend_factor * N_d1[j] -
+                                     K * discount_factor * N_d2[j]);
+        if (!std::isfinite(price)) {
+            store_invalid_row(output, i, BatchStatus::NUMERICAL_ERROR);
+            continue;
         }
+        store(output.price, i, price);
         
-        const double price_diff = result.price - market_price;
-        const double vega = result.greeks.vega * 100.0;  // Convert back to per unit
+        if constexpr (WantGreeks) {
+            const double sigma_sqrt_T = sigma * sqrt_T;
+            const double S_dividend_phi = S * dividend_factor * phi_d1[j];
+            
+            store(output.delta, i, sign * dividend_factor * N_d1[j]);
+            store(output.gamma, i, dividend_factor * phi_d1[j] / (S * sigma_sqrt_T));
+            store(output.theta, i, (-S_dividend_phi * sigma / (2.0 * sqrt_T) +
+                                    sign * (q * S * dividend_factor * N_d1[j] -
+                                            r * K * discount_factor * N_d2[j])) / 365.0);
+            store(output.vega, i, S_dividend_phi * sqrt_T / 100.0);
+            store(output.rho, i, sign * K * T * discount_factor * N_d2[j] / 100.0);
+        }
         
-        // Check convergence
-        if (std::abs(price_diff) < tolerance) {
-            logger_.info("Implied volatility converged: {:.4f} after {} iterations", vol, i + 1);
-            return vol;
+        if (output.status != nullptr) {
+            output.status[i] = BatchStatus::OK;
         }
+        ++priced;
+    }
+    return priced;
+}
+
+// Greeks columns are chosen once per block, so the price-only loop carries no Greek code
+inline size_t price_block(const BlockColumns& input, size_t base, size_t n, const uint32_t* row_status,
+                          double* log_moneyness, const BlockTerms& terms, const BatchOutput& output,
+                          bool want_greeks) noexcept {
+    return want_greeks ? price_block<true>(input, base, n, row_status, log_moneyness, terms, output)
+                       : price_block<false>(input, base, n, row_status, log_moneyness, terms, output);
+}
+
+// Every row of a slice shares term slot 0
+void slice_terms(const ExpirySlice& slice, BlockTerms& terms) noexcept {
+    terms.T[0] = slice.time_to_expiry;
+    terms.r[0] = slice.risk_free_rate;
+    terms.q[0] = slice.dividend_yield;
+    terms.sqrt_T[0] = slice.sqrt_T;
+    terms.discount_factor[0] = slice.discount_factor;
+    terms.dividend_factor[0] = slice.dividend_factor;
+    std::fill(terms.slot, terms.slot + BATCH_BLOCK_SIZE, uint8_t(0));
+}
+
+// Price grid rows [first, last); strike, volatility and option type are broadcast per block
+size_t price_grid_rows(const ExpirySlice& slice, const GridInput& input, const BatchOutput& output,
+                       size_t first, size_t last) noexcept {
+    const bool want_greeks = wants_greeks(output);
+    BlockTerms terms;
+    slice_terms(slice, terms);
+    double strike[BATCH_BLOCK_SIZE];
+    double volatility[BATCH_BLOCK_SIZE];
+    uint8_t is_call[BATCH_BLOCK_SIZE];
+    uint32_t row_status[BATCH_BLOCK_SIZE];
+    double log_moneyness[BATCH_BLOCK_SIZE];
+    std::fill(strike, strike + BATCH_BLOCK_SIZE, input.strike_price);
+    std::fill(is_call, is_call + BATCH_BLOCK_SIZE, static_cast<uint8_t>(input.is_call ? 1 : 0));
+    
+    size_t priced = 0;
+    for (size_t v = first; v < last; ++v) {
+        std::fill(volatility, volatility + BATCH_BLOCK_SIZE, input.volatility[v]);
+        for (size_t base = 0; base < input.spot_count; base += BATCH_BLOCK_SIZE) {
+            const size_t n = std::min(BATCH_BLOCK_SIZE, input.spot_count - base);
+            const BlockColumns columns{input.spot_price + base, strike, volatility, is_call};
+            for (size_t j = 0; j < n; ++j) {
+                row_status[j] = OptionPricer::validate_row(columns.spot_price[j], input.strike_price,
+                                                           slice.time_to_expiry, slice.risk_free_rate,
+                                                           input.volatility[v], slice.dividend_yield);
+                log_moneyness[j] = moneyness(columns, j, row_status[j]);
+            }
+            
+            const size_t cell = v * input.spot_count + base;
+            priced += price_block(columns, 0, n, row_status, log_moneyness, terms, rows(output, cell), want_greeks);
+        }
+    }
+    return priced;
+}
+
+// One price_batch() call without the metrics
+size_t price_rows(const BatchInput& input, const BatchOutput& output) noexcept {
+    const bool missing_input = input.spot_price == nullptr || input.strike_price == nullptr ||
+                               input.time_to_expiry == nullptr || input.risk_free_rate == nullptr ||
+                               input.volatility == nullptr || input.is_call == nullptr;
+    if (missing_input) {
+        for (size_t i = 0; i < input.count; ++i) {
+            store_invalid_row(output, i, BatchStatus::MISSING_INPUT);
+        }
+        return 0;
+    }
+    
+    const BlockColumns columns{input.spot_price, input.strike_price, input.volatility, input.is_call};
+    const bool want_greeks = wants_greeks(output);
+    size_t priced = 0;
+    
+    BlockTerms terms;
+    uint32_t row_status[BATCH_BLOCK_SIZE];
+    double log_moneyness[BATCH_BLOCK_SIZE];
+    
+    for (size_t base = 0; base < input.count; base += BATCH_BLOCK_SIZE) {
+        const size_t n = std::min(BATCH_BLOCK_SIZE, input.count - base);
         
-        // Check for zero vega
-        if (std::abs(vega) < 1e-10) {
-            logger_.warning("Zero vega encountered in IV calculation");
-            break;
+        // Group runs of rows with equal (T, r, q); each run gets one term slot
+        size_t expiries = 0;
+        for (size_t j = 0; j < n; ++j) {
+            const size_t i = base + j;
+            const double T = input.time_to_expiry[i];
+            const double r = input.risk_free_rate[i];
+            const double q = input.dividend_yield != nullptr ? input.dividend_yield[i] : 0.0;
+            
+            row_status[j] = OptionPricer::validate_row(input.spot_price[i], input.strike_price[i], T, r,
+                                         input.volatility[i], q);
+            log_moneyness[j] = moneyness(columns, i, row_status[j]);
+            if (row_status[j] != BatchStatus::OK) {
+                terms.slot[j] = 0;      // Never read for invalid rows
+                continue;
+            }
+            
+            const size_t last = expiries - 1;
+            if (expiries == 0 || T != terms.T[last] || r != terms.r[last] || q != terms.q[last]) {
+                terms.T[expiries] = T;
+                terms.r[expiries] = r;
+                terms.q[expiries] = q;
+                terms.sqrt_T[expiries] = T;
+                terms.discount_factor[expiries] = -r * T;
+                terms.dividend_factor[expiries] = -q * T;
+                ++expiries;
+            }
+            terms.slot[j] = static_cast<uint8_t>(expiries - 1);
         }
         
-        // Newton-Raphson update
-        vol -= price_diff / vega;
-        vol = std::max(vol, 0.001);  // Ensure positive volatility
+        VectorMath::sqrt(terms.sqrt_T, terms.sqrt_T, expiries);
+        VectorMath::exp(terms.discount_factor, terms.discount_factor, expiries);
+        VectorMath::exp(terms.dividend_factor, terms.dividend_factor, expiries);
+        
+        priced += price_block(columns, base, n, row_status, log_moneyness, terms, output, want_greeks);
+    }
+    
+    return priced;
+}
+
+} // namespace
+
+size_t OptionPricer::price_batch(const BatchInput& input, const BatchOutput& output) noexcept {
+    METRICS_LATENCY(Utils::MetricHistogram::PRICE_BATCH);
+    const size_t priced = price_rows(input, output);
+    count_rows(input.count, priced);
+    return priced;
+}
+
+size_t OptionPricer::price_batch(const BatchInput& input, const VolatilitySurface& surface,
+                                 const BatchOutput& output) noexcept {
+    METRICS_LATENCY(Utils::MetricHistogram::PRICE_BATCH);
+    if (input.strike_price == nullptr || input.time_to_expiry == nullptr) {
+        BatchInput missing = input;
+        missing.volatility = nullptr;
+        price_rows(missing, output);
+        count_rows(input.count, 0);
+        return 0;
+    }
+    
+    // σ for one block at a time, looked up into the stack and priced from there
+    double volatility[BATCH_BLOCK_SIZE];
+    size_t priced = 0;
+    for (size_t base = 0; base < input.count; base += BATCH_BLOCK_SIZE) {
+        const size_t n = std::min(BATCH_BLOCK_SIZE, input.count - base);
+        surface.volatility(input.strike_price + base, input.time_to_expiry + base, volatility, n);
+        BatchInput part = rows(input, base, n);
+        part.volatility = volatility;
+        priced += price_rows(part, rows(output, base));
+    }
+    
+    count_rows(input.count, priced);
+    return priced;
+}
+
+size_t OptionPricer::price_batch_parallel(const BatchInput& input, const BatchOutput& output,
+                                          Utils::ThreadPool* pool) {
+    Utils::ThreadPool& workers = pool != nullptr ? *pool : Utils::ThreadPool::shared();
+    std::atomic<size_t> priced{0};
+    workers.parallel_for_range(input.count, [&](size_t begin, size_t end) {
+        priced.fetch_add(price_batch(rows(input, begin, end - begin), rows(output, begin)),
+                         std::memory_order_relaxed);
+    }, PARALLEL_BATCH_GRAIN);
+    return priced.load();
+}
+
+size_t OptionPricer::price_slice(const ExpirySlice& slice, const SliceInput& input,
+                                 const BatchOutput& output) noexcept {
+    const bool missing_input = input.spot_price == nullptr || input.strike_price == nullptr ||
+                               input.volatility == nullptr || input.is_call == nullptr;
+    if (missing_input) {
+        for (size_t i = 0; i < input.count; ++i) {
+            store_invalid_row(output, i, BatchStatus::MISSING_INPUT);
+        }
+        count_rows(input.count, 0);
+        return 0;
     }
     
-    logger_.warning("Implied volatility failed to converge after {} iterations", max_iterations);
-    return std::numeric_limits<double>::quiet_NaN();
+    const BlockColumns columns{input.spot_price, input.strike_price, input.volatility, input.is_call};
+    const bool want_greeks = wants_greeks(output);
+    size_t priced = 0;
+    
+    BlockTerms terms;
+    slice_terms(slice, terms);
+    uint32_t row_status[BATCH_BLOCK_SIZE];
+    double log_moneyness[BATCH_BLOCK_SIZE];
+    
+    for (size_t base = 0; base < input.count; base += BATCH_BLOCK_SIZE) {
+        const size_t n = std::min(BATCH_BLOCK_SIZE, input.count - base);
+        for (size_t j = 0; j < n; ++j) {
+            const size_t i = base + j;
+            row_status[j] = validate_row(input.spot_price[i], input.strike_price[i], slice.time_to_expiry,
+                                         slice.risk_free_rate, input.volatility[i], slice.dividend_yield);
+            log_moneyness[j] = moneyness(columns, i, row_status[j]);
+        }
+        priced += price_block(columns, base, n, row_status, log_moneyness, terms, output, want_greeks);
+    }
+    
+    count_rows(input.count, priced);
+    return priced;
 }
 
+size_t OptionPricer::price_grid(const ExpirySlice& slice, const GridInput& input, const BatchOutput& output,
+                                Utils::ThreadPool* pool) {
+    const size_t cells = input.vol_count * input.spot_count;
+    if (input.spot_price == nullptr || input.volatility == nullptr) {
+        for (size_t i = 0; i < cells; ++i) {
+            store_invalid_row(output, i, BatchStatus::MISSING_INPUT);
+        }
+        count_rows(cells, 0);
+        return 0;
+    }
+    
+    Utils::ThreadPool& workers = pool != nullptr ? *pool : Utils::ThreadPool::shared();
+    std::atomic<size_t> priced{0};
+    workers.parallel_for_range(input.vol_count, [&](size_t first, size_t last) {
+        priced.fetch_add(price_grid_rows(slice, input, output, first, last), std::memory_order_relaxed);
+    }, std::max<size_t>(1, PARALLEL_BATCH_GRAIN / std::max<size_t>(1, input.spot_count)));
+    count_rows(cells, priced.load());
+    return priced.load();
+}
+
+namespace {
+
+// AssumptionFlags for one row; bools are combined arithmetically so batch loops stay branch-free
+inline uint32_t assumption_flags(double S, double K, double T, double r, double sigma, double q) noexcept {
+    const double moneyness = S / K;
+    return static_cast<uint32_t>(sigma > 2.0) * AssumptionFlags::HIGH_VOLATILITY |
+           static_cast<uint32_t>(T > 10.0) * AssumptionFlags::LONG_EXPIRY |
+           static_cast<uint32_t>(r > 0.20) * AssumptionFlags::HIGH_RATE |
+           static_cast<uint32_t>((moneyness < 0.5) | (moneyness > 2.0)) * AssumptionFlags::EXTREME_MONEYNESS |
+           static_cast<uint32_t>(q > r + 0.10) * AssumptionFlags::HIGH_DIVIDEND;
+}
+
+} // namespace
+
 std::vector<std::string> OptionPricer::validate_assumptions(const Parameters& params) {
     std::vector<std::string> warnings;
+    const uint32_t flags = assumption_flags(params.spot_price, params.strike_price, params.time_to_expiry,
+                                            params.risk_free_rate, params.volatility, params.dividend_yield);
     
     // Check for extreme parameters
-    if (params.volatility > 2.0) {
+    if (flags & AssumptionFlags::HIGH_VOLATILITY) {
         warnings.push_back("Very high volatility (>200%) may indicate model breakdown");
     }
     
-    if (params.time_to_expiry > 10.0) {
+    if (flags & AssumptionFlags::LONG_EXPIRY) {
         warnings.push_back("Very long time to expiry (>10 years) may reduce model accuracy");
     }
     
-    if (params.risk_free_rate > 0.20) {
+    if (flags & AssumptionFlags::HIGH_RATE) {
         warnings.push_back("Very high risk-free rate (>20%) is unusual");
     }
     
     // Check moneyness
-    const double moneyness = params.spot_price / params.strike_price;
-    if (moneyness < 0.5 || moneyness > 2.0) {
+    if (flags & AssumptionFlags::EXTREME_MONEYNESS) {
         warnings.push_back("Extreme moneyness may reduce model accuracy");
     }
     
     // Check for dividend yield vs risk-free rate
-    if (params.dividend_yield > params.risk_free_rate + 0.10) {
+    if (flags & AssumptionFlags::HIGH_DIVIDEND) {
         warnings.push_back("Dividend yield significantly higher than risk-free rate");
     }
     
     return warnings;
 }
 
+size_t OptionPricer::check_assumptions(const BatchInput& input, uint32_t* flags) noexcept {
+    const bool missing_input = input.spot_price == nullptr || input.strike_price == nullptr ||
+                               input.time_to_expiry == nullptr || input.risk_free_rate == nullptr ||
+                               input.volatility == nullptr;
+    if (missing_input) {
+        std::fill(flags, flags + input.count, AssumptionFlags::NONE);
+        return 0;
+    }
+    
+    size_t flagged = 0;
+    if (input.dividend_yield != nullptr) {
+        for (size_t i = 0; i < input.count; ++i) {
+            flags[i] = assumption_flags(input.spot_price[i], input.strike_price[i], input.time_to_expiry[i],
+                                        input.risk_free_rate[i], input.volatility[i], input.dividend_yield[i]);
+            flagged += flags[i] != AssumptionFlags::NONE;
+        }
+    } else {
+        for (size_t i = 0; i < input.count; ++i) {
+            flags[i] = assumption_flags(input.spot_price[i], input.strike_price[i], input.time_to_expiry[i],
+                                        input.risk_free_rate[i], input.volatility[i], 0.0);
+            flagged += flags[i] != AssumptionFlags::NONE;
+        }
+    }
+    return flagged;
+}
+
 // MathUtils implementation
 namespace MathUtils {
 
@@ -298,53 +794,67 @@ double normal_inv_cdf(double p) {
         throw std::invalid_argument("Probability must be in (0,1)");
     }
     
-    // Beasley-Springer-Moro algorithm
+    // Beasley-Springer-Moro algorithm, coefficients highest degree first
     static const double a[4] = {
-        2.50662823884,
-        -18.61500062529,
+        -25.44106049637,
         41.39119773534,
-        -25.44106049637
+        -18.61500062529,
+        2.50662823884
     };
     
-    static const double b[4] = {
-        -8.47351093090,
-        23.08336743743,
+    static const double b[5] = {
+        3.13082909833,
         -21.06224101826,
-        3.13082909833
+        23.08336743743,
+        -8.47351093090,
+        1.0
     };
     
     static const double c[9] = {
-        0.3374754822726147,
-        0.9761690190917186,
-        0.1607979714918209,
-        0.0276438810333863,
-        0.0038405729373609,
-        0.0003951896511919,
-        0.0000321767881768,
+        0.0000003960315187,
         0.0000002888167364,
-        0.0000003960315187
+        0.0000321767881768,
+        0.0003951896511919,
+        0.0038405729373609,
+        0.0276438810333863,
+        0.1607979714918209,
+        0.9761690190917186,
+        0.3374754822726147
     };
     
     double x = p - 0.5;
+    double q = x > 0.0 ? 1.0 - p : p;
+    double estimate;
     
     if (std::abs(x) < 0.42) {
         double r = x * x;
-        return x * (((a[3] * r + a[2]) * r + a[1]) * r + a[0]) /
-               ((((b[3] * r + b[2]) * r + b[1]) * r + b[0]) * r + 1.0);
+        double num = a[0];
+        for (int i = 1; i < 4; ++i) {
+            num = num * r + a[i];
+        }
+        double den = b[0];
+        for (int i = 1; i < 5; ++i) {
+            den = den * r + b[i];
+        }
+        estimate = std::abs(x * num / den);
+    } else {
+        double t = std::log(-std::log(q));
+        estimate = c[0];
+        for (int i = 1; i < 9; ++i) {
+            estimate = estimate * t + c[i];
+        }
     }
     
-    double r = p;
-    if (x > 0.0) r = 1.0 - p;
-    r = std::log(-std::log(r));
-    
-    double result = c[0];
-    for (int i = 1; i < 9; ++i) {
-        result += c[i] * std::pow(r, i);
+    // One Halley step on N(y) = q in the lower tail (error 3e-9 -> 2e-16).
+    // Working with y = -|x| and q = min(p, 1-p) keeps the residual free of cancellation.
+    double y = -estimate;
+    if (q >= std::numeric_limits<double>::min()) {
+        static const double sqrt_2pi = std::sqrt(2.0 * M_PI);
+        double u = (normal_cdf(y) - q) * sqrt_2pi / std::exp(-0.5 * y * y);
+        y -= u / (1.0 + 0.5 * y * u);
     }
     
-    if (x < 0.0) result = -result;
-    
-    return result;
+    return x > 0.0 ? -y : y;
 }
 
 } // namespace MathUtils
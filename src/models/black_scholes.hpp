@@ -1,10 +1,16 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <stdexcept>
 #include "../utils/logger.hpp"
 #include "../config/config.hpp"
 
+namespace Utils {
+class ThreadPool;
+}
+
 /**
  * @file black_scholes.hpp
  * @brief Black-Scholes option pricing model implementation
@@ -32,6 +38,8 @@
 
 namespace BlackScholes {
 
+class VolatilitySurface;
+
 /**
  * @brief Parameters for Black-Scholes option pricing
  * 
@@ -106,6 +114,165 @@ struct PricingResult {
     PricingResult() : price(0.0), implied_vol(0.0), is_valid(false) {}
 };
 
+/**
+ * @brief Output selection flags for OptionPricer::evaluate()
+ * 
+ * Callers OR together the outputs they need; intermediates shared between
+ * them (d1, d2, discount factors, N(d1), N(d2), φ(d1)) are computed once
+ * and only when some requested output depends on them.
+ */
+struct OutputFlags {
+    static constexpr uint32_t PRICE = 1u << 0;   ///< Option price
+    static constexpr uint32_t DELTA = 1u << 1;   ///< ∂V/∂S
+    static constexpr uint32_t GAMMA = 1u << 2;   ///< ∂²V/∂S²
+    static constexpr uint32_t THETA = 1u << 3;   ///< ∂V/∂T (per day)
+    static constexpr uint32_t VEGA  = 1u << 4;   ///< ∂V/∂σ (per 1%)
+    static constexpr uint32_t RHO   = 1u << 5;   ///< ∂V/∂r (per 1%)
+    
+    static constexpr uint32_t GREEKS = DELTA | GAMMA | THETA | VEGA | RHO;
+    static constexpr uint32_t PRICE_DELTA = PRICE | DELTA;  ///< Typical hedging request
+    static constexpr uint32_t ALL = PRICE | GREEKS;         ///< Full risk request
+};
+
+/**
+ * @brief Per-row status flags reported by the batch pricer
+ * 
+ * A row priced successfully has status OK (0). Any other value is a bitwise
+ * OR of the flags below, mirroring the checks in Parameters::is_valid().
+ * Outputs for a flagged row are set to NaN.
+ */
+struct BatchStatus {
+    static constexpr uint32_t OK                 = 0;
+    static constexpr uint32_t INVALID_SPOT       = 1u << 0;  ///< S <= 0 or NaN
+    static constexpr uint32_t INVALID_STRIKE     = 1u << 1;  ///< K <= 0 or NaN
+    static constexpr uint32_t INVALID_EXPIRY     = 1u << 2;  ///< T <= 0 or NaN
+    static constexpr uint32_t INVALID_RATE       = 1u << 3;  ///< r < 0 or NaN
+    static constexpr uint32_t INVALID_VOLATILITY = 1u << 4;  ///< σ <= 0 or NaN
+    static constexpr uint32_t INVALID_DIVIDEND   = 1u << 5;  ///< q < 0 or NaN
+    static constexpr uint32_t NUMERICAL_ERROR    = 1u << 6;  ///< Non-finite result
+    static constexpr uint32_t MISSING_INPUT      = 1u << 7;  ///< Required input column is null
+    static constexpr uint32_t UNSUPPORTED_EXERCISE = 1u << 8;  ///< Exercise style not priced by the engine
+};
+
+/**
+ * @brief Per-row model-assumption warnings reported by OptionPricer::check_assumptions()
+ * 
+ * Same thresholds as OptionPricer::validate_assumptions(); a row with
+ * warnings can still be priced, but the model may be less accurate.
+ */
+struct AssumptionFlags {
+    static constexpr uint32_t NONE              = 0;
+    static constexpr uint32_t HIGH_VOLATILITY   = 1u << 0;  ///< σ > 200%
+    static constexpr uint32_t LONG_EXPIRY       = 1u << 1;  ///< T > 10 years
+    static constexpr uint32_t HIGH_RATE         = 1u << 2;  ///< r > 20%
+    static constexpr uint32_t EXTREME_MONEYNESS = 1u << 3;  ///< S/K < 0.5 or S/K > 2
+    static constexpr uint32_t HIGH_DIVIDEND     = 1u << 4;  ///< q > r + 10%
+};
+
+/**
+ * @brief Allocation-free result of OptionPricer::quote()
+ * 
+ * Plain data only (no strings), so it can be returned from the hot path
+ * without touching the heap. Errors are reported through BatchStatus flags.
+ */
+struct QuoteResult {
+    double price;       ///< Option price (NaN if not requested or invalid)
+    Greeks greeks;      ///< Requested Greeks (NaN where not requested)
+    uint32_t status;    ///< BatchStatus::OK or a bitwise OR of error flags
+};
+
+/**
+ * @brief Structure-of-arrays input for batch pricing
+ * 
+ * Each pointer refers to a caller-owned column of `count` values; row i of
+ * the batch is (spot_price[i], strike_price[i], ...). The dividend_yield
+ * column is optional and defaults to q = 0 when null.
+ */
+struct BatchInput {
+    const double* spot_price = nullptr;      ///< S per row
+    const double* strike_price = nullptr;    ///< K per row
+    const double* time_to_expiry = nullptr;  ///< T per row (years)
+    const double* risk_free_rate = nullptr;  ///< r per row
+    const double* volatility = nullptr;      ///< σ per row
+    const double* dividend_yield = nullptr;  ///< q per row (optional)
+    const uint8_t* is_call = nullptr;        ///< Nonzero for call, 0 for put
+    size_t count = 0;                        ///< Number of rows
+};
+
+/**
+ * @brief Structure-of-arrays output for batch pricing
+ * 
+ * All columns are caller-owned and must hold at least BatchInput::count
+ * values. Any column may be null, in which case it is not computed. Greeks
+ * use the same units as calculate_call_greeks() (theta per day, vega and
+ * rho per 1%).
+ */
+struct BatchOutput {
+    double* price = nullptr;     ///< Option price per row
+    double* delta = nullptr;     ///< ∂V/∂S per row
+    double* gamma = nullptr;     ///< ∂²V/∂S² per row
+    double* theta = nullptr;     ///< ∂V/∂T per row (per day)
+    double* vega = nullptr;      ///< ∂V/∂σ per row (per 1%)
+    double* rho = nullptr;       ///< ∂V/∂r per row (per 1%)
+    uint32_t* status = nullptr;  ///< BatchStatus flags per row
+};
+
+/**
+ * @brief Term-structure factors shared by every strike of one expiry
+ * 
+ * All options of one expiry share T, r and q, hence √T, e^{-rT} and
+ * e^{-qT}. An ExpirySlice computes them once; OptionPricer::quote() and
+ * OptionPricer::price_slice() then price any number of strikes from it.
+ */
+struct ExpirySlice {
+    double time_to_expiry = 0.0;             ///< T (years)
+    double risk_free_rate = 0.0;             ///< r
+    double dividend_yield = 0.0;             ///< q
+    double sqrt_T = 0.0;                     ///< √T
+    double discount_factor = 0.0;            ///< e^{-rT}
+    double dividend_factor = 0.0;            ///< e^{-qT}
+    uint32_t status = BatchStatus::INVALID_EXPIRY;  ///< BatchStatus flags for T, r and q
+    
+    ExpirySlice() = default;
+    
+    /**
+     * @brief Precompute the factors for one expiry
+     * @param T Time to expiration in years
+     * @param r Risk-free rate
+     * @param q Dividend yield (default: 0.0)
+     */
+    ExpirySlice(double T, double r, double q = 0.0) noexcept;
+};
+
+/**
+ * @brief Structure-of-arrays strikes of one expiry for OptionPricer::price_slice()
+ * 
+ * Same layout as BatchInput without the per-row T, r and q columns, which
+ * come from the slice.
+ */
+struct SliceInput {
+    const double* spot_price = nullptr;      ///< S per row
+    const double* strike_price = nullptr;    ///< K per row
+    const double* volatility = nullptr;      ///< σ per row
+    const uint8_t* is_call = nullptr;        ///< Nonzero for call, 0 for put
+    size_t count = 0;                        ///< Number of rows
+};
+
+/**
+ * @brief Spot × volatility grid of one contract for OptionPricer::price_grid()
+ * 
+ * Cell (v, s) prices the contract at spot_price[s] and volatility[v];
+ * outputs are row-major with one row per volatility.
+ */
+struct GridInput {
+    const double* spot_price = nullptr;      ///< Spot axis
+    size_t spot_count = 0;                   ///< Number of spots (columns)
+    const double* volatility = nullptr;      ///< Volatility axis
+    size_t vol_count = 0;                    ///< Number of volatilities (rows)
+    double strike_price = 0.0;               ///< K shared by every cell
+    bool is_call = true;                     ///< Call or put
+};
+
 /**
  * @brief Black-Scholes option pricer class
  * 
@@ -114,7 +281,7 @@ struct PricingResult {
  */
 class OptionPricer {
 private:
-    static thread_local Logger logger_;  ///< Thread-local logger instance
+    static thread_local Utils::Logger logger_;  ///< Thread-local logger instance
     
     /**
      * @brief Calculate d1 parameter for Black-Scholes formula
@@ -148,6 +315,85 @@ public:
      */
     static PricingResult price_put(const Parameters& params);
     
+    /**
+     * @brief Fused evaluation of price and Greeks sharing all intermediates
+     * 
+     * Computes d1, d2, the discount factors and the normal CDF/PDF terms once
+     * and derives every requested output from them. Outputs not requested
+     * are set to NaN. No logging or allocation is performed, which makes
+     * this the preferred entry point for hot loops.
+     * 
+     * @param params Black-Scholes parameters (assumed validated)
+     * @param is_call true for call option, false for put
+     * @param outputs Bitwise OR of OutputFlags values (default: all)
+     * @return Pricing result; is_valid is false if a requested output is not finite
+     */
+    static PricingResult evaluate(const Parameters& params, bool is_call,
+                                  uint32_t outputs = OutputFlags::ALL) noexcept;
+    
+    /**
+     * @brief Hot-path pricing with error codes instead of exceptions
+     * 
+     * Validates the inputs with the same rules as Parameters::is_valid() and
+     * prices them with the fused kernel. Performs no heap allocation, no
+     * logging and no lock acquisition in any configuration.
+     * 
+     * @param S Current stock price
+     * @param K Strike price
+     * @param T Time to expiration in years
+     * @param r Risk-free rate
+     * @param sigma Volatility
+     * @param q Dividend yield
+     * @param is_call true for call option, false for put
+     * @param outputs Bitwise OR of OutputFlags values (default: all)
+     * @return Result with BatchStatus flags; outputs are NaN on error
+     */
+    static QuoteResult quote(double S, double K, double T, double r, double sigma, double q,
+                             bool is_call, uint32_t outputs = OutputFlags::ALL) noexcept;
+    
+    /**
+     * @brief Hot-path pricing of one strike from a precomputed expiry
+     * 
+     * Same validation and results as quote(S, K, T, r, sigma, q, ...),
+     * without recomputing √T, e^{-rT} and e^{-qT}.
+     * 
+     * @param slice Factors of the option's expiry
+     * @param S Current stock price
+     * @param K Strike price
+     * @param sigma Volatility
+     * @param is_call true for call option, false for put
+     * @param outputs Bitwise OR of OutputFlags values (default: all)
+     * @return Result with BatchStatus flags; outputs are NaN on error
+     */
+    static QuoteResult quote(const ExpirySlice& slice, double S, double K, double sigma,
+                             bool is_call, uint32_t outputs = OutputFlags::ALL) noexcept;
+    
+    /**
+     * @brief Enable or disable hot-path mode at runtime
+     * 
+     * In hot-path mode price_call(), price_put() and the Parameters
+     * constructor skip their debug/info logging, so pricing valid inputs
+     * performs no allocation or locking. Without a call, the mode follows
+     * the `performance.hot_path` configuration key, including later set()
+     * and reload() changes; this call overrides the key until
+     * reset_hot_path(). Building with -DBLACKSCHOLES_HOT_PATH forces the
+     * mode on at compile time.
+     * 
+     * @param enabled True to enable hot-path mode
+     */
+    static void set_hot_path(bool enabled) noexcept;
+    
+    /**
+     * @brief Drop the set_hot_path() override and follow `performance.hot_path` again
+     */
+    static void reset_hot_path() noexcept;
+    
+    /**
+     * @brief Check whether hot-path mode is active
+     * @return true if pricer logging is suppressed
+     */
+    static bool hot_path_enabled();
+    
     /**
      * @brief Calculate Greeks for a call option
      * @param params Black-Scholes parameters
@@ -163,7 +409,10 @@ public:
     static Greeks calculate_put_greeks(const Parameters& params);
     
     /**
-     * @brief Calculate implied volatility using Newton-Raphson method
+     * @brief Calculate implied volatility for a single quote
+     * 
+     * Delegates to ImpliedVolatilitySolver::solve(); use
+     * ImpliedVolatilitySolver::solve_batch() to invert many quotes at once.
      * @param market_price Observed market price
      * @param params Black-Scholes parameters (volatility will be ignored)
      * @param is_call true for call option, false for put
@@ -179,12 +428,113 @@ public:
         double tolerance = 0.0   // 0 means use config default
     );
     
+    /**
+     * @brief Price a batch of European options in one call
+     * 
+     * Rows are validated with the same rules as Parameters::is_valid(), but
+     * invalid rows are reported through BatchOutput::status instead of
+     * exceptions. The call performs no heap allocation and no logging per
+     * row, so it is safe to use on latency-sensitive paths. The log, exp,
+     * sqrt and normal CDF/PDF evaluations use the SIMD kernels in
+     * VectorMath, so results agree with price_call()/price_put() to a few
+     * ULP rather than bit-for-bit.
+     * 
+     * Consecutive rows with equal (T, r, q), such as the strikes of one
+     * expiry in a chain sorted by expiry, share one evaluation of √T,
+     * e^{-rT} and e^{-qT}.
+     * 
+     * @param input Structure-of-arrays option parameters
+     * @param output Caller-owned output columns (null columns are skipped)
+     * @return Number of rows priced successfully
+     */
+    static size_t price_batch(const BatchInput& input, const BatchOutput& output) noexcept;
+    
+    /**
+     * @brief Price a batch with σ from a volatility surface
+     * 
+     * Same validation, output and allocation guarantees as price_batch();
+     * each row's σ is surface.volatility(K, T) and input.volatility is
+     * ignored (it may be null). Rows where the surface has no σ report
+     * INVALID_VOLATILITY.
+     * 
+     * @param input Structure-of-arrays option parameters
+     * @param surface Fitted surface
+     * @param output Caller-owned output columns (null columns are skipped)
+     * @return Number of rows priced successfully
+     */
+    static size_t price_batch(const BatchInput& input, const VolatilitySurface& surface,
+                              const BatchOutput& output) noexcept;
+    
+    /**
+     * @brief Price a batch across a thread pool
+     * 
+     * Splits the rows into ranges and runs price_batch() on each range;
+     * results are identical to a single price_batch() call.
+     * 
+     * @param input Structure-of-arrays option parameters
+     * @param output Caller-owned output columns (null columns are skipped)
+     * @param pool Thread pool to use (nullptr = Utils::ThreadPool::shared())
+     * @return Number of rows priced successfully
+     */
+    static size_t price_batch_parallel(const BatchInput& input, const BatchOutput& output,
+                                       Utils::ThreadPool* pool = nullptr);
+    
+    /**
+     * @brief Price all strikes of one expiry in one call
+     * 
+     * Same validation, output and allocation guarantees as price_batch();
+     * T, r and q and their factors come from the slice.
+     * 
+     * @param slice Factors of the common expiry
+     * @param input Structure-of-arrays strikes
+     * @param output Caller-owned output columns (null columns are skipped)
+     * @return Number of rows priced successfully
+     */
+    static size_t price_slice(const ExpirySlice& slice, const SliceInput& input,
+                              const BatchOutput& output) noexcept;
+    
+    /**
+     * @brief Price a spot × volatility grid of one contract across a thread pool
+     * 
+     * Same validation and output semantics as price_slice(); cell (v, s) is
+     * written to index v * spot_count + s of every output column. Rows are
+     * split across the pool, each priced in blocks without allocation.
+     * 
+     * @param slice Factors of the contract's expiry
+     * @param input Grid axes and contract
+     * @param output Caller-owned columns of vol_count * spot_count entries
+     * @param pool Thread pool to use (nullptr = Utils::ThreadPool::shared())
+     * @return Number of cells priced successfully
+     */
+    static size_t price_grid(const ExpirySlice& slice, const GridInput& input,
+                             const BatchOutput& output, Utils::ThreadPool* pool = nullptr);
+    
+    /**
+     * @brief Compute the BatchStatus flags for one set of raw parameters
+     * @return BatchStatus::OK if the parameters are valid
+     */
+    static uint32_t validate_row(double S, double K, double T, double r,
+                                 double sigma, double q) noexcept;
+    
     /**
      * @brief Validate Black-Scholes assumptions
      * @param params Parameters to validate
      * @return Validation warnings (empty if no issues)
      */
     static std::vector<std::string> validate_assumptions(const Parameters& params);
+    
+    /**
+     * @brief Check the validate_assumptions() rules over a batch
+     * 
+     * Branch-free over structure-of-arrays columns so the loop vectorizes;
+     * no allocation and no logging. Rows whose required columns are null
+     * get AssumptionFlags::NONE.
+     * 
+     * @param input Structure-of-arrays option parameters
+     * @param flags Caller-owned column of input.count AssumptionFlags values
+     * @return Number of rows with at least one warning
+     */
+    static size_t check_assumptions(const BatchInput& input, uint32_t* flags) noexcept;
 };
 
 /**
@@ -207,6 +557,11 @@ namespace MathUtils {
     
     /**
      * @brief Inverse normal cumulative distribution function
+     * 
+     * Beasley-Springer-Moro approximation refined by one Halley step:
+     * error below 2ε·max(|x|, 1) for min(p, 1-p) ≥ 1e-20.
+     * VectorMath::normal_inv_cdf() is the batch version.
+     * 
      * @param p Probability (0 < p < 1)
      * @return x such that N(x) = p
      * @throws std::invalid_argument if p is not in (0,1)
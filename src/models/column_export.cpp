@@ -0,0 +1,216 @@
+#include "column_export.hpp"
+#include "implied_volatility.hpp"
+#include "../utils/column_file.hpp"
+#include "../utils/thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace BlackScholes {
+
+namespace {
+
+// Rows per priced_chain() task: copy, price and invert while the range is in cache
+constexpr size_t EXPORT_GRAIN = 4096;
+
+struct OutputColumn {
+    uint32_t flag;
+    const char* name;
+};
+
+const OutputColumn OUTPUT_COLUMNS[] = {
+    {OutputFlags::PRICE, "price"},
+    {OutputFlags::DELTA, "delta"},
+    {OutputFlags::GAMMA, "gamma"},
+    {OutputFlags::THETA, "theta"},
+    {OutputFlags::VEGA, "vega"},
+    {OutputFlags::RHO, "rho"},
+};
+
+// Column shifted to start at row `begin` (null stays null)
+template <typename T>
+inline T* offset(T* column, size_t begin) noexcept {
+    return column != nullptr ? column + begin : nullptr;
+}
+
+template <typename T>
+void copy_rows(T* destination, const T* source, size_t begin, size_t end) noexcept {
+    if (source != nullptr) {
+        std::memcpy(destination + begin, source + begin, (end - begin) * sizeof(T));
+    }
+}
+
+void add_output_specs(std::vector<Utils::ColumnSpec>& specs, uint32_t outputs) {
+    for (const OutputColumn& column : OUTPUT_COLUMNS) {
+        if (outputs & column.flag) {
+            specs.push_back({column.name, Utils::ColumnType::FLOAT64, 1});
+        }
+    }
+    specs.push_back({"status", Utils::ColumnType::UINT32, 1});
+}
+
+BatchOutput mapped_output(Utils::ColumnFileWriter& file, uint32_t outputs) {
+    const auto column = [&](uint32_t flag, const char* name) -> double* {
+        return (outputs & flag) ? file.float64(name) : nullptr;
+    };
+    BatchOutput output;
+    output.price = column(OutputFlags::PRICE, "price");
+    output.delta = column(OutputFlags::DELTA, "delta");
+    output.gamma = column(OutputFlags::GAMMA, "gamma");
+    output.theta = column(OutputFlags::THETA, "theta");
+    output.vega = column(OutputFlags::VEGA, "vega");
+    output.rho = column(OutputFlags::RHO, "rho");
+    output.status = file.uint32("status");
+    return output;
+}
+
+BatchOutput offset(const BatchOutput& output, size_t begin) noexcept {
+    BatchOutput part;
+    part.price = offset(output.price, begin);
+    part.delta = offset(output.delta, begin);
+    part.gamma = offset(output.gamma, begin);
+    part.theta = offset(output.theta, begin);
+    part.vega = offset(output.vega, begin);
+    part.rho = offset(output.rho, begin);
+    part.status = offset(output.status, begin);
+    return part;
+}
+
+} // namespace
+
+size_t ColumnExport::priced_chain(const std::string& path, const BatchInput& input, uint32_t outputs,
+                                  const double* market_price, Utils::ThreadPool* pool) {
+    std::vector<Utils::ColumnSpec> specs = {
+        {"spot", Utils::ColumnType::FLOAT64, 1},
+        {"strike", Utils::ColumnType::FLOAT64, 1},
+        {"expiry", Utils::ColumnType::FLOAT64, 1},
+        {"rate", Utils::ColumnType::FLOAT64, 1},
+        {"volatility", Utils::ColumnType::FLOAT64, 1},
+        {"dividend", Utils::ColumnType::FLOAT64, 1},
+        {"is_call", Utils::ColumnType::UINT8, 1},
+    };
+    add_output_specs(specs, outputs);
+    if (market_price != nullptr) {
+        specs.push_back({"market_price", Utils::ColumnType::FLOAT64, 1});
+        specs.push_back({"implied_vol", Utils::ColumnType::FLOAT64, 1});
+        specs.push_back({"iv_iterations", Utils::ColumnType::UINT32, 1});
+        specs.push_back({"iv_failure", Utils::ColumnType::UINT8, 1});
+    }
+    Utils::ColumnFileWriter file(path, input.count, specs);
+    
+    // Pricing reads the inputs back from the file; a column missing from the
+    // input stays null (zeros on disk) so the pricer flags it as usual
+    const auto mapped = [&](const auto* source, auto* destination) {
+        return source != nullptr ? destination : nullptr;
+    };
+    double* const spot = mapped(input.spot_price, file.float64("spot"));
+    double* const strike = mapped(input.strike_price, file.float64("strike"));
+    double* const expiry = mapped(input.time_to_expiry, file.float64("expiry"));
+    double* const rate = mapped(input.risk_free_rate, file.float64("rate"));
+    double* const volatility = mapped(input.volatility, file.float64("volatility"));
+    double* const dividend = mapped(input.dividend_yield, file.float64("dividend"));
+    uint8_t* const is_call = mapped(input.is_call, file.uint8("is_call"));
+    const BatchOutput output = mapped_output(file, outputs);
+    
+    double* const quoted = market_price != nullptr ? file.float64("market_price") : nullptr;
+    IVBatchOutput solved;
+    if (market_price != nullptr) {
+        solved.implied_vol = file.float64("implied_vol");
+        solved.iterations = file.uint32("iv_iterations");
+        solved.failure = reinterpret_cast<IVFailure*>(file.uint8("iv_failure"));
+    }
+    
+    Utils::ThreadPool& workers = pool != nullptr ? *pool : Utils::ThreadPool::shared();
+    std::atomic<size_t> priced{0};
+    workers.parallel_for_range(input.count, [&](size_t begin, size_t end) {
+        copy_rows(spot, input.spot_price, begin, end);
+        copy_rows(strike, input.strike_price, begin, end);
+        copy_rows(expiry, input.time_to_expiry, begin, end);
+        copy_rows(rate, input.risk_free_rate, begin, end);
+        copy_rows(volatility, input.volatility, begin, end);
+        copy_rows(dividend, input.dividend_yield, begin, end);
+        copy_rows(is_call, input.is_call, begin, end);
+        
+        BatchInput part;
+        part.spot_price = offset(spot, begin);
+        part.strike_price = offset(strike, begin);
+        part.time_to_expiry = offset(expiry, begin);
+        part.risk_free_rate = offset(rate, begin);
+        part.volatility = offset(volatility, begin);
+        part.dividend_yield = offset(dividend, begin);
+        part.is_call = offset(is_call, begin);
+        part.count = end - begin;
+        priced.fetch_add(OptionPricer::price_batch(part, offset(output, begin)), std::memory_order_relaxed);
+        
+        if (quoted != nullptr) {
+            copy_rows(quoted, market_price, begin, end);
+            IVBatchInput quotes;
+            quotes.market_price = quoted + begin;
+            quotes.spot_price = part.spot_price;
+            quotes.strike_price = part.strike_price;
+            quotes.time_to_expiry = part.time_to_expiry;
+            quotes.risk_free_rate = part.risk_free_rate;
+            quotes.dividend_yield = part.dividend_yield;
+            quotes.is_call = part.is_call;
+            quotes.count = part.count;
+            IVBatchOutput range;
+            range.implied_vol = solved.implied_vol + begin;
+            range.iterations = solved.iterations + begin;
+            range.failure = solved.failure + begin;
+            ImpliedVolatilitySolver::solve_batch(quotes, range);
+        }
+    }, EXPORT_GRAIN);
+    
+    file.finish();
+    return priced.load();
+}
+
+size_t ColumnExport::price_grid(const std::string& path, const ExpirySlice& slice, const GridInput& grid,
+                                uint32_t outputs, Utils::ThreadPool* pool) {
+    std::vector<Utils::ColumnSpec> specs = {
+        {"spot", Utils::ColumnType::FLOAT64, 1},
+        {"volatility", Utils::ColumnType::FLOAT64, 1},
+    };
+    add_output_specs(specs, outputs);
+    Utils::ColumnFileWriter file(path, grid.vol_count * grid.spot_count, specs);
+    
+    if (grid.spot_price != nullptr && grid.volatility != nullptr) {
+        double* const spot = file.float64("spot");
+        double* const volatility = file.float64("volatility");
+        for (size_t v = 0; v < grid.vol_count; ++v) {
+            std::memcpy(spot + v * grid.spot_count, grid.spot_price, grid.spot_count * sizeof(double));
+            std::fill(volatility + v * grid.spot_count, volatility + (v + 1) * grid.spot_count, grid.volatility[v]);
+        }
+    }
+    
+    const size_t priced = OptionPricer::price_grid(slice, grid, mapped_output(file, outputs), pool);
+    file.finish();
+    return priced;
+}
+
+void ColumnExport::scenario_pnl(const std::string& path, const ScenarioEngine& engine,
+                                const std::vector<Scenario>& scenarios) {
+    Utils::ColumnFileWriter file(path, scenarios.size(), {
+        {"spot_shift", Utils::ColumnType::FLOAT64, 1},
+        {"vol_shift", Utils::ColumnType::FLOAT64, 1},
+        {"rate_shift", Utils::ColumnType::FLOAT64, 1},
+        {"pnl", Utils::ColumnType::FLOAT64, std::max<size_t>(engine.positions(), 1)},
+        {"portfolio_pnl", Utils::ColumnType::FLOAT64, 1},
+    });
+    
+    double* const spot_shift = file.float64("spot_shift");
+    double* const vol_shift = file.float64("vol_shift");
+    double* const rate_shift = file.float64("rate_shift");
+    for (size_t s = 0; s < scenarios.size(); ++s) {
+        spot_shift[s] = scenarios[s].spot_shift;
+        vol_shift[s] = scenarios[s].vol_shift;
+        rate_shift[s] = scenarios[s].rate_shift;
+    }
+    
+    double* const pnl = file.float64("pnl");
+    engine.run(scenarios.data(), scenarios.size(), pnl);
+    engine.ladder(pnl, scenarios.size(), file.float64("portfolio_pnl"));
+    file.finish();
+}
+
+} // namespace BlackScholes
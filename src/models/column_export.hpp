@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "black_scholes.hpp"
+#include "scenario_engine.hpp"
+
+/**
+ * @file column_export.hpp
+ * @brief Pricing results written straight into memory-mapped column files
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * Each exporter sizes a Utils::ColumnFileWriter for its result and points
+ * the pricer's output columns into the mapping, so prices, Greeks, implied
+ * volatilities and P&L are computed in place; nothing is buffered per row
+ * and no PricingResult objects are built. Downstream readers map the file
+ * with Utils::ColumnFileReader or python/column_file.py.
+ *
+ * Column names:
+ * - priced_chain(): spot, strike, expiry, rate, volatility, dividend,
+ *   is_call (uint8), the requested outputs among price, delta, gamma,
+ *   theta, vega and rho, and status (uint32 BatchStatus); with market
+ *   prices also market_price, implied_vol, iv_iterations (uint32) and
+ *   iv_failure (uint8 IVFailure).
+ * - price_grid(): one row per cell, volatility-major: spot, volatility,
+ *   the requested outputs and status.
+ * - scenario_pnl(): one row per scenario: spot_shift, vol_shift,
+ *   rate_shift, pnl (one value per position) and portfolio_pnl.
+ */
+
+namespace BlackScholes {
+
+/**
+ * @brief Writers of pricing results in the column file format
+ */
+class ColumnExport {
+public:
+    /**
+     * @brief Price a batch, optionally solve implied volatilities, and write both
+     *
+     * Inputs are copied into the file and priced (and inverted) range by
+     * range on the pool while the range is still in cache. Same results
+     * as price_batch() and ImpliedVolatilitySolver::solve_batch().
+     *
+     * @param path Output file (created or truncated)
+     * @param input Structure-of-arrays option parameters
+     * @param outputs OutputFlags selecting the result columns
+     * @param market_price Observed prices per row to invert (nullptr = no IV columns)
+     * @param pool Thread pool to use (nullptr = Utils::ThreadPool::shared())
+     * @return Number of rows priced successfully
+     * @throws std::runtime_error if the file cannot be written
+     */
+    static size_t priced_chain(const std::string& path, const BatchInput& input,
+                               uint32_t outputs = OutputFlags::ALL, const double* market_price = nullptr,
+                               Utils::ThreadPool* pool = nullptr);
+    
+    /**
+     * @brief Price a spot × volatility grid and write it cell by cell
+     * @param path Output file (created or truncated)
+     * @param slice Factors of the contract's expiry
+     * @param grid Grid axes and contract
+     * @param outputs OutputFlags selecting the result columns
+     * @param pool Thread pool to use (nullptr = Utils::ThreadPool::shared())
+     * @return Number of cells priced successfully
+     * @throws std::runtime_error if the file cannot be written
+     */
+    static size_t price_grid(const std::string& path, const ExpirySlice& slice, const GridInput& grid,
+                             uint32_t outputs = OutputFlags::PRICE, Utils::ThreadPool* pool = nullptr);
+    
+    /**
+     * @brief Run scenarios and write the P&L matrix and ladder
+     * @param path Output file (created or truncated)
+     * @param engine Portfolio to reprice
+     * @param scenarios Scenarios to apply
+     * @throws std::invalid_argument if a shift is invalid
+     * @throws std::runtime_error if the file cannot be written
+     */
+    static void scenario_pnl(const std::string& path, const ScenarioEngine& engine,
+                             const std::vector<Scenario>& scenarios);
+};
+
+} // namespace BlackScholes
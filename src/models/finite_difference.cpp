@@ -0,0 +1,293 @@
+#include "pricing_engine.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace BlackScholes {
+
+namespace {
+
+// Fully implicit steps before switching to Crank-Nicolson (Rannacher smoothing)
+constexpr uint32_t RANNACHER_STEPS = 2;
+
+// Relative volatility bump and absolute rate bump for vega and rho
+constexpr double VEGA_BUMP = 0.01;
+constexpr double RHO_BUMP = 1e-4;
+
+/**
+ * @brief Value and first two x-derivatives of a grid at one point
+ */
+struct GridPoint {
+    double value;
+    double first;
+    double second;
+};
+
+// Cubic through the four nodes around x, so v'' is second-order accurate between nodes
+GridPoint interpolate(const std::vector<double>& v, double x_min, double dx, double x) noexcept {
+    const double position = (x - x_min) / dx;
+    const double last = static_cast<double>(v.size() - 3);
+    const size_t k = static_cast<size_t>(std::clamp(std::floor(position), 1.0, last));
+    const double t = position - static_cast<double>(k);
+    
+    // p(t) = a + b t + c t² + d t³ through v[k-1], v[k], v[k+1], v[k+2]
+    const double a = v[k];
+    const double b = -v[k - 1] / 3.0 - 0.5 * v[k] + v[k + 1] - v[k + 2] / 6.0;
+    const double c = 0.5 * (v[k - 1] + v[k + 1]) - v[k];
+    const double d = (v[k + 2] - v[k - 1]) / 6.0 + 0.5 * (v[k] - v[k + 1]);
+    return {a + t * (b + t * (c + t * d)), (b + t * (2.0 * c + 3.0 * t * d)) / dx,
+            (2.0 * c + 6.0 * t * d) / (dx * dx)};
+}
+
+} // namespace
+
+FiniteDifferenceOptions FiniteDifferenceOptions::from_config() {
+    FiniteDifferenceOptions options;
+    const auto& config = Config::ConfigManager::getInstance().snapshot();
+    options.space_steps = static_cast<uint32_t>(std::max(config.finite_difference.space_steps, 4));
+    options.time_steps = static_cast<uint32_t>(std::max(config.finite_difference.time_steps, 2));
+    options.std_devs = config.finite_difference.std_devs > 0.0 ? config.finite_difference.std_devs : 5.0;
+    return options;
+}
+
+CrankNicolsonEngine::CrankNicolsonEngine(const FiniteDifferenceOptions& options) : options_(options) {
+    if (options_.space_steps < 4 || options_.time_steps < 2 || !(options_.std_devs > 0.0)) {
+        throw std::invalid_argument("Finite-difference grid needs at least 4 space steps, 2 time steps "
+                                    "and a positive width");
+    }
+    const size_t nodes = static_cast<size_t>(options_.space_steps) + 1;
+    value_.resize(nodes);
+    previous_.resize(nodes);
+    payoff_.resize(nodes);
+    scratch_.resize(nodes);
+    rhs_.resize(nodes);
+}
+
+CrankNicolsonEngine::Solution CrankNicolsonEngine::solve(double T, double r, double sigma, double q,
+                                                         bool is_call, bool american,
+                                                         double x_min, double x_max) const {
+    const size_t n = options_.space_steps;
+    const uint32_t steps = options_.time_steps;
+    const Solution grid{x_min, (x_max - x_min) / static_cast<double>(n), T / steps};
+    
+    for (size_t i = 0; i <= n; ++i) {
+        const double moneyness = std::exp(x_min + static_cast<double>(i) * grid.dx);
+        payoff_[i] = is_call ? std::max(moneyness - 1.0, 0.0) : std::max(1.0 - moneyness, 0.0);
+    }
+    std::copy(payoff_.begin(), payoff_.end(), value_.begin());
+    
+    // Spatial operator L v_i = lower v_{i-1} + diagonal v_i + upper v_{i+1}
+    const double half_variance = 0.5 * sigma * sigma;
+    const double diffusion = half_variance / (grid.dx * grid.dx);
+    const double convection = (r - q - half_variance) / (2.0 * grid.dx);
+    const double lower = diffusion - convection;
+    const double diagonal = -2.0 * diffusion - r;
+    const double upper = diffusion + convection;
+    const double high_moneyness = std::exp(x_max);
+    const double low_moneyness = std::exp(x_min);
+    
+    for (uint32_t step = 1; step <= steps; ++step) {
+        std::swap(value_, previous_);
+        const double* old_layer = previous_.data();
+        double* layer = value_.data();
+        
+        const double tau = grid.dt * step;
+        const double discount = std::exp(-r * tau);
+        const double carry = std::exp(-q * tau);
+        double low = 0.0;
+        double high = 0.0;
+        if (is_call) {
+            high = high_moneyness * carry - discount;
+            high = american ? std::max(high, high_moneyness - 1.0) : high;
+        } else {
+            low = discount - low_moneyness * carry;
+            low = american ? std::max(low, 1.0 - low_moneyness) : low;
+        }
+        
+        // (I - θ dt L) v_new = (I + (1 - θ) dt L) v_old
+        const double theta = step <= RANNACHER_STEPS ? 1.0 : 0.5;
+        const double explicit_weight = (1.0 - theta) * grid.dt;
+        const double implicit_weight = theta * grid.dt;
+        const double sub = -implicit_weight * lower;
+        const double main = 1.0 - implicit_weight * diagonal;
+        const double super = -implicit_weight * upper;
+        for (size_t i = 1; i < n; ++i) {
+            rhs_[i] = old_layer[i] + explicit_weight *
+                      (lower * old_layer[i - 1] + diagonal * old_layer[i] + upper * old_layer[i + 1]);
+        }
+        rhs_[1] -= sub * low;
+        rhs_[n - 1] -= super * high;
+        
+        // Thomas algorithm: forward sweep into scratch_/rhs_, back substitution into the layer
+        scratch_[1] = super / main;
+        rhs_[1] /= main;
+        for (size_t i = 2; i < n; ++i) {
+            const double pivot = main - sub * scratch_[i - 1];
+            scratch_[i] = super / pivot;
+            rhs_[i] = (rhs_[i] - sub * rhs_[i - 1]) / pivot;
+        }
+        layer[n - 1] = rhs_[n - 1];
+        for (size_t i = n - 1; i-- > 1;) {
+            layer[i] = rhs_[i] - scratch_[i] * layer[i + 1];
+        }
+        layer[0] = low;
+        layer[n] = high;
+        
+        if (american) {
+            for (size_t i = 0; i <= n; ++i) {
+                layer[i] = std::max(layer[i], payoff_[i]);
+            }
+        }
+    }
+    return grid;
+}
+
+size_t CrankNicolsonEngine::price_run(const BatchInput& input, const BatchOutput& output, size_t begin,
+                                      size_t end, ExerciseStyle exercise, uint32_t outputs) const {
+    const double T = input.time_to_expiry[begin];
+    const double r = input.risk_free_rate[begin];
+    const double sigma = input.volatility[begin];
+    const double q = input.dividend_yield != nullptr ? input.dividend_yield[begin] : 0.0;
+    const bool is_call = input.is_call[begin] != 0;
+    const bool american = exercise == ExerciseStyle::AMERICAN;
+    
+    // One grid covering every row of the run and the strike
+    double x_low = 0.0;
+    double x_high = 0.0;
+    for (size_t i = begin; i < end; ++i) {
+        const double x = std::log(input.spot_price[i] / input.strike_price[i]);
+        x_low = std::min(x_low, x);
+        x_high = std::max(x_high, x);
+    }
+    const double width = options_.std_devs * sigma * std::sqrt(T);
+    x_low -= width;
+    x_high += width;
+    
+    const auto bumped_prices = [&](double* column, double bumped_sigma, double bumped_r, double sign) {
+        const Solution grid = solve(T, bumped_r, bumped_sigma, q, is_call, american, x_low, x_high);
+        for (size_t i = begin; i < end; ++i) {
+            const double x = std::log(input.spot_price[i] / input.strike_price[i]);
+            column[i] += sign * input.strike_price[i] * interpolate(value_, grid.x_min, grid.dx, x).value;
+        }
+    };
+    // Central bumps share the grid, so the discretization error largely cancels (per 1%, like OptionPricer)
+    const double vega_bump = VEGA_BUMP * sigma;
+    const bool want_vega = (outputs & OutputFlags::VEGA) && output.vega != nullptr;
+    const bool want_rho = (outputs & OutputFlags::RHO) && output.rho != nullptr;
+    if (want_vega) {
+        std::fill(output.vega + begin, output.vega + end, 0.0);
+        bumped_prices(output.vega, sigma + vega_bump, r, 1.0);
+        bumped_prices(output.vega, sigma - vega_bump, r, -1.0);
+        for (size_t i = begin; i < end; ++i) {
+            output.vega[i] /= 2.0 * vega_bump * 100.0;
+        }
+    }
+    if (want_rho) {
+        std::fill(output.rho + begin, output.rho + end, 0.0);
+        bumped_prices(output.rho, sigma, r + RHO_BUMP, 1.0);
+        bumped_prices(output.rho, sigma, r - RHO_BUMP, -1.0);
+        for (size_t i = begin; i < end; ++i) {
+            output.rho[i] /= 2.0 * RHO_BUMP * 100.0;
+        }
+    }
+    
+    const Solution grid = solve(T, r, sigma, q, is_call, american, x_low, x_high);
+    size_t priced = 0;
+    for (size_t i = begin; i < end; ++i) {
+        const double S = input.spot_price[i];
+        const double K = input.strike_price[i];
+        const double x = std::log(S / K);
+        const GridPoint point = interpolate(value_, grid.x_min, grid.dx, x);
+        
+        // V = K v(ln(S/K)): ∂V/∂S = K v'/S, ∂²V/∂S² = K (v'' - v')/S², ∂V/∂t = -∂V/∂τ
+        QuoteResult result = failed(BatchStatus::OK);
+        if (outputs & OutputFlags::PRICE) result.price = K * point.value;
+        if (outputs & OutputFlags::DELTA) result.greeks.delta = K * point.first / S;
+        if (outputs & OutputFlags::GAMMA) result.greeks.gamma = K * (point.second - point.first) / (S * S);
+        if (outputs & OutputFlags::THETA) {
+            const double earlier = interpolate(previous_, grid.x_min, grid.dx, x).value;
+            result.greeks.theta = -K * (point.value - earlier) / grid.dt / 365.0;
+        }
+        if (want_vega) result.greeks.vega = output.vega[i];
+        if (want_rho) result.greeks.rho = output.rho[i];
+        
+        const bool finite = (!(outputs & OutputFlags::PRICE) || std::isfinite(result.price)) &&
+                            (!(outputs & OutputFlags::DELTA) || std::isfinite(result.greeks.delta)) &&
+                            (!(outputs & OutputFlags::GAMMA) || std::isfinite(result.greeks.gamma)) &&
+                            (!(outputs & OutputFlags::THETA) || std::isfinite(result.greeks.theta)) &&
+                            (!want_vega || std::isfinite(result.greeks.vega)) &&
+                            (!want_rho || std::isfinite(result.greeks.rho));
+        if (!finite) {
+            result = failed(BatchStatus::NUMERICAL_ERROR);
+        }
+        store(output, i, result);
+        priced += finite ? 1 : 0;
+    }
+    return priced;
+}
+
+QuoteResult CrankNicolsonEngine::quote_valid(double S, double K, double T, double r, double sigma, double q,
+                                             bool is_call, ExerciseStyle exercise, uint32_t outputs) const {
+    QuoteResult result = failed(BatchStatus::OK);
+    const uint8_t call = is_call ? 1 : 0;
+    BatchInput row;
+    row.spot_price = &S;
+    row.strike_price = &K;
+    row.time_to_expiry = &T;
+    row.risk_free_rate = &r;
+    row.volatility = &sigma;
+    row.dividend_yield = &q;
+    row.is_call = &call;
+    row.count = 1;
+    
+    BatchOutput out;
+    out.price = (outputs & OutputFlags::PRICE) ? &result.price : nullptr;
+    out.delta = (outputs & OutputFlags::DELTA) ? &result.greeks.delta : nullptr;
+    out.gamma = (outputs & OutputFlags::GAMMA) ? &result.greeks.gamma : nullptr;
+    out.theta = (outputs & OutputFlags::THETA) ? &result.greeks.theta : nullptr;
+    out.vega = (outputs & OutputFlags::VEGA) ? &result.greeks.vega : nullptr;
+    out.rho = (outputs & OutputFlags::RHO) ? &result.greeks.rho : nullptr;
+    out.status = &result.status;
+    price_run(row, out, 0, 1, exercise, outputs);
+    return result;
+}
+
+size_t CrankNicolsonEngine::price_rows(const BatchInput& input, const BatchOutput& output,
+                                       ExerciseStyle exercise) const {
+    if (input.spot_price == nullptr || input.strike_price == nullptr || input.time_to_expiry == nullptr ||
+        input.risk_free_rate == nullptr || input.volatility == nullptr || input.is_call == nullptr) {
+        return PricingEngine<CrankNicolsonEngine>::price_rows(input, output, exercise);
+    }
+    
+    const uint32_t outputs = requested_outputs(output);
+    const auto dividend = [&](size_t i) { return input.dividend_yield != nullptr ? input.dividend_yield[i] : 0.0; };
+    const auto row_status = [&](size_t i) {
+        return OptionPricer::validate_row(input.spot_price[i], input.strike_price[i], input.time_to_expiry[i],
+                                          input.risk_free_rate[i], input.volatility[i], dividend(i));
+    };
+    
+    // Runs of valid rows with equal (T, r, σ, q, type) share one grid
+    size_t priced = 0;
+    size_t i = 0;
+    while (i < input.count) {
+        const uint32_t status = row_status(i);
+        if (status != BatchStatus::OK) {
+            store(output, i, failed(status));
+            ++i;
+            continue;
+        }
+        size_t end = i + 1;
+        while (end < input.count && input.time_to_expiry[end] == input.time_to_expiry[i] &&
+               input.risk_free_rate[end] == input.risk_free_rate[i] && input.volatility[end] == input.volatility[i] &&
+               dividend(end) == dividend(i) && (input.is_call[end] != 0) == (input.is_call[i] != 0) &&
+               row_status(end) == BatchStatus::OK) {
+            ++end;
+        }
+        priced += price_run(input, output, i, end, exercise, outputs);
+        i = end;
+    }
+    return priced;
+}
+
+} // namespace BlackScholes
@@ -0,0 +1,186 @@
+#include "gpu_backend.hpp"
+#include "philox.hpp"
+#include "../config/config.hpp"
+#include "../utils/metrics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace BlackScholes {
+
+const char* to_string(GpuBackend backend) noexcept {
+    switch (backend) {
+        case GpuBackend::CPU:   return "CPU";
+        case GpuBackend::CUDA:  return "CUDA";
+        default:                return "UNKNOWN";
+    }
+}
+
+GpuOptions GpuOptions::from_config() {
+    GpuOptions options;
+    const auto& config = Config::ConfigManager::getInstance().snapshot();
+    options.enabled = config.gpu.enabled;
+    options.device = std::max(config.gpu.device, 0);
+    options.min_batch_rows = static_cast<size_t>(std::max(config.gpu.min_batch_rows, 0));
+    options.min_paths = static_cast<uint64_t>(std::max(config.gpu.min_paths, 0));
+    options.chunk_rows = static_cast<size_t>(std::max(config.gpu.chunk_rows, 1));
+    options.streams = static_cast<uint32_t>(std::clamp(config.gpu.streams, 1, 16));
+    return options;
+}
+
+namespace Gpu {
+
+#ifndef BLACKSCHOLES_CUDA
+// Built without `make cuda`: there is no device and every call falls back
+namespace detail {
+
+int device_count() noexcept {
+    return 0;
+}
+
+std::string device_name(int) {
+    return "none";
+}
+
+bool price_batch(const BatchInput&, const BatchOutput&, const GpuOptions&, size_t&) noexcept {
+    return false;
+}
+
+bool simulate(const DeviceSimulation&, const GpuOptions&, double*, double*, size_t) noexcept {
+    return false;
+}
+
+} // namespace detail
+#endif
+
+namespace {
+
+bool is_barrier(PathPayoff payoff) noexcept {
+    return payoff == PathPayoff::UP_AND_OUT || payoff == PathPayoff::DOWN_AND_OUT ||
+           payoff == PathPayoff::UP_AND_IN || payoff == PathPayoff::DOWN_AND_IN;
+}
+
+bool has_required_columns(const BatchInput& input) noexcept {
+    return input.spot_price != nullptr && input.strike_price != nullptr && input.time_to_expiry != nullptr &&
+           input.risk_free_rate != nullptr && input.volatility != nullptr && input.is_call != nullptr;
+}
+
+} // namespace
+
+bool available(int device) noexcept {
+    return device >= 0 && device < detail::device_count();
+}
+
+std::string device_name(int device) {
+    return available(device) ? detail::device_name(device) : std::string("none");
+}
+
+GpuBackend batch_backend(size_t rows, const GpuOptions& options) noexcept {
+    return options.enabled && rows > 0 && rows >= options.min_batch_rows && available(options.device)
+               ? GpuBackend::CUDA
+               : GpuBackend::CPU;
+}
+
+GpuBackend monte_carlo_backend(const MonteCarloOptions& mc, const GpuOptions& options) noexcept {
+    return options.enabled && mc.sampling == MonteCarloSampling::PSEUDO_RANDOM &&
+                   mc.simulations >= options.min_paths && available(options.device)
+               ? GpuBackend::CUDA
+               : GpuBackend::CPU;
+}
+
+size_t price_batch(const BatchInput& input, const BatchOutput& output, const GpuOptions& options,
+                   GpuBackend* used) noexcept {
+    size_t priced = 0;
+    if (has_required_columns(input) && batch_backend(input.count, options) == GpuBackend::CUDA &&
+        detail::price_batch(input, output, options, priced)) {
+        Utils::Metrics::add(Utils::MetricCounter::OPTIONS_PRICED, priced);
+        Utils::Metrics::add(Utils::MetricCounter::OPTIONS_REJECTED, input.count - priced);
+        if (used != nullptr) {
+            *used = GpuBackend::CUDA;
+        }
+        return priced;
+    }
+    
+    // The CPU pricer rewrites every output, so a device failure part way through leaves no trace
+    if (used != nullptr) {
+        *used = GpuBackend::CPU;
+    }
+    return OptionPricer::price_batch(input, output);
+}
+
+MonteCarloResult price_monte_carlo(const Parameters& params, const PathContract& contract,
+                                   const MonteCarloOptions& mc, const GpuOptions& options, GpuBackend* used) {
+    if (used != nullptr) {
+        *used = GpuBackend::CPU;
+    }
+    
+    // Same sample count and path constants as MonteCarloEngine::simulate()
+    const uint64_t paths = mc.antithetic ? mc.simulations + (mc.simulations & 1) : mc.simulations;
+    const uint64_t samples = mc.antithetic ? paths / 2 : paths;
+    const uint32_t samples_per_block = static_cast<uint32_t>(
+        mc.antithetic ? MonteCarloEngine::BLOCK_PATHS / 2 : MonteCarloEngine::BLOCK_PATHS);
+    const uint64_t blocks = (samples + samples_per_block - 1) / samples_per_block;
+    
+    // Anything the engine would reject is left to it, so errors read the same on both backends
+    const bool supported = monte_carlo_backend(mc, options) == GpuBackend::CUDA && samples >= 2 && mc.steps > 0 &&
+                           blocks <= static_cast<uint64_t>(std::numeric_limits<int>::max()) && params.is_valid() &&
+                           (!is_barrier(contract.payoff) || (contract.barrier > 0.0 && std::isfinite(contract.barrier)));
+    if (!supported) {
+        return MonteCarloEngine(mc).price(params, contract);
+    }
+    
+    detail::DeviceSimulation setup;
+    setup.steps = contract.payoff == PathPayoff::EUROPEAN ? 1u : mc.steps;
+    const double dt = params.time_to_expiry / setup.steps;
+    const double sigma = params.volatility;
+    setup.log_spot = std::log(params.spot_price);
+    setup.strike = params.strike_price;
+    setup.drift = (params.risk_free_rate - params.dividend_yield - 0.5 * sigma * sigma) * dt;
+    setup.diffusion = sigma * std::sqrt(dt);
+    setup.barrier = contract.barrier;
+    const Random::Philox4x32::Key key = Random::Philox4x32::key_from_seed(mc.seed);
+    setup.key[0] = key[0];
+    setup.key[1] = key[1];
+    setup.samples_per_block = samples_per_block;
+    setup.samples = samples;
+    setup.payoff = contract.payoff;
+    setup.is_call = contract.is_call;
+    setup.antithetic = mc.antithetic;
+    
+    std::vector<double> block_sum(static_cast<size_t>(blocks));
+    std::vector<double> block_sum_sq(static_cast<size_t>(blocks));
+    if (!detail::simulate(setup, options, block_sum.data(), block_sum_sq.data(), block_sum.size())) {
+        return MonteCarloEngine(mc).price(params, contract);
+    }
+    
+    // Combine in block order, as MonteCarloEngine::simulate() does
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    for (size_t block = 0; block < block_sum.size(); ++block) {
+        sum += block_sum[block];
+        sum_sq += block_sum_sq[block];
+    }
+    const double n = static_cast<double>(samples);
+    const double mean = sum / n;
+    const double variance_of_mean = std::max(sum_sq / n - mean * mean, 0.0) / (n - 1.0);
+    const double discount = std::exp(-params.risk_free_rate * params.time_to_expiry);
+    
+    MonteCarloResult result;
+    result.price = discount * mean;
+    result.std_error = discount * std::sqrt(variance_of_mean);
+    result.paths = paths;
+    result.threads = 1;
+    result.is_valid = std::isfinite(result.price);
+    if (!result.is_valid) {
+        result.error_msg = "Non-finite Monte Carlo estimate";
+    }
+    if (used != nullptr) {
+        *used = GpuBackend::CUDA;
+    }
+    return result;
+}
+
+} // namespace Gpu
+
+} // namespace BlackScholes
@@ -0,0 +1,451 @@
+#include "gpu_backend.hpp"
+#include "philox.hpp"
+#include <cuda_runtime.h>
+#include <math_constants.h>
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+/**
+ * @file gpu_backend.cu
+ * @brief CUDA kernels and stream pipeline behind gpu_backend.hpp
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * Compiled only by `make cuda` (nvcc -DBLACKSCHOLES_CUDA -fmad=false
+ * --expt-relaxed-constexpr). -fmad=false keeps a·b + c unfused, as in the
+ * portable CPU kernels, so the path arithmetic rounds like the host's;
+ * relaxed constexpr lets the device use the std::array types of philox.hpp.
+ */
+
+namespace BlackScholes {
+namespace Gpu {
+namespace detail {
+
+namespace {
+
+constexpr int BATCH_THREADS = 256;
+constexpr size_t INPUT_COLUMNS = 6;     // S, K, T, r, σ, q
+constexpr size_t OUTPUT_COLUMNS = 6;    // price, delta, gamma, theta, vega, rho
+
+// ---------------------------------------------------------------------------
+// Closed-form batch kernel: OptionPricer::price_batch() row by row
+// ---------------------------------------------------------------------------
+
+__device__ double normal_cdf(double x) {
+    return 0.5 * erfc(-x * 0.70710678118654752440);
+}
+
+__device__ double normal_pdf(double x) {
+    return 0.39894228040143267794 * exp(-0.5 * x * x);
+}
+
+__device__ void store_row(double* column, size_t i, double value) {
+    if (column != nullptr) {
+        column[i] = value;
+    }
+}
+
+// Device pointers of one chunk; null output columns are not computed
+struct BatchColumns {
+    const double* input[INPUT_COLUMNS];     // q may be null (zero dividend)
+    const uint8_t* is_call;
+    double* output[OUTPUT_COLUMNS];
+    uint32_t* status;
+    size_t rows;
+};
+
+__global__ void price_kernel(BatchColumns columns) {
+    const size_t i = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    if (i >= columns.rows) {
+        return;
+    }
+    const double S = columns.input[0][i];
+    const double K = columns.input[1][i];
+    const double T = columns.input[2][i];
+    const double r = columns.input[3][i];
+    const double sigma = columns.input[4][i];
+    const double q = columns.input[5] != nullptr ? columns.input[5][i] : 0.0;
+    
+    // Same flags as OptionPricer::validate_row()
+    uint32_t status = BatchStatus::OK;
+    if (!(S > 0.0)) status |= BatchStatus::INVALID_SPOT;
+    if (!(K > 0.0)) status |= BatchStatus::INVALID_STRIKE;
+    if (!(T > 0.0)) status |= BatchStatus::INVALID_EXPIRY;
+    if (!(r >= 0.0)) status |= BatchStatus::INVALID_RATE;
+    if (!(sigma > 0.0)) status |= BatchStatus::INVALID_VOLATILITY;
+    if (!(q >= 0.0)) status |= BatchStatus::INVALID_DIVIDEND;
+    
+    double price = 0.0;
+    if (status == BatchStatus::OK) {
+        const double sign = columns.is_call[i] != 0 ? 1.0 : -1.0;
+        const double sqrt_T = sqrt(T);
+        const double sigma_sqrt_T = sigma * sqrt_T;
+        const double discount_factor = exp(-r * T);
+        const double dividend_factor = exp(-q * T);
+        const double d1 = (log(S / K) + (r - q + 0.5 * sigma * sigma) * T) / sigma_sqrt_T;
+        const double N_d1 = normal_cdf(sign * d1);
+        const double N_d2 = normal_cdf(sign * (d1 - sigma_sqrt_T));
+        price = sign * (S * dividend_factor * N_d1 - K * discount_factor * N_d2);
+        if (!isfinite(price)) {
+            status = BatchStatus::NUMERICAL_ERROR;
+        } else {
+            const double phi_d1 = normal_pdf(d1);
+            const double S_dividend_phi = S * dividend_factor * phi_d1;
+            store_row(columns.output[0], i, price);
+            store_row(columns.output[1], i, sign * dividend_factor * N_d1);
+            store_row(columns.output[2], i, dividend_factor * phi_d1 / (S * sigma_sqrt_T));
+            store_row(columns.output[3], i, (-S_dividend_phi * sigma / (2.0 * sqrt_T) +
+                                             sign * (q * S * dividend_factor * N_d1 -
+                                                     r * K * discount_factor * N_d2)) / 365.0);
+            store_row(columns.output[4], i, S_dividend_phi * sqrt_T / 100.0);
+            store_row(columns.output[5], i, sign * K * T * discount_factor * N_d2 / 100.0);
+        }
+    }
+    if (status != BatchStatus::OK) {
+        for (size_t c = 0; c < OUTPUT_COLUMNS; ++c) {
+            store_row(columns.output[c], i, CUDART_NAN);
+        }
+    }
+    columns.status[i] = status;
+}
+
+// ---------------------------------------------------------------------------
+// Stream pipeline
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Pinned staging and device buffers of one stream, sized to one chunk
+ */
+struct StreamBuffers {
+    cudaStream_t stream = nullptr;
+    double* host = nullptr;             // INPUT_COLUMNS + OUTPUT_COLUMNS columns, pinned
+    uint8_t* host_call = nullptr;
+    uint32_t* host_status = nullptr;
+    double* device = nullptr;
+    uint8_t* device_call = nullptr;
+    uint32_t* device_status = nullptr;
+    size_t first = 0;                   // Chunk in flight: rows [first, first + rows)
+    size_t rows = 0;
+};
+
+/**
+ * @brief Buffers kept for the life of the process and grown on demand
+ *
+ * Never freed at exit: the CUDA runtime tears itself down in its own
+ * static destructor and may already be gone.
+ */
+struct BatchContext {
+    std::mutex mutex;
+    int device = -1;
+    size_t capacity = 0;
+    std::vector<StreamBuffers> streams;
+    
+    void release() noexcept {
+        for (StreamBuffers& buffers : streams) {
+            cudaFreeHost(buffers.host);
+            cudaFreeHost(buffers.host_call);
+            cudaFreeHost(buffers.host_status);
+            cudaFree(buffers.device);
+            cudaFree(buffers.device_call);
+            cudaFree(buffers.device_status);
+            if (buffers.stream != nullptr) {
+                cudaStreamDestroy(buffers.stream);
+            }
+        }
+        streams.clear();
+        capacity = 0;
+    }
+    
+    bool reserve(int ordinal, uint32_t count, size_t rows) noexcept {
+        if (ordinal == device && streams.size() == count && capacity >= rows) {
+            return true;
+        }
+        release();
+        device = ordinal;
+        if (cudaSetDevice(ordinal) != cudaSuccess) {
+            return false;
+        }
+        const size_t doubles = (INPUT_COLUMNS + OUTPUT_COLUMNS) * rows * sizeof(double);
+        streams.resize(count);
+        for (StreamBuffers& buffers : streams) {
+            if (cudaStreamCreateWithFlags(&buffers.stream, cudaStreamNonBlocking) != cudaSuccess ||
+                cudaHostAlloc(reinterpret_cast<void**>(&buffers.host), doubles, cudaHostAllocDefault) != cudaSuccess ||
+                cudaHostAlloc(reinterpret_cast<void**>(&buffers.host_call), rows, cudaHostAllocDefault) != cudaSuccess ||
+                cudaHostAlloc(reinterpret_cast<void**>(&buffers.host_status), rows * sizeof(uint32_t),
+                              cudaHostAllocDefault) != cudaSuccess ||
+                cudaMalloc(reinterpret_cast<void**>(&buffers.device), doubles) != cudaSuccess ||
+                cudaMalloc(reinterpret_cast<void**>(&buffers.device_call), rows) != cudaSuccess ||
+                cudaMalloc(reinterpret_cast<void**>(&buffers.device_status), rows * sizeof(uint32_t)) != cudaSuccess) {
+                release();
+                return false;
+            }
+        }
+        capacity = rows;
+        return true;
+    }
+};
+
+BatchContext& batch_context() {
+    static BatchContext* context = new BatchContext();
+    return *context;
+}
+
+// Stage rows [first, first + rows) on a stream: pinned copy, upload, kernel, download
+bool launch_chunk(StreamBuffers& buffers, size_t capacity, const BatchInput& input, const BatchOutput& output,
+                  size_t first, size_t rows) noexcept {
+    const double* const inputs[INPUT_COLUMNS] = {input.spot_price, input.strike_price, input.time_to_expiry,
+                                                 input.risk_free_rate, input.volatility, input.dividend_yield};
+    double* const outputs[OUTPUT_COLUMNS] = {output.price, output.delta, output.gamma,
+                                             output.theta, output.vega, output.rho};
+    BatchColumns columns;
+    for (size_t c = 0; c < INPUT_COLUMNS; ++c) {
+        columns.input[c] = nullptr;
+        if (inputs[c] == nullptr) {
+            continue;
+        }
+        std::memcpy(buffers.host + c * capacity, inputs[c] + first, rows * sizeof(double));
+        if (cudaMemcpyAsync(buffers.device + c * capacity, buffers.host + c * capacity, rows * sizeof(double),
+                            cudaMemcpyHostToDevice, buffers.stream) != cudaSuccess) {
+            return false;
+        }
+        columns.input[c] = buffers.device + c * capacity;
+    }
+    std::memcpy(buffers.host_call, input.is_call + first, rows);
+    if (cudaMemcpyAsync(buffers.device_call, buffers.host_call, rows, cudaMemcpyHostToDevice,
+                        buffers.stream) != cudaSuccess) {
+        return false;
+    }
+    columns.is_call = buffers.device_call;
+    for (size_t c = 0; c < OUTPUT_COLUMNS; ++c) {
+        columns.output[c] = outputs[c] != nullptr ? buffers.device + (INPUT_COLUMNS + c) * capacity : nullptr;
+    }
+    columns.status = buffers.device_status;
+    columns.rows = rows;
+    
+    const unsigned grid = static_cast<unsigned>((rows + BATCH_THREADS - 1) / BATCH_THREADS);
+    price_kernel<<<grid, BATCH_THREADS, 0, buffers.stream>>>(columns);
+    if (cudaGetLastError() != cudaSuccess) {
+        return false;
+    }
+    
+    for (size_t c = 0; c < OUTPUT_COLUMNS; ++c) {
+        if (columns.output[c] != nullptr &&
+            cudaMemcpyAsync(buffers.host + (INPUT_COLUMNS + c) * capacity, columns.output[c], rows * sizeof(double),
+                            cudaMemcpyDeviceToHost, buffers.stream) != cudaSuccess) {
+            return false;
+        }
+    }
+    if (cudaMemcpyAsync(buffers.host_status, buffers.device_status, rows * sizeof(uint32_t),
+                        cudaMemcpyDeviceToHost, buffers.stream) != cudaSuccess) {
+        return false;
+    }
+    buffers.first = first;
+    buffers.rows = rows;
+    return true;
+}
+
+// Wait for a stream's chunk and copy it out of pinned memory; returns false on a device error
+bool finish_chunk(StreamBuffers& buffers, size_t capacity, const BatchOutput& output, size_t& priced) noexcept {
+    if (buffers.rows == 0) {
+        return true;
+    }
+    const size_t first = buffers.first;
+    const size_t rows = buffers.rows;
+    buffers.rows = 0;
+    if (cudaStreamSynchronize(buffers.stream) != cudaSuccess) {
+        return false;
+    }
+    double* const outputs[OUTPUT_COLUMNS] = {output.price, output.delta, output.gamma,
+                                             output.theta, output.vega, output.rho};
+    for (size_t c = 0; c < OUTPUT_COLUMNS; ++c) {
+        if (outputs[c] != nullptr) {
+            std::memcpy(outputs[c] + first, buffers.host + (INPUT_COLUMNS + c) * capacity, rows * sizeof(double));
+        }
+    }
+    if (output.status != nullptr) {
+        std::memcpy(output.status + first, buffers.host_status, rows * sizeof(uint32_t));
+    }
+    priced += static_cast<size_t>(std::count(buffers.host_status, buffers.host_status + rows, BatchStatus::OK));
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Monte Carlo kernel: MonteCarloEngine's pseudo-random paths, one thread per sample
+// ---------------------------------------------------------------------------
+
+__device__ double vanilla(bool is_call, double spot, double strike) {
+    return fmax(is_call ? spot - strike : strike - spot, 0.0);
+}
+
+// Mirrors path_payoff() in monte_carlo.cpp
+__device__ double path_payoff(const DeviceSimulation& setup, double S_T, double S_max, double S_min, double mean) {
+    const bool is_call = setup.is_call;
+    const double K = setup.strike;
+    const double barrier = setup.barrier;
+    switch (setup.payoff) {
+        case PathPayoff::EUROPEAN:
+            return vanilla(is_call, S_T, K);
+        case PathPayoff::ASIAN_ARITHMETIC:
+        case PathPayoff::ASIAN_GEOMETRIC:
+            return vanilla(is_call, mean, K);
+        case PathPayoff::UP_AND_OUT:
+            return S_max >= barrier ? 0.0 : vanilla(is_call, S_T, K);
+        case PathPayoff::DOWN_AND_OUT:
+            return S_min <= barrier ? 0.0 : vanilla(is_call, S_T, K);
+        case PathPayoff::UP_AND_IN:
+            return S_max >= barrier ? vanilla(is_call, S_T, K) : 0.0;
+        case PathPayoff::DOWN_AND_IN:
+            return S_min <= barrier ? vanilla(is_call, S_T, K) : 0.0;
+        case PathPayoff::LOOKBACK_FLOATING:
+            return is_call ? S_T - S_min : S_max - S_T;
+        case PathPayoff::LOOKBACK_FIXED:
+            return is_call ? fmax(S_max - K, 0.0) : fmax(K - S_min, 0.0);
+    }
+    return 0.0;
+}
+
+// One sample (an antithetic pair counts once) with the counters of simulate_block()
+__device__ double simulate_sample(const DeviceSimulation& setup, uint64_t sample) {
+    const PathPayoff payoff = setup.payoff;
+    const bool asian = payoff == PathPayoff::ASIAN_ARITHMETIC || payoff == PathPayoff::ASIAN_GEOMETRIC;
+    const bool track_extremes = payoff != PathPayoff::EUROPEAN && !asian;
+    const int lanes = setup.antithetic ? 2 : 1;
+    const Random::Philox4x32::Key key{{setup.key[0], setup.key[1]}};
+    
+    double log_s[2] = {setup.log_spot, setup.log_spot};
+    double high[2] = {setup.log_spot, setup.log_spot};
+    double low[2] = {setup.log_spot, setup.log_spot};
+    double average[2] = {0.0, 0.0};
+    for (uint32_t step = 0; step < setup.steps; step += 2) {
+        const Random::Philox4x32::Counter words = Random::Philox4x32::generate(
+            Random::Philox4x32::Counter{{step / 2, 0u, static_cast<uint32_t>(sample),
+                                         static_cast<uint32_t>(sample >> 32)}},
+            key);
+        const double z[2] = {normcdfinv(Random::to_unit_interval(words[0], words[1])),
+                             normcdfinv(Random::to_unit_interval(words[2], words[3]))};
+        for (uint32_t sub = 0; sub < 2 && step + sub < setup.steps; ++sub) {
+            log_s[0] += setup.drift + setup.diffusion * z[sub];
+            log_s[1] += setup.drift - setup.diffusion * z[sub];
+            for (int lane = 0; lane < lanes; ++lane) {
+                if (track_extremes) {
+                    high[lane] = fmax(high[lane], log_s[lane]);
+                    low[lane] = fmin(low[lane], log_s[lane]);
+                }
+                if (payoff == PathPayoff::ASIAN_ARITHMETIC) {
+                    average[lane] += exp(log_s[lane]);
+                } else if (payoff == PathPayoff::ASIAN_GEOMETRIC) {
+                    average[lane] += log_s[lane];
+                }
+            }
+        }
+    }
+    
+    double payoffs[2] = {0.0, 0.0};
+    for (int lane = 0; lane < lanes; ++lane) {
+        double mean = average[lane] / setup.steps;
+        if (payoff == PathPayoff::ASIAN_GEOMETRIC) {
+            mean = exp(mean);
+        }
+        payoffs[lane] = path_payoff(setup, exp(log_s[lane]), track_extremes ? exp(high[lane]) : high[lane],
+                                    track_extremes ? exp(low[lane]) : low[lane], mean);
+    }
+    return setup.antithetic ? 0.5 * (payoffs[0] + payoffs[1]) : payoffs[0];
+}
+
+// One CUDA block per engine block; samples are summed in index order like the CPU block loop
+__global__ void simulate_kernel(DeviceSimulation setup, double* block_sum, double* block_sum_sq) {
+    extern __shared__ double samples[];
+    const uint64_t sample = static_cast<uint64_t>(blockIdx.x) * setup.samples_per_block + threadIdx.x;
+    samples[threadIdx.x] = sample < setup.samples ? simulate_sample(setup, sample) : 0.0;
+    __syncthreads();
+    
+    if (threadIdx.x == 0) {
+        const uint64_t first = static_cast<uint64_t>(blockIdx.x) * setup.samples_per_block;
+        const uint64_t remaining = setup.samples - first;
+        const uint64_t count = remaining < setup.samples_per_block ? remaining : setup.samples_per_block;
+        double sum = 0.0;
+        double sum_sq = 0.0;
+        for (uint64_t k = 0; k < count; ++k) {
+            sum += samples[k];
+            sum_sq += samples[k] * samples[k];
+        }
+        block_sum[blockIdx.x] = sum;
+        block_sum_sq[blockIdx.x] = sum_sq;
+    }
+}
+
+} // namespace
+
+int device_count() noexcept {
+    static const int count = [] {
+        int devices = 0;
+        return cudaGetDeviceCount(&devices) == cudaSuccess ? devices : 0;
+    }();
+    return count;
+}
+
+std::string device_name(int device) {
+    cudaDeviceProp properties;
+    if (cudaGetDeviceProperties(&properties, device) != cudaSuccess) {
+        return "none";
+    }
+    return properties.name;
+}
+
+bool price_batch(const BatchInput& input, const BatchOutput& output, const GpuOptions& options,
+                 size_t& priced) noexcept {
+    BatchContext& context = batch_context();
+    std::lock_guard<std::mutex> lock(context.mutex);
+    const size_t chunk = std::min(std::max<size_t>(options.chunk_rows, 1), input.count);
+    const uint32_t stream_count = std::max<uint32_t>(options.streams, 1);
+    if (!context.reserve(options.device, stream_count, chunk) || cudaSetDevice(options.device) != cudaSuccess) {
+        return false;
+    }
+    
+    // Chunk c runs on stream c % streams; reusing a stream first drains its previous chunk,
+    // so staging the next chunk on the host overlaps the other streams' copies and kernels
+    priced = 0;
+    bool ok = true;
+    size_t chunk_index = 0;
+    for (size_t first = 0; ok && first < input.count; first += chunk, ++chunk_index) {
+        StreamBuffers& buffers = context.streams[chunk_index % stream_count];
+        ok = finish_chunk(buffers, context.capacity, output, priced) &&
+             launch_chunk(buffers, context.capacity, input, output, first, std::min(chunk, input.count - first));
+    }
+    for (size_t s = 0; s < stream_count; ++s) {
+        StreamBuffers& buffers = context.streams[(chunk_index + s) % stream_count];
+        if (ok) {
+            ok = finish_chunk(buffers, context.capacity, output, priced);
+        } else {
+            cudaStreamSynchronize(buffers.stream);
+            buffers.rows = 0;
+        }
+    }
+    return ok;
+}
+
+bool simulate(const DeviceSimulation& setup, const GpuOptions& options, double* block_sum,
+              double* block_sum_sq, size_t blocks) noexcept {
+    if (blocks == 0 || cudaSetDevice(options.device) != cudaSuccess) {
+        return false;
+    }
+    double* sums = nullptr;
+    if (cudaMalloc(reinterpret_cast<void**>(&sums), 2 * blocks * sizeof(double)) != cudaSuccess) {
+        return false;
+    }
+    const unsigned threads = setup.samples_per_block;
+    simulate_kernel<<<static_cast<unsigned>(blocks), threads, threads * sizeof(double)>>>(setup, sums, sums + blocks);
+    const bool ok = cudaGetLastError() == cudaSuccess &&
+                    cudaMemcpy(block_sum, sums, blocks * sizeof(double), cudaMemcpyDeviceToHost) == cudaSuccess &&
+                    cudaMemcpy(block_sum_sq, sums + blocks, blocks * sizeof(double),
+                               cudaMemcpyDeviceToHost) == cudaSuccess;
+    cudaFree(sums);
+    return ok;
+}
+
+} // namespace detail
+} // namespace Gpu
+} // namespace BlackScholes
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "black_scholes.hpp"
+#include "monte_carlo.hpp"
+
+/**
+ * @file gpu_backend.hpp
+ * @brief Optional CUDA offload for batch pricing and Monte Carlo, with CPU fallback
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * The default build has no GPU dependency and every call here runs on the
+ * CPU. `make cuda` additionally compiles gpu_backend.cu with nvcc, defines
+ * BLACKSCHOLES_CUDA and links the CUDA runtime; then, with gpu.enabled set
+ * and a device present, large work is offloaded:
+ * - Gpu::price_batch() streams a batch through the device in chunks of
+ *   gpu.chunk_rows. Each of gpu.streams CUDA streams owns pinned host and
+ *   device buffers, so one chunk's host-to-device copy, another's kernel
+ *   and a third's device-to-host copy overlap.
+ * - Gpu::price_monte_carlo() runs one device thread per sample. The
+ *   device includes philox.hpp, so every (sample, step) counter yields the
+ *   same Philox words and uniforms as the CPU engine bit for bit; normals
+ *   and payoffs then agree to the last bits of the device libm, and block
+ *   sums are combined in block order as on the CPU.
+ *
+ * Batches below gpu.min_batch_rows and simulations below gpu.min_paths
+ * stay on the CPU, where the PCIe transfer would cost more than it saves,
+ * as does anything the device path does not cover (Sobol sampling,
+ * missing input columns) or any device error. Typical use:
+ *
+ *   GpuBackend used;
+ *   Gpu::price_batch(input, output, GpuOptions::from_config(), &used);
+ *   MonteCarloResult mc = Gpu::price_monte_carlo(params, contract, MonteCarloOptions::from_config());
+ */
+
+namespace BlackScholes {
+
+/**
+ * @brief Where a call ran
+ */
+enum class GpuBackend : uint8_t {
+    CPU = 0,    ///< Host pricer or MonteCarloEngine
+    CUDA = 1    ///< CUDA device
+};
+
+/**
+ * @brief Convert backend to string representation
+ * @param backend Backend to convert
+ * @return String representation of backend
+ */
+const char* to_string(GpuBackend backend) noexcept;
+
+/**
+ * @brief Offload settings
+ */
+struct GpuOptions {
+    bool enabled = false;               ///< Offload at all
+    int device = 0;                     ///< CUDA device ordinal
+    size_t min_batch_rows = 65536;      ///< Smaller batches are priced on the CPU
+    uint64_t min_paths = 1048576;       ///< Smaller simulations run on the CPU
+    size_t chunk_rows = 262144;         ///< Rows per stream chunk
+    uint32_t streams = 3;               ///< Streams cycling through the chunks
+    
+    /**
+     * @brief Read gpu.* settings
+     * @return Options populated from configuration
+     */
+    static GpuOptions from_config();
+};
+
+namespace Gpu {
+
+/**
+ * @brief Whether this build has CUDA support and the device exists
+ */
+bool available(int device = 0) noexcept;
+
+/**
+ * @brief Device name ("none" without CUDA support or device)
+ */
+std::string device_name(int device = 0);
+
+/**
+ * @brief Backend price_batch() would use for a batch
+ */
+GpuBackend batch_backend(size_t rows, const GpuOptions& options) noexcept;
+
+/**
+ * @brief Backend price_monte_carlo() would use for a simulation
+ */
+GpuBackend monte_carlo_backend(const MonteCarloOptions& mc, const GpuOptions& options) noexcept;
+
+/**
+ * @brief Price a batch on the device, or with OptionPricer::price_batch() when it would not pay off
+ *
+ * Same columns, statuses and units as OptionPricer::price_batch().
+ *
+ * @param input Input columns
+ * @param output Output columns
+ * @param options Offload settings
+ * @param used Receives the backend that priced the batch (optional)
+ * @return Number of rows priced successfully
+ */
+size_t price_batch(const BatchInput& input, const BatchOutput& output,
+                   const GpuOptions& options = GpuOptions::from_config(), GpuBackend* used = nullptr) noexcept;
+
+/**
+ * @brief Monte Carlo price on the device, or with MonteCarloEngine when it would not pay off
+ *
+ * Offloads pseudo-random sampling only; the estimate uses the CPU
+ * engine's draws, path construction and block combination.
+ *
+ * @param params Market parameters (volatility is used as the path volatility)
+ * @param contract Payoff terms
+ * @param mc Simulation settings (parallel and max_threads apply to the CPU fallback)
+ * @param options Offload settings
+ * @param used Receives the backend that ran the simulation (optional)
+ * @return Price and standard error, or is_valid = false with error_msg
+ */
+MonteCarloResult price_monte_carlo(const Parameters& params, const PathContract& contract,
+                                   const MonteCarloOptions& mc, const GpuOptions& options = GpuOptions::from_config(),
+                                   GpuBackend* used = nullptr);
+
+/**
+ * @brief Device entry points, defined by gpu_backend.cu in CUDA builds
+ *
+ * Each returns false when the device could not do the work, and the
+ * caller then falls back to the CPU.
+ */
+namespace detail {
+
+/**
+ * @brief Per-simulation constants of MonteCarloEngine's pseudo-random path
+ */
+struct DeviceSimulation {
+    double log_spot;        ///< ln S
+    double strike;          ///< K
+    double drift;           ///< (r - q - σ²/2)Δt
+    double diffusion;       ///< σ√Δt
+    double barrier;         ///< Barrier level (barrier payoffs only)
+    uint32_t key[2];        ///< Philox key from the seed
+    uint32_t steps;         ///< Monitoring dates
+    uint32_t samples_per_block;     ///< Samples per block (MonteCarloEngine::BLOCK_PATHS, halved when antithetic)
+    uint64_t samples;       ///< Samples (antithetic pairs count once)
+    PathPayoff payoff;      ///< Payoff type
+    bool is_call;           ///< Call or put
+    bool antithetic;        ///< Pair every path with its mirror image
+};
+
+int device_count() noexcept;
+std::string device_name(int device);
+bool price_batch(const BatchInput& input, const BatchOutput& output, const GpuOptions& options,
+                 size_t& priced) noexcept;
+bool simulate(const DeviceSimulation& setup, const GpuOptions& options, double* block_sum,
+              double* block_sum_sq, size_t blocks) noexcept;
+
+} // namespace detail
+
+} // namespace Gpu
+
+} // namespace BlackScholes
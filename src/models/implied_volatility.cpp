@@ -0,0 +1,469 @@
+#include "implied_volatility.hpp"
+#include "vector_math.hpp"
+#include "../utils/metrics.hpp"
+#include "../utils/thread_pool.hpp"
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+namespace BlackScholes {
+
+const char* to_string(IVFailure failure) noexcept {
+    switch (failure) {
+        case IVFailure::NONE:              return "NONE";
+        case IVFailure::INVALID_INPUT:     return "INVALID_INPUT";
+        case IVFailure::MISSING_INPUT:     return "MISSING_INPUT";
+        case IVFailure::BELOW_INTRINSIC:   return "BELOW_INTRINSIC";
+        case IVFailure::ABOVE_UPPER_BOUND: return "ABOVE_UPPER_BOUND";
+        case IVFailure::MAX_ITERATIONS:    return "MAX_ITERATIONS";
+        case IVFailure::NUMERICAL_ERROR:   return "NUMERICAL_ERROR";
+        default:                           return "UNKNOWN";
+    }
+}
+
+IVSolverOptions IVSolverOptions::from_config() {
+    IVSolverOptions options;
+    const auto& config = Config::ConfigManager::getInstance().snapshot();
+    options.max_iterations = config.implied_vol.max_iterations;
+    options.price_tolerance = config.implied_vol.tolerance;
+    return options;
+}
+
+namespace {
+
+constexpr size_t IV_BLOCK_SIZE = 64;
+constexpr double INV_SQRT_TWO = 0.70710678118654752440;
+
+// Relative price residual below which a lower-branch quote counts as converged
+constexpr double LOG_RESIDUAL_CAP = 1e-10;
+
+// Normalized OTM call value β(s) for x <= 0, in scalar precision
+double normalized_call(double x, double s) noexcept {
+    const double d1 = x / s + 0.5 * s;
+    const double d2 = d1 - s;
+    return std::exp(0.5 * x) * 0.5 * std::erfc(-d1 * INV_SQRT_TWO) -
+           std::exp(-0.5 * x) * 0.5 * std::erfc(-d2 * INV_SQRT_TWO);
+}
+
+/**
+ * @brief Tabulated inverse of β used as the initial guess
+ * 
+ * ln s is sampled on a 48×96 grid over u = √a / (1 + √a), with a = |x|,
+ * and v = 1 / (1 + √ℓ), with ℓ = -ln(β e^{-x/2}) (so β / e^{x/2} = e^{-ℓ}).
+ * In these coordinates ln s is smooth enough that bilinear interpolation
+ * has a median relative error of about 1e-4 over σ√T ∈ [0.02, 1.5] and
+ * |x| ≤ 2.4 σ√T, so Halley usually needs one or two steps. The table is
+ * built once, on first use, by bisection.
+ */
+class InitialGuessTable {
+public:
+    static const InitialGuessTable& instance() {
+        static const InitialGuessTable table;
+        return table;
+    }
+    
+    /**
+     * @brief Interpolated total volatility for a normalized quote
+     * @param x Folded log-moneyness (x <= 0)
+     * @param log_beta ln β of the target price
+     * @return Approximate s = σ√T
+     */
+    double guess(double x, double log_beta) const noexcept {
+        const double root_a = std::sqrt(-x);
+        const double u = root_a / (1.0 + root_a);
+        const double v = 1.0 / (1.0 + std::sqrt(std::max(0.5 * x - log_beta, 0.0)));
+        
+        const double fu = std::min(std::max(u / U_MAX * (NU - 1), 0.0), NU - 1.000001);
+        const double fv = std::min(std::max(v * NV - 0.5, 0.0), NV - 1.000001);
+        const size_t i = static_cast<size_t>(fu);
+        const size_t j = static_cast<size_t>(fv);
+        const double tu = fu - static_cast<double>(i);
+        const double tv = fv - static_cast<double>(j);
+        
+        const double log_s = (1.0 - tu) * ((1.0 - tv) * log_s_[i][j] + tv * log_s_[i][j + 1]) +
+                             tu * ((1.0 - tv) * log_s_[i + 1][j] + tv * log_s_[i + 1][j + 1]);
+        return std::exp(log_s);
+    }
+
+private:
+    static constexpr size_t NU = 48;
+    static constexpr size_t NV = 96;
+    static constexpr double U_MAX = 0.95;   ///< a ≤ 361
+    
+    double log_s_[NU][NV];
+    
+    InitialGuessTable() {
+        for (size_t i = 0; i < NU; ++i) {
+            const double root_a_ratio = U_MAX * static_cast<double>(i) / static_cast<double>(NU - 1);
+            const double root_a = root_a_ratio / (1.0 - root_a_ratio);
+            const double x = -root_a * root_a;
+            
+            for (size_t j = 0; j < NV; ++j) {
+                const double v = (static_cast<double>(j) + 0.5) / static_cast<double>(NV);
+                const double root_l = (1.0 - v) / v;
+                const double log_beta = 0.5 * x - root_l * root_l;
+                
+                // Bisection on ln s; β is increasing in s
+                double lo = -30.0;
+                double hi = 4.0;
+                for (int k = 0; k < 56; ++k) {
+                    const double mid = 0.5 * (lo + hi);
+                    if (std::log(normalized_call(x, std::exp(mid))) > log_beta) {
+                        hi = mid;
+                    } else {
+                        lo = mid;
+                    }
+                }
+                log_s_[i][j] = 0.5 * (lo + hi);
+            }
+        }
+    }
+};
+
+// Quotes per solve_batch_parallel() task; amortizes the scheduling cost
+constexpr size_t PARALLEL_IV_GRAIN = 1024;
+
+// Column shifted to start at row `begin` (null stays null)
+template <typename T>
+inline T* offset(T* column, size_t begin) noexcept {
+    return column != nullptr ? column + begin : nullptr;
+}
+
+void store_row(const IVBatchOutput& output, size_t i, double vol, uint32_t iterations,
+               IVFailure failure) noexcept {
+    if (output.implied_vol != nullptr) {
+        output.implied_vol[i] = failure == IVFailure::NONE ? vol : std::numeric_limits<double>::quiet_NaN();
+    }
+    if (output.iterations != nullptr) {
+        output.iterations[i] = iterations;
+    }
+    if (output.failure != nullptr) {
+        output.failure[i] = failure;
+    }
+}
+
+// Hot-path counters for one solve_batch() call
+inline void count_solves(size_t quotes, size_t converged, uint64_t iterations) noexcept {
+    Utils::Metrics::add(Utils::MetricCounter::IV_SOLVES, quotes);
+    Utils::Metrics::add(Utils::MetricCounter::IV_ITERATIONS, iterations);
+    Utils::Metrics::add(Utils::MetricCounter::IV_FAILURES, quotes - converged);
+}
+
+} // namespace
+
+size_t ImpliedVolatilitySolver::solve_batch(const IVBatchInput& input, const IVBatchOutput& output,
+                                            const IVSolverOptions& options) noexcept {
+    METRICS_LATENCY(Utils::MetricHistogram::IV_BATCH);
+    const bool missing_input = input.market_price == nullptr || input.spot_price == nullptr ||
+                               input.strike_price == nullptr || input.time_to_expiry == nullptr ||
+                               input.risk_free_rate == nullptr || input.is_call == nullptr;
+    if (missing_input) {
+        for (size_t i = 0; i < input.count; ++i) {
+            store_row(output, i, 0.0, 0, IVFailure::MISSING_INPUT);
+        }
+        count_solves(input.count, 0, 0);
+        return 0;
+    }
+    
+    const double inf = std::numeric_limits<double>::infinity();
+    const uint32_t max_iterations = static_cast<uint32_t>(std::max(options.max_iterations, 0));
+    const InitialGuessTable& table = InitialGuessTable::instance();
+    size_t converged = 0;
+    uint64_t total_iterations = 0;
+    
+    // Per-quote state, indexed by position in the block
+    double x[IV_BLOCK_SIZE];            // ln(F/K), folded to x <= 0
+    double exp_half_x[IV_BLOCK_SIZE];   // e^{x/2}
+    double beta_target[IV_BLOCK_SIZE];  // Normalized OTM call price
+    double log_target[IV_BLOCK_SIZE];   // ln β* (lower branch only)
+    double scale[IV_BLOCK_SIZE];        // Price = scale · β
+    double sqrt_T[IV_BLOCK_SIZE];
+    double s[IV_BLOCK_SIZE];            // Current total volatility σ√T
+    double table_s[IV_BLOCK_SIZE];      // Tabulated guess for s
+    double lo[IV_BLOCK_SIZE];           // Bracket on s
+    double hi[IV_BLOCK_SIZE];
+    double tolerance[IV_BLOCK_SIZE];    // Residual tolerance in objective units
+    bool lower_branch[IV_BLOCK_SIZE];
+    uint32_t iterations[IV_BLOCK_SIZE];
+    IVFailure failure[IV_BLOCK_SIZE];
+    
+    // Packed buffers for the quotes still iterating
+    size_t active[IV_BLOCK_SIZE];
+    double d1[IV_BLOCK_SIZE];
+    double d2[IV_BLOCK_SIZE];
+    double N_d1[IV_BLOCK_SIZE];
+    double N_d2[IV_BLOCK_SIZE];
+    double phi_d1[IV_BLOCK_SIZE];
+    double beta[IV_BLOCK_SIZE];
+    double log_beta[IV_BLOCK_SIZE];
+    
+    for (size_t base = 0; base < input.count; base += IV_BLOCK_SIZE) {
+        const size_t n = std::min(IV_BLOCK_SIZE, input.count - base);
+        
+        // Forward F = S·e^{(r-q)T}, discount D = e^{-rT}; invalid rows get placeholders
+        for (size_t j = 0; j < n; ++j) {
+            const size_t i = base + j;
+            const double T = input.time_to_expiry[i];
+            const double r = input.risk_free_rate[i];
+            const double q = input.dividend_yield != nullptr ? input.dividend_yield[i] : 0.0;
+            const double price = input.market_price[i];
+            
+            const bool valid = OptionPricer::validate_row(input.spot_price[i], input.strike_price[i],
+                                                          T, r, 1.0, q) == BatchStatus::OK &&
+                               price > 0.0 && std::isfinite(price);
+            failure[j] = valid ? IVFailure::NONE : IVFailure::INVALID_INPUT;
+            iterations[j] = 0;
+            table_s[j] = std::numeric_limits<double>::quiet_NaN();
+            
+            d1[j] = valid ? (r - q) * T : 0.0;  // Forward growth exponent
+            d2[j] = valid ? -r * T : 0.0;       // Discount exponent
+            sqrt_T[j] = valid ? T : 1.0;
+        }
+        
+        VectorMath::exp(d1, d1, n);
+        VectorMath::exp(d2, d2, n);
+        VectorMath::sqrt(sqrt_T, sqrt_T, n);
+        
+        // Fold to a normalized OTM call via put-call parity and put/call symmetry
+        for (size_t j = 0; j < n; ++j) {
+            const size_t i = base + j;
+            if (failure[j] != IVFailure::NONE) {
+                x[j] = 1.0;
+                scale[j] = 1.0;
+                beta_target[j] = 1.0;
+                continue;
+            }
+            
+            const double K = input.strike_price[i];
+            const double F = input.spot_price[i] * d1[j];
+            const double D = d2[j];
+            const double undiscounted = input.market_price[i] / D;
+            const double sign = input.is_call[i] != 0 ? 1.0 : -1.0;
+            const double intrinsic = std::max(sign * (F - K), 0.0);
+            const double upper = input.is_call[i] != 0 ? F : K;
+            
+            if (!(undiscounted > intrinsic)) {
+                failure[j] = IVFailure::BELOW_INTRINSIC;
+            } else if (!(undiscounted < upper)) {
+                failure[j] = IVFailure::ABOVE_UPPER_BOUND;
+            }
+            
+            const double root_FK = std::sqrt(F * K);
+            scale[j] = D * root_FK;
+            beta_target[j] = (undiscounted - intrinsic) / root_FK;
+            x[j] = F / K;
+        }
+        
+        VectorMath::log(x, x, n);
+        for (size_t j = 0; j < n; ++j) {
+            x[j] = -std::abs(x[j]);
+            d1[j] = 0.5 * x[j];
+        }
+        VectorMath::exp(d1, exp_half_x, n);
+        
+        // β at the inflection point s_c = √(2|x|) selects the branch: β(s_c) = e^{x/2}/2 - e^{-x/2} N(-s_c)
+        for (size_t j = 0; j < n; ++j) {
+            d2[j] = -std::sqrt(-2.0 * x[j]);
+        }
+        VectorMath::normal_cdf(d2, N_d2, n);
+        VectorMath::log(beta_target, log_target, n);
+        
+        size_t active_count = 0;
+        for (size_t j = 0; j < n; ++j) {
+            const size_t i = base + j;
+            if (failure[j] != IVFailure::NONE) {
+                continue;
+            }
+            if (!std::isfinite(beta_target[j]) || !std::isfinite(x[j]) || !(beta_target[j] > 0.0)) {
+                failure[j] = beta_target[j] > 0.0 ? IVFailure::NUMERICAL_ERROR : IVFailure::BELOW_INTRINSIC;
+                continue;
+            }
+            
+            const double s_c = -d2[j];
+            const double beta_c = 0.5 * exp_half_x[j] - N_d2[j] / exp_half_x[j];
+            lower_branch[j] = beta_target[j] < beta_c;
+            
+            double guess = table.guess(x[j], log_target[j]);
+            if (lower_branch[j]) {
+                lo[j] = 0.0;
+                hi[j] = s_c;
+                // d ln β ≈ dβ / β
+                tolerance[j] = std::min(options.price_tolerance / (scale[j] * beta_target[j]),
+                                        LOG_RESIDUAL_CAP);
+            } else {
+                lo[j] = s_c;
+                hi[j] = inf;
+                tolerance[j] = options.price_tolerance / scale[j];
+            }
+            
+            table_s[j] = guess;
+            if (input.guess_ratio != nullptr) {
+                // The table error is smooth, so last snapshot's correction still applies
+                const double ratio = input.guess_ratio[i];
+                if (ratio > 0.0 && std::isfinite(ratio)) {
+                    guess *= ratio;
+                }
+            }
+            if (input.initial_guess != nullptr) {
+                const double warm = input.initial_guess[i] * sqrt_T[j];
+                if (warm > 0.0 && std::isfinite(warm)) {
+                    guess = warm;
+                }
+            }
+            // Clamp onto the branch; quotes near s_c then start at the inflection point
+            if (guess > 0.0) {
+                guess = std::min(std::max(guess, lo[j]), hi[j]);
+            } else {
+                guess = std::isfinite(hi[j]) ? 0.5 * (lo[j] + hi[j]) : std::max(2.0 * lo[j], 0.5);
+            }
+            
+            s[j] = guess;
+            active[active_count++] = j;
+        }
+        
+        // Safeguarded Halley iteration over the packed unconverged quotes
+        for (uint32_t iteration = 0; active_count > 0; ++iteration) {
+            for (size_t k = 0; k < active_count; ++k) {
+                const size_t j = active[k];
+                d1[k] = x[j] / s[j] + 0.5 * s[j];
+                d2[k] = d1[k] - s[j];
+            }
+            
+            VectorMath::normal_cdf(d1, N_d1, active_count);
+            VectorMath::normal_cdf(d2, N_d2, active_count);
+            VectorMath::normal_pdf(d1, phi_d1, active_count);
+            for (size_t k = 0; k < active_count; ++k) {
+                const size_t j = active[k];
+                beta[k] = exp_half_x[j] * N_d1[k] - N_d2[k] / exp_half_x[j];
+            }
+            VectorMath::log(beta, log_beta, active_count);
+            
+            size_t still_active = 0;
+            for (size_t k = 0; k < active_count; ++k) {
+                const size_t j = active[k];
+                const double vega = exp_half_x[j] * phi_d1[k];         // ∂β/∂s
+                const double volga = vega * d1[k] * d2[k] / s[j];       // ∂²β/∂s²
+                
+                double f;
+                double f1;
+                double f2;
+                if (lower_branch[j]) {
+                    f = log_beta[k] - log_target[j];
+                    f1 = vega / beta[k];
+                    f2 = volga / beta[k] - f1 * f1;
+                } else {
+                    f = beta[k] - beta_target[j];
+                    f1 = vega;
+                    f2 = volga;
+                }
+                
+                if (std::abs(f) <= tolerance[j]) {
+                    continue;
+                }
+                if (iteration == max_iterations) {
+                    failure[j] = IVFailure::MAX_ITERATIONS;
+                    continue;
+                }
+                
+                // β is increasing in s, so the sign of f tightens the bracket
+                if (f > 0.0) {
+                    hi[j] = std::min(hi[j], s[j]);
+                } else if (f < 0.0) {
+                    lo[j] = std::max(lo[j], s[j]);
+                }
+                
+                const double newton = -f / f1;
+                const double halley = 0.5 * f * f2 / (f1 * f1);
+                double next = s[j] + (std::abs(halley) < 0.5 ? newton / (1.0 - halley) : newton);
+                if (!(next > lo[j] && next < hi[j])) {
+                    next = s[j] + newton;
+                }
+                if (!(next > lo[j] && next < hi[j])) {
+                    // Bisect (or expand an open upper bracket) when neither step is usable
+                    next = std::isfinite(hi[j]) ? 0.5 * (lo[j] + hi[j]) : 2.0 * s[j];
+                }
+                
+                const double step = std::abs(next - s[j]);
+                s[j] = next;
+                iterations[j] = iteration + 1;
+                if (step <= options.vol_tolerance * sqrt_T[j]) {
+                    continue;
+                }
+                active[still_active++] = j;
+            }
+            active_count = still_active;
+        }
+        
+        for (size_t j = 0; j < n; ++j) {
+            const double vol = failure[j] == IVFailure::NONE ? s[j] / sqrt_T[j] : 0.0;
+            store_row(output, base + j, vol, iterations[j], failure[j]);
+            total_iterations += iterations[j];
+            if (output.guess_ratio != nullptr) {
+                output.guess_ratio[base + j] = failure[j] == IVFailure::NONE
+                    ? s[j] / table_s[j] : std::numeric_limits<double>::quiet_NaN();
+            }
+            if (failure[j] == IVFailure::NONE) {
+                ++converged;
+            }
+        }
+    }
+    
+    count_solves(input.count, converged, total_iterations);
+    return converged;
+}
+
+size_t ImpliedVolatilitySolver::solve_batch_parallel(const IVBatchInput& input, const IVBatchOutput& output,
+                                                     const IVSolverOptions& options, Utils::ThreadPool* pool) {
+    Utils::ThreadPool& workers = pool != nullptr ? *pool : Utils::ThreadPool::shared();
+    std::atomic<size_t> converged{0};
+    workers.parallel_for_range(input.count, [&](size_t begin, size_t end) {
+        IVBatchInput part;
+        part.market_price = offset(input.market_price, begin);
+        part.spot_price = offset(input.spot_price, begin);
+        part.strike_price = offset(input.strike_price, begin);
+        part.time_to_expiry = offset(input.time_to_expiry, begin);
+        part.risk_free_rate = offset(input.risk_free_rate, begin);
+        part.dividend_yield = offset(input.dividend_yield, begin);
+        part.is_call = offset(input.is_call, begin);
+        part.initial_guess = offset(input.initial_guess, begin);
+        part.guess_ratio = offset(input.guess_ratio, begin);
+        part.count = end - begin;
+        
+        IVBatchOutput out;
+        out.implied_vol = offset(output.implied_vol, begin);
+        out.iterations = offset(output.iterations, begin);
+        out.failure = offset(output.failure, begin);
+        out.guess_ratio = offset(output.guess_ratio, begin);
+        
+        converged.fetch_add(solve_batch(part, out, options), std::memory_order_relaxed);
+    }, PARALLEL_IV_GRAIN);
+    return converged.load();
+}
+
+IVResult ImpliedVolatilitySolver::solve(double market_price, double S, double K, double T, double r,
+                                        double q, bool is_call, const IVSolverOptions& options,
+                                        double initial_guess) noexcept {
+    const uint8_t call_flag = is_call ? 1 : 0;
+    IVBatchInput input;
+    input.market_price = &market_price;
+    input.spot_price = &S;
+    input.strike_price = &K;
+    input.time_to_expiry = &T;
+    input.risk_free_rate = &r;
+    input.dividend_yield = &q;
+    input.is_call = &call_flag;
+    input.initial_guess = &initial_guess;
+    input.count = 1;
+    
+    IVResult result;
+    IVBatchOutput output;
+    output.implied_vol = &result.implied_vol;
+    output.iterations = &result.iterations;
+    output.failure = &result.failure;
+    
+    solve_batch(input, output, options);
+    return result;
+}
+
+} // namespace BlackScholes
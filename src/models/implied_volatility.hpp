@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include "black_scholes.hpp"
+
+/**
+ * @file implied_volatility.hpp
+ * @brief Vectorized implied volatility solver for whole option surfaces
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * Quotes are reduced to a normalized out-of-the-money call,
+ *   β(s) = e^{x/2} N(x/s + s/2) - e^{-x/2} N(x/s - s/2),  x = ln(F/K) ≤ 0,
+ * where s = σ√T is the total volatility. β is increasing in s with a
+ * single inflection point at s_c = √(2|x|), which splits each quote into
+ * one of two branches:
+ * - Upper branch (β ≥ β(s_c)): Halley iteration on β(s) - β*.
+ * - Lower branch (deep out-of-the-money): Halley iteration on
+ *   ln β(s) - ln β*, which stays well conditioned as β → 0.
+ *
+ * The initial guess is read from a precomputed, smooth two-dimensional
+ * table of the inverse (median relative error about 1e-4), or taken from
+ * the caller's warm start, so most quotes converge in one or two steps.
+ *
+ * Every step is bracketed ([0, s_c] or [s_c, ∞)) and falls back to
+ * bisection if it would leave the bracket, so the iteration cannot diverge.
+ * Quotes are processed in blocks and the exp, log and normal CDF/PDF
+ * evaluations for all unconverged quotes of a block run as one VectorMath
+ * call per iteration.
+ */
+
+namespace BlackScholes {
+
+/**
+ * @brief Reason an implied volatility could not be found
+ */
+enum class IVFailure : uint8_t {
+    NONE = 0,                   ///< Converged
+    INVALID_INPUT = 1,          ///< S, K, T, r or q invalid, or price not positive and finite
+    MISSING_INPUT = 2,          ///< Required input column is null
+    BELOW_INTRINSIC = 3,        ///< Price at or below intrinsic value (no time value)
+    ABOVE_UPPER_BOUND = 4,      ///< Price at or above S·e^{-qT} (call) or K·e^{-rT} (put)
+    MAX_ITERATIONS = 5,         ///< Tolerance not reached within the iteration limit
+    NUMERICAL_ERROR = 6         ///< Non-finite intermediate result
+};
+
+/**
+ * @brief Convert IV failure reason to string representation
+ * @param failure Failure reason to convert
+ * @return String representation of failure reason
+ */
+const char* to_string(IVFailure failure) noexcept;
+
+/**
+ * @brief Convergence settings for the implied volatility solver
+ */
+struct IVSolverOptions {
+    int max_iterations = 20;        ///< Maximum Halley steps per quote
+    double price_tolerance = 1e-10; ///< Stop when |model - market| price is below this
+    double vol_tolerance = 1e-8;    ///< Stop when a step changes σ by less than this
+    
+    /**
+     * @brief Read implied_vol.max_iterations and implied_vol.tolerance once
+     * @return Options populated from configuration
+     */
+    static IVSolverOptions from_config();
+};
+
+/**
+ * @brief Structure-of-arrays quotes for batch implied volatility
+ *
+ * Each pointer refers to a caller-owned column of `count` values. The
+ * dividend_yield column is optional (q = 0 when null). Two optional
+ * columns seed the solve; finite positive entries are used, others are
+ * ignored:
+ * - guess_ratio scales the tabulated guess, typically by the ratio
+ *   IVBatchOutput::guess_ratio reported for the same instrument in the
+ *   previous snapshot.
+ * - initial_guess replaces the guess with an explicit σ.
+ */
+struct IVBatchInput {
+    const double* market_price = nullptr;    ///< Observed option price per row
+    const double* spot_price = nullptr;      ///< S per row
+    const double* strike_price = nullptr;    ///< K per row
+    const double* time_to_expiry = nullptr;  ///< T per row (years)
+    const double* risk_free_rate = nullptr;  ///< r per row
+    const double* dividend_yield = nullptr;  ///< q per row (optional)
+    const uint8_t* is_call = nullptr;        ///< Nonzero for call, 0 for put
+    const double* initial_guess = nullptr;   ///< σ to start from per row (optional, NaN = none)
+    const double* guess_ratio = nullptr;     ///< Factor on the tabulated guess per row (optional, NaN = none)
+    size_t count = 0;                        ///< Number of rows
+};
+
+/**
+ * @brief Structure-of-arrays results for batch implied volatility
+ *
+ * All columns are caller-owned and may be null, in which case they are
+ * not written.
+ */
+struct IVBatchOutput {
+    double* implied_vol = nullptr;      ///< σ per row (NaN on failure)
+    uint32_t* iterations = nullptr;     ///< Halley steps taken per row
+    IVFailure* failure = nullptr;       ///< IVFailure::NONE or the reason per row
+    double* guess_ratio = nullptr;      ///< Converged σ over the tabulated guess per row (NaN on failure)
+};
+
+/**
+ * @brief Result of a single implied volatility solve
+ */
+struct IVResult {
+    double implied_vol;     ///< σ (NaN on failure)
+    uint32_t iterations;    ///< Halley steps taken
+    IVFailure failure;      ///< IVFailure::NONE or the reason
+};
+
+/**
+ * @brief Batch implied volatility solver
+ *
+ * Stateless and thread-safe. No heap allocation and no logging per quote.
+ */
+class ImpliedVolatilitySolver {
+public:
+    /**
+     * @brief Invert a batch of quotes
+     * @param input Structure-of-arrays quotes
+     * @param output Caller-owned output columns (null columns are skipped)
+     * @param options Convergence settings
+     * @return Number of quotes that converged
+     */
+    static size_t solve_batch(const IVBatchInput& input, const IVBatchOutput& output,
+                              const IVSolverOptions& options = IVSolverOptions()) noexcept;
+    
+    /**
+     * @brief Invert a batch of quotes across a thread pool
+     *
+     * Splits the quotes into ranges and runs solve_batch() on each range;
+     * results are identical to a single solve_batch() call.
+     *
+     * @param input Structure-of-arrays quotes
+     * @param output Caller-owned output columns (null columns are skipped)
+     * @param options Convergence settings
+     * @param pool Thread pool to use (nullptr = Utils::ThreadPool::shared())
+     * @return Number of quotes that converged
+     */
+    static size_t solve_batch_parallel(const IVBatchInput& input, const IVBatchOutput& output,
+                                       const IVSolverOptions& options = IVSolverOptions(),
+                                       Utils::ThreadPool* pool = nullptr);
+    
+    /**
+     * @brief Invert a single quote
+     * @param market_price Observed option price
+     * @param S Spot price
+     * @param K Strike price
+     * @param T Time to expiry (years)
+     * @param r Risk-free rate
+     * @param q Dividend yield
+     * @param is_call true for call option, false for put
+     * @param options Convergence settings
+     * @param initial_guess σ to start from (NaN for the tabulated guess)
+     * @return Implied volatility with iteration count and failure reason
+     */
+    static IVResult solve(double market_price, double S, double K, double T, double r,
+                          double q, bool is_call,
+                          const IVSolverOptions& options = IVSolverOptions(),
+                          double initial_guess = std::numeric_limits<double>::quiet_NaN()) noexcept;
+};
+
+} // namespace BlackScholes
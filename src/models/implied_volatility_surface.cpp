@@ -0,0 +1,165 @@
+#include "implied_volatility_surface.hpp"
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+namespace BlackScholes {
+
+namespace {
+
+void store_row(const IVBatchOutput& output, size_t i, double vol, uint32_t iterations,
+               IVFailure failure) noexcept {
+    if (output.implied_vol != nullptr) {
+        output.implied_vol[i] = vol;
+    }
+    if (output.iterations != nullptr) {
+        output.iterations[i] = iterations;
+    }
+    if (output.failure != nullptr) {
+        output.failure[i] = failure;
+    }
+}
+
+bool within(double previous, double current, double tolerance) noexcept {
+    return std::abs(current - previous) <= tolerance * std::max(1.0, std::abs(previous));
+}
+
+} // namespace
+
+ImpliedVolatilitySurface::ImpliedVolatilitySurface(double input_tolerance,
+                                                   const IVSolverOptions& options)
+    : options_(options), input_tolerance_(std::max(input_tolerance, 0.0)) {}
+
+bool ImpliedVolatilitySurface::unchanged(const Entry& entry, double price, double S, double K,
+                                         double T, double r, double q,
+                                         uint8_t is_call) const noexcept {
+    return (entry.is_call != 0) == (is_call != 0) &&
+           within(entry.market_price, price, input_tolerance_) &&
+           within(entry.spot_price, S, input_tolerance_) &&
+           within(entry.strike_price, K, input_tolerance_) &&
+           within(entry.time_to_expiry, T, input_tolerance_) &&
+           within(entry.risk_free_rate, r, input_tolerance_) &&
+           within(entry.dividend_yield, q, input_tolerance_);
+}
+
+size_t ImpliedVolatilitySurface::update(const uint64_t* keys, const IVBatchInput& input,
+                                        const IVBatchOutput& output) {
+    const bool missing_input = keys == nullptr || input.market_price == nullptr ||
+                               input.spot_price == nullptr || input.strike_price == nullptr ||
+                               input.time_to_expiry == nullptr || input.risk_free_rate == nullptr ||
+                               input.is_call == nullptr;
+    if (missing_input) {
+        for (size_t i = 0; i < input.count; ++i) {
+            store_row(output, i, std::numeric_limits<double>::quiet_NaN(), 0, IVFailure::MISSING_INPUT);
+        }
+        return 0;
+    }
+    
+    size_t converged = 0;
+    rows_.clear();
+    price_.clear();
+    spot_.clear();
+    strike_.clear();
+    expiry_.clear();
+    rate_.clear();
+    dividend_.clear();
+    guess_.clear();
+    is_call_.clear();
+    
+    // Serve unchanged quotes from the cache and compact the rest
+    for (size_t i = 0; i < input.count; ++i) {
+        const double q = input.dividend_yield != nullptr ? input.dividend_yield[i] : 0.0;
+        auto it = entries_.find(keys[i]);
+        if (it != entries_.end() &&
+            unchanged(it->second, input.market_price[i], input.spot_price[i], input.strike_price[i],
+                      input.time_to_expiry[i], input.risk_free_rate[i], q, input.is_call[i])) {
+            const Entry& entry = it->second;
+            store_row(output, i, entry.implied_vol, 0, entry.failure);
+            ++stats_.skipped;
+            if (entry.failure == IVFailure::NONE) {
+                ++converged;
+            }
+            continue;
+        }
+        
+        const bool warm = it != entries_.end() && it->second.failure == IVFailure::NONE;
+        rows_.push_back(i);
+        price_.push_back(input.market_price[i]);
+        spot_.push_back(input.spot_price[i]);
+        strike_.push_back(input.strike_price[i]);
+        expiry_.push_back(input.time_to_expiry[i]);
+        rate_.push_back(input.risk_free_rate[i]);
+        dividend_.push_back(q);
+        is_call_.push_back(input.is_call[i]);
+        guess_.push_back(warm ? it->second.guess_ratio : std::numeric_limits<double>::quiet_NaN());
+    }
+    
+    if (rows_.empty()) {
+        return converged;
+    }
+    
+    const size_t pending = rows_.size();
+    vol_.resize(pending);
+    iterations_.resize(pending);
+    failure_.resize(pending);
+    ratio_.resize(pending);
+    
+    IVBatchInput batch;
+    batch.market_price = price_.data();
+    batch.spot_price = spot_.data();
+    batch.strike_price = strike_.data();
+    batch.time_to_expiry = expiry_.data();
+    batch.risk_free_rate = rate_.data();
+    batch.dividend_yield = dividend_.data();
+    batch.is_call = is_call_.data();
+    batch.guess_ratio = guess_.data();
+    batch.count = pending;
+    converged += ImpliedVolatilitySolver::solve_batch_parallel(
+        batch, IVBatchOutput{vol_.data(), iterations_.data(), failure_.data(), ratio_.data()}, options_);
+    
+    // Scatter results back and remember them for the next snapshot
+    for (size_t k = 0; k < pending; ++k) {
+        const size_t i = rows_[k];
+        const bool warm = !std::isnan(guess_[k]);
+        store_row(output, i, vol_[k], iterations_[k], failure_[k]);
+        
+        if (failure_[k] != IVFailure::NONE) {
+            ++stats_.failed;
+        } else if (warm) {
+            ++stats_.warm_converged;
+        } else {
+            ++stats_.cold_solved;
+        }
+        (warm ? stats_.warm_iterations : stats_.cold_iterations) += iterations_[k];
+        
+        Entry& entry = entries_[keys[i]];
+        entry.market_price = price_[k];
+        entry.spot_price = spot_[k];
+        entry.strike_price = strike_[k];
+        entry.time_to_expiry = expiry_[k];
+        entry.risk_free_rate = rate_[k];
+        entry.dividend_yield = dividend_[k];
+        entry.is_call = is_call_[k];
+        entry.implied_vol = vol_[k];
+        entry.iterations = iterations_[k];
+        entry.failure = failure_[k];
+        entry.guess_ratio = ratio_[k];
+    }
+    
+    return converged;
+}
+
+bool ImpliedVolatilitySurface::lookup(uint64_t key, double& implied_vol) const {
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        return false;
+    }
+    implied_vol = it->second.implied_vol;
+    return true;
+}
+
+bool ImpliedVolatilitySurface::erase(uint64_t key) {
+    return entries_.erase(key) > 0;
+}
+
+} // namespace BlackScholes
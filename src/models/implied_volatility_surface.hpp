@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "implied_volatility.hpp"
+
+/**
+ * @file implied_volatility_surface.hpp
+ * @brief Incremental implied volatility across market snapshots
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * Between snapshots most quotes move only slightly. ImpliedVolatilitySurface
+ * remembers the inputs and last result per instrument key and, on each
+ * update:
+ * - Skips quotes whose inputs are unchanged within the input tolerance and
+ *   returns the stored result.
+ * - Warm-starts changed quotes from their last converged σ. The solver's
+ *   tabulated guess is scaled by the ratio of that σ to the guess the
+ *   table gave for the previous inputs; as the table error varies
+ *   smoothly, this carries the previous solve's correction over to
+ *   the new inputs.
+ * - Solves quotes without a converged σ (new keys or previous failures)
+ *   from the solver's tabulated guess.
+ *
+ * Counters report how much work incremental mode saved.
+ */
+
+namespace BlackScholes {
+
+/**
+ * @brief Work counters accumulated by ImpliedVolatilitySurface::update()
+ */
+struct IVSurfaceStats {
+    uint64_t skipped = 0;               ///< Unchanged quotes served from the cache
+    uint64_t warm_converged = 0;        ///< Quotes solved from the previous σ
+    uint64_t cold_solved = 0;           ///< Quotes solved without a previous σ
+    uint64_t failed = 0;                ///< Quotes that did not converge
+    uint64_t warm_iterations = 0;       ///< Halley steps spent on warm-started quotes
+    uint64_t cold_iterations = 0;       ///< Halley steps spent on cold-started quotes
+};
+
+/**
+ * @brief Stateful implied volatility surface keyed by instrument
+ *
+ * Not thread-safe; use one surface per thread or guard it externally.
+ * Scratch buffers are kept between updates, so steady-state updates of a
+ * fixed instrument set do not allocate.
+ */
+class ImpliedVolatilitySurface {
+private:
+    /**
+     * @brief Last inputs and result for one instrument
+     */
+    struct Entry {
+        double market_price;
+        double spot_price;
+        double strike_price;
+        double time_to_expiry;
+        double risk_free_rate;
+        double dividend_yield;
+        uint8_t is_call;
+        double implied_vol;         ///< NaN when the last solve failed
+        uint32_t iterations;
+        IVFailure failure;
+        double guess_ratio;         ///< Converged σ over the tabulated guess
+    };
+    
+    std::unordered_map<uint64_t, Entry> entries_;
+    IVSolverOptions options_;
+    double input_tolerance_;
+    IVSurfaceStats stats_;
+    
+    // Compacted rows to re-solve, reused across updates
+    std::vector<size_t> rows_;
+    std::vector<double> price_, spot_, strike_, expiry_, rate_, dividend_, guess_, ratio_;
+    std::vector<uint8_t> is_call_;
+    std::vector<double> vol_;
+    std::vector<uint32_t> iterations_;
+    std::vector<IVFailure> failure_;
+    
+    bool unchanged(const Entry& entry, double price, double S, double K, double T,
+                   double r, double q, uint8_t is_call) const noexcept;
+
+public:
+    /**
+     * @brief Create an empty surface
+     * @param input_tolerance Relative change (absolute below 1) under which an input counts as unchanged
+     * @param options Solver convergence settings
+     */
+    explicit ImpliedVolatilitySurface(double input_tolerance = 1e-12,
+                                      const IVSolverOptions& options = IVSolverOptions());
+    
+    /**
+     * @brief Apply a market snapshot
+     * @param keys Instrument key per row (input.count values)
+     * @param input Structure-of-arrays quotes (the seed columns are ignored)
+     * @param output Caller-owned output columns (null columns are skipped);
+     *               iterations are 0 for skipped rows
+     * @return Number of rows with a converged implied volatility
+     */
+    size_t update(const uint64_t* keys, const IVBatchInput& input, const IVBatchOutput& output);
+    
+    /**
+     * @brief Look up the last result for an instrument
+     * @param key Instrument key
+     * @param implied_vol Set to the stored σ (NaN if the last solve failed)
+     * @return false if the key has never been updated
+     */
+    bool lookup(uint64_t key, double& implied_vol) const;
+    
+    /**
+     * @brief Forget an instrument (e.g. after expiry)
+     * @param key Instrument key
+     * @return true if the key was present
+     */
+    bool erase(uint64_t key);
+    
+    /**
+     * @brief Forget all instruments; counters are kept
+     */
+    void clear() { entries_.clear(); }
+    
+    size_t size() const noexcept { return entries_.size(); }
+    const IVSurfaceStats& stats() const noexcept { return stats_; }
+    void reset_stats() noexcept { stats_ = IVSurfaceStats(); }
+    
+    const IVSolverOptions& options() const noexcept { return options_; }
+    double input_tolerance() const noexcept { return input_tolerance_; }
+};
+
+} // namespace BlackScholes
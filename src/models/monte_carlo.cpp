@@ -0,0 +1,667 @@
+#include "monte_carlo.hpp"
+#include "adjoint.hpp"
+#include "philox.hpp"
+#include "sobol.hpp"
+#include "vector_math.hpp"
+#include "../utils/arena.hpp"
+#include "../utils/thread_pool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace BlackScholes {
+
+thread_local Utils::Logger MonteCarloEngine::logger_("BlackScholes::MonteCarloEngine");
+
+const char* to_string(PathPayoff payoff) noexcept {
+    switch (payoff) {
+        case PathPayoff::EUROPEAN:          return "EUROPEAN";
+        case PathPayoff::ASIAN_ARITHMETIC:  return "ASIAN_ARITHMETIC";
+        case PathPayoff::UP_AND_OUT:        return "UP_AND_OUT";
+        case PathPayoff::DOWN_AND_OUT:      return "DOWN_AND_OUT";
+        case PathPayoff::UP_AND_IN:         return "UP_AND_IN";
+        case PathPayoff::DOWN_AND_IN:       return "DOWN_AND_IN";
+        case PathPayoff::LOOKBACK_FLOATING: return "LOOKBACK_FLOATING";
+        case PathPayoff::LOOKBACK_FIXED:    return "LOOKBACK_FIXED";
+        case PathPayoff::ASIAN_GEOMETRIC:   return "ASIAN_GEOMETRIC";
+        default:                            return "UNKNOWN";
+    }
+}
+
+const char* to_string(MonteCarloSampling sampling) noexcept {
+    switch (sampling) {
+        case MonteCarloSampling::PSEUDO_RANDOM: return "PSEUDO_RANDOM";
+        case MonteCarloSampling::SOBOL:         return "SOBOL";
+        default:                                return "UNKNOWN";
+    }
+}
+
+double geometric_asian_price(const Parameters& params, bool is_call, uint32_t steps) noexcept {
+    // ln G ~ N(ln S + μ(n+1)T/(2n), σ²T(n+1)(2n+1)/(6n²)), μ = r - q - σ²/2
+    const double n = static_cast<double>(std::max(steps, 1u));
+    const double T = params.time_to_expiry;
+    const double sigma = params.volatility;
+    const double mu = params.risk_free_rate - params.dividend_yield - 0.5 * sigma * sigma;
+    const double mean = std::log(params.spot_price) + mu * T * (n + 1.0) / (2.0 * n);
+    const double stddev = sigma * std::sqrt(T * (n + 1.0) * (2.0 * n + 1.0) / (6.0 * n * n));
+    
+    const double d2 = (mean - std::log(params.strike_price)) / stddev;
+    const double d1 = d2 + stddev;
+    const double forward = std::exp(mean + 0.5 * stddev * stddev);
+    const double discount = std::exp(-params.risk_free_rate * T);
+    const double K = params.strike_price;
+    return is_call ? discount * (forward * MathUtils::normal_cdf(d1) - K * MathUtils::normal_cdf(d2))
+                   : discount * (K * MathUtils::normal_cdf(-d2) - forward * MathUtils::normal_cdf(-d1));
+}
+
+MonteCarloOptions MonteCarloOptions::from_config() {
+    MonteCarloOptions options;
+    const auto& config = Config::ConfigManager::getInstance().snapshot();
+    options.simulations = static_cast<uint64_t>(std::max(config.monte_carlo.simulations, 1));
+    options.steps = static_cast<uint32_t>(std::max(config.monte_carlo.steps, 1));
+    options.antithetic = config.monte_carlo.antithetic;
+    options.seed = static_cast<uint64_t>(config.monte_carlo.seed);
+    options.parallel = config.threading.enable_parallel_mc;
+    options.max_threads = static_cast<size_t>(std::max(config.threading.max_threads, 1));
+    options.sampling = config.monte_carlo.sampling == "SOBOL" ? MonteCarloSampling::SOBOL
+                                                              : MonteCarloSampling::PSEUDO_RANDOM;
+    options.qmc_replications = static_cast<uint32_t>(std::max(config.monte_carlo.qmc_replications, 2));
+    return options;
+}
+
+namespace {
+
+bool is_barrier(PathPayoff payoff) noexcept {
+    return payoff == PathPayoff::UP_AND_OUT || payoff == PathPayoff::DOWN_AND_OUT ||
+           payoff == PathPayoff::UP_AND_IN || payoff == PathPayoff::DOWN_AND_IN;
+}
+
+// Adjoint estimates: the discounted payoff, then its derivative with respect to each input
+enum Estimate : size_t { VALUE, SPOT, STRIKE, EXPIRY, RATE, VOLATILITY, DIVIDEND, ESTIMATES };
+
+/**
+ * @brief Sums and sums of squares of the samples in one block
+ *
+ * Only VALUE is used unless the block is differentiated.
+ */
+struct BlockSums {
+    double sum[ESTIMATES] = {};
+    double sum_sq[ESTIMATES] = {};
+};
+
+/**
+ * @brief Per-simulation constants shared by all blocks
+ */
+struct PathSetup {
+    double log_spot;
+    double strike;
+    double drift;           // (r - q - σ²/2)Δt
+    double diffusion;       // σ√Δt
+    double bridge_scale;    // σ√T, scales the unit-time Brownian bridge
+    uint32_t steps;
+    bool antithetic;
+    PathContract contract;
+    Random::Philox4x32::Key key;
+    const SobolSequence* sobol = nullptr;
+    const BrownianBridge* bridge = nullptr;
+    const uint32_t* shifts = nullptr;   // steps digital shifts per replication
+};
+
+// Uniforms converted per batch by the Sobol path (bounds the scratch buffers)
+constexpr size_t SOBOL_BATCH_VALUES = 1 << 16;
+
+// Payoffs are templates so the adjoint paths evaluate them on AD::Real
+template <typename Real>
+Real vanilla(bool is_call, const Real& spot, const Real& strike) {
+    using std::max;
+    return max(is_call ? spot - strike : strike - spot, Real(0.0));
+}
+
+// Payoff of one path; mean is the arithmetic or geometric average for Asian payoffs
+template <typename Real>
+Real path_payoff(const PathContract& contract, const Real& K, const Real& S_T, const Real& S_max,
+                 const Real& S_min, const Real& mean) {
+    using std::max;
+    const bool is_call = contract.is_call;
+    const double barrier = contract.barrier;
+    switch (contract.payoff) {
+        case PathPayoff::EUROPEAN:
+            return vanilla(is_call, S_T, K);
+        case PathPayoff::ASIAN_ARITHMETIC:
+        case PathPayoff::ASIAN_GEOMETRIC:
+            return vanilla(is_call, mean, K);
+        case PathPayoff::UP_AND_OUT:
+            return S_max >= barrier ? Real(0.0) : vanilla(is_call, S_T, K);
+        case PathPayoff::DOWN_AND_OUT:
+            return S_min <= barrier ? Real(0.0) : vanilla(is_call, S_T, K);
+        case PathPayoff::UP_AND_IN:
+            return S_max >= barrier ? vanilla(is_call, S_T, K) : Real(0.0);
+        case PathPayoff::DOWN_AND_IN:
+            return S_min <= barrier ? vanilla(is_call, S_T, K) : Real(0.0);
+        case PathPayoff::LOOKBACK_FLOATING:
+            return is_call ? S_T - S_min : S_max - S_T;
+        case PathPayoff::LOOKBACK_FIXED:
+            return is_call ? max(S_max - K, Real(0.0)) : max(K - S_min, Real(0.0));
+    }
+    return Real(0.0);
+}
+
+bool is_asian(PathPayoff payoff) noexcept {
+    return payoff == PathPayoff::ASIAN_ARITHMETIC || payoff == PathPayoff::ASIAN_GEOMETRIC;
+}
+
+// Simulate samples [first, first + count) and accumulate their payoffs
+BlockSums simulate_block(const PathSetup& setup, uint64_t first, size_t count) {
+    constexpr size_t LANES = MonteCarloEngine::BLOCK_PATHS;
+    const size_t lanes = setup.antithetic ? 2 * count : count;
+    const PathPayoff payoff = setup.contract.payoff;
+    const bool track_extremes = payoff != PathPayoff::EUROPEAN && !is_asian(payoff);
+    const bool track_average = payoff == PathPayoff::ASIAN_ARITHMETIC;
+    const bool track_log_average = payoff == PathPayoff::ASIAN_GEOMETRIC;
+    
+    double log_s[LANES];
+    double high[LANES];         // Running max of ln S (then of S), including the start
+    double low[LANES];          // Running min of ln S (then of S)
+    double average[LANES];      // Running sum of S (or ln S) over the monitoring dates
+    double spot[LANES];
+    double z[2][LANES];
+    
+    std::fill(log_s, log_s + lanes, setup.log_spot);
+    std::fill(high, high + lanes, setup.log_spot);
+    std::fill(low, low + lanes, setup.log_spot);
+    std::fill(average, average + lanes, 0.0);
+    
+    for (uint32_t step = 0; step < setup.steps; step += 2) {
+        // One Philox call yields the uniforms for two consecutive steps of a sample
+        for (size_t k = 0; k < count; ++k) {
+            const uint64_t sample = first + k;
+            const Random::Philox4x32::Counter words = Random::Philox4x32::generate(
+                Random::Philox4x32::Counter{{step / 2, 0u, static_cast<uint32_t>(sample),
+                                             static_cast<uint32_t>(sample >> 32)}},
+                setup.key);
+            z[0][k] = Random::to_unit_interval(words[0], words[1]);
+            z[1][k] = Random::to_unit_interval(words[2], words[3]);
+        }
+        VectorMath::normal_inv_cdf(z[0], z[0], count);
+        if (step + 1 < setup.steps) {
+            VectorMath::normal_inv_cdf(z[1], z[1], count);
+        }
+        
+        for (uint32_t sub = 0; sub < 2 && step + sub < setup.steps; ++sub) {
+            const double* draws = z[sub];
+            if (setup.antithetic) {
+                for (size_t k = 0; k < count; ++k) {
+                    log_s[2 * k] += setup.drift + setup.diffusion * draws[k];
+                    log_s[2 * k + 1] += setup.drift - setup.diffusion * draws[k];
+                }
+            } else {
+                for (size_t k = 0; k < count; ++k) {
+                    log_s[k] += setup.drift + setup.diffusion * draws[k];
+                }
+            }
+            
+            if (track_extremes) {
+                for (size_t lane = 0; lane < lanes; ++lane) {
+                    high[lane] = std::max(high[lane], log_s[lane]);
+                    low[lane] = std::min(low[lane], log_s[lane]);
+                }
+            }
+            if (track_average) {
+                VectorMath::exp(log_s, spot, lanes);
+                for (size_t lane = 0; lane < lanes; ++lane) {
+                    average[lane] += spot[lane];
+                }
+            }
+            if (track_log_average) {
+                for (size_t lane = 0; lane < lanes; ++lane) {
+                    average[lane] += log_s[lane];
+                }
+            }
+        }
+    }
+    
+    VectorMath::exp(log_s, spot, lanes);
+    if (track_extremes) {
+        VectorMath::exp(high, high, lanes);
+        VectorMath::exp(low, low, lanes);
+    }
+    if (track_average || track_log_average) {
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            average[lane] /= setup.steps;
+        }
+        if (track_log_average) {
+            VectorMath::exp(average, average, lanes);
+        }
+    }
+    
+    double* payoffs = average;  // Reused once the averages are consumed
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        payoffs[lane] = path_payoff(setup.contract, setup.strike, spot[lane], high[lane], low[lane], average[lane]);
+    }
+    
+    BlockSums sums;
+    for (size_t k = 0; k < count; ++k) {
+        const double sample = setup.antithetic ? 0.5 * (payoffs[2 * k] + payoffs[2 * k + 1]) : payoffs[k];
+        sums.sum[VALUE] += sample;
+        sums.sum_sq[VALUE] += sample * sample;
+    }
+    return sums;
+}
+
+// Simulate Sobol points [first, first + count) of one digitally shifted replication
+BlockSums simulate_sobol_block(const PathSetup& setup, uint32_t replication, uint64_t first, size_t count) {
+    const size_t dims = setup.steps;
+    const size_t batch = std::max<size_t>(1, std::min(count, SOBOL_BATCH_VALUES / dims));
+    const uint32_t* shift = setup.shifts + static_cast<size_t>(replication) * dims;
+    const PathPayoff payoff = setup.contract.payoff;
+    const double spot_0 = std::exp(setup.log_spot);
+    
+    // Scratch from this worker's arena, returned when the block is done
+    Utils::ArenaScope scratch;
+    std::pmr::vector<uint32_t> point(dims, scratch.resource());
+    std::pmr::vector<double> values(batch * dims, scratch.resource());   // Uniforms, then normals
+    std::pmr::vector<double> spot(batch * dims, scratch.resource());     // ln S, then S
+    std::pmr::vector<double> log_mean(batch, scratch.resource());
+    std::pmr::vector<double> path(dims, scratch.resource());
+    
+    BlockSums sums;
+    setup.sobol->point(first, point.data());
+    for (size_t start = 0; start < count; start += batch) {
+        const size_t paths = std::min(batch, count - start);
+        for (size_t k = 0; k < paths; ++k) {
+            double* u = &values[k * dims];
+            for (size_t d = 0; d < dims; ++d) {
+                u[d] = SobolSequence::to_unit(point[d] ^ shift[d]);
+            }
+            setup.sobol->next(first + start + k, point.data());
+        }
+        VectorMath::normal_inv_cdf(values.data(), values.data(), paths * dims);
+        
+        for (size_t k = 0; k < paths; ++k) {
+            setup.bridge->transform(&values[k * dims], path.data());
+            double* log_s = &spot[k * dims];
+            double log_sum = 0.0;
+            for (size_t i = 0; i < dims; ++i) {
+                log_s[i] = setup.log_spot + setup.drift * static_cast<double>(i + 1) + setup.bridge_scale * path[i];
+                log_sum += log_s[i];
+            }
+            log_mean[k] = log_sum / static_cast<double>(dims);
+        }
+        VectorMath::exp(spot.data(), spot.data(), paths * dims);
+        
+        for (size_t k = 0; k < paths; ++k) {
+            const double* s = &spot[k * dims];
+            double S_max = spot_0;
+            double S_min = spot_0;
+            double sum = 0.0;
+            for (size_t i = 0; i < dims; ++i) {
+                S_max = std::max(S_max, s[i]);
+                S_min = std::min(S_min, s[i]);
+                sum += s[i];
+            }
+            const double mean = payoff == PathPayoff::ASIAN_GEOMETRIC ? std::exp(log_mean[k])
+                                                                      : sum / static_cast<double>(dims);
+            const double sample = path_payoff(setup.contract, setup.strike, s[dims - 1], S_max, S_min, mean);
+            sums.sum[VALUE] += sample;
+            sums.sum_sq[VALUE] += sample * sample;
+        }
+    }
+    return sums;
+}
+
+/**
+ * @brief Inputs of an adjoint block and the per-simulation terms built from them
+ *
+ * Recorded once per block, ahead of the mark every sample rewinds to.
+ */
+struct AdjointInputs {
+    AD::Real input[ESTIMATES];  // Variables at SPOT .. DIVIDEND
+    AD::Real log_spot;
+    AD::Real drift;             // (r - q - σ²/2)Δt
+    AD::Real diffusion;         // σ√Δt
+    AD::Real bridge_scale;      // σ√T
+    AD::Real discount;          // e^{-rT}
+};
+
+AdjointInputs record_inputs(AD::Tape& tape, const Parameters& params, uint32_t steps) {
+    AdjointInputs in;
+    in.input[SPOT] = tape.variable(params.spot_price);
+    in.input[STRIKE] = tape.variable(params.strike_price);
+    in.input[EXPIRY] = tape.variable(params.time_to_expiry);
+    in.input[RATE] = tape.variable(params.risk_free_rate);
+    in.input[VOLATILITY] = tape.variable(params.volatility);
+    in.input[DIVIDEND] = tape.variable(params.dividend_yield);
+    
+    const AD::Real& T = in.input[EXPIRY];
+    const AD::Real& r = in.input[RATE];
+    const AD::Real& sigma = in.input[VOLATILITY];
+    const AD::Real dt = T / static_cast<double>(steps);
+    in.log_spot = AD::log(in.input[SPOT]);
+    in.drift = (r - in.input[DIVIDEND] - 0.5 * sigma * sigma) * dt;
+    in.diffusion = sigma * AD::sqrt(dt);
+    in.bridge_scale = sigma * AD::sqrt(T);
+    in.discount = AD::exp(-r * T);
+    return in;
+}
+
+// Discounted payoff of one path on the tape; next(i, ln S_{i-1}) gives ln S at date i
+template <typename NextLogSpot>
+AD::Real adjoint_payoff(const PathSetup& setup, const AdjointInputs& in, NextLogSpot next) {
+    const PathPayoff payoff = setup.contract.payoff;
+    const bool track_extremes = payoff != PathPayoff::EUROPEAN && !is_asian(payoff);
+    
+    AD::Real log_s = in.log_spot;
+    AD::Real high = in.log_spot;
+    AD::Real low = in.log_spot;
+    AD::Real average = 0.0;
+    for (uint32_t i = 0; i < setup.steps; ++i) {
+        log_s = next(i, log_s);
+        if (track_extremes) {
+            high = AD::max(high, log_s);
+            low = AD::min(low, log_s);
+        }
+        if (payoff == PathPayoff::ASIAN_ARITHMETIC) {
+            average += AD::exp(log_s);
+        } else if (payoff == PathPayoff::ASIAN_GEOMETRIC) {
+            average += log_s;
+        }
+    }
+    
+    if (is_asian(payoff)) {
+        average /= static_cast<double>(setup.steps);
+        if (payoff == PathPayoff::ASIAN_GEOMETRIC) {
+            average = AD::exp(average);
+        }
+    }
+    if (track_extremes) {
+        high = AD::exp(high);
+        low = AD::exp(low);
+    }
+    return in.discount * path_payoff(setup.contract, in.input[STRIKE], AD::exp(log_s), high, low, average);
+}
+
+// One backward sweep from the sample gives its derivatives with respect to every input
+void accumulate(const AD::Tape& tape, const AdjointInputs& in, const AD::Real& sample, BlockSums& sums) {
+    for (size_t e = 0; e < ESTIMATES; ++e) {
+        const double value = e == VALUE ? sample.value() : tape.adjoint(in.input[e]);
+        sums.sum[e] += value;
+        sums.sum_sq[e] += value * value;
+    }
+}
+
+// Differentiate samples [first, first + count) with the draws of simulate_block()
+BlockSums simulate_adjoint_block(const PathSetup& setup, const Parameters& params, uint64_t first, size_t count) {
+    AD::TapeScope scope;
+    AD::Tape& tape = scope.tape();
+    const AdjointInputs in = record_inputs(tape, params, setup.steps);
+    const size_t inputs_end = tape.mark();
+    
+    Utils::ArenaScope scratch;
+    std::pmr::vector<double> z(setup.steps + 1, scratch.resource());
+    
+    BlockSums sums;
+    for (size_t k = 0; k < count; ++k) {
+        const uint64_t sample = first + k;
+        for (uint32_t step = 0; step < setup.steps; step += 2) {
+            const Random::Philox4x32::Counter words = Random::Philox4x32::generate(
+                Random::Philox4x32::Counter{{step / 2, 0u, static_cast<uint32_t>(sample),
+                                             static_cast<uint32_t>(sample >> 32)}},
+                setup.key);
+            z[step] = Random::to_unit_interval(words[0], words[1]);
+            z[step + 1] = Random::to_unit_interval(words[2], words[3]);
+        }
+        VectorMath::normal_inv_cdf(z.data(), z.data(), setup.steps);
+        
+        const auto path = [&](double sign) {
+            return adjoint_payoff(setup, in, [&](uint32_t i, const AD::Real& log_s) {
+                return log_s + (in.drift + in.diffusion * (sign * z[i]));
+            });
+        };
+        const AD::Real value = setup.antithetic ? 0.5 * (path(1.0) + path(-1.0)) : path(1.0);
+        tape.backward(value);
+        accumulate(tape, in, value, sums);
+        tape.rewind(inputs_end);
+    }
+    return sums;
+}
+
+// Differentiate Sobol points [first, first + count) with the paths of simulate_sobol_block()
+BlockSums simulate_adjoint_sobol_block(const PathSetup& setup, const Parameters& params, uint32_t replication,
+                                       uint64_t first, size_t count) {
+    const size_t dims = setup.steps;
+    const uint32_t* shift = setup.shifts + static_cast<size_t>(replication) * dims;
+    
+    AD::TapeScope scope;
+    AD::Tape& tape = scope.tape();
+    const AdjointInputs in = record_inputs(tape, params, setup.steps);
+    const size_t inputs_end = tape.mark();
+    
+    Utils::ArenaScope scratch;
+    std::pmr::vector<uint32_t> point(dims, scratch.resource());
+    std::pmr::vector<double> normals(dims, scratch.resource());
+    std::pmr::vector<double> path(dims, scratch.resource());
+    
+    BlockSums sums;
+    setup.sobol->point(first, point.data());
+    for (size_t k = 0; k < count; ++k) {
+        for (size_t d = 0; d < dims; ++d) {
+            normals[d] = SobolSequence::to_unit(point[d] ^ shift[d]);
+        }
+        setup.sobol->next(first + k, point.data());
+        VectorMath::normal_inv_cdf(normals.data(), normals.data(), dims);
+        setup.bridge->transform(normals.data(), path.data());
+        
+        const AD::Real value = adjoint_payoff(setup, in, [&](uint32_t i, const AD::Real&) {
+            return in.log_spot + in.drift * static_cast<double>(i + 1) + in.bridge_scale * path[i];
+        });
+        tape.backward(value);
+        accumulate(tape, in, value, sums);
+        tape.rewind(inputs_end);
+    }
+    return sums;
+}
+
+} // namespace
+
+MonteCarloEngine::MonteCarloEngine(const MonteCarloOptions& options, Utils::ThreadPool* pool)
+    : options_(options), pool_(pool != nullptr ? pool : &Utils::ThreadPool::shared()) {}
+
+bool MonteCarloEngine::simulate(const Parameters& params, const PathContract& contract, bool adjoint,
+                                MonteCarloResult& result, double* means, double* errors) const {
+    const bool sobol = options_.sampling == MonteCarloSampling::SOBOL;
+    const bool antithetic = !sobol && options_.antithetic;
+    const uint64_t replications = sobol ? std::max<uint64_t>(options_.qmc_replications, 1) : 1;
+    const uint64_t per_replication = (options_.simulations + replications - 1) / replications;
+    const uint64_t paths = sobol ? per_replication * replications
+                                 : antithetic ? options_.simulations + (options_.simulations & 1) : options_.simulations;
+    const uint64_t samples = antithetic ? paths / 2 : paths;
+    const uint32_t steps = contract.payoff == PathPayoff::EUROPEAN ? 1u : options_.steps;
+    
+    if (samples < 2 || options_.steps == 0) {
+        result.error_msg = "Monte Carlo needs at least two samples and one step";
+    } else if (is_barrier(contract.payoff) && !(contract.barrier > 0.0 && std::isfinite(contract.barrier))) {
+        result.error_msg = "Barrier must be positive and finite";
+    } else if (adjoint && is_barrier(contract.payoff)) {
+        result.error_msg = "Pathwise Greeks need a payoff that is continuous in the path";
+    } else if (sobol && options_.qmc_replications < 2) {
+        result.error_msg = "Sobol sampling needs at least two replications";
+    } else if (sobol && steps > MAX_SOBOL_STEPS) {
+        result.error_msg = "Sobol sampling supports at most 1024 steps";
+    } else if (sobol && per_replication > (uint64_t(1) << 32)) {
+        result.error_msg = "Sobol sampling supports at most 2^32 paths per replication";
+    } else if (!params.is_valid()) {
+        result.error_msg = params.validation_error();
+    }
+    if (!result.error_msg.empty()) {
+        LOG_ERROR(logger_, "Failed to price {} option by Monte Carlo: {}", to_string(contract.payoff), result.error_msg);
+        return false;
+    }
+    
+    PathSetup setup;
+    setup.steps = steps;
+    const double dt = params.time_to_expiry / setup.steps;
+    const double sigma = params.volatility;
+    setup.log_spot = std::log(params.spot_price);
+    setup.strike = params.strike_price;
+    setup.drift = (params.risk_free_rate - params.dividend_yield - 0.5 * sigma * sigma) * dt;
+    setup.diffusion = sigma * std::sqrt(dt);
+    setup.bridge_scale = sigma * std::sqrt(params.time_to_expiry);
+    setup.antithetic = antithetic;
+    setup.contract = contract;
+    setup.key = Random::Philox4x32::key_from_seed(options_.seed);
+    
+    // Sobol: blocks are (replication, chunk) pairs, each replication with its own digital shift
+    Utils::ArenaScope scratch;
+    std::unique_ptr<SobolSequence> sequence;
+    std::unique_ptr<BrownianBridge> bridge;
+    std::pmr::vector<uint32_t> shifts(scratch.resource());
+    size_t chunks = 0;
+    if (sobol) {
+        sequence = std::make_unique<SobolSequence>(steps);
+        bridge = std::make_unique<BrownianBridge>(steps);
+        shifts.resize(static_cast<size_t>(replications) * steps);
+        for (uint32_t r = 0; r < replications; ++r) {
+            for (uint32_t d = 0; d < steps; ++d) {
+                shifts[static_cast<size_t>(r) * steps + d] =
+                    Random::Philox4x32::generate(Random::Philox4x32::Counter{{d, r + 1, 0u, 0u}}, setup.key)[0];
+            }
+        }
+        setup.sobol = sequence.get();
+        setup.bridge = bridge.get();
+        setup.shifts = shifts.data();
+        chunks = static_cast<size_t>((per_replication + BLOCK_PATHS - 1) / BLOCK_PATHS);
+    }
+    
+    const size_t samples_per_block = antithetic ? BLOCK_PATHS / 2 : BLOCK_PATHS;
+    const size_t blocks = sobol ? chunks * static_cast<size_t>(replications)
+                                : static_cast<size_t>((samples + samples_per_block - 1) / samples_per_block);
+    const size_t available = pool_->size() + 1;
+    const size_t threads = std::min(options_.parallel
+                                        ? (options_.max_threads == 0 ? available : std::min(options_.max_threads, available))
+                                        : size_t(1),
+                                    blocks);
+    
+    LOG_DEBUG(logger_, "Monte Carlo {} ({}{}): {} paths x {} steps in {} blocks on {} threads",
+              to_string(contract.payoff), to_string(options_.sampling), adjoint ? ", adjoint" : "",
+              paths, setup.steps, blocks, threads);
+    
+    std::pmr::vector<BlockSums> block_sums(blocks, scratch.resource());
+    pool_->parallel_for(blocks, [&](size_t block) {
+        if (sobol) {
+            const uint32_t replication = static_cast<uint32_t>(block / chunks);
+            const uint64_t first = static_cast<uint64_t>(block % chunks) * BLOCK_PATHS;
+            const size_t count = static_cast<size_t>(std::min<uint64_t>(BLOCK_PATHS, per_replication - first));
+            block_sums[block] = adjoint ? simulate_adjoint_sobol_block(setup, params, replication, first, count)
+                                        : simulate_sobol_block(setup, replication, first, count);
+        } else {
+            const uint64_t first = static_cast<uint64_t>(block) * samples_per_block;
+            const size_t count = static_cast<size_t>(std::min<uint64_t>(samples_per_block, samples - first));
+            block_sums[block] = adjoint ? simulate_adjoint_block(setup, params, first, count)
+                                        : simulate_block(setup, first, count);
+        }
+    }, threads);
+    
+    // Combine in block order so the result does not depend on scheduling
+    const size_t estimates = adjoint ? size_t(ESTIMATES) : size_t(1);
+    for (size_t e = 0; e < estimates; ++e) {
+        double mean = 0.0;
+        double variance_of_mean = 0.0;
+        if (sobol) {
+            // Replication means are i.i.d. and unbiased; their spread gives the error
+            std::pmr::vector<double> replication_means(static_cast<size_t>(replications), 0.0, scratch.resource());
+            for (size_t block = 0; block < blocks; ++block) {
+                replication_means[block / chunks] += block_sums[block].sum[e];
+            }
+            for (double& m : replication_means) {
+                m /= static_cast<double>(per_replication);
+                mean += m;
+            }
+            const double R = static_cast<double>(replications);
+            mean /= R;
+            for (double m : replication_means) {
+                variance_of_mean += (m - mean) * (m - mean);
+            }
+            variance_of_mean /= (R - 1.0) * R;
+        } else {
+            double sum = 0.0;
+            double sum_sq = 0.0;
+            for (const BlockSums& block : block_sums) {
+                sum += block.sum[e];
+                sum_sq += block.sum_sq[e];
+            }
+            const double n = static_cast<double>(samples);
+            mean = sum / n;
+            variance_of_mean = std::max(sum_sq / n - mean * mean, 0.0) / (n - 1.0);
+        }
+        means[e] = mean;
+        errors[e] = std::sqrt(variance_of_mean);
+    }
+    
+    result.paths = paths;
+    result.threads = threads;
+    return true;
+}
+
+MonteCarloResult MonteCarloEngine::price(const Parameters& params, const PathContract& contract) const {
+    MonteCarloResult result;
+    double mean = 0.0;
+    double error = 0.0;
+    if (!simulate(params, contract, false, result, &mean, &error)) {
+        return result;
+    }
+    const double discount = std::exp(-params.risk_free_rate * params.time_to_expiry);
+    
+    result.price = discount * mean;
+    result.std_error = discount * error;
+    result.is_valid = std::isfinite(result.price);
+    if (!result.is_valid) {
+        result.error_msg = "Non-finite Monte Carlo estimate";
+        LOG_ERROR(logger_, "Failed to price {} option by Monte Carlo: {}", to_string(contract.payoff), result.error_msg);
+        return result;
+    }
+    
+    LOG_INFO(logger_, "{} option priced by Monte Carlo ({}): ${:.4f} ± {:.4f} ({} paths)",
+             to_string(contract.payoff), to_string(options_.sampling), result.price, result.std_error, result.paths);
+    return result;
+}
+
+MonteCarloGreeks MonteCarloEngine::price_with_greeks(const Parameters& params, const PathContract& contract) const {
+    MonteCarloGreeks result;
+    MonteCarloResult& estimate = result.estimate;
+    double means[ESTIMATES];
+    double errors[ESTIMATES];
+    if (!simulate(params, contract, true, estimate, means, errors)) {
+        return result;
+    }
+    
+    // Greeks units: theta is -∂V/∂T per day, vega and rho per 1%
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    result.greeks = Greeks(means[SPOT], nan, -means[EXPIRY] / 365.0, means[VOLATILITY] / 100.0, means[RATE] / 100.0);
+    result.std_error = Greeks(errors[SPOT], nan, errors[EXPIRY] / 365.0, errors[VOLATILITY] / 100.0, errors[RATE] / 100.0);
+    result.dividend_rho = means[DIVIDEND] / 100.0;
+    result.dual_delta = means[STRIKE];
+    estimate.price = means[VALUE];
+    estimate.std_error = errors[VALUE];
+    
+    bool finite = true;
+    for (size_t e = 0; e < ESTIMATES; ++e) {
+        finite = finite && std::isfinite(means[e]);
+    }
+    estimate.is_valid = finite;
+    if (!estimate.is_valid) {
+        estimate.error_msg = "Non-finite Monte Carlo estimate";
+        LOG_ERROR(logger_, "Failed to price {} option by Monte Carlo: {}", to_string(contract.payoff), estimate.error_msg);
+        return result;
+    }
+    
+    LOG_INFO(logger_, "{} option priced by adjoint Monte Carlo ({}): ${:.4f} ± {:.4f}, delta {:.4f}, vega {:.4f} ({} paths)",
+             to_string(contract.payoff), to_string(options_.sampling), estimate.price, estimate.std_error,
+             result.greeks.delta, result.greeks.vega, estimate.paths);
+    return result;
+}
+
+} // namespace BlackScholes
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "black_scholes.hpp"
+
+namespace Utils {
+class ThreadPool;
+}
+
+/**
+ * @file monte_carlo.hpp
+ * @brief Parallel Monte Carlo pricing of path-dependent options
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * Paths follow geometric Brownian motion under the risk-neutral measure,
+ * simulated with the exact log-Euler step
+ *   ln S(t+Δt) = ln S(t) + (r - q - σ²/2)Δt + σ√Δt Z,
+ * and barriers are monitored at every step (discrete monitoring).
+ *
+ * Paths are split into fixed-size blocks that are distributed across a
+ * thread pool. The normal draws for (path, step) come from a Philox
+ * counter-based generator keyed by the seed, and block results are
+ * combined in block order, so the price is bit-for-bit identical for any
+ * number of threads.
+ *
+ * MonteCarloSampling::SOBOL replaces the pseudo-random draws with a
+ * Sobol sequence (one dimension per step) and builds each path with a
+ * Brownian bridge. The error then falls close to 1/N instead of 1/√N.
+ * The sequence is randomized by qmc_replications independent digital
+ * shifts, and the standard error is estimated from the spread of the
+ * per-shift means.
+ *
+ * price_with_greeks() runs the same paths on an AD::Real tape and sweeps
+ * it backward once per sample, so one simulation gives the price and its
+ * pathwise derivatives with respect to spot, strike, expiry, rate,
+ * volatility and dividend yield. The pathwise estimator needs a payoff
+ * that is continuous in the path, so barrier payoffs are rejected.
+ */
+
+namespace BlackScholes {
+
+/**
+ * @brief Payoff types supported by MonteCarloEngine
+ */
+enum class PathPayoff : uint8_t {
+    EUROPEAN = 0,           ///< max(±(S_T - K), 0)
+    ASIAN_ARITHMETIC = 1,   ///< max(±(A - K), 0), A = mean of S over the monitoring dates
+    UP_AND_OUT = 2,         ///< European payoff, void if S ≥ barrier on any date
+    DOWN_AND_OUT = 3,       ///< European payoff, void if S ≤ barrier on any date
+    UP_AND_IN = 4,          ///< European payoff, only if S ≥ barrier on some date
+    DOWN_AND_IN = 5,        ///< European payoff, only if S ≤ barrier on some date
+    LOOKBACK_FLOATING = 6,  ///< Call: S_T - min S, put: max S - S_T
+    LOOKBACK_FIXED = 7,     ///< Call: max(max S - K, 0), put: max(K - min S, 0)
+    ASIAN_GEOMETRIC = 8     ///< max(±(G - K), 0), G = geometric mean of S over the monitoring dates
+};
+
+/**
+ * @brief Convert payoff type to string representation
+ * @param payoff Payoff type to convert
+ * @return String representation of payoff type
+ */
+const char* to_string(PathPayoff payoff) noexcept;
+
+/**
+ * @brief Source of the normal draws
+ */
+enum class MonteCarloSampling : uint8_t {
+    PSEUDO_RANDOM = 0,  ///< Philox counter-based generator
+    SOBOL = 1           ///< Randomized Sobol sequence with Brownian-bridge paths
+};
+
+/**
+ * @brief Convert sampling method to string representation
+ * @param sampling Sampling method to convert
+ * @return String representation of sampling method
+ */
+const char* to_string(MonteCarloSampling sampling) noexcept;
+
+/**
+ * @brief Closed-form price of a discretely monitored geometric Asian option
+ *
+ * ln G is normal when S follows geometric Brownian motion, so the option
+ * prices like a European on G. Used as a control and convergence reference.
+ *
+ * @param params Market parameters
+ * @param is_call Call or put
+ * @param steps Equally spaced monitoring dates ending at expiry
+ * @return Option price
+ */
+double geometric_asian_price(const Parameters& params, bool is_call, uint32_t steps) noexcept;
+
+/**
+ * @brief Path-dependent contract terms
+ */
+struct PathContract {
+    PathPayoff payoff = PathPayoff::EUROPEAN;   ///< Payoff type
+    bool is_call = true;                        ///< Call or put
+    double barrier = 0.0;                       ///< Barrier level (barrier payoffs only)
+};
+
+/**
+ * @brief Simulation settings for MonteCarloEngine
+ */
+struct MonteCarloOptions {
+    uint64_t simulations = 100000;  ///< Number of paths (antithetic pairs count as two)
+    uint32_t steps = 252;           ///< Monitoring dates per path (European payoffs use one)
+    bool antithetic = true;         ///< Pair every path with its mirror image (-Z); pseudo-random only
+    uint64_t seed = 42;             ///< Philox key (also draws the Sobol digital shifts)
+    bool parallel = true;           ///< Distribute blocks across the thread pool
+    size_t max_threads = 0;         ///< Thread limit including the caller (0 = pool size + 1)
+    MonteCarloSampling sampling = MonteCarloSampling::PSEUDO_RANDOM;  ///< Draw source
+    uint32_t qmc_replications = 8;  ///< Independently shifted Sobol sequences (at least 2)
+    
+    /**
+     * @brief Read monte_carlo.* and threading.* settings
+     * @return Options populated from configuration
+     */
+    static MonteCarloOptions from_config();
+};
+
+/**
+ * @brief Monte Carlo price estimate
+ */
+struct MonteCarloResult {
+    double price;           ///< Discounted mean payoff
+    double std_error;       ///< Standard error of the estimate
+    uint64_t paths;         ///< Paths simulated
+    size_t threads;         ///< Threads that were allowed to run blocks
+    bool is_valid;          ///< Whether the simulation ran
+    std::string error_msg;  ///< Error message if it did not
+    
+    MonteCarloResult() : price(0.0), std_error(0.0), paths(0), threads(0), is_valid(false) {}
+};
+
+/**
+ * @brief Monte Carlo price with pathwise adjoint Greeks
+ *
+ * Greeks use the units of calculate_call_greeks() (theta per day, vega
+ * and rho per 1%). The pathwise estimator gives no gamma.
+ */
+struct MonteCarloGreeks {
+    MonteCarloResult estimate;  ///< Price, standard error and simulation figures
+    Greeks greeks;              ///< Delta, theta, vega and rho; gamma is NaN
+    Greeks std_error;           ///< Standard errors of greeks; gamma is NaN
+    double dividend_rho;        ///< ∂V/∂q (per 1%)
+    double dual_delta;          ///< ∂V/∂K
+    
+    MonteCarloGreeks() : greeks(), std_error(), dividend_rho(0.0), dual_delta(0.0) {}
+};
+
+/**
+ * @brief Monte Carlo engine for path-dependent payoffs
+ */
+class MonteCarloEngine {
+private:
+    MonteCarloOptions options_;
+    Utils::ThreadPool* pool_;
+    static thread_local Utils::Logger logger_;
+    
+    /**
+     * @brief Validate the contract, simulate the blocks and combine them in block order
+     * @param adjoint Differentiate each sample on the AD tape
+     * @param result Receives paths and threads, or error_msg
+     * @param means Sample means: the undiscounted payoff, or with adjoint the
+     *              discounted payoff followed by its derivatives (7 values)
+     * @param errors Standard errors of the means
+     * @return Whether the simulation ran
+     */
+    bool simulate(const Parameters& params, const PathContract& contract, bool adjoint,
+                  MonteCarloResult& result, double* means, double* errors) const;
+
+public:
+    /// Paths simulated together by one task (fixed so results do not depend on threading)
+    static constexpr size_t BLOCK_PATHS = 1024;
+    
+    /// Largest step count supported by Sobol sampling (one dimension per step)
+    static constexpr uint32_t MAX_SOBOL_STEPS = 1024;
+    
+    /**
+     * @brief Create an engine
+     * @param options Simulation settings
+     * @param pool Thread pool for the blocks (nullptr = Utils::ThreadPool::shared())
+     */
+    explicit MonteCarloEngine(const MonteCarloOptions& options = MonteCarloOptions::from_config(),
+                              Utils::ThreadPool* pool = nullptr);
+    
+    /**
+     * @brief Price a contract
+     * @param params Market parameters (volatility is used as the path volatility)
+     * @param contract Payoff terms
+     * @return Price and standard error, or is_valid = false with error_msg
+     */
+    MonteCarloResult price(const Parameters& params, const PathContract& contract) const;
+    
+    /**
+     * @brief Price a contract and differentiate every path by adjoint AD
+     *
+     * Uses the same draws as price(), so the prices agree to rounding.
+     *
+     * @param params Market parameters (volatility is used as the path volatility)
+     * @param contract Payoff terms (not a barrier payoff)
+     * @return Price, Greeks and their standard errors, or estimate.is_valid = false with error_msg
+     */
+    MonteCarloGreeks price_with_greeks(const Parameters& params, const PathContract& contract) const;
+    
+    const MonteCarloOptions& options() const noexcept { return options_; }
+};
+
+} // namespace BlackScholes
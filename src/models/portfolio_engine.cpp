@@ -0,0 +1,277 @@
+#include "portfolio_engine.hpp"
+#include "../utils/thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace BlackScholes {
+
+namespace {
+
+// Pairwise sum of count partial results spaced stride apart; the shape depends only on count
+PortfolioGreeks tree_sum(const PortfolioGreeks* sums, size_t stride, size_t count) noexcept {
+    if (count == 0) {
+        return PortfolioGreeks();
+    }
+    if (count == 1) {
+        return sums[0];
+    }
+    const size_t half = count / 2;
+    PortfolioGreeks total = tree_sum(sums, stride, half);
+    total += tree_sum(sums + half * stride, stride, count - half);
+    return total;
+}
+
+} // namespace
+
+PortfolioEngine::PortfolioEngine(const std::vector<Position>& positions, const std::vector<std::string>& underlyings,
+                                 const PortfolioOptions& options, Utils::ThreadPool* pool)
+    : options_(options), pool_(pool != nullptr ? pool : &Utils::ThreadPool::shared()),
+      buckets_(options.expiry_buckets.size() + 1) {
+    if (positions.size() != underlyings.size()) {
+        throw std::invalid_argument("Portfolio needs one underlying per position");
+    }
+    const std::vector<double>& edges = options_.expiry_buckets;
+    for (size_t i = 0; i < edges.size(); ++i) {
+        if (!std::isfinite(edges[i]) || !(edges[i] > 0.0) || (i > 0 && !(edges[i] > edges[i - 1]))) {
+            throw std::invalid_argument("Portfolio expiry buckets must be positive, finite and strictly increasing");
+        }
+    }
+    if (buckets_ > UINT16_MAX) {
+        throw std::invalid_argument("Portfolio has too many expiry buckets");
+    }
+    
+    // Group by underlying in order of first appearance, keeping position order within a group
+    const size_t n = positions.size();
+    std::vector<size_t> group(n);
+    for (size_t i = 0; i < n; ++i) {
+        const auto inserted = index_.emplace(underlyings[i], names_.size());
+        if (inserted.second) {
+            names_.push_back(underlyings[i]);
+        }
+        group[i] = inserted.first->second;
+    }
+    const size_t groups = names_.size();
+    group_begin_.assign(groups + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        ++group_begin_[group[i] + 1];
+    }
+    std::partial_sum(group_begin_.begin(), group_begin_.end(), group_begin_.begin());
+    std::vector<size_t> next(group_begin_.begin(), group_begin_.end() - 1);
+    slot_.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        slot_[i] = next[group[i]]++;
+    }
+    
+    for (std::vector<double>* column : {&spot_, &strike_, &time_, &rate_, &vol_, &dividend_, &quantity_,
+                                        &value_, &delta_, &gamma_, &theta_, &vega_, &rho_}) {
+        column->resize(n);
+    }
+    is_call_.resize(n);
+    status_.resize(n);
+    bucket_.resize(n);
+    dirty_.assign(n, 1);
+    for (size_t i = 0; i < n; ++i) {
+        const size_t s = slot_[i];
+        const Parameters& p = positions[i].params;
+        spot_[s] = p.spot_price;
+        strike_[s] = p.strike_price;
+        time_[s] = p.time_to_expiry;
+        rate_[s] = p.risk_free_rate;
+        vol_[s] = p.volatility;
+        dividend_[s] = p.dividend_yield;
+        quantity_[s] = positions[i].quantity;
+        is_call_[s] = positions[i].is_call ? 1 : 0;
+    }
+    
+    // Leaves cut every underlying into runs of LEAF_POSITIONS slots
+    group_leaf_begin_.resize(groups + 1);
+    for (size_t u = 0; u < groups; ++u) {
+        group_leaf_begin_[u] = leaf_begin_.size();
+        for (size_t begin = group_begin_[u]; begin < group_begin_[u + 1]; begin += LEAF_POSITIONS) {
+            leaf_begin_.push_back(begin);
+        }
+    }
+    group_leaf_begin_[groups] = leaf_begin_.size();
+    const size_t leaves = leaf_begin_.size();
+    leaf_begin_.push_back(n);
+    
+    leaf_dirty_.assign(leaves, 1);
+    pending_.resize(leaves);
+    std::iota(pending_.begin(), pending_.end(), size_t(0));
+    leaf_sums_.resize(leaves * buckets_);
+    cells_.resize(groups * buckets_);
+    by_underlying_.resize(groups);
+    by_expiry_.resize(buckets_);
+    refresh();
+}
+
+size_t PortfolioEngine::bucket(double time_to_expiry) const noexcept {
+    const std::vector<double>& edges = options_.expiry_buckets;
+    return static_cast<size_t>(std::lower_bound(edges.begin(), edges.end(), time_to_expiry) - edges.begin());
+}
+
+size_t PortfolioEngine::underlying(const std::string& name) const {
+    const auto found = index_.find(name);
+    if (found == index_.end()) {
+        throw std::invalid_argument("Portfolio has no position on underlying " + name);
+    }
+    return found->second;
+}
+
+size_t PortfolioEngine::slot(size_t position) const {
+    if (position >= positions()) {
+        throw std::invalid_argument("Portfolio position index out of range");
+    }
+    return slot_[position];
+}
+
+void PortfolioEngine::mark(size_t slot, bool reprice) noexcept {
+    if (reprice) {
+        dirty_[slot] = 1;
+    }
+    const size_t leaf = static_cast<size_t>(std::upper_bound(leaf_begin_.begin(), leaf_begin_.end(), slot) -
+                                            leaf_begin_.begin()) - 1;
+    if (leaf_dirty_[leaf] == 0) {
+        leaf_dirty_[leaf] = 1;
+        pending_.push_back(leaf);
+    }
+}
+
+void PortfolioEngine::set_spot(size_t underlying, double spot) {
+    if (underlying >= underlyings()) {
+        throw std::invalid_argument("Portfolio underlying index out of range");
+    }
+    if (!std::isfinite(spot) || !(spot > 0.0)) {
+        throw std::invalid_argument("Spot price must be positive and finite");
+    }
+    for (size_t s = group_begin_[underlying]; s < group_begin_[underlying + 1]; ++s) {
+        if (spot_[s] != spot) {
+            spot_[s] = spot;
+            mark(s, true);
+        }
+    }
+}
+
+void PortfolioEngine::set_volatility(size_t position, double volatility) {
+    const size_t s = slot(position);
+    if (!std::isfinite(volatility) || !(volatility > 0.0)) {
+        throw std::invalid_argument("Volatility must be positive and finite");
+    }
+    if (vol_[s] != volatility) {
+        vol_[s] = volatility;
+        mark(s, true);
+    }
+}
+
+void PortfolioEngine::set_quantity(size_t position, double quantity) {
+    const size_t s = slot(position);
+    if (!std::isfinite(quantity)) {
+        throw std::invalid_argument("Position quantity must be finite");
+    }
+    if (quantity_[s] != quantity) {
+        quantity_[s] = quantity;
+        mark(s, false);
+    }
+}
+
+void PortfolioEngine::set_parameters(size_t position, const Parameters& params) {
+    const size_t s = slot(position);
+    spot_[s] = params.spot_price;
+    strike_[s] = params.strike_price;
+    time_[s] = params.time_to_expiry;
+    rate_[s] = params.risk_free_rate;
+    vol_[s] = params.volatility;
+    dividend_[s] = params.dividend_yield;
+    mark(s, true);
+}
+
+size_t PortfolioEngine::refresh_leaf(size_t leaf) noexcept {
+    const size_t begin = leaf_begin_[leaf];
+    const size_t end = leaf_begin_[leaf + 1];
+    
+    // Reprice each run of dirty slots as one batch
+    size_t repriced = 0;
+    for (size_t i = begin; i < end;) {
+        if (dirty_[i] == 0) {
+            ++i;
+            continue;
+        }
+        size_t run = i;
+        for (; run < end && dirty_[run] != 0; ++run) {
+            dirty_[run] = 0;
+            bucket_[run] = static_cast<uint16_t>(bucket(time_[run]));
+        }
+        const BatchInput input{&spot_[i], &strike_[i], &time_[i], &rate_[i], &vol_[i], &dividend_[i],
+                               &is_call_[i], run - i};
+        BatchOutput output;
+        output.price = &value_[i];
+        output.delta = &delta_[i];
+        output.gamma = &gamma_[i];
+        output.theta = &theta_[i];
+        output.vega = &vega_[i];
+        output.rho = &rho_[i];
+        output.status = &status_[i];
+        OptionPricer::price_batch(input, output);
+        repriced += run - i;
+        i = run;
+    }
+    
+    // Net the leaf in slot order
+    PortfolioGreeks* const sums = &leaf_sums_[leaf * buckets_];
+    std::fill(sums, sums + buckets_, PortfolioGreeks());
+    for (size_t i = begin; i < end; ++i) {
+        PortfolioGreeks& cell = sums[bucket_[i]];
+        if (status_[i] != BatchStatus::OK) {
+            ++cell.rejected;
+            continue;
+        }
+        const double quantity = quantity_[i];
+        cell.value += quantity * value_[i];
+        cell.delta += quantity * delta_[i];
+        cell.gamma += quantity * gamma_[i];
+        cell.theta += quantity * theta_[i];
+        cell.vega += quantity * vega_[i];
+        cell.rho += quantity * rho_[i];
+        ++cell.positions;
+    }
+    leaf_dirty_[leaf] = 0;
+    return repriced;
+}
+
+size_t PortfolioEngine::refresh() {
+    if (pending_.empty()) {
+        return 0;
+    }
+    std::atomic<size_t> repriced{0};
+    pool_->parallel_for_range(pending_.size(), [&](size_t first, size_t last) {
+        size_t count = 0;
+        for (size_t k = first; k < last; ++k) {
+            count += refresh_leaf(pending_[k]);
+        }
+        repriced.fetch_add(count, std::memory_order_relaxed);
+    }, 1, options_.max_threads);
+    pending_.clear();
+    
+    // Leaves pairwise per (underlying, bucket), then cells in index order
+    std::fill(by_expiry_.begin(), by_expiry_.end(), PortfolioGreeks());
+    total_ = PortfolioGreeks();
+    for (size_t u = 0; u < underlyings(); ++u) {
+        const size_t first_leaf = group_leaf_begin_[u];
+        const size_t leaves = group_leaf_begin_[u + 1] - first_leaf;
+        PortfolioGreeks sum;
+        for (size_t b = 0; b < buckets_; ++b) {
+            PortfolioGreeks& cell = cells_[u * buckets_ + b];
+            cell = tree_sum(&leaf_sums_[first_leaf * buckets_ + b], buckets_, leaves);
+            sum += cell;
+            by_expiry_[b] += cell;
+        }
+        by_underlying_[u] = sum;
+        total_ += sum;
+    }
+    return repriced.load(std::memory_order_relaxed);
+}
+
+} // namespace BlackScholes
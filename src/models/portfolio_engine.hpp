@@ -0,0 +1,214 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "black_scholes.hpp"
+#include "scenario_engine.hpp"
+
+/**
+ * @file portfolio_engine.hpp
+ * @brief Position-weighted portfolio Greeks with dirty tracking and deterministic netting
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * A PortfolioEngine keeps the inputs and unit Greeks of every position in
+ * structure-of-arrays columns, grouped by underlying, and nets
+ * quantity-weighted value, delta, gamma, theta, vega and rho by
+ * underlying, by expiry bucket and in total. Typical use:
+ *
+ *   PortfolioEngine book(positions, underlyings);
+ *   book.set_spot(book.underlying("SPX"), 4512.25);     // marks the SPX positions dirty
+ *   book.refresh();                                     // reprices only those
+ *   const PortfolioGreeks& spx = book.underlying_greeks(book.underlying("SPX"));
+ *
+ * Setters only record what changed; refresh() reprices the dirty
+ * positions with OptionPricer::price_batch() and re-nets the leaves that
+ * hold them. A quantity change re-nets without repricing.
+ *
+ * Netting is a fixed tree: positions are summed in order within leaves of
+ * LEAF_POSITIONS (which never span two underlyings), leaves are summed
+ * pairwise per underlying and expiry bucket, and those cells are summed in
+ * index order. Leaves are netted in parallel on a thread pool, but the
+ * tree depends only on the portfolio, so the totals are bit-identical
+ * across runs, thread counts and incremental or full refreshes.
+ */
+
+namespace BlackScholes {
+
+/**
+ * @brief Quantity-weighted Greeks of a set of positions
+ *
+ * Same units as calculate_call_greeks() (theta per day, vega and rho per
+ * 1%), multiplied by the signed quantity.
+ */
+struct PortfolioGreeks {
+    double value = 0.0;     ///< Σ quantity · V
+    double delta = 0.0;     ///< Σ quantity · ∂V/∂S
+    double gamma = 0.0;     ///< Σ quantity · ∂²V/∂S²
+    double theta = 0.0;     ///< Σ quantity · ∂V/∂t (per day)
+    double vega = 0.0;      ///< Σ quantity · ∂V/∂σ (per 1%)
+    double rho = 0.0;       ///< Σ quantity · ∂V/∂r (per 1%)
+    size_t positions = 0;   ///< Positions netted
+    size_t rejected = 0;    ///< Positions left out because price_batch() rejected them
+    
+    PortfolioGreeks& operator+=(const PortfolioGreeks& other) noexcept {
+        value += other.value;
+        delta += other.delta;
+        gamma += other.gamma;
+        theta += other.theta;
+        vega += other.vega;
+        rho += other.rho;
+        positions += other.positions;
+        rejected += other.rejected;
+        return *this;
+    }
+};
+
+/**
+ * @brief Settings for PortfolioEngine
+ */
+struct PortfolioOptions {
+    /// Upper bucket edges in years: bucket b holds edge[b-1] < T <= edge[b], the last bucket T > edge.back()
+    std::vector<double> expiry_buckets = {0.25, 0.5, 1.0, 2.0};
+    size_t max_threads = 0;             ///< Thread limit including the caller (0 = pool size + 1)
+};
+
+/**
+ * @brief Portfolio of European options netted into Greeks by underlying and expiry
+ */
+class PortfolioEngine {
+private:
+    PortfolioOptions options_;
+    Utils::ThreadPool* pool_;
+    size_t buckets_;
+    
+    // Underlyings in order of first appearance; slots of underlying u are [group_begin_[u], group_begin_[u + 1])
+    std::vector<std::string> names_;
+    std::unordered_map<std::string, size_t> index_;
+    std::vector<size_t> group_begin_;
+    std::vector<size_t> group_leaf_begin_;      ///< Leaves of underlying u are [group_leaf_begin_[u], group_leaf_begin_[u + 1])
+    std::vector<size_t> slot_;                  ///< Slot of each position, in constructor order
+    
+    // Inputs and unit results per slot, structure-of-arrays
+    std::vector<double> spot_, strike_, time_, rate_, vol_, dividend_, quantity_;
+    std::vector<uint8_t> is_call_;
+    std::vector<double> value_, delta_, gamma_, theta_, vega_, rho_;
+    std::vector<uint32_t> status_;
+    std::vector<uint16_t> bucket_;
+    std::vector<uint8_t> dirty_;                ///< Inputs changed since the last refresh()
+    
+    // Netting tree
+    std::vector<size_t> leaf_begin_;            ///< Slots of leaf l are [leaf_begin_[l], leaf_begin_[l + 1])
+    std::vector<uint8_t> leaf_dirty_;
+    std::vector<PortfolioGreeks> leaf_sums_;    ///< leaf_sums_[leaf * buckets + bucket]
+    std::vector<PortfolioGreeks> cells_;        ///< cells_[underlying * buckets + bucket]
+    std::vector<PortfolioGreeks> by_underlying_;
+    std::vector<PortfolioGreeks> by_expiry_;
+    PortfolioGreeks total_;
+    std::vector<size_t> pending_;               ///< Dirty leaves awaiting refresh()
+    
+    size_t refresh_leaf(size_t leaf) noexcept;
+    void mark(size_t slot, bool reprice) noexcept;
+    size_t slot(size_t position) const;
+
+public:
+    /// Positions netted sequentially by one task; fixes the shape of the netting tree
+    static constexpr size_t LEAF_POSITIONS = 256;
+    
+    /**
+     * @brief Capture a portfolio and net its Greeks
+     * @param positions Portfolio
+     * @param underlyings Underlying of each position (same length as positions)
+     * @param options Expiry buckets and thread limit
+     * @param pool Thread pool for refresh() (nullptr = Utils::ThreadPool::shared())
+     * @throws std::invalid_argument if the lengths differ or the bucket edges are not positive and increasing
+     */
+    PortfolioEngine(const std::vector<Position>& positions, const std::vector<std::string>& underlyings,
+                    const PortfolioOptions& options = PortfolioOptions(), Utils::ThreadPool* pool = nullptr);
+    
+    /**
+     * @brief Move the spot of every position on an underlying
+     * @throws std::invalid_argument if the index is out of range or the spot is not positive and finite
+     */
+    void set_spot(size_t underlying, double spot);
+    
+    /**
+     * @brief Change a position's volatility
+     * @param position Index in the constructor's positions
+     * @throws std::invalid_argument if the index is out of range or σ is not positive and finite
+     */
+    void set_volatility(size_t position, double volatility);
+    
+    /**
+     * @brief Change a position's quantity (re-nets without repricing)
+     * @throws std::invalid_argument if the index is out of range or the quantity is not finite
+     */
+    void set_quantity(size_t position, double quantity);
+    
+    /**
+     * @brief Replace all of a position's market parameters, its spot included
+     * @throws std::invalid_argument if the index is out of range
+     */
+    void set_parameters(size_t position, const Parameters& params);
+    
+    /**
+     * @brief Reprice the dirty positions and re-net the totals
+     * @return Number of positions repriced
+     */
+    size_t refresh();
+    
+    /**
+     * @brief Whether any input changed since the last refresh()
+     */
+    bool dirty() const noexcept { return !pending_.empty(); }
+    
+    /**
+     * @brief Index of an underlying by name
+     * @throws std::invalid_argument if the portfolio has no position on it
+     */
+    size_t underlying(const std::string& name) const;
+    
+    const std::string& underlying_name(size_t underlying) const noexcept { return names_[underlying]; }
+    size_t underlyings() const noexcept { return names_.size(); }
+    size_t positions() const noexcept { return slot_.size(); }
+    
+    /**
+     * @brief Number of expiry buckets (bucket edges + 1)
+     */
+    size_t buckets() const noexcept { return buckets_; }
+    
+    /**
+     * @brief Expiry bucket of a maturity
+     */
+    size_t bucket(double time_to_expiry) const noexcept;
+    
+    /**
+     * @brief Greeks of the whole portfolio as of the last refresh()
+     */
+    const PortfolioGreeks& total() const noexcept { return total_; }
+    
+    /**
+     * @brief Greeks of the positions on one underlying
+     */
+    const PortfolioGreeks& underlying_greeks(size_t underlying) const noexcept { return by_underlying_[underlying]; }
+    
+    /**
+     * @brief Greeks of the positions in one expiry bucket, over every underlying
+     */
+    const PortfolioGreeks& expiry_greeks(size_t bucket) const noexcept { return by_expiry_[bucket]; }
+    
+    /**
+     * @brief Greeks of the positions on one underlying in one expiry bucket
+     */
+    const PortfolioGreeks& greeks(size_t underlying, size_t bucket) const noexcept {
+        return cells_[underlying * buckets_ + bucket];
+    }
+    
+    const PortfolioOptions& options() const noexcept { return options_; }
+};
+
+} // namespace BlackScholes
@@ -0,0 +1,207 @@
+#include "pricing_cache.hpp"
+#include "../utils/metrics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace BlackScholes {
+
+namespace {
+
+inline uint64_t to_bits(double value) noexcept {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline double from_bits(uint64_t bits) noexcept {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Fold one word into a running hash (multiply-xorshift, as in splitmix64)
+inline uint64_t mix(uint64_t hash, uint64_t word) noexcept {
+    hash ^= word + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+    hash ^= hash >> 31;
+    hash *= 0xBF58476D1CE4E5B9ull;
+    return hash ^ (hash >> 29);
+}
+
+// Largest power of two not above n (n >= 1)
+inline size_t floor_pow2(size_t n) noexcept {
+    size_t p = 1;
+    while (p <= n / 2) {
+        p *= 2;
+    }
+    return p;
+}
+
+} // namespace
+
+PricingCacheOptions PricingCacheOptions::from_config() {
+    PricingCacheOptions options;
+    const auto& config = Config::ConfigManager::getInstance().snapshot();
+    options.capacity = static_cast<size_t>(std::max(config.pricing_cache.capacity, 0));
+    options.tolerance = config.pricing_cache.tolerance;
+    return options;
+}
+
+bool PricingCache::Key::operator==(const Key& other) const noexcept {
+    return tag == other.tag && std::memcmp(inputs, other.inputs, sizeof(inputs)) == 0;
+}
+
+PricingCache::PricingCache(const PricingCacheOptions& options)
+    : tolerance_(std::max(options.tolerance, 0.0)) {
+    // Rounding to a multiple of 2^drop ULPs moves a value by at most 2^(drop - 53) relative
+    if (tolerance_ > 0.0) {
+        const int drop = static_cast<int>(std::floor(std::log2(tolerance_))) + 53;
+        drop_bits_ = static_cast<unsigned>(std::clamp(drop, 0, 52));
+    }
+    
+    const size_t sets = (options.capacity + WAYS - 1) / WAYS;
+    shard_count_ = std::min(MAX_SHARDS, floor_pow2(std::max<size_t>(sets, 1)));
+    sets_per_shard_ = (sets + shard_count_ - 1) / shard_count_;
+    shards_.reset(new Shard[shard_count_]);
+    for (size_t s = 0; s < shard_count_; ++s) {
+        shards_[s].entries.resize(sets_per_shard_ * WAYS);
+        shards_[s].hands.assign(sets_per_shard_, 0);
+    }
+}
+
+PricingCache& PricingCache::shared() {
+    static PricingCache cache(PricingCacheOptions::from_config());
+    return cache;
+}
+
+double PricingCache::quantize(double value) const noexcept {
+    if (drop_bits_ == 0 || !std::isfinite(value)) {
+        return value;
+    }
+    // Sign-magnitude layout: adding half a step and truncating rounds |value| to nearest
+    const uint64_t step = uint64_t(1) << drop_bits_;
+    return from_bits((to_bits(value) + step / 2) & ~(step - 1));
+}
+
+PricingCache::Key PricingCache::make_key(double& S, double& K, double& T, double& r, double& sigma,
+                                         double& q, bool is_call, uint32_t outputs) const noexcept {
+    S = quantize(S);
+    K = quantize(K);
+    T = quantize(T);
+    r = quantize(r);
+    sigma = quantize(sigma);
+    q = quantize(q);
+    
+    Key key;
+    key.inputs[0] = to_bits(S);
+    key.inputs[1] = to_bits(K);
+    key.inputs[2] = to_bits(T);
+    key.inputs[3] = to_bits(r);
+    key.inputs[4] = to_bits(sigma);
+    key.inputs[5] = to_bits(q);
+    key.tag = (is_call ? 1u : 0u) | (outputs << 1);
+    return key;
+}
+
+QuoteResult PricingCache::quote(double S, double K, double T, double r, double sigma, double q,
+                                bool is_call, uint32_t outputs) {
+    const Key key = make_key(S, K, T, r, sigma, q, is_call, outputs);
+    uint64_t hash = key.tag;
+    for (uint64_t word : key.inputs) {
+        hash = mix(hash, word);
+    }
+    
+    Shard& shard = shards_[hash & (shard_count_ - 1)];
+    if (sets_per_shard_ == 0) {
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            ++shard.misses;
+        }
+        Utils::Metrics::add(Utils::MetricCounter::CACHE_MISSES);
+        return OptionPricer::quote(S, K, T, r, sigma, q, is_call, outputs);
+    }
+    
+    // Map the high bits onto [0, sets_per_shard_) without a division
+    const size_t set = static_cast<size_t>(((hash >> 32) * sets_per_shard_) >> 32);
+    Entry* const ways = &shard.entries[set * WAYS];
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (size_t w = 0; w < WAYS; ++w) {
+            if (ways[w].occupied && ways[w].key == key) {
+                ways[w].referenced = true;
+                ++shard.hits;
+                Utils::Metrics::add(Utils::MetricCounter::CACHE_HITS);
+                return ways[w].result;
+            }
+        }
+        ++shard.misses;
+    }
+    Utils::Metrics::add(Utils::MetricCounter::CACHE_MISSES);
+    
+    // Price outside the lock; a concurrent miss on the same key prices it too
+    const QuoteResult result = OptionPricer::quote(S, K, T, r, sigma, q, is_call, outputs);
+    
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    Entry* slot = nullptr;
+    for (size_t w = 0; w < WAYS && slot == nullptr; ++w) {
+        if (!ways[w].occupied || ways[w].key == key) {
+            slot = &ways[w];
+        }
+    }
+    if (slot == nullptr) {
+        // CLOCK: clear reference bits until an unreferenced entry comes round
+        uint8_t& hand = shard.hands[set];
+        while (ways[hand].referenced) {
+            ways[hand].referenced = false;
+            hand = static_cast<uint8_t>((hand + 1) % WAYS);
+        }
+        slot = &ways[hand];
+        hand = static_cast<uint8_t>((hand + 1) % WAYS);
+        ++shard.evictions;
+    } else if (!slot->occupied) {
+        ++shard.size;
+    }
+    slot->key = key;
+    slot->result = result;
+    slot->occupied = true;
+    slot->referenced = false;
+    return result;
+}
+
+PricingCacheStats PricingCache::stats() const {
+    PricingCacheStats stats;
+    for (size_t s = 0; s < shard_count_; ++s) {
+        const Shard& shard = shards_[s];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.hits += shard.hits;
+        stats.misses += shard.misses;
+        stats.evictions += shard.evictions;
+        stats.size += shard.size;
+    }
+    return stats;
+}
+
+void PricingCache::clear() {
+    for (size_t s = 0; s < shard_count_; ++s) {
+        Shard& shard = shards_[s];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (Entry& entry : shard.entries) {
+            entry.occupied = false;
+            entry.referenced = false;
+        }
+        std::fill(shard.hands.begin(), shard.hands.end(), uint8_t(0));
+        shard.size = 0;
+    }
+}
+
+void PricingCache::reset_stats() {
+    for (size_t s = 0; s < shard_count_; ++s) {
+        Shard& shard = shards_[s];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.hits = 0;
+        shard.misses = 0;
+        shard.evictions = 0;
+    }
+}
+
+} // namespace BlackScholes
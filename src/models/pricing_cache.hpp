@@ -0,0 +1,191 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "black_scholes.hpp"
+
+/**
+ * @file pricing_cache.hpp
+ * @brief Bounded memoization of closed-form prices and Greeks
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * Interactive front ends re-price the same (S, K, T, r, σ, q) tuples many
+ * times. PricingCache sits in front of OptionPricer::quote() and returns
+ * the stored result for inputs it has seen before.
+ *
+ * Each input is rounded to a relative step given by the tolerance (the
+ * low mantissa bits are dropped), and the option is priced at the rounded
+ * inputs, so a hit and a miss for the same key return identical results.
+ * The key is the six rounded inputs plus call/put and the output flags;
+ * the full key is compared on lookup, so hash collisions cannot return a
+ * wrong result.
+ *
+ * Entries live in 8-way sets spread over independently locked shards.
+ * Within a set, CLOCK (second chance) picks the entry to evict, so memory
+ * is fixed at construction and a lookup costs one hash, one uncontended
+ * lock and at most eight key compares, well below one closed-form
+ * evaluation.
+ */
+
+namespace BlackScholes {
+
+/**
+ * @brief Construction settings for PricingCache
+ */
+struct PricingCacheOptions {
+    size_t capacity = 65536;    ///< Entries to keep (0 = every lookup is priced)
+    double tolerance = 1e-9;    ///< Relative rounding of each input (0 = exact key)
+    
+    /**
+     * @brief Read pricing_cache.capacity and pricing_cache.tolerance
+     * @return Options populated from configuration
+     */
+    static PricingCacheOptions from_config();
+};
+
+/**
+ * @brief Counters accumulated by PricingCache
+ */
+struct PricingCacheStats {
+    uint64_t hits = 0;          ///< Lookups served from the cache
+    uint64_t misses = 0;        ///< Lookups that were priced
+    uint64_t evictions = 0;     ///< Entries replaced to make room
+    size_t size = 0;            ///< Entries currently held
+    
+    /**
+     * @brief Fraction of lookups served from the cache
+     * @return hits / (hits + misses), or 0 before the first lookup
+     */
+    double hit_rate() const noexcept {
+        const uint64_t lookups = hits + misses;
+        return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+    }
+};
+
+/**
+ * @brief Concurrent, bounded cache of OptionPricer::quote() results
+ *
+ * Thread-safe. Lookups that hit perform no allocation or logging.
+ */
+class PricingCache {
+private:
+    static constexpr size_t WAYS = 8;           ///< Entries per set
+    static constexpr size_t MAX_SHARDS = 64;    ///< Independently locked groups of sets
+    
+    struct Key {
+        uint64_t inputs[6];     ///< Bit patterns of the rounded S, K, T, r, σ, q
+        uint32_t tag;           ///< is_call | outputs << 1
+        
+        bool operator==(const Key& other) const noexcept;
+    };
+    
+    struct Entry {
+        Key key;
+        QuoteResult result;
+        bool occupied = false;
+        bool referenced = false;    ///< CLOCK bit, set on every hit
+    };
+    
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::vector<Entry> entries;     ///< sets_per_shard_ * WAYS entries
+        std::vector<uint8_t> hands;     ///< CLOCK hand per set
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t size = 0;
+    };
+    
+    std::unique_ptr<Shard[]> shards_;
+    size_t shard_count_ = 0;        ///< Power of two
+    size_t sets_per_shard_ = 0;
+    unsigned drop_bits_ = 0;        ///< Mantissa bits rounded away
+    double tolerance_;
+    
+    Key make_key(double& S, double& K, double& T, double& r, double& sigma, double& q,
+                 bool is_call, uint32_t outputs) const noexcept;
+
+public:
+    /**
+     * @brief Create an empty cache
+     * @param options Capacity and key tolerance
+     */
+    explicit PricingCache(const PricingCacheOptions& options = PricingCacheOptions());
+    
+    PricingCache(const PricingCache&) = delete;
+    PricingCache& operator=(const PricingCache&) = delete;
+    
+    /**
+     * @brief Process-wide cache configured by PricingCacheOptions::from_config()
+     * @return Reference to the shared cache
+     */
+    static PricingCache& shared();
+    
+    /**
+     * @brief Cached equivalent of OptionPricer::quote()
+     *
+     * Prices the rounded inputs on a miss and stores the result, including
+     * BatchStatus error results.
+     *
+     * @param S Current stock price
+     * @param K Strike price
+     * @param T Time to expiration in years
+     * @param r Risk-free rate
+     * @param sigma Volatility
+     * @param q Dividend yield
+     * @param is_call true for call option, false for put
+     * @param outputs Bitwise OR of OutputFlags values (default: all)
+     * @return Result for the rounded inputs
+     */
+    QuoteResult quote(double S, double K, double T, double r, double sigma, double q,
+                      bool is_call, uint32_t outputs = OutputFlags::ALL);
+    
+    /**
+     * @brief Cached price and Greeks for validated parameters
+     * @param params Black-Scholes parameters
+     * @param is_call true for call option, false for put
+     * @param outputs Bitwise OR of OutputFlags values (default: all)
+     * @return Result for the rounded parameters
+     */
+    QuoteResult quote(const Parameters& params, bool is_call, uint32_t outputs = OutputFlags::ALL) {
+        return quote(params.spot_price, params.strike_price, params.time_to_expiry,
+                     params.risk_free_rate, params.volatility, params.dividend_yield,
+                     is_call, outputs);
+    }
+    
+    /**
+     * @brief Round a value the way cache keys are rounded
+     * @param value Input value
+     * @return Value with the dropped mantissa bits rounded to nearest
+     */
+    double quantize(double value) const noexcept;
+    
+    /**
+     * @brief Snapshot of the counters, summed over all shards
+     */
+    PricingCacheStats stats() const;
+    
+    /**
+     * @brief Drop every entry; counters are kept
+     */
+    void clear();
+    
+    /**
+     * @brief Zero the hit, miss and eviction counters
+     */
+    void reset_stats();
+    
+    /**
+     * @brief Entries the cache can hold (the requested capacity rounded up to whole sets)
+     */
+    size_t capacity() const noexcept { return shard_count_ * sets_per_shard_ * WAYS; }
+    
+    double tolerance() const noexcept { return tolerance_; }
+};
+
+} // namespace BlackScholes
@@ -0,0 +1,45 @@
+#include "pricing_engine.hpp"
+
+namespace BlackScholes {
+
+const char* to_string(ExerciseStyle exercise) noexcept {
+    switch (exercise) {
+        case ExerciseStyle::EUROPEAN: return "EUROPEAN";
+        case ExerciseStyle::AMERICAN: return "AMERICAN";
+        default:                      return "UNKNOWN";
+    }
+}
+
+const char* to_string(PricingMethod method) noexcept {
+    switch (method) {
+        case PricingMethod::CLOSED_FORM:       return "CLOSED_FORM";
+        case PricingMethod::MONTE_CARLO:       return "MONTE_CARLO";
+        case PricingMethod::FINITE_DIFFERENCE: return "FINITE_DIFFERENCE";
+        default:                               return "UNKNOWN";
+    }
+}
+
+PricingMethod preferred_method(ExerciseStyle exercise) noexcept {
+    return exercise == ExerciseStyle::EUROPEAN ? PricingMethod::CLOSED_FORM : PricingMethod::FINITE_DIFFERENCE;
+}
+
+QuoteResult MonteCarloVanillaEngine::quote_valid(double S, double K, double T, double r, double sigma, double q,
+                                                 bool is_call, ExerciseStyle, uint32_t outputs) const {
+    QuoteResult result = failed(BatchStatus::OK);
+    if (!(outputs & OutputFlags::PRICE)) {
+        return result;
+    }
+    
+    PathContract contract;
+    contract.payoff = PathPayoff::EUROPEAN;
+    contract.is_call = is_call;
+    const MonteCarloResult simulated = simulator_.price(Parameters(S, K, T, r, sigma, q), contract);
+    if (!simulated.is_valid) {
+        result.status = BatchStatus::NUMERICAL_ERROR;
+        return result;
+    }
+    result.price = simulated.price;
+    return result;
+}
+
+} // namespace BlackScholes
@@ -0,0 +1,400 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include "black_scholes.hpp"
+#include "monte_carlo.hpp"
+
+/**
+ * @file pricing_engine.hpp
+ * @brief Closed-form, Monte Carlo and finite-difference engines behind one interface
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * Every engine derives from PricingEngine<Engine> (CRTP) and provides the
+ * same quote(), price() and price_batch() entry points. The base class
+ * validates the inputs and calls the engine's hooks through static_cast,
+ * so batch loops over a concrete engine contain no virtual calls and the
+ * per-row kernel can be inlined. Code that picks the method at run time
+ * uses with_engine(), which switches once and then runs a generic lambda
+ * against the concrete engine type.
+ *
+ * Engines:
+ * - ClosedFormEngine: the Black-Scholes formulas of OptionPricer (European).
+ * - MonteCarloVanillaEngine: MonteCarloEngine with a European payoff;
+ *   price only.
+ * - CrankNicolsonEngine: Crank-Nicolson finite differences in log-spot,
+ *   European or American exercise, with dividends.
+ *
+ * Engine hooks (private, reached through `friend class PricingEngine<Engine>`):
+ * - `static constexpr PricingMethod METHOD`
+ * - `static bool supports(ExerciseStyle) noexcept`
+ * - `QuoteResult quote_valid(S, K, T, r, sigma, q, is_call, exercise, outputs) const`
+ *   for inputs that passed OptionPricer::validate_row()
+ * - optionally `size_t price_rows(const BatchInput&, const BatchOutput&, ExerciseStyle) const`
+ *   to replace the row-by-row batch loop of the base class
+ */
+
+namespace BlackScholes {
+
+/**
+ * @brief When the holder may exercise
+ */
+enum class ExerciseStyle : uint8_t {
+    EUROPEAN = 0,   ///< At expiry only
+    AMERICAN = 1    ///< At any time up to expiry
+};
+
+/**
+ * @brief Convert exercise style to string representation
+ * @param exercise Exercise style to convert
+ * @return String representation of exercise style
+ */
+const char* to_string(ExerciseStyle exercise) noexcept;
+
+/**
+ * @brief Numerical method of an engine
+ */
+enum class PricingMethod : uint8_t {
+    CLOSED_FORM = 0,        ///< ClosedFormEngine
+    MONTE_CARLO = 1,        ///< MonteCarloVanillaEngine
+    FINITE_DIFFERENCE = 2   ///< CrankNicolsonEngine
+};
+
+/**
+ * @brief Convert pricing method to string representation
+ * @param method Pricing method to convert
+ * @return String representation of pricing method
+ */
+const char* to_string(PricingMethod method) noexcept;
+
+/**
+ * @brief Fastest method that supports an exercise style
+ * @return CLOSED_FORM for European, FINITE_DIFFERENCE for American exercise
+ */
+PricingMethod preferred_method(ExerciseStyle exercise) noexcept;
+
+/**
+ * @brief Static interface shared by all pricing engines
+ * @tparam Engine Concrete engine deriving from PricingEngine<Engine>
+ */
+template <typename Engine>
+class PricingEngine {
+public:
+    /**
+     * @brief Price one option with error codes instead of exceptions
+     *
+     * Inputs are validated with OptionPricer::validate_row(); an exercise
+     * style the engine cannot price is reported as
+     * BatchStatus::UNSUPPORTED_EXERCISE. Outputs not requested, or not
+     * produced by the engine, are NaN.
+     *
+     * @param S Current stock price
+     * @param K Strike price
+     * @param T Time to expiration in years
+     * @param r Risk-free rate
+     * @param sigma Volatility
+     * @param q Dividend yield
+     * @param is_call true for call option, false for put
+     * @param exercise Exercise style
+     * @param outputs Bitwise OR of OutputFlags values (default: all)
+     * @return Result with BatchStatus flags; outputs are NaN on error
+     */
+    QuoteResult quote(double S, double K, double T, double r, double sigma, double q, bool is_call,
+                      ExerciseStyle exercise = ExerciseStyle::EUROPEAN,
+                      uint32_t outputs = OutputFlags::ALL) const {
+        uint32_t status = OptionPricer::validate_row(S, K, T, r, sigma, q);
+        if (!Engine::supports(exercise)) {
+            status |= BatchStatus::UNSUPPORTED_EXERCISE;
+        }
+        if (status != BatchStatus::OK) {
+            return failed(status);
+        }
+        return engine().quote_valid(S, K, T, r, sigma, q, is_call, exercise, outputs);
+    }
+    
+    /**
+     * @brief Price one option with price and Greeks
+     * @param params Black-Scholes parameters
+     * @param is_call true for call option, false for put
+     * @param exercise Exercise style
+     * @return Pricing result; is_valid is false with error_msg on failure
+     */
+    PricingResult price(const Parameters& params, bool is_call,
+                        ExerciseStyle exercise = ExerciseStyle::EUROPEAN) const {
+        const QuoteResult quoted = quote(params.spot_price, params.strike_price, params.time_to_expiry,
+                                         params.risk_free_rate, params.volatility, params.dividend_yield,
+                                         is_call, exercise);
+        PricingResult result;
+        result.price = quoted.price;
+        result.greeks = quoted.greeks;
+        result.is_valid = quoted.status == BatchStatus::OK;
+        if (quoted.status & BatchStatus::UNSUPPORTED_EXERCISE) {
+            result.error_msg = std::string(to_string(exercise)) + " exercise is not supported by the " +
+                               to_string(Engine::METHOD) + " engine";
+        } else if (quoted.status & BatchStatus::NUMERICAL_ERROR) {
+            result.error_msg = "Non-finite price or Greeks";
+        } else if (quoted.status != BatchStatus::OK) {
+            result.error_msg = params.validation_error();
+        }
+        return result;
+    }
+    
+    /**
+     * @brief Price a batch with one exercise style
+     *
+     * Same column conventions as OptionPricer::price_batch(): null output
+     * columns are skipped, invalid rows get NaN outputs and BatchStatus
+     * flags.
+     *
+     * @param input Structure-of-arrays option parameters
+     * @param output Caller-owned output columns (null columns are skipped)
+     * @param exercise Exercise style of every row
+     * @return Number of rows priced successfully
+     */
+    size_t price_batch(const BatchInput& input, const BatchOutput& output,
+                       ExerciseStyle exercise = ExerciseStyle::EUROPEAN) const {
+        return engine().price_rows(input, output, exercise);
+    }
+
+protected:
+    /// Outputs requested by the non-null columns of a BatchOutput
+    static uint32_t requested_outputs(const BatchOutput& output) noexcept {
+        return (output.price != nullptr ? OutputFlags::PRICE : 0u) |
+               (output.delta != nullptr ? OutputFlags::DELTA : 0u) |
+               (output.gamma != nullptr ? OutputFlags::GAMMA : 0u) |
+               (output.theta != nullptr ? OutputFlags::THETA : 0u) |
+               (output.vega != nullptr ? OutputFlags::VEGA : 0u) |
+               (output.rho != nullptr ? OutputFlags::RHO : 0u);
+    }
+    
+    /// Result of a row that cannot be priced
+    static QuoteResult failed(uint32_t status) noexcept {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        QuoteResult result;
+        result.price = nan;
+        result.greeks = Greeks(nan, nan, nan, nan, nan);
+        result.status = status;
+        return result;
+    }
+    
+    /// Write one result to row i of every non-null output column
+    static void store(const BatchOutput& output, size_t i, const QuoteResult& result) noexcept {
+        if (output.price != nullptr) output.price[i] = result.price;
+        if (output.delta != nullptr) output.delta[i] = result.greeks.delta;
+        if (output.gamma != nullptr) output.gamma[i] = result.greeks.gamma;
+        if (output.theta != nullptr) output.theta[i] = result.greeks.theta;
+        if (output.vega != nullptr) output.vega[i] = result.greeks.vega;
+        if (output.rho != nullptr) output.rho[i] = result.greeks.rho;
+        if (output.status != nullptr) output.status[i] = result.status;
+    }
+    
+    /// Default batch loop: quote() row by row, statically dispatched
+    size_t price_rows(const BatchInput& input, const BatchOutput& output, ExerciseStyle exercise) const {
+        const uint32_t outputs = requested_outputs(output);
+        const bool missing = input.spot_price == nullptr || input.strike_price == nullptr ||
+                             input.time_to_expiry == nullptr || input.risk_free_rate == nullptr ||
+                             input.volatility == nullptr || input.is_call == nullptr;
+        size_t priced = 0;
+        for (size_t i = 0; i < input.count; ++i) {
+            if (missing) {
+                store(output, i, failed(BatchStatus::MISSING_INPUT));
+                continue;
+            }
+            const double q = input.dividend_yield != nullptr ? input.dividend_yield[i] : 0.0;
+            const QuoteResult result = quote(input.spot_price[i], input.strike_price[i], input.time_to_expiry[i],
+                                             input.risk_free_rate[i], input.volatility[i], q,
+                                             input.is_call[i] != 0, exercise, outputs);
+            store(output, i, result);
+            priced += result.status == BatchStatus::OK ? 1 : 0;
+        }
+        return priced;
+    }
+
+private:
+    const Engine& engine() const noexcept { return static_cast<const Engine&>(*this); }
+};
+
+/**
+ * @brief Black-Scholes formulas (European exercise only)
+ */
+class ClosedFormEngine : public PricingEngine<ClosedFormEngine> {
+    friend class PricingEngine<ClosedFormEngine>;
+    
+    static constexpr PricingMethod METHOD = PricingMethod::CLOSED_FORM;
+    
+    static bool supports(ExerciseStyle exercise) noexcept { return exercise == ExerciseStyle::EUROPEAN; }
+    
+    QuoteResult quote_valid(double S, double K, double T, double r, double sigma, double q, bool is_call,
+                            ExerciseStyle, uint32_t outputs) const noexcept {
+        return OptionPricer::quote(S, K, T, r, sigma, q, is_call, outputs);
+    }
+    
+    // European batches go to the SIMD batch pricer
+    size_t price_rows(const BatchInput& input, const BatchOutput& output, ExerciseStyle exercise) const {
+        if (supports(exercise)) {
+            return OptionPricer::price_batch(input, output);
+        }
+        return PricingEngine<ClosedFormEngine>::price_rows(input, output, exercise);
+    }
+};
+
+/**
+ * @brief Monte Carlo price of European options (no Greeks)
+ *
+ * Uses MonteCarloEngine with PathPayoff::EUROPEAN (one step per path), so
+ * results carry simulation noise; mostly useful as an independent check of
+ * the other engines.
+ */
+class MonteCarloVanillaEngine : public PricingEngine<MonteCarloVanillaEngine> {
+    friend class PricingEngine<MonteCarloVanillaEngine>;
+    
+    MonteCarloEngine simulator_;
+    
+    static constexpr PricingMethod METHOD = PricingMethod::MONTE_CARLO;
+    
+    static bool supports(ExerciseStyle exercise) noexcept { return exercise == ExerciseStyle::EUROPEAN; }
+    
+    QuoteResult quote_valid(double S, double K, double T, double r, double sigma, double q, bool is_call,
+                            ExerciseStyle exercise, uint32_t outputs) const;
+
+public:
+    /**
+     * @brief Create an engine
+     * @param options Simulation settings
+     * @param pool Thread pool for the path blocks (nullptr = Utils::ThreadPool::shared())
+     */
+    explicit MonteCarloVanillaEngine(const MonteCarloOptions& options = MonteCarloOptions::from_config(),
+                                     Utils::ThreadPool* pool = nullptr)
+        : simulator_(options, pool) {}
+    
+    const MonteCarloOptions& options() const noexcept { return simulator_.options(); }
+};
+
+/**
+ * @brief Grid settings for CrankNicolsonEngine
+ */
+struct FiniteDifferenceOptions {
+    uint32_t space_steps = 400;     ///< Intervals of the log-spot grid
+    uint32_t time_steps = 200;      ///< Time steps to expiry (the first two are implicit)
+    double std_devs = 5.0;          ///< Grid half-width beyond the quoted spots, in σ√T
+    
+    /**
+     * @brief Read finite_difference.* settings
+     * @return Options populated from configuration
+     */
+    static FiniteDifferenceOptions from_config();
+};
+
+/**
+ * @brief Crank-Nicolson finite-difference engine for European and American options
+ *
+ * Solves the Black-Scholes PDE for V(S, K) = K·v(ln(S/K)), which holds for
+ * any strike, on a uniform grid in x = ln(S/K):
+ *   ∂v/∂τ = ½σ² ∂²v/∂x² + (r - q - ½σ²) ∂v/∂x - r v
+ * with Crank-Nicolson steps solved by the Thomas algorithm, two implicit
+ * (Rannacher) start-up steps to damp the payoff kink, and early exercise
+ * applied after every step for American options. Dirichlet boundaries use
+ * the discounted intrinsic value.
+ *
+ * The grid and the tridiagonal workspace are allocated once per engine.
+ * Because v does not depend on K, price_batch() solves one grid for each
+ * run of consecutive rows with equal (T, r, σ, q, type) — the strikes and
+ * spots of one expiry/smile point — and reads every row from it. Delta,
+ * gamma and theta come from the grid; vega and rho are central bumps that
+ * cost two extra solves each and are only computed when requested.
+ *
+ * quote() and price_batch() reuse the engine's workspace, so an engine
+ * must not be shared between threads; use one engine per thread.
+ */
+class CrankNicolsonEngine : public PricingEngine<CrankNicolsonEngine> {
+    friend class PricingEngine<CrankNicolsonEngine>;
+    
+    /**
+     * @brief Solved grid for one (T, r, σ, q, type, exercise)
+     */
+    struct Solution {
+        double x_min;       ///< Log-moneyness of node 0
+        double dx;          ///< Node spacing
+        double dt;          ///< Time step
+    };
+    
+    FiniteDifferenceOptions options_;
+    mutable std::vector<double> value_;     ///< v at τ = T after a solve
+    mutable std::vector<double> previous_;  ///< v at τ = T - dt (for theta)
+    mutable std::vector<double> payoff_;    ///< Exercise value per node
+    mutable std::vector<double> scratch_;   ///< Thomas forward-sweep coefficients
+    mutable std::vector<double> rhs_;       ///< Right-hand side of one step
+    
+    static constexpr PricingMethod METHOD = PricingMethod::FINITE_DIFFERENCE;
+    
+    static bool supports(ExerciseStyle) noexcept { return true; }
+    
+    QuoteResult quote_valid(double S, double K, double T, double r, double sigma, double q, bool is_call,
+                            ExerciseStyle exercise, uint32_t outputs) const;
+    
+    size_t price_rows(const BatchInput& input, const BatchOutput& output, ExerciseStyle exercise) const;
+    
+    /**
+     * @brief Solve v on [x_min, x_max] into value_ (and previous_)
+     */
+    Solution solve(double T, double r, double sigma, double q, bool is_call, bool american,
+                   double x_min, double x_max) const;
+    
+    /**
+     * @brief Price rows [begin, end) of one run, all sharing T, r, σ, q and type
+     * @return Number of rows priced successfully
+     */
+    size_t price_run(const BatchInput& input, const BatchOutput& output, size_t begin, size_t end,
+                   ExerciseStyle exercise, uint32_t outputs) const;
+
+public:
+    /**
+     * @brief Create an engine and allocate its grid
+     * @param options Grid settings
+     * @throws std::invalid_argument if space_steps < 4, time_steps < 2 or std_devs <= 0
+     */
+    explicit CrankNicolsonEngine(const FiniteDifferenceOptions& options = FiniteDifferenceOptions::from_config());
+    
+    const FiniteDifferenceOptions& options() const noexcept { return options_; }
+};
+
+/**
+ * @brief Run a generic callable against the engine for a method
+ *
+ * The engine is built from configuration and passed by reference as its
+ * concrete type, so the callable's loops are statically dispatched:
+ *
+ *     with_engine(preferred_method(ExerciseStyle::AMERICAN), [&](const auto& engine) {
+ *         return engine.price_batch(input, output, ExerciseStyle::AMERICAN);
+ *     });
+ *
+ * @param method Engine to build
+ * @param visitor Callable taking `const Engine&`; every instantiation must return the same type
+ * @return Whatever the callable returns
+ */
+template <typename Visitor>
+decltype(auto) with_engine(PricingMethod method, Visitor&& visitor) {
+    switch (method) {
+        case PricingMethod::MONTE_CARLO: {
+            const MonteCarloVanillaEngine engine;
+            return visitor(engine);
+        }
+        case PricingMethod::FINITE_DIFFERENCE: {
+            const CrankNicolsonEngine engine;
+            return visitor(engine);
+        }
+        case PricingMethod::CLOSED_FORM:
+        default: {
+            const ClosedFormEngine engine;
+            return visitor(engine);
+        }
+    }
+}
+
+} // namespace BlackScholes
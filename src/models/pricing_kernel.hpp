@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include "black_scholes.hpp"
+
+/**
+ * @file pricing_kernel.hpp
+ * @brief Black-Scholes kernel specialized at compile time on option type and outputs
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * Kernel::evaluate<Type, Outputs>() is the single implementation of the
+ * closed-form price and Greeks. The option type fixes the sign of every
+ * term and the OutputFlags mask selects the work with `if constexpr`, so a
+ * price-only put contains no delta, gamma, vega or φ(d1) code and no
+ * branch on the type. Callers that know both at compile time, such as a
+ * hedging loop over puts, call Kernel::quote<OptionType::PUT,
+ * OutputFlags::PRICE_DELTA>() and get the kernel inlined. The runtime
+ * entry points (OptionPricer::evaluate(), quote(), price_call(),
+ * calculate_put_greeks(), ...) pick the matching specialization once per
+ * call through Kernel::select().
+ */
+
+namespace BlackScholes {
+
+/**
+ * @brief Option type as a compile-time parameter
+ */
+enum class OptionType : uint8_t {
+    CALL = 0,
+    PUT = 1
+};
+
+/**
+ * @brief Convert option type to string representation
+ * @param type Option type to convert
+ * @return String representation of option type
+ */
+const char* to_string(OptionType type) noexcept;
+
+namespace Kernel {
+
+// Which shared intermediates the requested outputs depend on
+constexpr bool needs_N_d1(uint32_t outputs) noexcept {
+    return (outputs & (OutputFlags::PRICE | OutputFlags::DELTA | OutputFlags::THETA)) != 0;
+}
+
+constexpr bool needs_N_d2(uint32_t outputs) noexcept {
+    return (outputs & (OutputFlags::PRICE | OutputFlags::THETA | OutputFlags::RHO)) != 0;
+}
+
+constexpr bool needs_phi(uint32_t outputs) noexcept {
+    return (outputs & (OutputFlags::GAMMA | OutputFlags::THETA | OutputFlags::VEGA)) != 0;
+}
+
+/**
+ * @brief Price and Greeks from the term-structure factors of the expiry
+ *
+ * Writes the outputs in Outputs and NaN to the others.
+ *
+ * @tparam Type Call or put
+ * @tparam Outputs Bitwise OR of OutputFlags values
+ * @param discount_factor e^{-rT} (ignored unless Outputs needs N(d2))
+ * @return false if any requested output is not finite
+ */
+template <OptionType Type, uint32_t Outputs>
+inline bool evaluate(double S, double K, double T, double r, double sigma, double q,
+                     double sqrt_T, double discount_factor, double dividend_factor,
+                     double& price, Greeks& greeks) noexcept {
+    constexpr double sign = Type == OptionType::CALL ? 1.0 : -1.0;
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    price = nan;
+    greeks = Greeks(nan, nan, nan, nan, nan);
+    
+    // Shared intermediates, computed once
+    const double sigma_sqrt_T = sigma * sqrt_T;
+    const double d1 = (std::log(S / K) + (r - q + 0.5 * sigma * sigma) * T) / sigma_sqrt_T;
+    
+    // N(±d1), N(±d2) with the sign fixed by the option type
+    double N_d1 = 0.0;
+    double N_d2 = 0.0;
+    double phi_d1 = 0.0;
+    if constexpr (needs_N_d1(Outputs)) {
+        N_d1 = MathUtils::normal_cdf(sign * d1);
+    }
+    if constexpr (needs_N_d2(Outputs)) {
+        N_d2 = MathUtils::normal_cdf(sign * (d1 - sigma_sqrt_T));
+    }
+    if constexpr (needs_phi(Outputs)) {
+        phi_d1 = MathUtils::normal_pdf(d1);
+    }
+    
+    bool finite = true;
+    if constexpr ((Outputs & OutputFlags::PRICE) != 0) {
+        price = sign * (S * dividend_factor * N_d1 - K * discount_factor * N_d2);
+        finite = finite && std::isfinite(price);
+    }
+    
+    // Delta: ∂V/∂S
+    if constexpr ((Outputs & OutputFlags::DELTA) != 0) {
+        greeks.delta = sign * dividend_factor * N_d1;
+        finite = finite && std::isfinite(greeks.delta);
+    }
+    
+    // Gamma: ∂²V/∂S² (same for calls and puts)
+    if constexpr ((Outputs & OutputFlags::GAMMA) != 0) {
+        greeks.gamma = dividend_factor * phi_d1 / (S * sigma_sqrt_T);
+        finite = finite && std::isfinite(greeks.gamma);
+    }
+    
+    // Theta: ∂V/∂T (per day)
+    if constexpr ((Outputs & OutputFlags::THETA) != 0) {
+        const double theta_decay = -S * dividend_factor * phi_d1 * sigma / (2.0 * sqrt_T);
+        const double theta_carry = sign * (q * S * dividend_factor * N_d1 - r * K * discount_factor * N_d2);
+        greeks.theta = (theta_decay + theta_carry) / 365.0;
+        finite = finite && std::isfinite(greeks.theta);
+    }
+    
+    // Vega: ∂V/∂σ (per 1%, same for calls and puts)
+    if constexpr ((Outputs & OutputFlags::VEGA) != 0) {
+        greeks.vega = S * dividend_factor * phi_d1 * sqrt_T / 100.0;
+        finite = finite && std::isfinite(greeks.vega);
+    }
+    
+    // Rho: ∂V/∂r (per 1%)
+    if constexpr ((Outputs & OutputFlags::RHO) != 0) {
+        greeks.rho = sign * K * T * discount_factor * N_d2 / 100.0;
+        finite = finite && std::isfinite(greeks.rho);
+    }
+    
+    return finite;
+}
+
+/**
+ * @brief Hot-path pricing with the option type and outputs fixed at compile time
+ *
+ * Same validation and results as OptionPricer::quote(S, K, T, r, sigma, q,
+ * is_call, outputs); no allocation, logging or locking.
+ *
+ * @tparam Type Call or put
+ * @tparam Outputs Bitwise OR of OutputFlags values (default: all)
+ * @return Result with BatchStatus flags; outputs are NaN on error or when not requested
+ */
+template <OptionType Type, uint32_t Outputs = OutputFlags::ALL>
+inline QuoteResult quote(double S, double K, double T, double r, double sigma, double q) noexcept {
+    QuoteResult result;
+    result.status = OptionPricer::validate_row(S, K, T, r, sigma, q);
+    if (result.status != BatchStatus::OK) {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        result.price = nan;
+        result.greeks = Greeks(nan, nan, nan, nan, nan);
+        return result;
+    }
+    
+    const double sqrt_T = std::sqrt(T);
+    const double dividend_factor = std::exp(-q * T);
+    const double discount_factor = needs_N_d2(Outputs) ? std::exp(-r * T) : 0.0;
+    if (!evaluate<Type, Outputs>(S, K, T, r, sigma, q, sqrt_T, discount_factor, dividend_factor,
+                                 result.price, result.greeks)) {
+        result.status = BatchStatus::NUMERICAL_ERROR;
+    }
+    return result;
+}
+
+/**
+ * @brief Hot-path pricing of one strike from a precomputed expiry, specialized at compile time
+ *
+ * Same validation and results as OptionPricer::quote(slice, S, K, sigma, is_call, outputs).
+ */
+template <OptionType Type, uint32_t Outputs = OutputFlags::ALL>
+inline QuoteResult quote(const ExpirySlice& slice, double S, double K, double sigma) noexcept {
+    QuoteResult result;
+    result.status = OptionPricer::validate_row(S, K, slice.time_to_expiry, slice.risk_free_rate, sigma,
+                                               slice.dividend_yield);
+    if (result.status != BatchStatus::OK) {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        result.price = nan;
+        result.greeks = Greeks(nan, nan, nan, nan, nan);
+        return result;
+    }
+    
+    if (!evaluate<Type, Outputs>(S, K, slice.time_to_expiry, slice.risk_free_rate, sigma, slice.dividend_yield,
+                                 slice.sqrt_T, slice.discount_factor, slice.dividend_factor,
+                                 result.price, result.greeks)) {
+        result.status = BatchStatus::NUMERICAL_ERROR;
+    }
+    return result;
+}
+
+/// One specialization of evaluate()
+using EvaluateFn = bool (*)(double S, double K, double T, double r, double sigma, double q,
+                            double sqrt_T, double discount_factor, double dividend_factor,
+                            double& price, Greeks& greeks) noexcept;
+
+/**
+ * @brief Specialization of evaluate() for a runtime option type and output mask
+ * @param is_call true for call option, false for put
+ * @param outputs Bitwise OR of OutputFlags values (bits outside OutputFlags::ALL are ignored)
+ * @return Pointer into a table of every (type, outputs) specialization
+ */
+EvaluateFn select(bool is_call, uint32_t outputs) noexcept;
+
+} // namespace Kernel
+
+} // namespace BlackScholes
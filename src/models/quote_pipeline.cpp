@@ -0,0 +1,582 @@
+#include "quote_pipeline.hpp"
+#include "../utils/metrics.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace BlackScholes {
+
+namespace {
+
+// Reader buffer; large enough that a read() call returns thousands of quotes
+constexpr size_t READ_BUFFER_SIZE = 256 * 1024;
+
+int64_t now_ns() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::runtime_error system_error(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+// Pointer to a column, or null if the column was not allocated
+template <typename T>
+T* column(std::vector<T>& values) noexcept {
+    return values.empty() ? nullptr : values.data();
+}
+
+const char* skip_spaces(const char* begin, const char* end) noexcept {
+    while (begin != end && (*begin == ' ' || *begin == '\t')) {
+        ++begin;
+    }
+    return begin;
+}
+
+const char* trim_spaces(const char* begin, const char* end) noexcept {
+    while (end != begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) {
+        --end;
+    }
+    return end;
+}
+
+bool parse_number(const char* begin, const char* end, double& value) noexcept {
+    begin = skip_spaces(begin, end);
+    end = trim_spaces(begin, end);
+    if (begin != end && *begin == '+') {
+        ++begin;    // from_chars does not accept a leading '+'
+    }
+    const auto result = std::from_chars(begin, end, value);
+    return result.ec == std::errc() && result.ptr == end && begin != end;
+}
+
+// Case-insensitive match of [begin, end) against a lower-case word
+bool equals_word(const char* begin, const char* end, const char* word) noexcept {
+    for (; begin != end && *word != '\0'; ++begin, ++word) {
+        const char c = (*begin >= 'A' && *begin <= 'Z') ? static_cast<char>(*begin - 'A' + 'a') : *begin;
+        if (c != *word) {
+            return false;
+        }
+    }
+    return begin == end && *word == '\0';
+}
+
+bool parse_option_type(const char* begin, const char* end, uint8_t& is_call) noexcept {
+    begin = skip_spaces(begin, end);
+    end = trim_spaces(begin, end);
+    if (equals_word(begin, end, "c") || equals_word(begin, end, "call") || equals_word(begin, end, "1")) {
+        is_call = 1;
+        return true;
+    }
+    if (equals_word(begin, end, "p") || equals_word(begin, end, "put") || equals_word(begin, end, "0")) {
+        is_call = 0;
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+const char* to_string(QuoteFormat format) noexcept {
+    switch (format) {
+        case QuoteFormat::CSV: return "CSV";
+        case QuoteFormat::BINARY: return "BINARY";
+        default: return "UNKNOWN";
+    }
+}
+
+// QuoteSource implementation
+QuoteSource::~QuoteSource() {
+    if (owned_ && fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+QuoteSource::QuoteSource(QuoteSource&& other) noexcept : fd_(other.fd_), owned_(other.owned_) {
+    other.fd_ = -1;
+    other.owned_ = false;
+}
+
+QuoteSource& QuoteSource::operator=(QuoteSource&& other) noexcept {
+    if (this != &other) {
+        if (owned_ && fd_ >= 0) {
+            ::close(fd_);
+        }
+        fd_ = other.fd_;
+        owned_ = other.owned_;
+        other.fd_ = -1;
+        other.owned_ = false;
+    }
+    return *this;
+}
+
+QuoteSource QuoteSource::open_file(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw system_error("Cannot open quote file " + path);
+    }
+    return QuoteSource(fd, true);
+}
+
+QuoteSource QuoteSource::connect_tcp(const std::string& host, uint16_t port) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    const std::string service = std::to_string(port);
+    const int error = ::getaddrinfo(host.c_str(), service.c_str(), &hints, &addresses);
+    if (error != 0) {
+        throw std::runtime_error("Cannot resolve quote feed " + host + ": " + ::gai_strerror(error));
+    }
+    
+    int fd = -1;
+    for (const addrinfo* address = addresses; address != nullptr && fd < 0; address = address->ai_next) {
+        fd = ::socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC, address->ai_protocol);
+        if (fd >= 0 && ::connect(fd, address->ai_addr, address->ai_addrlen) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    ::freeaddrinfo(addresses);
+    if (fd < 0) {
+        throw system_error("Cannot connect to quote feed " + host + ":" + service);
+    }
+    return QuoteSource(fd, true);
+}
+
+size_t QuoteSource::read(char* buffer, size_t size) {
+    for (;;) {
+        const ssize_t n = ::read(fd_, buffer, size);
+        if (n >= 0) {
+            return static_cast<size_t>(n);
+        }
+        if (errno != EINTR) {
+            throw system_error("Quote stream read failed");
+        }
+    }
+}
+
+// QuoteBatch implementation
+QuoteBatch::QuoteBatch(size_t rows, uint32_t outputs)
+    : spot_price(rows), strike_price(rows), time_to_expiry(rows), risk_free_rate(rows),
+      volatility(rows), dividend_yield(rows), is_call(rows),
+      status(rows), warnings(rows), capacity(rows) {
+    const auto allocate = [&](std::vector<double>& values, uint32_t flag) {
+        if (outputs & flag) {
+            values.resize(rows);
+        }
+    };
+    allocate(price, OutputFlags::PRICE);
+    allocate(delta, OutputFlags::DELTA);
+    allocate(gamma, OutputFlags::GAMMA);
+    allocate(theta, OutputFlags::THETA);
+    allocate(vega, OutputFlags::VEGA);
+    allocate(rho, OutputFlags::RHO);
+}
+
+void QuoteBatch::clear() noexcept {
+    count = 0;
+    rejected = 0;
+}
+
+BatchInput QuoteBatch::input() const noexcept {
+    BatchInput input;
+    input.spot_price = spot_price.data();
+    input.strike_price = strike_price.data();
+    input.time_to_expiry = time_to_expiry.data();
+    input.risk_free_rate = risk_free_rate.data();
+    input.volatility = volatility.data();
+    input.dividend_yield = dividend_yield.data();
+    input.is_call = is_call.data();
+    input.count = count;
+    return input;
+}
+
+BatchOutput QuoteBatch::output() noexcept {
+    BatchOutput output;
+    output.price = column(price);
+    output.delta = column(delta);
+    output.gamma = column(gamma);
+    output.theta = column(theta);
+    output.vega = column(vega);
+    output.rho = column(rho);
+    output.status = column(status);
+    return output;
+}
+
+// QuoteParser implementation
+bool QuoteParser::parse_line(const char* begin, const char* end, QuoteBatch& batch) noexcept {
+    const char* content = skip_spaces(begin, end);
+    end = trim_spaces(content, end);
+    if (content == end || *content == '#') {
+        return false;
+    }
+    
+    const bool header_allowed = first_line_;
+    first_line_ = false;
+    
+    // Split into exactly seven fields without copying
+    const char* fields[8];
+    size_t field_count = 0;
+    fields[field_count++] = content;
+    for (const char* c = content; c != end && field_count < 8; ++c) {
+        if (*c == ',') {
+            fields[field_count++] = c + 1;
+        }
+    }
+    
+    const size_t row = batch.count;
+    double values[6];
+    bool ok = field_count == 7;
+    for (size_t f = 0; ok && f < 6; ++f) {
+        const char* field_end = fields[f + 1] - 1;
+        if (f == 5 && skip_spaces(fields[f], field_end) == field_end) {
+            values[f] = 0.0;    // Empty dividend
+        } else {
+            ok = parse_number(fields[f], field_end, values[f]);
+        }
+    }
+    uint8_t is_call = 0;
+    ok = ok && parse_option_type(fields[6], end, is_call);
+    
+    if (!ok) {
+        // A non-numeric first line is a header; anything else is a bad record
+        const char c = *content;
+        const bool numeric_start = (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.';
+        if (!(header_allowed && !numeric_start)) {
+            ++batch.rejected;
+        }
+        return false;
+    }
+    
+    batch.spot_price[row] = values[0];
+    batch.strike_price[row] = values[1];
+    batch.time_to_expiry[row] = values[2];
+    batch.risk_free_rate[row] = values[3];
+    batch.volatility[row] = values[4];
+    batch.dividend_yield[row] = values[5];
+    batch.is_call[row] = is_call;
+    batch.count = row + 1;
+    return true;
+}
+
+size_t QuoteParser::parse(const char* data, size_t size, QuoteBatch& batch) noexcept {
+    if (format_ == QuoteFormat::BINARY) {
+        const size_t records = std::min(size / sizeof(QuoteRecord), batch.capacity - batch.count);
+        for (size_t i = 0; i < records; ++i) {
+            QuoteRecord record;
+            std::memcpy(&record, data + i * sizeof(QuoteRecord), sizeof(QuoteRecord));
+            const size_t row = batch.count + i;
+            batch.spot_price[row] = record.spot_price;
+            batch.strike_price[row] = record.strike_price;
+            batch.time_to_expiry[row] = record.time_to_expiry;
+            batch.risk_free_rate[row] = record.risk_free_rate;
+            batch.volatility[row] = record.volatility;
+            batch.dividend_yield[row] = record.dividend_yield;
+            batch.is_call[row] = record.is_call != 0 ? 1 : 0;
+        }
+        batch.count += records;
+        return records * sizeof(QuoteRecord);
+    }
+    
+    const char* position = data;
+    const char* const end = data + size;
+    while (!batch.full()) {
+        const char* newline = static_cast<const char*>(std::memchr(position, '\n', static_cast<size_t>(end - position)));
+        if (newline == nullptr) {
+            break;
+        }
+        parse_line(position, newline, batch);
+        position = newline + 1;
+    }
+    return static_cast<size_t>(position - data);
+}
+
+void QuoteParser::finish(const char* data, size_t size, QuoteBatch& batch) noexcept {
+    if (size == 0) {
+        return;
+    }
+    if (format_ == QuoteFormat::BINARY) {
+        ++batch.rejected;   // Truncated record
+    } else {
+        parse_line(data, data + size, batch);
+    }
+}
+
+// QuotePipelineOptions implementation
+QuotePipelineOptions QuotePipelineOptions::from_config() {
+    QuotePipelineOptions options;
+    const auto& config = Config::ConfigManager::getInstance().snapshot();
+    options.batch_size = static_cast<size_t>(std::max(config.pipeline.batch_size, 1));
+    options.queue_depth = static_cast<size_t>(std::max(config.pipeline.queue_depth, 1));
+    const int workers = config.pipeline.workers > 0 ? config.pipeline.workers
+                                                     : config.threading.max_threads - 2;
+    options.workers = static_cast<size_t>(std::max(workers, 1));
+    return options;
+}
+
+// QuotePipeline implementation
+void QuotePipeline::StageCounters::add(size_t rows_done, uint64_t ns) noexcept {
+    batches.fetch_add(1, std::memory_order_relaxed);
+    rows.fetch_add(rows_done, std::memory_order_relaxed);
+    busy_ns.fetch_add(ns, std::memory_order_relaxed);
+}
+
+void QuotePipeline::StageCounters::reset() noexcept {
+    batches.store(0, std::memory_order_relaxed);
+    rows.store(0, std::memory_order_relaxed);
+    busy_ns.store(0, std::memory_order_relaxed);
+}
+
+PipelineStageStats QuotePipeline::StageCounters::snapshot() const noexcept {
+    PipelineStageStats stats;
+    stats.batches = batches.load(std::memory_order_relaxed);
+    stats.rows = rows.load(std::memory_order_relaxed);
+    stats.busy_seconds = static_cast<double>(busy_ns.load(std::memory_order_relaxed)) * 1e-9;
+    return stats;
+}
+
+QuotePipeline::QuotePipeline(const QuotePipelineOptions& options)
+    : options_(options),
+      buffer_(std::max(READ_BUFFER_SIZE, sizeof(QuoteRecord))),
+      // Enough batches to fill both queues while the reader, every worker and the sink hold one
+      free_(2 * std::max<size_t>(options.queue_depth, 1) + std::max<size_t>(options.workers, 1) + 2),
+      parsed_(std::max<size_t>(options.queue_depth, 1)),
+      priced_(std::max<size_t>(options.queue_depth, 1)) {
+    options_.batch_size = std::max<size_t>(options_.batch_size, 1);
+    options_.queue_depth = std::max<size_t>(options_.queue_depth, 1);
+    options_.workers = std::max<size_t>(options_.workers, 1);
+    
+    const size_t batches = 2 * options_.queue_depth + options_.workers + 2;
+    batches_.reserve(batches);
+    for (size_t i = 0; i < batches; ++i) {
+        batches_.emplace_back(options_.batch_size, options_.outputs);
+    }
+}
+
+void QuotePipeline::abort() noexcept {
+    free_.close();
+    parsed_.close();
+    priced_.close();
+}
+
+void QuotePipeline::read_stage(QuoteSource& source) {
+    QuoteParser parser(options_.format);
+    char* const buffer = buffer_.data();
+    const size_t buffer_size = buffer_.size();
+    size_t have = 0;                // Unparsed bytes at the start of buffer
+    bool end_of_stream = false;
+    bool discarding = false;        // Skipping the rest of an over-long CSV line
+    uint64_t sequence = 0;
+    uint64_t row = 0;
+    QuoteBatch* batch = nullptr;
+    int64_t busy_start = 0;
+    
+    // Hand the current batch to the workers; false if the pipeline stopped
+    const auto publish = [&]() {
+        parse_.add(batch->count, static_cast<uint64_t>(now_ns() - busy_start));
+        rejected_.fetch_add(batch->rejected, std::memory_order_relaxed);
+        row += batch->count;
+        QuoteBatch* const filled = batch;
+        batch = nullptr;
+        return parsed_.push(filled);
+    };
+    
+    for (;;) {
+        if (batch == nullptr) {
+            if (parsed_.closed() || !free_.pop(batch)) {
+                return;     // Stopped, or aborted while waiting for a batch
+            }
+            batch->clear();
+            batch->sequence = sequence++;
+            batch->first_row = row;
+            busy_start = now_ns();
+        }
+        
+        const size_t used = parser.parse(buffer, have, *batch);
+        have -= used;
+        std::memmove(buffer, buffer + used, have);
+        if (batch->full()) {
+            if (!publish()) {
+                return;
+            }
+            continue;
+        }
+        
+        if (end_of_stream) {
+            parser.finish(buffer, have, *batch);
+            if (batch->count > 0 || batch->rejected > 0) {
+                publish();
+            } else {
+                free_.push(batch);
+            }
+            return;
+        }
+        
+        if (have == buffer_size) {
+            // One CSV line longer than the whole buffer: reject it
+            ++batch->rejected;
+            have = 0;
+            discarding = true;
+        }
+        
+        const size_t n = source.read(buffer + have, buffer_size - have);
+        end_of_stream = n == 0;
+        if (discarding && n > 0) {
+            const char* newline = static_cast<const char*>(std::memchr(buffer + have, '\n', n));
+            if (newline == nullptr) {
+                continue;
+            }
+            const size_t skipped = static_cast<size_t>(newline + 1 - (buffer + have));
+            std::memmove(buffer + have, newline + 1, n - skipped);
+            have += n - skipped;
+            discarding = false;
+        } else if (!discarding) {
+            have += n;
+        }
+    }
+}
+
+void QuotePipeline::price_stage() {
+    QuoteBatch* batch = nullptr;
+    while (parsed_.pop(batch)) {
+        Utils::Metrics::set(Utils::MetricGauge::PIPELINE_PARSED_DEPTH, static_cast<int64_t>(parsed_.size()));
+        const int64_t start = now_ns();
+        const BatchInput input = batch->input();
+        const size_t warned = OptionPricer::check_assumptions(input, batch->warnings.data());
+        const size_t priced = OptionPricer::price_batch(input, batch->output());
+        const uint64_t elapsed = static_cast<uint64_t>(now_ns() - start);
+        price_.add(batch->count, elapsed);
+        Utils::Metrics::add(Utils::MetricCounter::PIPELINE_BATCHES);
+        Utils::Metrics::record(Utils::MetricHistogram::PIPELINE_BATCH, elapsed);
+        invalid_.fetch_add(batch->count - priced, std::memory_order_relaxed);
+        warnings_.fetch_add(warned, std::memory_order_relaxed);
+        if (!priced_.push(batch)) {
+            return;
+        }
+    }
+}
+
+PipelineStats QuotePipeline::run(QuoteSource& source, const Sink& sink) {
+    parse_.reset();
+    price_.reset();
+    sink_.reset();
+    rejected_.store(0, std::memory_order_relaxed);
+    invalid_.store(0, std::memory_order_relaxed);
+    warnings_.store(0, std::memory_order_relaxed);
+    
+    // Queues are empty between runs; refill the free list with every batch
+    QuoteBatch* stale = nullptr;
+    while (free_.try_pop(stale)) {
+    }
+    free_.reopen();
+    parsed_.reopen();
+    priced_.reopen();
+    for (QuoteBatch& batch : batches_) {
+        free_.try_push(&batch);
+    }
+    free_.reset_high_water();
+    parsed_.reset_high_water();
+    priced_.reset_high_water();
+    
+    started_ns_.store(now_ns(), std::memory_order_relaxed);
+    running_.store(true, std::memory_order_release);
+    
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    const auto fail = [&]() {
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+        abort();
+    };
+    
+    std::thread reader([&]() {
+        try {
+            read_stage(source);
+        } catch (...) {
+            fail();
+        }
+        parsed_.close();
+    });
+    
+    std::atomic<size_t> remaining{options_.workers};
+    std::vector<std::thread> workers;
+    workers.reserve(options_.workers);
+    for (size_t w = 0; w < options_.workers; ++w) {
+        workers.emplace_back([&]() {
+            try {
+                price_stage();
+            } catch (...) {
+                fail();
+            }
+            if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                priced_.close();
+            }
+        });
+    }
+    
+    QuoteBatch* batch = nullptr;
+    bool sink_failed = false;
+    while (priced_.pop(batch)) {
+        Utils::Metrics::set(Utils::MetricGauge::PIPELINE_PRICED_DEPTH, static_cast<int64_t>(priced_.size()));
+        if (!sink_failed) {
+            const int64_t start = now_ns();
+            try {
+                sink(*batch);
+            } catch (...) {
+                sink_failed = true;
+                fail();
+            }
+            sink_.add(batch->count, static_cast<uint64_t>(now_ns() - start));
+        }
+        free_.push(batch);
+    }
+    
+    reader.join();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    finished_ns_.store(now_ns(), std::memory_order_relaxed);
+    running_.store(false, std::memory_order_release);
+    
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return stats();
+}
+
+PipelineStats QuotePipeline::stats() const noexcept {
+    PipelineStats stats;
+    stats.parse = parse_.snapshot();
+    stats.price = price_.snapshot();
+    stats.sink = sink_.snapshot();
+    stats.rejected_rows = rejected_.load(std::memory_order_relaxed);
+    stats.invalid_rows = invalid_.load(std::memory_order_relaxed);
+    stats.warning_rows = warnings_.load(std::memory_order_relaxed);
+    stats.parsed_depth = parsed_.size();
+    stats.priced_depth = priced_.size();
+    stats.parsed_high_water = parsed_.high_water();
+    stats.priced_high_water = priced_.high_water();
+    const int64_t end = running_.load(std::memory_order_acquire) ? now_ns()
+                                                                 : finished_ns_.load(std::memory_order_relaxed);
+    stats.elapsed_seconds = static_cast<double>(end - started_ns_.load(std::memory_order_relaxed)) * 1e-9;
+    return stats;
+}
+
+} // namespace BlackScholes
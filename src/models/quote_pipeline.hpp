@@ -0,0 +1,340 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "black_scholes.hpp"
+#include "../utils/bounded_queue.hpp"
+
+/**
+ * @file quote_pipeline.hpp
+ * @brief Streaming ingestion of option quotes into the batch pricer
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * A QuotePipeline reads a quote stream from a file or socket, parses it
+ * into structure-of-arrays QuoteBatch buffers, checks and prices each
+ * batch with OptionPricer::check_assumptions() and
+ * OptionPricer::price_batch(), and hands priced batches to a sink. Three
+ * kinds of threads overlap:
+ * - one reader parses batch k + 1,
+ * - pricing workers price batch k,
+ * - the thread that called run() delivers batch k - 1 to the sink.
+ *
+ * Stages exchange batch pointers through BoundedQueue; a fixed set of
+ * batches is allocated up front and recycled, and the reader parses from
+ * one fixed buffer, so the steady state allocates nothing per row or per
+ * batch. With more than one worker, batches may reach the sink out of
+ * order; QuoteBatch::sequence and QuoteBatch::first_row identify them.
+ *
+ * Input formats:
+ * - CSV: `spot,strike,expiry,rate,volatility,dividend,type`, one quote per
+ *   line. type is C/P (or call/put, 1/0); dividend may be left empty.
+ *   Blank lines, lines starting with '#' and a leading header line are
+ *   skipped; other malformed lines are counted as rejected.
+ * - BINARY: a sequence of native-endian QuoteRecord structs.
+ */
+
+namespace BlackScholes {
+
+/**
+ * @brief Wire format of a quote stream
+ */
+enum class QuoteFormat : uint8_t {
+    CSV = 0,        ///< Comma-separated text, one quote per line
+    BINARY = 1      ///< Fixed-size QuoteRecord structs
+};
+
+/**
+ * @brief Convert quote format to string representation
+ * @param format Format to convert
+ * @return String representation of format
+ */
+const char* to_string(QuoteFormat format) noexcept;
+
+/**
+ * @brief One quote of a BINARY stream (56 bytes, native byte order)
+ */
+struct QuoteRecord {
+    double spot_price;
+    double strike_price;
+    double time_to_expiry;
+    double risk_free_rate;
+    double volatility;
+    double dividend_yield;
+    uint32_t is_call;       ///< Nonzero for call, 0 for put
+    uint32_t reserved;      ///< Written as zero, ignored on read
+};
+
+static_assert(sizeof(QuoteRecord) == 56, "QuoteRecord is a wire format");
+
+/**
+ * @brief Readable byte stream backed by a file descriptor
+ */
+class QuoteSource {
+private:
+    int fd_ = -1;
+    bool owned_ = false;
+
+public:
+    QuoteSource() = default;
+    
+    /**
+     * @brief Wrap an existing descriptor
+     * @param fd Open, readable descriptor (file, pipe or socket)
+     * @param owned Whether the source closes fd when destroyed
+     */
+    QuoteSource(int fd, bool owned) noexcept : fd_(fd), owned_(owned) {}
+    
+    ~QuoteSource();
+    
+    QuoteSource(QuoteSource&& other) noexcept;
+    QuoteSource& operator=(QuoteSource&& other) noexcept;
+    QuoteSource(const QuoteSource&) = delete;
+    QuoteSource& operator=(const QuoteSource&) = delete;
+    
+    /**
+     * @brief Open a file for reading
+     * @param path File path
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    static QuoteSource open_file(const std::string& path);
+    
+    /**
+     * @brief Connect to a TCP quote feed
+     * @param host Host name or address
+     * @param port Port number
+     * @throws std::runtime_error if no address accepts the connection
+     */
+    static QuoteSource connect_tcp(const std::string& host, uint16_t port);
+    
+    /**
+     * @brief Read up to size bytes (retries on EINTR)
+     * @return Bytes read, 0 at end of stream
+     * @throws std::runtime_error on read errors
+     */
+    size_t read(char* buffer, size_t size);
+    
+    bool is_open() const noexcept { return fd_ >= 0; }
+};
+
+/**
+ * @brief Structure-of-arrays buffer of quotes and their pricing results
+ *
+ * Columns are allocated once for `capacity` rows and reused; only the
+ * first `count` rows are meaningful. Output columns follow the pipeline's
+ * OutputFlags; unrequested ones stay empty.
+ */
+struct QuoteBatch {
+    std::vector<double> spot_price;
+    std::vector<double> strike_price;
+    std::vector<double> time_to_expiry;
+    std::vector<double> risk_free_rate;
+    std::vector<double> volatility;
+    std::vector<double> dividend_yield;
+    std::vector<uint8_t> is_call;
+    
+    std::vector<double> price;
+    std::vector<double> delta;
+    std::vector<double> gamma;
+    std::vector<double> theta;
+    std::vector<double> vega;
+    std::vector<double> rho;
+    std::vector<uint32_t> status;       ///< BatchStatus flags per row
+    std::vector<uint32_t> warnings;     ///< AssumptionFlags per row
+    
+    size_t capacity = 0;
+    size_t count = 0;                   ///< Rows in use
+    uint64_t sequence = 0;              ///< Batch number in the stream, from 0
+    uint64_t first_row = 0;             ///< Stream index of row 0 (rejected lines not counted)
+    uint64_t rejected = 0;              ///< Malformed records skipped while filling this batch
+    
+    /**
+     * @brief Allocate columns for capacity rows
+     * @param rows Row capacity
+     * @param outputs OutputFlags selecting the result columns
+     */
+    QuoteBatch(size_t rows, uint32_t outputs);
+    
+    /**
+     * @brief Forget the rows (capacity is kept)
+     */
+    void clear() noexcept;
+    
+    bool full() const noexcept { return count == capacity; }
+    
+    /**
+     * @brief Input columns for OptionPricer
+     */
+    BatchInput input() const noexcept;
+    
+    /**
+     * @brief Output columns for OptionPricer (unrequested columns are null)
+     */
+    BatchOutput output() noexcept;
+};
+
+/**
+ * @brief Incremental parser appending quotes to a QuoteBatch
+ *
+ * parse() consumes whole records from a byte range and reports how much
+ * it used; the caller keeps the unconsumed tail (a partial line or record)
+ * and passes it again with more data. finish() handles a tail left at end
+ * of stream.
+ */
+class QuoteParser {
+private:
+    QuoteFormat format_;
+    bool first_line_ = true;        ///< A CSV header is only accepted on the first line
+    
+    bool parse_line(const char* begin, const char* end, QuoteBatch& batch) noexcept;
+
+public:
+    explicit QuoteParser(QuoteFormat format) noexcept : format_(format) {}
+    
+    /**
+     * @brief Append complete records from [data, data + size) until the batch is full
+     * @param data Bytes from the stream
+     * @param size Number of bytes
+     * @param batch Batch to fill (rows are appended at batch.count)
+     * @return Bytes consumed
+     */
+    size_t parse(const char* data, size_t size, QuoteBatch& batch) noexcept;
+    
+    /**
+     * @brief Parse the final tail of the stream (a last CSV line without newline)
+     * @param data Remaining bytes
+     * @param size Number of bytes
+     * @param batch Batch to fill; must have room for one row
+     */
+    void finish(const char* data, size_t size, QuoteBatch& batch) noexcept;
+};
+
+/**
+ * @brief Construction settings for QuotePipeline
+ */
+struct QuotePipelineOptions {
+    QuoteFormat format = QuoteFormat::CSV;
+    size_t batch_size = 4096;                   ///< Rows per QuoteBatch
+    size_t queue_depth = 8;                     ///< Batches queued between two stages
+    size_t workers = 1;                         ///< Pricing threads
+    uint32_t outputs = OutputFlags::ALL;        ///< Results computed per row
+    
+    /**
+     * @brief Read pipeline.batch_size, pipeline.queue_depth and pipeline.workers
+     * @return Options for CSV input with every output; pipeline.workers = 0
+     *         uses threading.max_threads - 2 workers (at least one)
+     */
+    static QuotePipelineOptions from_config();
+};
+
+/**
+ * @brief Throughput of one pipeline stage
+ */
+struct PipelineStageStats {
+    uint64_t batches = 0;
+    uint64_t rows = 0;
+    double busy_seconds = 0.0;      ///< Time spent working, summed over the stage's threads
+    
+    /**
+     * @brief Rows per busy second (0 before any work)
+     */
+    double rows_per_second() const noexcept { return busy_seconds > 0.0 ? static_cast<double>(rows) / busy_seconds : 0.0; }
+};
+
+/**
+ * @brief Counters of a QuotePipeline
+ */
+struct PipelineStats {
+    PipelineStageStats parse;       ///< Reading and parsing
+    PipelineStageStats price;       ///< Assumption checks and pricing
+    PipelineStageStats sink;        ///< Sink callback
+    uint64_t rejected_rows = 0;     ///< Malformed records skipped by the parser
+    uint64_t invalid_rows = 0;      ///< Rows with BatchStatus other than OK
+    uint64_t warning_rows = 0;      ///< Rows with AssumptionFlags other than NONE
+    size_t parsed_depth = 0;        ///< Batches waiting for a worker
+    size_t priced_depth = 0;        ///< Batches waiting for the sink
+    size_t parsed_high_water = 0;   ///< Largest parsed_depth seen
+    size_t priced_high_water = 0;   ///< Largest priced_depth seen
+    double elapsed_seconds = 0.0;   ///< Wall time of the current or last run()
+};
+
+/**
+ * @brief Reader, pricing workers and sink connected by bounded queues
+ */
+class QuotePipeline {
+public:
+    /**
+     * @brief Consumer of priced batches; the batch is recycled when it returns
+     */
+    using Sink = std::function<void(const QuoteBatch&)>;
+
+private:
+    // Per-stage counters, updated once per batch
+    struct StageCounters {
+        std::atomic<uint64_t> batches{0};
+        std::atomic<uint64_t> rows{0};
+        std::atomic<uint64_t> busy_ns{0};
+        
+        void add(size_t rows_done, uint64_t ns) noexcept;
+        void reset() noexcept;
+        PipelineStageStats snapshot() const noexcept;
+    };
+    
+    QuotePipelineOptions options_;
+    std::vector<QuoteBatch> batches_;
+    std::vector<char> buffer_;                  ///< Reader's input buffer
+    Utils::BoundedQueue<QuoteBatch*> free_;     ///< Empty batches for the reader
+    Utils::BoundedQueue<QuoteBatch*> parsed_;   ///< Filled batches for the workers
+    Utils::BoundedQueue<QuoteBatch*> priced_;   ///< Priced batches for the sink
+    
+    StageCounters parse_;
+    StageCounters price_;
+    StageCounters sink_;
+    std::atomic<uint64_t> rejected_{0};
+    std::atomic<uint64_t> invalid_{0};
+    std::atomic<uint64_t> warnings_{0};
+    std::atomic<int64_t> started_ns_{0};
+    std::atomic<int64_t> finished_ns_{0};
+    std::atomic<bool> running_{false};
+    
+    void read_stage(QuoteSource& source);
+    void price_stage();
+    void abort() noexcept;
+
+public:
+    /**
+     * @brief Allocate the batches and queues
+     * @param options Format, batch size, queue depth, workers and outputs
+     */
+    explicit QuotePipeline(const QuotePipelineOptions& options = QuotePipelineOptions::from_config());
+    
+    QuotePipeline(const QuotePipeline&) = delete;
+    QuotePipeline& operator=(const QuotePipeline&) = delete;
+    
+    /**
+     * @brief Stream a source through the pipeline until it ends
+     *
+     * The sink runs on the calling thread. Counters are reset at the start.
+     * If the source or the sink throws, the pipeline stops, the threads are
+     * joined and the first exception is rethrown.
+     *
+     * @param source Quote stream in options.format
+     * @param sink Consumer of priced batches
+     * @return Counters of the run
+     */
+    PipelineStats run(QuoteSource& source, const Sink& sink);
+    
+    /**
+     * @brief Current counters and queue depths (callable from any thread while run() is active)
+     */
+    PipelineStats stats() const noexcept;
+    
+    const QuotePipelineOptions& options() const noexcept { return options_; }
+};
+
+} // namespace BlackScholes
@@ -0,0 +1,283 @@
+#include "scenario_engine.hpp"
+#include "adjoint.hpp"
+#include "vector_math.hpp"
+#include "../utils/thread_pool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace BlackScholes {
+
+namespace {
+
+// Scenario matrix cells per run() task; amortizes the scheduling cost
+constexpr size_t CELLS_PER_TASK = 4096;
+
+void check_scenario(const Scenario& scenario) {
+    if (!std::isfinite(scenario.spot_shift) || !std::isfinite(scenario.vol_shift) ||
+        !std::isfinite(scenario.rate_shift)) {
+        throw std::invalid_argument("Scenario shifts must be finite");
+    }
+    if (scenario.spot_shift <= -1.0) {
+        throw std::invalid_argument("Scenario spot_shift must be greater than -1");
+    }
+}
+
+void check_confidence(double confidence) {
+    if (!(confidence > 0.0 && confidence < 1.0)) {
+        throw std::invalid_argument("VaR confidence must be in (0, 1)");
+    }
+}
+
+} // namespace
+
+ScenarioOptions ScenarioOptions::from_config() {
+    ScenarioOptions options;
+    const auto& config = Config::ConfigManager::getInstance().snapshot();
+    options.var_confidence_95 = config.risk.var_confidence_95;
+    options.var_confidence_99 = config.risk.var_confidence_99;
+    options.enable_stress_testing = config.risk.enable_stress_testing;
+    return options;
+}
+
+ScenarioEngine::ScenarioEngine(const std::vector<Position>& positions, const ScenarioOptions& options,
+                               Utils::ThreadPool* pool)
+    : options_(options), pool_(pool != nullptr ? pool : &Utils::ThreadPool::shared()) {
+    const size_t n = positions.size();
+    for (std::vector<double>* column : {&spot_, &strike_, &time_, &rate_, &dividend_, &vol_, &sign_,
+                                        &quantity_, &log_moneyness_, &sqrt_T_, &sigma_sqrt_T_,
+                                        &drift_T_, &discount_, &dividend_factor_, &base_value_}) {
+        column->resize(n);
+    }
+    
+    for (size_t i = 0; i < n; ++i) {
+        const Parameters& p = positions[i].params;
+        spot_[i] = p.spot_price;
+        strike_[i] = p.strike_price;
+        time_[i] = p.time_to_expiry;
+        rate_[i] = p.risk_free_rate;
+        dividend_[i] = p.dividend_yield;
+        vol_[i] = p.volatility;
+        sign_[i] = positions[i].is_call ? 1.0 : -1.0;
+        quantity_[i] = positions[i].quantity;
+        log_moneyness_[i] = std::log(p.spot_price / p.strike_price);
+        sqrt_T_[i] = std::sqrt(p.time_to_expiry);
+        sigma_sqrt_T_[i] = p.volatility * sqrt_T_[i];
+        drift_T_[i] = (p.risk_free_rate - p.dividend_yield + 0.5 * p.volatility * p.volatility) * p.time_to_expiry;
+        discount_[i] = std::exp(-p.risk_free_rate * p.time_to_expiry);
+        dividend_factor_[i] = std::exp(-p.dividend_yield * p.time_to_expiry);
+        
+        const PricingResult greeks = OptionPricer::evaluate(p, positions[i].is_call,
+                                                            OutputFlags::DELTA | OutputFlags::VEGA);
+        dollar_delta_ += positions[i].quantity * greeks.greeks.delta * p.spot_price;
+        vega_ += positions[i].quantity * greeks.greeks.vega * 100.0;     // Greeks::vega is per 1%
+    }
+    
+    // Base values come from the scenario kernel itself, so a zero shift gives exactly zero P&L
+    for (size_t begin = 0; begin < n; begin += BLOCK_POSITIONS) {
+        value_block(Scenario(), begin, std::min(BLOCK_POSITIONS, n - begin), &base_value_[begin]);
+    }
+}
+
+void ScenarioEngine::value_block(const Scenario& scenario, size_t begin, size_t n, double* value) const noexcept {
+    double n_d1[BLOCK_POSITIONS] = {};
+    double n_d2[BLOCK_POSITIONS] = {};
+    double rate_factor[BLOCK_POSITIONS];
+    const double spot_factor = 1.0 + scenario.spot_shift;
+    const double log_spot_factor = std::log1p(scenario.spot_shift);
+    const bool vol_or_rate = scenario.vol_shift != 0.0 || scenario.rate_shift != 0.0;
+    
+    // d1 and d2 oriented by the call/put sign, replaced by N(±d1) and N(±d2) below
+    for (size_t j = 0; j < n; ++j) {
+        const size_t i = begin + j;
+        double sigma_sqrt_T = sigma_sqrt_T_[i];
+        double drift_T = drift_T_[i];
+        if (vol_or_rate) {
+            const double sigma = std::max(vol_[i] + scenario.vol_shift, MIN_VOLATILITY);
+            sigma_sqrt_T = sigma * sqrt_T_[i];
+            drift_T = (rate_[i] + scenario.rate_shift - dividend_[i] + 0.5 * sigma * sigma) * time_[i];
+        }
+        const double d1 = (log_moneyness_[i] + log_spot_factor + drift_T) / sigma_sqrt_T;
+        n_d1[j] = sign_[i] * d1;
+        n_d2[j] = sign_[i] * (d1 - sigma_sqrt_T);
+        rate_factor[j] = -scenario.rate_shift * time_[i];
+    }
+    VectorMath::normal_cdf(n_d1, n_d1, n);
+    VectorMath::normal_cdf(n_d2, n_d2, n);
+    if (scenario.rate_shift != 0.0) {
+        VectorMath::exp(rate_factor, rate_factor, n);
+    } else {
+        std::fill(rate_factor, rate_factor + n, 1.0);
+    }
+    
+    for (size_t j = 0; j < n; ++j) {
+        const size_t i = begin + j;
+        value[j] = sign_[i] * (spot_[i] * spot_factor * dividend_factor_[i] * n_d1[j] -
+                               strike_[i] * discount_[i] * rate_factor[j] * n_d2[j]);
+    }
+}
+
+void ScenarioEngine::run(const Scenario* scenarios, size_t count, double* pnl) const {
+    for (size_t s = 0; s < count; ++s) {
+        check_scenario(scenarios[s]);
+    }
+    const size_t n = positions();
+    if (count == 0 || n == 0) {
+        return;
+    }
+    
+    pool_->parallel_for_range(count, [&](size_t first, size_t last) {
+        for (size_t s = first; s < last; ++s) {
+            double* row = pnl + s * n;
+            for (size_t begin = 0; begin < n; begin += BLOCK_POSITIONS) {
+                const size_t block = std::min(BLOCK_POSITIONS, n - begin);
+                value_block(scenarios[s], begin, block, row + begin);
+                for (size_t i = begin; i < begin + block; ++i) {
+                    row[i] = quantity_[i] * (row[i] - base_value_[i]);
+                }
+            }
+        }
+    }, std::max<size_t>(1, CELLS_PER_TASK / n), options_.max_threads);
+}
+
+std::vector<double> ScenarioEngine::run(const std::vector<Scenario>& scenarios) const {
+    std::vector<double> pnl(scenarios.size() * positions());
+    run(scenarios.data(), scenarios.size(), pnl.data());
+    return pnl;
+}
+
+void ScenarioEngine::ladder(const double* pnl, size_t count, double* totals) const noexcept {
+    const size_t n = positions();
+    for (size_t s = 0; s < count; ++s) {
+        double total = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            total += pnl[s * n + i];
+        }
+        totals[s] = total;
+    }
+}
+
+ScenarioGreeks ScenarioEngine::greeks(const Scenario& scenario) const {
+    check_scenario(scenario);
+    const size_t n = positions();
+    AD::TapeScope scope;
+    AD::Tape& tape = scope.tape();
+    const AD::Real spot_shift = tape.variable(scenario.spot_shift);
+    const AD::Real vol_shift = tape.variable(scenario.vol_shift);
+    const AD::Real rate_shift = tape.variable(scenario.rate_shift);
+    
+    // Same terms as value_block(), with the position inputs as variables
+    Utils::ArenaScope scratch;
+    std::pmr::vector<AD::Real> inputs(3 * n, scratch.resource());
+    AD::Real value = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const AD::Real spot = inputs[3 * i] = tape.variable(spot_[i]);
+        const AD::Real vol = inputs[3 * i + 1] = tape.variable(vol_[i]);
+        const AD::Real rate = inputs[3 * i + 2] = tape.variable(rate_[i]);
+        
+        const AD::Real sigma = AD::max(vol + vol_shift, MIN_VOLATILITY);
+        const AD::Real sigma_sqrt_T = sigma * sqrt_T_[i];
+        const AD::Real shifted_spot = spot * (1.0 + spot_shift);
+        const AD::Real shifted_rate = rate + rate_shift;
+        const AD::Real d1 = (AD::log(shifted_spot / strike_[i]) +
+                             (shifted_rate - dividend_[i] + 0.5 * sigma * sigma) * time_[i]) / sigma_sqrt_T;
+        const AD::Real unit = sign_[i] * (shifted_spot * dividend_factor_[i] * AD::normal_cdf(sign_[i] * d1) -
+                                          strike_[i] * AD::exp(-shifted_rate * time_[i]) *
+                                              AD::normal_cdf(sign_[i] * (d1 - sigma_sqrt_T)));
+        value += quantity_[i] * unit;
+    }
+    tape.backward(value);
+    
+    ScenarioGreeks result;
+    result.value = value.value();
+    result.spot_shift = tape.adjoint(spot_shift);
+    result.vol_shift = tape.adjoint(vol_shift);
+    result.rate_shift = tape.adjoint(rate_shift);
+    result.delta.resize(n);
+    result.vega.resize(n);
+    result.rho.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        result.delta[i] = tape.adjoint(inputs[3 * i]);
+        result.vega[i] = tape.adjoint(inputs[3 * i + 1]);
+        result.rho[i] = tape.adjoint(inputs[3 * i + 2]);
+    }
+    return result;
+}
+
+double ScenarioEngine::historical_var(const double* totals, size_t count, double confidence) {
+    check_confidence(confidence);
+    if (count == 0) {
+        throw std::invalid_argument("Historical VaR needs at least one scenario");
+    }
+    // The (1 - c)·n worst outcomes lie strictly beyond VaR
+    std::vector<double> sorted(totals, totals + count);
+    const size_t k = std::min(count - 1, static_cast<size_t>(std::floor((1.0 - confidence) * static_cast<double>(count))));
+    std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(k), sorted.end());
+    return -sorted[k];
+}
+
+double ScenarioEngine::parametric_var(double spot_return_vol, double vol_change_vol, double confidence) const {
+    check_confidence(confidence);
+    const double spot_term = dollar_delta_ * spot_return_vol;
+    const double vol_term = vega_ * vol_change_vol;
+    return MathUtils::normal_inv_cdf(confidence) * std::sqrt(spot_term * spot_term + vol_term * vol_term);
+}
+
+RiskReport ScenarioEngine::report(const std::vector<Scenario>& historical, double spot_return_vol,
+                                  double vol_change_vol) const {
+    if (historical.empty()) {
+        throw std::invalid_argument("Risk report needs at least one historical scenario");
+    }
+    RiskReport result;
+    result.base_value = base_value();
+    
+    std::vector<double> totals(historical.size());
+    ladder(run(historical).data(), historical.size(), totals.data());
+    result.var_95 = historical_var(totals.data(), totals.size(), options_.var_confidence_95);
+    result.var_99 = historical_var(totals.data(), totals.size(), options_.var_confidence_99);
+    result.parametric_var_95 = parametric_var(spot_return_vol, vol_change_vol, options_.var_confidence_95);
+    result.parametric_var_99 = parametric_var(spot_return_vol, vol_change_vol, options_.var_confidence_99);
+    
+    if (options_.enable_stress_testing) {
+        const std::vector<Scenario> stress = stress_scenarios();
+        totals.resize(stress.size());
+        ladder(run(stress).data(), stress.size(), totals.data());
+        const auto worst = std::min_element(totals.begin(), totals.end());
+        result.stress_loss = -*worst;
+        result.stress_scenario = static_cast<size_t>(worst - totals.begin());
+    }
+    return result;
+}
+
+std::vector<Scenario> ScenarioEngine::grid(const std::vector<double>& spot_shifts,
+                                           const std::vector<double>& vol_shifts,
+                                           const std::vector<double>& rate_shifts) {
+    std::vector<Scenario> scenarios;
+    scenarios.reserve(spot_shifts.size() * vol_shifts.size() * rate_shifts.size());
+    for (double spot : spot_shifts) {
+        for (double vol : vol_shifts) {
+            for (double rate : rate_shifts) {
+                Scenario scenario;
+                scenario.spot_shift = spot;
+                scenario.vol_shift = vol;
+                scenario.rate_shift = rate;
+                scenarios.push_back(scenario);
+            }
+        }
+    }
+    return scenarios;
+}
+
+std::vector<Scenario> ScenarioEngine::stress_scenarios() {
+    return grid({-0.20, -0.10, -0.05, 0.0, 0.05, 0.10, 0.20}, {-0.05, 0.0, 0.05}, {-0.01, 0.0, 0.01});
+}
+
+double ScenarioEngine::base_value() const noexcept {
+    double total = 0.0;
+    for (size_t i = 0; i < positions(); ++i) {
+        total += quantity_[i] * base_value_[i];
+    }
+    return total;
+}
+
+} // namespace BlackScholes
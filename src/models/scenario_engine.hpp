@@ -0,0 +1,247 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "black_scholes.hpp"
+
+/**
+ * @file scenario_engine.hpp
+ * @brief Bump-and-reprice scenario engine for risk ladders, VaR and stress tests
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * A ScenarioEngine holds a portfolio of European options and reprices it
+ * under shifts of spot (relative), volatility and rate (absolute). The
+ * base state of every position (ln(S/K), √T, σ√T, the drift term and both
+ * discount factors) is computed once at construction; a scenario then
+ * only recomputes what it shifts:
+ * - Spot-only shocks add ln(1 + shift) to ln(S/K), so each position costs
+ *   two normal CDF evaluations.
+ * - Volatility shocks recompute σ√T and the drift term.
+ * - Rate shocks also rescale the discount factor by e^{-ΔrT}.
+ *
+ * Scenarios are distributed across a thread pool and P&L is written
+ * straight into a caller-owned (scenario × position) matrix. Positions in
+ * a scenario are evaluated in blocks with the VectorMath kernels.
+ *
+ * Historical VaR is read from the sorted scenario P&L; parametric VaR is the
+ * delta-vega normal approximation for a portfolio on one underlying.
+ *
+ * greeks() values the portfolio under one scenario on an AD::Real tape;
+ * one backward sweep gives the sensitivity to each scenario shift and to
+ * the spot, volatility and rate of every position.
+ */
+
+namespace BlackScholes {
+
+/**
+ * @brief One option position
+ */
+struct Position {
+    Parameters params;      ///< Market parameters in the base state
+    bool is_call;           ///< Call or put
+    double quantity;        ///< Signed number of options (negative = short)
+    
+    Position(const Parameters& p, bool call, double qty = 1.0)
+        : params(p), is_call(call), quantity(qty) {}
+};
+
+/**
+ * @brief Market shift applied to every position
+ */
+struct Scenario {
+    double spot_shift = 0.0;    ///< Relative spot move (-0.1 = spot down 10%)
+    double vol_shift = 0.0;     ///< Absolute volatility move (0.02 = up 2 vol points)
+    double rate_shift = 0.0;    ///< Absolute rate move (0.0025 = up 25bp)
+};
+
+/**
+ * @brief Risk settings for ScenarioEngine
+ */
+struct ScenarioOptions {
+    double var_confidence_95 = 0.95;    ///< Confidence of RiskReport::var_95
+    double var_confidence_99 = 0.99;    ///< Confidence of RiskReport::var_99
+    bool enable_stress_testing = true;  ///< Evaluate stress_scenarios() in report()
+    size_t max_threads = 0;             ///< Thread limit including the caller (0 = pool size + 1)
+    
+    /**
+     * @brief Read risk.* settings
+     * @return Options populated from configuration
+     */
+    static ScenarioOptions from_config();
+};
+
+/**
+ * @brief Portfolio risk figures from ScenarioEngine::report()
+ *
+ * VaR figures are losses: positive when the portfolio loses money.
+ */
+struct RiskReport {
+    double base_value = 0.0;            ///< Portfolio value in the base state
+    double var_95 = 0.0;                ///< Historical VaR at var_confidence_95
+    double var_99 = 0.0;                ///< Historical VaR at var_confidence_99
+    double parametric_var_95 = 0.0;     ///< Delta-vega normal VaR at var_confidence_95
+    double parametric_var_99 = 0.0;     ///< Delta-vega normal VaR at var_confidence_99
+    double stress_loss = 0.0;           ///< Largest loss over stress_scenarios() (0 if disabled)
+    size_t stress_scenario = 0;         ///< Index of that scenario in stress_scenarios()
+};
+
+/**
+ * @brief Adjoint sensitivities of the portfolio value under one scenario
+ *
+ * Position figures are derivatives of the whole portfolio value, so they
+ * include the quantity; volatility and rate derivatives are per unit.
+ */
+struct ScenarioGreeks {
+    double value = 0.0;         ///< Portfolio value under the scenario
+    double spot_shift = 0.0;    ///< ∂value/∂spot_shift
+    double vol_shift = 0.0;     ///< ∂value/∂vol_shift
+    double rate_shift = 0.0;    ///< ∂value/∂rate_shift
+    std::vector<double> delta;  ///< ∂value/∂S of each position
+    std::vector<double> vega;   ///< ∂value/∂σ of each position
+    std::vector<double> rho;    ///< ∂value/∂r of each position
+};
+
+/**
+ * @brief Reprices a fixed portfolio under market scenarios
+ *
+ * The portfolio is fixed at construction. All other members are const
+ * and may be called from several threads at once.
+ */
+class ScenarioEngine {
+private:
+    ScenarioOptions options_;
+    Utils::ThreadPool* pool_;
+    
+    // Base state per position, structure-of-arrays
+    std::vector<double> spot_, strike_, time_, rate_, dividend_, vol_, sign_, quantity_;
+    std::vector<double> log_moneyness_, sqrt_T_, sigma_sqrt_T_, drift_T_, discount_, dividend_factor_;
+    std::vector<double> base_value_;    ///< Unit value per position
+    double dollar_delta_ = 0.0;         ///< Σ quantity · Δ · S
+    double vega_ = 0.0;                 ///< Σ quantity · ∂V/∂σ (per unit of σ)
+    
+    void value_block(const Scenario& scenario, size_t begin, size_t n, double* value) const noexcept;
+
+public:
+    /// Positions evaluated together by one VectorMath call
+    static constexpr size_t BLOCK_POSITIONS = 64;
+    
+    /// Floor applied to shifted volatilities
+    static constexpr double MIN_VOLATILITY = 1e-4;
+    
+    /**
+     * @brief Capture the base state of a portfolio
+     * @param positions Portfolio
+     * @param options Risk settings
+     * @param pool Thread pool for the scenarios (nullptr = Utils::ThreadPool::shared())
+     */
+    explicit ScenarioEngine(const std::vector<Position>& positions,
+                            const ScenarioOptions& options = ScenarioOptions::from_config(),
+                            Utils::ThreadPool* pool = nullptr);
+    
+    /**
+     * @brief Reprice every position under every scenario
+     *
+     * pnl[s * positions() + p] receives quantity · (V_s - V_base) of
+     * position p under scenario s. No allocation is performed.
+     *
+     * @param scenarios Scenarios to apply
+     * @param count Number of scenarios
+     * @param pnl Caller-owned matrix of count × positions() values
+     * @throws std::invalid_argument if a shift is not finite or spot_shift <= -1
+     */
+    void run(const Scenario* scenarios, size_t count, double* pnl) const;
+    
+    /**
+     * @brief Reprice every position under every scenario into a new matrix
+     * @param scenarios Scenarios to apply
+     * @return Row-major (scenario × position) P&L matrix
+     * @throws std::invalid_argument if a shift is not finite or spot_shift <= -1
+     */
+    std::vector<double> run(const std::vector<Scenario>& scenarios) const;
+    
+    /**
+     * @brief Sum a P&L matrix over positions
+     * @param pnl Matrix produced by run()
+     * @param count Number of scenarios in the matrix
+     * @param totals Caller-owned array of count portfolio P&L values
+     */
+    void ladder(const double* pnl, size_t count, double* totals) const noexcept;
+    
+    /**
+     * @brief Portfolio value under a scenario and all its first-order sensitivities
+     *
+     * Records the closed-form value of every position on the calling
+     * thread's AD tape and sweeps it backward once.
+     *
+     * @param scenario Scenario to apply (Scenario() for the base state)
+     * @return Value and derivatives
+     * @throws std::invalid_argument if a shift is not finite or spot_shift <= -1
+     */
+    ScenarioGreeks greeks(const Scenario& scenario = Scenario()) const;
+    
+    /**
+     * @brief Delta-vega normal VaR
+     *
+     * Treats the portfolio as ΔP = dollar_delta · R + vega · Δσ with
+     * independent normal spot return R and volatility change Δσ.
+     *
+     * @param spot_return_vol Standard deviation of the spot return over the horizon
+     * @param vol_change_vol Standard deviation of the volatility change over the horizon
+     * @param confidence Confidence level in (0, 1)
+     * @return Loss exceeded with probability 1 - confidence
+     * @throws std::invalid_argument if confidence is not in (0, 1)
+     */
+    double parametric_var(double spot_return_vol, double vol_change_vol, double confidence) const;
+    
+    /**
+     * @brief Historical VaR, parametric VaR and stress loss in one report
+     *
+     * Each historical scenario is weighted equally.
+     *
+     * @param historical Observed market moves over the VaR horizon
+     * @param spot_return_vol Spot return volatility for the parametric figures
+     * @param vol_change_vol Volatility-change volatility for the parametric figures
+     * @return Portfolio risk figures
+     * @throws std::invalid_argument if historical is empty or a shift is invalid
+     */
+    RiskReport report(const std::vector<Scenario>& historical, double spot_return_vol,
+                      double vol_change_vol) const;
+    
+    /**
+     * @brief Loss exceeded in at most a fraction 1 - confidence of the scenarios
+     * @param totals Portfolio P&L per scenario
+     * @param count Number of scenarios (at least 1)
+     * @param confidence Confidence level in (0, 1)
+     * @return VaR (positive = loss)
+     * @throws std::invalid_argument if count is 0 or confidence is not in (0, 1)
+     */
+    static double historical_var(const double* totals, size_t count, double confidence);
+    
+    /**
+     * @brief Cartesian product of shift ladders
+     * @return One scenario per (spot, vol, rate) combination, spot varying slowest
+     */
+    static std::vector<Scenario> grid(const std::vector<double>& spot_shifts,
+                                      const std::vector<double>& vol_shifts,
+                                      const std::vector<double>& rate_shifts);
+    
+    /**
+     * @brief Standard stress grid: spot ±5/10/20%, volatility ±5 points, rates ±100bp
+     */
+    static std::vector<Scenario> stress_scenarios();
+    
+    size_t positions() const noexcept { return spot_.size(); }
+    
+    /**
+     * @brief Portfolio value in the base state
+     */
+    double base_value() const noexcept;
+    
+    double dollar_delta() const noexcept { return dollar_delta_; }
+    double vega() const noexcept { return vega_; }
+    const ScenarioOptions& options() const noexcept { return options_; }
+};
+
+} // namespace BlackScholes
@@ -0,0 +1,125 @@
+#include "sobol.hpp"
+#include "sobol_directions.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace BlackScholes {
+
+SobolSequence::SobolSequence(uint32_t dimensions)
+    : dimensions_(dimensions), directions_(static_cast<size_t>(dimensions) * BITS) {
+    if (dimensions == 0 || dimensions > MAX_DIMENSIONS) {
+        throw std::invalid_argument("Sobol dimensions must be between 1 and 1024");
+    }
+    
+    // Dimension 1: van der Corput, v_k = 2^(32-k)
+    for (uint32_t k = 0; k < BITS; ++k) {
+        directions_[k] = 1u << (BITS - 1 - k);
+    }
+    
+    for (uint32_t d = 1; d < dimensions; ++d) {
+        const detail::SobolPrimitive& primitive = detail::SOBOL_PRIMITIVES[d - 1];
+        uint32_t degree = 0;
+        while ((primitive.polynomial >> (degree + 1)) != 0) {
+            ++degree;
+        }
+        // Coefficients a_1 ... a_{s-1} of x^{s-1} ... x
+        const uint32_t inner = (primitive.polynomial >> 1) & ((1u << (degree - 1)) - 1u);
+        
+        uint32_t* v = &directions_[static_cast<size_t>(d) * BITS];
+        for (uint32_t k = 0; k < degree && k < BITS; ++k) {
+            v[k] = static_cast<uint32_t>(primitive.m[k]) << (BITS - 1 - k);
+        }
+        for (uint32_t k = degree; k < BITS; ++k) {
+            uint32_t value = v[k - degree] ^ (v[k - degree] >> degree);
+            for (uint32_t i = 1; i < degree; ++i) {
+                if ((inner >> (degree - 1 - i)) & 1u) {
+                    value ^= v[k - i];
+                }
+            }
+            v[k] = value;
+        }
+    }
+}
+
+void SobolSequence::point(uint64_t index, uint32_t* out) const noexcept {
+    const uint64_t gray = index ^ (index >> 1);
+    for (uint32_t d = 0; d < dimensions_; ++d) {
+        const uint32_t* v = &directions_[static_cast<size_t>(d) * BITS];
+        uint32_t x = 0;
+        for (uint32_t k = 0; k < BITS; ++k) {
+            if ((gray >> k) & 1u) {
+                x ^= v[k];
+            }
+        }
+        out[d] = x;
+    }
+}
+
+void SobolSequence::next(uint64_t index, uint32_t* state) const noexcept {
+    // gray(index) and gray(index + 1) differ in the lowest zero bit of index
+    uint32_t bit = 0;
+    while ((index >> bit) & 1u) {
+        ++bit;
+    }
+    for (uint32_t d = 0; d < dimensions_; ++d) {
+        state[d] ^= directions_[static_cast<size_t>(d) * BITS + bit];
+    }
+}
+
+BrownianBridge::BrownianBridge(size_t steps)
+    : bridge_index_(steps), left_index_(steps), right_index_(steps),
+      left_weight_(steps), right_weight_(steps), std_dev_(steps) {
+    if (steps == 0) {
+        throw std::invalid_argument("Brownian bridge needs at least one date");
+    }
+    
+    const double n = static_cast<double>(steps);
+    auto time = [n](size_t i) { return static_cast<double>(i + 1) / n; };
+    
+    // placed[i] != 0 once date i has been set
+    std::vector<size_t> placed(steps, 0);
+    placed[steps - 1] = 1;
+    bridge_index_[0] = steps - 1;
+    std_dev_[0] = 1.0;
+    
+    size_t j = 0;
+    for (size_t i = 1; i < steps; ++i) {
+        // Next gap [j, k): dates j ... k-1 unset, k set
+        while (placed[j] != 0) {
+            ++j;
+        }
+        size_t k = j;
+        while (placed[k] == 0) {
+            ++k;
+        }
+        const size_t l = j + ((k - 1 - j) >> 1);
+        placed[l] = i;
+        bridge_index_[i] = l;
+        left_index_[i] = j;
+        right_index_[i] = k;
+        
+        const double t_left = j != 0 ? time(j - 1) : 0.0;
+        const double t_mid = time(l);
+        const double t_right = time(k);
+        left_weight_[i] = (t_right - t_mid) / (t_right - t_left);
+        right_weight_[i] = (t_mid - t_left) / (t_right - t_left);
+        std_dev_[i] = std::sqrt((t_mid - t_left) * (t_right - t_mid) / (t_right - t_left));
+        
+        j = k + 1;
+        if (j >= steps) {
+            j = 0;
+        }
+    }
+}
+
+void BrownianBridge::transform(const double* z, double* w) const noexcept {
+    const size_t steps = size();
+    w[steps - 1] = std_dev_[0] * z[0];
+    for (size_t i = 1; i < steps; ++i) {
+        const size_t j = left_index_[i];
+        const double left = j != 0 ? w[j - 1] : 0.0;
+        w[bridge_index_[i]] = left_weight_[i] * left + right_weight_[i] * w[right_index_[i]] + std_dev_[i] * z[i];
+    }
+}
+
+} // namespace BlackScholes
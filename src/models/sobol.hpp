@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file sobol.hpp
+ * @brief Sobol low-discrepancy sequence for quasi-Monte Carlo
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * Points are generated in Gray-code order with 32-bit direction numbers
+ * (Joe-Kuo new-joe-kuo-6.21201, up to 1024 dimensions). Point i is the XOR
+ * of the direction numbers selected by the bits of gray(i) = i ^ (i >> 1),
+ * so any point can be computed directly and consecutive points differ by
+ * a single XOR per dimension. This lets each thread start at its own
+ * offset and still produce exactly the sequential stream.
+ */
+
+namespace BlackScholes {
+
+/**
+ * @brief Sobol sequence generator
+ */
+class SobolSequence {
+public:
+    static constexpr uint32_t MAX_DIMENSIONS = 1024;
+    static constexpr uint32_t BITS = 32;
+    
+    /**
+     * @brief Build the direction numbers
+     * @param dimensions Number of dimensions (1 to MAX_DIMENSIONS)
+     * @throws std::invalid_argument if dimensions is out of range
+     */
+    explicit SobolSequence(uint32_t dimensions);
+    
+    uint32_t dimensions() const noexcept { return dimensions_; }
+    
+    /**
+     * @brief Compute point `index` directly
+     * @param index Point index (< 2^32)
+     * @param out Integer coordinates, one per dimension
+     */
+    void point(uint64_t index, uint32_t* out) const noexcept;
+    
+    /**
+     * @brief Advance point `index` (in place) to point `index + 1`
+     * @param index Index of the point currently held in state
+     * @param state Integer coordinates, one per dimension
+     */
+    void next(uint64_t index, uint32_t* state) const noexcept;
+    
+    /**
+     * @brief Map an integer coordinate to the open interval (0, 1)
+     * @param x Integer coordinate
+     * @return (x + 0.5) / 2^32
+     */
+    static double to_unit(uint32_t x) noexcept {
+        return (static_cast<double>(x) + 0.5) * 0x1.0p-32;
+    }
+
+private:
+    uint32_t dimensions_;
+    std::vector<uint32_t> directions_;  ///< BITS direction numbers per dimension
+};
+
+/**
+ * @brief Brownian bridge construction over equally spaced dates
+ *
+ * Maps independent standard normals to a Brownian path on t_i = (i + 1)/n,
+ * i = 0 ... n-1, over unit total time: the first normal sets W(1), the
+ * next the midpoint, and so on by bisection. With a low-discrepancy
+ * sequence this puts the coordinates with the best uniformity on the
+ * directions that explain most of the path variance.
+ */
+class BrownianBridge {
+public:
+    /**
+     * @brief Precompute the construction order and weights
+     * @param steps Number of dates (at least 1)
+     * @throws std::invalid_argument if steps is 0
+     */
+    explicit BrownianBridge(size_t steps);
+    
+    size_t size() const noexcept { return bridge_index_.size(); }
+    
+    /**
+     * @brief Build a path from normals
+     * @param z size() independent standard normals, in construction order
+     * @param w Output W(t_i) for i = 0 ... size()-1 (must not alias z)
+     */
+    void transform(const double* z, double* w) const noexcept;
+
+private:
+    std::vector<size_t> bridge_index_;  ///< Date set by each normal
+    std::vector<size_t> left_index_;    ///< One past the left neighbour (0 = origin)
+    std::vector<size_t> right_index_;   ///< Right neighbour
+    std::vector<double> left_weight_;
+    std::vector<double> right_weight_;
+    std::vector<double> std_dev_;
+};
+
+} // namespace BlackScholes
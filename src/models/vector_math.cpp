@@ -0,0 +1,168 @@
+#include "vector_math.hpp"
+#include "vector_math_kernels.hpp"
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+namespace BlackScholes {
+namespace VectorMath {
+
+namespace detail {
+namespace {
+
+/**
+ * Portable fallback: one double per "register". mul_add stays unfused so the
+ * fallback does not depend on hardware FMA; fma_exact uses std::fma because
+ * the exact split of x² in the Gaussian kernels needs a true fused result.
+ */
+struct ScalarOps {
+    using reg = double;
+    using mask = bool;
+    static constexpr size_t width = 1;
+    
+    static reg load(const double* p) noexcept { return *p; }
+    static void store(double* p, reg v) noexcept { *p = v; }
+    static reg set1(double v) noexcept { return v; }
+    static reg set1_bits(uint64_t bits) noexcept { return from_bits(bits); }
+    
+    static reg add(reg a, reg b) noexcept { return a + b; }
+    static reg sub(reg a, reg b) noexcept { return a - b; }
+    static reg mul(reg a, reg b) noexcept { return a * b; }
+    static reg div(reg a, reg b) noexcept { return a / b; }
+    static reg sqrt(reg a) noexcept { return std::sqrt(a); }
+    static reg min(reg a, reg b) noexcept { return a < b ? a : b; }
+    static reg max(reg a, reg b) noexcept { return a > b ? a : b; }
+    static reg round_nearest(reg a) noexcept { return std::nearbyint(a); }
+    static reg floor(reg a) noexcept { return std::floor(a); }
+    static reg mul_add(reg a, reg b, reg c) noexcept { return a * b + c; }
+    static reg fma_exact(reg a, reg b, reg c) noexcept { return std::fma(a, b, c); }
+    
+    static mask lt(reg a, reg b) noexcept { return a < b; }
+    static mask gt(reg a, reg b) noexcept { return a > b; }
+    static mask eq(reg a, reg b) noexcept { return a == b; }
+    static mask is_nan(reg a) noexcept { return a != a; }
+    static reg select(mask m, reg a, reg b) noexcept { return m ? a : b; }
+    
+    static reg bits_and(reg a, reg b) noexcept { return from_bits(to_bits(a) & to_bits(b)); }
+    static reg bits_or(reg a, reg b) noexcept { return from_bits(to_bits(a) | to_bits(b)); }
+    static reg bits_add(reg a, reg b) noexcept { return from_bits(to_bits(a) + to_bits(b)); }
+    template<int N> static reg shl(reg a) noexcept { return from_bits(to_bits(a) << N); }
+    template<int N> static reg shr(reg a) noexcept { return from_bits(to_bits(a) >> N); }
+
+private:
+    static uint64_t to_bits(double v) noexcept {
+        uint64_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        return bits;
+    }
+    
+    static double from_bits(uint64_t bits) noexcept {
+        double v;
+        std::memcpy(&v, &bits, sizeof(v));
+        return v;
+    }
+};
+
+constexpr KernelTable scalar_table = make_kernel_table<ScalarOps>();
+
+} // namespace
+
+const KernelTable* scalar_kernels() noexcept {
+    return &scalar_table;
+}
+
+} // namespace detail
+
+namespace {
+
+const detail::KernelTable* kernels_for(SimdLevel level) noexcept {
+    switch (level) {
+        case SimdLevel::AVX512: return detail::avx512_kernels();
+        case SimdLevel::AVX2:   return detail::avx2_kernels();
+        case SimdLevel::NEON:   return detail::neon_kernels();
+        case SimdLevel::SCALAR: return detail::scalar_kernels();
+    }
+    return detail::scalar_kernels();
+}
+
+std::atomic<int> g_active_level{-1};
+
+const detail::KernelTable& active_kernels() noexcept {
+    return *kernels_for(active_simd_level());
+}
+
+} // namespace
+
+const char* to_string(SimdLevel level) noexcept {
+    switch (level) {
+        case SimdLevel::SCALAR: return "SCALAR";
+        case SimdLevel::NEON:   return "NEON";
+        case SimdLevel::AVX2:   return "AVX2";
+        case SimdLevel::AVX512: return "AVX512";
+        default:                return "UNKNOWN";
+    }
+}
+
+SimdLevel detect_simd_level() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (detail::avx512_kernels() != nullptr && __builtin_cpu_supports("avx512f")) {
+        return SimdLevel::AVX512;
+    }
+    if (detail::avx2_kernels() != nullptr &&
+        __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return SimdLevel::AVX2;
+    }
+#else
+    if (detail::neon_kernels() != nullptr) {
+        return SimdLevel::NEON;
+    }
+#endif
+    return SimdLevel::SCALAR;
+}
+
+SimdLevel active_simd_level() noexcept {
+    int level = g_active_level.load(std::memory_order_acquire);
+    if (level < 0) {
+        // Benign race: concurrent first calls all detect the same level
+        level = static_cast<int>(detect_simd_level());
+        g_active_level.store(level, std::memory_order_release);
+    }
+    return static_cast<SimdLevel>(level);
+}
+
+SimdLevel set_simd_level(SimdLevel level) noexcept {
+    const SimdLevel detected = detect_simd_level();
+    if (static_cast<int>(level) > static_cast<int>(detected) || kernels_for(level) == nullptr) {
+        level = detected;
+    }
+    g_active_level.store(static_cast<int>(level), std::memory_order_release);
+    return level;
+}
+
+void exp(const double* x, double* out, size_t n) noexcept {
+    active_kernels().exp(x, out, n);
+}
+
+void log(const double* x, double* out, size_t n) noexcept {
+    active_kernels().log(x, out, n);
+}
+
+void sqrt(const double* x, double* out, size_t n) noexcept {
+    active_kernels().sqrt(x, out, n);
+}
+
+void normal_pdf(const double* x, double* out, size_t n) noexcept {
+    active_kernels().normal_pdf(x, out, n);
+}
+
+void normal_cdf(const double* x, double* out, size_t n) noexcept {
+    active_kernels().normal_cdf(x, out, n);
+}
+
+void normal_inv_cdf(const double* p, double* out, size_t n) noexcept {
+    active_kernels().normal_inv_cdf(p, out, n);
+}
+
+} // namespace VectorMath
+} // namespace BlackScholes
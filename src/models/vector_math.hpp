@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @file vector_math.hpp
+ * @brief SIMD-vectorized transcendental kernels for batch pricing
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * Array versions of exp, log, sqrt and the standard normal PDF/CDF used by
+ * OptionPricer::price_batch(). Each kernel is compiled for several
+ * instruction sets (AVX-512, AVX2+FMA, NEON and a portable scalar fallback)
+ * and the widest one supported by the running CPU is selected at first use,
+ * so release binaries do not need to be built with -march=native.
+ *
+ * All instruction sets run the same algorithm, so results agree to within
+ * FMA contraction (the scalar fallback does not fuse its polynomial steps).
+ * Maximum error against a quad-precision reference, measured on 10^6
+ * random points per domain:
+ *
+ * | Kernel     | Domain                 | Max error |
+ * |------------|------------------------|-----------|
+ * | exp        | [-745.13, 709.78]      | 1.2 ULP   |
+ * | log        | (0, +inf)              | 1 ULP     |
+ * | sqrt       | [0, +inf)              | 0.5 ULP (correctly rounded) |
+ * | normal_pdf | [-38, 38]              | 3 ULP     |
+ * | normal_cdf | [-37.5, +inf)          | 5 ULP     |
+ * | normal_inv_cdf | [1e-20, 1)         | 1.7·ε·max(|x|, 1) |
+ *
+ * Outside these domains the kernels follow IEEE conventions: exp underflows
+ * gradually to 0 and overflows to +inf, log(0) = -inf, log(x < 0) = NaN, the
+ * normal CDF returns 0 below -38.5, and NaN inputs propagate. The inverse
+ * CDF loses accuracy gradually below p = 1e-20 (relative 4e-6 at 1e-300).
+ */
+
+namespace BlackScholes {
+namespace VectorMath {
+
+/**
+ * @brief Instruction set used by the vector kernels
+ */
+enum class SimdLevel {
+    SCALAR = 0,     ///< Portable scalar fallback
+    NEON = 1,       ///< ARMv8 Advanced SIMD (2 doubles per register)
+    AVX2 = 2,       ///< x86 AVX2 + FMA (4 doubles per register)
+    AVX512 = 3      ///< x86 AVX-512F (8 doubles per register)
+};
+
+/**
+ * @brief Convert SIMD level to string representation
+ * @param level SIMD level to convert
+ * @return String representation of SIMD level
+ */
+const char* to_string(SimdLevel level) noexcept;
+
+/**
+ * @brief Detect the widest instruction set supported by this CPU and build
+ * @return Best available SIMD level
+ */
+SimdLevel detect_simd_level() noexcept;
+
+/**
+ * @brief Get the instruction set currently used by the kernels
+ * @return Active SIMD level (detected on first use unless overridden)
+ */
+SimdLevel active_simd_level() noexcept;
+
+/**
+ * @brief Override the instruction set used by the kernels
+ *
+ * Intended for benchmarks and tests. Levels not supported by the CPU are
+ * clamped to the detected level.
+ *
+ * @param level Requested SIMD level
+ * @return SIMD level actually selected
+ */
+SimdLevel set_simd_level(SimdLevel level) noexcept;
+
+/**
+ * @brief out[i] = e^x[i]
+ * @param x Input array
+ * @param out Output array (may alias x)
+ * @param n Number of elements
+ */
+void exp(const double* x, double* out, size_t n) noexcept;
+
+/**
+ * @brief out[i] = ln(x[i])
+ * @param x Input array
+ * @param out Output array (may alias x)
+ * @param n Number of elements
+ */
+void log(const double* x, double* out, size_t n) noexcept;
+
+/**
+ * @brief out[i] = √x[i]
+ * @param x Input array
+ * @param out Output array (may alias x)
+ * @param n Number of elements
+ */
+void sqrt(const double* x, double* out, size_t n) noexcept;
+
+/**
+ * @brief out[i] = φ(x[i]), the standard normal density
+ * @param x Input array
+ * @param out Output array (may alias x)
+ * @param n Number of elements
+ */
+void normal_pdf(const double* x, double* out, size_t n) noexcept;
+
+/**
+ * @brief out[i] = N(x[i]), the standard normal cumulative distribution
+ * @param x Input array
+ * @param out Output array (may alias x)
+ * @param n Number of elements
+ */
+void normal_cdf(const double* x, double* out, size_t n) noexcept;
+
+/**
+ * @brief out[i] = N⁻¹(p[i]), the inverse standard normal distribution
+ * 
+ * Same refined Beasley-Springer-Moro approximation as
+ * MathUtils::normal_inv_cdf(), evaluated without branches. Returns -∞/+∞
+ * for p = 0/1 and NaN outside [0, 1] instead of throwing.
+ * 
+ * @param p Probabilities
+ * @param out Output array (may alias p)
+ * @param n Number of elements
+ */
+void normal_inv_cdf(const double* p, double* out, size_t n) noexcept;
+
+} // namespace VectorMath
+} // namespace BlackScholes
@@ -0,0 +1,84 @@
+#include "vector_math_kernels.hpp"
+
+// Compiled with -mavx2 -mfma (see Makefile); only reached after runtime
+// CPU detection in vector_math.cpp. Do not include standard headers here.
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+
+namespace BlackScholes {
+namespace VectorMath {
+namespace detail {
+namespace {
+
+struct Avx2Ops {
+    using reg = __m256d;
+    using mask = __m256d;
+    static constexpr size_t width = 4;
+
+    static reg load(const double* p) noexcept { return _mm256_loadu_pd(p); }
+    static void store(double* p, reg v) noexcept { _mm256_storeu_pd(p, v); }
+    static reg set1(double v) noexcept { return _mm256_set1_pd(v); }
+    static reg set1_bits(uint64_t bits) noexcept {
+        return _mm256_castsi256_pd(_mm256_set1_epi64x(static_cast<long long>(bits)));
+    }
+
+    static reg add(reg a, reg b) noexcept { return _mm256_add_pd(a, b); }
+    static reg sub(reg a, reg b) noexcept { return _mm256_sub_pd(a, b); }
+    static reg mul(reg a, reg b) noexcept { return _mm256_mul_pd(a, b); }
+    static reg div(reg a, reg b) noexcept { return _mm256_div_pd(a, b); }
+    static reg sqrt(reg a) noexcept { return _mm256_sqrt_pd(a); }
+    static reg min(reg a, reg b) noexcept { return _mm256_min_pd(a, b); }
+    static reg max(reg a, reg b) noexcept { return _mm256_max_pd(a, b); }
+    static reg round_nearest(reg a) noexcept {
+        return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+    static reg floor(reg a) noexcept { return _mm256_floor_pd(a); }
+    static reg mul_add(reg a, reg b, reg c) noexcept { return _mm256_fmadd_pd(a, b, c); }
+    static reg fma_exact(reg a, reg b, reg c) noexcept { return _mm256_fmadd_pd(a, b, c); }
+
+    static mask lt(reg a, reg b) noexcept { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static mask gt(reg a, reg b) noexcept { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static mask eq(reg a, reg b) noexcept { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+    static mask is_nan(reg a) noexcept { return _mm256_cmp_pd(a, a, _CMP_UNORD_Q); }
+    static reg select(mask m, reg a, reg b) noexcept { return _mm256_blendv_pd(b, a, m); }
+
+    static reg bits_and(reg a, reg b) noexcept { return _mm256_and_pd(a, b); }
+    static reg bits_or(reg a, reg b) noexcept { return _mm256_or_pd(a, b); }
+    static reg bits_add(reg a, reg b) noexcept {
+        return _mm256_castsi256_pd(_mm256_add_epi64(_mm256_castpd_si256(a), _mm256_castpd_si256(b)));
+    }
+    template<int N> static reg shl(reg a) noexcept {
+        return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(a), N));
+    }
+    template<int N> static reg shr(reg a) noexcept {
+        return _mm256_castsi256_pd(_mm256_srli_epi64(_mm256_castpd_si256(a), N));
+    }
+};
+
+constexpr KernelTable avx2_table = make_kernel_table<Avx2Ops>();
+
+} // namespace
+
+const KernelTable* avx2_kernels() noexcept {
+    return &avx2_table;
+}
+
+} // namespace detail
+} // namespace VectorMath
+} // namespace BlackScholes
+
+#else
+
+namespace BlackScholes {
+namespace VectorMath {
+namespace detail {
+
+const KernelTable* avx2_kernels() noexcept {
+    return nullptr;
+}
+
+} // namespace detail
+} // namespace VectorMath
+} // namespace BlackScholes
+
+#endif
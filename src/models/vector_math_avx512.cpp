@@ -0,0 +1,95 @@
+#include "vector_math_kernels.hpp"
+
+// Compiled with -mavx512f -mfma (see Makefile); only reached after runtime
+// CPU detection in vector_math.cpp. Do not include standard headers here.
+#if defined(__AVX512F__)
+#include <immintrin.h>
+
+namespace BlackScholes {
+namespace VectorMath {
+namespace detail {
+namespace {
+
+struct Avx512Ops {
+    using reg = __m512d;
+    using mask = __mmask8;
+    static constexpr size_t width = 8;
+
+    // GCC's unmasked forms of these intrinsics pass an _mm512_undefined_*()
+    // source, which -flto reports as -Wmaybe-uninitialized; the zero-masked
+    // forms with every lane selected compile to the same instructions
+    static constexpr mask all = 0xFF;
+
+    static reg load(const double* p) noexcept { return _mm512_loadu_pd(p); }
+    static void store(double* p, reg v) noexcept { _mm512_storeu_pd(p, v); }
+    static reg set1(double v) noexcept { return _mm512_set1_pd(v); }
+    static reg set1_bits(uint64_t bits) noexcept {
+        return _mm512_castsi512_pd(_mm512_set1_epi64(static_cast<long long>(bits)));
+    }
+
+    static reg add(reg a, reg b) noexcept { return _mm512_add_pd(a, b); }
+    static reg sub(reg a, reg b) noexcept { return _mm512_sub_pd(a, b); }
+    static reg mul(reg a, reg b) noexcept { return _mm512_mul_pd(a, b); }
+    static reg div(reg a, reg b) noexcept { return _mm512_div_pd(a, b); }
+    static reg sqrt(reg a) noexcept { return _mm512_maskz_sqrt_pd(all, a); }
+    static reg min(reg a, reg b) noexcept { return _mm512_maskz_min_pd(all, a, b); }
+    static reg max(reg a, reg b) noexcept { return _mm512_maskz_max_pd(all, a, b); }
+    static reg round_nearest(reg a) noexcept {
+        return _mm512_maskz_roundscale_pd(all, a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+    static reg floor(reg a) noexcept {
+        return _mm512_maskz_roundscale_pd(all, a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    }
+    static reg mul_add(reg a, reg b, reg c) noexcept { return _mm512_fmadd_pd(a, b, c); }
+    static reg fma_exact(reg a, reg b, reg c) noexcept { return _mm512_fmadd_pd(a, b, c); }
+
+    static mask lt(reg a, reg b) noexcept { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    static mask gt(reg a, reg b) noexcept { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+    static mask eq(reg a, reg b) noexcept { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+    static mask is_nan(reg a) noexcept { return _mm512_cmp_pd_mask(a, a, _CMP_UNORD_Q); }
+    static reg select(mask m, reg a, reg b) noexcept { return _mm512_mask_blend_pd(m, b, a); }
+
+    static reg bits_and(reg a, reg b) noexcept {
+        return _mm512_castsi512_pd(_mm512_and_si512(_mm512_castpd_si512(a), _mm512_castpd_si512(b)));
+    }
+    static reg bits_or(reg a, reg b) noexcept {
+        return _mm512_castsi512_pd(_mm512_or_si512(_mm512_castpd_si512(a), _mm512_castpd_si512(b)));
+    }
+    static reg bits_add(reg a, reg b) noexcept {
+        return _mm512_castsi512_pd(_mm512_add_epi64(_mm512_castpd_si512(a), _mm512_castpd_si512(b)));
+    }
+    template<int N> static reg shl(reg a) noexcept {
+        return _mm512_castsi512_pd(_mm512_maskz_slli_epi64(all, _mm512_castpd_si512(a), N));
+    }
+    template<int N> static reg shr(reg a) noexcept {
+        return _mm512_castsi512_pd(_mm512_maskz_srli_epi64(all, _mm512_castpd_si512(a), N));
+    }
+};
+
+constexpr KernelTable avx512_table = make_kernel_table<Avx512Ops>();
+
+} // namespace
+
+const KernelTable* avx512_kernels() noexcept {
+    return &avx512_table;
+}
+
+} // namespace detail
+} // namespace VectorMath
+} // namespace BlackScholes
+
+#else
+
+namespace BlackScholes {
+namespace VectorMath {
+namespace detail {
+
+const KernelTable* avx512_kernels() noexcept {
+    return nullptr;
+}
+
+} // namespace detail
+} // namespace VectorMath
+} // namespace BlackScholes
+
+#endif
@@ -0,0 +1,352 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file vector_math_kernels.hpp
+ * @brief Instruction-set independent bodies of the VectorMath kernels
+ *
+ * Internal header, included only by vector_math.cpp and the per-ISA
+ * translation units (vector_math_avx2.cpp, ...). Each includer provides an
+ * "ops" struct wrapping its intrinsics:
+ *
+ * - `reg` / `mask` register types and `width` (doubles per register)
+ * - load, store, set1, set1_bits
+ * - add, sub, mul, div, sqrt, min, max, round_nearest, floor
+ * - mul_add (may be unfused), fma_exact (must be a true fused multiply-add)
+ * - lt, gt, eq, is_nan, select(mask, if_true, if_false)
+ * - bits_and, bits_or, bits_add (64-bit integer lanes), shl<N>, shr<N>
+ *
+ * The templates below live in an anonymous namespace on purpose: every ISA
+ * translation unit is compiled with different -m flags, and internal linkage
+ * keeps the linker from merging an AVX instantiation into generic code.
+ * For the same reason, includers must not rely on other inline functions
+ * from standard headers inside the kernels.
+ */
+
+namespace BlackScholes {
+namespace VectorMath {
+namespace detail {
+
+/**
+ * @brief Function table implemented once per instruction set
+ */
+struct KernelTable {
+    void (*exp)(const double* x, double* out, size_t n) noexcept;
+    void (*log)(const double* x, double* out, size_t n) noexcept;
+    void (*sqrt)(const double* x, double* out, size_t n) noexcept;
+    void (*normal_pdf)(const double* x, double* out, size_t n) noexcept;
+    void (*normal_cdf)(const double* x, double* out, size_t n) noexcept;
+    void (*normal_inv_cdf)(const double* x, double* out, size_t n) noexcept;
+};
+
+// Kernel tables; a null return means the ISA was not compiled into this build
+const KernelTable* scalar_kernels() noexcept;
+const KernelTable* neon_kernels() noexcept;
+const KernelTable* avx2_kernels() noexcept;
+const KernelTable* avx512_kernels() noexcept;
+
+namespace {
+
+namespace constants {
+    constexpr double LOG2E = 1.44269504088896338700e+00;
+    constexpr double LN2_HI = 6.93147180369123816490e-01;   // 0x3fe62e42fee00000
+    constexpr double LN2_LO = 1.90821492927058770002e-10;   // ln(2) - LN2_HI
+    constexpr double EXP_MAX = 709.782712893383973096;      // ln(DBL_MAX)
+    constexpr double EXP_MIN = -745.133219101941108420;     // ln(smallest subnormal)
+    constexpr double SQRT2 = 1.41421356237309504880;
+    constexpr double SQRT1_2 = 0.70710678118654752440;
+    constexpr double INV_SQRT_2PI = 0.39894228040143267794;
+    constexpr double SQRT_2PI = 2.50662827463100050242;
+    constexpr double DBL_MIN_NORMAL = 2.2250738585072014e-308;
+    constexpr double TWO_POW_54 = 18014398509481984.0;
+    constexpr double TWO_POW_52 = 4503599627370496.0;
+    constexpr double ROUND_MAGIC = 6755399441055744.0;       // 1.5 * 2^52
+    constexpr uint64_t ROUND_MAGIC_BITS = 0x4338000000000000ull;
+    constexpr uint64_t TWO_POW_52_BITS = 0x4330000000000000ull;
+    constexpr uint64_t ONE_BITS = 0x3ff0000000000000ull;
+    constexpr uint64_t MANTISSA_MASK = 0x000fffffffffffffull;
+    constexpr uint64_t ABS_MASK = 0x7fffffffffffffffull;
+    constexpr uint64_t SIGN_MASK = 0x8000000000000000ull;
+    constexpr uint64_t INF_BITS = 0x7ff0000000000000ull;
+    constexpr uint64_t NAN_BITS = 0x7ff8000000000000ull;
+    constexpr uint64_t NEG_INF_BITS = 0xfff0000000000000ull;
+    
+    // Taylor coefficients 1/k! for e^r on |r| <= ln(2)/2, highest degree first
+    constexpr double EXP_POLY[] = {
+        1.0 / 6227020800.0, 1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0,
+        1.0 / 362880.0, 1.0 / 40320.0, 1.0 / 5040.0, 1.0 / 720.0, 1.0 / 120.0,
+        1.0 / 24.0, 1.0 / 6.0, 0.5, 1.0, 1.0
+    };
+    
+    // log(1+f) = f - f²/2 + s·(f²/2 + R(s²)) with s = f/(2+f), R(z) = Σ 2z^k/(2k+1)
+    constexpr double LOG_POLY[] = {
+        2.0 / 21.0, 2.0 / 19.0, 2.0 / 17.0, 2.0 / 15.0, 2.0 / 13.0,
+        2.0 / 11.0, 2.0 / 9.0, 2.0 / 7.0, 2.0 / 5.0, 2.0 / 3.0
+    };
+    
+    // Chebyshev expansion of (1 + 2t)·erfcx(t) in y = (t - 3)/(t + 3), t >= 0.
+    // Computed in quad precision; the leading coefficient is pre-halved.
+    constexpr double ERFCX_K = 3.0;
+    constexpr double ERFCX_CHEB[] = {
+        1.17756257419656007e+00,  5.35390453961567677e-03, -9.37755034228420905e-02,
+        5.43665255574432205e-02, -1.89765967078452074e-02,  4.45342606146271157e-03,
+       -6.33553171055314694e-04,  1.76617195231715918e-05,  1.28415328640566707e-05,
+       -2.00722856590599145e-06, -1.80752279041483712e-07,  7.54982834382509302e-08,
+        1.88566852383860821e-09, -2.69951904979835618e-09, -1.46007911993823878e-11,
+        1.03616074459702686e-10,  1.47571597662884808e-12, -4.27734006439500675e-12,
+       -2.07922492861731082e-13,  1.81345020026398872e-13,  1.97342557377167710e-14,
+       -7.28794374613961459e-15, -1.51698787668616817e-15,  2.35141117325798715e-16,
+        1.00061115091960205e-16, -2.05725086035819310e-18, -5.60860288609855810e-18
+    };
+    constexpr size_t ERFCX_TERMS = sizeof(ERFCX_CHEB) / sizeof(ERFCX_CHEB[0]);
+    
+    // N(x) - 1/2 = x·Σ a_k x^(2k), a_k = (-1)^k / (2^k k! (2k+1) √(2π)), highest degree first.
+    // Used for |x| < 1, where 1/2 - tail would lose bits to cancellation.
+    constexpr double CDF_SERIES_LIMIT = 1.0;
+    constexpr double CDF_SERIES[] = {
+        8.81650791103284301e-21, -3.00330075937118781e-19, 9.63127484901794712e-18,
+        -2.89651673237132336e-16, 8.13341898449867599e-15, -2.12176147421704591e-13,
+        5.11243479025631062e-12, -1.13011716416192129e-10, 2.27352982437280637e-09,
+        -4.12266741486268888e-08, 6.65969351631665127e-07, -9.44465625950361453e-06,
+        1.15434687616155289e-04, -1.18732821548045440e-03, 9.97355701003581695e-03,
+        -6.64903800669054463e-02, 3.98942280401432678e-01
+    };
+    
+    // Beasley-Springer-Moro inverse normal, highest degree first: central region
+    // x·A(x²)/B(x²) for |p - 1/2| < 0.42, tail C(ln(-ln q)) with q = min(p, 1 - p)
+    constexpr double INV_CDF_CENTRAL_LIMIT = 0.42;
+    constexpr double INV_CDF_A[] = {
+        -25.44106049637, 41.39119773534, -18.61500062529, 2.50662823884
+    };
+    constexpr double INV_CDF_B[] = {
+        3.13082909833, -21.06224101826, 23.08336743743, -8.47351093090, 1.0
+    };
+    constexpr double INV_CDF_C[] = {
+        0.0000003960315187, 0.0000002888167364, 0.0000321767881768, 0.0003951896511919,
+        0.0038405729373609, 0.0276438810333863, 0.1607979714918209, 0.9761690190917186,
+        0.3374754822726147
+    };
+} // namespace constants
+
+// 2^n for integral n in [-1022, 1023], built directly in the exponent field
+template<class V>
+inline typename V::reg pow2_kernel(typename V::reg n) noexcept {
+    using namespace constants;
+    const typename V::reg biased = V::bits_add(V::add(n, V::set1(ROUND_MAGIC)),
+                                               V::set1_bits(1023 - ROUND_MAGIC_BITS));
+    return V::template shl<52>(biased);
+}
+
+template<class V>
+inline typename V::reg exp_kernel(typename V::reg x) noexcept {
+    using namespace constants;
+    using reg = typename V::reg;
+    
+    const reg xc = V::min(V::max(x, V::set1(EXP_MIN)), V::set1(EXP_MAX));
+    
+    // x = n·ln2 + r with |r| <= ln2/2
+    const reg n = V::round_nearest(V::mul(xc, V::set1(LOG2E)));
+    reg r = V::fma_exact(n, V::set1(-LN2_HI), xc);
+    r = V::fma_exact(n, V::set1(-LN2_LO), r);
+    
+    reg p = V::set1(EXP_POLY[0]);
+    for (size_t k = 1; k < sizeof(EXP_POLY) / sizeof(EXP_POLY[0]); ++k) {
+        p = V::mul_add(p, r, V::set1(EXP_POLY[k]));
+    }
+    
+    // Scale by 2^n in two halves so neither factor leaves the normal range;
+    // this yields gradual underflow down to the smallest subnormal
+    const reg n1 = V::floor(V::mul(n, V::set1(0.5)));
+    const reg n2 = V::sub(n, n1);
+    reg result = V::mul(V::mul(p, pow2_kernel<V>(n1)), pow2_kernel<V>(n2));
+    
+    result = V::select(V::gt(x, V::set1(EXP_MAX)), V::set1_bits(INF_BITS), result);
+    result = V::select(V::lt(x, V::set1(EXP_MIN)), V::set1(0.0), result);
+    return V::select(V::is_nan(x), x, result);
+}
+
+template<class V>
+inline typename V::reg log_kernel(typename V::reg x) noexcept {
+    using namespace constants;
+    using reg = typename V::reg;
+    
+    // Bring subnormals into the normal range before splitting the exponent
+    const typename V::mask tiny = V::lt(x, V::set1(DBL_MIN_NORMAL));
+    const reg xs = V::select(tiny, V::mul(x, V::set1(TWO_POW_54)), x);
+    const reg bias = V::select(tiny, V::set1(1023.0 + 54.0), V::set1(1023.0));
+    
+    // x = m·2^e with m in [√½, √2)
+    const reg biased_exp = V::sub(V::bits_or(V::template shr<52>(xs), V::set1_bits(TWO_POW_52_BITS)),
+                                  V::set1(TWO_POW_52));
+    reg m = V::bits_or(V::bits_and(xs, V::set1_bits(MANTISSA_MASK)), V::set1_bits(ONE_BITS));
+    const typename V::mask above = V::gt(m, V::set1(SQRT2));
+    m = V::select(above, V::mul(m, V::set1(0.5)), m);
+    const reg e = V::add(V::sub(biased_exp, bias), V::select(above, V::set1(1.0), V::set1(0.0)));
+    
+    const reg f = V::sub(m, V::set1(1.0));
+    const reg s = V::div(f, V::add(f, V::set1(2.0)));
+    const reg z = V::mul(s, s);
+    const reg hfsq = V::mul(V::mul(f, f), V::set1(0.5));
+    
+    reg R = V::set1(LOG_POLY[0]);
+    for (size_t k = 1; k < sizeof(LOG_POLY) / sizeof(LOG_POLY[0]); ++k) {
+        R = V::mul_add(R, z, V::set1(LOG_POLY[k]));
+    }
+    R = V::mul(R, z);
+    
+    // e·ln2_hi - ((hfsq - (s·(hfsq + R) + e·ln2_lo)) - f), as in fdlibm
+    const reg tail = V::mul_add(e, V::set1(LN2_LO), V::mul(s, V::add(hfsq, R)));
+    reg result = V::sub(V::mul(e, V::set1(LN2_HI)), V::sub(V::sub(hfsq, tail), f));
+    
+    result = V::select(V::gt(x, V::set1(1.7976931348623157e308)), x, result);
+    result = V::select(V::lt(x, V::set1(0.0)), V::set1_bits(NAN_BITS), result);
+    result = V::select(V::eq(x, V::set1(0.0)), V::set1_bits(NEG_INF_BITS), result);
+    return V::select(V::is_nan(x), x, result);
+}
+
+// e^(-x²/2) using an exact split of x² so the tail keeps full relative accuracy
+template<class V>
+inline typename V::reg gaussian_kernel(typename V::reg x) noexcept {
+    using reg = typename V::reg;
+    const reg hi = V::mul(x, x);
+    const reg lo = V::fma_exact(x, x, V::sub(V::set1(0.0), hi));
+    const reg e = exp_kernel<V>(V::mul(hi, V::set1(-0.5)));
+    return V::mul_add(V::mul(e, V::set1(-0.5)), lo, e);
+}
+
+template<class V>
+inline typename V::reg normal_pdf_kernel(typename V::reg x) noexcept {
+    using namespace constants;
+    const typename V::reg ax = V::bits_and(x, V::set1_bits(ABS_MASK));
+    const typename V::reg result = V::mul(gaussian_kernel<V>(x), V::set1(INV_SQRT_2PI));
+    return V::select(V::gt(ax, V::set1(40.0)), V::set1(0.0), result);
+}
+
+template<class V>
+inline typename V::reg normal_cdf_kernel(typename V::reg x) noexcept {
+    using namespace constants;
+    using reg = typename V::reg;
+    
+    // erfc(t) = e^(-t²)·erfcx(t) with t = |x|/√2, so N(-|x|) = ½·e^(-x²/2)·erfcx(t)
+    const reg ax = V::bits_and(x, V::set1_bits(ABS_MASK));
+    const reg t = V::mul(ax, V::set1(SQRT1_2));
+    const reg y = V::div(V::sub(t, V::set1(ERFCX_K)), V::add(t, V::set1(ERFCX_K)));
+    
+    // Clenshaw recurrence for Σ c_k T_k(y)
+    const reg y2 = V::add(y, y);
+    reg b1 = V::set1(0.0);
+    reg b2 = V::set1(0.0);
+    for (size_t k = ERFCX_TERMS - 1; k >= 1; --k) {
+        const reg b0 = V::mul_add(y2, b1, V::sub(V::set1(ERFCX_CHEB[k]), b2));
+        b2 = b1;
+        b1 = b0;
+    }
+    const reg cheb = V::mul_add(y, b1, V::sub(V::set1(ERFCX_CHEB[0]), b2));
+    const reg erfcx = V::div(cheb, V::mul_add(t, V::set1(2.0), V::set1(1.0)));
+    
+    const reg lower_tail = V::mul(V::mul(gaussian_kernel<V>(x), erfcx), V::set1(0.5));
+    reg result = V::select(V::lt(x, V::set1(0.0)), lower_tail, V::sub(V::set1(1.0), lower_tail));
+    
+    const reg x2 = V::mul(x, x);
+    reg series = V::set1(CDF_SERIES[0]);
+    for (size_t k = 1; k < sizeof(CDF_SERIES) / sizeof(CDF_SERIES[0]); ++k) {
+        series = V::mul_add(series, x2, V::set1(CDF_SERIES[k]));
+    }
+    const reg central = V::mul_add(x, series, V::set1(0.5));
+    result = V::select(V::lt(ax, V::set1(CDF_SERIES_LIMIT)), central, result);
+    
+    result = V::select(V::lt(x, V::set1(-38.5)), V::set1(0.0), result);
+    result = V::select(V::gt(x, V::set1(38.5)), V::set1(1.0), result);
+    return V::select(V::is_nan(x), x, result);
+}
+
+// Moro's approximation (absolute error ~3e-9 for q > 1e-12) followed by one
+// Halley step on N(a) = q in the lower tail, a = -|x|, so the residual never
+// cancels. Below q = 1e-20 Moro's start drifts and one step is no longer exact.
+template<class V>
+inline typename V::reg normal_inv_cdf_kernel(typename V::reg p) noexcept {
+    using namespace constants;
+    using reg = typename V::reg;
+    
+    const reg x = V::sub(p, V::set1(0.5));
+    const reg r = V::mul(x, x);
+    reg num = V::set1(INV_CDF_A[0]);
+    for (size_t k = 1; k < sizeof(INV_CDF_A) / sizeof(INV_CDF_A[0]); ++k) {
+        num = V::mul_add(num, r, V::set1(INV_CDF_A[k]));
+    }
+    reg den = V::set1(INV_CDF_B[0]);
+    for (size_t k = 1; k < sizeof(INV_CDF_B) / sizeof(INV_CDF_B[0]); ++k) {
+        den = V::mul_add(den, r, V::set1(INV_CDF_B[k]));
+    }
+    const reg central = V::div(V::mul(x, num), den);
+    
+    // Evaluated for every lane; central lanes have q in (0.08, 0.5] and stay finite
+    const typename V::mask upper = V::gt(x, V::set1(0.0));
+    const reg q = V::select(upper, V::sub(V::set1(1.0), p), p);
+    const reg t = log_kernel<V>(V::sub(V::set1(0.0), log_kernel<V>(q)));
+    reg tail = V::set1(INV_CDF_C[0]);
+    for (size_t k = 1; k < sizeof(INV_CDF_C) / sizeof(INV_CDF_C[0]); ++k) {
+        tail = V::mul_add(tail, t, V::set1(INV_CDF_C[k]));
+    }
+    
+    const reg ax = V::bits_and(x, V::set1_bits(ABS_MASK));
+    const reg estimate = V::select(V::lt(ax, V::set1(INV_CDF_CENTRAL_LIMIT)), central, tail);
+    const reg a = V::bits_or(V::bits_and(estimate, V::set1_bits(ABS_MASK)), V::set1_bits(SIGN_MASK));
+    
+    // u = (N(a) - q)/φ(a), a' = a - u/(1 + a·u/2); skipped where φ(a) nears underflow
+    const reg u = V::div(V::mul(V::sub(normal_cdf_kernel<V>(a), q), V::set1(SQRT_2PI)), gaussian_kernel<V>(a));
+    const reg refined = V::sub(a, V::div(u, V::mul_add(V::mul(a, u), V::set1(0.5), V::set1(1.0))));
+    const reg lower = V::select(V::lt(q, V::set1(DBL_MIN_NORMAL)), a, refined);
+    reg result = V::select(upper, V::sub(V::set1(0.0), lower), lower);
+    
+    result = V::select(V::eq(p, V::set1(0.0)), V::set1_bits(NEG_INF_BITS), result);
+    result = V::select(V::eq(p, V::set1(1.0)), V::set1_bits(INF_BITS), result);
+    result = V::select(V::lt(p, V::set1(0.0)), V::set1_bits(NAN_BITS), result);
+    result = V::select(V::gt(p, V::set1(1.0)), V::set1_bits(NAN_BITS), result);
+    return V::select(V::is_nan(p), p, result);
+}
+
+template<class V>
+inline typename V::reg sqrt_kernel(typename V::reg x) noexcept {
+    return V::sqrt(x);
+}
+
+// Apply a register kernel over an array, padding the tail to a full register
+template<class V, typename V::reg (*Kernel)(typename V::reg) noexcept>
+void apply_kernel(const double* x, double* out, size_t n) noexcept {
+    size_t i = 0;
+    for (; i + V::width <= n; i += V::width) {
+        V::store(out + i, Kernel(V::load(x + i)));
+    }
+    
+    if (i < n) {
+        double buffer[V::width];
+        for (size_t j = 0; j < V::width; ++j) {
+            buffer[j] = (i + j < n) ? x[i + j] : 1.0;
+        }
+        V::store(buffer, Kernel(V::load(buffer)));
+        for (size_t j = 0; i + j < n; ++j) {
+            out[i + j] = buffer[j];
+        }
+    }
+}
+
+template<class V>
+constexpr KernelTable make_kernel_table() noexcept {
+    return KernelTable{
+        &apply_kernel<V, &exp_kernel<V>>,
+        &apply_kernel<V, &log_kernel<V>>,
+        &apply_kernel<V, &sqrt_kernel<V>>,
+        &apply_kernel<V, &normal_pdf_kernel<V>>,
+        &apply_kernel<V, &normal_cdf_kernel<V>>,
+        &apply_kernel<V, &normal_inv_cdf_kernel<V>>
+    };
+}
+
+} // namespace
+
+} // namespace detail
+} // namespace VectorMath
+} // namespace BlackScholes
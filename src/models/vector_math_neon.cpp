@@ -0,0 +1,84 @@
+#include "vector_math_kernels.hpp"
+
+// Advanced SIMD is mandatory on AArch64, so no extra compiler flags are
+// needed; the file compiles to a null table on other architectures.
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+
+namespace BlackScholes {
+namespace VectorMath {
+namespace detail {
+namespace {
+
+struct NeonOps {
+    using reg = float64x2_t;
+    using mask = uint64x2_t;
+    static constexpr size_t width = 2;
+
+    static reg load(const double* p) noexcept { return vld1q_f64(p); }
+    static void store(double* p, reg v) noexcept { vst1q_f64(p, v); }
+    static reg set1(double v) noexcept { return vdupq_n_f64(v); }
+    static reg set1_bits(uint64_t bits) noexcept { return vreinterpretq_f64_u64(vdupq_n_u64(bits)); }
+
+    static reg add(reg a, reg b) noexcept { return vaddq_f64(a, b); }
+    static reg sub(reg a, reg b) noexcept { return vsubq_f64(a, b); }
+    static reg mul(reg a, reg b) noexcept { return vmulq_f64(a, b); }
+    static reg div(reg a, reg b) noexcept { return vdivq_f64(a, b); }
+    static reg sqrt(reg a) noexcept { return vsqrtq_f64(a); }
+    static reg min(reg a, reg b) noexcept { return vminq_f64(a, b); }
+    static reg max(reg a, reg b) noexcept { return vmaxq_f64(a, b); }
+    static reg round_nearest(reg a) noexcept { return vrndnq_f64(a); }
+    static reg floor(reg a) noexcept { return vrndmq_f64(a); }
+    static reg mul_add(reg a, reg b, reg c) noexcept { return vfmaq_f64(c, a, b); }
+    static reg fma_exact(reg a, reg b, reg c) noexcept { return vfmaq_f64(c, a, b); }
+
+    static mask lt(reg a, reg b) noexcept { return vcltq_f64(a, b); }
+    static mask gt(reg a, reg b) noexcept { return vcgtq_f64(a, b); }
+    static mask eq(reg a, reg b) noexcept { return vceqq_f64(a, b); }
+    static mask is_nan(reg a) noexcept { return veorq_u64(vceqq_f64(a, a), vdupq_n_u64(~0ull)); }
+    static reg select(mask m, reg a, reg b) noexcept { return vbslq_f64(m, a, b); }
+
+    static reg bits_and(reg a, reg b) noexcept {
+        return vreinterpretq_f64_u64(vandq_u64(vreinterpretq_u64_f64(a), vreinterpretq_u64_f64(b)));
+    }
+    static reg bits_or(reg a, reg b) noexcept {
+        return vreinterpretq_f64_u64(vorrq_u64(vreinterpretq_u64_f64(a), vreinterpretq_u64_f64(b)));
+    }
+    static reg bits_add(reg a, reg b) noexcept {
+        return vreinterpretq_f64_u64(vaddq_u64(vreinterpretq_u64_f64(a), vreinterpretq_u64_f64(b)));
+    }
+    template<int N> static reg shl(reg a) noexcept {
+        return vreinterpretq_f64_u64(vshlq_n_u64(vreinterpretq_u64_f64(a), N));
+    }
+    template<int N> static reg shr(reg a) noexcept {
+        return vreinterpretq_f64_u64(vshrq_n_u64(vreinterpretq_u64_f64(a), N));
+    }
+};
+
+constexpr KernelTable neon_table = make_kernel_table<NeonOps>();
+
+} // namespace
+
+const KernelTable* neon_kernels() noexcept {
+    return &neon_table;
+}
+
+} // namespace detail
+} // namespace VectorMath
+} // namespace BlackScholes
+
+#else
+
+namespace BlackScholes {
+namespace VectorMath {
+namespace detail {
+
+const KernelTable* neon_kernels() noexcept {
+    return nullptr;
+}
+
+} // namespace detail
+} // namespace VectorMath
+} // namespace BlackScholes
+
+#endif
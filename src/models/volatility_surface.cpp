@@ -0,0 +1,337 @@
+#include "volatility_surface.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace BlackScholes {
+
+namespace {
+
+void check_axis(const std::vector<double>& axis, size_t minimum, const char* name) {
+    if (axis.size() < minimum) {
+        throw std::invalid_argument(std::string("Volatility surface needs at least ") + std::to_string(minimum) +
+                                    " " + name);
+    }
+    for (size_t i = 0; i < axis.size(); ++i) {
+        if (!std::isfinite(axis[i]) || !(axis[i] > 0.0) || (i > 0 && !(axis[i] > axis[i - 1]))) {
+            throw std::invalid_argument(std::string("Volatility surface ") + name +
+                                        " must be positive, finite and strictly increasing");
+        }
+    }
+}
+
+// Converged quote with a usable strike, expiry and σ
+inline bool usable(const IVBatchInput& quotes, const IVBatchOutput& solved, size_t i) noexcept {
+    const double K = quotes.strike_price[i];
+    const double T = quotes.time_to_expiry[i];
+    const double vol = solved.implied_vol[i];
+    return (solved.failure == nullptr || solved.failure[i] == IVFailure::NONE) &&
+           std::isfinite(K) && K > 0.0 && std::isfinite(T) && T > 0.0 && std::isfinite(vol) && vol > 0.0;
+}
+
+} // namespace
+
+VolatilitySurface::VolatilitySurface(std::vector<double> strikes, std::vector<double> expiries)
+    : strikes_(std::move(strikes)), expiries_(std::move(expiries)) {
+    check_axis(strikes_, 2, "strikes");
+    check_axis(expiries_, 1, "expiries");
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    nodes_.assign(strikes_.size() * expiries_.size(), Node{nan, nan});
+    fitted_.assign(expiries_.size(), 0);
+    diagonal_.resize(strikes_.size());
+}
+
+VolatilitySurface VolatilitySurface::build(const IVBatchInput& quotes, const IVBatchOutput& solved,
+                                           size_t strike_nodes) {
+    std::vector<double> expiries;
+    double low = std::numeric_limits<double>::infinity();
+    double high = -std::numeric_limits<double>::infinity();
+    if (quotes.strike_price != nullptr && quotes.time_to_expiry != nullptr && solved.implied_vol != nullptr) {
+        for (size_t i = 0; i < quotes.count; ++i) {
+            if (usable(quotes, solved, i)) {
+                expiries.push_back(quotes.time_to_expiry[i]);
+                low = std::min(low, quotes.strike_price[i]);
+                high = std::max(high, quotes.strike_price[i]);
+            }
+        }
+    }
+    if (!(high > low)) {
+        throw std::invalid_argument("Volatility surface needs converged quotes at two or more strikes");
+    }
+    
+    // One slice per distinct expiry; expiries within the tolerance share a slice
+    std::sort(expiries.begin(), expiries.end());
+    size_t distinct = 0;
+    for (const double T : expiries) {
+        if (distinct == 0 || T - expiries[distinct - 1] > EXPIRY_TOLERANCE * expiries[distinct - 1]) {
+            expiries[distinct++] = T;
+        }
+    }
+    expiries.resize(distinct);
+    
+    const size_t nodes = std::max<size_t>(strike_nodes, 2);
+    std::vector<double> strikes(nodes);
+    for (size_t i = 0; i < nodes; ++i) {
+        strikes[i] = low + (high - low) * static_cast<double>(i) / static_cast<double>(nodes - 1);
+    }
+    strikes.back() = high;
+    
+    VolatilitySurface surface(std::move(strikes), std::move(expiries));
+    surface.update(quotes, solved);
+    return surface;
+}
+
+size_t VolatilitySurface::match_slice(double T) const noexcept {
+    const size_t upper = static_cast<size_t>(std::lower_bound(expiries_.begin(), expiries_.end(), T) -
+                                             expiries_.begin());
+    for (const size_t slice : {upper, upper - 1}) {
+        if (slice < expiries_.size() && std::abs(T - expiries_[slice]) <= EXPIRY_TOLERANCE * expiries_[slice]) {
+            return slice;
+        }
+    }
+    return expiries_.size();
+}
+
+size_t VolatilitySurface::update(const IVBatchInput& quotes, const IVBatchOutput& solved) {
+    if (quotes.strike_price == nullptr || quotes.time_to_expiry == nullptr || solved.implied_vol == nullptr) {
+        return 0;
+    }
+    
+    points_.clear();
+    for (size_t i = 0; i < quotes.count; ++i) {
+        if (!usable(quotes, solved, i)) {
+            continue;
+        }
+        const size_t slice = match_slice(quotes.time_to_expiry[i]);
+        if (slice < expiries_.size()) {
+            points_.push_back(Point{slice, quotes.strike_price[i], solved.implied_vol[i]});
+        }
+    }
+    std::sort(points_.begin(), points_.end(), [](const Point& a, const Point& b) {
+        return a.slice != b.slice ? a.slice < b.slice : a.strike < b.strike;
+    });
+    
+    size_t refit = 0;
+    for (size_t begin = 0; begin < points_.size();) {
+        const size_t slice = points_[begin].slice;
+        smile_.clear();
+        size_t end = begin;
+        for (; end < points_.size() && points_[end].slice == slice; ++end) {
+            smile_.emplace_back(points_[end].strike, points_[end].vol);
+        }
+        fit_smile(slice);
+        ++refit;
+        begin = end;
+    }
+    return refit;
+}
+
+bool VolatilitySurface::fit_slice(size_t slice, const double* strikes, const double* vols, size_t count) {
+    if (slice >= expiries_.size() || (count > 0 && (strikes == nullptr || vols == nullptr))) {
+        return false;
+    }
+    smile_.clear();
+    for (size_t i = 0; i < count; ++i) {
+        if (!std::isfinite(strikes[i]) || !(strikes[i] > 0.0) || !std::isfinite(vols[i]) || !(vols[i] > 0.0)) {
+            return false;
+        }
+        smile_.emplace_back(strikes[i], vols[i]);
+    }
+    
+    if (count == 0) {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        std::fill(nodes_.begin() + static_cast<std::ptrdiff_t>(slice * strikes_.size()),
+                  nodes_.begin() + static_cast<std::ptrdiff_t>((slice + 1) * strikes_.size()), Node{nan, nan});
+        fitted_[slice] = 0;
+        return true;
+    }
+    std::sort(smile_.begin(), smile_.end());
+    fit_smile(slice);
+    return true;
+}
+
+void VolatilitySurface::fit_smile(size_t slice) noexcept {
+    // Average quotes at equal strikes (a call and a put, say)
+    size_t distinct = 0;
+    for (size_t i = 0; i < smile_.size();) {
+        size_t j = i;
+        double sum = 0.0;
+        for (; j < smile_.size() && smile_[j].first == smile_[i].first; ++j) {
+            sum += smile_[j].second;
+        }
+        smile_[distinct++] = {smile_[i].first, sum / static_cast<double>(j - i)};
+        i = j;
+    }
+    smile_.resize(distinct);
+    
+    // σ at the nodes: linear between quoted strikes, flat beyond them
+    const size_t n = strikes_.size();
+    Node* const row = &nodes_[slice * n];
+    size_t quote = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const double K = strikes_[i];
+        while (quote + 1 < smile_.size() && smile_[quote + 1].first <= K) {
+            ++quote;
+        }
+        if (K <= smile_.front().first) {
+            row[i].vol = smile_.front().second;
+        } else if (quote + 1 >= smile_.size()) {
+            row[i].vol = smile_.back().second;
+        } else {
+            const auto& [K0, vol0] = smile_[quote];
+            const auto& [K1, vol1] = smile_[quote + 1];
+            row[i].vol = vol0 + (vol1 - vol0) * (K - K0) / (K1 - K0);
+        }
+    }
+    
+    // Natural cubic spline curvatures: tridiagonal system solved by the Thomas algorithm
+    row[0].curvature = 0.0;
+    row[n - 1].curvature = 0.0;
+    for (size_t i = 1; i + 1 < n; ++i) {
+        const double h0 = strikes_[i] - strikes_[i - 1];
+        const double h1 = strikes_[i + 1] - strikes_[i];
+        double diagonal = 2.0 * (h0 + h1);
+        double rhs = 6.0 * ((row[i + 1].vol - row[i].vol) / h1 - (row[i].vol - row[i - 1].vol) / h0);
+        if (i > 1) {
+            const double factor = h0 / diagonal_[i - 1];
+            diagonal -= factor * h0;
+            rhs -= factor * row[i - 1].curvature;
+        }
+        diagonal_[i] = diagonal;
+        row[i].curvature = rhs;
+    }
+    for (size_t i = n - 2; i >= 1; --i) {
+        row[i].curvature = (row[i].curvature - (strikes_[i + 1] - strikes_[i]) * row[i + 1].curvature) / diagonal_[i];
+    }
+    
+    fitted_[slice] = 1;
+    ++refits_;
+}
+
+ExpiryWeights VolatilitySurface::expiry_weights(double T) const noexcept {
+    ExpiryWeights weights;
+    const size_t n = expiries_.size();
+    if (!(T > 0.0) || !std::isfinite(T)) {
+        return weights;
+    }
+    if (T <= expiries_.front() || T >= expiries_.back()) {
+        weights.first = T <= expiries_.front() ? 0 : n - 1;
+        weights.count = 1;
+        weights.weight[0] = 1.0;
+        return weights;
+    }
+    
+    // Bracket [T_j, T_j+1); Hermite basis in s = (T - T_j) / dt
+    const size_t j = static_cast<size_t>(std::upper_bound(expiries_.begin(), expiries_.end(), T) -
+                                         expiries_.begin()) - 1;
+    const double dt = expiries_[j + 1] - expiries_[j];
+    const double s = (T - expiries_[j]) / dt;
+    const double s2 = s * s;
+    const double s3 = s2 * s;
+    const double h00 = 2.0 * s3 - 3.0 * s2 + 1.0;
+    const double h10 = (s3 - 2.0 * s2 + s) * dt;
+    const double h01 = -2.0 * s3 + 3.0 * s2;
+    const double h11 = (s3 - s2) * dt;
+    
+    // Weights on the total variance of slices j-1 .. j+2
+    double c[4] = {0.0, h00, h01, 0.0};
+    
+    // Slope at a slice from its neighbours (exact for quadratics), or the secant at the ends
+    const auto slope = [&](size_t at, double basis) {
+        const size_t k = at - j + 1;      // Offset of `at` in c
+        const bool left = at > 0;
+        const bool right = at + 1 < n;
+        if (left && right) {
+            const double a = expiries_[at] - expiries_[at - 1];
+            const double b = expiries_[at + 1] - expiries_[at];
+            c[k - 1] -= basis * b / (a * (a + b));
+            c[k] += basis * (b / a - a / b) / (a + b);
+            c[k + 1] += basis * a / (b * (a + b));
+        } else {
+            c[1] -= basis / dt;
+            c[2] += basis / dt;
+        }
+    };
+    slope(j, h10);
+    slope(j + 1, h11);
+    
+    const size_t start = j == 0 ? 1 : 0;
+    const size_t end = j + 2 < n ? 4 : 3;
+    weights.first = j + start - 1;
+    weights.count = static_cast<uint8_t>(end - start);
+    weights.lower = static_cast<uint8_t>(1 - start);
+    weights.flat = false;
+    for (size_t k = start; k < end; ++k) {
+        weights.weight[k - start] = c[k];
+    }
+    return weights;
+}
+
+double VolatilitySurface::volatility(double K, double T, const ExpiryWeights& weights) const noexcept {
+    if (weights.count == 0 || !(K > 0.0)) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    
+    // Strike interval and spline coefficients, shared by every slice
+    const size_t n = strikes_.size();
+    const double strike = std::min(std::max(K, strikes_.front()), strikes_.back());
+    size_t i = static_cast<size_t>(std::upper_bound(strikes_.begin(), strikes_.end(), strike) - strikes_.begin());
+    i = std::min(std::max<size_t>(i, 1), n - 1) - 1;
+    const double h = strikes_[i + 1] - strikes_[i];
+    const double a = (strikes_[i + 1] - strike) / h;
+    const double b = 1.0 - a;
+    const double curvature_a = (a * a * a - a) * h * h / 6.0;
+    const double curvature_b = (b * b * b - b) * h * h / 6.0;
+    
+    const auto smile = [&](size_t slice) {
+        const Node* const node = &nodes_[slice * n + i];
+        const double vol = a * node[0].vol + b * node[1].vol + curvature_a * node[0].curvature +
+                           curvature_b * node[1].curvature;
+        return vol > 0.0 ? vol : (std::isnan(vol) ? vol : 0.0);
+    };
+    if (weights.flat) {
+        return smile(weights.first);
+    }
+    
+    double total = 0.0;
+    double bracket[2] = {0.0, 0.0};
+    for (size_t k = 0; k < weights.count; ++k) {
+        const size_t slice = weights.first + k;
+        const double vol = smile(slice);
+        const double variance = vol * vol * expiries_[slice];
+        total += weights.weight[k] * variance;
+        if (k == weights.lower || k == weights.lower + 1u) {
+            bracket[k - weights.lower] = variance;
+        }
+    }
+    
+    // Never overshoot the bracketing slices
+    const double low = std::min(bracket[0], bracket[1]);
+    const double high = std::max(bracket[0], bracket[1]);
+    total = total < low ? low : (total > high ? high : total);
+    return std::sqrt(total / T);
+}
+
+double VolatilitySurface::volatility(double K, double T) const noexcept {
+    return volatility(K, T, expiry_weights(T));
+}
+
+void VolatilitySurface::volatility(const double* K, const double* T, double* vols, size_t count) const noexcept {
+    if (count == 0) {
+        return;
+    }
+    double current = T[0];
+    ExpiryWeights weights = expiry_weights(current);
+    for (size_t i = 0; i < count; ++i) {
+        if (T[i] != current) {
+            current = T[i];
+            weights = expiry_weights(current);
+        }
+        vols[i] = volatility(K[i], current, weights);
+    }
+}
+
+} // namespace BlackScholes
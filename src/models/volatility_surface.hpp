@@ -0,0 +1,196 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "implied_volatility.hpp"
+
+/**
+ * @file volatility_surface.hpp
+ * @brief Interpolated implied volatility surface on a strike × expiry grid
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * VolatilitySurface turns solved implied volatilities into σ(K, T) for
+ * repricing. Every expiry slice holds σ at a common set of strike nodes,
+ * fitted from that expiry's quotes, and its natural cubic spline
+ * curvatures; the nodes of one slice are contiguous and interleaved with
+ * their curvatures, so a lookup reads two adjacent nodes from each of at
+ * most four slices. Interpolation is bicubic:
+ * - In strike, the slice's natural cubic spline.
+ * - In expiry, a cubic Hermite curve through the total variances σ²T of
+ *   the neighbouring slices, with three-point slopes, clamped to the two
+ *   bracketing slices so it never overshoots them.
+ *
+ * Strikes outside the grid take the nearest edge node and expiries
+ * outside it the nearest slice's σ (flat extrapolation). A slice is refit
+ * from its own quotes only, so a market update refits just the expiries
+ * whose quotes changed. Typical use:
+ *
+ *   ImpliedVolatilitySolver::solve_batch(quotes, solved);
+ *   VolatilitySurface surface = VolatilitySurface::build(quotes, solved);
+ *   OptionPricer::price_batch(input, surface, output);   // σ per row from the surface
+ *   ...
+ *   ImpliedVolatilitySolver::solve_batch(moved, moved_solved);
+ *   surface.update(moved, moved_solved);                 // refits the moved expiries only
+ *
+ * Lookups are const and thread-safe; fitting is not.
+ */
+
+namespace BlackScholes {
+
+/**
+ * @brief Interpolation weights over the slices for one expiry
+ */
+struct ExpiryWeights {
+    size_t first = 0;           ///< First slice used
+    uint8_t count = 0;          ///< Slices used (0 = no slice: σ is NaN)
+    uint8_t lower = 0;          ///< Offset from first of the slice at or before T
+    bool flat = true;           ///< Outside the expiry range: σ of slice `first`
+    double weight[4] = {};      ///< Weight of each used slice's total variance
+};
+
+/**
+ * @brief Implied volatility surface with bicubic interpolation
+ */
+class VolatilitySurface {
+public:
+    /// Relative distance within which a quote's expiry matches a slice
+    static constexpr double EXPIRY_TOLERANCE = 1e-6;
+    
+    /// Strike nodes chosen by build()
+    static constexpr size_t DEFAULT_STRIKE_NODES = 33;
+    
+    /**
+     * @brief Create an unfitted surface (σ is NaN until a slice is fitted)
+     * @param strikes Strike nodes, strictly increasing and positive (at least 2)
+     * @param expiries Slice expiries in years, strictly increasing and positive (at least 1)
+     * @throws std::invalid_argument if an axis is too short, unsorted or not positive
+     */
+    VolatilitySurface(std::vector<double> strikes, std::vector<double> expiries);
+    
+    /**
+     * @brief Fit a surface to solved quotes
+     *
+     * Slices are the distinct expiries of the converged quotes; strike nodes
+     * are spaced evenly across their strikes.
+     *
+     * @param quotes Quotes given to the solver (strike and expiry columns are read)
+     * @param solved Solver output (implied_vol required, failure optional)
+     * @param strike_nodes Number of strike nodes
+     * @throws std::invalid_argument if the converged quotes span fewer than two strikes
+     */
+    static VolatilitySurface build(const IVBatchInput& quotes, const IVBatchOutput& solved,
+                                   size_t strike_nodes = DEFAULT_STRIKE_NODES);
+    
+    /**
+     * @brief Refit the slices with quotes in a batch
+     *
+     * Each slice that has at least one converged quote in the batch is
+     * refit from those quotes alone, so pass every quote of a changed
+     * expiry; other slices keep their fit. Quotes that did not converge or
+     * whose expiry matches no slice are ignored.
+     *
+     * @param quotes Quotes given to the solver (strike and expiry columns are read)
+     * @param solved Solver output (implied_vol required, failure optional)
+     * @return Number of slices refit
+     */
+    size_t update(const IVBatchInput& quotes, const IVBatchOutput& solved);
+    
+    /**
+     * @brief Refit one slice from its smile
+     *
+     * σ at each strike node is interpolated linearly between the quoted
+     * strikes (flat beyond them); quotes at equal strikes are averaged.
+     *
+     * @param slice Index into expiries()
+     * @param strikes Quoted strikes (any order)
+     * @param vols Implied volatility per quote
+     * @param count Number of quotes; 0 clears the slice
+     * @return false if the slice index is out of range or a quote is not finite and positive
+     */
+    bool fit_slice(size_t slice, const double* strikes, const double* vols, size_t count);
+    
+    /**
+     * @brief Implied volatility at a strike and expiry
+     * @return σ(K, T), or NaN if K or T is not positive or a slice it needs is unfitted
+     */
+    double volatility(double K, double T) const noexcept;
+    
+    /**
+     * @brief Implied volatility for a batch of strikes and expiries
+     *
+     * Expiry weights are computed once per run of equal expiries, the
+     * layout of an option chain.
+     *
+     * @param K Strike per row
+     * @param T Expiry per row
+     * @param vols Output σ per row
+     * @param count Number of rows
+     */
+    void volatility(const double* K, const double* T, double* vols, size_t count) const noexcept;
+    
+    /**
+     * @brief Interpolation weights for an expiry
+     */
+    ExpiryWeights expiry_weights(double T) const noexcept;
+    
+    /**
+     * @brief Implied volatility at a strike with precomputed expiry weights
+     */
+    double volatility(double K, double T, const ExpiryWeights& weights) const noexcept;
+    
+    const std::vector<double>& strikes() const noexcept { return strikes_; }
+    const std::vector<double>& expiries() const noexcept { return expiries_; }
+    
+    /**
+     * @brief Whether a slice has been fitted
+     */
+    bool fitted(size_t slice) const noexcept { return slice < fitted_.size() && fitted_[slice] != 0; }
+    
+    /**
+     * @brief Fitted σ at a grid node (NaN if the slice is unfitted)
+     */
+    double node(size_t slice, size_t strike) const noexcept { return nodes_[slice * strikes_.size() + strike].vol; }
+    
+    /**
+     * @brief Slices refit since construction
+     */
+    uint64_t refits() const noexcept { return refits_; }
+
+private:
+    /**
+     * @brief Grid node: σ and its spline curvature ∂²σ/∂K²
+     */
+    struct Node {
+        double vol;
+        double curvature;
+    };
+    
+    /**
+     * @brief One converged quote during update()
+     */
+    struct Point {
+        size_t slice;
+        double strike;
+        double vol;
+    };
+    
+    std::vector<double> strikes_;
+    std::vector<double> expiries_;
+    std::vector<Node> nodes_;           ///< Slice-major: nodes_[slice * strikes + strike]
+    std::vector<uint8_t> fitted_;
+    uint64_t refits_ = 0;
+    
+    // Scratch reused across fits
+    std::vector<Point> points_;
+    std::vector<std::pair<double, double>> smile_;     ///< (strike, σ) sorted by strike
+    std::vector<double> diagonal_;
+    
+    size_t match_slice(double T) const noexcept;
+    void fit_smile(size_t slice) noexcept;
+};
+
+} // namespace BlackScholes
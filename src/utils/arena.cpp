@@ -0,0 +1,127 @@
+#include "arena.hpp"
+#include "memory_profiler.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace Utils {
+
+Arena::Arena(size_t chunk_size)
+    : chunk_size_(std::max<size_t>(chunk_size, alignof(std::max_align_t))) {
+}
+
+Arena::~Arena() {
+    high_water_ = std::max(high_water_, used());
+    report_high_water();
+    release_chunks();
+}
+
+Arena& Arena::local() {
+    static thread_local Arena arena;
+    return arena;
+}
+
+void Arena::rewind(const Marker& marker) noexcept {
+    high_water_ = std::max(high_water_, used());
+    
+    current_ = marker.chunk;
+    offset_ = marker.offset;
+    used_before_ = 0;
+    for (size_t i = 0; i < current_ && i < chunks_.size(); ++i) {
+        used_before_ += chunks_[i].size;
+    }
+}
+
+void Arena::reset() noexcept {
+    high_water_ = std::max(high_water_, used());
+    report_high_water();
+    
+    current_ = 0;
+    offset_ = 0;
+    used_before_ = 0;
+    if (chunks_.size() > 1) {
+        // The last batch spilled: keep one chunk that holds all of it
+        const size_t total = capacity_;
+        release_chunks();
+        try {
+            add_chunk(total);
+        } catch (const std::bad_alloc&) {
+            // Start over with no chunks; the next allocation retries
+        }
+    }
+}
+
+size_t Arena::used() const noexcept {
+    return used_before_ + offset_;
+}
+
+size_t Arena::high_water_mark() const noexcept {
+    return std::max(high_water_, used());
+}
+
+void* Arena::do_allocate(size_t bytes, size_t alignment) {
+    if (current_ < chunks_.size()) {
+        const Chunk& chunk = chunks_[current_];
+        const uintptr_t base = reinterpret_cast<uintptr_t>(chunk.data);
+        const size_t start = static_cast<size_t>(((base + offset_ + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base);
+        if (start <= chunk.size && bytes <= chunk.size - start) {
+            offset_ = start + bytes;
+            return chunk.data + start;
+        }
+    }
+    return allocate_slow(bytes, alignment);
+}
+
+void* Arena::allocate_slow(size_t bytes, size_t alignment) {
+    high_water_ = std::max(high_water_, used());
+    if (bytes > SIZE_MAX / 2 - alignment) {
+        throw std::bad_alloc();
+    }
+    const size_t needed = bytes + alignment;    // Worst-case padding
+    
+    // Move on to the next retained chunk, or replace the retained ones with a larger chunk
+    const size_t next = chunks_.empty() ? 0 : current_ + 1;
+    if (next >= chunks_.size() || chunks_[next].size < needed) {
+        while (chunks_.size() > next) {
+            capacity_ -= chunks_.back().size;
+            MemoryProfiler::deallocate(chunks_.back().data);
+            chunks_.pop_back();
+        }
+        size_t size = std::max(chunk_size_, needed);
+        if (!chunks_.empty()) {
+            size = std::max(size, 2 * chunks_.back().size);
+        }
+        add_chunk(size);
+    }
+    
+    if (next != 0) {
+        used_before_ += chunks_[current_].size;
+    }
+    current_ = next;
+    offset_ = 0;
+    return do_allocate(bytes, alignment);
+}
+
+void Arena::add_chunk(size_t size) {
+    chunks_.reserve(chunks_.size() + 1);
+    char* data = static_cast<char*>(MemoryProfiler::allocate(size, __FILE__, __LINE__, "Utils::Arena"));
+    chunks_.push_back(Chunk{data, size});
+    capacity_ += size;
+}
+
+void Arena::release_chunks() noexcept {
+    for (const Chunk& chunk : chunks_) {
+        MemoryProfiler::deallocate(chunk.data);
+    }
+    chunks_.clear();
+    capacity_ = 0;
+}
+
+void Arena::report_high_water() noexcept {
+    if (high_water_ > reported_high_water_) {
+        MemoryProfiler::recordArenaHighWater(high_water_ - reported_high_water_);
+        reported_high_water_ = high_water_;
+    }
+}
+
+} // namespace Utils
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @file arena.hpp
+ * @brief Monotonic arena for per-batch scratch memory
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * An Arena hands out memory by bumping a pointer through a list of chunks
+ * and never frees individual allocations; the whole arena is rewound at
+ * once when the batch that used it ends. Chunks are kept across batches,
+ * and a reset() that needed more than one chunk replaces them with a
+ * single chunk of the combined size, so a workload of repeating batches
+ * reaches a steady state with no malloc traffic at all.
+ *
+ * Arena is a std::pmr::memory_resource, so scratch containers are
+ * std::pmr::vector and friends constructed with &arena. Typical use:
+ *
+ *   Utils::ArenaScope scratch;                 // this thread's arena
+ *   std::pmr::vector<double> d1(n, scratch.resource());
+ *   ...                                        // memory returned at scope exit
+ *
+ * Arenas are not thread-safe; Arena::local() gives each thread its own.
+ */
+
+namespace Utils {
+
+/**
+ * @brief Bump-pointer memory resource with wholesale reset
+ */
+class Arena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+    
+    /**
+     * @brief Position to rewind to
+     */
+    struct Marker {
+        size_t chunk = 0;   ///< Chunk in use
+        size_t offset = 0;  ///< Bytes used in that chunk
+    };
+    
+    /**
+     * @brief Create an empty arena (no memory is reserved until first use)
+     * @param chunk_size Size of the first chunk; later chunks double
+     */
+    explicit Arena(size_t chunk_size = DEFAULT_CHUNK_SIZE);
+    ~Arena() override;
+    
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    
+    /**
+     * @brief Get the calling thread's arena
+     * @return Arena owned by the current thread
+     */
+    static Arena& local();
+    
+    /**
+     * @brief Current position, for rewind()
+     * @return Marker of the next allocation
+     */
+    Marker mark() const noexcept { return Marker{current_, offset_}; }
+    
+    /**
+     * @brief Release everything allocated since `marker`
+     * @param marker Value returned by mark() on this arena
+     */
+    void rewind(const Marker& marker) noexcept;
+    
+    /**
+     * @brief Release everything and coalesce the chunks
+     *
+     * If the last batch spilled into several chunks they are replaced by
+     * one chunk large enough for the whole batch.
+     */
+    void reset() noexcept;
+    
+    /**
+     * @brief Bytes in use, including alignment padding and skipped chunk tails
+     * @return Bytes allocated since the last reset
+     */
+    size_t used() const noexcept;
+    
+    /**
+     * @brief Bytes reserved from the system
+     * @return Total size of the chunks held
+     */
+    size_t capacity() const noexcept { return capacity_; }
+    
+    /**
+     * @brief Largest used() since construction
+     * @return High-water mark in bytes
+     */
+    size_t high_water_mark() const noexcept;
+
+private:
+    struct Chunk {
+        char* data;
+        size_t size;
+    };
+    
+    std::vector<Chunk> chunks_;
+    size_t current_ = 0;        ///< Index of the chunk being filled
+    size_t offset_ = 0;         ///< Bytes used in chunks_[current_]
+    size_t used_before_ = 0;    ///< Sizes of the chunks before current_
+    size_t capacity_ = 0;
+    size_t chunk_size_;
+    size_t high_water_ = 0;
+    size_t reported_high_water_ = 0;   ///< Part of high_water_ already reported to MemoryProfiler
+    
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+    
+    void* allocate_slow(size_t bytes, size_t alignment);
+    void add_chunk(size_t size);
+    void release_chunks() noexcept;
+    void report_high_water() noexcept;
+};
+
+/**
+ * @brief RAII scope over an arena: everything allocated inside is released on exit
+ *
+ * The outermost scope of an arena calls reset(), so the chunks are
+ * coalesced at the end of each batch; nested scopes rewind to their entry
+ * position.
+ */
+class ArenaScope {
+public:
+    /**
+     * @brief Enter a scope
+     * @param arena Arena to use (default: this thread's arena)
+     */
+    explicit ArenaScope(Arena& arena = Arena::local()) noexcept
+        : arena_(arena), marker_(arena.mark()) {}
+    
+    ~ArenaScope() {
+        if (marker_.chunk == 0 && marker_.offset == 0) {
+            arena_.reset();
+        } else {
+            arena_.rewind(marker_);
+        }
+    }
+    
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+    
+    Arena& arena() noexcept { return arena_; }
+    std::pmr::memory_resource* resource() noexcept { return &arena_; }
+
+private:
+    Arena& arena_;
+    Arena::Marker marker_;
+};
+
+} // namespace Utils
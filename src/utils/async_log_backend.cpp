@@ -0,0 +1,350 @@
+#include "async_log_backend.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <sstream>
+
+namespace Utils {
+
+namespace {
+
+// Producer-side handle; marks the ring orphaned when the thread exits
+struct ProducerHandle {
+    std::shared_ptr<LogRing> ring;
+    uint64_t generation = 0;
+    
+    ~ProducerHandle() {
+        if (ring) {
+            ring->set_orphaned();
+        }
+    }
+};
+
+thread_local ProducerHandle t_producer;
+
+// Keeps the producer's ring marked in flight for the rest of enqueue()
+struct WriteScope {
+    LogRing* ring;
+    
+    explicit WriteScope(LogRing* r) noexcept : ring(r) { ring->begin_write(); }
+    ~WriteScope() { ring->end_write(); }
+};
+
+size_t round_up_pow2(size_t value) {
+    size_t capacity = 2;
+    while (capacity < value) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+// Copy at most capacity - 1 bytes, marking truncation with "..."
+uint16_t copy_truncated(char* dest, size_t capacity, const std::string& source) {
+    size_t length = source.size();
+    if (length < capacity) {
+        std::memcpy(dest, source.data(), length);
+    } else {
+        length = capacity - 1;
+        std::memcpy(dest, source.data(), length - 3);
+        std::memcpy(dest + length - 3, "...", 3);
+    }
+    return static_cast<uint16_t>(length);
+}
+
+} // namespace
+
+// LogRing implementation
+LogRing::LogRing(size_t capacity)
+    : slots_(new LogRecord[round_up_pow2(capacity)]),
+      mask_(round_up_pow2(capacity) - 1) {
+    std::ostringstream oss;
+    oss << std::this_thread::get_id();
+    thread_id_ = oss.str();
+}
+
+LogRecord* LogRing::try_reserve() noexcept {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    if (head - tail > mask_) {
+        return nullptr;
+    }
+    return &slots_[head & mask_];
+}
+
+// AsyncLogBackend implementation
+AsyncLogBackend& AsyncLogBackend::getInstance() {
+    // Never destroyed: loggers may still be used while statics are torn down
+    static AsyncLogBackend* instance = new AsyncLogBackend();
+    return *instance;
+}
+
+void AsyncLogBackend::start(const AsyncLogOptions& options) {
+    const size_t capacity = round_up_pow2(std::max<size_t>(options.queue_capacity, 2));
+    if (ring_capacity_.exchange(capacity) != capacity) {
+        generation_.fetch_add(1, std::memory_order_release);
+    }
+    overflow_policy_.store(static_cast<int>(options.overflow_policy), std::memory_order_relaxed);
+    flush_interval_ms_.store(std::max(options.flush_interval_ms, 1), std::memory_order_relaxed);
+    
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (writer_.joinable()) {
+        return;
+    }
+    
+    stop_requested_ = false;
+    running_.store(true, std::memory_order_release);
+    writer_ = std::thread(&AsyncLogBackend::writer_loop, this);
+    
+    // Drain pending records at normal program exit
+    static std::once_flag atexit_flag;
+    std::call_once(atexit_flag, []() {
+        std::atexit([]() { AsyncLogBackend::getInstance().stop(); });
+    });
+}
+
+void AsyncLogBackend::stop() {
+    std::thread writer;
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        if (!writer_.joinable()) {
+            return;
+        }
+        running_.store(false, std::memory_order_seq_cst);
+        stop_requested_ = true;
+        writer = std::move(writer_);
+    }
+    
+    wake_cv_.notify_all();
+    writer.join();
+    
+    // Records committed after the writer's last drain; skipped if start()
+    // already launched a new writer, which owns the rings again
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (!writer_.joinable()) {
+        wait_for_producers();
+        drain_all();
+    }
+    flushed_cv_.notify_all();
+}
+
+void AsyncLogBackend::wait_for_producers() {
+    std::vector<std::shared_ptr<LogRing>> rings;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        rings = rings_;
+    }
+    
+    // A producer that sees running() cleared leaves without committing
+    for (const auto& ring : rings) {
+        while (ring->writing()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+LogRing* AsyncLogBackend::ring_for_current_thread() {
+    const uint64_t generation = generation_.load(std::memory_order_acquire);
+    if (t_producer.ring && t_producer.generation == generation) {
+        return t_producer.ring.get();
+    }
+    
+    // First record from this thread (or capacity changed): register a new ring
+    if (t_producer.ring) {
+        t_producer.ring->set_orphaned();
+    }
+    auto ring = std::make_shared<LogRing>(ring_capacity_.load(std::memory_order_relaxed));
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        rings_.push_back(ring);
+    }
+    t_producer.ring = std::move(ring);
+    t_producer.generation = generation;
+    return t_producer.ring.get();
+}
+
+bool AsyncLogBackend::enqueue(LogLevel level, const std::string& component, const std::string& message) {
+    if (!running()) {
+        return false;
+    }
+    
+    // Mark the ring before re-checking, so stop() either sees this producer
+    // in flight or this producer sees the backend stopped
+    LogRing* ring = ring_for_current_thread();
+    const WriteScope scope(ring);
+    if (!running_.load(std::memory_order_seq_cst)) {
+        return false;
+    }
+    
+    LogRecord* slot = ring->try_reserve();
+    
+    if (slot == nullptr) {
+        if (overflow_policy_.load(std::memory_order_relaxed) == static_cast<int>(OverflowPolicy::DROP)) {
+            ring->record_drop();
+            return true;
+        }
+        
+        // BLOCK: nudge the writer and wait for a free slot
+        while ((slot = ring->try_reserve()) == nullptr) {
+            if (!running()) {
+                return false;
+            }
+            wake_requested_.store(true, std::memory_order_release);
+            wake_cv_.notify_one();
+            std::this_thread::yield();
+        }
+    }
+    
+    slot->timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    slot->level = level;
+    slot->component_length = copy_truncated(slot->component, LogRecord::COMPONENT_CAPACITY, component);
+    slot->message_length = copy_truncated(slot->message, LogRecord::MESSAGE_CAPACITY, message);
+    ring->commit();
+    
+    enqueued_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void AsyncLogBackend::flush(int timeout_ms) {
+    std::unique_lock<std::mutex> lock(state_mutex_);
+    if (!running() || std::this_thread::get_id() == writer_.get_id()) {
+        return;
+    }
+    
+    const uint64_t ticket = ++flush_requests_;
+    wake_cv_.notify_one();
+    flushed_cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this, ticket]() {
+        return flushes_completed_ >= ticket || !running();
+    });
+}
+
+AsyncLogStats AsyncLogBackend::stats() {
+    AsyncLogStats result;
+    result.enqueued = enqueued_.load(std::memory_order_relaxed);
+    result.dropped = total_dropped();
+    result.written = written_.load(std::memory_order_relaxed);
+    result.batches = batches_.load(std::memory_order_relaxed);
+    return result;
+}
+
+uint64_t AsyncLogBackend::total_dropped() {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    uint64_t dropped = dropped_retired_.load(std::memory_order_relaxed);
+    for (const auto& ring : rings_) {
+        dropped += ring->dropped();
+    }
+    return dropped;
+}
+
+void AsyncLogBackend::writer_loop() {
+    std::unique_lock<std::mutex> lock(state_mutex_);
+    
+    while (true) {
+        const auto interval = std::chrono::milliseconds(flush_interval_ms_.load(std::memory_order_relaxed));
+        wake_cv_.wait_for(lock, interval, [this]() {
+            return stop_requested_ || flush_requests_ > flushes_completed_ ||
+                   wake_requested_.load(std::memory_order_acquire);
+        });
+        wake_requested_.store(false, std::memory_order_relaxed);
+        
+        const bool stopping = stop_requested_;
+        const uint64_t flush_target = flush_requests_;
+        
+        lock.unlock();
+        drain_all();
+        lock.lock();
+        
+        flushes_completed_ = std::max(flushes_completed_, flush_target);
+        flushed_cv_.notify_all();
+        
+        if (stopping) {
+            break;
+        }
+    }
+}
+
+void AsyncLogBackend::format_line(const LogRecord& record, const std::string& thread_id) {
+    // localtime_r once per second; milliseconds appended per record
+    const int64_t second = record.timestamp_ns / 1000000000;
+    if (second != cached_second_) {
+        const std::time_t time = static_cast<std::time_t>(second);
+        std::tm local_tm{};
+        localtime_r(&time, &local_tm);
+        std::strftime(cached_timestamp_, sizeof(cached_timestamp_), "%Y-%m-%d %H:%M:%S", &local_tm);
+        cached_second_ = second;
+    }
+    
+    char millis[8];
+    std::snprintf(millis, sizeof(millis), ".%03d", static_cast<int>((record.timestamp_ns / 1000000) % 1000));
+    
+    line_.clear();
+    line_.append(cached_timestamp_).append(millis);
+    line_.append(" [").append(to_string(record.level)).append("] [");
+    line_.append(record.component, record.component_length);
+    line_.append("] [T:").append(thread_id).append("] ");
+    line_.append(record.message, record.message_length);
+    line_.push_back('\n');
+}
+
+size_t AsyncLogBackend::drain_all() {
+    std::vector<std::shared_ptr<LogRing>> rings;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        rings = rings_;
+    }
+    
+    file_lines_.clear();
+    out_lines_.clear();
+    err_lines_.clear();
+    
+    size_t count = 0;
+    for (const auto& ring : rings) {
+        count += ring->drain([this, &ring](const LogRecord& record) {
+            format_line(record, ring->thread_id());
+            file_lines_ += line_;
+            (record.level >= LogLevel::ERROR ? err_lines_ : out_lines_) += line_;
+        });
+    }
+    
+    // Report drops once per batch rather than per record
+    const uint64_t dropped = total_dropped();
+    if (dropped > dropped_reported_) {
+        LogRecord notice{};
+        notice.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        notice.level = LogLevel::WARNING;
+        notice.component_length = copy_truncated(notice.component, LogRecord::COMPONENT_CAPACITY, "Logger");
+        notice.message_length = copy_truncated(notice.message, LogRecord::MESSAGE_CAPACITY,
+            "Dropped " + std::to_string(dropped - dropped_reported_) + " log records (async queue full)");
+        format_line(notice, "writer");
+        file_lines_ += line_;
+        out_lines_ += line_;
+        dropped_reported_ = dropped;
+    }
+    
+    if (!file_lines_.empty()) {
+        Logger::write_batch(file_lines_, out_lines_, err_lines_);
+        batches_.fetch_add(1, std::memory_order_relaxed);
+    }
+    written_.fetch_add(count, std::memory_order_relaxed);
+    
+    // Forget rings whose threads have exited once they are empty
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        auto retired = std::remove_if(rings_.begin(), rings_.end(), [this](const std::shared_ptr<LogRing>& ring) {
+            if (ring->orphaned() && ring->empty()) {
+                dropped_retired_.fetch_add(ring->dropped(), std::memory_order_relaxed);
+                return true;
+            }
+            return false;
+        });
+        rings_.erase(retired, rings_.end());
+    }
+    
+    return count;
+}
+
+} // namespace Utils
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "logger.hpp"
+
+/**
+ * @file async_log_backend.hpp
+ * @brief Lock-free asynchronous delivery of log records
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * Internal to the logging system; use Logger::set_backend() to enable it.
+ *
+ * Each producer thread owns a single-producer/single-consumer ring of
+ * fixed-size records, so logging from a pricing thread is a bounded copy
+ * plus a few atomic operations on its own ring. Timestamp and thread-id formatting are
+ * deferred to a background writer thread, which drains all rings, builds
+ * one batch per destination and hands it to Logger for writing and file
+ * rotation. Records from one thread keep their order; records from
+ * different threads may interleave differently than in SYNC mode.
+ */
+
+namespace Utils {
+
+/**
+ * @brief One log record, copied by value into a producer ring
+ */
+struct LogRecord {
+    static constexpr size_t COMPONENT_CAPACITY = 48;
+    static constexpr size_t MESSAGE_CAPACITY = 432;
+    
+    int64_t timestamp_ns;                   ///< system_clock time since epoch
+    LogLevel level;                         ///< Record severity
+    uint16_t component_length;              ///< Bytes used in component
+    uint16_t message_length;                ///< Bytes used in message
+    char component[COMPONENT_CAPACITY];     ///< Logger component name (truncated)
+    char message[MESSAGE_CAPACITY];         ///< Formatted message (truncated with "...")
+};
+
+/**
+ * @brief Single-producer/single-consumer ring owned by one logging thread
+ */
+class LogRing {
+private:
+    std::unique_ptr<LogRecord[]> slots_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> head_{0};      ///< Next slot to write (producer)
+    std::atomic<bool> in_flight_{false};           ///< Producer is inside enqueue() (same line as head_)
+    alignas(64) std::atomic<size_t> tail_{0};      ///< Next slot to read (writer thread)
+    std::atomic<uint64_t> dropped_{0};             ///< Records dropped because the ring was full
+    std::atomic<bool> orphaned_{false};            ///< Producer thread has exited
+    std::string thread_id_;                        ///< Pre-formatted producer thread id
+
+public:
+    /**
+     * @brief Create a ring for the calling thread
+     * @param capacity Number of records (rounded up to a power of two)
+     */
+    explicit LogRing(size_t capacity);
+    
+    /**
+     * @brief Reserve the next slot (producer side)
+     * @return Slot to fill, or nullptr if the ring is full
+     */
+    LogRecord* try_reserve() noexcept;
+    
+    /**
+     * @brief Publish the slot returned by try_reserve() (producer side)
+     */
+    void commit() noexcept { head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+    
+    /**
+     * @brief Visit and release all published records (writer side)
+     * @param visit Callback invoked for each record in order
+     * @return Number of records consumed
+     */
+    template<typename Visitor>
+    size_t drain(Visitor&& visit) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t head = head_.load(std::memory_order_acquire);
+        for (size_t i = tail; i != head; ++i) {
+            visit(slots_[i & mask_]);
+        }
+        tail_.store(head, std::memory_order_release);
+        return head - tail;
+    }
+    
+    bool empty() const noexcept {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+    
+    /**
+     * @brief Mark the producer as inside enqueue(), ordered before its running() check
+     */
+    void begin_write() noexcept { in_flight_.store(true, std::memory_order_seq_cst); }
+    void end_write() noexcept { in_flight_.store(false, std::memory_order_release); }
+    bool writing() const noexcept { return in_flight_.load(std::memory_order_seq_cst); }
+    
+    void record_drop() noexcept { dropped_.fetch_add(1, std::memory_order_relaxed); }
+    uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+    void set_orphaned() noexcept { orphaned_.store(true, std::memory_order_release); }
+    bool orphaned() const noexcept { return orphaned_.load(std::memory_order_acquire); }
+    const std::string& thread_id() const noexcept { return thread_id_; }
+};
+
+/**
+ * @brief Background writer and registry of producer rings (singleton)
+ *
+ * The singleton is intentionally never destroyed: loggers with static or
+ * thread storage duration may still log during shutdown. An atexit hook
+ * stops the writer and drains pending records; afterwards enqueue()
+ * returns false and Logger falls back to synchronous writes.
+ */
+class AsyncLogBackend {
+private:
+    // Registry of producer rings, guarded by registry_mutex_ (taken once per thread)
+    std::mutex registry_mutex_;
+    std::vector<std::shared_ptr<LogRing>> rings_;
+    
+    // Writer thread state, guarded by state_mutex_
+    std::mutex state_mutex_;
+    std::condition_variable wake_cv_;
+    std::condition_variable flushed_cv_;
+    std::thread writer_;
+    bool stop_requested_ = false;
+    uint64_t flush_requests_ = 0;
+    uint64_t flushes_completed_ = 0;
+    
+    std::atomic<bool> running_{false};
+    std::atomic<bool> wake_requested_{false};  ///< Set by blocked producers
+    std::atomic<uint64_t> generation_{0};   ///< Bumped when ring capacity changes
+    std::atomic<size_t> ring_capacity_{1024};
+    std::atomic<int> overflow_policy_{static_cast<int>(OverflowPolicy::DROP)};
+    std::atomic<int> flush_interval_ms_{50};
+    
+    std::atomic<uint64_t> enqueued_{0};
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> batches_{0};
+    uint64_t dropped_reported_ = 0;         ///< Writer thread (or stop() after joining it) only
+    std::atomic<uint64_t> dropped_retired_{0};  ///< Drops from rings already removed
+    
+    // Writer thread scratch buffers, reused across batches
+    std::string file_lines_;
+    std::string out_lines_;
+    std::string err_lines_;
+    std::string line_;
+    int64_t cached_second_ = -1;
+    char cached_timestamp_[32] = {};
+    
+    AsyncLogBackend() = default;
+    
+    LogRing* ring_for_current_thread();
+    void writer_loop();
+    void wait_for_producers();
+    size_t drain_all();
+    void format_line(const LogRecord& record, const std::string& thread_id);
+    uint64_t total_dropped();
+
+public:
+    AsyncLogBackend(const AsyncLogBackend&) = delete;
+    AsyncLogBackend& operator=(const AsyncLogBackend&) = delete;
+    
+    /**
+     * @brief Get singleton instance
+     * @return Reference to the backend
+     */
+    static AsyncLogBackend& getInstance();
+    
+    /**
+     * @brief Start (or reconfigure) the writer thread
+     * @param options Queue capacity, overflow policy and flush interval
+     */
+    void start(const AsyncLogOptions& options);
+    
+    /**
+     * @brief Drain all pending records and stop the writer thread
+     *
+     * Producers that passed the running() check before it was cleared may
+     * commit after the writer's last drain; stop() waits for them and
+     * drains those records on the calling thread.
+     */
+    void stop();
+    
+    /**
+     * @brief Check whether the writer thread is running
+     * @return true if records are accepted
+     */
+    bool running() const noexcept { return running_.load(std::memory_order_acquire); }
+    
+    /**
+     * @brief Enqueue a formatted message from the calling thread
+     * @param level Log level
+     * @param component Logger component name
+     * @param message Formatted message
+     * @return false if the backend is not running (caller should write synchronously)
+     */
+    bool enqueue(LogLevel level, const std::string& component, const std::string& message);
+    
+    /**
+     * @brief Block until every record enqueued before the call is written
+     * @param timeout_ms Maximum time to wait
+     */
+    void flush(int timeout_ms = 1000);
+    
+    /**
+     * @brief Get delivery counters
+     * @return Snapshot of enqueued/dropped/written/batch counts
+     */
+    AsyncLogStats stats();
+};
+
+} // namespace Utils
@@ -0,0 +1,349 @@
+#include "benchmark.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Utils {
+
+namespace {
+
+double median_of(std::vector<double> values) {
+    if (values.empty()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    std::sort(values.begin(), values.end());
+    const size_t mid = values.size() / 2;
+    return values.size() % 2 == 1 ? values[mid] : 0.5 * (values[mid - 1] + values[mid]);
+}
+
+void write_json_string(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+            out << escaped;
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+void write_json_number(std::ostream& out, double value) {
+    if (std::isfinite(value)) {
+        out << value;
+    } else {
+        out << "null";
+    }
+}
+
+// String starting at the quote at text[pos], as write_json_string() escapes it; pos ends past the closing quote
+bool read_json_string(const std::string& text, size_t& pos, std::string& value) {
+    if (pos >= text.size() || text[pos] != '"') {
+        return false;
+    }
+    value.clear();
+    for (++pos; pos < text.size(); ++pos) {
+        const char c = text[pos];
+        if (c == '"') {
+            ++pos;
+            return true;
+        }
+        if (c != '\\') {
+            value += c;
+            continue;
+        }
+        if (++pos >= text.size()) {
+            return false;
+        }
+        if (text[pos] != 'u') {
+            value += text[pos];
+            continue;
+        }
+        if (pos + 4 >= text.size()) {
+            return false;
+        }
+        const unsigned long code = std::strtoul(text.substr(pos + 1, 4).c_str(), nullptr, 16);
+        if (code >= 0x80) {
+            return false;
+        }
+        value += static_cast<char>(code);
+        pos += 4;
+    }
+    return false;
+}
+
+// Number of the "key" field in text[begin, end), NaN when absent or null
+double read_json_field(const std::string& text, size_t begin, size_t end, const char* key) {
+    const std::string label = std::string("\"") + key + "\": ";
+    const size_t found = text.find(label, begin);
+    if (found == std::string::npos || found >= end) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    const char* start = text.c_str() + found + label.size();
+    char* stop = nullptr;
+    const double value = std::strtod(start, &stop);
+    return stop == start ? std::numeric_limits<double>::quiet_NaN() : value;
+}
+
+size_t read_json_count(const std::string& text, size_t begin, size_t end, const char* key) {
+    const double value = read_json_field(text, begin, end, key);
+    return std::isfinite(value) && value >= 0.0 ? static_cast<size_t>(value) : 0;
+}
+
+} // namespace
+
+BenchmarkResult BenchmarkResult::from_samples(const std::string& name, size_t items, std::vector<double> samples_ns) {
+    BenchmarkResult result;
+    result.name = name;
+    result.items = items;
+    result.runs = samples_ns.size();
+    if (samples_ns.empty()) {
+        return result;
+    }
+    
+    std::sort(samples_ns.begin(), samples_ns.end());
+    const size_t n = samples_ns.size();
+    result.median_ns = median_of(samples_ns);
+    const size_t rank = static_cast<size_t>(std::ceil(0.99 * static_cast<double>(n)));
+    result.p99_ns = samples_ns[std::max<size_t>(rank, 1) - 1];
+    result.min_ns = samples_ns.front();
+    double total = 0.0;
+    for (const double sample : samples_ns) {
+        total += sample;
+    }
+    result.mean_ns = total / static_cast<double>(n);
+    return result;
+}
+
+uint64_t monotonic_ns() noexcept {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ull + static_cast<uint64_t>(now.tv_nsec);
+}
+
+HardwareCounters::HardwareCounters() noexcept {
+#if defined(__linux__)
+    const uint64_t events[COUNTERS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                       PERF_COUNT_HW_CACHE_MISSES};
+    for (size_t i = 0; i < COUNTERS; ++i) {
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = events[i];
+        attr.disabled = i == 0 ? 1 : 0;     // The leader starts and stops the whole group
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        const long fd = syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fds_[0], 0);
+        if (fd < 0) {
+            // All or nothing: a partial group would report misleading ratios
+            for (size_t j = 0; j < i; ++j) {
+                close(fds_[j]);
+                fds_[j] = -1;
+            }
+            return;
+        }
+        fds_[i] = static_cast<int>(fd);
+    }
+#endif
+}
+
+HardwareCounters::~HardwareCounters() {
+#if defined(__linux__)
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+#endif
+}
+
+void HardwareCounters::start() noexcept {
+#if defined(__linux__)
+    if (available()) {
+        ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+}
+
+bool HardwareCounters::stop(uint64_t& cycles, uint64_t& instructions, uint64_t& cache_misses) noexcept {
+#if defined(__linux__)
+    if (!available()) {
+        return false;
+    }
+    ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    uint64_t group[1 + COUNTERS];   // Count of events, then one value per event
+    if (read(fds_[0], group, sizeof(group)) != static_cast<ssize_t>(sizeof(group)) || group[0] != COUNTERS) {
+        return false;
+    }
+    cycles = group[1];
+    instructions = group[2];
+    cache_misses = group[3];
+    return true;
+#else
+    (void)cycles;
+    (void)instructions;
+    (void)cache_misses;
+    return false;
+#endif
+}
+
+BenchmarkRunner::BenchmarkRunner(const BenchmarkOptions& options) : options_(options) {
+    options_.runs = std::max<size_t>(options_.runs, 1);
+}
+
+const BenchmarkResult& BenchmarkRunner::run(const std::string& name, size_t items,
+                                            const std::function<void()>& body) {
+    for (size_t i = 0; i < options_.warmup_runs; ++i) {
+        body();
+    }
+    
+    const bool count = counters_available();
+    std::vector<double> samples(options_.runs);
+    std::vector<double> cycles, instructions, cache_misses;
+    for (size_t i = 0; i < options_.runs; ++i) {
+        if (count) {
+            counters_.start();
+        }
+        const uint64_t start = monotonic_ns();
+        body();
+        samples[i] = static_cast<double>(monotonic_ns() - start);
+        
+        uint64_t c = 0, n = 0, m = 0;
+        if (count && counters_.stop(c, n, m)) {
+            cycles.push_back(static_cast<double>(c));
+            instructions.push_back(static_cast<double>(n));
+            cache_misses.push_back(static_cast<double>(m));
+        }
+    }
+    
+    BenchmarkResult result = BenchmarkResult::from_samples(name, items, std::move(samples));
+    result.cycles = median_of(cycles);
+    result.instructions = median_of(instructions);
+    result.cache_misses = median_of(cache_misses);
+    results_.push_back(std::move(result));
+    return results_.back();
+}
+
+const BenchmarkResult& BenchmarkRunner::record(BenchmarkResult result) {
+    results_.push_back(std::move(result));
+    return results_.back();
+}
+
+void BenchmarkRunner::write_table(std::ostream& out) const {
+    const std::ios::fmtflags flags = out.flags();
+    out << std::left << std::setw(32) << "benchmark" << std::right
+        << std::setw(10) << "items" << std::setw(14) << "median ms" << std::setw(14) << "p99 ms"
+        << std::setw(12) << "ns/item" << std::setw(12) << "IPC" << std::setw(14) << "misses/item" << '\n';
+    out << std::fixed;
+    for (const BenchmarkResult& result : results_) {
+        out << std::left << std::setw(32) << result.name << std::right
+            << std::setw(10) << result.items
+            << std::setw(14) << std::setprecision(3) << result.median_ns / 1e6
+            << std::setw(14) << result.p99_ns / 1e6
+            << std::setw(12) << std::setprecision(2) << result.ns_per_item();
+        if (std::isfinite(result.cycles) && result.cycles > 0.0 && result.items > 0) {
+            out << std::setw(12) << result.instructions / result.cycles
+                << std::setw(14) << std::setprecision(4) << result.cache_misses / static_cast<double>(result.items);
+        } else {
+            out << std::setw(12) << "-" << std::setw(14) << "-";
+        }
+        out << '\n';
+    }
+    out.flags(flags);
+}
+
+void BenchmarkRunner::write_json(std::ostream& out, const std::map<std::string, std::string>& context) const {
+    const std::ios::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision(12);
+    out.unsetf(std::ios::floatfield);
+    
+    out << "{\n  \"context\": {";
+    bool first = true;
+    for (const auto& [key, value] : context) {
+        out << (first ? "\n    " : ",\n    ");
+        write_json_string(out, key);
+        out << ": ";
+        write_json_string(out, value);
+        first = false;
+    }
+    out << (first ? "},\n" : "\n  },\n");
+    
+    out << "  \"benchmarks\": [";
+    for (size_t i = 0; i < results_.size(); ++i) {
+        const BenchmarkResult& result = results_[i];
+        out << (i == 0 ? "\n    {" : ",\n    {") << "\"name\": ";
+        write_json_string(out, result.name);
+        out << ", \"items\": " << result.items << ", \"runs\": " << result.runs;
+        out << ", \"median_ns\": ";
+        write_json_number(out, result.median_ns);
+        out << ", \"p99_ns\": ";
+        write_json_number(out, result.p99_ns);
+        out << ", \"min_ns\": ";
+        write_json_number(out, result.min_ns);
+        out << ", \"mean_ns\": ";
+        write_json_number(out, result.mean_ns);
+        out << ", \"ns_per_item\": ";
+        write_json_number(out, result.ns_per_item());
+        out << ", \"cycles\": ";
+        write_json_number(out, result.cycles);
+        out << ", \"instructions\": ";
+        write_json_number(out, result.instructions);
+        out << ", \"cache_misses\": ";
+        write_json_number(out, result.cache_misses);
+        out << '}';
+    }
+    out << (results_.empty() ? "]\n}\n" : "\n  ]\n}\n");
+    
+    out.precision(precision);
+    out.flags(flags);
+}
+
+std::vector<BenchmarkResult> read_benchmark_json(std::istream& in) {
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    const std::string text = buffer.str();
+    
+    std::vector<BenchmarkResult> results;
+    const std::string marker = "{\"name\": ";
+    for (size_t pos = text.find(marker); pos != std::string::npos; pos = text.find(marker, pos)) {
+        pos += marker.size();
+        BenchmarkResult result;
+        if (!read_json_string(text, pos, result.name)) {
+            continue;
+        }
+        const size_t end = text.find('}', pos);
+        if (end == std::string::npos) {
+            break;
+        }
+        result.items = read_json_count(text, pos, end, "items");
+        result.runs = read_json_count(text, pos, end, "runs");
+        result.median_ns = read_json_field(text, pos, end, "median_ns");
+        result.p99_ns = read_json_field(text, pos, end, "p99_ns");
+        result.min_ns = read_json_field(text, pos, end, "min_ns");
+        result.mean_ns = read_json_field(text, pos, end, "mean_ns");
+        if (std::isfinite(result.median_ns)) {
+            results.push_back(std::move(result));
+        }
+        pos = end;
+    }
+    return results;
+}
+
+} // namespace Utils
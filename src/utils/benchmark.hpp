@@ -0,0 +1,200 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file benchmark.hpp
+ * @brief Repeated-run micro-benchmark harness with optional hardware counters
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * BenchmarkRunner runs a body a few times to warm caches, branch predictors
+ * and lazily initialized state, then times a fixed number of runs with
+ * clock_gettime(CLOCK_MONOTONIC) and reports the median, 99th percentile,
+ * minimum and mean, plus the median cost per processed item.
+ *
+ * On Linux, cycles, instructions and cache misses of the calling thread are
+ * read around every run through one perf_event_open() counter group. The
+ * counters are optional: they are skipped silently when the kernel denies
+ * access (perf_event_paranoid, containers) or the build is not for Linux.
+ * Work done by pool threads is timed but not counted.
+ *
+ * Results can be printed as a table or written as JSON for tracking across
+ * releases, and the JSON read back as a baseline to compare against.
+ */
+
+namespace Utils {
+
+/**
+ * @brief Run counts for BenchmarkRunner
+ */
+struct BenchmarkOptions {
+    size_t warmup_runs = 3;         ///< Untimed runs before measuring
+    size_t runs = 25;               ///< Timed runs (at least 1)
+    bool hardware_counters = true;  ///< Read perf counters when available
+};
+
+/**
+ * @brief Summary of the timed runs of one benchmark
+ *
+ * Times are wall-clock nanoseconds per run; counters are medians per run
+ * (NaN when unavailable).
+ */
+struct BenchmarkResult {
+    std::string name;
+    size_t items = 0;           ///< Options, quotes or paths processed per run
+    size_t runs = 0;            ///< Timed runs
+    double median_ns = 0.0;
+    double p99_ns = 0.0;        ///< Nearest-rank 99th percentile
+    double min_ns = 0.0;
+    double mean_ns = 0.0;
+    double cycles = std::numeric_limits<double>::quiet_NaN();
+    double instructions = std::numeric_limits<double>::quiet_NaN();
+    double cache_misses = std::numeric_limits<double>::quiet_NaN();
+    
+    /**
+     * @brief Median nanoseconds per item
+     */
+    double ns_per_item() const noexcept {
+        return items == 0 ? 0.0 : median_ns / static_cast<double>(items);
+    }
+    
+    /**
+     * @brief Summarize raw run times
+     * @param name Benchmark name
+     * @param items Items processed per run
+     * @param samples_ns Wall time of each timed run (at least one)
+     * @return Result with the time statistics filled in
+     */
+    static BenchmarkResult from_samples(const std::string& name, size_t items, std::vector<double> samples_ns);
+};
+
+/**
+ * @brief Monotonic clock in nanoseconds (clock_gettime(CLOCK_MONOTONIC))
+ */
+uint64_t monotonic_ns() noexcept;
+
+/**
+ * @brief Keep a value alive so the computation producing it is not optimized away
+ */
+template <typename T>
+inline void do_not_optimize(const T& value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Cycles, instructions and cache misses of the calling thread
+ */
+class HardwareCounters {
+private:
+    static constexpr size_t COUNTERS = 3;
+    int fds_[COUNTERS] = {-1, -1, -1};     ///< Group leader first
+
+public:
+    /**
+     * @brief Open the counter group (check available() afterwards)
+     */
+    HardwareCounters() noexcept;
+    ~HardwareCounters();
+    
+    HardwareCounters(const HardwareCounters&) = delete;
+    HardwareCounters& operator=(const HardwareCounters&) = delete;
+    
+    bool available() const noexcept { return fds_[0] >= 0; }
+    
+    /**
+     * @brief Zero and enable the counters
+     */
+    void start() noexcept;
+    
+    /**
+     * @brief Disable the counters and read them
+     * @param cycles CPU cycles since start()
+     * @param instructions Retired instructions since start()
+     * @param cache_misses Last-level cache misses since start()
+     * @return false if the counters are unavailable or could not be read
+     */
+    bool stop(uint64_t& cycles, uint64_t& instructions, uint64_t& cache_misses) noexcept;
+};
+
+/**
+ * @brief Runs benchmarks and collects their results
+ */
+class BenchmarkRunner {
+private:
+    BenchmarkOptions options_;
+    HardwareCounters counters_;
+    std::vector<BenchmarkResult> results_;
+
+public:
+    explicit BenchmarkRunner(const BenchmarkOptions& options = BenchmarkOptions());
+    
+    /**
+     * @brief Warm up, time and record one benchmark
+     * @param name Benchmark name
+     * @param items Items body processes per call (for ns per item)
+     * @param body Work to measure; called warmup_runs + runs times
+     * @return Recorded result
+     */
+    const BenchmarkResult& run(const std::string& name, size_t items, const std::function<void()>& body);
+    
+    /**
+     * @brief Record a result timed elsewhere, e.g. inside a child process
+     * @param result Result to add to the table and the JSON
+     * @return Recorded result
+     */
+    const BenchmarkResult& record(BenchmarkResult result);
+    
+    const std::vector<BenchmarkResult>& results() const noexcept { return results_; }
+    
+    /**
+     * @brief Whether hardware counters are being read
+     */
+    bool counters_available() const noexcept { return options_.hardware_counters && counters_.available(); }
+    
+    /**
+     * @brief Print a human-readable table of the results
+     * @param out Destination stream
+     */
+    void write_table(std::ostream& out) const;
+    
+    /**
+     * @brief Write the results as JSON
+     *
+     * Layout: {"context": {...}, "benchmarks": [{"name", "items", "runs",
+     * "median_ns", "p99_ns", "min_ns", "mean_ns", "ns_per_item",
+     * "cycles", "instructions", "cache_misses"}, ...]}. Unavailable
+     * counters are written as null.
+     *
+     * @param out Destination stream
+     * @param context Extra string fields describing the build and machine
+     */
+    void write_json(std::ostream& out, const std::map<std::string, std::string>& context = {}) const;
+};
+
+/**
+ * @brief Read results written by BenchmarkRunner::write_json()
+ *
+ * Reads the name, items, runs and time statistics of every benchmark;
+ * counters are left NaN. Entries without a median are skipped.
+ *
+ * @param in Source stream
+ * @return Results in file order
+ */
+std::vector<BenchmarkResult> read_benchmark_json(std::istream& in);
+
+} // namespace Utils
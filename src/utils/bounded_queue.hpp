@@ -0,0 +1,226 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * @file bounded_queue.hpp
+ * @brief Bounded lock-free multi-producer/multi-consumer queue
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * A fixed ring of cells, each tagged with a sequence number that tells
+ * producers and consumers whose turn it is (D. Vyukov's bounded MPMC
+ * queue). try_push() and try_pop() are one compare-and-swap plus one
+ * release store and never allocate. push() and pop() spin briefly and then
+ * sleep on a condition variable; the mutex is only touched while some
+ * thread is actually waiting, so a queue that never runs full or empty
+ * costs no locking.
+ *
+ * close() ends the stream: pushes fail from then on, and pops drain what is
+ * left and then return false. It is meant for pipeline stages handing
+ * buffers to each other, where the producer closes after its last push.
+ */
+
+namespace Utils {
+
+/**
+ * @brief Bounded MPMC queue of trivially copyable values
+ */
+template <typename T>
+class BoundedQueue {
+private:
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+    
+    static constexpr int SPIN_LIMIT = 64;           ///< Failed attempts before sleeping
+    static constexpr auto WAIT_SLICE = std::chrono::milliseconds(10);  ///< Re-check period while asleep
+    
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> head_{0};       ///< Next position to push
+    alignas(64) std::atomic<size_t> tail_{0};       ///< Next position to pop
+    alignas(64) std::atomic<bool> closed_{false};
+    std::atomic<size_t> high_water_{0};             ///< Largest size observed after a push
+    std::atomic<uint32_t> waiters_{0};              ///< Threads asleep in push() or pop()
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    
+    static size_t round_up(size_t capacity) noexcept {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        return size;
+    }
+    
+    void notify() {
+        // Pairs with the increment of waiters_ before a sleeper re-checks the queue
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) != 0) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cv_.notify_all();
+        }
+    }
+    
+    template <typename Attempt>
+    bool wait_for(Attempt&& attempt) {
+        for (int spin = 0; spin < SPIN_LIMIT; ++spin) {
+            if (attempt()) {
+                return true;
+            }
+            std::this_thread::yield();
+        }
+        
+        std::unique_lock<std::mutex> lock(mutex_);
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        bool done = false;
+        while (!(done = attempt()) && !closed_.load(std::memory_order_acquire)) {
+            cv_.wait_for(lock, WAIT_SLICE);
+        }
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        return done;
+    }
+
+public:
+    /**
+     * @brief Create an empty queue
+     * @param capacity Maximum number of queued values (rounded up to a power of two, at least 2)
+     */
+    explicit BoundedQueue(size_t capacity)
+        : cells_(new Cell[round_up(capacity)]), mask_(round_up(capacity) - 1) {
+        for (size_t i = 0; i <= mask_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+    
+    /**
+     * @brief Append a value if there is room
+     * @return false if the queue is full or closed
+     */
+    bool try_push(const T& value) noexcept {
+        if (closed_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        size_t position = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t lag = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (lag == 0) {
+                if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    const size_t depth = position + 1 - tail_.load(std::memory_order_relaxed);
+                    size_t seen = high_water_.load(std::memory_order_relaxed);
+                    while (depth > seen && depth <= capacity() &&
+                           !high_water_.compare_exchange_weak(seen, depth, std::memory_order_relaxed)) {
+                    }
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false;   // The cell still holds the value from one lap ago
+            } else {
+                position = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    /**
+     * @brief Remove the oldest value if there is one
+     * @return false if the queue is empty
+     */
+    bool try_pop(T& value) noexcept {
+        size_t position = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t lag = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (lag == 0) {
+                if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    value = cell.value;
+                    cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false;   // Not yet written
+            } else {
+                position = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    /**
+     * @brief Append a value, waiting while the queue is full
+     * @return false if the queue was closed before the value could be added
+     */
+    bool push(const T& value) {
+        if (!wait_for([&]() { return try_push(value); })) {
+            return false;
+        }
+        notify();
+        return true;
+    }
+    
+    /**
+     * @brief Remove the oldest value, waiting while the queue is empty
+     * @return false once the queue is closed and drained
+     */
+    bool pop(T& value) {
+        if (!wait_for([&]() { return try_pop(value); }) && !try_pop(value)) {
+            return false;
+        }
+        notify();
+        return true;
+    }
+    
+    /**
+     * @brief Reject further pushes and wake every waiting thread
+     */
+    void close() {
+        closed_.store(true, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(mutex_);
+        cv_.notify_all();
+    }
+    
+    /**
+     * @brief Accept pushes again after close()
+     *
+     * Only valid while no other thread uses the queue.
+     */
+    void reopen() noexcept { closed_.store(false, std::memory_order_release); }
+    
+    bool closed() const noexcept { return closed_.load(std::memory_order_acquire); }
+    
+    /**
+     * @brief Number of queued values (approximate while other threads are active)
+     */
+    size_t size() const noexcept {
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        const size_t head = head_.load(std::memory_order_acquire);
+        return head > tail ? head - tail : 0;
+    }
+    
+    size_t capacity() const noexcept { return mask_ + 1; }
+    
+    /**
+     * @brief Largest number of queued values seen since construction or reset_high_water()
+     */
+    size_t high_water() const noexcept { return high_water_.load(std::memory_order_relaxed); }
+    
+    void reset_high_water() noexcept { high_water_.store(size(), std::memory_order_relaxed); }
+};
+
+} // namespace Utils
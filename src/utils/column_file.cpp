@@ -0,0 +1,247 @@
+#include "column_file.hpp"
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Utils {
+
+namespace {
+
+size_t align_up(size_t value, size_t alignment) noexcept {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+std::runtime_error system_error(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+bool known_type(uint32_t type) noexcept {
+    return type >= static_cast<uint32_t>(ColumnType::FLOAT64) && type <= static_cast<uint32_t>(ColumnType::UINT64);
+}
+
+// rows * width * element size, or SIZE_MAX on overflow
+size_t block_size(size_t rows, size_t width, ColumnType type) noexcept {
+    const size_t element = element_size(type);
+    if (width != 0 && rows > std::numeric_limits<size_t>::max() / width / element) {
+        return std::numeric_limits<size_t>::max();
+    }
+    return rows * width * element;
+}
+
+const ColumnInfo* lookup(const std::vector<ColumnInfo>& columns, const std::string& name) noexcept {
+    for (const ColumnInfo& info : columns) {
+        if (info.name == name) {
+            return &info;
+        }
+    }
+    return nullptr;
+}
+
+const ColumnInfo& lookup(const std::vector<ColumnInfo>& columns, const std::string& name, ColumnType type) {
+    const ColumnInfo* info = lookup(columns, name);
+    if (info == nullptr) {
+        throw std::invalid_argument("Column file has no column '" + name + "'");
+    }
+    if (info->type != type) {
+        throw std::invalid_argument("Column '" + name + "' is " + to_string(info->type) + ", not " + to_string(type));
+    }
+    return *info;
+}
+
+} // namespace
+
+const char* to_string(ColumnType type) noexcept {
+    switch (type) {
+        case ColumnType::FLOAT64: return "FLOAT64";
+        case ColumnType::UINT32: return "UINT32";
+        case ColumnType::UINT8: return "UINT8";
+        case ColumnType::UINT64: return "UINT64";
+        default: return "UNKNOWN";
+    }
+}
+
+size_t element_size(ColumnType type) noexcept {
+    switch (type) {
+        case ColumnType::FLOAT64: return sizeof(double);
+        case ColumnType::UINT32: return sizeof(uint32_t);
+        case ColumnType::UINT8: return sizeof(uint8_t);
+        case ColumnType::UINT64: return sizeof(uint64_t);
+        default: return 1;
+    }
+}
+
+// ColumnFileWriter implementation
+ColumnFileWriter::ColumnFileWriter(const std::string& path, size_t rows, const std::vector<ColumnSpec>& columns)
+    : path_(path), rows_(rows) {
+    size_t offset = align_up(sizeof(ColumnFileHeader) + columns.size() * sizeof(ColumnDescriptor), ALIGNMENT);
+    columns_.reserve(columns.size());
+    for (const ColumnSpec& spec : columns) {
+        if (spec.name.empty() || spec.name.size() >= ColumnDescriptor::NAME_CAPACITY) {
+            throw std::invalid_argument("Column name must have 1 to 31 characters: '" + spec.name + "'");
+        }
+        if (lookup(columns_, spec.name) != nullptr) {
+            throw std::invalid_argument("Duplicate column name '" + spec.name + "'");
+        }
+        if (spec.width == 0 || spec.width > std::numeric_limits<uint32_t>::max()) {
+            throw std::invalid_argument("Column '" + spec.name + "' needs a width of at least 1");
+        }
+        const size_t size = block_size(rows, spec.width, spec.type);
+        if (size == std::numeric_limits<size_t>::max()) {
+            throw std::invalid_argument("Column '" + spec.name + "' is too large");
+        }
+        columns_.push_back({spec.name, spec.type, spec.width, offset, size});
+        offset = align_up(offset + size, ALIGNMENT);
+    }
+    size_ = offset;
+    
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw system_error("Cannot create column file " + path);
+    }
+    // ftruncate() extends the file with zeros, typically without writing blocks
+    if (::ftruncate(fd, static_cast<off_t>(size_)) != 0) {
+        const std::runtime_error error = system_error("Cannot size column file " + path);
+        ::close(fd);
+        throw error;
+    }
+    void* mapping = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw system_error("Cannot map column file " + path);
+    }
+    data_ = static_cast<char*>(mapping);
+    
+    ColumnFileHeader header{};
+    header.version = ColumnFileHeader::VERSION;
+    header.byte_order = ColumnFileHeader::ENDIAN_MARK;
+    header.row_count = rows;
+    header.column_count = columns_.size();
+    header.file_size = size_;
+    std::memcpy(data_, &header, sizeof(header));
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        const ColumnInfo& info = columns_[i];
+        ColumnDescriptor descriptor{};
+        std::memcpy(descriptor.name, info.name.data(), info.name.size());
+        descriptor.type = static_cast<uint32_t>(info.type);
+        descriptor.width = static_cast<uint32_t>(info.width);
+        descriptor.offset = info.offset;
+        descriptor.size = info.size;
+        std::memcpy(data_ + sizeof(header) + i * sizeof(descriptor), &descriptor, sizeof(descriptor));
+    }
+}
+
+ColumnFileWriter::~ColumnFileWriter() {
+    release();
+}
+
+void ColumnFileWriter::release() noexcept {
+    if (data_ != nullptr) {
+        ::munmap(data_, size_);
+        data_ = nullptr;
+    }
+}
+
+void* ColumnFileWriter::find(const std::string& name, ColumnType type) const {
+    if (data_ == nullptr) {
+        throw std::invalid_argument("Column file " + path_ + " is already finished");
+    }
+    return data_ + lookup(columns_, name, type).offset;
+}
+
+void ColumnFileWriter::finish() noexcept {
+    if (data_ != nullptr) {
+        std::memcpy(data_, ColumnFileHeader::MAGIC, sizeof(ColumnFileHeader::MAGIC));
+        release();
+    }
+}
+
+// ColumnFileReader implementation
+ColumnFileReader::ColumnFileReader(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw system_error("Cannot open column file " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(ColumnFileHeader))) {
+        ::close(fd);
+        throw std::runtime_error("Not a column file: " + path);
+    }
+    size_ = static_cast<size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw system_error("Cannot map column file " + path);
+    }
+    data_ = static_cast<char*>(mapping);
+    
+    const auto invalid = [&](const std::string& reason) {
+        ::munmap(data_, size_);
+        data_ = nullptr;
+        return std::runtime_error("Invalid column file " + path + ": " + reason);
+    };
+    
+    ColumnFileHeader header;
+    std::memcpy(&header, data_, sizeof(header));
+    if (std::memcmp(header.magic, ColumnFileHeader::MAGIC, sizeof(header.magic)) != 0) {
+        throw invalid("bad magic (not a column file, or the writer did not finish)");
+    }
+    if (header.version != ColumnFileHeader::VERSION) {
+        throw invalid("unsupported version " + std::to_string(header.version));
+    }
+    if (header.byte_order != ColumnFileHeader::ENDIAN_MARK) {
+        throw invalid("written with a different byte order");
+    }
+    if (header.file_size != size_ ||
+        header.column_count > (size_ - sizeof(header)) / sizeof(ColumnDescriptor)) {
+        throw invalid("truncated");
+    }
+    
+    rows_ = static_cast<size_t>(header.row_count);
+    columns_.reserve(static_cast<size_t>(header.column_count));
+    for (size_t i = 0; i < header.column_count; ++i) {
+        ColumnDescriptor descriptor;
+        std::memcpy(&descriptor, data_ + sizeof(header) + i * sizeof(descriptor), sizeof(descriptor));
+        const size_t name_length = strnlen(descriptor.name, ColumnDescriptor::NAME_CAPACITY);
+        if (name_length == 0 || name_length == ColumnDescriptor::NAME_CAPACITY) {
+            throw invalid("bad name in column " + std::to_string(i));
+        }
+        const std::string name(descriptor.name, name_length);
+        if (!known_type(descriptor.type) || descriptor.width == 0) {
+            throw invalid("bad type or width in column '" + name + "'");
+        }
+        const ColumnType type = static_cast<ColumnType>(descriptor.type);
+        if (descriptor.offset % ColumnFileWriter::ALIGNMENT != 0 || descriptor.offset > size_ ||
+            descriptor.size > size_ - descriptor.offset ||
+            descriptor.size != block_size(rows_, descriptor.width, type)) {
+            throw invalid("column '" + name + "' lies outside the file");
+        }
+        columns_.push_back({name, type, descriptor.width, static_cast<size_t>(descriptor.offset),
+                            static_cast<size_t>(descriptor.size)});
+    }
+}
+
+ColumnFileReader::~ColumnFileReader() {
+    if (data_ != nullptr) {
+        ::munmap(data_, size_);
+    }
+}
+
+const void* ColumnFileReader::find(const std::string& name, ColumnType type) const {
+    return data_ + lookup(columns_, name, type).offset;
+}
+
+bool ColumnFileReader::has_column(const std::string& name) const noexcept {
+    return lookup(columns_, name) != nullptr;
+}
+
+const ColumnInfo* ColumnFileReader::column(const std::string& name) const noexcept {
+    return lookup(columns_, name);
+}
+
+} // namespace Utils
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file column_file.hpp
+ * @brief Memory-mapped columnar file format for bulk pricing output
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * A column file holds a fixed number of rows and any number of named,
+ * typed columns, each stored as one contiguous block that starts on a
+ * 64-byte boundary, so a reader can mmap the file and use every column in
+ * place (NumPy, Arrow buffers or SIMD loads) without copying. A column may
+ * have several values per row (`width`), stored row-major, for matrices
+ * such as scenario × position P&L.
+ *
+ * Layout (native byte order, checked through byte_order):
+ *
+ *     offset 0    ColumnFileHeader (64 bytes)
+ *     offset 64   ColumnDescriptor[column_count] (64 bytes each)
+ *     ...         column blocks at the offsets given in the descriptors
+ *
+ * ColumnFileWriter sizes and maps the file up front and hands out pointers
+ * into the mapping, so producers such as OptionPricer::price_batch() write
+ * their results straight into the file. The magic is written last, by
+ * finish(), so a file whose writer did not finish is rejected by readers.
+ */
+
+namespace Utils {
+
+/**
+ * @brief Element type of a column
+ */
+enum class ColumnType : uint32_t {
+    FLOAT64 = 1,
+    UINT32 = 2,
+    UINT8 = 3,
+    UINT64 = 4
+};
+
+/**
+ * @brief Convert column type to string representation
+ * @param type Type to convert
+ * @return String representation of type
+ */
+const char* to_string(ColumnType type) noexcept;
+
+/**
+ * @brief Size in bytes of one element of a column type
+ */
+size_t element_size(ColumnType type) noexcept;
+
+/**
+ * @brief Fixed file header
+ */
+struct ColumnFileHeader {
+    static constexpr char MAGIC[8] = {'Q', 'L', 'C', 'O', 'L', 'S', '0', '1'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t ENDIAN_MARK = 0x01020304;
+    
+    char magic[8];              ///< MAGIC once the writer has finished, zero before
+    uint32_t version;           ///< Format version
+    uint32_t byte_order;        ///< ENDIAN_MARK as written by the producer
+    uint64_t row_count;         ///< Rows in every column
+    uint64_t column_count;      ///< Descriptors following the header
+    uint64_t file_size;         ///< Total size in bytes
+    uint8_t reserved[24];
+};
+
+/**
+ * @brief Location and type of one column
+ */
+struct ColumnDescriptor {
+    static constexpr size_t NAME_CAPACITY = 32;
+    
+    char name[NAME_CAPACITY];   ///< NUL-padded column name
+    uint32_t type;              ///< ColumnType
+    uint32_t width;             ///< Values per row
+    uint64_t offset;            ///< Byte offset of the block from the file start
+    uint64_t size;              ///< Block size in bytes (row_count * width * element size)
+    uint8_t reserved[8];
+};
+
+static_assert(sizeof(ColumnFileHeader) == 64, "ColumnFileHeader is a file format");
+static_assert(sizeof(ColumnDescriptor) == 64, "ColumnDescriptor is a file format");
+
+/**
+ * @brief Column requested from ColumnFileWriter
+ */
+struct ColumnSpec {
+    std::string name;           ///< Unique name, shorter than ColumnDescriptor::NAME_CAPACITY
+    ColumnType type;
+    size_t width = 1;           ///< Values per row
+};
+
+/**
+ * @brief Column of an open file, as seen by readers and writers
+ */
+struct ColumnInfo {
+    std::string name;
+    ColumnType type;
+    size_t width;
+    size_t offset;
+    size_t size;
+};
+
+/**
+ * @brief Creates a column file and exposes its columns for writing
+ *
+ * Not thread-safe to construct or finish; the column pointers may be
+ * written from any number of threads.
+ */
+class ColumnFileWriter {
+private:
+    std::string path_;
+    char* data_ = nullptr;
+    size_t size_ = 0;
+    size_t rows_ = 0;
+    std::vector<ColumnInfo> columns_;
+    
+    void* find(const std::string& name, ColumnType type) const;
+    void release() noexcept;
+
+public:
+    /// Alignment of every column block
+    static constexpr size_t ALIGNMENT = 64;
+    
+    /**
+     * @brief Create (or truncate) a file with the given columns and map it
+     *
+     * Column blocks are zero-filled.
+     *
+     * @param path File path
+     * @param rows Rows per column
+     * @param columns Column names, types and widths
+     * @throws std::invalid_argument on empty, duplicate or over-long names or a zero width
+     * @throws std::runtime_error if the file cannot be created or mapped
+     */
+    ColumnFileWriter(const std::string& path, size_t rows, const std::vector<ColumnSpec>& columns);
+    
+    /**
+     * @brief Unmap the file; an unfinished file stays invalid for readers
+     */
+    ~ColumnFileWriter();
+    
+    ColumnFileWriter(const ColumnFileWriter&) = delete;
+    ColumnFileWriter& operator=(const ColumnFileWriter&) = delete;
+    
+    /**
+     * @brief Writable column block
+     * @throws std::invalid_argument if no column has this name and type
+     */
+    double* float64(const std::string& name) { return static_cast<double*>(find(name, ColumnType::FLOAT64)); }
+    uint32_t* uint32(const std::string& name) { return static_cast<uint32_t*>(find(name, ColumnType::UINT32)); }
+    uint8_t* uint8(const std::string& name) { return static_cast<uint8_t*>(find(name, ColumnType::UINT8)); }
+    uint64_t* uint64(const std::string& name) { return static_cast<uint64_t*>(find(name, ColumnType::UINT64)); }
+    
+    /**
+     * @brief Mark the file complete and unmap it
+     *
+     * Column pointers are invalid afterwards. Data reaches the page cache,
+     * so readers on the same machine see it at once; durability on disk is
+     * left to the kernel's write-back.
+     */
+    void finish() noexcept;
+    
+    size_t rows() const noexcept { return rows_; }
+    const std::vector<ColumnInfo>& columns() const noexcept { return columns_; }
+    const std::string& path() const noexcept { return path_; }
+};
+
+/**
+ * @brief Read-only zero-copy view of a column file
+ */
+class ColumnFileReader {
+private:
+    char* data_ = nullptr;
+    size_t size_ = 0;
+    size_t rows_ = 0;
+    std::vector<ColumnInfo> columns_;
+    
+    const void* find(const std::string& name, ColumnType type) const;
+
+public:
+    /**
+     * @brief Map a finished file and validate its header and descriptors
+     * @param path File path
+     * @throws std::runtime_error if the file cannot be mapped or is not a valid, finished column file
+     */
+    explicit ColumnFileReader(const std::string& path);
+    
+    ~ColumnFileReader();
+    
+    ColumnFileReader(const ColumnFileReader&) = delete;
+    ColumnFileReader& operator=(const ColumnFileReader&) = delete;
+    
+    /**
+     * @brief Column block inside the mapping
+     * @throws std::invalid_argument if no column has this name and type
+     */
+    const double* float64(const std::string& name) const { return static_cast<const double*>(find(name, ColumnType::FLOAT64)); }
+    const uint32_t* uint32(const std::string& name) const { return static_cast<const uint32_t*>(find(name, ColumnType::UINT32)); }
+    const uint8_t* uint8(const std::string& name) const { return static_cast<const uint8_t*>(find(name, ColumnType::UINT8)); }
+    const uint64_t* uint64(const std::string& name) const { return static_cast<const uint64_t*>(find(name, ColumnType::UINT64)); }
+    
+    /**
+     * @brief Whether a column with this name exists
+     */
+    bool has_column(const std::string& name) const noexcept;
+    
+    /**
+     * @brief Descriptor of a column by name (nullptr if absent)
+     */
+    const ColumnInfo* column(const std::string& name) const noexcept;
+    
+    size_t rows() const noexcept { return rows_; }
+    const std::vector<ColumnInfo>& columns() const noexcept { return columns_; }
+};
+
+} // namespace Utils
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+
+/**
+ * @file format_string.hpp
+ * @brief Pre-split log format strings with compile-time validation
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * A FormatString records the position of every replacement field once, when
+ * it is constructed. Constructed from a string literal in a constant
+ * expression (as the LOG_* macros in logger.hpp do), parsing happens at
+ * compile time and malformed fields or argument-count mismatches are
+ * compile errors. Formatting then copies literal segments straight from the
+ * original text without creating substrings.
+ *
+ * Supported replacement fields:
+ * - {}       Stream the argument with default formatting
+ * - {:.Nf}   Fixed notation with N digits after the point (N <= 999)
+ * - {:.Ne}   Scientific notation with N digits after the point
+ * - {:.Ng}   General notation with N significant digits
+ * - {:.N}    Precision N with the stream's current notation
+ */
+
+namespace Utils {
+
+/**
+ * @brief One replacement field inside a FormatString
+ */
+struct FormatPlaceholder {
+    size_t begin = 0;       ///< Offset of the opening '{'
+    size_t end = 0;         ///< Offset one past the closing '}'
+    int precision = -1;     ///< Requested precision, -1 for the stream default
+    char presentation = 0;  ///< 'f', 'e', 'g', or 0 for the stream default
+};
+
+/**
+ * @brief Non-owning view of a format string with pre-parsed placeholders
+ *
+ * The referenced text must outlive the FormatString; string literals and
+ * the std::string argument of a logging call both do.
+ */
+class FormatString {
+public:
+    static constexpr size_t MAX_PLACEHOLDERS = 16;
+    
+    /**
+     * @brief Parse a string literal (compile-time in constant expressions)
+     * @param text Format text
+     */
+    template<size_t N>
+    constexpr FormatString(const char (&text)[N]) noexcept
+        : FormatString(text, bounded_length(text, N)) {}
+    
+    /**
+     * @brief Parse a runtime format string
+     * @param text Format text
+     */
+    FormatString(const std::string& text) noexcept
+        : FormatString(text.data(), text.size()) {}
+    
+    /**
+     * @brief Parse text of known length
+     * @param text Format text
+     * @param length Number of characters
+     */
+    constexpr FormatString(const char* text, size_t length) noexcept
+        : text_(text), length_(length), count_(0), valid_(true), placeholders_{} {
+        parse();
+    }
+    
+    constexpr const char* data() const noexcept { return text_; }
+    constexpr size_t size() const noexcept { return length_; }
+    
+    /**
+     * @brief Number of replacement fields found
+     */
+    constexpr size_t placeholder_count() const noexcept { return count_; }
+    
+    /**
+     * @brief Whether every '{' started a well-formed field and the field limit was respected
+     */
+    constexpr bool valid() const noexcept { return valid_; }
+    
+    constexpr const FormatPlaceholder& placeholder(size_t index) const noexcept {
+        return placeholders_[index];
+    }
+
+private:
+    const char* text_;
+    size_t length_;
+    size_t count_;
+    bool valid_;
+    FormatPlaceholder placeholders_[MAX_PLACEHOLDERS];
+    
+    template<size_t N>
+    static constexpr size_t bounded_length(const char (&text)[N], size_t capacity) noexcept {
+        size_t length = 0;
+        while (length < capacity && text[length] != '\0') {
+            ++length;
+        }
+        return length;
+    }
+    
+    static constexpr bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+    
+    // Malformed fields are flagged and left in the output as literal text
+    constexpr void parse() noexcept {
+        size_t i = 0;
+        while (i < length_) {
+            if (text_[i] != '{') {
+                ++i;
+                continue;
+            }
+            
+            FormatPlaceholder field;
+            field.begin = i;
+            size_t j = i + 1;
+            
+            if (j < length_ && text_[j] == ':') {
+                ++j;
+                if (j < length_ && text_[j] == '.') {
+                    ++j;
+                    int precision = 0;
+                    size_t digits = 0;
+                    while (j < length_ && is_digit(text_[j]) && digits < 3) {
+                        precision = precision * 10 + (text_[j] - '0');
+                        ++j;
+                        ++digits;
+                    }
+                    if (digits == 0) {
+                        valid_ = false;
+                        ++i;
+                        continue;
+                    }
+                    field.precision = precision;
+                }
+                if (j < length_ && (text_[j] == 'f' || text_[j] == 'e' || text_[j] == 'g')) {
+                    field.presentation = text_[j];
+                    ++j;
+                }
+            }
+            
+            if (j >= length_ || text_[j] != '}') {
+                valid_ = false;
+                ++i;
+                continue;
+            }
+            
+            if (count_ == MAX_PLACEHOLDERS) {
+                valid_ = false;
+                return;
+            }
+            
+            field.end = j + 1;
+            placeholders_[count_++] = field;
+            i = j + 1;
+        }
+    }
+};
+
+namespace detail {
+
+/**
+ * @brief Count macro arguments without evaluating them (use in decltype only)
+ */
+template<typename... Args>
+std::integral_constant<size_t, sizeof...(Args)> count_log_args(const Args&...);
+
+} // namespace detail
+
+} // namespace Utils
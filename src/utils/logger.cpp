@@ -1,4 +1,5 @@
 #include "logger.hpp"
+#include "async_log_backend.hpp"
 #include <iostream>
 #include <filesystem>
 #include <algorithm>
@@ -15,6 +16,8 @@ std::string Logger::log_filename_ = "quantlib.log";
 size_t Logger::max_file_size_ = 10 * 1024 * 1024;  // 10MB
 size_t Logger::current_file_size_ = 0;
 int Logger::max_log_files_ = 5;
+bool Logger::file_pending_ = true;
+std::atomic<bool> Logger::async_enabled_{false};
 
 // Global logger instance
 Utils::Logger g_logger("Global");
@@ -30,15 +33,26 @@ std::string to_string(LogLevel level) {
     }
 }
 
-Logger::Logger(const std::string& component_name) 
-    : component_name_(component_name) {
-    // Initialize logging on first logger creation
-    static std::once_flag init_flag;
-    std::call_once(init_flag, []() {
-        configure();  // Use default configuration
-    });
+std::string to_string(LogBackend backend) {
+    switch (backend) {
+        case LogBackend::SYNC:  return "SYNC";
+        case LogBackend::ASYNC: return "ASYNC";
+        default:                return "UNKNOWN";
+    }
+}
+
+std::string to_string(OverflowPolicy policy) {
+    switch (policy) {
+        case OverflowPolicy::DROP:  return "DROP";
+        case OverflowPolicy::BLOCK: return "BLOCK";
+        default:                    return "UNKNOWN";
+    }
 }
 
+// The defaults above are the configure() defaults; the file opens on the first record
+Logger::Logger(const std::string& component_name) 
+    : component_name_(component_name) {}
+
 Logger::~Logger() {
     flush();
 }
@@ -60,27 +74,28 @@ void Logger::configure(
     max_file_size_ = max_file_size;
     max_log_files_ = max_log_files;
     
-    // Close existing log file if open
+    // Close existing log file if open; the new one is opened by the next record
     if (log_file_.is_open()) {
         log_file_.close();
     }
-    
-    // Open new log file if file output is enabled
-    if (file_output_) {
-        log_file_.open(log_filename_, std::ios::app);
-        if (log_file_.is_open()) {
-            // Get current file size
-            log_file_.seekp(0, std::ios::end);
-            current_file_size_ = log_file_.tellp();
-            
-            // Write configuration message
-            std::string config_msg = "Logger configured - Level: " + to_string(min_level_) +
-                                   ", Console: " + (console_output_ ? "ON" : "OFF") +
-                                   ", File: " + (file_output_ ? "ON" : "OFF");
-            
-            log_file_ << get_timestamp() << " [INFO] [Logger] " << config_msg << std::endl;
-            current_file_size_ += config_msg.length() + 50;  // Approximate
-        }
+    file_pending_ = file_output_;
+}
+
+void Logger::open_log_file() {
+    file_pending_ = false;
+    log_file_.open(log_filename_, std::ios::app);
+    if (log_file_.is_open()) {
+        // Get current file size
+        log_file_.seekp(0, std::ios::end);
+        current_file_size_ = static_cast<size_t>(log_file_.tellp());
+        
+        // Write configuration message
+        std::string config_msg = "Logger configured - Level: " + to_string(min_level_) +
+                               ", Console: " + (console_output_ ? "ON" : "OFF") +
+                               ", File: " + (file_output_ ? "ON" : "OFF");
+        
+        log_file_ << get_timestamp() << " [INFO] [Logger] " << config_msg << std::endl;
+        current_file_size_ += config_msg.length() + 50;  // Approximate
     }
 }
 
@@ -140,6 +155,11 @@ void Logger::rotate_log_files() {
 }
 
 void Logger::write_log(LogLevel level, const std::string& message) {
+    if (async_enabled_.load(std::memory_order_acquire) &&
+        AsyncLogBackend::getInstance().enqueue(level, component_name_, message)) {
+        return;
+    }
+    
     std::lock_guard<std::mutex> lock(global_mutex_);
     
     std::string timestamp = get_timestamp();
@@ -162,6 +182,9 @@ void Logger::write_log(LogLevel level, const std::string& message) {
     }
     
     // File output
+    if (file_pending_) {
+        open_log_file();
+    }
     if (file_output_ && log_file_.is_open()) {
         log_file_ << full_message << std::endl;
         current_file_size_ += full_message.length() + 1;  // +1 for newline
@@ -173,11 +196,61 @@ void Logger::write_log(LogLevel level, const std::string& message) {
     }
 }
 
-void Logger::format_string(std::ostringstream& oss, const std::string& format) {
-    oss << format;
+void Logger::write_batch(const std::string& file_lines, const std::string& out_lines,
+                         const std::string& err_lines) {
+    std::lock_guard<std::mutex> lock(global_mutex_);
+    
+    // Console output, one write per stream per batch
+    if (console_output_) {
+        if (!out_lines.empty()) {
+            std::cout << out_lines << std::flush;
+        }
+        if (!err_lines.empty()) {
+            std::cerr << err_lines << std::flush;
+        }
+    }
+    
+    // File output
+    if (file_pending_ && !file_lines.empty()) {
+        open_log_file();
+    }
+    if (file_output_ && log_file_.is_open() && !file_lines.empty()) {
+        log_file_ << file_lines;
+        log_file_.flush();
+        current_file_size_ += file_lines.length();
+        
+        // Check if rotation is needed
+        if (current_file_size_ > max_file_size_) {
+            rotate_log_files();
+        }
+    }
+}
+
+void Logger::set_backend(LogBackend backend, const AsyncLogOptions& options) {
+    AsyncLogBackend& async_backend = AsyncLogBackend::getInstance();
+    
+    if (backend == LogBackend::ASYNC) {
+        async_backend.start(options);
+        async_enabled_.store(true, std::memory_order_release);
+    } else {
+        async_enabled_.store(false, std::memory_order_release);
+        async_backend.stop();
+    }
+}
+
+LogBackend Logger::get_backend() {
+    return async_enabled_.load(std::memory_order_acquire) ? LogBackend::ASYNC : LogBackend::SYNC;
+}
+
+AsyncLogStats Logger::get_async_stats() {
+    return AsyncLogBackend::getInstance().stats();
 }
 
 void Logger::flush() {
+    if (async_enabled_.load(std::memory_order_acquire)) {
+        AsyncLogBackend::getInstance().flush();
+    }
+    
     std::lock_guard<std::mutex> lock(global_mutex_);
     
     if (console_output_) {
@@ -196,7 +269,7 @@ PerformanceTimer::PerformanceTimer(Logger& logger, const std::string& operation_
     start_time_ = std::chrono::high_resolution_clock::now();
     
     if (logger_.is_enabled(log_level_)) {
-        logger_.debug("Starting operation: {}", operation_name_);
+        LOG_DEBUG(logger_, "Starting operation: {}", operation_name_);
     }
 }
 
@@ -205,15 +278,15 @@ PerformanceTimer::~PerformanceTimer() {
     
     if (logger_.is_enabled(log_level_)) {
         if (log_level_ == LogLevel::DEBUG) {
-            logger_.debug("Operation '{}' completed in {:.3f}ms", operation_name_, elapsed);
+            LOG_DEBUG(logger_, "Operation '{}' completed in {:.3f}ms", operation_name_, elapsed);
         } else if (log_level_ == LogLevel::INFO) {
-            logger_.info("Operation '{}' completed in {:.3f}ms", operation_name_, elapsed);
+            LOG_INFO(logger_, "Operation '{}' completed in {:.3f}ms", operation_name_, elapsed);
         } else if (log_level_ == LogLevel::WARNING) {
-            logger_.warning("Operation '{}' completed in {:.3f}ms", operation_name_, elapsed);
+            LOG_WARNING(logger_, "Operation '{}' completed in {:.3f}ms", operation_name_, elapsed);
         } else if (log_level_ == LogLevel::ERROR) {
-            logger_.error("Operation '{}' completed in {:.3f}ms", operation_name_, elapsed);
+            LOG_ERROR(logger_, "Operation '{}' completed in {:.3f}ms", operation_name_, elapsed);
         } else if (log_level_ == LogLevel::CRITICAL) {
-            logger_.critical("Operation '{}' completed in {:.3f}ms", operation_name_, elapsed);
+            LOG_CRITICAL(logger_, "Operation '{}' completed in {:.3f}ms", operation_name_, elapsed);
         }
     }
 }
@@ -221,7 +294,7 @@ PerformanceTimer::~PerformanceTimer() {
 double PerformanceTimer::elapsed_ms() const {
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time_);
-    return duration.count() / 1000.0;  // Convert to milliseconds
+    return static_cast<double>(duration.count()) / 1000.0;  // Convert to milliseconds
 }
 
 } // namespace Utils
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <fstream>
 #include <memory>
@@ -8,6 +10,7 @@
 #include <chrono>
 #include <iomanip>
 #include <thread>
+#include "format_string.hpp"
 
 /**
  * @file logger.hpp
@@ -21,6 +24,7 @@
  * - Multiple log levels (DEBUG, INFO, WARNING, ERROR, CRITICAL)
  * - Configurable output destinations (console, file, both)
  * - Automatic log rotation
+ * - Optional asynchronous backend with per-thread lock-free queues
  * - Performance monitoring integration
  * - Memory-efficient string formatting
  */
@@ -45,6 +49,55 @@ enum class LogLevel {
  */
 std::string to_string(LogLevel level);
 
+/**
+ * @brief Log delivery backend
+ */
+enum class LogBackend {
+    SYNC = 0,       ///< Format and write on the calling thread under a global mutex
+    ASYNC = 1       ///< Enqueue to a per-thread ring; a background thread writes
+};
+
+/**
+ * @brief Behaviour of the async backend when a producer's queue is full
+ */
+enum class OverflowPolicy {
+    DROP = 0,       ///< Discard the record and count it; logging never blocks
+    BLOCK = 1       ///< Wait for the writer thread to free a slot
+};
+
+/**
+ * @brief Convert log backend to string representation
+ * @param backend Backend to convert
+ * @return "SYNC" or "ASYNC"
+ */
+std::string to_string(LogBackend backend);
+
+/**
+ * @brief Convert overflow policy to string representation
+ * @param policy Policy to convert
+ * @return "DROP" or "BLOCK"
+ */
+std::string to_string(OverflowPolicy policy);
+
+/**
+ * @brief Tuning options for the asynchronous backend
+ */
+struct AsyncLogOptions {
+    size_t queue_capacity = 1024;                           ///< Records per producer thread (power of two)
+    OverflowPolicy overflow_policy = OverflowPolicy::DROP;  ///< Full-queue behaviour
+    int flush_interval_ms = 50;                             ///< Maximum delay before a batch is written
+};
+
+/**
+ * @brief Delivery counters of the asynchronous backend
+ */
+struct AsyncLogStats {
+    uint64_t enqueued = 0;  ///< Records accepted into a queue
+    uint64_t dropped = 0;   ///< Records discarded by the DROP policy
+    uint64_t written = 0;   ///< Records written by the background thread
+    uint64_t batches = 0;   ///< Batches handed to the console/file sinks
+};
+
 /**
  * @brief Thread-safe logger class
  * 
@@ -64,6 +117,10 @@ private:
     static size_t max_file_size_;       ///< Maximum log file size before rotation
     static size_t current_file_size_;   ///< Current log file size
     static int max_log_files_;          ///< Maximum number of log files to keep
+    static bool file_pending_;          ///< Log file not opened yet (opened by the first record)
+    static std::atomic<bool> async_enabled_;  ///< Whether records go to AsyncLogBackend
+    
+    friend class AsyncLogBackend;
     
     /**
      * @brief Get current timestamp as string
@@ -82,12 +139,26 @@ private:
      */
     static void rotate_log_files();
     
+    /**
+     * @brief Open the configured log file on first use (caller holds global_mutex_)
+     */
+    static void open_log_file();
+    
     /**
      * @brief Write log message to destinations
      * @param level Log level
      * @param message Formatted message
      */
     void write_log(LogLevel level, const std::string& message);
+    
+    /**
+     * @brief Write a batch of pre-formatted lines from the async writer thread
+     * @param file_lines All newline-terminated lines, in order, for the log file
+     * @param out_lines Lines below ERROR, for stdout
+     * @param err_lines ERROR/CRITICAL lines, for stderr
+     */
+    static void write_batch(const std::string& file_lines, const std::string& out_lines,
+                            const std::string& err_lines);
 
 public:
     /**
@@ -111,6 +182,11 @@ public:
     
     /**
      * @brief Configure global logger settings
+     * 
+     * Only records the settings: the log file is opened (and its
+     * "Logger configured" line written) by the first record that reaches
+     * it, so processes that never log touch no file.
+     * 
      * @param min_level Minimum log level to output
      * @param console_output Enable console output
      * @param file_output Enable file output
@@ -129,11 +205,11 @@ public:
     
     /**
      * @brief Log debug message
-     * @param format Format string (printf-style)
+     * @param format Format string with {} / {:.Nf} placeholders
      * @param args Format arguments
      */
     template<typename... Args>
-    void debug(const std::string& format, Args&&... args) {
+    void debug(const FormatString& format, Args&&... args) {
         if (min_level_ <= LogLevel::DEBUG) {
             log(LogLevel::DEBUG, format, std::forward<Args>(args)...);
         }
@@ -141,11 +217,11 @@ public:
     
     /**
      * @brief Log info message
-     * @param format Format string (printf-style)
+     * @param format Format string with {} / {:.Nf} placeholders
      * @param args Format arguments
      */
     template<typename... Args>
-    void info(const std::string& format, Args&&... args) {
+    void info(const FormatString& format, Args&&... args) {
         if (min_level_ <= LogLevel::INFO) {
             log(LogLevel::INFO, format, std::forward<Args>(args)...);
         }
@@ -153,11 +229,11 @@ public:
     
     /**
      * @brief Log warning message
-     * @param format Format string (printf-style)
+     * @param format Format string with {} / {:.Nf} placeholders
      * @param args Format arguments
      */
     template<typename... Args>
-    void warning(const std::string& format, Args&&... args) {
+    void warning(const FormatString& format, Args&&... args) {
         if (min_level_ <= LogLevel::WARNING) {
             log(LogLevel::WARNING, format, std::forward<Args>(args)...);
         }
@@ -165,11 +241,11 @@ public:
     
     /**
      * @brief Log error message
-     * @param format Format string (printf-style)
+     * @param format Format string with {} / {:.Nf} placeholders
      * @param args Format arguments
      */
     template<typename... Args>
-    void error(const std::string& format, Args&&... args) {
+    void error(const FormatString& format, Args&&... args) {
         if (min_level_ <= LogLevel::ERROR) {
             log(LogLevel::ERROR, format, std::forward<Args>(args)...);
         }
@@ -177,18 +253,60 @@ public:
     
     /**
      * @brief Log critical message
-     * @param format Format string (printf-style)
+     * @param format Format string with {} / {:.Nf} placeholders
      * @param args Format arguments
      */
     template<typename... Args>
-    void critical(const std::string& format, Args&&... args) {
+    void critical(const FormatString& format, Args&&... args) {
         if (min_level_ <= LogLevel::CRITICAL) {
             log(LogLevel::CRITICAL, format, std::forward<Args>(args)...);
         }
     }
     
+    /**
+     * @brief Log with a format string parsed and checked at compile time
+     * 
+     * Target of the LOG_* macros, which have already checked the level;
+     * prefer the macros over calling this directly.
+     * @param level Log level
+     * @param format Format string parsed in a constant expression
+     * @param args Format arguments
+     */
+    template<typename... Args>
+    void log_checked(LogLevel level, const FormatString& format, Args&&... args) {
+        log(level, format, std::forward<Args>(args)...);
+    }
+    
+    /**
+     * @brief Select the delivery backend
+     * 
+     * Switching to ASYNC starts the background writer thread; switching
+     * back to SYNC drains all queued records and stops it. Calling with
+     * ASYNC again applies new options (a new queue capacity takes effect
+     * for each thread on its next log call).
+     * 
+     * @param backend SYNC or ASYNC
+     * @param options Async queue and flush settings (ignored for SYNC)
+     */
+    static void set_backend(LogBackend backend, const AsyncLogOptions& options = AsyncLogOptions());
+    
+    /**
+     * @brief Get the active delivery backend
+     * @return Current backend
+     */
+    static LogBackend get_backend();
+    
+    /**
+     * @brief Get async delivery counters
+     * @return Counters (all zero if ASYNC was never enabled)
+     */
+    static AsyncLogStats get_async_stats();
+    
     /**
      * @brief Flush all pending log messages
+     * 
+     * In ASYNC mode this waits (up to one second) until the writer thread
+     * has written everything enqueued before the call.
      */
     static void flush();
     
@@ -209,14 +327,14 @@ private:
     /**
      * @brief Internal logging function with formatting
      * @param level Log level
-     * @param format Format string
+     * @param format Pre-parsed format string
      * @param args Format arguments
      */
     template<typename... Args>
-    void log(LogLevel level, const std::string& format, Args&&... args) {
+    void log(LogLevel level, const FormatString& format, Args&&... args) {
         try {
             std::ostringstream oss;
-            format_string(oss, format, std::forward<Args>(args)...);
+            format_to(oss, format, std::forward<Args>(args)...);
             write_log(level, oss.str());
         } catch (const std::exception& e) {
             // Fallback logging in case of formatting errors
@@ -225,28 +343,63 @@ private:
     }
     
     /**
-     * @brief Format string with arguments (recursive base case)
+     * @brief Write literal segments and arguments in placeholder order
+     * 
+     * Placeholders without an argument are kept as literal text; surplus
+     * arguments are ignored.
      * @param oss Output string stream
-     * @param format Format string
+     * @param format Pre-parsed format string
+     * @param args Format arguments
      */
-    void format_string(std::ostringstream& oss, const std::string& format);
+    template<typename... Args>
+    static void format_to(std::ostringstream& oss, const FormatString& format, Args&&... args) {
+        size_t cursor = 0;
+        if constexpr (sizeof...(Args) > 0) {
+            size_t index = 0;
+            (format_argument(oss, format, cursor, index, std::forward<Args>(args)), ...);
+        }
+        oss.write(format.data() + cursor, static_cast<std::streamsize>(format.size() - cursor));
+    }
     
     /**
-     * @brief Format string with arguments (recursive case)
+     * @brief Write the literal text before the next placeholder, then one argument
      * @param oss Output string stream
-     * @param format Format string
-     * @param arg First argument
-     * @param args Remaining arguments
+     * @param format Pre-parsed format string
+     * @param cursor Offset of the first unwritten character (updated)
+     * @param index Next placeholder index (updated)
+     * @param arg Argument for that placeholder
      */
-    template<typename T, typename... Args>
-    void format_string(std::ostringstream& oss, const std::string& format, T&& arg, Args&&... args) {
-        size_t pos = format.find("{}");
-        if (pos != std::string::npos) {
-            oss << format.substr(0, pos) << std::forward<T>(arg);
-            format_string(oss, format.substr(pos + 2), std::forward<Args>(args)...);
-        } else {
-            oss << format;
+    template<typename T>
+    static void format_argument(std::ostringstream& oss, const FormatString& format,
+                                size_t& cursor, size_t& index, T&& arg) {
+        if (index >= format.placeholder_count()) {
+            return;
+        }
+        
+        const FormatPlaceholder& field = format.placeholder(index++);
+        oss.write(format.data() + cursor, static_cast<std::streamsize>(field.begin - cursor));
+        cursor = field.end;
+        
+        if (field.precision < 0 && field.presentation == 0) {
+            oss << std::forward<T>(arg);
+            return;
+        }
+        
+        const std::ios_base::fmtflags saved_flags = oss.flags();
+        const std::streamsize saved_precision = oss.precision();
+        if (field.presentation == 'f') {
+            oss.setf(std::ios_base::fixed, std::ios_base::floatfield);
+        } else if (field.presentation == 'e') {
+            oss.setf(std::ios_base::scientific, std::ios_base::floatfield);
+        } else if (field.presentation == 'g') {
+            oss.unsetf(std::ios_base::floatfield);
+        }
+        if (field.precision >= 0) {
+            oss.precision(field.precision);
         }
+        oss << std::forward<T>(arg);
+        oss.flags(saved_flags);
+        oss.precision(saved_precision);
     }
 };
 
@@ -299,6 +452,39 @@ public:
 #define PERF_TIMER_LEVEL(logger, name, level) \
     Utils::PerformanceTimer _perf_timer(logger, name, level)
 
+/**
+ * @brief Log macros with compile-time format checking and lazy arguments
+ * 
+ * Usage: LOG_INFO(logger_, "Priced {} options in {:.3f}ms", count, elapsed);
+ * 
+ * The format must be a string literal. It is parsed at compile time, and a
+ * malformed field or a placeholder/argument count mismatch fails the build.
+ * When the level is disabled, the arguments are not evaluated.
+ */
+#define LOG_DEBUG(logger, ...)    UTILS_LOG_AT_LEVEL(logger, Utils::LogLevel::DEBUG, __VA_ARGS__)
+#define LOG_INFO(logger, ...)     UTILS_LOG_AT_LEVEL(logger, Utils::LogLevel::INFO, __VA_ARGS__)
+#define LOG_WARNING(logger, ...)  UTILS_LOG_AT_LEVEL(logger, Utils::LogLevel::WARNING, __VA_ARGS__)
+#define LOG_ERROR(logger, ...)    UTILS_LOG_AT_LEVEL(logger, Utils::LogLevel::ERROR, __VA_ARGS__)
+#define LOG_CRITICAL(logger, ...) UTILS_LOG_AT_LEVEL(logger, Utils::LogLevel::CRITICAL, __VA_ARGS__)
+
+// The format literal leads __VA_ARGS__: one copy is parsed, the lambda drops the other
+#define UTILS_LOG_FORMAT_TEXT(format, ...) format
+
+#define UTILS_LOG_AT_LEVEL(logger, level, ...) \
+    do { \
+        if (Utils::Logger::is_enabled(level)) { \
+            constexpr Utils::FormatString utils_log_format_(UTILS_LOG_FORMAT_TEXT(__VA_ARGS__, 0)); \
+            static_assert(utils_log_format_.valid(), "Malformed log format string"); \
+            static_assert(utils_log_format_.placeholder_count() + 1 == \
+                          decltype(Utils::detail::count_log_args(__VA_ARGS__))::value, \
+                          "Log format placeholder count does not match argument count"); \
+            [&](const char*, auto&&... utils_log_args_) { \
+                (logger).log_checked(level, utils_log_format_, \
+                                     std::forward<decltype(utils_log_args_)>(utils_log_args_)...); \
+            }(__VA_ARGS__); \
+        } \
+    } while (0)
+
 } // namespace Utils
 
 // Global logger instance for convenience
@@ -0,0 +1,678 @@
+#include "memory_profiler.hpp"
+#include "arena.hpp"
+#include "metrics.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <iomanip>
+#include <sstream>
+
+#if defined(__GLIBC__)
+#include <execinfo.h>
+#endif
+
+namespace Utils {
+
+// Static member definitions
+std::unique_ptr<MemoryProfiler> MemoryProfiler::instance_;
+std::mutex MemoryProfiler::instance_mutex_;
+
+namespace detail {
+
+/**
+ * @brief Allocation counters of one thread
+ *
+ * Only the owning thread writes a shard (plain load/store, no lock
+ * prefix); readers sum all shards with relaxed loads. A shard is released
+ * when its thread exits and reused by the next new thread, so the list is
+ * bounded by the peak number of live threads.
+ */
+struct alignas(64) ThreadCounters {
+    std::atomic<size_t> allocated{0};
+    std::atomic<size_t> deallocated{0};
+    std::atomic<size_t> allocations{0};
+    std::atomic<size_t> deallocations{0};
+    std::atomic<bool> in_use{true};
+    bool shared = false;        ///< Written by several threads (uses atomic read-modify-write)
+    ThreadCounters* next = nullptr;
+    
+    // Sampling state, owner only
+    uint32_t sampling_generation = 0;
+    size_t sample_interval = 0;
+    size_t sample_bytes = 0;
+    size_t allocations_until_sample = 0;
+    size_t bytes_until_sample = 0;
+    
+    void add(std::atomic<size_t>& counter, size_t value) noexcept {
+        if (shared) {
+            counter.fetch_add(value, std::memory_order_relaxed);
+        } else {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+    }
+};
+
+} // namespace detail
+
+namespace {
+
+// Published once the singleton is fully constructed; read by operator new
+std::atomic<MemoryProfiler*> g_profiler{nullptr};
+
+// Set while the profiler itself is running, so that allocations made by its
+// own bookkeeping (map nodes, strings, log messages) are not recorded
+thread_local bool t_inside_profiler = false;
+
+// Sum of the high-water marks reported by arenas
+std::atomic<size_t> g_arena_high_water{0};
+
+// This thread's counter shard, and whether the thread has released it
+thread_local detail::ThreadCounters* t_counters = nullptr;
+thread_local bool t_counters_released = false;
+
+// Record one current_usage sample every this many allocations of a thread
+constexpr size_t USAGE_SAMPLE_INTERVAL = 1024;
+constexpr size_t MAX_USAGE_SAMPLES = 4096;
+
+/**
+ * @brief Prefix of every block handed out by MemoryProfiler::allocate()
+ */
+struct alignas(std::max_align_t) BlockHeader {
+    size_t size;
+    uint32_t epoch;     ///< Profiler epoch when the block was counted (0 = not counted)
+    uint32_t sampled;   ///< Non-zero if the block is in the leak table
+};
+
+class ReentrancyGuard {
+public:
+    ReentrancyGuard() : previous_(t_inside_profiler) { t_inside_profiler = true; }
+    ~ReentrancyGuard() { t_inside_profiler = previous_; }
+    
+    ReentrancyGuard(const ReentrancyGuard&) = delete;
+    ReentrancyGuard& operator=(const ReentrancyGuard&) = delete;
+
+private:
+    bool previous_;
+};
+
+// Hands the shard back when its thread exits
+class CounterLease {
+public:
+    ~CounterLease() {
+        if (counters != nullptr) {
+            counters->in_use.store(false, std::memory_order_release);
+            t_counters = nullptr;
+            t_counters_released = true;
+        }
+    }
+    
+    detail::ThreadCounters* counters = nullptr;
+};
+
+thread_local CounterLease t_lease;
+
+template<typename... Args>
+void log_at(Logger& logger, LogLevel level, const std::string& format, Args&&... args) {
+    switch (level) {
+        case LogLevel::DEBUG:    logger.debug(format, std::forward<Args>(args)...); break;
+        case LogLevel::INFO:     logger.info(format, std::forward<Args>(args)...); break;
+        case LogLevel::WARNING:  logger.warning(format, std::forward<Args>(args)...); break;
+        case LogLevel::ERROR:    logger.error(format, std::forward<Args>(args)...); break;
+        case LogLevel::CRITICAL: logger.critical(format, std::forward<Args>(args)...); break;
+    }
+}
+
+} // namespace
+
+MemoryProfiler::MemoryProfiler()
+    : tracked_count_(0), counters_(nullptr), shared_counters_(new detail::ThreadCounters()),
+      peak_usage_(0), epoch_(1), sampling_generation_(1), sample_interval_(1), sample_bytes_(0),
+      logger_("MemoryProfiler"), enabled_(false), track_call_stacks_(false),
+      max_tracked_allocations_(100000) {
+    shared_counters_->shared = true;
+}
+
+MemoryProfiler::~MemoryProfiler() {
+    g_profiler.store(nullptr, std::memory_order_release);
+    
+    detail::ThreadCounters* counters = counters_.load(std::memory_order_acquire);
+    while (counters != nullptr) {
+        detail::ThreadCounters* next = counters->next;
+        delete counters;
+        counters = next;
+    }
+}
+
+MemoryProfiler& MemoryProfiler::getInstance() {
+    MemoryProfiler* profiler = g_profiler.load(std::memory_order_acquire);
+    if (profiler != nullptr) {
+        return *profiler;
+    }
+    
+    std::lock_guard<std::mutex> lock(instance_mutex_);
+    if (!instance_) {
+        ReentrancyGuard guard;
+        instance_.reset(new MemoryProfiler());
+        g_profiler.store(instance_.get(), std::memory_order_release);
+    }
+    return *instance_;
+}
+
+void MemoryProfiler::initialize(bool enabled, bool track_call_stacks, size_t max_tracked_allocations,
+                                size_t sample_interval, size_t sample_bytes) {
+    MemoryProfiler& profiler = getInstance();
+    
+    profiler.track_call_stacks_.store(track_call_stacks, std::memory_order_relaxed);
+    profiler.max_tracked_allocations_.store(max_tracked_allocations, std::memory_order_relaxed);
+    profiler.sample_interval_.store(sample_interval, std::memory_order_relaxed);
+    profiler.sample_bytes_.store(sample_bytes, std::memory_order_relaxed);
+    profiler.sampling_generation_.fetch_add(1, std::memory_order_release);
+    profiler.setEnabled(enabled);
+    
+    LOG_INFO(profiler.logger_, "Memory profiler initialized: enabled={}, call_stacks={}, max_tracked={}, sample_interval={}, sample_bytes={}",
+                          enabled, track_call_stacks, max_tracked_allocations, sample_interval, sample_bytes);
+}
+
+void* MemoryProfiler::allocate(size_t size, const char* file, int line, const char* function) {
+    if (size > SIZE_MAX - sizeof(BlockHeader)) {
+        throw std::bad_alloc();
+    }
+    BlockHeader* header = static_cast<BlockHeader*>(std::malloc(sizeof(BlockHeader) + size));
+    if (header == nullptr) {
+        throw std::bad_alloc();
+    }
+    header->size = size;
+    header->epoch = 0;
+    header->sampled = 0;
+    void* ptr = header + 1;
+    
+    Metrics::add(MetricCounter::ALLOCATIONS);
+    Metrics::add(MetricCounter::ALLOCATED_BYTES, size);
+    
+    MemoryProfiler* profiler = g_profiler.load(std::memory_order_acquire);
+    if (profiler != nullptr && !t_inside_profiler && profiler->isEnabled()) {
+        // Read before counting: a concurrent reset() then drops this block rather than
+        // counting its deallocation without its allocation
+        header->epoch = profiler->epoch_.load(std::memory_order_acquire);
+        header->sampled = profiler->recordAllocation(ptr, size, file, line, function) ? 1u : 0u;
+    }
+    return ptr;
+}
+
+void MemoryProfiler::deallocate(void* ptr) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+    BlockHeader* header = static_cast<BlockHeader*>(ptr) - 1;
+    
+    MemoryProfiler* profiler = g_profiler.load(std::memory_order_acquire);
+    if (profiler != nullptr && header->epoch != 0 && !t_inside_profiler) {
+        try {
+            profiler->releaseBlock(ptr, header->size, header->sampled != 0, header->epoch);
+        } catch (...) {
+            // Never let bookkeeping failures escape operator delete
+        }
+    }
+    std::free(header);
+}
+
+void MemoryProfiler::recordArenaHighWater(size_t growth) noexcept {
+    g_arena_high_water.fetch_add(growth, std::memory_order_relaxed);
+}
+
+bool MemoryProfiler::recordAllocation(void* ptr, size_t size, const char* file,
+                                      int line, const char* function) {
+    if (!isEnabled() || ptr == nullptr) {
+        return false;
+    }
+    ReentrancyGuard guard;
+    
+    detail::ThreadCounters& counters = localCounters();
+    counters.add(counters.allocated, size);
+    counters.add(counters.allocations, 1);
+    
+    if (!counters.shared &&
+        counters.allocations.load(std::memory_order_relaxed) % USAGE_SAMPLE_INTERVAL == 0) {
+        const size_t usage = currentUsage();
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        if (usage_history_.size() < MAX_USAGE_SAMPLES) {
+            usage_history_.push_back(usage);
+        }
+    }
+    
+    if (!shouldSample(counters, size)) {
+        return false;
+    }
+    updatePeakUsage();
+    return track(ptr, size, file, line, function);
+}
+
+size_t MemoryProfiler::recordDeallocation(void* ptr) {
+    if (!isEnabled() || ptr == nullptr) {
+        return 0;
+    }
+    ReentrancyGuard guard;
+    
+    size_t size = 0;
+    if (!untrack(ptr, size)) {
+        // Not sampled, allocated before profiling was enabled, or beyond the tracking limit
+        return 0;
+    }
+    
+    detail::ThreadCounters& counters = localCounters();
+    counters.add(counters.deallocated, size);
+    counters.add(counters.deallocations, 1);
+    return size;
+}
+
+void MemoryProfiler::releaseBlock(void* ptr, size_t size, bool sampled, uint32_t epoch) {
+    if (!isEnabled() || epoch != epoch_.load(std::memory_order_acquire)) {
+        return;
+    }
+    ReentrancyGuard guard;
+    
+    if (sampled) {
+        size_t tracked_size = 0;
+        untrack(ptr, tracked_size);
+    }
+    
+    detail::ThreadCounters& counters = localCounters();
+    counters.add(counters.deallocated, size);
+    counters.add(counters.deallocations, 1);
+}
+
+MemoryStats MemoryProfiler::getStats() const {
+    const MemoryStats raw = rawTotals();
+    
+    MemoryStats stats;
+    stats.total_allocated = raw.total_allocated.load() - baseline_.total_allocated.load(std::memory_order_relaxed);
+    stats.total_deallocated = raw.total_deallocated.load() - baseline_.total_deallocated.load(std::memory_order_relaxed);
+    stats.allocation_count = raw.allocation_count.load() - baseline_.allocation_count.load(std::memory_order_relaxed);
+    stats.deallocation_count = raw.deallocation_count.load() - baseline_.deallocation_count.load(std::memory_order_relaxed);
+    
+    // Shards are read one at a time, so a block freed on another thread may be
+    // seen without its allocation
+    const size_t allocated = stats.total_allocated.load();
+    const size_t deallocated = stats.total_deallocated.load();
+    const size_t allocations = stats.allocation_count.load();
+    const size_t deallocations = stats.deallocation_count.load();
+    stats.current_usage = allocated > deallocated ? allocated - deallocated : 0;
+    stats.active_allocations = allocations > deallocations ? allocations - deallocations : 0;
+    
+    size_t peak = peak_usage_.load(std::memory_order_relaxed);
+    const size_t current = stats.current_usage.load();
+    while (current > peak &&
+           !peak_usage_.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+    stats.peak_usage = std::max(peak, current);
+    stats.arena_high_water = g_arena_high_water.load(std::memory_order_relaxed);
+    return stats;
+}
+
+size_t MemoryProfiler::getActiveAllocationCount() const {
+    return tracked_count_.load(std::memory_order_relaxed);
+}
+
+std::vector<AllocationInfo> MemoryProfiler::detectLeaks() const {
+    ReentrancyGuard guard;
+    
+    std::vector<AllocationInfo> leaks;
+    leaks.reserve(tracked_count_.load(std::memory_order_relaxed));
+    for (const TableShard& shard : table_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto& pair : shard.allocations) {
+            leaks.push_back(pair.second);
+        }
+    }
+    
+    // Largest first, so reports show the most significant leaks
+    std::sort(leaks.begin(), leaks.end(), [](const AllocationInfo& a, const AllocationInfo& b) {
+        return a.size > b.size;
+    });
+    return leaks;
+}
+
+void MemoryProfiler::printReport(LogLevel log_level) const {
+    if (!Logger::is_enabled(log_level)) {
+        return;
+    }
+    
+    const MemoryStats stats = getStats();
+    Logger& logger = const_cast<Logger&>(logger_);
+    
+    log_at(logger, log_level, "Memory report:");
+    log_at(logger, log_level, "  Total allocated:   {} ({} allocations)",
+           formatBytes(stats.total_allocated.load()), stats.allocation_count.load());
+    log_at(logger, log_level, "  Total deallocated: {} ({} deallocations)",
+           formatBytes(stats.total_deallocated.load()), stats.deallocation_count.load());
+    log_at(logger, log_level, "  Current usage:     {}", formatBytes(stats.current_usage.load()));
+    log_at(logger, log_level, "  Peak usage:        {}", formatBytes(stats.peak_usage.load()));
+    log_at(logger, log_level, "  Active allocations: {}", stats.active_allocations.load());
+    if (stats.arena_high_water.load() != 0) {
+        log_at(logger, log_level, "  Arena high water:  {}", formatBytes(stats.arena_high_water.load()));
+    }
+    if (getSampleInterval() != 1) {
+        log_at(logger, log_level, "  Leak table:        {} sampled (1 in {} allocations, 1 per {} bytes; 0 = off)",
+               getActiveAllocationCount(), getSampleInterval(), getSampleBytes());
+    }
+}
+
+void MemoryProfiler::printLeakReport(size_t max_leaks) const {
+    const std::vector<AllocationInfo> leaks = detectLeaks();
+    Logger& logger = const_cast<Logger&>(logger_);
+    
+    if (leaks.empty()) {
+        logger.info("No memory leaks detected");
+        return;
+    }
+    
+    size_t total = 0;
+    for (const auto& leak : leaks) {
+        total += leak.size;
+    }
+    logger.warning("Detected {} unfreed allocations totalling {}", leaks.size(), formatBytes(total));
+    
+    const size_t shown = std::min(max_leaks, leaks.size());
+    for (size_t i = 0; i < shown; ++i) {
+        const AllocationInfo& leak = leaks[i];
+        logger.warning("  {} at {}:{} ({})", formatBytes(leak.size),
+                       leak.file != nullptr ? leak.file : "<unknown>", leak.line,
+                       leak.function != nullptr ? leak.function : "<unknown>");
+    }
+}
+
+void MemoryProfiler::reset() {
+    ReentrancyGuard guard;
+    
+    // Blocks counted before this point are not counted when freed
+    epoch_.fetch_add(1, std::memory_order_acq_rel);
+    for (TableShard& shard : table_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.allocations.clear();
+    }
+    tracked_count_.store(0, std::memory_order_relaxed);
+    
+    const MemoryStats raw = rawTotals();
+    baseline_.total_allocated.store(raw.total_allocated.load(), std::memory_order_relaxed);
+    baseline_.total_deallocated.store(raw.total_deallocated.load(), std::memory_order_relaxed);
+    baseline_.allocation_count.store(raw.allocation_count.load(), std::memory_order_relaxed);
+    baseline_.deallocation_count.store(raw.deallocation_count.load(), std::memory_order_relaxed);
+    peak_usage_.store(0, std::memory_order_relaxed);
+    
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    usage_history_.clear();
+}
+
+std::string MemoryProfiler::formatBytes(size_t bytes) {
+    static const char* units[] = {"B", "KB", "MB", "GB", "TB"};
+    
+    double value = static_cast<double>(bytes);
+    size_t unit = 0;
+    while (value >= 1024.0 && unit + 1 < sizeof(units) / sizeof(units[0])) {
+        value /= 1024.0;
+        ++unit;
+    }
+    
+    std::ostringstream oss;
+    if (unit == 0) {
+        oss << bytes << " " << units[unit];
+    } else {
+        oss << std::fixed << std::setprecision(1) << value << " " << units[unit];
+    }
+    return oss.str();
+}
+
+double MemoryProfiler::getUsageTrend(size_t window_size) const {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    
+    const size_t n = std::min(window_size, usage_history_.size());
+    if (n < 2) {
+        return 0.0;
+    }
+    
+    // Least-squares slope over the most recent n samples
+    const size_t first = usage_history_.size() - n;
+    double sum_x = 0.0, sum_y = 0.0, sum_xy = 0.0, sum_xx = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const double x = static_cast<double>(i);
+        const double y = static_cast<double>(usage_history_[first + i]);
+        sum_x += x;
+        sum_y += y;
+        sum_xy += x * y;
+        sum_xx += x * x;
+    }
+    const double count = static_cast<double>(n);
+    return (count * sum_xy - sum_x * sum_y) / (count * sum_xx - sum_x * sum_x);
+}
+
+detail::ThreadCounters& MemoryProfiler::localCounters() {
+    if (t_counters != nullptr) {
+        return *t_counters;
+    }
+    if (t_counters_released) {
+        // Allocations from thread_local destructors after the lease was returned
+        return *shared_counters_;
+    }
+    
+    detail::ThreadCounters* head = counters_.load(std::memory_order_acquire);
+    detail::ThreadCounters* counters = nullptr;
+    for (detail::ThreadCounters* c = head; c != nullptr; c = c->next) {
+        bool expected = false;
+        if (c->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            counters = c;
+            break;
+        }
+    }
+    
+    if (counters == nullptr) {
+        counters = new detail::ThreadCounters();
+        counters->next = head;
+        while (!counters_.compare_exchange_weak(counters->next, counters, std::memory_order_release,
+                                                std::memory_order_relaxed)) {
+        }
+    }
+    
+    counters->sampling_generation = 0;
+    t_counters = counters;
+    t_lease.counters = counters;
+    return *counters;
+}
+
+bool MemoryProfiler::shouldSample(detail::ThreadCounters& counters, size_t size) const noexcept {
+    if (counters.shared) {
+        return false;
+    }
+    
+    const uint32_t generation = sampling_generation_.load(std::memory_order_acquire);
+    if (counters.sampling_generation != generation) {
+        counters.sampling_generation = generation;
+        counters.sample_interval = sample_interval_.load(std::memory_order_relaxed);
+        counters.sample_bytes = sample_bytes_.load(std::memory_order_relaxed);
+        counters.allocations_until_sample = counters.sample_interval;
+        counters.bytes_until_sample = counters.sample_bytes;
+    }
+    
+    bool sample = false;
+    if (counters.sample_interval != 0 && --counters.allocations_until_sample == 0) {
+        counters.allocations_until_sample = counters.sample_interval;
+        sample = true;
+    }
+    if (counters.sample_bytes != 0) {
+        if (size >= counters.bytes_until_sample) {
+            // Carry the overshoot so that the sampling rate stays one per sample_bytes
+            const size_t overshoot = size - counters.bytes_until_sample;
+            counters.bytes_until_sample = counters.sample_bytes - overshoot % counters.sample_bytes;
+            sample = true;
+        } else {
+            counters.bytes_until_sample -= size;
+        }
+    }
+    return sample;
+}
+
+bool MemoryProfiler::track(void* ptr, size_t size, const char* file, int line, const char* function) {
+    if (tracked_count_.fetch_add(1, std::memory_order_relaxed) >=
+        max_tracked_allocations_.load(std::memory_order_relaxed)) {
+        tracked_count_.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (function == nullptr && track_call_stacks_.load(std::memory_order_relaxed)) {
+        function = internCallStack();
+    }
+    
+    TableShard& shard = tableShard(ptr);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (!shard.allocations.insert_or_assign(ptr, AllocationInfo(size, file, line, function)).second) {
+        // Address reused without a recorded deallocation
+        tracked_count_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+bool MemoryProfiler::untrack(void* ptr, size_t& size) {
+    TableShard& shard = tableShard(ptr);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.allocations.find(ptr);
+    if (it == shard.allocations.end()) {
+        return false;
+    }
+    size = it->second.size;
+    shard.allocations.erase(it);
+    tracked_count_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+MemoryStats MemoryProfiler::rawTotals() const {
+    MemoryStats totals;
+    auto accumulate = [&totals](const detail::ThreadCounters& counters) {
+        totals.total_allocated += counters.allocated.load(std::memory_order_relaxed);
+        totals.total_deallocated += counters.deallocated.load(std::memory_order_relaxed);
+        totals.allocation_count += counters.allocations.load(std::memory_order_relaxed);
+        totals.deallocation_count += counters.deallocations.load(std::memory_order_relaxed);
+    };
+    
+    for (const detail::ThreadCounters* c = counters_.load(std::memory_order_acquire); c != nullptr; c = c->next) {
+        accumulate(*c);
+    }
+    accumulate(*shared_counters_);
+    return totals;
+}
+
+size_t MemoryProfiler::currentUsage() const {
+    const MemoryStats raw = rawTotals();
+    const size_t allocated = raw.total_allocated.load() - baseline_.total_allocated.load(std::memory_order_relaxed);
+    const size_t deallocated = raw.total_deallocated.load() - baseline_.total_deallocated.load(std::memory_order_relaxed);
+    return allocated > deallocated ? allocated - deallocated : 0;
+}
+
+void MemoryProfiler::updatePeakUsage() const {
+    const size_t current = currentUsage();
+    size_t peak = peak_usage_.load(std::memory_order_relaxed);
+    while (current > peak &&
+           !peak_usage_.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+}
+
+MemoryProfiler::TableShard& MemoryProfiler::tableShard(void* ptr) noexcept {
+    // Fibonacci hash of the address; the low bits are always zero
+    const uint64_t address = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)) >> 4;
+    return table_[static_cast<size_t>((address * 0x9E3779B97F4A7C15ull) >> 58)];
+}
+
+const char* MemoryProfiler::internCallStack() {
+    std::string stack = getCallStack();
+    if (stack.empty()) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return call_stacks_.insert(std::move(stack)).first->c_str();
+}
+
+std::string MemoryProfiler::getCallStack() const {
+#if defined(__GLIBC__)
+    void* frames[16];
+    const int depth = backtrace(frames, 16);
+    char** symbols = backtrace_symbols(frames, depth);
+    if (symbols == nullptr) {
+        return "";
+    }
+    
+    // Skip recordAllocation/getCallStack themselves
+    std::string stack;
+    for (int i = 2; i < depth; ++i) {
+        if (!stack.empty()) {
+            stack += " <- ";
+        }
+        stack += symbols[i];
+    }
+    std::free(symbols);
+    return stack;
+#else
+    return "";
+#endif
+}
+
+namespace {
+
+// Trackers read the profiler only if something built it: before that nothing is counted
+size_t profiled_usage() {
+    const MemoryProfiler* profiler = g_profiler.load(std::memory_order_acquire);
+    return profiler != nullptr ? profiler->getStats().current_usage.load() : 0;
+}
+
+} // namespace
+
+// ScopedMemoryTracker implementation
+ScopedMemoryTracker::ScopedMemoryTracker(const std::string& scope_name)
+    : scope_name_(scope_name),
+      initial_usage_(profiled_usage()),
+      start_time_(std::chrono::high_resolution_clock::now()),
+      logger_("MemoryTracker") {
+}
+
+ScopedMemoryTracker::~ScopedMemoryTracker() {
+    const auto elapsed = std::chrono::high_resolution_clock::now() - start_time_;
+    const double elapsed_ms = std::chrono::duration<double, std::milli>(elapsed).count();
+    LOG_DEBUG(logger_, "Scope '{}' used {} in {}ms (arena high water {})", scope_name_,
+                  MemoryProfiler::formatBytes(getCurrentUsage()), elapsed_ms,
+                  MemoryProfiler::formatBytes(getArenaHighWater()));
+}
+
+size_t ScopedMemoryTracker::getCurrentUsage() const {
+    const size_t current = profiled_usage();
+    return current > initial_usage_ ? current - initial_usage_ : 0;
+}
+
+size_t ScopedMemoryTracker::getArenaHighWater() const {
+    return Arena::local().high_water_mark();
+}
+
+} // namespace Utils
+
+#ifdef ENABLE_MEMORY_PROFILING
+
+void* operator new(size_t size) {
+    return Utils::MemoryProfiler::allocate(size);
+}
+
+void* operator new[](size_t size) {
+    return Utils::MemoryProfiler::allocate(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    Utils::MemoryProfiler::deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    Utils::MemoryProfiler::deallocate(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    Utils::MemoryProfiler::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    Utils::MemoryProfiler::deallocate(ptr);
+}
+
+#endif // ENABLE_MEMORY_PROFILING
@@ -1,9 +1,14 @@
 #pragma once
 
 #include <memory>
+#include <array>
 #include <atomic>
+#include <cstdlib>
+#include <new>
 #include <mutex>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
 #include <chrono>
 #include <vector>
@@ -23,6 +28,14 @@
  * - Peak memory monitoring
  * - Thread-safe operation
  * - Integration with custom allocators
+ *
+ * Allocation and deallocation counts are kept in per-thread counter shards
+ * that only their owning thread writes, so the hot path takes no lock and
+ * shares no cache line; getStats() sums the shards on demand. Only sampled
+ * allocations (every Nth allocation and/or one per N bytes, per thread)
+ * are entered in the leak table, which is itself split into independently
+ * locked shards. With the default interval of 1 every allocation is
+ * sampled and the profiler behaves as a full tracker.
  */
 
 namespace Utils {
@@ -32,20 +45,24 @@ namespace Utils {
  */
 struct AllocationInfo {
     size_t size;                    ///< Size of allocation in bytes
-    std::string file;               ///< Source file where allocation occurred
+    const char* file;               ///< Source file where allocation occurred (static storage, may be nullptr)
     int line;                       ///< Line number where allocation occurred
-    std::string function;           ///< Function name where allocation occurred
+    const char* function;           ///< Function name or call stack (static storage, may be nullptr)
     std::chrono::system_clock::time_point timestamp;  ///< When allocation occurred
     std::thread::id thread_id;      ///< Thread that made the allocation
     
-    AllocationInfo() : size(0), line(0), timestamp(std::chrono::system_clock::now()) {}
+    AllocationInfo() : size(0), file(nullptr), line(0), function(nullptr) {}
     
-    AllocationInfo(size_t s, const std::string& f, int l, const std::string& func)
-        : size(s), file(f), line(l), function(func), 
+    AllocationInfo(size_t s, const char* f, int l, const char* func)
+        : size(s), file(f), line(l), function(func),
           timestamp(std::chrono::system_clock::now()),
           thread_id(std::this_thread::get_id()) {}
 };
 
+namespace detail {
+struct ThreadCounters;
+}
+
 /**
  * @brief Memory usage statistics
  */
@@ -57,6 +74,24 @@ struct MemoryStats {
     std::atomic<size_t> allocation_count{0};    ///< Number of allocations
     std::atomic<size_t> deallocation_count{0};  ///< Number of deallocations
     std::atomic<size_t> active_allocations{0};  ///< Current active allocations
+    std::atomic<size_t> arena_high_water{0};    ///< Sum of the Arena high-water marks
+    
+    MemoryStats() = default;
+    
+    /**
+     * @brief Snapshot copy (each counter is loaded individually)
+     */
+    MemoryStats(const MemoryStats& other)
+        : total_allocated(other.total_allocated.load()),
+          total_deallocated(other.total_deallocated.load()),
+          current_usage(other.current_usage.load()),
+          peak_usage(other.peak_usage.load()),
+          allocation_count(other.allocation_count.load()),
+          deallocation_count(other.deallocation_count.load()),
+          active_allocations(other.active_allocations.load()),
+          arena_high_water(other.arena_high_water.load()) {}
+    
+    MemoryStats& operator=(const MemoryStats&) = delete;
     
     /**
      * @brief Get memory efficiency ratio
@@ -64,7 +99,7 @@ struct MemoryStats {
      */
     double efficiency_ratio() const {
         size_t allocated = total_allocated.load();
-        return allocated > 0 ? static_cast<double>(total_deallocated.load()) / allocated : 0.0;
+        return allocated > 0 ? static_cast<double>(total_deallocated.load()) / static_cast<double>(allocated) : 0.0;
     }
     
     /**
@@ -73,7 +108,7 @@ struct MemoryStats {
      */
     double average_allocation_size() const {
         size_t count = allocation_count.load();
-        return count > 0 ? static_cast<double>(total_allocated.load()) / count : 0.0;
+        return count > 0 ? static_cast<double>(total_allocated.load()) / static_cast<double>(count) : 0.0;
     }
 };
 
@@ -86,23 +121,50 @@ struct MemoryStats {
  */
 class MemoryProfiler {
 private:
+    /// Leak table partition, selected by pointer hash
+    struct TableShard {
+        mutable std::mutex mutex;
+        std::unordered_map<void*, AllocationInfo> allocations;
+    };
+    static constexpr size_t TABLE_SHARDS = 64;
+    
     static std::unique_ptr<MemoryProfiler> instance_;
     static std::mutex instance_mutex_;
     
-    mutable std::mutex allocations_mutex_;
-    std::unordered_map<void*, AllocationInfo> active_allocations_;
-    MemoryStats stats_;
+    std::array<TableShard, TABLE_SHARDS> table_;
+    std::atomic<size_t> tracked_count_;         ///< Entries in table_
+    std::atomic<detail::ThreadCounters*> counters_;         ///< Lock-free list of thread shards (never shrinks)
+    std::unique_ptr<detail::ThreadCounters> shared_counters_;   ///< Used by threads that are exiting
+    MemoryStats baseline_;                      ///< Raw shard totals at the last reset()
+    mutable std::atomic<size_t> peak_usage_;
+    std::atomic<uint32_t> epoch_;               ///< Incremented by reset(); stale blocks are not counted
+    std::atomic<uint32_t> sampling_generation_; ///< Incremented when the sampling settings change
+    std::atomic<size_t> sample_interval_;
+    std::atomic<size_t> sample_bytes_;
+    
+    mutable std::mutex state_mutex_;            ///< Guards usage_history_ and call_stacks_
+    std::vector<size_t> usage_history_;         ///< Sampled current_usage
+    std::unordered_set<std::string> call_stacks_;   ///< Interned call stacks referenced by the table
     Logger logger_;
-    bool enabled_;
-    bool track_call_stacks_;
-    size_t max_tracked_allocations_;
+    std::atomic<bool> enabled_;
+    std::atomic<bool> track_call_stacks_;
+    std::atomic<size_t> max_tracked_allocations_;
     
     // Private constructor for singleton
     MemoryProfiler();
 
 public:
+    ~MemoryProfiler();
+    
+    MemoryProfiler(const MemoryProfiler&) = delete;
+    MemoryProfiler& operator=(const MemoryProfiler&) = delete;
+    
     /**
-     * @brief Get singleton instance
+     * @brief Get singleton instance, built on first use
+     * 
+     * Only profiling calls build it; ScopedMemoryTracker and the global
+     * operator new read it only once it exists.
+     * 
      * @return Reference to memory profiler instance
      */
     static MemoryProfiler& getInstance();
@@ -112,35 +174,69 @@ public:
      * @param enabled Enable memory tracking
      * @param track_call_stacks Enable call stack tracking (expensive)
      * @param max_tracked_allocations Maximum number of allocations to track
+     * @param sample_interval Enter every Nth allocation of each thread in the leak table (1 = all, 0 = none)
+     * @param sample_bytes Also enter one allocation per N bytes allocated by each thread (0 = off)
      */
     static void initialize(bool enabled = true, bool track_call_stacks = false, 
-                          size_t max_tracked_allocations = 100000);
+                          size_t max_tracked_allocations = 100000,
+                          size_t sample_interval = 1, size_t sample_bytes = 0);
     
     /**
-     * @brief Enable or disable memory profiling
-     * @param enabled True to enable profiling
+     * @brief Allocate memory with malloc and record it
+     *
+     * The block carries a small header with its size and sampling state,
+     * so deallocate() accounts for it exactly without a table lookup.
+     * Used by TrackedAllocator and the global operator new.
+     *
+     * @param size Size of allocation
+     * @param file Source file name (string literal)
+     * @param line Line number
+     * @param function Function name (string literal)
+     * @return Pointer to the allocated memory
+     * @throws std::bad_alloc if the allocation fails
      */
-    void setEnabled(bool enabled) { enabled_ = enabled; }
+    static void* allocate(size_t size, const char* file = nullptr, int line = 0,
+                          const char* function = nullptr);
+    
+    /**
+     * @brief Free memory obtained from allocate() and record it
+     * @param ptr Pointer returned by allocate() (nullptr is ignored)
+     */
+    static void deallocate(void* ptr) noexcept;
+    
+    void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
     
     /**
      * @brief Check if profiling is enabled
      * @return True if profiling is enabled
      */
-    bool isEnabled() const { return enabled_; }
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief Add to the reported arena high-water total
+     * @param growth Increase of one Arena's high-water mark in bytes
+     */
+    static void recordArenaHighWater(size_t growth) noexcept;
     
     /**
      * @brief Record memory allocation
      * @param ptr Pointer to allocated memory
      * @param size Size of allocation
-     * @param file Source file name
+     * @param file Source file name (string literal)
      * @param line Line number
-     * @param function Function name
+     * @param function Function name (string literal)
+     * @return True if the allocation was sampled into the leak table
      */
-    void recordAllocation(void* ptr, size_t size, const char* file = nullptr, 
+    bool recordAllocation(void* ptr, size_t size, const char* file = nullptr, 
                          int line = 0, const char* function = nullptr);
     
     /**
      * @brief Record memory deallocation
+     *
+     * The size is looked up in the leak table, so only sampled allocations
+     * are accounted for; with a sample interval other than 1 prefer
+     * allocate()/deallocate(), which count every block.
+     *
      * @param ptr Pointer to deallocated memory
      * @return Size of deallocated memory (0 if not found)
      */
@@ -148,19 +244,31 @@ public:
     
     /**
      * @brief Get current memory statistics
-     * @return Memory usage statistics
+     * @return Memory usage statistics, summed over all thread shards
      */
-    MemoryStats getStats() const { return stats_; }
+    MemoryStats getStats() const;
     
     /**
      * @brief Get number of active allocations
-     * @return Number of unfreed allocations
+     * @return Number of unfreed allocations in the leak table (sampled allocations only)
      */
     size_t getActiveAllocationCount() const;
     
+    /**
+     * @brief Get the sampling interval
+     * @return Every how many allocations one is entered in the leak table (0 = by bytes only)
+     */
+    size_t getSampleInterval() const { return sample_interval_.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief Get the byte sampling period
+     * @return Bytes per sampled allocation (0 = off)
+     */
+    size_t getSampleBytes() const { return sample_bytes_.load(std::memory_order_relaxed); }
+    
     /**
      * @brief Check for memory leaks
-     * @return Vector of leak information
+     * @return Vector of leak information (sampled allocations only), largest first
      */
     std::vector<AllocationInfo> detectLeaks() const;
     
@@ -194,7 +302,7 @@ public:
      * @return True if current usage exceeds threshold
      */
     bool exceedsThreshold(size_t threshold_bytes) const {
-        return stats_.current_usage.load() > threshold_bytes;
+        return getStats().current_usage.load() > threshold_bytes;
     }
     
     /**
@@ -205,7 +313,16 @@ public:
     double getUsageTrend(size_t window_size = 10) const;
 
 private:
-    void updatePeakUsage();
+    detail::ThreadCounters& localCounters();
+    bool shouldSample(detail::ThreadCounters& counters, size_t size) const noexcept;
+    bool track(void* ptr, size_t size, const char* file, int line, const char* function);
+    bool untrack(void* ptr, size_t& size);
+    void releaseBlock(void* ptr, size_t size, bool sampled, uint32_t epoch);
+    MemoryStats rawTotals() const;
+    size_t currentUsage() const;
+    void updatePeakUsage() const;
+    TableShard& tableShard(void* ptr) noexcept;
+    const char* internCallStack();
     std::string getCallStack() const;
 };
 
@@ -236,6 +353,12 @@ public:
      * @return Memory used since construction
      */
     size_t getCurrentUsage() const;
+    
+    /**
+     * @brief Get the calling thread's arena high-water mark
+     * @return Largest Arena::local() usage so far in bytes
+     */
+    size_t getArenaHighWater() const;
 };
 
 /**
@@ -265,20 +388,11 @@ public:
     TrackedAllocator(const TrackedAllocator<U>&) {}
     
     pointer allocate(size_type n) {
-        size_t size = n * sizeof(T);
-        pointer ptr = static_cast<pointer>(std::malloc(size));
-        
-        if (!ptr) {
-            throw std::bad_alloc();
-        }
-        
-        MemoryProfiler::getInstance().recordAllocation(ptr, size, __FILE__, __LINE__, __FUNCTION__);
-        return ptr;
+        return static_cast<pointer>(MemoryProfiler::allocate(n * sizeof(T), __FILE__, __LINE__, __FUNCTION__));
     }
     
     void deallocate(pointer ptr, size_type) {
-        MemoryProfiler::getInstance().recordDeallocation(ptr);
-        std::free(ptr);
+        MemoryProfiler::deallocate(ptr);
     }
     
     template<typename U, typename... Args>
@@ -0,0 +1,436 @@
+#include "metrics.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace Utils {
+
+const char* to_string(MetricCounter metric) noexcept {
+    switch (metric) {
+        case MetricCounter::OPTIONS_PRICED:   return "options_priced_total";
+        case MetricCounter::OPTIONS_REJECTED: return "options_rejected_total";
+        case MetricCounter::IV_SOLVES:        return "iv_solves_total";
+        case MetricCounter::IV_ITERATIONS:    return "iv_iterations_total";
+        case MetricCounter::IV_FAILURES:      return "iv_failures_total";
+        case MetricCounter::CACHE_HITS:       return "cache_hits_total";
+        case MetricCounter::CACHE_MISSES:     return "cache_misses_total";
+        case MetricCounter::PIPELINE_BATCHES: return "pipeline_batches_total";
+        case MetricCounter::ALLOCATIONS:      return "allocations_total";
+        case MetricCounter::ALLOCATED_BYTES:  return "allocated_bytes_total";
+        default:                              return "unknown_total";
+    }
+}
+
+const char* to_string(MetricHistogram metric) noexcept {
+    switch (metric) {
+        case MetricHistogram::PRICE_BATCH:    return "price_batch_seconds";
+        case MetricHistogram::IV_BATCH:       return "iv_batch_seconds";
+        case MetricHistogram::PIPELINE_BATCH: return "pipeline_batch_seconds";
+        default:                              return "unknown_seconds";
+    }
+}
+
+const char* to_string(MetricGauge metric) noexcept {
+    switch (metric) {
+        case MetricGauge::PIPELINE_PARSED_DEPTH: return "pipeline_parsed_depth";
+        case MetricGauge::PIPELINE_PRICED_DEPTH: return "pipeline_priced_depth";
+        default:                                 return "unknown";
+    }
+}
+
+namespace {
+
+constexpr const char* PREFIX = "blackscholes_";
+
+// Smallest exported histogram bound: 2^8 ns = 256 ns
+constexpr unsigned FIRST_BOUND_EXPONENT = 8;
+
+// How often the server checks for shutdown while idle
+constexpr int POLL_INTERVAL_MS = 100;
+
+// Largest request header read before answering
+constexpr size_t REQUEST_BUFFER_SIZE = 4096;
+
+const char* help(MetricCounter metric) noexcept {
+    switch (metric) {
+        case MetricCounter::OPTIONS_PRICED:   return "Closed-form evaluations, quotes and batch rows priced";
+        case MetricCounter::OPTIONS_REJECTED: return "Closed-form rows and quotes not priced";
+        case MetricCounter::IV_SOLVES:        return "Implied volatility quotes solved";
+        case MetricCounter::IV_ITERATIONS:    return "Implied volatility root-finder iterations";
+        case MetricCounter::IV_FAILURES:      return "Implied volatility quotes that did not converge";
+        case MetricCounter::CACHE_HITS:       return "Pricing cache lookups served from the cache";
+        case MetricCounter::CACHE_MISSES:     return "Pricing cache lookups that priced the option";
+        case MetricCounter::PIPELINE_BATCHES: return "Quote pipeline batches priced";
+        case MetricCounter::ALLOCATIONS:      return "Allocations through the memory profiler";
+        case MetricCounter::ALLOCATED_BYTES:  return "Bytes allocated through the memory profiler";
+        default:                              return "";
+    }
+}
+
+const char* help(MetricHistogram metric) noexcept {
+    switch (metric) {
+        case MetricHistogram::PRICE_BATCH:    return "Latency of one closed-form batch pricing call";
+        case MetricHistogram::IV_BATCH:       return "Latency of one implied volatility batch solve";
+        case MetricHistogram::PIPELINE_BATCH: return "Latency of pricing one quote pipeline batch";
+        default:                              return "";
+    }
+}
+
+const char* help(MetricGauge metric) noexcept {
+    switch (metric) {
+        case MetricGauge::PIPELINE_PARSED_DEPTH: return "Quote pipeline batches waiting for a worker";
+        case MetricGauge::PIPELINE_PRICED_DEPTH: return "Quote pipeline batches waiting for the sink";
+        default:                                 return "";
+    }
+}
+
+// One thread's metrics; aligned so that no two shards share a cache line
+struct alignas(64) Shard {
+    struct Histogram {
+        std::atomic<uint64_t> buckets[HistogramSnapshot::BUCKETS];
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> sum;
+    };
+    
+    std::atomic<bool> claimed{false};
+    std::atomic<uint64_t> counters[METRIC_COUNTERS];
+    Histogram histograms[METRIC_HISTOGRAMS];
+};
+
+// Static storage: zero-initialized before any allocation, so operator new can record
+Shard g_shards[Metrics::MAX_THREADS];
+Shard g_shared;     // Threads without a shard of their own, and threads that are exiting
+
+thread_local Shard* t_shard = nullptr;
+
+// Returns the thread's shard to the pool when the thread exits
+struct ShardOwner {
+    ~ShardOwner() {
+        Shard* const shard = t_shard;
+        t_shard = &g_shared;
+        if (shard != nullptr && shard != &g_shared) {
+            shard->claimed.store(false, std::memory_order_release);
+        }
+    }
+};
+
+Shard& claim_shard() noexcept {
+    Shard* shard = &g_shared;
+    for (Shard& candidate : g_shards) {
+        bool expected = false;
+        if (!candidate.claimed.load(std::memory_order_relaxed) &&
+            candidate.claimed.compare_exchange_strong(expected, true, std::memory_order_acquire,
+                                                      std::memory_order_relaxed)) {
+            shard = &candidate;
+            break;
+        }
+    }
+    t_shard = shard;
+    static thread_local ShardOwner owner;
+    (void)owner;
+    return *shard;
+}
+
+inline Shard& local_shard() noexcept {
+    Shard* const shard = t_shard;
+    return shard != nullptr ? *shard : claim_shard();
+}
+
+// Owned shards have a single writer and need no read-modify-write
+inline void bump(std::atomic<uint64_t>& cell, uint64_t value, bool shared) noexcept {
+    if (shared) {
+        cell.fetch_add(value, std::memory_order_relaxed);
+    } else {
+        cell.store(cell.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+}
+
+template <typename Visit>
+void for_each_shard(Visit&& visit) {
+    for (Shard& shard : g_shards) {
+        visit(shard);
+    }
+    visit(g_shared);
+}
+
+std::runtime_error system_error(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+void send_all(int fd, const std::string& data) noexcept {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        const ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return;
+        }
+        sent += static_cast<size_t>(n);
+    }
+}
+
+} // namespace
+
+// HistogramSnapshot implementation
+uint64_t HistogramSnapshot::bucket_end(size_t index) noexcept {
+    if (index < SUB_BUCKETS) {
+        return index + 1;
+    }
+    const size_t shift = index / SUB_BUCKETS - 1;
+    return (SUB_BUCKETS + index % SUB_BUCKETS + 1) << shift;
+}
+
+uint64_t HistogramSnapshot::quantile(double q) const noexcept {
+    if (count == 0) {
+        return 0;
+    }
+    const double clamped = q < 0.0 ? 0.0 : (q > 1.0 ? 1.0 : q);
+    uint64_t rank = static_cast<uint64_t>(clamped * static_cast<double>(count) + 0.5);
+    rank = rank < 1 ? 1 : rank;
+    
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return bucket_end(i) - 1;
+        }
+    }
+    return bucket_end(BUCKETS - 1) - 1;
+}
+
+// Metrics implementation
+std::atomic<bool> Metrics::enabled_{false};
+Metrics::Gauge Metrics::gauges_[METRIC_GAUGES];
+
+void Metrics::add_enabled(MetricCounter metric, uint64_t value) noexcept {
+    Shard& shard = local_shard();
+    bump(shard.counters[static_cast<size_t>(metric)], value, &shard == &g_shared);
+}
+
+void Metrics::record_enabled(MetricHistogram metric, uint64_t nanoseconds) noexcept {
+    Shard& shard = local_shard();
+    const bool shared = &shard == &g_shared;
+    Shard::Histogram& histogram = shard.histograms[static_cast<size_t>(metric)];
+    bump(histogram.buckets[HistogramSnapshot::bucket(nanoseconds)], 1, shared);
+    bump(histogram.count, 1, shared);
+    bump(histogram.sum, nanoseconds, shared);
+}
+
+MetricsSnapshot Metrics::snapshot() noexcept {
+    MetricsSnapshot snapshot;
+    for_each_shard([&](const Shard& shard) {
+        for (size_t c = 0; c < METRIC_COUNTERS; ++c) {
+            snapshot.counters[c] += shard.counters[c].load(std::memory_order_relaxed);
+        }
+        for (size_t h = 0; h < METRIC_HISTOGRAMS; ++h) {
+            HistogramSnapshot& total = snapshot.histograms[h];
+            const Shard::Histogram& histogram = shard.histograms[h];
+            for (size_t b = 0; b < HistogramSnapshot::BUCKETS; ++b) {
+                total.buckets[b] += histogram.buckets[b].load(std::memory_order_relaxed);
+            }
+            total.count += histogram.count.load(std::memory_order_relaxed);
+            total.sum += histogram.sum.load(std::memory_order_relaxed);
+        }
+    });
+    for (size_t g = 0; g < METRIC_GAUGES; ++g) {
+        snapshot.gauges[g] = gauges_[g].value.load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+void Metrics::reset() noexcept {
+    for_each_shard([](Shard& shard) {
+        for (std::atomic<uint64_t>& counter : shard.counters) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        for (Shard::Histogram& histogram : shard.histograms) {
+            for (std::atomic<uint64_t>& bucket : histogram.buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+            histogram.count.store(0, std::memory_order_relaxed);
+            histogram.sum.store(0, std::memory_order_relaxed);
+        }
+    });
+    for (Gauge& gauge : gauges_) {
+        gauge.value.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::string Metrics::prometheus() {
+    const MetricsSnapshot snapshot = Metrics::snapshot();
+    std::ostringstream out;
+    
+    for (size_t c = 0; c < METRIC_COUNTERS; ++c) {
+        const MetricCounter metric = static_cast<MetricCounter>(c);
+        out << "# HELP " << PREFIX << to_string(metric) << ' ' << help(metric) << '\n'
+            << "# TYPE " << PREFIX << to_string(metric) << " counter\n"
+            << PREFIX << to_string(metric) << ' ' << snapshot.counters[c] << '\n';
+    }
+    
+    for (size_t g = 0; g < METRIC_GAUGES; ++g) {
+        const MetricGauge metric = static_cast<MetricGauge>(g);
+        out << "# HELP " << PREFIX << to_string(metric) << ' ' << help(metric) << '\n'
+            << "# TYPE " << PREFIX << to_string(metric) << " gauge\n"
+            << PREFIX << to_string(metric) << ' ' << snapshot.gauges[g] << '\n';
+    }
+    
+    for (size_t h = 0; h < METRIC_HISTOGRAMS; ++h) {
+        const MetricHistogram metric = static_cast<MetricHistogram>(h);
+        const HistogramSnapshot& histogram = snapshot.histograms[h];
+        const std::string name = std::string(PREFIX) + to_string(metric);
+        out << "# HELP " << name << ' ' << help(metric) << '\n'
+            << "# TYPE " << name << " histogram\n";
+        
+        // Cumulative counts below each power of two; the buckets never straddle one
+        uint64_t cumulative = 0;
+        size_t next = 0;
+        for (unsigned exponent = FIRST_BOUND_EXPONENT; exponent <= HistogramSnapshot::MAX_EXPONENT; ++exponent) {
+            const uint64_t bound = uint64_t(1) << exponent;
+            for (const size_t end = HistogramSnapshot::bucket(bound); next < end; ++next) {
+                cumulative += histogram.buckets[next];
+            }
+            out << name << "_bucket{le=\"" << static_cast<double>(bound) * 1e-9 << "\"} " << cumulative << '\n';
+        }
+        for (; next < HistogramSnapshot::BUCKETS; ++next) {
+            cumulative += histogram.buckets[next];
+        }
+        
+        // Count from the buckets so +Inf and _count agree under concurrent updates
+        out << name << "_bucket{le=\"+Inf\"} " << cumulative << '\n'
+            << name << "_sum " << static_cast<double>(histogram.sum) * 1e-9 << '\n'
+            << name << "_count " << cumulative << '\n';
+    }
+    return out.str();
+}
+
+void Metrics::write_prometheus(std::ostream& out) {
+    out << prometheus();
+}
+
+void Metrics::write_prometheus(const std::string& path) {
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        file << prometheus();
+        file.flush();
+        if (!file) {
+            throw std::runtime_error("Cannot write metrics file " + temporary);
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        throw system_error("Cannot replace metrics file " + path);
+    }
+}
+
+// MetricsServer implementation
+MetricsServer::MetricsServer(uint16_t port, const std::string& address) {
+    sockaddr_in endpoint{};
+    endpoint.sin_family = AF_INET;
+    endpoint.sin_port = htons(port);
+    if (::inet_pton(AF_INET, address.c_str(), &endpoint.sin_addr) != 1) {
+        throw std::runtime_error("Invalid metrics address " + address);
+    }
+    
+    fd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd_ < 0) {
+        throw system_error("Cannot create metrics socket");
+    }
+    const int reuse = 1;
+    ::setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    
+    socklen_t length = sizeof(endpoint);
+    if (::bind(fd_, reinterpret_cast<const sockaddr*>(&endpoint), sizeof(endpoint)) != 0 ||
+        ::listen(fd_, SOMAXCONN) != 0 ||
+        ::getsockname(fd_, reinterpret_cast<sockaddr*>(&endpoint), &length) != 0) {
+        const std::runtime_error error = system_error("Cannot listen on " + address + ":" + std::to_string(port));
+        ::close(fd_);
+        throw error;
+    }
+    port_ = ntohs(endpoint.sin_port);
+    thread_ = std::thread([this]() { serve(); });
+}
+
+MetricsServer::~MetricsServer() {
+    stop_.store(true, std::memory_order_relaxed);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    ::close(fd_);
+}
+
+void MetricsServer::serve() {
+    while (!stop_.load(std::memory_order_relaxed)) {
+        pollfd listener{fd_, POLLIN, 0};
+        if (::poll(&listener, 1, POLL_INTERVAL_MS) <= 0) {
+            continue;
+        }
+        const int client = ::accept4(fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0) {
+            continue;
+        }
+        try {
+            answer(client);
+        } catch (...) {
+            // A failed response only loses this scrape
+        }
+        ::close(client);
+    }
+}
+
+void MetricsServer::answer(int client) {
+    // Bound the wait for a client that connects and sends nothing
+    timeval timeout{};
+    timeout.tv_sec = 1;
+    ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    
+    char request[REQUEST_BUFFER_SIZE];
+    size_t have = 0;
+    while (have < sizeof(request)) {
+        const ssize_t n = ::recv(client, request + have, sizeof(request) - have, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        have += static_cast<size_t>(n);
+        if (std::string_view(request, have).find("\r\n\r\n") != std::string_view::npos) {
+            break;
+        }
+    }
+    
+    const std::string_view received(request, have);
+    const std::string_view line = received.substr(0, received.find_first_of("\r\n"));
+    const bool found = line.rfind("GET /metrics ", 0) == 0 || line.rfind("GET /metrics?", 0) == 0 ||
+                       line.rfind("GET / ", 0) == 0;
+    std::string response;
+    if (found) {
+        const std::string body = Metrics::prometheus();
+        response = "HTTP/1.1 200 OK\r\n"
+                   "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                   "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                   "Connection: close\r\n\r\n" + body;
+    } else {
+        response = "HTTP/1.1 404 Not Found\r\n"
+                   "Content-Type: text/plain\r\n"
+                   "Content-Length: 10\r\n"
+                   "Connection: close\r\n\r\nNot found\n";
+    }
+    send_all(client, response);
+    requests_.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace Utils
@@ -0,0 +1,333 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <thread>
+
+/**
+ * @file metrics.hpp
+ * @brief Low-overhead hot-path counters and latency histograms with Prometheus export
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * PerformanceTimer reports one operation as a log line when its scope
+ * ends; Metrics instead keeps running totals that a monitoring system
+ * scrapes while the process runs. Every thread updates its own
+ * cache-line-aligned shard of counters and log-linear latency histograms
+ * with plain relaxed stores, so recording costs a thread-local lookup and
+ * an add, and snapshot() sums the shards without taking a lock. Typical
+ * use:
+ *
+ *   Utils::Metrics::add(Utils::MetricCounter::CACHE_HITS);
+ *   METRICS_LATENCY(Utils::MetricHistogram::PRICE_BATCH);   // times the scope
+ *   ...
+ *   Utils::MetricsServer server(9100);                      // GET /metrics
+ *
+ * Recording is off until performance.enable_profiling is set in the
+ * configuration (or set_enabled(true) is called); while off, every call
+ * is a single relaxed load and a branch.
+ */
+
+namespace Utils {
+
+/**
+ * @brief Monotonic event counters
+ */
+enum class MetricCounter : uint8_t {
+    OPTIONS_PRICED = 0,     ///< Closed-form evaluations, quotes and batch rows priced
+    OPTIONS_REJECTED,       ///< Closed-form rows and quotes not priced (invalid or not finite)
+    IV_SOLVES,              ///< Implied volatility quotes solved
+    IV_ITERATIONS,          ///< Root-finder iterations over all solves
+    IV_FAILURES,            ///< Implied volatility quotes that did not converge
+    CACHE_HITS,             ///< PricingCache lookups served from the cache
+    CACHE_MISSES,           ///< PricingCache lookups that priced the option
+    PIPELINE_BATCHES,       ///< QuotePipeline batches priced
+    ALLOCATIONS,            ///< Allocations through MemoryProfiler::allocate()
+    ALLOCATED_BYTES,        ///< Bytes requested through MemoryProfiler::allocate()
+    COUNT
+};
+
+/**
+ * @brief Latency distributions, recorded in nanoseconds
+ */
+enum class MetricHistogram : uint8_t {
+    PRICE_BATCH = 0,        ///< OptionPricer::price_batch() call
+    IV_BATCH,               ///< ImpliedVolatilitySolver::solve_batch() call
+    PIPELINE_BATCH,         ///< QuotePipeline worker pricing one batch
+    COUNT
+};
+
+/**
+ * @brief Last-value gauges
+ */
+enum class MetricGauge : uint8_t {
+    PIPELINE_PARSED_DEPTH = 0,  ///< QuotePipeline batches waiting for a worker
+    PIPELINE_PRICED_DEPTH,      ///< QuotePipeline batches waiting for the sink
+    COUNT
+};
+
+/**
+ * @brief Convert a metric to its Prometheus name (without the exporter prefix)
+ * @param metric Metric to convert
+ * @return Name such as "options_priced_total"
+ */
+const char* to_string(MetricCounter metric) noexcept;
+const char* to_string(MetricHistogram metric) noexcept;
+const char* to_string(MetricGauge metric) noexcept;
+
+constexpr size_t METRIC_COUNTERS = static_cast<size_t>(MetricCounter::COUNT);
+constexpr size_t METRIC_HISTOGRAMS = static_cast<size_t>(MetricHistogram::COUNT);
+constexpr size_t METRIC_GAUGES = static_cast<size_t>(MetricGauge::COUNT);
+
+/**
+ * @brief Log-linear (HDR-style) histogram counts
+ *
+ * Values below SUB_BUCKETS have a bucket each; above that every power of
+ * two is split into SUB_BUCKETS equal buckets, so a bucket's width is at
+ * most 1/SUB_BUCKETS of its values and quantiles carry at most 6.25%
+ * relative error. Values of 2^(MAX_EXPONENT + 1) or more (about 73
+ * minutes in nanoseconds) land in the last bucket.
+ */
+struct HistogramSnapshot {
+    static constexpr unsigned SUB_BUCKET_BITS = 4;
+    static constexpr size_t SUB_BUCKETS = size_t(1) << SUB_BUCKET_BITS;
+    static constexpr unsigned MAX_EXPONENT = 41;
+    static constexpr size_t BUCKETS = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+    
+    uint64_t buckets[BUCKETS] = {};
+    uint64_t count = 0;         ///< Values recorded
+    uint64_t sum = 0;           ///< Sum of the values recorded
+    
+    /**
+     * @brief Bucket holding a value
+     */
+    static size_t bucket(uint64_t value) noexcept {
+        if (value < SUB_BUCKETS) {
+            return static_cast<size_t>(value);
+        }
+        const unsigned exponent = 63u - static_cast<unsigned>(__builtin_clzll(value));
+        if (exponent > MAX_EXPONENT) {
+            return BUCKETS - 1;
+        }
+        const unsigned shift = exponent - SUB_BUCKET_BITS;
+        return (shift + 1) * SUB_BUCKETS + static_cast<size_t>((value >> shift) & (SUB_BUCKETS - 1));
+    }
+    
+    /**
+     * @brief Smallest value that falls in a bucket above `index`
+     */
+    static uint64_t bucket_end(size_t index) noexcept;
+    
+    /**
+     * @brief Value at a quantile
+     * @param q Quantile in [0, 1]
+     * @return Largest value of the bucket holding the q-th recorded value (0 if empty)
+     */
+    uint64_t quantile(double q) const noexcept;
+    
+    /**
+     * @brief Mean of the recorded values (0 if empty)
+     */
+    double mean() const noexcept { return count > 0 ? static_cast<double>(sum) / static_cast<double>(count) : 0.0; }
+};
+
+/**
+ * @brief Totals over every thread at one point in time
+ */
+struct MetricsSnapshot {
+    uint64_t counters[METRIC_COUNTERS] = {};
+    int64_t gauges[METRIC_GAUGES] = {};
+    HistogramSnapshot histograms[METRIC_HISTOGRAMS];
+    
+    uint64_t counter(MetricCounter metric) const noexcept { return counters[static_cast<size_t>(metric)]; }
+    int64_t gauge(MetricGauge metric) const noexcept { return gauges[static_cast<size_t>(metric)]; }
+    const HistogramSnapshot& histogram(MetricHistogram metric) const noexcept {
+        return histograms[static_cast<size_t>(metric)];
+    }
+};
+
+/**
+ * @brief Process-wide registry of the hot-path metrics
+ *
+ * All members are static and thread-safe. The first MAX_THREADS threads
+ * that record get a shard of their own; later threads share one updated
+ * with atomic read-modify-writes. A shard is handed to the next new
+ * thread when its owner exits, with its totals kept.
+ */
+class Metrics {
+public:
+    /// Threads with a shard of their own
+    static constexpr size_t MAX_THREADS = 64;
+    
+    /**
+     * @brief Whether metrics are being recorded
+     */
+    static bool enabled() noexcept { return enabled_.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief Start or stop recording
+     */
+    static void set_enabled(bool enabled) noexcept { enabled_.store(enabled, std::memory_order_relaxed); }
+    
+    /**
+     * @brief Add to a counter
+     */
+    static void add(MetricCounter metric, uint64_t value = 1) noexcept {
+        if (enabled()) {
+            add_enabled(metric, value);
+        }
+    }
+    
+    /**
+     * @brief Record a latency
+     * @param nanoseconds Duration of the operation
+     */
+    static void record(MetricHistogram metric, uint64_t nanoseconds) noexcept {
+        if (enabled()) {
+            record_enabled(metric, nanoseconds);
+        }
+    }
+    
+    /**
+     * @brief Set a gauge
+     */
+    static void set(MetricGauge metric, int64_t value) noexcept {
+        if (enabled()) {
+            gauges_[static_cast<size_t>(metric)].value.store(value, std::memory_order_relaxed);
+        }
+    }
+    
+    /**
+     * @brief Sum every thread's shard
+     */
+    static MetricsSnapshot snapshot() noexcept;
+    
+    /**
+     * @brief Zero every metric
+     *
+     * Not synchronized with threads recording at the same time, whose
+     * updates may survive or be lost; meant for use between runs.
+     */
+    static void reset() noexcept;
+    
+    /**
+     * @brief Write a snapshot in the Prometheus text exposition format (version 0.0.4)
+     *
+     * Metric names get the prefix "blackscholes_"; latencies are exported
+     * in seconds with a bucket per power of two nanoseconds.
+     */
+    static void write_prometheus(std::ostream& out);
+    
+    /**
+     * @brief Snapshot in the Prometheus text exposition format
+     */
+    static std::string prometheus();
+    
+    /**
+     * @brief Write a snapshot in the Prometheus text format to a file
+     *
+     * The file is written next to `path` and renamed over it, so a
+     * node_exporter textfile collector never reads a partial file.
+     *
+     * @throws std::runtime_error if the file cannot be written
+     */
+    static void write_prometheus(const std::string& path);
+    
+    /**
+     * @brief Steady-clock time in nanoseconds
+     */
+    static uint64_t now_ns() noexcept {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+private:
+    struct alignas(64) Gauge {
+        std::atomic<int64_t> value{0};
+    };
+    
+    static std::atomic<bool> enabled_;
+    static Gauge gauges_[METRIC_GAUGES];
+    
+    static void add_enabled(MetricCounter metric, uint64_t value) noexcept;
+    static void record_enabled(MetricHistogram metric, uint64_t nanoseconds) noexcept;
+};
+
+/**
+ * @brief RAII latency measurement into a histogram
+ *
+ * Reads the clock only while metrics are enabled.
+ */
+class ScopedLatency {
+public:
+    explicit ScopedLatency(MetricHistogram metric) noexcept
+        : metric_(metric), start_(Metrics::enabled() ? Metrics::now_ns() : 0) {}
+    
+    ~ScopedLatency() {
+        if (start_ != 0) {
+            Metrics::record(metric_, Metrics::now_ns() - start_);
+        }
+    }
+    
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+private:
+    MetricHistogram metric_;
+    uint64_t start_;
+};
+
+/**
+ * @brief Macro for latency measurement of the enclosing scope
+ * Usage: METRICS_LATENCY(Utils::MetricHistogram::PRICE_BATCH);
+ */
+#define METRICS_LATENCY(metric) \
+    Utils::ScopedLatency _metrics_latency(metric)
+
+/**
+ * @brief Minimal HTTP endpoint serving Metrics::prometheus()
+ *
+ * Answers GET /metrics (and GET /) from a background thread, one
+ * connection at a time; any other request gets 404. Stops when destroyed.
+ */
+class MetricsServer {
+public:
+    /**
+     * @brief Listen and start serving
+     * @param port TCP port (0 picks a free one; see port())
+     * @param address IPv4 address to bind (default: loopback only)
+     * @throws std::runtime_error if the socket cannot be bound
+     */
+    explicit MetricsServer(uint16_t port, const std::string& address = "127.0.0.1");
+    ~MetricsServer();
+    
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+    
+    /**
+     * @brief Port the server listens on
+     */
+    uint16_t port() const noexcept { return port_; }
+    
+    /**
+     * @brief Requests answered so far
+     */
+    uint64_t requests() const noexcept { return requests_.load(std::memory_order_relaxed); }
+
+private:
+    int fd_ = -1;
+    uint16_t port_ = 0;
+    std::atomic<bool> stop_{false};
+    std::atomic<uint64_t> requests_{0};
+    std::thread thread_;
+    
+    void serve();
+    void answer(int client);
+};
+
+} // namespace Utils
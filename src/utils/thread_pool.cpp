@@ -0,0 +1,375 @@
+#include "thread_pool.hpp"
+#include "../config/config.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Utils {
+
+namespace {
+
+// Set while the current thread runs parallel_for() tasks; nested loops run inline
+thread_local bool inside_parallel_for = false;
+
+// Highest NUMA node id probed in sysfs
+constexpr int MAX_NUMA_NODES = 256;
+
+/**
+ * @brief CPUs this process may use, grouped by NUMA node
+ */
+struct Topology {
+    std::vector<std::vector<int>> nodes;
+    
+    int node_of(int cpu) const noexcept {
+        for (size_t n = 0; n < nodes.size(); ++n) {
+            if (std::find(nodes[n].begin(), nodes[n].end(), cpu) != nodes[n].end()) {
+                return static_cast<int>(n);
+            }
+        }
+        return -1;
+    }
+};
+
+// Parse a sysfs CPU list such as "0-3,8,10-11"
+std::vector<int> parse_cpu_list(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        const size_t dash = item.find('-');
+        try {
+            const int first = std::stoi(item.substr(0, dash));
+            const int last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        } catch (const std::exception&) {
+            // Ignore malformed entries
+        }
+    }
+    return cpus;
+}
+
+Topology discover_topology() {
+    Topology topology;
+#if defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return topology;
+    }
+    
+    std::vector<int> unassigned;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &allowed)) {
+            unassigned.push_back(cpu);
+        }
+    }
+    
+    for (int node = 0; node < MAX_NUMA_NODES; ++node) {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        std::string line;
+        if (!file || !std::getline(file, line)) {
+            continue;
+        }
+        std::vector<int> cpus;
+        for (int cpu : parse_cpu_list(line)) {
+            auto it = std::find(unassigned.begin(), unassigned.end(), cpu);
+            if (it != unassigned.end()) {
+                cpus.push_back(cpu);
+                unassigned.erase(it);
+            }
+        }
+        if (!cpus.empty()) {
+            topology.nodes.push_back(std::move(cpus));
+        }
+    }
+    
+    // No NUMA information (or CPUs outside every node): treat as one more node
+    if (!unassigned.empty()) {
+        topology.nodes.push_back(std::move(unassigned));
+    }
+#endif
+    return topology;
+}
+
+const Topology& topology() {
+    static const Topology instance = discover_topology();
+    return instance;
+}
+
+bool pin_thread(std::thread& thread, int cpu) noexcept {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#else
+    (void)thread;
+    (void)cpu;
+    return false;
+#endif
+}
+
+} // namespace
+
+const char* to_string(AffinityPolicy policy) noexcept {
+    switch (policy) {
+        case AffinityPolicy::NONE:    return "NONE";
+        case AffinityPolicy::COMPACT: return "COMPACT";
+        case AffinityPolicy::SCATTER: return "SCATTER";
+        default:                      return "UNKNOWN";
+    }
+}
+
+ThreadPoolOptions ThreadPoolOptions::from_config() {
+    ThreadPoolOptions options;
+    const auto& config = Config::ConfigManager::getInstance().snapshot();
+    options.threads = static_cast<size_t>(std::max(config.threading.max_threads, 1) - 1);
+    options.affinity = config.threading.affinity == "COMPACT" ? AffinityPolicy::COMPACT
+                     : config.threading.affinity == "SCATTER" ? AffinityPolicy::SCATTER
+                                                              : AffinityPolicy::NONE;
+    return options;
+}
+
+ThreadPool::ThreadPool(size_t threads) {
+    ThreadPoolOptions options;
+    options.threads = threads;
+    start(options);
+}
+
+ThreadPool::ThreadPool(const ThreadPoolOptions& options) {
+    start(options);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    work_cv_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::start(const ThreadPoolOptions& options) {
+    worker_cpus_ = placement(options.threads, options.affinity);
+    worker_nodes_.assign(options.threads, -1);
+    workers_.reserve(options.threads);
+    for (size_t i = 0; i < options.threads; ++i) {
+        workers_.emplace_back(&ThreadPool::worker_loop, this, i);
+        if (worker_cpus_[i] >= 0 && pin_thread(workers_.back(), worker_cpus_[i])) {
+            std::lock_guard<std::mutex> lock(mutex_);   // Workers read their node under mutex_
+            worker_nodes_[i] = topology().node_of(worker_cpus_[i]);
+        } else {
+            worker_cpus_[i] = -1;
+        }
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool(ThreadPoolOptions::from_config());
+    return pool;
+}
+
+std::vector<int> ThreadPool::placement(size_t threads, AffinityPolicy policy) {
+    std::vector<int> cpus(threads, -1);
+    const Topology& machine = topology();
+    if (policy == AffinityPolicy::NONE || machine.nodes.empty()) {
+        return cpus;
+    }
+    
+    std::vector<int> order;
+    if (policy == AffinityPolicy::COMPACT) {
+        for (const std::vector<int>& node : machine.nodes) {
+            order.insert(order.end(), node.begin(), node.end());
+        }
+    } else {
+        for (size_t round = 0;; ++round) {
+            bool any = false;
+            for (const std::vector<int>& node : machine.nodes) {
+                if (round < node.size()) {
+                    order.push_back(node[round]);
+                    any = true;
+                }
+            }
+            if (!any) {
+                break;
+            }
+        }
+    }
+    
+    const size_t offset = order.size() > threads ? 1 : 0;
+    for (size_t i = 0; i < threads; ++i) {
+        cpus[i] = order[(i + offset) % order.size()];
+    }
+    return cpus;
+}
+
+ThreadPool::Job* ThreadPool::find_job() noexcept {
+    for (Job* job : jobs_) {
+        if (job->joined < job->max_workers && !job->exhausted.load(std::memory_order_relaxed)) {
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void ThreadPool::worker_loop(size_t worker) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        Job* job = nullptr;
+        work_cv_.wait(lock, [&]() { return stop_ || (job = find_job()) != nullptr; });
+        if (stop_) {
+            return;
+        }
+        
+        const size_t slot = ++job->joined;
+        ++job->active;
+        job->slots[slot].node.store(worker_nodes_[worker], std::memory_order_relaxed);
+        lock.unlock();
+        run_job(*job, slot);
+        lock.lock();
+        if (--job->active == 0) {
+            done_cv_.notify_all();
+        }
+    }
+}
+
+void ThreadPool::run_job(Job& job, size_t slot) {
+    const bool was_inside = inside_parallel_for;
+    inside_parallel_for = true;
+    Slot& own = job.slots[slot];
+    const size_t participants = job.slots.size();
+    
+    while (!job.cancelled.load(std::memory_order_relaxed)) {
+        size_t begin = 0;
+        size_t end = 0;
+        {
+            // Take a chunk from the front; half the remainder stays stealable
+            std::lock_guard<std::mutex> lock(own.mutex);
+            const size_t remaining = own.end - own.begin;
+            if (remaining > 0) {
+                const size_t chunk = std::min(remaining, std::max<size_t>(1, remaining / (2 * participants * job.grain)) * job.grain);
+                begin = own.begin;
+                own.begin += chunk;
+                end = own.begin;
+            }
+        }
+        if (begin == end && !steal(job, slot)) {
+            break;
+        }
+        if (begin == end) {
+            continue;
+        }
+        
+        try {
+            (*job.body)(begin, end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(job.error_mutex);
+            if (!job.error) {
+                job.error = std::current_exception();
+            }
+            job.cancelled.store(true, std::memory_order_relaxed);
+        }
+    }
+    // Nothing left to hand out: stop further workers from joining
+    job.exhausted.store(true, std::memory_order_relaxed);
+    inside_parallel_for = was_inside;
+}
+
+bool ThreadPool::steal(Job& job, size_t thief) noexcept {
+    const size_t participants = job.slots.size();
+    Slot& own = job.slots[thief];
+    const int node = own.node.load(std::memory_order_relaxed);
+    
+    // First pass: victims on the thief's NUMA node; second pass: anyone
+    for (int pass = node >= 0 ? 0 : 1; pass < 2; ++pass) {
+        for (size_t k = 1; k < participants; ++k) {
+            Slot& victim = job.slots[(thief + k) % participants];
+            if (pass == 0 && victim.node.load(std::memory_order_relaxed) != node) {
+                continue;
+            }
+            
+            size_t begin = 0;
+            size_t end = 0;
+            {
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                const size_t remaining = victim.end - victim.begin;
+                if (remaining == 0) {
+                    continue;
+                }
+                // The victim keeps a grain-aligned front half
+                const size_t keep = remaining <= job.grain ? 0 : std::max<size_t>(1, remaining / (2 * job.grain)) * job.grain;
+                begin = victim.begin + keep;
+                end = victim.end;
+                victim.end = begin;
+            }
+            std::lock_guard<std::mutex> lock(own.mutex);
+            own.begin = begin;
+            own.end = end;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::parallel_for_range(size_t count, const std::function<void(size_t, size_t)>& body,
+                                    size_t grain, size_t max_threads) {
+    if (count == 0) {
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+    const size_t chunks = (count + grain - 1) / grain;
+    const size_t participants = std::min({max_threads == 0 ? workers_.size() + 1 : max_threads,
+                                          workers_.size() + 1, chunks});
+    if (inside_parallel_for || participants <= 1) {
+        body(0, count);
+        return;
+    }
+    
+    Job job;
+    job.body = &body;
+    job.grain = grain;
+    job.max_workers = participants - 1;
+    job.slots = std::vector<Slot>(participants);
+    // Boundaries on multiples of grain: only the chunk ending at count can be short
+    for (size_t i = 0; i < participants; ++i) {
+        job.slots[i].begin = std::min(count, chunks * i / participants * grain);
+        job.slots[i].end = std::min(count, chunks * (i + 1) / participants * grain);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(&job);
+    }
+    work_cv_.notify_all();
+    
+    run_job(job, 0);
+    
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        jobs_.erase(std::find(jobs_.begin(), jobs_.end(), &job));
+        done_cv_.wait(lock, [&]() { return job.active == 0; });
+    }
+    
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
+
+void ThreadPool::parallel_for(size_t count, const std::function<void(size_t)>& body, size_t max_threads) {
+    parallel_for_range(count, [&body](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            body(i);
+        }
+    }, 1, max_threads);
+}
+
+} // namespace Utils
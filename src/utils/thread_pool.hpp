@@ -0,0 +1,187 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file thread_pool.hpp
+ * @brief Work-stealing worker pool for data-parallel loops
+ * @author Quantitative Finance Team
+ * @version 1.0
+ * @date 2025
+ *
+ * parallel_for_range() splits an index range evenly across the calling
+ * thread and the pool workers. Each participant takes chunks from the front
+ * of its own range; chunks shrink as the range drains, so the chunk size
+ * adapts from large (little overhead) to single items (good balance at the
+ * end). A participant that runs dry steals the back half of another's
+ * remaining range, preferring threads on its own NUMA node.
+ *
+ * Several threads may run loops on the same pool at once: each caller works
+ * on its own loop, and idle workers join whichever loop still has work, so
+ * the pricing engines share one set of threads instead of oversubscribing
+ * the machine. Workers sleep on a condition variable between loops, so an
+ * idle pool costs nothing.
+ */
+
+namespace Utils {
+
+/**
+ * @brief Worker placement on CPUs
+ */
+enum class AffinityPolicy : uint8_t {
+    NONE = 0,       ///< Leave scheduling to the OS
+    COMPACT = 1,    ///< Pin workers to consecutive CPUs, filling one NUMA node before the next
+    SCATTER = 2     ///< Pin workers round-robin across NUMA nodes
+};
+
+/**
+ * @brief Convert affinity policy to string representation
+ * @param policy Policy to convert
+ * @return String representation of policy
+ */
+const char* to_string(AffinityPolicy policy) noexcept;
+
+/**
+ * @brief Construction settings for ThreadPool
+ */
+struct ThreadPoolOptions {
+    size_t threads = 0;                             ///< Pool threads (the caller of parallel_for() is extra)
+    AffinityPolicy affinity = AffinityPolicy::NONE; ///< Worker placement
+    
+    /**
+     * @brief Read threading.max_threads and threading.affinity
+     * @return Options with max_threads - 1 workers
+     */
+    static ThreadPoolOptions from_config();
+};
+
+/**
+ * @brief Pool of worker threads executing parallel loops
+ */
+class ThreadPool {
+private:
+    // Remaining range of one participant, guarded by mutex
+    struct alignas(64) Slot {
+        std::mutex mutex;
+        size_t begin = 0;
+        size_t end = 0;
+        std::atomic<int> node{-1};              ///< NUMA node of the thread working the slot
+    };
+    
+    // One parallel_for_range() in flight
+    struct Job {
+        const std::function<void(size_t, size_t)>* body = nullptr;
+        size_t grain = 1;
+        size_t max_workers = 0;                 ///< Pool threads allowed to join
+        size_t joined = 0;                      ///< Pool threads that joined, guarded by mutex_
+        size_t active = 0;                      ///< Pool threads still running, guarded by mutex_
+        std::vector<Slot> slots;                ///< Slot 0 belongs to the caller
+        std::atomic<bool> exhausted{false};     ///< Every slot was found empty
+        std::atomic<bool> cancelled{false};     ///< A task threw; skip the rest
+        std::mutex error_mutex;
+        std::exception_ptr error;               ///< First exception thrown by a task
+    };
+    
+    std::vector<std::thread> workers_;
+    std::vector<int> worker_cpus_;              ///< CPU per worker (-1 = not pinned)
+    std::vector<int> worker_nodes_;             ///< NUMA node per worker (-1 = unknown)
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    std::vector<Job*> jobs_;                    ///< Loops accepting workers, oldest first, guarded by mutex_
+    bool stop_ = false;
+    
+    void start(const ThreadPoolOptions& options);
+    void worker_loop(size_t worker);
+    Job* find_job() noexcept;
+    static void run_job(Job& job, size_t slot);
+    static bool steal(Job& job, size_t thief) noexcept;
+
+public:
+    /**
+     * @brief Start unpinned workers
+     * @param threads Number of pool threads (the caller of parallel_for() is extra)
+     */
+    explicit ThreadPool(size_t threads);
+    
+    /**
+     * @brief Start workers with the given placement
+     * @param options Pool size and affinity
+     */
+    explicit ThreadPool(const ThreadPoolOptions& options);
+    
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    /**
+     * @brief Process-wide pool configured by ThreadPoolOptions::from_config()
+     * @return Reference to the shared pool
+     */
+    static ThreadPool& shared();
+    
+    /**
+     * @brief CPUs the workers of a pool would be pinned to
+     *
+     * Uses the CPUs this process may run on, grouped by NUMA node. The
+     * first CPU is left to the caller when there are more CPUs than
+     * workers.
+     *
+     * @param threads Number of workers
+     * @param policy Placement policy
+     * @return CPU per worker, or -1 for each worker when not pinned
+     */
+    static std::vector<int> placement(size_t threads, AffinityPolicy policy);
+    
+    /**
+     * @brief Run body(begin, end) over chunks covering [0, count), in parallel, and wait
+     *
+     * Chunks are disjoint, start on a multiple of `grain` and are a multiple
+     * of `grain` long (except the one ending at `count`); they may run in
+     * any order and on any thread. The first
+     * exception thrown by a task is rethrown here after all started tasks
+     * finish; remaining chunks are skipped. Nested calls from inside a task
+     * run inline.
+     *
+     * @param count Number of indices
+     * @param body Task function, called with a half-open index range
+     * @param grain Smallest chunk worth running on its own
+     * @param max_threads Upper bound on threads used, including the caller (0 = all)
+     */
+    void parallel_for_range(size_t count, const std::function<void(size_t, size_t)>& body,
+                            size_t grain = 1, size_t max_threads = 0);
+    
+    /**
+     * @brief Run body(0) ... body(count - 1), in parallel, and wait
+     *
+     * Same scheduling and error handling as parallel_for_range() with a
+     * grain of one index.
+     *
+     * @param count Number of tasks
+     * @param body Task function, called with the task index
+     * @param max_threads Upper bound on threads used, including the caller (0 = all)
+     */
+    void parallel_for(size_t count, const std::function<void(size_t)>& body, size_t max_threads = 0);
+    
+    /**
+     * @brief Number of pool threads
+     */
+    size_t size() const noexcept { return workers_.size(); }
+    
+    /**
+     * @brief CPU each worker is pinned to
+     * @return One entry per worker (-1 = not pinned)
+     */
+    const std::vector<int>& worker_cpus() const noexcept { return worker_cpus_; }
+};
+
+} // namespace Utils
@@ -0,0 +1,119 @@
+#include "test_framework.hpp"
+#include "../src/models/adjoint.hpp"
+#include "../src/models/black_scholes.hpp"
+#include <cmath>
+
+using namespace BlackScholes;
+using namespace Testing;
+
+/**
+ * @file test_adjoint.cpp
+ * @brief Unit tests for the reverse-mode AD tape
+ *
+ * Test Coverage:
+ * - Gradients of arithmetic and elementary functions against closed forms
+ * - Constant-only expressions are not recorded
+ * - Rewinding reuses the tape storage
+ * - Closed-form Greeks through the tape
+ */
+
+// Test suite for AD::Tape and AD::Real
+TEST_SUITE(AdjointTapeTests) {
+    auto suite = std::make_unique<TestSuite>("AdjointTape");
+    
+    suite->addTest("Gradients", []() {
+        AD::TapeScope scope;
+        AD::Tape& tape = scope.tape();
+        const AD::Real x = tape.variable(1.5);
+        const AD::Real y = tape.variable(-0.7);
+        
+        // f = x·y + e^x / y - √x·ln x + N(y) + max(x, y) - min(x, 2)
+        const AD::Real f = x * y + AD::exp(x) / y - AD::sqrt(x) * AD::log(x) + AD::normal_cdf(y) +
+                           AD::max(x, y) - AD::min(x, 2.0);
+        tape.backward(f);
+        const double df_dx = -0.7 + std::exp(1.5) / -0.7 - (0.5 / std::sqrt(1.5)) * std::log(1.5) -
+                             std::sqrt(1.5) / 1.5 + 1.0 - 1.0;
+        const double df_dy = 1.5 - std::exp(1.5) / (0.7 * 0.7) + MathUtils::normal_pdf(-0.7);
+        ASSERT_NEAR(df_dx, tape.adjoint(x), 1e-12);
+        ASSERT_NEAR(df_dy, tape.adjoint(y), 1e-12);
+        ASSERT_EQ(1.0, tape.adjoint(f));
+        
+        // Compound assignment and negation
+        AD::Real g = x;
+        g *= y;
+        g -= -x;
+        g /= 2.0;
+        tape.backward(g);
+        ASSERT_NEAR((-0.7 + 1.0) / 2.0, tape.adjoint(x), 1e-15);
+        ASSERT_NEAR(1.5 / 2.0, tape.adjoint(y), 1e-15);
+        ASSERT_EQ(0.0, tape.adjoint(AD::Real(3.0)));
+    });
+    
+    suite->addTest("ConstantsAreNotRecorded", []() {
+        AD::TapeScope scope;
+        AD::Tape& tape = scope.tape();
+        const size_t before = tape.size();
+        const AD::Real c = AD::exp(AD::Real(2.0)) * 3.0 + 1.0;
+        ASSERT_EQ(before, tape.size());
+        ASSERT_EQ(AD::Tape::CONSTANT, c.node());
+        ASSERT_NEAR(3.0 * std::exp(2.0) + 1.0, c.value(), 1e-12);
+        
+        const AD::Real x = tape.variable(2.0);
+        const AD::Real y = x * c;
+        ASSERT_EQ(before + 2, tape.size());
+        tape.backward(y);
+        ASSERT_NEAR(c.value(), tape.adjoint(x), 1e-12);
+    });
+    
+    // A record / backward / rewind loop keeps reusing the same blocks
+    suite->addTest("RewindReusesStorage", []() {
+        AD::TapeScope scope;
+        AD::Tape& tape = scope.tape();
+        const AD::Real x = tape.variable(0.5);
+        const size_t start = tape.mark();
+        size_t capacity = 0;
+        for (int path = 0; path < 200; ++path) {
+            AD::Real sum = 0.0;
+            for (int i = 0; i < 3000; ++i) {
+                sum += x * static_cast<double>(i % 7);
+            }
+            tape.backward(sum);
+            ASSERT_NEAR(8994.0, tape.adjoint(x), 1e-9);
+            if (path == 0) {
+                capacity = tape.capacity();
+                ASSERT_GE(capacity, tape.size());
+            }
+            tape.rewind(start);
+        }
+        ASSERT_EQ(capacity, tape.capacity());
+        ASSERT_EQ(start, tape.size());
+    });
+    
+    // The closed-form price differentiated on the tape gives the analytic Greeks
+    suite->addTest("ClosedFormGreeks", []() {
+        const Parameters params(100.0, 110.0, 0.5, 0.04, 0.3, 0.015);
+        AD::TapeScope scope;
+        AD::Tape& tape = scope.tape();
+        const AD::Real S = tape.variable(params.spot_price);
+        const AD::Real T = tape.variable(params.time_to_expiry);
+        const AD::Real r = tape.variable(params.risk_free_rate);
+        const AD::Real sigma = tape.variable(params.volatility);
+        const double K = params.strike_price;
+        const double q = params.dividend_yield;
+        
+        const AD::Real sigma_sqrt_T = sigma * AD::sqrt(T);
+        const AD::Real d1 = (AD::log(S / K) + (r - q + 0.5 * sigma * sigma) * T) / sigma_sqrt_T;
+        const AD::Real call = S * AD::exp(-q * T) * AD::normal_cdf(d1) -
+                              K * AD::exp(-r * T) * AD::normal_cdf(d1 - sigma_sqrt_T);
+        tape.backward(call);
+        
+        const Greeks expected = OptionPricer::calculate_call_greeks(params);
+        ASSERT_NEAR(OptionPricer::price_call(params).price, call.value(), 1e-10);
+        ASSERT_NEAR(expected.delta, tape.adjoint(S), 1e-10);
+        ASSERT_NEAR(expected.theta, -tape.adjoint(T) / 365.0, 1e-10);
+        ASSERT_NEAR(expected.vega, tape.adjoint(sigma) / 100.0, 1e-10);
+        ASSERT_NEAR(expected.rho, tape.adjoint(r) / 100.0, 1e-10);
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}
@@ -0,0 +1,117 @@
+#include "test_framework.hpp"
+#include "../src/utils/arena.hpp"
+#include "../src/utils/memory_profiler.hpp"
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+using namespace Testing;
+
+/**
+ * @file test_arena.cpp
+ * @brief Unit tests for the scratch-memory arena
+ *
+ * Test Coverage:
+ * - Alignment and growth across chunks
+ * - Nested scopes rewind, the outermost resets and coalesces
+ * - No allocations once the arena has warmed up
+ * - High-water marks reported to the memory profiler
+ */
+
+// Test suite for Arena and ArenaScope
+TEST_SUITE(ArenaTests) {
+    auto suite = std::make_unique<TestSuite>("Arena");
+    
+    suite->addTest("AlignmentAndGrowth", []() {
+        Utils::Arena arena(1024);
+        ASSERT_EQ(size_t(0), arena.capacity());
+        
+        void* small = arena.allocate(3, 1);
+        void* aligned = arena.allocate(64, 64);
+        ASSERT_TRUE(small != nullptr);
+        ASSERT_EQ(uintptr_t(0), reinterpret_cast<uintptr_t>(aligned) % 64);
+        
+        // Larger than a chunk: a new chunk is added
+        void* large = arena.allocate(4096, 16);
+        ASSERT_EQ(uintptr_t(0), reinterpret_cast<uintptr_t>(large) % 16);
+        ASSERT_GE(arena.capacity(), size_t(1024 + 4096));
+        ASSERT_GE(arena.used(), size_t(3 + 64 + 4096));
+    });
+    
+    suite->addTest("ScopesRewindAndCoalesce", []() {
+        Utils::Arena arena(1024);
+        {
+            Utils::ArenaScope outer(arena);
+            std::pmr::vector<double> a(64, 1.0, outer.resource());
+            const size_t used = arena.used();
+            {
+                Utils::ArenaScope inner(arena);
+                std::pmr::vector<double> b(1024, 2.0, inner.resource());
+                ASSERT_GT(arena.used(), used);
+            }
+            ASSERT_EQ(used, arena.used());
+            ASSERT_EQ(1.0, a[63]);
+        }
+        ASSERT_EQ(size_t(0), arena.used());
+        ASSERT_GE(arena.high_water_mark(), size_t(1024 * sizeof(double)));
+        
+        // The spilled chunks were replaced by one that fits the whole batch
+        const size_t capacity = arena.capacity();
+        {
+            Utils::ArenaScope again(arena);
+            std::pmr::vector<double> a(64, 1.0, again.resource());
+            std::pmr::vector<double> b(1024, 2.0, again.resource());
+        }
+        ASSERT_EQ(capacity, arena.capacity());
+    });
+    
+    // Repeating batches stop allocating after the first one
+    suite->addTest("SteadyStateIsAllocationFree", []() {
+        Utils::Arena arena(256);
+        auto batch = [&arena](size_t n) {
+            Utils::ArenaScope scratch(arena);
+            std::pmr::vector<double> d1(n, scratch.resource());
+            std::pmr::vector<double> d2(n, scratch.resource());
+            std::pmr::vector<uint32_t> flags(n, scratch.resource());
+            for (size_t i = 0; i < n; ++i) {
+                d1[i] = static_cast<double>(i);
+                d2[i] = d1[i] * 0.5;
+                flags[i] = static_cast<uint32_t>(i & 1);
+            }
+            return d2[n - 1];
+        };
+        batch(5000);
+        
+        Utils::MemoryProfiler::initialize(true);
+        const size_t before = Utils::MemoryProfiler::getInstance().getStats().allocation_count.load();
+        double checksum = 0.0;
+        for (int i = 0; i < 100; ++i) {
+            checksum += batch(5000 - static_cast<size_t>(i));
+        }
+        const size_t allocations = Utils::MemoryProfiler::getInstance().getStats().allocation_count.load() - before;
+        Utils::MemoryProfiler::getInstance().setEnabled(false);
+        
+        ASSERT_EQ(size_t(0), allocations);
+        ASSERT_GT(checksum, 0.0);
+    });
+    
+    suite->addTest("ReportsHighWater", []() {
+        const size_t before = Utils::MemoryProfiler::getInstance().getStats().arena_high_water.load();
+        {
+            Utils::Arena arena;
+            Utils::ArenaScope scratch(arena);
+            static_cast<void>(scratch.arena().allocate(10000, 8));
+        }
+        const size_t after = Utils::MemoryProfiler::getInstance().getStats().arena_high_water.load();
+        ASSERT_GE(after - before, size_t(10000));
+        
+        Utils::ScopedMemoryTracker tracker("arena");
+        {
+            Utils::ArenaScope scratch;
+            static_cast<void>(scratch.arena().allocate(2048, 8));
+        }
+        ASSERT_GE(tracker.getArenaHighWater(), size_t(2048));
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}
@@ -0,0 +1,194 @@
+#include "test_framework.hpp"
+#include "../src/utils/benchmark.hpp"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Utils;
+using namespace Testing;
+
+/**
+ * @file test_benchmark.cpp
+ * @brief Unit tests for the benchmark harness
+ *
+ * Test Coverage:
+ * - Median, nearest-rank p99, minimum and mean of run times
+ * - Warmup and timed run counts
+ * - Table and JSON output, with and without hardware counters
+ * - JSON results read back as a baseline
+ * - Performance regression verdicts, failures and baseline updates
+ */
+
+// Test suite for BenchmarkRunner
+TEST_SUITE(BenchmarkHarnessTests) {
+    auto suite = std::make_unique<TestSuite>("BenchmarkHarness");
+    
+    suite->addTest("SampleStatistics", []() {
+        std::vector<double> samples;
+        for (int i = 200; i >= 1; --i) {
+            samples.push_back(static_cast<double>(i));
+        }
+        const BenchmarkResult result = BenchmarkResult::from_samples("ramp", 10, samples);
+        ASSERT_EQ(size_t(200), result.runs);
+        ASSERT_NEAR(100.5, result.median_ns, 1e-12);
+        ASSERT_NEAR(198.0, result.p99_ns, 1e-12);
+        ASSERT_NEAR(1.0, result.min_ns, 1e-12);
+        ASSERT_NEAR(100.5, result.mean_ns, 1e-12);
+        ASSERT_NEAR(10.05, result.ns_per_item(), 1e-12);
+        
+        const BenchmarkResult odd = BenchmarkResult::from_samples("odd", 0, {5.0, 1.0, 3.0});
+        ASSERT_NEAR(3.0, odd.median_ns, 1e-12);
+        ASSERT_NEAR(5.0, odd.p99_ns, 1e-12);
+        ASSERT_EQ(0.0, odd.ns_per_item());
+        ASSERT_TRUE(std::isnan(odd.cycles));
+    });
+    
+    suite->addTest("RunsAndReports", []() {
+        BenchmarkOptions options;
+        options.warmup_runs = 2;
+        options.runs = 7;
+        options.hardware_counters = false;
+        BenchmarkRunner runner(options);
+        ASSERT_FALSE(runner.counters_available());
+        
+        int calls = 0;
+        const BenchmarkResult& result = runner.run("loop \"quoted\"", 1000, [&]() {
+            double sum = 0.0;
+            for (int i = 0; i < 1000; ++i) {
+                sum += std::sqrt(static_cast<double>(i));
+            }
+            do_not_optimize(sum);
+            ++calls;
+        });
+        ASSERT_EQ(9, calls);
+        ASSERT_EQ(size_t(7), result.runs);
+        ASSERT_GT(result.median_ns, 0.0);
+        ASSERT_LE(result.min_ns, result.median_ns);
+        ASSERT_LE(result.median_ns, result.p99_ns);
+        ASSERT_TRUE(std::isnan(result.instructions));
+        ASSERT_EQ(size_t(1), runner.results().size());
+        
+        std::ostringstream table;
+        runner.write_table(table);
+        ASSERT_NE(std::string::npos, table.str().find("loop \"quoted\""));
+        
+        std::ostringstream json;
+        runner.write_json(json, {{"simd", "AVX2"}});
+        const std::string text = json.str();
+        ASSERT_NE(std::string::npos, text.find("\"simd\": \"AVX2\""));
+        ASSERT_NE(std::string::npos, text.find("\"name\": \"loop \\\"quoted\\\"\""));
+        ASSERT_NE(std::string::npos, text.find("\"items\": 1000, \"runs\": 7"));
+        ASSERT_NE(std::string::npos, text.find("\"cycles\": null"));
+        
+        // Counters are optional; when the kernel grants them they are reported per run
+        BenchmarkRunner counted;
+        const BenchmarkResult& sampled = counted.run("spin", 1, [&]() { do_not_optimize(calls); });
+        if (counted.counters_available()) {
+            ASSERT_GT(sampled.instructions, 0.0);
+        } else {
+            ASSERT_TRUE(std::isnan(sampled.instructions));
+        }
+    });
+    
+    // read_benchmark_json() reads what write_json() writes
+    suite->addTest("ReadJsonBaseline", []() {
+        BenchmarkOptions options;
+        options.warmup_runs = 0;
+        options.runs = 3;
+        options.hardware_counters = false;
+        BenchmarkRunner runner(options);
+        runner.run("plain", 10, []() {});
+        runner.run("odd \"name\" {\\}", 20, []() {});
+        
+        std::stringstream json;
+        runner.write_json(json, {{"simd", "AVX2"}});
+        const std::vector<BenchmarkResult> read = read_benchmark_json(json);
+        ASSERT_EQ(size_t(2), read.size());
+        for (size_t i = 0; i < read.size(); ++i) {
+            const BenchmarkResult& written = runner.results()[i];
+            ASSERT_EQ(written.name, read[i].name);
+            ASSERT_EQ(written.items, read[i].items);
+            ASSERT_EQ(size_t(3), read[i].runs);
+            ASSERT_NEAR(written.median_ns, read[i].median_ns, 1e-9 * written.median_ns + 1e-9);
+            ASSERT_NEAR(written.p99_ns, read[i].p99_ns, 1e-9 * written.p99_ns + 1e-9);
+            ASSERT_TRUE(std::isnan(read[i].cycles));
+        }
+        
+        std::istringstream empty("{\"context\": {}, \"benchmarks\": []}");
+        ASSERT_TRUE(read_benchmark_json(empty).empty());
+    });
+    
+    // A check slower than its baseline fails; faster, unknown and updating checks do not
+    suite->addTest("PerfRegressionVerdicts", []() {
+        const std::string file = "test_perf_baseline.json";
+        {
+            std::ofstream baseline(file);
+            baseline << "{\n  \"context\": {},\n  \"benchmarks\": [\n"
+                     << "    {\"name\": \"regressed\", \"items\": 1, \"runs\": 9, \"median_ns\": 1},\n"
+                     << "    {\"name\": \"improved\", \"items\": 1, \"runs\": 9, \"median_ns\": 1e15}\n"
+                     << "  ]\n}\n";
+        }
+        const auto spin = []() {
+            double sum = 0.0;
+            for (int i = 0; i < 1000; ++i) {
+                sum += std::sqrt(static_cast<double>(i));
+            }
+            do_not_optimize(sum);
+        };
+        
+        PerfOptions options;
+        options.enabled = true;
+        options.baseline_file = file;
+        options.noise_floor_ns = 0.0;
+        options.warmup_runs = 1;
+        options.runs = 3;
+        PerfRegression perf(options);
+        ASSERT_THROWS(perf.check("regressed", 1000, spin), AssertionFailure);
+        perf.check("improved", 1000, spin);
+        perf.check("new", 1000, spin);
+        ASSERT_EQ(size_t(3), perf.getChecks().size());
+        ASSERT_TRUE(perf.getChecks()[0].verdict == PerfVerdict::REGRESSED);
+        ASSERT_TRUE(perf.getChecks()[1].verdict == PerfVerdict::IMPROVED);
+        ASSERT_TRUE(perf.getChecks()[2].verdict == PerfVerdict::NEW);
+        ASSERT_TRUE(std::isnan(perf.getChecks()[2].baseline_ns));
+        ASSERT_EQ(size_t(1), perf.getRegressionCount());
+        
+        std::ostringstream report;
+        perf.printReport(report);
+        ASSERT_NE(std::string::npos, report.str().find("REGRESSED"));
+        ASSERT_NE(std::string::npos, report.str().find("Regressions:   1"));
+        
+        // The noise floor absorbs small absolute slowdowns
+        options.noise_floor_ns = 1e12;
+        ASSERT_TRUE(perf.configure(options));
+        perf.check("regressed", 1000, spin);
+        ASSERT_TRUE(perf.getChecks()[0].verdict == PerfVerdict::OK);
+        
+        // Updating never fails and records every check
+        options.noise_floor_ns = 0.0;
+        options.update_baseline = true;
+        ASSERT_TRUE(perf.configure(options));
+        perf.check("regressed", 1000, spin);
+        perf.check("new", 1000, spin);
+        ASSERT_TRUE(perf.writeBaseline());
+        std::ifstream written(file);
+        const std::vector<BenchmarkResult> recorded = read_benchmark_json(written);
+        ASSERT_EQ(size_t(2), recorded.size());
+        ASSERT_EQ(std::string("regressed"), recorded[0].name);
+        ASSERT_EQ(size_t(3), recorded[1].runs);
+        
+        // Disabled, a check runs its body once and records nothing
+        int calls = 0;
+        PerfRegression disabled;
+        disabled.check("once", 1, [&]() { ++calls; });
+        ASSERT_EQ(1, calls);
+        ASSERT_TRUE(disabled.getChecks().empty());
+        
+        std::remove(file.c_str());
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}
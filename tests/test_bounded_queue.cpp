@@ -0,0 +1,118 @@
+#include "test_framework.hpp"
+#include "../src/utils/bounded_queue.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace Utils;
+using namespace Testing;
+
+/**
+ * @file test_bounded_queue.cpp
+ * @brief Unit tests for the bounded MPMC queue
+ *
+ * Test Coverage:
+ * - FIFO order, capacity rounding and high-water mark
+ * - close() draining and waking blocked threads
+ * - Every value delivered exactly once with several producers and consumers
+ */
+
+// Test suite for BoundedQueue
+TEST_SUITE(BoundedQueueTests) {
+    auto suite = std::make_unique<TestSuite>("BoundedQueue");
+    
+    suite->addTest("FifoAndCapacity", []() {
+        BoundedQueue<int> queue(3);
+        ASSERT_EQ(size_t(4), queue.capacity());
+        for (int i = 0; i < 4; ++i) {
+            ASSERT_TRUE(queue.try_push(i));
+        }
+        ASSERT_FALSE(queue.try_push(4));
+        ASSERT_EQ(size_t(4), queue.size());
+        ASSERT_EQ(size_t(4), queue.high_water());
+        
+        int value = -1;
+        for (int i = 0; i < 4; ++i) {
+            ASSERT_TRUE(queue.try_pop(value));
+            ASSERT_EQ(i, value);
+        }
+        ASSERT_FALSE(queue.try_pop(value));
+        
+        // Wrap around the ring several times
+        for (int i = 0; i < 100; ++i) {
+            ASSERT_TRUE(queue.push(i));
+            ASSERT_TRUE(queue.pop(value));
+            ASSERT_EQ(i, value);
+        }
+        queue.reset_high_water();
+        ASSERT_EQ(size_t(0), queue.high_water());
+    });
+    
+    // Pops drain what is left after close(); blocked consumers wake up
+    suite->addTest("CloseDrainsAndWakes", []() {
+        BoundedQueue<int> queue(8);
+        ASSERT_TRUE(queue.push(1));
+        ASSERT_TRUE(queue.push(2));
+        queue.close();
+        ASSERT_TRUE(queue.closed());
+        ASSERT_FALSE(queue.push(3));
+        
+        int value = 0;
+        ASSERT_TRUE(queue.pop(value));
+        ASSERT_EQ(1, value);
+        ASSERT_TRUE(queue.pop(value));
+        ASSERT_EQ(2, value);
+        ASSERT_FALSE(queue.pop(value));
+        
+        queue.reopen();
+        std::atomic<bool> woke{false};
+        std::thread consumer([&]() {
+            int unused = 0;
+            woke.store(!queue.pop(unused));
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.close();
+        consumer.join();
+        ASSERT_TRUE(woke.load());
+    });
+    
+    suite->addTest("ManyProducersAndConsumers", []() {
+        constexpr int PRODUCERS = 3;
+        constexpr int CONSUMERS = 3;
+        constexpr int PER_PRODUCER = 20000;
+        BoundedQueue<int> queue(16);
+        std::vector<std::atomic<int>> seen(PRODUCERS * PER_PRODUCER);
+        std::atomic<int> producers_left{PRODUCERS};
+        
+        std::vector<std::thread> threads;
+        for (int p = 0; p < PRODUCERS; ++p) {
+            threads.emplace_back([&, p]() {
+                for (int i = 0; i < PER_PRODUCER; ++i) {
+                    queue.push(p * PER_PRODUCER + i);
+                }
+                if (producers_left.fetch_sub(1) == 1) {
+                    queue.close();
+                }
+            });
+        }
+        for (int c = 0; c < CONSUMERS; ++c) {
+            threads.emplace_back([&]() {
+                int value = 0;
+                while (queue.pop(value)) {
+                    seen[static_cast<size_t>(value)].fetch_add(1);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        
+        for (const std::atomic<int>& count : seen) {
+            ASSERT_EQ(1, count.load());
+        }
+        ASSERT_LE(queue.high_water(), queue.capacity());
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}
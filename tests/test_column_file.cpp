@@ -0,0 +1,264 @@
+#include "test_framework.hpp"
+#include "../src/utils/column_file.hpp"
+#include "../src/models/column_export.hpp"
+#include "../src/models/black_scholes.hpp"
+#include "../src/models/implied_volatility.hpp"
+#include "../src/models/scenario_engine.hpp"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Utils;
+using namespace BlackScholes;
+using namespace Testing;
+
+/**
+ * @file test_column_file.cpp
+ * @brief Unit tests for the memory-mapped column file format and its exporters
+ *
+ * Test Coverage:
+ * - Round trip of typed, multi-value columns with aligned blocks
+ * - Rejection of unfinished, truncated and foreign files
+ * - Column name and type checks
+ * - Column file export of priced chains, grids and scenario P&L
+ */
+
+namespace {
+
+const char* const COLUMN_FILE = "test_column_file.qcol";
+
+} // namespace
+
+// Test suite for ColumnFileWriter and ColumnFileReader
+TEST_SUITE(ColumnFileTests) {
+    auto suite = std::make_unique<TestSuite>("ColumnFile");
+    
+    suite->addTest("RoundTrip", []() {
+        const size_t rows = 1000;
+        {
+            ColumnFileWriter writer(COLUMN_FILE, rows, {
+                {"price", ColumnType::FLOAT64, 1},
+                {"flag", ColumnType::UINT8, 1},
+                {"status", ColumnType::UINT32, 1},
+                {"matrix", ColumnType::FLOAT64, 3},
+                {"key", ColumnType::UINT64, 1},
+            });
+            ASSERT_EQ(rows, writer.rows());
+            double* price = writer.float64("price");
+            uint8_t* flag = writer.uint8("flag");
+            uint32_t* status = writer.uint32("status");
+            double* matrix = writer.float64("matrix");
+            uint64_t* key = writer.uint64("key");
+            for (size_t i = 0; i < rows; ++i) {
+                price[i] = 0.5 * static_cast<double>(i);
+                flag[i] = static_cast<uint8_t>(i % 2);
+                status[i] = static_cast<uint32_t>(i * 7);
+                for (size_t j = 0; j < 3; ++j) {
+                    matrix[i * 3 + j] = static_cast<double>(i * 10 + j);
+                }
+                key[i] = uint64_t(1) << 40 | i;
+            }
+            writer.finish();
+            ASSERT_THROWS(writer.float64("price"), std::invalid_argument);
+        }
+        
+        ColumnFileReader reader(COLUMN_FILE);
+        ASSERT_EQ(rows, reader.rows());
+        ASSERT_EQ(size_t(5), reader.columns().size());
+        for (const ColumnInfo& info : reader.columns()) {
+            ASSERT_EQ(size_t(0), info.offset % ColumnFileWriter::ALIGNMENT);
+        }
+        const ColumnInfo* matrix_info = reader.column("matrix");
+        ASSERT_TRUE(matrix_info != nullptr);
+        ASSERT_EQ(size_t(3), matrix_info->width);
+        ASSERT_EQ(rows * 3 * sizeof(double), matrix_info->size);
+        ASSERT_TRUE(reader.has_column("key"));
+        ASSERT_FALSE(reader.has_column("missing"));
+        
+        const double* price = reader.float64("price");
+        const uint8_t* flag = reader.uint8("flag");
+        const uint32_t* status = reader.uint32("status");
+        const double* matrix = reader.float64("matrix");
+        const uint64_t* key = reader.uint64("key");
+        for (size_t i = 0; i < rows; ++i) {
+            ASSERT_EQ(0.5 * static_cast<double>(i), price[i]);
+            ASSERT_EQ(static_cast<uint8_t>(i % 2), flag[i]);
+            ASSERT_EQ(static_cast<uint32_t>(i * 7), status[i]);
+            ASSERT_EQ(static_cast<double>(i * 10 + 2), matrix[i * 3 + 2]);
+            ASSERT_EQ(uint64_t(1) << 40 | i, key[i]);
+        }
+        
+        ASSERT_THROWS(reader.uint32("price"), std::invalid_argument);
+        ASSERT_THROWS(reader.float64("missing"), std::invalid_argument);
+        std::remove(COLUMN_FILE);
+    });
+    
+    suite->addTest("RejectsInvalidFiles", []() {
+        // A writer that never finishes leaves a file readers refuse
+        {
+            ColumnFileWriter writer(COLUMN_FILE, 10, {{"price", ColumnType::FLOAT64, 1}});
+            writer.float64("price")[0] = 1.0;
+        }
+        ASSERT_THROWS(ColumnFileReader reader(COLUMN_FILE), std::runtime_error);
+        
+        // Truncated file
+        {
+            ColumnFileWriter writer(COLUMN_FILE, 10, {{"price", ColumnType::FLOAT64, 1}});
+            writer.finish();
+        }
+        {
+            std::ifstream in(COLUMN_FILE, std::ios::binary);
+            std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            in.close();
+            std::ofstream out(COLUMN_FILE, std::ios::binary | std::ios::trunc);
+            out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 8));
+        }
+        ASSERT_THROWS(ColumnFileReader reader(COLUMN_FILE), std::runtime_error);
+        
+        // Foreign file and missing file
+        {
+            std::ofstream out(COLUMN_FILE, std::ios::trunc);
+            out << "spot,strike,expiry,rate,volatility,dividend,type\n"
+                << "100,100,1,0.05,0.2,0,C\n";
+        }
+        ASSERT_THROWS(ColumnFileReader reader(COLUMN_FILE), std::runtime_error);
+        std::remove(COLUMN_FILE);
+        ASSERT_THROWS(ColumnFileReader reader(COLUMN_FILE), std::runtime_error);
+        
+        // Bad column specifications
+        ASSERT_THROWS(ColumnFileWriter(COLUMN_FILE, 1, {{"", ColumnType::FLOAT64, 1}}), std::invalid_argument);
+        ASSERT_THROWS(ColumnFileWriter(COLUMN_FILE, 1, {{std::string(40, 'x'), ColumnType::FLOAT64, 1}}),
+                      std::invalid_argument);
+        ASSERT_THROWS(ColumnFileWriter(COLUMN_FILE, 1, {{"a", ColumnType::FLOAT64, 1}, {"a", ColumnType::UINT8, 1}}),
+                      std::invalid_argument);
+        ASSERT_THROWS(ColumnFileWriter(COLUMN_FILE, 1, {{"a", ColumnType::FLOAT64, 0}}), std::invalid_argument);
+        std::remove(COLUMN_FILE);
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}
+
+// Column file export tests
+TEST_SUITE(ColumnExportTests) {
+    auto suite = std::make_unique<TestSuite>("ColumnExport");
+    
+    // Mapped columns hold the same prices, Greeks and implied volatilities as the batch APIs
+    suite->addTest("PricedChainMatchesBatch", []() {
+        const char* path = "test_export_chain.qcol";
+        const size_t n = 10000;
+        std::vector<double> spot(n), strike(n), expiry(n), rate(n), vol(n), div(n), market(n);
+        std::vector<uint8_t> is_call(n);
+        for (size_t i = 0; i < n; ++i) {
+            spot[i] = 100.0;
+            strike[i] = 60.0 + 0.008 * static_cast<double>(i);
+            expiry[i] = 0.25 + 0.25 * static_cast<double>(i % 4);
+            rate[i] = 0.04;
+            vol[i] = i == 17 ? -1.0 : 0.2 + 0.0001 * static_cast<double>(i % 1000);
+            div[i] = 0.01;
+            is_call[i] = i % 2 == 0 ? 1 : 0;
+        }
+        const BatchInput input{spot.data(), strike.data(), expiry.data(), rate.data(),
+                               vol.data(), div.data(), is_call.data(), n};
+        
+        // Market prices: the model prices themselves, so IV must recover vol
+        BatchOutput quoted;
+        quoted.price = market.data();
+        OptionPricer::price_batch(input, quoted);
+        
+        const size_t priced = ColumnExport::priced_chain(path, input, OutputFlags::PRICE_DELTA, market.data());
+        ASSERT_EQ(n - 1, priced);
+        
+        std::vector<double> price(n), delta(n);
+        std::vector<uint32_t> status(n);
+        BatchOutput expected;
+        expected.price = price.data();
+        expected.delta = delta.data();
+        expected.status = status.data();
+        OptionPricer::price_batch(input, expected);
+        
+        Utils::ColumnFileReader file(path);
+        ASSERT_EQ(n, file.rows());
+        ASSERT_FALSE(file.has_column("gamma"));
+        const double* mapped_price = file.float64("price");
+        const double* mapped_delta = file.float64("delta");
+        const uint32_t* mapped_status = file.uint32("status");
+        const double* implied = file.float64("implied_vol");
+        const uint8_t* failure = file.uint8("iv_failure");
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(strike[i], file.float64("strike")[i]);
+            ASSERT_EQ(is_call[i], file.uint8("is_call")[i]);
+            ASSERT_EQ(status[i], mapped_status[i]);
+            if (status[i] != BatchStatus::OK) {
+                ASSERT_TRUE(std::isnan(mapped_price[i]));
+                ASSERT_NE(static_cast<uint8_t>(IVFailure::NONE), failure[i]);
+                continue;
+            }
+            ASSERT_EQ(price[i], mapped_price[i]);
+            ASSERT_EQ(delta[i], mapped_delta[i]);
+            if (failure[i] == static_cast<uint8_t>(IVFailure::NONE)) {
+                ASSERT_NEAR(vol[i], implied[i], 1e-6);
+            }
+        }
+        std::remove(path);
+    });
+    
+    suite->addTest("GridAndScenarioFiles", []() {
+        const char* grid_path = "test_export_grid.qcol";
+        const char* pnl_path = "test_export_pnl.qcol";
+        
+        std::vector<double> spots = {80.0, 90.0, 100.0, 110.0, 120.0};
+        std::vector<double> vols = {0.1, 0.2, 0.3};
+        GridInput grid;
+        grid.spot_price = spots.data();
+        grid.spot_count = spots.size();
+        grid.volatility = vols.data();
+        grid.vol_count = vols.size();
+        grid.strike_price = 100.0;
+        const ExpirySlice slice(0.5, 0.03, 0.0);
+        ASSERT_EQ(spots.size() * vols.size(), ColumnExport::price_grid(grid_path, slice, grid));
+        {
+            Utils::ColumnFileReader file(grid_path);
+            ASSERT_EQ(spots.size() * vols.size(), file.rows());
+            for (size_t v = 0; v < vols.size(); ++v) {
+                for (size_t s = 0; s < spots.size(); ++s) {
+                    const size_t cell = v * spots.size() + s;
+                    ASSERT_EQ(spots[s], file.float64("spot")[cell]);
+                    ASSERT_EQ(vols[v], file.float64("volatility")[cell]);
+                    const QuoteResult q = OptionPricer::quote(slice, spots[s], 100.0, vols[v], true, OutputFlags::PRICE);
+                    ASSERT_NEAR(q.price, file.float64("price")[cell], 1e-9);
+                }
+            }
+        }
+        std::remove(grid_path);
+        
+        std::vector<Position> portfolio = {
+            Position(Parameters(100.0, 100.0, 0.5, 0.03, 0.2), true, 10.0),
+            Position(Parameters(100.0, 90.0, 1.0, 0.03, 0.25), false, -5.0),
+        };
+        const ScenarioEngine engine(portfolio);
+        const std::vector<Scenario> scenarios = ScenarioEngine::grid({-0.1, 0.0, 0.1}, {-0.05, 0.05}, {0.0});
+        ColumnExport::scenario_pnl(pnl_path, engine, scenarios);
+        {
+            Utils::ColumnFileReader file(pnl_path);
+            ASSERT_EQ(scenarios.size(), file.rows());
+            ASSERT_EQ(portfolio.size(), file.column("pnl")->width);
+            const std::vector<double> expected = engine.run(scenarios);
+            std::vector<double> totals(scenarios.size());
+            engine.ladder(expected.data(), scenarios.size(), totals.data());
+            for (size_t s = 0; s < scenarios.size(); ++s) {
+                ASSERT_EQ(scenarios[s].spot_shift, file.float64("spot_shift")[s]);
+                ASSERT_EQ(totals[s], file.float64("portfolio_pnl")[s]);
+                for (size_t p = 0; p < portfolio.size(); ++p) {
+                    ASSERT_EQ(expected[s * portfolio.size() + p], file.float64("pnl")[s * portfolio.size() + p]);
+                }
+            }
+        }
+        std::remove(pnl_path);
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}
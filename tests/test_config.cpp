@@ -0,0 +1,235 @@
+#include "test_framework.hpp"
+#include "../src/config/config.hpp"
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace Testing;
+
+/**
+ * @file test_config.cpp
+ * @brief Unit tests for the configuration manager
+ *
+ * Test Coverage:
+ * - Typed values parsed once, including exponent notation
+ * - Snapshot publication and versioning on set()
+ * - Snapshot references valid across any number of updates
+ * - Atomic reload under concurrent readers
+ * - Invalid reloads keep the current configuration
+ * - Binary cache: reused while current, bypassed when the file changes or the cache is damaged
+ * - Nested sections of the shipped config.json read as dotted keys
+ */
+
+namespace {
+
+const char* const RELOAD_FILE = "test_config_reload.json";
+const char* const NESTED_FILE = "test_config_nested.json";
+
+void write_config(int simulations, int steps) {
+    std::ofstream file(RELOAD_FILE);
+    file << "{\n"
+         << "  \"monte_carlo\": {\n"
+         << "    \"simulations\": " << simulations << ",\n"
+         << "    \"steps\": " << steps << "\n"
+         << "  },\n"
+         << "  \"implied_vol\": {\n"
+         << "    \"tolerance\": 1e-9\n"
+         << "  }\n"
+         << "}\n";
+}
+
+// Copies the shipped config.json to NESTED_FILE, replacing each "from" text with its "to"
+void write_shipped_config(const std::vector<std::pair<std::string, std::string>>& edits) {
+    std::ifstream in("config.json");
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    for (const auto& edit : edits) {
+        const size_t pos = content.find(edit.first);
+        if (pos == std::string::npos) {
+            throw std::runtime_error("config.json has no \"" + edit.first + "\"");
+        }
+        content.replace(pos, edit.first.size(), edit.second);
+    }
+    std::ofstream out(NESTED_FILE);
+    out << content;
+}
+
+} // namespace
+
+// Test suite for ConfigValue and ConfigSnapshot
+TEST_SUITE(ConfigurationTests) {
+    auto suite = std::make_unique<TestSuite>("Configuration");
+    
+    suite->addTest("TypedValues", []() {
+        ASSERT_EQ(1e-12, static_cast<double>(Config::ConfigValue(1e-12)));
+        ASSERT_EQ(std::string("1e-12"), Config::ConfigValue(1e-12).getString());
+        ASSERT_EQ(42, static_cast<int>(Config::ConfigValue(std::string("42"))));
+        ASSERT_EQ(std::string("INFO"), Config::ConfigValue("INFO").getString());
+        ASSERT_FALSE(Config::ConfigValue("INFO").isNumeric());
+        ASSERT_THROWS(static_cast<void>(static_cast<int>(Config::ConfigValue("abc"))), std::invalid_argument);
+    });
+    
+    // set() publishes a new snapshot; references to the old one keep their values
+    suite->addTest("SetPublishesSnapshot", []() {
+        Config::ConfigManager& manager = Config::ConfigManager::getInstance();
+        const Config::ConfigSnapshot& before = manager.snapshot();
+        const int steps = before.monte_carlo.steps;
+        
+        manager.set("monte_carlo.steps", Config::ConfigValue(steps + 1));
+        const Config::ConfigSnapshot& after = manager.snapshot();
+        ASSERT_EQ(before.version + 1, after.version);
+        ASSERT_EQ(steps, before.monte_carlo.steps);
+        ASSERT_EQ(steps + 1, after.monte_carlo.steps);
+        ASSERT_EQ(steps + 1, manager.getInt("monte_carlo.steps"));
+        
+        manager.set("monte_carlo.steps", Config::ConfigValue(steps));
+        ASSERT_EQ(steps, manager.getMonteCarloSteps());
+    });
+    
+    // A reference taken before many updates still reads its own values
+    suite->addTest("SnapshotOutlivesUpdates", []() {
+        Config::ConfigManager& manager = Config::ConfigManager::getInstance();
+        const Config::ConfigSnapshot& before = manager.snapshot();
+        const int steps = before.monte_carlo.steps;
+        const uint64_t version = before.version;
+        
+        for (int i = 1; i <= 64; ++i) {
+            manager.set("monte_carlo.steps", Config::ConfigValue(steps + i));
+        }
+        ASSERT_EQ(steps, before.monte_carlo.steps);
+        ASSERT_EQ(version, before.version);
+        ASSERT_EQ(version + 64, manager.snapshot().version);
+        ASSERT_EQ(steps + 64, manager.getMonteCarloSteps());
+        
+        manager.set("monte_carlo.steps", Config::ConfigValue(steps));
+    });
+    
+    // Readers never observe fields from two different files
+    suite->addTest("ReloadIsAtomic", []() {
+        Config::ConfigManager& manager = Config::ConfigManager::getInstance();
+        write_config(1000, 10);
+        ASSERT_TRUE(manager.initialize(RELOAD_FILE));
+        ASSERT_EQ(1e-9, manager.getImpliedVolTolerance());
+        
+        std::atomic<bool> done{false};
+        std::atomic<int> torn{0};
+        std::atomic<long> reads{0};
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 2; ++t) {
+            readers.emplace_back([&]() {
+                while (!done.load()) {
+                    const Config::ConfigSnapshot& config = manager.snapshot();
+                    if (config.monte_carlo.simulations != 100 * config.monte_carlo.steps) {
+                        torn.fetch_add(1);
+                    }
+                    reads.fetch_add(1);
+                }
+            });
+        }
+        bool reloaded = true;   // Checked after the join so a failure cannot leave threads running
+        for (int round = 1; round <= 50; ++round) {
+            write_config(1000 * (round % 7 + 1), 10 * (round % 7 + 1));
+            reloaded = manager.reload() && reloaded;
+        }
+        done.store(true);
+        for (std::thread& reader : readers) {
+            reader.join();
+        }
+        
+        ASSERT_TRUE(reloaded);
+        ASSERT_EQ(0, torn.load());
+        ASSERT_GT(reads.load(), 0L);
+        ASSERT_EQ(2000, manager.getMonteCarloSimulations());
+        
+        // An invalid file is rejected and the current configuration stays
+        write_config(1000, -1);
+        const uint64_t version = manager.snapshot().version;
+        ASSERT_FALSE(manager.reload());
+        ASSERT_EQ(version, manager.snapshot().version);
+        ASSERT_EQ(20, manager.getMonteCarloSteps());
+        
+        std::remove(RELOAD_FILE);
+        std::remove((std::string(RELOAD_FILE) + ".cache").c_str());
+        ASSERT_TRUE(manager.initialize("test_config.json"));
+    });
+    
+    // The second start reads the cache; edits and damage send it back to the JSON
+    suite->addTest("BinaryCache", []() {
+        auto& manager = Config::ConfigManager::getInstance();
+        const std::string cache = std::string(RELOAD_FILE) + ".cache";
+        std::remove(cache.c_str());
+        write_config(4321, 17);
+        
+        ASSERT_TRUE(manager.initialize(RELOAD_FILE));
+        ASSERT_FALSE(manager.snapshot().from_cache);
+        const std::vector<std::string> parsed_keys = manager.getAllKeys();
+        const double tolerance = manager.snapshot().implied_vol.tolerance;
+        
+        ASSERT_TRUE(manager.initialize(RELOAD_FILE));
+        ASSERT_TRUE(manager.snapshot().from_cache);
+        ASSERT_EQ(4321, manager.getMonteCarloSimulations());
+        ASSERT_EQ(17, manager.getMonteCarloSteps());
+        ASSERT_EQ(tolerance, manager.snapshot().implied_vol.tolerance);
+        ASSERT_TRUE(parsed_keys == manager.getAllKeys());
+        
+        // Same size, new content: the content hash rejects the cache even within one mtime tick
+        write_config(4322, 17);
+        ASSERT_TRUE(manager.initialize(RELOAD_FILE));
+        ASSERT_FALSE(manager.snapshot().from_cache);
+        ASSERT_EQ(4322, manager.getMonteCarloSimulations());
+        
+        // A flipped payload byte fails the checksum
+        {
+            std::fstream file(cache, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekg(-1, std::ios::end);
+            const char last = static_cast<char>(file.get());
+            file.seekp(-1, std::ios::end);
+            file.put(static_cast<char>(~last));
+        }
+        ASSERT_TRUE(manager.initialize(RELOAD_FILE));
+        ASSERT_FALSE(manager.snapshot().from_cache);
+        ASSERT_EQ(4322, manager.getMonteCarloSimulations());
+        
+        std::remove(RELOAD_FILE);
+        std::remove(cache.c_str());
+        ASSERT_TRUE(manager.initialize("test_config.json"));
+    });
+    
+    // Keys inside the objects of the shipped config.json are stored under "section.key"
+    suite->addTest("NestedSections", []() {
+        auto& manager = Config::ConfigManager::getInstance();
+        std::remove("config.json.cache");
+        ASSERT_TRUE(manager.initialize("config.json"));
+        ASSERT_FALSE(manager.snapshot().from_cache);
+        ASSERT_EQ(8, manager.getMaxThreads());      // Default is hardware_concurrency()
+        ASSERT_EQ(0.2, manager.getDouble("market.default_volatility"));
+        ASSERT_FALSE(manager.hasKey("max_threads"));
+        ASSERT_FALSE(manager.hasKey("monte_carlo"));
+        std::remove("config.json.cache");
+        
+        write_shipped_config({{"\"simulations\": 100000", "\"simulations\": 777"},
+                              {"\"hot_path\": false", "\"hot_path\": true"},
+                              {"\"capacity\": 65536", "\"capacity\": 123"}});
+        ASSERT_TRUE(manager.initialize(NESTED_FILE));
+        ASSERT_EQ(777, manager.getMonteCarloSimulations());
+        ASSERT_EQ(252, manager.getMonteCarloSteps());
+        ASSERT_TRUE(manager.getHotPathMode());
+        ASSERT_EQ(size_t{123}, manager.getPricingCacheCapacity());
+        
+        // The cache written from the nested file keeps the dotted keys
+        ASSERT_TRUE(manager.initialize(NESTED_FILE));
+        ASSERT_TRUE(manager.snapshot().from_cache);
+        ASSERT_EQ(777, manager.getMonteCarloSimulations());
+        
+        std::remove(NESTED_FILE);
+        std::remove((std::string(NESTED_FILE) + ".cache").c_str());
+        ASSERT_TRUE(manager.initialize("test_config.json"));
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}
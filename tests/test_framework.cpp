@@ -1,5 +1,6 @@
 #include "test_framework.hpp"
 #include <algorithm>
+#include <fstream>
 #include <iomanip>
 
 namespace Testing {
@@ -334,4 +335,128 @@ void TestRegistry::printDiscovery() const {
     std::cout << std::string(60, '=') << std::endl;
 }
 
-} // namespace Testing
\ No newline at end of file
+std::string to_string(PerfVerdict verdict) {
+    switch (verdict) {
+        case PerfVerdict::NEW:       return "NEW";
+        case PerfVerdict::OK:        return "OK";
+        case PerfVerdict::IMPROVED:  return "IMPROVED";
+        case PerfVerdict::REGRESSED: return "REGRESSED";
+        default:                     return "UNKNOWN";
+    }
+}
+
+PerfRegression::PerfRegression(const PerfOptions& options) {
+    configure(options);
+}
+
+PerfRegression& PerfRegression::getInstance() {
+    static PerfRegression instance;
+    return instance;
+}
+
+bool PerfRegression::configure(const PerfOptions& options) {
+    options_ = options;
+    Utils::BenchmarkOptions benchmark;
+    benchmark.warmup_runs = options.warmup_runs;
+    benchmark.runs = std::max<size_t>(options.runs, 1);
+    benchmark.hardware_counters = false;
+    runner_ = std::make_unique<Utils::BenchmarkRunner>(benchmark);
+    baseline_.clear();
+    checks_.clear();
+    
+    // Read even when updating, so the report still shows the change against the old baseline
+    if (options_.baseline_file.empty()) {
+        return true;
+    }
+    std::ifstream file(options_.baseline_file);
+    if (!file) {
+        return false;
+    }
+    for (const Utils::BenchmarkResult& result : Utils::read_benchmark_json(file)) {
+        baseline_[result.name] = result.median_ns;
+    }
+    return true;
+}
+
+void PerfRegression::check(const std::string& name, size_t items, const std::function<void()>& body) {
+    if (!options_.enabled) {
+        Benchmark benchmark(name);
+        body();
+        return;
+    }
+    
+    PerfCheck check;
+    check.name = name;
+    check.median_ns = runner_->run(name, items, body).median_ns;
+    
+    const auto found = baseline_.find(name);
+    double slowdown = 0.0;
+    if (found != baseline_.end()) {
+        check.baseline_ns = found->second;
+        slowdown = check.median_ns - check.baseline_ns;
+        const double allowed = options_.tolerance * check.baseline_ns;
+        if (slowdown > allowed && slowdown > options_.noise_floor_ns) {
+            check.verdict = PerfVerdict::REGRESSED;
+        } else if (-slowdown > allowed) {
+            check.verdict = PerfVerdict::IMPROVED;
+        } else {
+            check.verdict = PerfVerdict::OK;
+        }
+    }
+    checks_.push_back(check);
+    
+    if (check.verdict == PerfVerdict::REGRESSED && !options_.update_baseline) {
+        std::ostringstream message;
+        message << "Performance regression: " << name << " median " << std::fixed << std::setprecision(3)
+                << check.median_ns / 1e6 << "ms vs baseline " << check.baseline_ns / 1e6 << "ms (+"
+                << std::setprecision(1) << 100.0 * slowdown / check.baseline_ns << "%, tolerance "
+                << 100.0 * options_.tolerance << "%)";
+        throw AssertionFailure(message.str());
+    }
+}
+
+size_t PerfRegression::getRegressionCount() const {
+    return static_cast<size_t>(std::count_if(checks_.begin(), checks_.end(), [](const PerfCheck& check) {
+        return check.verdict == PerfVerdict::REGRESSED;
+    }));
+}
+
+void PerfRegression::printReport(std::ostream& out) const {
+    out << "\n" << std::string(80, '=') << std::endl;
+    out << "PERFORMANCE REGRESSION REPORT (median of " << std::max<size_t>(options_.runs, 1)
+        << " runs, tolerance " << std::fixed << std::setprecision(1) << 100.0 * options_.tolerance << "%)"
+        << std::endl;
+    out << std::string(80, '=') << std::endl;
+    
+    out << std::left << std::setw(44) << "check" << std::right << std::setw(11) << "median ms"
+        << std::setw(13) << "baseline ms" << std::setw(9) << "change" << "  verdict" << std::endl;
+    for (const PerfCheck& check : checks_) {
+        out << std::left << std::setw(44) << check.name << std::right << std::fixed << std::setprecision(3)
+            << std::setw(11) << check.median_ns / 1e6;
+        if (check.verdict == PerfVerdict::NEW) {
+            out << std::setw(13) << "-" << std::setw(9) << "-";
+        } else {
+            const double change = 100.0 * (check.median_ns / check.baseline_ns - 1.0);
+            out << std::setw(13) << check.baseline_ns / 1e6 << std::setw(8) << std::showpos
+                << std::setprecision(1) << change << std::noshowpos << "%";
+        }
+        out << "  " << to_string(check.verdict) << std::endl;
+    }
+    
+    out << "Regressions:   " << getRegressionCount() << std::endl;
+    out << std::string(80, '=') << std::endl;
+}
+
+bool PerfRegression::writeBaseline() const {
+    if (options_.baseline_file.empty()) {
+        return false;
+    }
+    std::ofstream file(options_.baseline_file);
+    if (!file) {
+        return false;
+    }
+    runner_->write_json(file, {{"source", "test_runner"}});
+    return static_cast<bool>(file);
+}
+
+} // namespace Testing
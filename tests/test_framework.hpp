@@ -8,7 +8,10 @@
 #include <iomanip>
 #include <sstream>
 #include <cmath>
+#include <limits>
+#include <map>
 #include <memory>
+#include "../src/utils/benchmark.hpp"
 #include "../src/utils/logger.hpp"
 
 /**
@@ -22,6 +25,7 @@
  * - Simple test case definition and execution
  * - Assertion macros with detailed error messages
  * - Performance benchmarking
+ * - Performance regression checks against a stored baseline
  * - Test fixtures and setup/teardown
  * - Parameterized tests
  * - Memory leak detection integration
@@ -230,6 +234,11 @@ public:
      */
     size_t getTestCount() const { return test_cases_.size(); }
     
+    /**
+     * @brief Get suite name
+     */
+    const std::string& getName() const { return name_; }
+    
     /**
      * @brief List all test names
      */
@@ -309,6 +318,102 @@ public:
     }
 };
 
+/**
+ * @brief Settings of the performance regression mode
+ */
+struct PerfOptions {
+    bool enabled = false;           ///< Time checks repeatedly (otherwise each body runs once)
+    std::string baseline_file;      ///< Baseline in BenchmarkRunner::write_json() layout (empty = none)
+    bool update_baseline = false;   ///< Record the measured medians instead of comparing
+    double tolerance = 0.5;         ///< Allowed median slowdown, as a fraction of the baseline
+    double noise_floor_ns = 20000.0;    ///< Slowdowns smaller than this never fail
+    size_t warmup_runs = 1;         ///< Untimed runs per check
+    size_t runs = 5;                ///< Timed runs per check
+};
+
+/**
+ * @brief Outcome of one performance check
+ */
+enum class PerfVerdict {
+    NEW,            ///< No baseline entry
+    OK,             ///< Within tolerance
+    IMPROVED,       ///< Faster than the baseline by more than the tolerance
+    REGRESSED       ///< Slower than the baseline by more than the tolerance
+};
+
+/**
+ * @brief Convert verdict to string
+ */
+std::string to_string(PerfVerdict verdict);
+
+/**
+ * @brief Measured median of one check against its baseline
+ */
+struct PerfCheck {
+    std::string name;
+    double median_ns = 0.0;
+    double baseline_ns = std::numeric_limits<double>::quiet_NaN();  ///< NaN without a baseline entry
+    PerfVerdict verdict = PerfVerdict::NEW;
+};
+
+/**
+ * @brief Performance regression mode for hot-path tests
+ * 
+ * ASSERT_PERFORMANCE(name, items, body) runs the body once, timed by
+ * Benchmark, unless the mode is enabled. When enabled, the body goes
+ * through Utils::BenchmarkRunner (warmup, then timed runs) and its median
+ * is compared with the baseline entry of the same name; a slowdown beyond
+ * the tolerance fails the test. With update_baseline set, nothing fails
+ * and writeBaseline() records the medians for later runs.
+ */
+class PerfRegression {
+private:
+    PerfOptions options_;
+    std::unique_ptr<Utils::BenchmarkRunner> runner_;
+    std::map<std::string, double> baseline_;    ///< Median ns by check name
+    std::vector<PerfCheck> checks_;
+    
+public:
+    explicit PerfRegression(const PerfOptions& options = PerfOptions());
+    
+    static PerfRegression& getInstance();
+    
+    /**
+     * @brief Replace the settings, clear earlier checks and read the baseline
+     * @param options New settings
+     * @return false if a baseline file is set but could not be read (every check is then NEW)
+     */
+    bool configure(const PerfOptions& options);
+    
+    const PerfOptions& getOptions() const { return options_; }
+    
+    /**
+     * @brief Run a timed check (throws AssertionFailure on a regression)
+     * @param name Check name, the key into the baseline
+     * @param items Items the body processes per call
+     * @param body Work to measure
+     */
+    void check(const std::string& name, size_t items, const std::function<void()>& body);
+    
+    const std::vector<PerfCheck>& getChecks() const { return checks_; }
+    
+    /**
+     * @brief Number of checks that regressed
+     */
+    size_t getRegressionCount() const;
+    
+    /**
+     * @brief Print every check with its baseline, change and verdict
+     */
+    void printReport(std::ostream& out) const;
+    
+    /**
+     * @brief Write the measured results to options().baseline_file
+     * @return true if written
+     */
+    bool writeBaseline() const;
+};
+
 // Assertion macros
 #define ASSERT_TRUE(condition) \
     do { \
@@ -467,4 +572,7 @@ public:
 #define BENCHMARK(name) \
     Testing::Benchmark _benchmark(name)
 
+#define ASSERT_PERFORMANCE(name, items, body) \
+    Testing::PerfRegression::getInstance().check(name, items, body)
+
 } // namespace Testing
\ No newline at end of file
@@ -0,0 +1,219 @@
+#include "test_framework.hpp"
+#include "../src/models/gpu_backend.hpp"
+#include "../src/models/black_scholes.hpp"
+#include "../src/models/monte_carlo.hpp"
+#include "../src/config/config.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace BlackScholes;
+using namespace Testing;
+
+/**
+ * @file test_gpu_backend.cpp
+ * @brief Unit tests for the GPU offload entry points
+ *
+ * Test Coverage:
+ * - Backend selection: thresholds, sampling and the enabled switch
+ * - Batch pricing and Monte Carlo results identical to the CPU engines when not offloaded
+ * - Options read from configuration, including the "gpu" object of a config file
+ *
+ * The default build has no CUDA support, so these tests pin down the CPU
+ * fallback; `make cuda` builds exercise the device through the benchmarks.
+ */
+
+namespace {
+
+// Columns for n rows, with a few invalid rows mixed in
+struct Batch {
+    std::vector<double> S, K, T, r, sigma, q;
+    std::vector<uint8_t> is_call;
+    
+    explicit Batch(size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            S.push_back(80.0 + 40.0 * static_cast<double>(i % 17) / 16.0);
+            K.push_back(100.0);
+            T.push_back(i % 53 == 7 ? -1.0 : 0.1 + static_cast<double>(i % 9) * 0.25);
+            r.push_back(0.03);
+            sigma.push_back(i % 61 == 11 ? 0.0 : 0.15 + 0.01 * static_cast<double>(i % 13));
+            q.push_back(0.01);
+            is_call.push_back(static_cast<uint8_t>(i % 2));
+        }
+    }
+    
+    BatchInput input() const {
+        return BatchInput{S.data(), K.data(), T.data(), r.data(), sigma.data(), q.data(), is_call.data(), S.size()};
+    }
+};
+
+// Equal bit patterns so NaN rows compare as well
+bool same_bits(const std::vector<double>& a, const std::vector<double>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+}
+
+GpuOptions offload_everything() {
+    GpuOptions options;
+    options.enabled = true;
+    options.min_batch_rows = 0;
+    options.min_paths = 0;
+    return options;
+}
+
+// Copies the shipped config.json to path, replacing each "from" text of the gpu object with its "to"
+void write_gpu_config(const std::string& path, const std::vector<std::pair<std::string, std::string>>& edits) {
+    std::ifstream in("config.json");
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    const size_t section = content.find("\"gpu\"");
+    for (const auto& edit : edits) {
+        const size_t pos = section == std::string::npos ? section : content.find(edit.first, section);
+        if (pos == std::string::npos) {
+            throw std::runtime_error("config.json has no gpu \"" + edit.first + "\"");
+        }
+        content.replace(pos, edit.first.size(), edit.second);
+    }
+    std::ofstream(path) << content;
+}
+
+} // namespace
+
+// Test suite for the GPU backend
+TEST_SUITE(GpuBackendTests) {
+    auto suite = std::make_unique<TestSuite>("GpuBackend");
+    
+    // Names and backend selection
+    suite->addTest("BackendSelection", []() {
+        ASSERT_EQ(std::string("CPU"), std::string(to_string(GpuBackend::CPU)));
+        ASSERT_EQ(std::string("CUDA"), std::string(to_string(GpuBackend::CUDA)));
+        
+        GpuOptions disabled = offload_everything();
+        disabled.enabled = false;
+        ASSERT_TRUE(Gpu::batch_backend(1000000, disabled) == GpuBackend::CPU);
+        ASSERT_TRUE(Gpu::monte_carlo_backend(MonteCarloOptions(), disabled) == GpuBackend::CPU);
+        
+        MonteCarloOptions sobol;
+        sobol.sampling = MonteCarloSampling::SOBOL;
+        ASSERT_TRUE(Gpu::monte_carlo_backend(sobol, offload_everything()) == GpuBackend::CPU);
+        ASSERT_TRUE(Gpu::batch_backend(0, offload_everything()) == GpuBackend::CPU);
+        ASSERT_FALSE(Gpu::available(-1));
+        
+        GpuOptions large = offload_everything();
+        large.min_batch_rows = 1000;
+        ASSERT_TRUE(Gpu::batch_backend(999, large) == GpuBackend::CPU);
+        
+#ifndef BLACKSCHOLES_CUDA
+        ASSERT_FALSE(Gpu::available());
+        ASSERT_EQ(std::string("none"), Gpu::device_name());
+        ASSERT_TRUE(Gpu::batch_backend(1000000, offload_everything()) == GpuBackend::CPU);
+        ASSERT_TRUE(Gpu::monte_carlo_backend(MonteCarloOptions(), offload_everything()) == GpuBackend::CPU);
+#endif
+    });
+    
+    // Gpu::price_batch() writes exactly what OptionPricer::price_batch() writes
+    suite->addTest("BatchMatchesCpuPricer", []() {
+        const Batch batch(3000);
+        const size_t n = batch.S.size();
+        std::vector<double> price(n), delta(n), gamma(n), theta(n), vega(n), rho(n);
+        std::vector<double> cpu_price(n), cpu_delta(n), cpu_gamma(n), cpu_theta(n), cpu_vega(n), cpu_rho(n);
+        std::vector<uint32_t> status(n), cpu_status(n);
+        const BatchOutput output{price.data(), delta.data(), gamma.data(), theta.data(),
+                                 vega.data(), rho.data(), status.data()};
+        const BatchOutput cpu_output{cpu_price.data(), cpu_delta.data(), cpu_gamma.data(), cpu_theta.data(),
+                                     cpu_vega.data(), cpu_rho.data(), cpu_status.data()};
+        
+        GpuBackend used = GpuBackend::CUDA;
+        const size_t priced = Gpu::price_batch(batch.input(), output, offload_everything(), &used);
+        ASSERT_EQ(OptionPricer::price_batch(batch.input(), cpu_output), priced);
+        ASSERT_LT(priced, n);
+#ifndef BLACKSCHOLES_CUDA
+        ASSERT_TRUE(used == GpuBackend::CPU);
+        ASSERT_TRUE(same_bits(cpu_price, price));
+        ASSERT_TRUE(same_bits(cpu_delta, delta));
+        ASSERT_TRUE(same_bits(cpu_theta, theta));
+        ASSERT_TRUE(same_bits(cpu_rho, rho));
+#endif
+        ASSERT_TRUE(status == cpu_status);
+        
+        // A missing required column stays on the CPU, which reports it per row
+        BatchInput missing = batch.input();
+        missing.volatility = nullptr;
+        ASSERT_EQ(0u, Gpu::price_batch(missing, output, offload_everything(), &used));
+        ASSERT_TRUE(used == GpuBackend::CPU);
+        ASSERT_EQ(BatchStatus::MISSING_INPUT, status[0]);
+    });
+    
+    // Gpu::price_monte_carlo() returns the CPU engine's estimate and errors when not offloaded
+    suite->addTest("MonteCarloMatchesEngine", []() {
+        const Parameters params(100.0, 105.0, 1.0, 0.05, 0.2, 0.01);
+        MonteCarloOptions mc;
+        mc.simulations = 20000;
+        mc.steps = 16;
+        PathContract contract;
+        contract.payoff = PathPayoff::UP_AND_OUT;
+        contract.barrier = 130.0;
+        
+        GpuBackend used = GpuBackend::CUDA;
+        const MonteCarloResult result = Gpu::price_monte_carlo(params, contract, mc, offload_everything(), &used);
+        const MonteCarloResult cpu = MonteCarloEngine(mc).price(params, contract);
+        ASSERT_TRUE(result.is_valid);
+#ifndef BLACKSCHOLES_CUDA
+        ASSERT_TRUE(used == GpuBackend::CPU);
+        ASSERT_EQ(cpu.price, result.price);
+        ASSERT_EQ(cpu.std_error, result.std_error);
+#else
+        ASSERT_NEAR(cpu.price, result.price, 1e-6 * cpu.price);
+#endif
+        ASSERT_EQ(cpu.paths, result.paths);
+        
+        contract.barrier = -1.0;
+        const MonteCarloResult rejected = Gpu::price_monte_carlo(params, contract, mc, offload_everything(), &used);
+        ASSERT_FALSE(rejected.is_valid);
+        ASSERT_TRUE(used == GpuBackend::CPU);
+        ASSERT_EQ(MonteCarloEngine(mc).price(params, contract).error_msg, rejected.error_msg);
+    });
+    
+    // GpuOptions::from_config() mirrors the gpu.* settings
+    suite->addTest("OptionsFromConfig", []() {
+        const auto& gpu = Config::ConfigManager::getInstance().snapshot().gpu;
+        const GpuOptions options = GpuOptions::from_config();
+        ASSERT_EQ(gpu.enabled, options.enabled);
+        ASSERT_EQ(gpu.device, options.device);
+        ASSERT_EQ(static_cast<size_t>(gpu.min_batch_rows), options.min_batch_rows);
+        ASSERT_EQ(static_cast<uint64_t>(gpu.min_paths), options.min_paths);
+        ASSERT_EQ(static_cast<size_t>(gpu.chunk_rows), options.chunk_rows);
+        ASSERT_EQ(static_cast<uint32_t>(gpu.streams), options.streams);
+    });
+    
+    // Every gpu.* setting of a nested config file reaches GpuOptions
+    suite->addTest("OptionsFromConfigFile", []() {
+        const std::string path = "test_gpu_config.json";
+        write_gpu_config(path, {{"\"enabled\": false", "\"enabled\": true"},
+                                {"\"min_batch_rows\": 65536", "\"min_batch_rows\": 1000"},
+                                {"\"min_paths\": 1048576", "\"min_paths\": 2000"},
+                                {"\"chunk_rows\": 262144", "\"chunk_rows\": 4096"},
+                                {"\"streams\": 3", "\"streams\": 5"}});
+        
+        Config::ConfigManager& config = Config::ConfigManager::getInstance();
+        const bool loaded = config.initialize(path);
+        const GpuOptions options = GpuOptions::from_config();
+        std::remove(path.c_str());
+        std::remove((path + ".cache").c_str());
+        ASSERT_TRUE(config.initialize("test_config.json"));
+        
+        ASSERT_TRUE(loaded);
+        ASSERT_TRUE(options.enabled);
+        ASSERT_EQ(0, options.device);
+        ASSERT_EQ(size_t{1000}, options.min_batch_rows);
+        ASSERT_EQ(uint64_t{2000}, options.min_paths);
+        ASSERT_EQ(size_t{4096}, options.chunk_rows);
+        ASSERT_EQ(uint32_t{5}, options.streams);
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}
@@ -0,0 +1,314 @@
+#include "test_framework.hpp"
+#include "../src/utils/logger.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Utils;
+using namespace Testing;
+
+/**
+ * @file test_logger.cpp
+ * @brief Unit tests for the logging system
+ *
+ * Test Coverage:
+ * - Compile-time format string parsing and precision fields
+ * - Lazy argument evaluation for disabled levels
+ * - Asynchronous backend delivery and ordering
+ * - Overflow policies (DROP and BLOCK)
+ * - No records lost when the backend stops while threads are logging
+ * - Call-site p99 latency: ASYNC clearly below SYNC
+ */
+
+namespace {
+
+const char* const ASYNC_TEST_LOG = "async_logger_test.log";
+
+// Route logging to a fresh file with console output off
+void redirect_to_test_log() {
+    std::remove(ASYNC_TEST_LOG);
+    Logger::configure(LogLevel::INFO, false, true, ASYNC_TEST_LOG, 512 * 1024 * 1024, 1);
+}
+
+// Restore the configuration used by the test runner
+void restore_test_logging() {
+    Logger::set_backend(LogBackend::SYNC);
+    Logger::configure(LogLevel::INFO, true, true, "test_results.log", 5 * 1024 * 1024, 3);
+    std::remove(ASYNC_TEST_LOG);
+}
+
+std::vector<std::string> read_lines_containing(const std::string& needle) {
+    std::vector<std::string> lines;
+    std::ifstream file(ASYNC_TEST_LOG);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.find(needle) != std::string::npos) {
+            lines.push_back(line);
+        }
+    }
+    return lines;
+}
+
+// 99th percentile of per-call latency in nanoseconds
+double measure_p99_ns(Logger& logger, int iterations) {
+    std::vector<double> samples(static_cast<size_t>(iterations));
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        logger.info("Latency probe {} spot={} vol={}", i, 100.25, 0.2);
+        auto end = std::chrono::steady_clock::now();
+        samples[static_cast<size_t>(i)] = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() * 99 / 100];
+}
+
+// Best p99 over several runs, so one descheduled run does not decide the comparison;
+// each run starts with the async queue drained
+double best_p99_ns(Logger& logger, int iterations, int runs) {
+    double best = measure_p99_ns(logger, iterations);
+    for (int run = 1; run < runs; ++run) {
+        Logger::flush();
+        best = std::min(best, measure_p99_ns(logger, iterations));
+    }
+    return best;
+}
+
+int g_evaluations = 0;
+
+double counted_argument() {
+    ++g_evaluations;
+    return 1.0;
+}
+
+// Format through a silent logger level and return the message text
+std::string format_message(const FormatString& format, double value, const std::string& text) {
+    std::remove(ASYNC_TEST_LOG);
+    Logger::configure(LogLevel::INFO, false, true, ASYNC_TEST_LOG, 512 * 1024 * 1024, 1);
+    Logger logger("FormatProbe");
+    logger.info(format, value, text);
+    std::vector<std::string> lines = read_lines_containing("[FormatProbe]");
+    restore_test_logging();
+    if (lines.empty()) {
+        return std::string();
+    }
+    const std::string& line = lines.back();
+    return line.substr(line.find("] ", line.find("[T:")) + 2);
+}
+
+// Parsing happens in constant expressions
+constexpr FormatString PRICE_FORMAT("Priced {} at ${:.4f} ({:.2e})");
+static_assert(PRICE_FORMAT.valid(), "PRICE_FORMAT should parse");
+static_assert(PRICE_FORMAT.placeholder_count() == 3, "PRICE_FORMAT has three fields");
+static_assert(PRICE_FORMAT.placeholder(1).precision == 4, "precision is parsed");
+static_assert(PRICE_FORMAT.placeholder(2).presentation == 'e', "presentation is parsed");
+static_assert(!FormatString("unterminated {").valid(), "stray brace is rejected");
+static_assert(!FormatString("missing digits {:.f}").valid(), "empty precision is rejected");
+
+} // namespace
+
+// Test suite for format string handling
+TEST_SUITE(LoggerFormatting) {
+    auto suite = std::make_unique<TestSuite>("LoggerFormatting");
+    
+    suite->addTest("PlaceholdersAndPrecision", []() {
+        ASSERT_EQ(std::string("S=100.5 label=atm"), format_message("S={} label={}", 100.5, "atm"));
+        ASSERT_EQ(std::string("price $4.7835 of call"), format_message("price ${:.4f} of {}", 4.783468, "call"));
+        ASSERT_EQ(std::string("vol 2.50e-01 tag"), format_message("vol {:.2e} {}", 0.25, "tag"));
+    });
+    
+    // Missing arguments leave the placeholder; surplus arguments are ignored
+    suite->addTest("ArgumentCountMismatchAtRuntime", []() {
+        ASSERT_EQ(std::string("a=1 b=x c={}"), format_message(std::string("a={} b={} c={}"), 1.0, "x"));
+        ASSERT_EQ(std::string("only 2"), format_message("only {}", 2.0, "ignored"));
+    });
+    
+    // Precision fields do not leak into later placeholders
+    suite->addTest("PrecisionIsScopedToField", []() {
+        ASSERT_EQ(std::string("0.33 then 0.333333"), format_message("{:.2f} then {}", 1.0 / 3.0, "0.333333"));
+    });
+    
+    // LOG_* macros skip argument evaluation when the level is disabled
+    suite->addTest("DisabledLevelSkipsArguments", []() {
+        Logger logger("LazyArgs");
+        g_evaluations = 0;
+        Logger::configure(LogLevel::ERROR, false, false);
+        LOG_INFO(logger, "value {}", counted_argument());
+        LOG_DEBUG(logger, "value {:.3f}", counted_argument());
+        const int evaluations_when_disabled = g_evaluations;
+        Logger::configure(LogLevel::INFO, false, false);
+        LOG_INFO(logger, "value {}", counted_argument());
+        restore_test_logging();
+        
+        ASSERT_EQ(0, evaluations_when_disabled);
+        ASSERT_EQ(1, g_evaluations);
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}
+
+// Test suite for the asynchronous logging backend
+TEST_SUITE(LoggerAsyncBackend) {
+    auto suite = std::make_unique<TestSuite>("LoggerAsyncBackend");
+    
+    // Every record reaches the file under BLOCK, in per-thread order
+    suite->addTest("BlockPolicyDeliversAllRecords", []() {
+        redirect_to_test_log();
+        
+        AsyncLogOptions options;
+        options.queue_capacity = 16;
+        options.overflow_policy = OverflowPolicy::BLOCK;
+        options.flush_interval_ms = 5;
+        Logger::set_backend(LogBackend::ASYNC, options);
+        ASSERT_TRUE(Logger::get_backend() == LogBackend::ASYNC);
+        
+        const int per_thread = 2000;
+        auto producer = [per_thread](int id) {
+            Logger logger("AsyncDelivery" + std::to_string(id));
+            for (int i = 0; i < per_thread; ++i) {
+                logger.info("record {}", i);
+            }
+        };
+        std::thread first(producer, 0);
+        std::thread second(producer, 1);
+        first.join();
+        second.join();
+        Logger::flush();
+        
+        std::vector<std::string> lines0 = read_lines_containing("[AsyncDelivery0]");
+        std::vector<std::string> lines1 = read_lines_containing("[AsyncDelivery1]");
+        restore_test_logging();
+        
+        ASSERT_EQ(static_cast<size_t>(per_thread), lines0.size());
+        ASSERT_EQ(static_cast<size_t>(per_thread), lines1.size());
+        for (int i = 0; i < per_thread; i += 499) {
+            const std::string suffix = " record " + std::to_string(i);
+            const std::string& line = lines0[static_cast<size_t>(i)];
+            ASSERT_TRUE(line.size() >= suffix.size() &&
+                        line.compare(line.size() - suffix.size(), suffix.size(), suffix) == 0);
+        }
+    });
+    
+    // A full queue under DROP loses records but counts and reports them
+    suite->addTest("DropPolicyCountsDroppedRecords", []() {
+        redirect_to_test_log();
+        
+        AsyncLogOptions options;
+        options.queue_capacity = 4;
+        options.overflow_policy = OverflowPolicy::DROP;
+        options.flush_interval_ms = 10000;  // Writer only drains on flush()
+        Logger::set_backend(LogBackend::ASYNC, options);
+        
+        const AsyncLogStats before = Logger::get_async_stats();
+        const int attempts = 100;
+        std::thread producer([attempts]() {
+            Logger logger("AsyncDrop");
+            for (int i = 0; i < attempts; ++i) {
+                logger.info("burst {}", i);
+            }
+        });
+        producer.join();
+        Logger::flush();
+        
+        const AsyncLogStats after = Logger::get_async_stats();
+        const uint64_t enqueued = after.enqueued - before.enqueued;
+        const uint64_t dropped = after.dropped - before.dropped;
+        const size_t reported = read_lines_containing("async queue full").size();
+        restore_test_logging();
+        
+        ASSERT_GT(dropped, 0u);
+        ASSERT_EQ(static_cast<uint64_t>(attempts), enqueued + dropped);
+        ASSERT_GE(after.written - before.written, enqueued);
+        ASSERT_GE(reported, 1u);
+    });
+    
+    // Records logged after switching back to SYNC are written immediately
+    suite->addTest("SwitchBackToSync", []() {
+        redirect_to_test_log();
+        Logger::set_backend(LogBackend::ASYNC);
+        Logger::set_backend(LogBackend::SYNC);
+        ASSERT_TRUE(Logger::get_backend() == LogBackend::SYNC);
+        
+        Logger logger("AsyncSwitch");
+        logger.warning("synchronous after async");
+        const size_t found = read_lines_containing("synchronous after async").size();
+        restore_test_logging();
+        
+        ASSERT_EQ(1u, found);
+    });
+    
+    // Records racing with stop() are written by the backend or synchronously, never lost
+    suite->addTest("StopKeepsRacingRecords", []() {
+        redirect_to_test_log();
+        
+        AsyncLogOptions options;
+        options.queue_capacity = 8192;
+        Logger::set_backend(LogBackend::ASYNC, options);
+        
+        const int per_thread = 4000;
+        std::atomic<int> started{0};
+        auto producer = [per_thread, &started](int id) {
+            Logger logger("AsyncStop" + std::to_string(id));
+            started.fetch_add(1);
+            for (int i = 0; i < per_thread; ++i) {
+                logger.info("record {}", i);
+            }
+        };
+        std::vector<std::thread> threads;
+        for (int id = 0; id < 3; ++id) {
+            threads.emplace_back(producer, id);
+        }
+        while (started.load() < 3) {
+            std::this_thread::yield();
+        }
+        Logger::set_backend(LogBackend::SYNC);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        
+        size_t found = 0;
+        for (int id = 0; id < 3; ++id) {
+            found += read_lines_containing("[AsyncStop" + std::to_string(id) + "]").size();
+        }
+        restore_test_logging();
+        
+        ASSERT_EQ(static_cast<size_t>(3 * per_thread), found);
+    });
+    
+    // Compare call-site tail latency of the two backends
+    suite->addTest("CallSiteLatencyBenchmark", []() {
+        const int iterations = 20000;
+        Logger logger("AsyncLatency");
+        
+        redirect_to_test_log();
+        double sync_p99 = 0.0;
+        {
+            BENCHMARK("SyncLogging_3x20k_records");
+            sync_p99 = best_p99_ns(logger, iterations, 3);
+        }
+        
+        AsyncLogOptions options;
+        options.queue_capacity = 32768;
+        Logger::set_backend(LogBackend::ASYNC, options);
+        double async_p99 = 0.0;
+        {
+            BENCHMARK("AsyncLogging_3x20k_records");
+            async_p99 = best_p99_ns(logger, iterations, 3);
+            Logger::flush();
+        }
+        const AsyncLogStats stats = Logger::get_async_stats();
+        restore_test_logging();
+        
+        ASSERT_GT(async_p99, 0.0);
+        ASSERT_GT(stats.batches, uint64_t(0));
+        // Enqueueing must beat formatting and writing on the caller by a clear margin
+        ASSERT_LT(async_p99, 0.75 * sync_p99);
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}
@@ -0,0 +1,179 @@
+#include "test_framework.hpp"
+#include "../src/utils/memory_profiler.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace Testing;
+
+/**
+ * @file test_memory_profiler.cpp
+ * @brief Unit tests for the memory profiler
+ *
+ * Test Coverage:
+ * - Sampling by allocation count and by bytes
+ * - Leak table entries keep file, line and function
+ * - Per-thread counters aggregate across threads
+ * - Overhead of full tracking versus sampling
+ */
+
+namespace {
+
+// Blocks of distinct, unusual sizes, so leak table entries can be matched by size
+template<size_t N>
+struct Blocks {
+    std::array<void*, N> pointers{};
+    std::array<size_t, N> sizes{};     // Kept apart from the blocks, so they can be counted after freeing
+};
+
+// Entries of the leak table that belong to blocks
+template<size_t N>
+size_t sampled_among(const Blocks<N>& blocks) {
+    const std::vector<Utils::AllocationInfo> leaks = Utils::MemoryProfiler::getInstance().detectLeaks();
+    size_t sampled = 0;
+    for (const size_t size : blocks.sizes) {
+        sampled += static_cast<size_t>(std::count_if(leaks.begin(), leaks.end(),
+            [size](const Utils::AllocationInfo& leak) { return leak.size == size; }));
+    }
+    return sampled;
+}
+
+template<size_t N>
+void allocate_blocks(Blocks<N>& blocks, size_t base_size) {
+    for (size_t i = 0; i < N; ++i) {
+        blocks.sizes[i] = base_size + 8 * i + 4099;
+        blocks.pointers[i] = Utils::MemoryProfiler::allocate(blocks.sizes[i]);
+    }
+}
+
+template<size_t N>
+void free_blocks(Blocks<N>& blocks) {
+    for (void* block : blocks.pointers) {
+        Utils::MemoryProfiler::deallocate(block);
+    }
+}
+
+} // namespace
+
+// Test suite for MemoryProfiler
+TEST_SUITE(MemoryProfilerTests) {
+    auto suite = std::make_unique<TestSuite>("MemoryProfiler");
+    
+    // Every 8th allocation of the thread is entered in the leak table
+    suite->addTest("SamplesEveryNthAllocation", []() {
+        Utils::MemoryProfiler::initialize(true, false, 100000, 8, 0);
+        Utils::MemoryProfiler& profiler = Utils::MemoryProfiler::getInstance();
+        
+        Blocks<64> blocks;
+        const size_t before = profiler.getStats().allocation_count.load();
+        allocate_blocks(blocks, 0);
+        const size_t allocations = profiler.getStats().allocation_count.load() - before;
+        const size_t sampled = sampled_among(blocks);
+        free_blocks(blocks);
+        const size_t remaining = sampled_among(blocks);
+        Utils::MemoryProfiler::initialize(false);
+        
+        ASSERT_GE(allocations, size_t(64));
+        ASSERT_EQ(size_t(8), sampled);
+        ASSERT_EQ(size_t(0), remaining);
+    });
+    
+    // One allocation per sample_bytes is sampled, and large blocks always are
+    suite->addTest("SamplesByBytes", []() {
+        Utils::MemoryProfiler::initialize(true, false, 100000, 0, 16384);
+        
+        Blocks<40> blocks;
+        allocate_blocks(blocks, 0);
+        const size_t sampled = sampled_among(blocks);
+        free_blocks(blocks);
+        
+        Blocks<1> large;
+        allocate_blocks(large, 65536);
+        const size_t large_sampled = sampled_among(large);
+        free_blocks(large);
+        Utils::MemoryProfiler::initialize(false);
+        
+        ASSERT_GE(sampled, size_t(9));
+        ASSERT_LE(sampled, size_t(11));
+        ASSERT_EQ(size_t(1), large_sampled);
+    });
+    
+    // Leak entries point at the caller's literals
+    suite->addTest("LeakKeepsOrigin", []() {
+        Utils::MemoryProfiler::initialize(true);
+        const int line = __LINE__ + 1;
+        void* block = Utils::MemoryProfiler::allocate(777, __FILE__, line, __FUNCTION__);
+        
+        const std::vector<Utils::AllocationInfo> leaks = Utils::MemoryProfiler::getInstance().detectLeaks();
+        auto leak = std::find_if(leaks.begin(), leaks.end(), [line](const Utils::AllocationInfo& info) {
+            return info.size == 777 && info.line == line;
+        });
+        const bool found = leak != leaks.end();
+        const bool same_file = found && std::strcmp(leak->file, __FILE__) == 0;
+        const bool has_function = found && leak->function != nullptr;
+        
+        Utils::MemoryProfiler::deallocate(block);
+        Utils::MemoryProfiler::initialize(false);
+        
+        ASSERT_TRUE(found);
+        ASSERT_TRUE(same_file);
+        ASSERT_TRUE(has_function);
+    });
+    
+    // Counters written by several threads sum to the totals
+    suite->addTest("ThreadCountersAggregate", []() {
+        Utils::MemoryProfiler::initialize(true, false, 100000, 1024, 0);
+        Utils::MemoryProfiler& profiler = Utils::MemoryProfiler::getInstance();
+        const Utils::MemoryStats before = profiler.getStats();
+        
+        constexpr size_t THREADS = 4;
+        constexpr size_t BLOCKS = 2000;
+        for (int round = 0; round < 2; ++round) {
+            std::vector<std::thread> threads;
+            for (size_t t = 0; t < THREADS; ++t) {
+                threads.emplace_back([]() {
+                    for (size_t i = 0; i < BLOCKS; ++i) {
+                        Utils::MemoryProfiler::deallocate(Utils::MemoryProfiler::allocate(64));
+                    }
+                });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+        }
+        
+        const Utils::MemoryStats after = profiler.getStats();
+        Utils::MemoryProfiler::initialize(false);
+        
+        const size_t allocations = after.allocation_count.load() - before.allocation_count.load();
+        const size_t deallocations = after.deallocation_count.load() - before.deallocation_count.load();
+        ASSERT_GE(allocations, 2 * THREADS * BLOCKS);
+        ASSERT_GE(deallocations, 2 * THREADS * BLOCKS);
+        ASSERT_GE(after.total_allocated.load() - before.total_allocated.load(), 2 * THREADS * BLOCKS * 64);
+        ASSERT_GE(after.peak_usage.load(), after.current_usage.load());
+    });
+    
+    // Cost per allocate/deallocate pair with full tracking and with sampling
+    suite->addTest("SamplingOverheadBenchmark", []() {
+        constexpr size_t PAIRS = 200000;
+        const size_t intervals[] = {1, 1024};
+        for (size_t interval : intervals) {
+            Utils::MemoryProfiler::initialize(true, false, 100000, interval, 0);
+            const auto start = std::chrono::high_resolution_clock::now();
+            for (size_t i = 0; i < PAIRS; ++i) {
+                Utils::MemoryProfiler::deallocate(Utils::MemoryProfiler::allocate(32 + (i & 63)));
+            }
+            const double elapsed_ns = std::chrono::duration<double, std::nano>(
+                std::chrono::high_resolution_clock::now() - start).count();
+            
+            Utils::Logger logger("Benchmark");
+            logger.info("Sample interval {}: {:.2e} ns per allocation", interval, elapsed_ns / PAIRS);
+        }
+        Utils::MemoryProfiler::initialize(false);
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}
@@ -0,0 +1,289 @@
+#include "test_framework.hpp"
+#include "../src/utils/metrics.hpp"
+#include "../src/models/black_scholes.hpp"
+#include "../src/models/implied_volatility.hpp"
+#include "../src/config/config.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace Utils;
+using namespace Testing;
+
+/**
+ * @file test_metrics.cpp
+ * @brief Unit tests for the hot-path metrics and their Prometheus export
+ *
+ * Test Coverage:
+ * - Counter totals across owned and shared thread shards
+ * - Recording switched off, directly and through performance.enable_profiling
+ * - Recording switched on by performance.enable_profiling in a nested config file
+ * - Histogram bucket bounds and quantile accuracy
+ * - Counters and latencies from batch pricing and implied volatility
+ * - Prometheus text exposition and the HTTP endpoint
+ */
+
+namespace {
+
+// Records from a clean slate for the lifetime of a test
+class Recording {
+public:
+    Recording() : previous_(Metrics::enabled()) {
+        Metrics::reset();
+        Metrics::set_enabled(true);
+    }
+    
+    ~Recording() { Metrics::set_enabled(previous_); }
+
+private:
+    bool previous_;
+};
+
+// Response to one HTTP request to the local endpoint
+std::string http_get(uint16_t port, const std::string& path) {
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in endpoint{};
+    endpoint.sin_family = AF_INET;
+    endpoint.sin_port = htons(port);
+    ::inet_pton(AF_INET, "127.0.0.1", &endpoint.sin_addr);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<const sockaddr*>(&endpoint), sizeof(endpoint)) != 0) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return "";
+    }
+    
+    const std::string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    ::send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+    std::string response;
+    char buffer[4096];
+    ssize_t n = 0;
+    while ((n = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        response.append(buffer, static_cast<size_t>(n));
+    }
+    ::close(fd);
+    return response;
+}
+
+// Copies the shipped config.json to path with profiling switched on
+void write_profiling_config(const std::string& path) {
+    std::ifstream in("config.json");
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    const std::string off = "\"enable_profiling\": false";
+    const size_t pos = content.find(off, content.find("\"performance\""));
+    if (pos == std::string::npos) {
+        throw std::runtime_error("config.json has no performance.enable_profiling");
+    }
+    content.replace(pos, off.size(), "\"enable_profiling\": true");
+    std::ofstream(path) << content;
+}
+
+} // namespace
+
+// Test suite for Metrics
+TEST_SUITE(MetricsTests) {
+    auto suite = std::make_unique<TestSuite>("Metrics");
+    
+    suite->addTest("CountersAcrossThreads", []() {
+        Recording recording;
+        
+        // More threads than shards, so some share the atomic overflow shard
+        const size_t threads = Metrics::MAX_THREADS + 16;
+        const uint64_t per_thread = 2000;
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&]() {
+                for (uint64_t i = 0; i < per_thread; ++i) {
+                    Metrics::add(MetricCounter::CACHE_HITS);
+                    Metrics::add(MetricCounter::IV_ITERATIONS, 3);
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        
+        const MetricsSnapshot snapshot = Metrics::snapshot();
+        ASSERT_EQ(threads * per_thread, snapshot.counter(MetricCounter::CACHE_HITS));
+        ASSERT_EQ(3 * threads * per_thread, snapshot.counter(MetricCounter::IV_ITERATIONS));
+        
+        // Shards of exited threads keep their totals when reused
+        std::thread([]() { Metrics::add(MetricCounter::CACHE_HITS); }).join();
+        ASSERT_EQ(threads * per_thread + 1, Metrics::snapshot().counter(MetricCounter::CACHE_HITS));
+    });
+    
+    suite->addTest("DisabledRecordsNothing", []() {
+        Recording recording;
+        Metrics::set_enabled(false);
+        Metrics::add(MetricCounter::CACHE_MISSES, 5);
+        Metrics::record(MetricHistogram::PRICE_BATCH, 1000);
+        Metrics::set(MetricGauge::PIPELINE_PARSED_DEPTH, 7);
+        {
+            METRICS_LATENCY(MetricHistogram::IV_BATCH);
+        }
+        
+        const MetricsSnapshot snapshot = Metrics::snapshot();
+        ASSERT_EQ(uint64_t(0), snapshot.counter(MetricCounter::CACHE_MISSES));
+        ASSERT_EQ(uint64_t(0), snapshot.histogram(MetricHistogram::PRICE_BATCH).count);
+        ASSERT_EQ(uint64_t(0), snapshot.histogram(MetricHistogram::IV_BATCH).count);
+        ASSERT_EQ(int64_t(0), snapshot.gauge(MetricGauge::PIPELINE_PARSED_DEPTH));
+    });
+    
+    suite->addTest("ConfigEnablesRecording", []() {
+        Recording recording;
+        Config::ConfigManager& config = Config::ConfigManager::getInstance();
+        config.set("performance.enable_profiling", Config::ConfigValue(false));
+        ASSERT_FALSE(Metrics::enabled());
+        ASSERT_FALSE(config.getEnableProfiling());
+        config.set("performance.enable_profiling", Config::ConfigValue(true));
+        ASSERT_TRUE(Metrics::enabled());
+        ASSERT_TRUE(config.getEnableProfiling());
+        config.set("performance.enable_profiling", Config::ConfigValue(false));
+    });
+    
+    // The setting read from the "performance" object of a file, not only through set()
+    suite->addTest("ConfigFileEnablesRecording", []() {
+        Recording recording;
+        Metrics::set_enabled(false);
+        const std::string path = "test_metrics_config.json";
+        write_profiling_config(path);
+        
+        Config::ConfigManager& config = Config::ConfigManager::getInstance();
+        const bool loaded = config.initialize(path);
+        std::remove(path.c_str());
+        std::remove((path + ".cache").c_str());
+        ASSERT_TRUE(loaded);
+        ASSERT_TRUE(config.getEnableProfiling());
+        ASSERT_TRUE(Metrics::enabled());
+        Metrics::add(MetricCounter::CACHE_HITS, 3);
+        ASSERT_EQ(uint64_t(3), Metrics::snapshot().counter(MetricCounter::CACHE_HITS));
+        
+        ASSERT_TRUE(config.initialize("test_config.json"));
+        ASSERT_FALSE(Metrics::enabled());
+    });
+    
+    suite->addTest("HistogramBuckets", []() {
+        // Every value lies inside its bucket, and the buckets tile the range
+        for (uint64_t value : {uint64_t(0), uint64_t(1), uint64_t(15), uint64_t(16), uint64_t(17),
+                               uint64_t(31), uint64_t(32), uint64_t(1000), uint64_t(123456789),
+                               (uint64_t(1) << 41) + 12345}) {
+            const size_t bucket = HistogramSnapshot::bucket(value);
+            ASSERT_TRUE(value < HistogramSnapshot::bucket_end(bucket));
+            ASSERT_TRUE(bucket == 0 || HistogramSnapshot::bucket_end(bucket - 1) <= value);
+        }
+        for (size_t b = 1; b < HistogramSnapshot::BUCKETS; ++b) {
+            ASSERT_EQ(b, HistogramSnapshot::bucket(HistogramSnapshot::bucket_end(b - 1)));
+        }
+        ASSERT_EQ(HistogramSnapshot::BUCKETS - 1, HistogramSnapshot::bucket(UINT64_MAX));
+        
+        Recording recording;
+        for (uint64_t value = 1; value <= 10000; ++value) {
+            Metrics::record(MetricHistogram::PRICE_BATCH, value);
+        }
+        const HistogramSnapshot histogram = Metrics::snapshot().histogram(MetricHistogram::PRICE_BATCH);
+        ASSERT_EQ(uint64_t(10000), histogram.count);
+        ASSERT_NEAR(5000.5, histogram.mean(), 1e-9);
+        ASSERT_NEAR(5000.0, static_cast<double>(histogram.quantile(0.5)), 5000.0 / 16.0);
+        ASSERT_NEAR(9900.0, static_cast<double>(histogram.quantile(0.99)), 9900.0 / 16.0);
+        ASSERT_GE(histogram.quantile(1.0), uint64_t(10000));
+        ASSERT_EQ(uint64_t(1), histogram.quantile(0.0));
+    });
+    
+    suite->addTest("InstrumentedPricing", []() {
+        Recording recording;
+        const size_t n = 100;
+        std::vector<double> spot(n, 100.0), strike(n, 100.0), expiry(n, 0.5), rate(n, 0.03), vol(n, 0.25);
+        std::vector<uint8_t> is_call(n, 1);
+        strike[3] = -1.0;
+        vol[7] = 0.0;
+        std::vector<double> price(n);
+        BlackScholes::BatchInput input{spot.data(), strike.data(), expiry.data(), rate.data(),
+                                       vol.data(), nullptr, is_call.data(), n};
+        BlackScholes::BatchOutput output;
+        output.price = price.data();
+        ASSERT_EQ(n - 2, BlackScholes::OptionPricer::price_batch(input, output));
+        BlackScholes::OptionPricer::quote(100.0, 90.0, 1.0, 0.05, 0.2, 0.0, false);
+        
+        std::vector<double> implied(n);
+        std::vector<uint32_t> iterations(n);
+        price[3] = 1.0;
+        price[7] = 1e6;     // Above the upper bound: fails
+        BlackScholes::IVBatchInput iv_input;
+        iv_input.market_price = price.data();
+        iv_input.spot_price = spot.data();
+        iv_input.strike_price = spot.data();
+        iv_input.time_to_expiry = expiry.data();
+        iv_input.risk_free_rate = rate.data();
+        iv_input.is_call = is_call.data();
+        iv_input.count = n;
+        BlackScholes::IVBatchOutput iv_output;
+        iv_output.implied_vol = implied.data();
+        iv_output.iterations = iterations.data();
+        const size_t converged = BlackScholes::ImpliedVolatilitySolver::solve_batch(iv_input, iv_output);
+        uint64_t total_iterations = 0;
+        for (uint32_t count : iterations) {
+            total_iterations += count;
+        }
+        
+        const MetricsSnapshot snapshot = Metrics::snapshot();
+        ASSERT_EQ(uint64_t(n - 1), snapshot.counter(MetricCounter::OPTIONS_PRICED));
+        ASSERT_EQ(uint64_t(2), snapshot.counter(MetricCounter::OPTIONS_REJECTED));
+        ASSERT_EQ(uint64_t(1), snapshot.histogram(MetricHistogram::PRICE_BATCH).count);
+        ASSERT_GT(snapshot.histogram(MetricHistogram::PRICE_BATCH).sum, uint64_t(0));
+        ASSERT_EQ(uint64_t(n), snapshot.counter(MetricCounter::IV_SOLVES));
+        ASSERT_EQ(uint64_t(n - converged), snapshot.counter(MetricCounter::IV_FAILURES));
+        ASSERT_GE(snapshot.counter(MetricCounter::IV_FAILURES), uint64_t(1));
+        ASSERT_EQ(total_iterations, snapshot.counter(MetricCounter::IV_ITERATIONS));
+        ASSERT_EQ(uint64_t(1), snapshot.histogram(MetricHistogram::IV_BATCH).count);
+    });
+    
+    suite->addTest("PrometheusText", []() {
+        Recording recording;
+        Metrics::add(MetricCounter::CACHE_HITS, 42);
+        Metrics::set(MetricGauge::PIPELINE_PRICED_DEPTH, 3);
+        Metrics::record(MetricHistogram::PIPELINE_BATCH, 100);         // Below the first bound
+        Metrics::record(MetricHistogram::PIPELINE_BATCH, 1500000);     // 1.5 ms
+        
+        const std::string text = Metrics::prometheus();
+        ASSERT_TRUE(text.find("# TYPE blackscholes_cache_hits_total counter\n") != std::string::npos);
+        ASSERT_TRUE(text.find("\nblackscholes_cache_hits_total 42\n") != std::string::npos);
+        ASSERT_TRUE(text.find("\nblackscholes_options_priced_total 0\n") != std::string::npos);
+        ASSERT_TRUE(text.find("# TYPE blackscholes_pipeline_priced_depth gauge\n") != std::string::npos);
+        ASSERT_TRUE(text.find("\nblackscholes_pipeline_priced_depth 3\n") != std::string::npos);
+        ASSERT_TRUE(text.find("# TYPE blackscholes_pipeline_batch_seconds histogram\n") != std::string::npos);
+        ASSERT_TRUE(text.find("blackscholes_pipeline_batch_seconds_bucket{le=\"2.56e-07\"} 1\n") != std::string::npos);
+        ASSERT_TRUE(text.find("blackscholes_pipeline_batch_seconds_bucket{le=\"0.00104858\"} 1\n") != std::string::npos);
+        ASSERT_TRUE(text.find("blackscholes_pipeline_batch_seconds_bucket{le=\"0.00209715\"} 2\n") != std::string::npos);
+        ASSERT_TRUE(text.find("blackscholes_pipeline_batch_seconds_bucket{le=\"+Inf\"} 2\n") != std::string::npos);
+        ASSERT_TRUE(text.find("blackscholes_pipeline_batch_seconds_count 2\n") != std::string::npos);
+        ASSERT_TRUE(text.find("blackscholes_pipeline_batch_seconds_sum 0.0015001\n") != std::string::npos);
+    });
+    
+    suite->addTest("HttpEndpoint", []() {
+        Recording recording;
+        Metrics::add(MetricCounter::PIPELINE_BATCHES, 9);
+        MetricsServer server(0);
+        ASSERT_GT(server.port(), uint16_t(0));
+        
+        const std::string scrape = http_get(server.port(), "/metrics");
+        ASSERT_TRUE(scrape.rfind("HTTP/1.1 200 OK\r\n", 0) == 0);
+        ASSERT_TRUE(scrape.find("Content-Type: text/plain; version=0.0.4") != std::string::npos);
+        ASSERT_TRUE(scrape.find("\nblackscholes_pipeline_batches_total 9\n") != std::string::npos);
+        
+        const std::string missing = http_get(server.port(), "/other");
+        ASSERT_TRUE(missing.rfind("HTTP/1.1 404 Not Found\r\n", 0) == 0);
+        ASSERT_EQ(uint64_t(2), server.requests());
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}
@@ -0,0 +1,383 @@
+#include "test_framework.hpp"
+#include "../src/models/black_scholes.hpp"
+#include "../src/models/monte_carlo.hpp"
+#include "../src/models/philox.hpp"
+#include "../src/models/sobol.hpp"
+#include "../src/utils/thread_pool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace BlackScholes;
+using namespace Testing;
+
+/**
+ * @file test_monte_carlo.cpp
+ * @brief Unit tests for the Monte Carlo pricing engine
+ *
+ * Test Coverage:
+ * - Philox4x32-10 known-answer values
+ * - Sobol points, stratification and Brownian-bridge covariance
+ * - European payoffs against the closed-form OptionPricer
+ * - Reproducibility across thread counts
+ * - Barrier parity, lookback and Asian ordering
+ * - Antithetic variance reduction
+ * - Invalid contracts
+ * - Quasi-Monte Carlo accuracy and convergence against pseudo-random paths
+ * - Adjoint pathwise Greeks against the closed forms
+ */
+
+namespace {
+
+MonteCarloOptions test_options(uint64_t simulations, uint32_t steps) {
+    MonteCarloOptions options;
+    options.simulations = simulations;
+    options.steps = steps;
+    options.antithetic = true;
+    options.seed = 2025;
+    return options;
+}
+
+MonteCarloOptions sobol_options(uint64_t simulations, uint32_t steps) {
+    MonteCarloOptions options = test_options(simulations, steps);
+    options.sampling = MonteCarloSampling::SOBOL;
+    options.qmc_replications = 8;
+    return options;
+}
+
+PathContract contract(PathPayoff payoff, bool is_call, double barrier = 0.0) {
+    PathContract terms;
+    terms.payoff = payoff;
+    terms.is_call = is_call;
+    terms.barrier = barrier;
+    return terms;
+}
+
+} // namespace
+
+// Test suite for the counter-based generator
+TEST_SUITE(PhiloxGenerator) {
+    auto suite = std::make_unique<TestSuite>("PhiloxGenerator");
+    
+    // Reference vectors published with Random123
+    suite->addTest("KnownAnswerValues", []() {
+        using Random::Philox4x32;
+        Philox4x32::Counter zero = Philox4x32::generate({{0u, 0u, 0u, 0u}}, {{0u, 0u}});
+        ASSERT_EQ(0x6627e8d5u, zero[0]);
+        ASSERT_EQ(0xe169c58du, zero[1]);
+        ASSERT_EQ(0xbc57ac4cu, zero[2]);
+        ASSERT_EQ(0x9b00dbd8u, zero[3]);
+        
+        Philox4x32::Counter pi = Philox4x32::generate({{0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u}},
+                                                      {{0xa4093822u, 0x299f31d0u}});
+        ASSERT_EQ(0xd16cfe09u, pi[0]);
+        ASSERT_EQ(0x94fdccebu, pi[1]);
+        ASSERT_EQ(0x5001e420u, pi[2]);
+        ASSERT_EQ(0x24126ea1u, pi[3]);
+    });
+    
+    suite->addTest("UnitIntervalIsOpen", []() {
+        ASSERT_GT(Random::to_unit_interval(0u, 0u), 0.0);
+        ASSERT_LT(Random::to_unit_interval(0xffffffffu, 0xffffffffu), 1.0);
+        ASSERT_NEAR(0.5, Random::to_unit_interval(0x80000000u, 0u), 1e-15);
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}
+
+// Test suite for the low-discrepancy sequence and path construction
+TEST_SUITE(SobolSequenceTests) {
+    auto suite = std::make_unique<TestSuite>("SobolSequence");
+    
+    suite->addTest("FirstPoints", []() {
+        SobolSequence sobol(2);
+        const double expected[4][2] = {{0.0, 0.0}, {0.5, 0.5}, {0.75, 0.25}, {0.25, 0.75}};
+        uint32_t point[2];
+        for (uint64_t i = 0; i < 4; ++i) {
+            sobol.point(i, point);
+            ASSERT_EQ(expected[i][0], point[0] * 0x1.0p-32);
+            ASSERT_EQ(expected[i][1], point[1] * 0x1.0p-32);
+        }
+        ASSERT_THROWS(SobolSequence(0), std::invalid_argument);
+        ASSERT_THROWS(SobolSequence(SobolSequence::MAX_DIMENSIONS + 1), std::invalid_argument);
+    });
+    
+    // Gray-code stepping reproduces the directly computed points
+    suite->addTest("NextMatchesPoint", []() {
+        SobolSequence sobol(40);
+        std::vector<uint32_t> state(40), direct(40);
+        sobol.point(1000, state.data());
+        for (uint64_t i = 1000; i < 3000; ++i) {
+            sobol.next(i, state.data());
+            sobol.point(i + 1, direct.data());
+            ASSERT_TRUE(state == direct);
+        }
+    });
+    
+    // Every dimension is a (0, m, 1)-net: the first 2^m points hit each interval of width 2^-m once
+    suite->addTest("EveryDimensionIsStratified", []() {
+        constexpr uint32_t m = 10;
+        SobolSequence sobol(SobolSequence::MAX_DIMENSIONS);
+        std::vector<uint32_t> point(SobolSequence::MAX_DIMENSIONS);
+        std::vector<std::vector<bool>> seen(SobolSequence::MAX_DIMENSIONS, std::vector<bool>(1u << m, false));
+        for (uint64_t i = 0; i < (1u << m); ++i) {
+            sobol.point(i, point.data());
+            for (uint32_t d = 0; d < SobolSequence::MAX_DIMENSIONS; ++d) {
+                ASSERT_FALSE(seen[d][point[d] >> (32 - m)]);
+                seen[d][point[d] >> (32 - m)] = true;
+            }
+        }
+    });
+    
+    // The bridge is linear with covariance min(t_i, t_j)
+    suite->addTest("BrownianBridgeCovariance", []() {
+        for (size_t steps : {1u, 2u, 7u, 16u}) {
+            BrownianBridge bridge(steps);
+            std::vector<std::vector<double>> columns(steps, std::vector<double>(steps));
+            std::vector<double> z(steps, 0.0);
+            for (size_t k = 0; k < steps; ++k) {
+                z[k] = 1.0;
+                bridge.transform(z.data(), columns[k].data());
+                z[k] = 0.0;
+            }
+            for (size_t i = 0; i < steps; ++i) {
+                for (size_t j = 0; j < steps; ++j) {
+                    double covariance = 0.0;
+                    for (size_t k = 0; k < steps; ++k) {
+                        covariance += columns[k][i] * columns[k][j];
+                    }
+                    const double expected = static_cast<double>(std::min(i, j) + 1) / static_cast<double>(steps);
+                    ASSERT_NEAR(expected, covariance, 1e-12);
+                }
+            }
+        }
+        ASSERT_THROWS(BrownianBridge(0), std::invalid_argument);
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}
+
+// Test suite for the Monte Carlo engine
+TEST_SUITE(MonteCarloEngineTests) {
+    auto suite = std::make_unique<TestSuite>("MonteCarloEngine");
+    
+    // European estimates agree with the closed form within four standard errors
+    suite->addTest("EuropeanMatchesClosedForm", []() {
+        Parameters params(100.0, 105.0, 0.75, 0.04, 0.25, 0.01);
+        MonteCarloEngine engine(test_options(200000, 1));
+        
+        MonteCarloResult call = engine.price(params, contract(PathPayoff::EUROPEAN, true));
+        MonteCarloResult put = engine.price(params, contract(PathPayoff::EUROPEAN, false));
+        ASSERT_TRUE(call.is_valid && put.is_valid);
+        ASSERT_EQ(200000u, call.paths);
+        ASSERT_LT(call.std_error, 0.05);
+        ASSERT_NEAR(OptionPricer::price_call(params).price, call.price, 4.0 * call.std_error);
+        ASSERT_NEAR(OptionPricer::price_put(params).price, put.price, 4.0 * put.std_error);
+    });
+    
+    // The estimate does not depend on how many threads run the blocks
+    suite->addTest("ReproducibleAcrossThreadCounts", []() {
+        Parameters params(100.0, 100.0, 1.0, 0.05, 0.3, 0.0);
+        Utils::ThreadPool pool(3);
+        MonteCarloOptions options = test_options(20000, 64);
+        
+        options.max_threads = 1;
+        MonteCarloResult single = MonteCarloEngine(options, &pool).price(params, contract(PathPayoff::ASIAN_ARITHMETIC, true));
+        options.max_threads = 4;
+        MonteCarloResult multi = MonteCarloEngine(options, &pool).price(params, contract(PathPayoff::ASIAN_ARITHMETIC, true));
+        
+        ASSERT_EQ(1u, single.threads);
+        ASSERT_EQ(4u, multi.threads);
+        ASSERT_EQ(single.price, multi.price);
+        ASSERT_EQ(single.std_error, multi.std_error);
+    });
+    
+    // Knock-in plus knock-out is the vanilla option
+    suite->addTest("BarrierInOutParity", []() {
+        Parameters params(100.0, 100.0, 0.5, 0.03, 0.2, 0.0);
+        MonteCarloEngine engine(test_options(40000, 50));
+        
+        MonteCarloResult up_out = engine.price(params, contract(PathPayoff::UP_AND_OUT, true, 115.0));
+        MonteCarloResult up_in = engine.price(params, contract(PathPayoff::UP_AND_IN, true, 115.0));
+        MonteCarloResult down_out = engine.price(params, contract(PathPayoff::DOWN_AND_OUT, false, 90.0));
+        MonteCarloResult down_in = engine.price(params, contract(PathPayoff::DOWN_AND_IN, false, 90.0));
+        
+        const double call = OptionPricer::price_call(params).price;
+        const double put = OptionPricer::price_put(params).price;
+        ASSERT_NEAR(call, up_out.price + up_in.price, 4.0 * (up_out.std_error + up_in.std_error));
+        ASSERT_NEAR(put, down_out.price + down_in.price, 4.0 * (down_out.std_error + down_in.std_error));
+        ASSERT_LT(up_out.price, call);
+        ASSERT_LT(down_out.price, put);
+    });
+    
+    // Averaging lowers and lookback raises the value relative to the vanilla call
+    suite->addTest("PathDependentOrdering", []() {
+        Parameters params(100.0, 100.0, 1.0, 0.05, 0.25, 0.0);
+        MonteCarloEngine engine(test_options(20000, 52));
+        const double call = OptionPricer::price_call(params).price;
+        
+        MonteCarloResult asian = engine.price(params, contract(PathPayoff::ASIAN_ARITHMETIC, true));
+        MonteCarloResult floating = engine.price(params, contract(PathPayoff::LOOKBACK_FLOATING, true));
+        MonteCarloResult fixed = engine.price(params, contract(PathPayoff::LOOKBACK_FIXED, true));
+        ASSERT_LT(asian.price, call);
+        ASSERT_GT(floating.price, call);
+        ASSERT_GT(fixed.price, call);
+    });
+    
+    // Antithetic pairs give a smaller standard error for the same path count
+    suite->addTest("AntitheticReducesError", []() {
+        Parameters params(100.0, 90.0, 1.0, 0.05, 0.2, 0.0);
+        MonteCarloOptions options = test_options(100000, 1);
+        MonteCarloResult paired = MonteCarloEngine(options).price(params, contract(PathPayoff::EUROPEAN, true));
+        options.antithetic = false;
+        MonteCarloResult plain = MonteCarloEngine(options).price(params, contract(PathPayoff::EUROPEAN, true));
+        ASSERT_LT(paired.std_error, plain.std_error);
+    });
+    
+    suite->addTest("InvalidContract", []() {
+        Parameters params(100.0, 100.0, 1.0, 0.05, 0.2, 0.0);
+        MonteCarloEngine engine(test_options(1000, 10));
+        MonteCarloResult result = engine.price(params, contract(PathPayoff::UP_AND_OUT, true, -1.0));
+        ASSERT_FALSE(result.is_valid);
+        ASSERT_FALSE(result.error_msg.empty());
+        ASSERT_EQ(std::string("LOOKBACK_FIXED"), std::string(to_string(PathPayoff::LOOKBACK_FIXED)));
+        
+        MonteCarloOptions options = sobol_options(1000, MonteCarloEngine::MAX_SOBOL_STEPS + 1);
+        ASSERT_FALSE(MonteCarloEngine(options).price(params, contract(PathPayoff::ASIAN_ARITHMETIC, true)).is_valid);
+        options = sobol_options(1000, 10);
+        options.qmc_replications = 1;
+        ASSERT_FALSE(MonteCarloEngine(options).price(params, contract(PathPayoff::EUROPEAN, true)).is_valid);
+        ASSERT_EQ(std::string("SOBOL"), std::string(to_string(MonteCarloSampling::SOBOL)));
+    });
+    
+    // Pseudo-random geometric Asian estimate agrees with its closed form
+    suite->addTest("GeometricAsianMatchesClosedForm", []() {
+        Parameters params(100.0, 95.0, 1.0, 0.05, 0.3, 0.02);
+        MonteCarloEngine engine(test_options(40000, 12));
+        MonteCarloResult call = engine.price(params, contract(PathPayoff::ASIAN_GEOMETRIC, true));
+        MonteCarloResult put = engine.price(params, contract(PathPayoff::ASIAN_GEOMETRIC, false));
+        ASSERT_NEAR(geometric_asian_price(params, true, 12), call.price, 4.0 * call.std_error);
+        ASSERT_NEAR(geometric_asian_price(params, false, 12), put.price, 4.0 * put.std_error);
+        ASSERT_NEAR(OptionPricer::price_call(params).price, geometric_asian_price(Parameters(100.0, 95.0, 1.0, 0.05, 0.3, 0.02), true, 1), 1e-10);
+    });
+    
+    // Sobol paths hit the closed forms with a much smaller error for the same path count
+    suite->addTest("SobolMatchesClosedForm", []() {
+        Parameters params(100.0, 105.0, 0.75, 0.04, 0.25, 0.01);
+        MonteCarloResult qmc = MonteCarloEngine(sobol_options(16384, 1)).price(params, contract(PathPayoff::EUROPEAN, true));
+        MonteCarloResult mc = MonteCarloEngine(test_options(16384, 1)).price(params, contract(PathPayoff::EUROPEAN, true));
+        ASSERT_TRUE(qmc.is_valid);
+        ASSERT_EQ(16384u, qmc.paths);
+        ASSERT_NEAR(OptionPricer::price_call(params).price, qmc.price, 4.0 * qmc.std_error);
+        ASSERT_LT(4.0 * qmc.std_error, mc.std_error);
+        
+        MonteCarloResult asian = MonteCarloEngine(sobol_options(16384, 64)).price(params, contract(PathPayoff::ASIAN_GEOMETRIC, false));
+        ASSERT_TRUE(asian.is_valid);
+        ASSERT_NEAR(geometric_asian_price(params, false, 64), asian.price, std::max(4.0 * asian.std_error, 1e-3));
+        ASSERT_LT(asian.std_error, 0.01);
+    });
+    
+    suite->addTest("SobolReproducibleAcrossThreadCounts", []() {
+        Parameters params(100.0, 100.0, 1.0, 0.05, 0.3, 0.0);
+        Utils::ThreadPool pool(3);
+        MonteCarloOptions options = sobol_options(10000, 32);
+        
+        options.max_threads = 1;
+        MonteCarloResult single = MonteCarloEngine(options, &pool).price(params, contract(PathPayoff::UP_AND_OUT, true, 130.0));
+        options.max_threads = 4;
+        MonteCarloResult multi = MonteCarloEngine(options, &pool).price(params, contract(PathPayoff::UP_AND_OUT, true, 130.0));
+        ASSERT_TRUE(single.is_valid);
+        ASSERT_EQ(single.price, multi.price);
+        ASSERT_EQ(single.std_error, multi.std_error);
+    });
+    
+    // One adjoint simulation gives the price of price() and the analytic Greeks within four standard errors
+    suite->addTest("AdjointGreeksMatchClosedForm", []() {
+        const Parameters params(100.0, 105.0, 0.75, 0.04, 0.25, 0.01);
+        for (const bool sobol : {false, true}) {
+            const MonteCarloEngine engine(sobol ? sobol_options(65536, 1) : test_options(200000, 1));
+            for (const bool is_call : {true, false}) {
+                const MonteCarloGreeks result = engine.price_with_greeks(params, contract(PathPayoff::EUROPEAN, is_call));
+                ASSERT_TRUE(result.estimate.is_valid);
+                ASSERT_NEAR(engine.price(params, contract(PathPayoff::EUROPEAN, is_call)).price,
+                            result.estimate.price, 1e-9);
+                
+                const Greeks expected = is_call ? OptionPricer::calculate_call_greeks(params)
+                                                : OptionPricer::calculate_put_greeks(params);
+                const Greeks& error = result.std_error;
+                ASSERT_LT(error.delta, 5e-3);
+                ASSERT_NEAR(expected.delta, result.greeks.delta, 4.0 * error.delta + 1e-6);
+                ASSERT_NEAR(expected.theta, result.greeks.theta, 4.0 * error.theta + 1e-6);
+                ASSERT_NEAR(expected.vega, result.greeks.vega, 4.0 * error.vega + 1e-6);
+                ASSERT_NEAR(expected.rho, result.greeks.rho, 4.0 * error.rho + 1e-6);
+                ASSERT_TRUE(std::isnan(result.greeks.gamma));
+                
+                // ∂V/∂K and ∂V/∂q satisfy the identities V = S ∂V/∂S + K ∂V/∂K and ∂V/∂q = -T S e^{-qT} N(±d1)
+                ASSERT_NEAR(result.estimate.price,
+                            params.spot_price * result.greeks.delta + params.strike_price * result.dual_delta, 1e-9);
+                ASSERT_NEAR(-params.time_to_expiry * params.spot_price * result.greeks.delta / 100.0,
+                            result.dividend_rho, 1e-9);
+            }
+        }
+    });
+    
+    // Pathwise geometric Asian delta and vega against bumps of the closed form
+    suite->addTest("AdjointAsianGreeks", []() {
+        const Parameters params(100.0, 95.0, 1.0, 0.05, 0.3, 0.02);
+        const MonteCarloGreeks result = MonteCarloEngine(sobol_options(32768, 12))
+                                            .price_with_greeks(params, contract(PathPayoff::ASIAN_GEOMETRIC, true));
+        ASSERT_TRUE(result.estimate.is_valid);
+        const auto bumped = [&](double dS, double dsigma) {
+            return geometric_asian_price(Parameters(params.spot_price + dS, params.strike_price, params.time_to_expiry,
+                                                    params.risk_free_rate, params.volatility + dsigma,
+                                                    params.dividend_yield), true, 12);
+        };
+        const double delta = (bumped(1e-4, 0.0) - bumped(-1e-4, 0.0)) / 2e-4;
+        const double vega = (bumped(0.0, 1e-5) - bumped(0.0, -1e-5)) / 2e-5 / 100.0;
+        ASSERT_NEAR(delta, result.greeks.delta, std::max(4.0 * result.std_error.delta, 1e-3));
+        ASSERT_NEAR(vega, result.greeks.vega, std::max(4.0 * result.std_error.vega, 1e-3));
+        
+        // Lookbacks are differentiable along the path; barriers are not
+        const MonteCarloEngine engine(test_options(4000, 20));
+        ASSERT_TRUE(engine.price_with_greeks(params, contract(PathPayoff::LOOKBACK_FIXED, true)).estimate.is_valid);
+        const MonteCarloGreeks barrier = engine.price_with_greeks(params, contract(PathPayoff::UP_AND_OUT, true, 130.0));
+        ASSERT_FALSE(barrier.estimate.is_valid);
+        ASSERT_FALSE(barrier.estimate.error_msg.empty());
+    });
+    
+    suite->addTest("AsianBenchmark", []() {
+        Parameters params(100.0, 100.0, 1.0, 0.05, 0.2, 0.0);
+        MonteCarloEngine engine(test_options(20000, 252));
+        {
+            BENCHMARK("MonteCarloAsian_20k_paths_252_steps");
+            MonteCarloResult result = engine.price(params, contract(PathPayoff::ASIAN_ARITHMETIC, true));
+            ASSERT_TRUE(result.is_valid);
+        }
+    });
+    
+    // Error against the closed-form geometric Asian as the path count grows
+    suite->addTest("ConvergenceBenchmark", []() {
+        Parameters params(100.0, 100.0, 1.0, 0.05, 0.2, 0.0);
+        const PathContract asian = contract(PathPayoff::ASIAN_GEOMETRIC, true);
+        const double exact = geometric_asian_price(params, true, 16);
+        Utils::Logger logger("Benchmark");
+        
+        double mc_error = 0.0;
+        double qmc_error = 0.0;
+        for (uint64_t paths = 1024; paths <= 65536; paths *= 4) {
+            BENCHMARK("MonteCarloConvergence_" + std::to_string(paths) + "_paths");
+            MonteCarloResult mc = MonteCarloEngine(test_options(paths, 16)).price(params, asian);
+            MonteCarloResult qmc = MonteCarloEngine(sobol_options(paths, 16)).price(params, asian);
+            ASSERT_TRUE(mc.is_valid && qmc.is_valid);
+            logger.info("{} paths: MC error {:.2e} (std error {:.2e}), QMC error {:.2e} (std error {:.2e})",
+                        paths, std::abs(mc.price - exact), mc.std_error, std::abs(qmc.price - exact), qmc.std_error);
+            mc_error = mc.std_error;
+            qmc_error = qmc.std_error;
+        }
+        ASSERT_LT(10.0 * qmc_error, mc_error);
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}
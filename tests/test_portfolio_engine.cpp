@@ -0,0 +1,217 @@
+#include "test_framework.hpp"
+#include "../src/models/portfolio_engine.hpp"
+#include "../src/models/black_scholes.hpp"
+#include "../src/utils/thread_pool.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace BlackScholes;
+using namespace Testing;
+
+/**
+ * @file test_portfolio_engine.cpp
+ * @brief Unit tests for portfolio Greeks netting
+ *
+ * Test Coverage:
+ * - Totals by underlying, expiry bucket and portfolio against per-position Greeks
+ * - Dirty tracking: only changed positions are repriced
+ * - Bit-identical totals for incremental and full refreshes and across thread counts
+ * - Input validation
+ */
+
+namespace {
+
+// Book of calls and puts on three underlyings spread over five years
+struct Book {
+    std::vector<Position> positions;
+    std::vector<std::string> underlyings;
+    
+    explicit Book(size_t n) {
+        const char* names[] = {"SPX", "NDX", "RUT"};
+        const double spots[] = {100.0, 150.0, 80.0};
+        for (size_t i = 0; i < n; ++i) {
+            const size_t u = (i * 7) % 3;
+            const double K = spots[u] * (0.7 + 0.6 * static_cast<double>((i * 37) % 101) / 100.0);
+            const double T = 0.05 + 4.95 * static_cast<double>((i * 53) % 97) / 96.0;
+            const double vol = 0.1 + 0.3 * static_cast<double>((i * 11) % 29) / 28.0;
+            const double quantity = static_cast<double>(static_cast<int>(i % 21) - 10);
+            positions.emplace_back(Parameters(spots[u], K, T, 0.03, vol, 0.01), i % 2 == 0, quantity);
+            underlyings.push_back(names[u]);
+        }
+    }
+};
+
+bool same(const PortfolioGreeks& a, const PortfolioGreeks& b) {
+    return a.value == b.value && a.delta == b.delta && a.gamma == b.gamma && a.theta == b.theta &&
+           a.vega == b.vega && a.rho == b.rho && a.positions == b.positions && a.rejected == b.rejected;
+}
+
+} // namespace
+
+// Test suite for the portfolio engine
+TEST_SUITE(PortfolioEngineTests) {
+    auto suite = std::make_unique<TestSuite>("PortfolioEngine");
+    
+    // Netted Greeks equal the quantity-weighted sum of each position's Greeks
+    suite->addTest("TotalsMatchPositionGreeks", []() {
+        const Book book(1000);
+        PortfolioEngine engine(book.positions, book.underlyings);
+        ASSERT_EQ(3u, engine.underlyings());
+        ASSERT_EQ(5u, engine.buckets());
+        
+        std::vector<PortfolioGreeks> expected(3 * engine.buckets());
+        for (size_t i = 0; i < book.positions.size(); ++i) {
+            const Position& p = book.positions[i];
+            const PricingResult r = OptionPricer::evaluate(p.params, p.is_call);
+            PortfolioGreeks& cell = expected[engine.underlying(book.underlyings[i]) * engine.buckets() +
+                                             engine.bucket(p.params.time_to_expiry)];
+            cell.value += p.quantity * r.price;
+            cell.delta += p.quantity * r.greeks.delta;
+            cell.gamma += p.quantity * r.greeks.gamma;
+            cell.vega += p.quantity * r.greeks.vega;
+            cell.theta += p.quantity * r.greeks.theta;
+            ++cell.positions;
+        }
+        
+        PortfolioGreeks total;
+        for (size_t u = 0; u < 3; ++u) {
+            PortfolioGreeks underlying;
+            for (size_t b = 0; b < engine.buckets(); ++b) {
+                const PortfolioGreeks& want = expected[u * engine.buckets() + b];
+                const PortfolioGreeks& got = engine.greeks(u, b);
+                ASSERT_EQ(want.positions, got.positions);
+                ASSERT_NEAR(want.value, got.value, 1e-8);
+                ASSERT_NEAR(want.delta, got.delta, 1e-9);
+                ASSERT_NEAR(want.gamma, got.gamma, 1e-9);
+                ASSERT_NEAR(want.vega, got.vega, 1e-8);
+                ASSERT_NEAR(want.theta, got.theta, 1e-9);
+                underlying += want;
+            }
+            ASSERT_NEAR(underlying.delta, engine.underlying_greeks(u).delta, 1e-8);
+            total += underlying;
+        }
+        ASSERT_EQ(1000u, engine.total().positions);
+        ASSERT_EQ(0u, engine.total().rejected);
+        ASSERT_NEAR(total.value, engine.total().value, 1e-7);
+        ASSERT_NEAR(total.gamma, engine.total().gamma, 1e-8);
+        
+        size_t bucketed = 0;
+        for (size_t b = 0; b < engine.buckets(); ++b) {
+            bucketed += engine.expiry_greeks(b).positions;
+        }
+        ASSERT_EQ(1000u, bucketed);
+    });
+    
+    // refresh() reprices only what changed; a quantity change only re-nets
+    suite->addTest("DirtyTracking", []() {
+        const Book book(3000);
+        PortfolioEngine engine(book.positions, book.underlyings);
+        ASSERT_FALSE(engine.dirty());
+        ASSERT_EQ(0u, engine.refresh());
+        
+        const size_t ndx = engine.underlying("NDX");
+        const size_t ndx_positions = engine.underlying_greeks(ndx).positions;
+        const PortfolioGreeks spx = engine.underlying_greeks(engine.underlying("SPX"));
+        engine.set_spot(ndx, 151.0);
+        ASSERT_TRUE(engine.dirty());
+        ASSERT_EQ(ndx_positions, engine.refresh());
+        ASSERT_TRUE(same(spx, engine.underlying_greeks(engine.underlying("SPX"))));
+        
+        engine.set_spot(ndx, 151.0);
+        ASSERT_FALSE(engine.dirty());
+        
+        engine.set_volatility(4, 0.35);
+        engine.set_volatility(5, 0.35);
+        ASSERT_EQ(2u, engine.refresh());
+        
+        const double before = engine.total().delta;
+        engine.set_quantity(0, book.positions[0].quantity + 100.0);
+        ASSERT_TRUE(engine.dirty());
+        ASSERT_EQ(0u, engine.refresh());
+        const PricingResult r = OptionPricer::evaluate(book.positions[0].params, book.positions[0].is_call);
+        ASSERT_NEAR(before + 100.0 * r.greeks.delta, engine.total().delta, 1e-8);
+        
+        // Moving a position across an expiry bucket
+        Parameters moved = book.positions[1].params;
+        moved.time_to_expiry = 0.1;
+        engine.set_parameters(1, moved);
+        ASSERT_EQ(1u, engine.refresh());
+        size_t front = 0;
+        for (size_t i = 0; i < book.positions.size(); ++i) {
+            const double T = i == 1 ? 0.1 : book.positions[i].params.time_to_expiry;
+            front += engine.bucket(T) == 0 ? 1 : 0;
+        }
+        ASSERT_EQ(front, engine.expiry_greeks(0).positions);
+    });
+    
+    // Incremental refreshes net to exactly the totals of a newly built engine
+    suite->addTest("IncrementalMatchesFull", []() {
+        Book book(5000);
+        PortfolioEngine engine(book.positions, book.underlyings);
+        engine.set_spot(engine.underlying("RUT"), 79.5);
+        engine.set_volatility(17, 0.42);
+        engine.set_quantity(4321, -3.0);
+        engine.refresh();
+        
+        for (size_t i = 0; i < book.positions.size(); ++i) {
+            if (book.underlyings[i] == "RUT") {
+                book.positions[i].params.spot_price = 79.5;
+            }
+        }
+        book.positions[17].params.volatility = 0.42;
+        book.positions[4321].quantity = -3.0;
+        const PortfolioEngine full(book.positions, book.underlyings);
+        
+        ASSERT_TRUE(same(full.total(), engine.total()));
+        for (size_t u = 0; u < engine.underlyings(); ++u) {
+            ASSERT_TRUE(same(full.underlying_greeks(u), engine.underlying_greeks(u)));
+        }
+        for (size_t b = 0; b < engine.buckets(); ++b) {
+            ASSERT_TRUE(same(full.expiry_greeks(b), engine.expiry_greeks(b)));
+        }
+    });
+    
+    // The netting tree does not depend on how many threads refresh it
+    suite->addTest("DeterministicAcrossThreads", []() {
+        const Book book(20000);
+        Utils::ThreadPool one(0);
+        Utils::ThreadPool many(7);
+        PortfolioOptions serial;
+        serial.max_threads = 1;
+        const PortfolioEngine reference(book.positions, book.underlyings, serial, &one);
+        for (int run = 0; run < 3; ++run) {
+            const PortfolioEngine parallel(book.positions, book.underlyings, PortfolioOptions(), &many);
+            ASSERT_TRUE(same(reference.total(), parallel.total()));
+            for (size_t b = 0; b < reference.buckets(); ++b) {
+                ASSERT_TRUE(same(reference.expiry_greeks(b), parallel.expiry_greeks(b)));
+            }
+        }
+    });
+    
+    // Mismatched inputs, bad buckets and out-of-range updates throw
+    suite->addTest("InvalidInputs", []() {
+        const Book book(10);
+        std::vector<std::string> short_names(book.underlyings.begin(), book.underlyings.end() - 1);
+        ASSERT_THROWS(PortfolioEngine(book.positions, short_names), std::invalid_argument);
+        PortfolioOptions unsorted;
+        unsorted.expiry_buckets = {1.0, 0.5};
+        ASSERT_THROWS(PortfolioEngine(book.positions, book.underlyings, unsorted), std::invalid_argument);
+        
+        PortfolioEngine engine(book.positions, book.underlyings);
+        ASSERT_THROWS(engine.underlying("VIX"), std::invalid_argument);
+        ASSERT_THROWS(engine.set_spot(3, 100.0), std::invalid_argument);
+        ASSERT_THROWS(engine.set_spot(0, -1.0), std::invalid_argument);
+        ASSERT_THROWS(engine.set_volatility(10, 0.2), std::invalid_argument);
+        ASSERT_THROWS(engine.set_volatility(0, std::nan("")), std::invalid_argument);
+        ASSERT_THROWS(engine.set_quantity(0, INFINITY), std::invalid_argument);
+        ASSERT_FALSE(engine.dirty());
+        
+        const PortfolioEngine empty({}, {});
+        ASSERT_EQ(0u, empty.total().positions);
+        ASSERT_EQ(0u, empty.underlyings());
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}
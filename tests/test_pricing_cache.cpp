@@ -0,0 +1,134 @@
+#include "test_framework.hpp"
+#include "../src/models/pricing_cache.hpp"
+#include "../src/models/black_scholes.hpp"
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace BlackScholes;
+using namespace Testing;
+
+/**
+ * @file test_pricing_cache.cpp
+ * @brief Unit tests for the pricing result cache
+ *
+ * Test Coverage:
+ * - Quantized keys: inputs within the tolerance share an entry
+ * - Bounded CLOCK eviction and a disabled (capacity 0) cache
+ * - Concurrent lookups from several threads
+ */
+
+// Test suite for the memoizing pricer
+TEST_SUITE(PricingCacheTests) {
+    auto suite = std::make_unique<TestSuite>("PricingCache");
+    
+    // Inputs within the tolerance share an entry; hits return the stored result exactly
+    suite->addTest("QuantizedKeyHits", []() {
+        PricingCacheOptions options;
+        options.capacity = 1024;
+        options.tolerance = 1e-9;
+        PricingCache cache(options);
+        
+        const QuoteResult first = cache.quote(100.0, 105.0, 0.5, 0.03, 0.25, 0.01, true);
+        const QuoteResult again = cache.quote(100.0 + 1e-12, 105.0, 0.5, 0.03, 0.25, 0.01, true);
+        ASSERT_EQ(BatchStatus::OK, first.status);
+        ASSERT_EQ(first.price, again.price);
+        ASSERT_EQ(first.greeks.vega, again.greeks.vega);
+        
+        const QuoteResult exact = OptionPricer::quote(100.0, 105.0, 0.5, 0.03, 0.25, 0.01, true);
+        ASSERT_NEAR(exact.price, first.price, 1e-7);
+        ASSERT_NEAR(exact.greeks.delta, first.greeks.delta, 1e-7);
+        
+        // Put, other outputs and a point outside the tolerance are separate keys
+        const QuoteResult put = cache.quote(100.0, 105.0, 0.5, 0.03, 0.25, 0.01, false);
+        ASSERT_LT(put.greeks.delta, 0.0);
+        const QuoteResult price_only = cache.quote(100.0, 105.0, 0.5, 0.03, 0.25, 0.01, true, OutputFlags::PRICE);
+        ASSERT_TRUE(std::isnan(price_only.greeks.delta));
+        cache.quote(100.001, 105.0, 0.5, 0.03, 0.25, 0.01, true);
+        
+        const PricingCacheStats stats = cache.stats();
+        ASSERT_EQ(uint64_t(1), stats.hits);
+        ASSERT_EQ(uint64_t(4), stats.misses);
+        ASSERT_EQ(size_t(4), stats.size);
+        ASSERT_EQ(0.0, cache.quantize(0.0));
+        ASSERT_NEAR(1.0, cache.quantize(1.0 + 1e-12), 0.0);
+        
+        // Invalid inputs are cached with their status, not thrown
+        ASSERT_EQ(BatchStatus::INVALID_SPOT, cache.quote(-1.0, 100.0, 1.0, 0.05, 0.2, 0.0, true).status);
+        ASSERT_EQ(BatchStatus::INVALID_SPOT, cache.quote(-1.0, 100.0, 1.0, 0.05, 0.2, 0.0, true).status);
+        ASSERT_EQ(uint64_t(2), cache.stats().hits);
+    });
+    
+    // Size stays within capacity and referenced entries survive eviction
+    suite->addTest("BoundedClockEviction", []() {
+        PricingCacheOptions options;
+        options.capacity = 16;
+        options.tolerance = 0.0;
+        PricingCache cache(options);
+        ASSERT_EQ(size_t(16), cache.capacity());
+        
+        cache.quote(100.0, 100.0, 1.0, 0.05, 0.2, 0.0, true);
+        for (int i = 0; i < 1000; ++i) {
+            cache.quote(100.0, 200.0 + 0.1 * i, 1.0, 0.05, 0.2, 0.0, true);
+            cache.quote(100.0, 100.0, 1.0, 0.05, 0.2, 0.0, true);
+        }
+        PricingCacheStats stats = cache.stats();
+        ASSERT_EQ(uint64_t(1000), stats.hits);
+        ASSERT_EQ(uint64_t(1001), stats.misses);
+        ASSERT_LE(stats.size, cache.capacity());
+        ASSERT_EQ(stats.misses - stats.size, stats.evictions);
+        
+        cache.clear();
+        cache.reset_stats();
+        stats = cache.stats();
+        ASSERT_EQ(size_t(0), stats.size);
+        ASSERT_EQ(uint64_t(0), stats.hits + stats.misses + stats.evictions);
+        
+        // Capacity 0 prices every lookup
+        options.capacity = 0;
+        PricingCache disabled(options);
+        ASSERT_EQ(size_t(0), disabled.capacity());
+        ASSERT_EQ(BatchStatus::OK, disabled.quote(100.0, 100.0, 1.0, 0.05, 0.2, 0.0, true).status);
+        ASSERT_EQ(BatchStatus::OK, disabled.quote(100.0, 100.0, 1.0, 0.05, 0.2, 0.0, true).status);
+        ASSERT_EQ(uint64_t(2), disabled.stats().misses);
+    });
+    
+    suite->addTest("ConcurrentLookups", []() {
+        PricingCacheOptions options;
+        options.capacity = 256;
+        PricingCache cache(options);
+        
+        const int num_threads = 4;
+        const int rounds = 200;
+        const int keys = 100;
+        std::vector<int> mismatches(num_threads, 0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&cache, &mismatches, t]() {
+                for (int round = 0; round < rounds; ++round) {
+                    for (int k = 0; k < keys; ++k) {
+                        const double K = 80.0 + 0.4 * k;
+                        const QuoteResult cached = cache.quote(100.0, K, 0.75, 0.04, 0.3, 0.0, k % 2 == 0);
+                        const QuoteResult direct = OptionPricer::quote(cache.quantize(100.0), cache.quantize(K),
+                                                                       cache.quantize(0.75), cache.quantize(0.04),
+                                                                       cache.quantize(0.3), 0.0, k % 2 == 0);
+                        mismatches[t] += cached.price == direct.price ? 0 : 1;
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        
+        for (int count : mismatches) {
+            ASSERT_EQ(0, count);
+        }
+        const PricingCacheStats stats = cache.stats();
+        ASSERT_EQ(uint64_t(num_threads * rounds * keys), stats.hits + stats.misses);
+        ASSERT_GE(stats.hit_rate(), 0.9);
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}
@@ -0,0 +1,184 @@
+#include "test_framework.hpp"
+#include "../src/models/black_scholes.hpp"
+#include "../src/models/pricing_engine.hpp"
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace BlackScholes;
+using namespace Testing;
+
+/**
+ * @file test_pricing_engine.cpp
+ * @brief Unit tests for the statically dispatched pricing engines
+ *
+ * Test Coverage:
+ * - Crank-Nicolson European prices and Greeks against the closed form
+ * - American puts and calls on dividend payers against binomial references
+ * - Early-exercise bounds
+ * - Batch pricing of a chain on shared grids, invalid rows
+ * - Unsupported exercise styles and engine selection through with_engine()
+ */
+
+namespace {
+
+FiniteDifferenceOptions test_grid() {
+    FiniteDifferenceOptions options;
+    options.space_steps = 400;
+    options.time_steps = 200;
+    options.std_devs = 5.0;
+    return options;
+}
+
+} // namespace
+
+// Test suite for CrankNicolsonEngine
+TEST_SUITE(FiniteDifferenceTests) {
+    auto suite = std::make_unique<TestSuite>("FiniteDifference");
+    
+    suite->addTest("EuropeanMatchesClosedForm", []() {
+        const CrankNicolsonEngine pde(test_grid());
+        const ClosedFormEngine exact;
+        for (const bool is_call : {true, false}) {
+            for (const double K : {80.0, 100.0, 120.0}) {
+                const QuoteResult numeric = pde.quote(100.0, K, 1.0, 0.05, 0.25, 0.02, is_call);
+                const QuoteResult formula = exact.quote(100.0, K, 1.0, 0.05, 0.25, 0.02, is_call);
+                ASSERT_EQ(BatchStatus::OK, numeric.status);
+                ASSERT_NEAR(formula.price, numeric.price, 5e-3);
+                ASSERT_NEAR(formula.greeks.delta, numeric.greeks.delta, 1e-3);
+                ASSERT_NEAR(formula.greeks.gamma, numeric.greeks.gamma, 1e-4);
+                ASSERT_NEAR(formula.greeks.theta, numeric.greeks.theta, 1e-4);
+                ASSERT_NEAR(formula.greeks.vega, numeric.greeks.vega, 1e-3);
+                ASSERT_NEAR(formula.greeks.rho, numeric.greeks.rho, 1e-3);
+            }
+        }
+    });
+    
+    // References: 8000-step Cox-Ross-Rubinstein trees
+    suite->addTest("AmericanMatchesBinomial", []() {
+        const CrankNicolsonEngine pde(test_grid());
+        ASSERT_NEAR(8.8825, pde.quote(100.0, 100.0, 1.0, 0.05, 0.25, 0.03, false, ExerciseStyle::AMERICAN).price, 1e-2);
+        ASSERT_NEAR(13.5221, pde.quote(90.0, 100.0, 0.5, 0.05, 0.3, 0.04, false, ExerciseStyle::AMERICAN).price, 1e-2);
+        ASSERT_NEAR(12.0093, pde.quote(100.0, 90.0, 1.0, 0.03, 0.2, 0.06, true, ExerciseStyle::AMERICAN).price, 1e-2);
+    });
+    
+    suite->addTest("EarlyExerciseBounds", []() {
+        const CrankNicolsonEngine pde(test_grid());
+        for (const double S : {60.0, 80.0, 100.0, 120.0}) {
+            const double american = pde.quote(S, 100.0, 2.0, 0.06, 0.3, 0.01, false, ExerciseStyle::AMERICAN).price;
+            const double european = pde.quote(S, 100.0, 2.0, 0.06, 0.3, 0.01, false).price;
+            ASSERT_GE(american, european);
+            ASSERT_GE(american, 100.0 - S - 1e-12);
+        }
+        
+        // Without dividends an American call is never exercised early
+        const double call = pde.quote(100.0, 100.0, 1.0, 0.05, 0.2, 0.0, true, ExerciseStyle::AMERICAN).price;
+        ASSERT_NEAR(pde.quote(100.0, 100.0, 1.0, 0.05, 0.2, 0.0, true).price, call, 1e-9);
+        
+        // Deep in the money the put is worth its intrinsic value
+        ASSERT_NEAR(60.0, pde.quote(40.0, 100.0, 1.0, 0.05, 0.2, 0.0, false, ExerciseStyle::AMERICAN).price, 1e-6);
+    });
+    
+    suite->addTest("BatchChain", []() {
+        const CrankNicolsonEngine pde(test_grid());
+        const ClosedFormEngine exact;
+        const size_t n = 41;
+        std::vector<double> spot(n, 100.0), strike(n), expiry(n, 0.75), rate(n, 0.04), vol(n, 0.3), div(n, 0.02);
+        std::vector<uint8_t> is_call(n, 0);
+        for (size_t i = 0; i < n; ++i) {
+            strike[i] = 70.0 + 1.5 * static_cast<double>(i);
+        }
+        strike[5] = -1.0;
+        is_call[30] = 1;
+        vol[35] = 0.35;
+        
+        const BatchInput input{spot.data(), strike.data(), expiry.data(), rate.data(),
+                               vol.data(), div.data(), is_call.data(), n};
+        std::vector<double> european(n), american(n), delta(n);
+        std::vector<uint32_t> status(n);
+        BatchOutput output;
+        output.price = european.data();
+        output.status = status.data();
+        ASSERT_EQ(n - 1, pde.price_batch(input, output));
+        output.price = american.data();
+        output.delta = delta.data();
+        ASSERT_EQ(n - 1, pde.price_batch(input, output, ExerciseStyle::AMERICAN));
+        
+        for (size_t i = 0; i < n; ++i) {
+            if (i == 5) {
+                ASSERT_EQ(BatchStatus::INVALID_STRIKE, status[i]);
+                ASSERT_TRUE(std::isnan(american[i]));
+                continue;
+            }
+            ASSERT_EQ(BatchStatus::OK, status[i]);
+            const QuoteResult formula = exact.quote(spot[i], strike[i], expiry[i], rate[i], vol[i], div[i], is_call[i] != 0);
+            ASSERT_NEAR(formula.price, european[i], 1e-2);
+            ASSERT_GE(american[i], european[i] - 1e-9);
+            const QuoteResult single = pde.quote(spot[i], strike[i], expiry[i], rate[i], vol[i], div[i],
+                                                 is_call[i] != 0, ExerciseStyle::AMERICAN);
+            ASSERT_NEAR(single.price, american[i], 1e-2);
+            ASSERT_NEAR(single.greeks.delta, delta[i], 1e-2);
+        }
+    });
+    
+    suite->addTest("InvalidGrid", []() {
+        FiniteDifferenceOptions options = test_grid();
+        options.space_steps = 2;
+        ASSERT_THROWS(CrankNicolsonEngine engine(options), std::invalid_argument);
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}
+
+// Test suite for the shared engine interface
+TEST_SUITE(PricingEngineTests) {
+    auto suite = std::make_unique<TestSuite>("PricingEngine");
+    
+    suite->addTest("UnsupportedExercise", []() {
+        const ClosedFormEngine exact;
+        const QuoteResult quoted = exact.quote(100.0, 100.0, 1.0, 0.05, 0.2, 0.03, false, ExerciseStyle::AMERICAN);
+        ASSERT_EQ(BatchStatus::UNSUPPORTED_EXERCISE, quoted.status);
+        ASSERT_TRUE(std::isnan(quoted.price));
+        
+        const PricingResult result = exact.price(Parameters(100.0, 100.0, 1.0, 0.05, 0.2, 0.03), false,
+                                                 ExerciseStyle::AMERICAN);
+        ASSERT_FALSE(result.is_valid);
+        ASSERT_FALSE(result.error_msg.empty());
+        ASSERT_TRUE(preferred_method(ExerciseStyle::AMERICAN) == PricingMethod::FINITE_DIFFERENCE);
+        ASSERT_TRUE(preferred_method(ExerciseStyle::EUROPEAN) == PricingMethod::CLOSED_FORM);
+    });
+    
+    suite->addTest("ClosedFormMatchesPricer", []() {
+        const ClosedFormEngine exact;
+        const Parameters params(100.0, 95.0, 0.5, 0.03, 0.22, 0.01);
+        const PricingResult engine_result = exact.price(params, true);
+        const PricingResult pricer_result = OptionPricer::evaluate(params, true);
+        ASSERT_TRUE(engine_result.is_valid);
+        ASSERT_NEAR(pricer_result.price, engine_result.price, 1e-12);
+        ASSERT_NEAR(pricer_result.greeks.delta, engine_result.greeks.delta, 1e-12);
+    });
+    
+    suite->addTest("WithEngine", []() {
+        MonteCarloOptions simulation;
+        simulation.simulations = 200000;
+        simulation.seed = 7;
+        const double expected = ClosedFormEngine().quote(100.0, 100.0, 1.0, 0.05, 0.2, 0.0, true).price;
+        
+        for (const PricingMethod method : {PricingMethod::CLOSED_FORM, PricingMethod::MONTE_CARLO,
+                                           PricingMethod::FINITE_DIFFERENCE}) {
+            const double price = with_engine(method, [](const auto& engine) {
+                return engine.quote(100.0, 100.0, 1.0, 0.05, 0.2, 0.0, true).price;
+            });
+            ASSERT_NEAR(expected, price, 0.05);
+        }
+        
+        const MonteCarloVanillaEngine simulated(simulation);
+        const QuoteResult quoted = simulated.quote(100.0, 100.0, 1.0, 0.05, 0.2, 0.0, true);
+        ASSERT_EQ(BatchStatus::OK, quoted.status);
+        ASSERT_NEAR(expected, quoted.price, 0.05);
+        ASSERT_TRUE(std::isnan(quoted.greeks.delta));
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}
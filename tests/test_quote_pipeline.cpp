@@ -0,0 +1,268 @@
+#include "test_framework.hpp"
+#include "../src/models/quote_pipeline.hpp"
+#include "../src/models/black_scholes.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace BlackScholes;
+using namespace Testing;
+
+/**
+ * @file test_quote_pipeline.cpp
+ * @brief Unit tests for the streaming quote pipeline
+ *
+ * Test Coverage:
+ * - CSV and binary record parsing, including rejected and partial lines
+ * - Streaming a CSV file and a binary pipe into the batch pricer
+ * - Sink exceptions stopping the pipeline (socket source)
+ */
+
+namespace {
+
+const char* const PIPELINE_CSV = "test_quote_pipeline.csv";
+
+// Deterministic chain: 40 strikes per expiry, every 97th row with a negative volatility
+QuoteRecord pipeline_quote(size_t i) {
+    QuoteRecord record{};
+    record.spot_price = 100.0;
+    record.strike_price = 80.0 + static_cast<double>(i % 40);
+    record.time_to_expiry = 0.25 * static_cast<double>(1 + (i / 40) % 8);
+    record.risk_free_rate = 0.03;
+    record.volatility = i % 97 == 0 ? -0.2 : 0.15 + 0.001 * static_cast<double>(i % 50);
+    record.dividend_yield = 0.01;
+    record.is_call = i % 3 != 0 ? 1u : 0u;
+    return record;
+}
+
+// Collects every priced row by stream index
+struct PipelineCollector {
+    std::vector<double> price;
+    std::vector<uint32_t> status;
+    std::vector<uint64_t> sequences;
+    
+    explicit PipelineCollector(size_t rows)
+        : price(rows, std::numeric_limits<double>::quiet_NaN()), status(rows, 0xffffffffu) {}
+    
+    void operator()(const QuoteBatch& batch) {
+        sequences.push_back(batch.sequence);
+        for (size_t j = 0; j < batch.count; ++j) {
+            price[batch.first_row + j] = batch.price[j];
+            status[batch.first_row + j] = batch.status[j];
+        }
+    }
+    
+    void check(size_t rows) const {
+        for (size_t i = 0; i < rows; ++i) {
+            const QuoteRecord q = pipeline_quote(i);
+            const QuoteResult expected = OptionPricer::quote(q.spot_price, q.strike_price, q.time_to_expiry,
+                                                             q.risk_free_rate, q.volatility, q.dividend_yield,
+                                                             q.is_call != 0, OutputFlags::PRICE);
+            ASSERT_EQ(expected.status, status[i]);
+            if (expected.status == BatchStatus::OK) {
+                ASSERT_NEAR(expected.price, price[i], 1e-9);
+            }
+        }
+    }
+};
+
+} // namespace
+
+TEST_SUITE(QuotePipelineTests) {
+    auto suite = std::make_unique<TestSuite>("QuotePipeline");
+    
+    // Headers, comments, blank lines, optional dividend, '+' signs and partial lines
+    suite->addTest("ParseCsvRecords", []() {
+        QuoteBatch batch(8, OutputFlags::PRICE);
+        QuoteParser parser(QuoteFormat::CSV);
+        const std::string text =
+            "spot,strike,expiry,rate,volatility,dividend,type\r\n"
+            "# comment\n"
+            "\n"
+            "100,105,0.5,0.05,0.2,0.01,C\n"
+            " 100 , 95 , 1 , +0.05 , 0.25 , , put\r\n"
+            "100,abc,1,0.05,0.2,0,C\n"
+            "100,95,1,0.05\n"
+            "50,55,2,0.01,0.3,0,x\n"
+            "99,100,1,0.05,0.2,0,1";
+        
+        const size_t used = parser.parse(text.data(), text.size(), batch);
+        ASSERT_EQ(text.rfind('\n') + 1, used);
+        parser.finish(text.data() + used, text.size() - used, batch);
+        
+        ASSERT_EQ(size_t(3), batch.count);
+        ASSERT_EQ(uint64_t(3), batch.rejected);
+        ASSERT_NEAR(105.0, batch.strike_price[0], 0.0);
+        ASSERT_NEAR(0.01, batch.dividend_yield[0], 0.0);
+        ASSERT_EQ(1, batch.is_call[0]);
+        ASSERT_NEAR(95.0, batch.strike_price[1], 0.0);
+        ASSERT_NEAR(0.05, batch.risk_free_rate[1], 0.0);
+        ASSERT_NEAR(0.0, batch.dividend_yield[1], 0.0);
+        ASSERT_EQ(0, batch.is_call[1]);
+        ASSERT_NEAR(99.0, batch.spot_price[2], 0.0);
+        ASSERT_EQ(1, batch.is_call[2]);
+        
+        // A header is only skipped on the first line
+        QuoteBatch later(4, OutputFlags::PRICE);
+        QuoteParser second(QuoteFormat::CSV);
+        const std::string rows = "100,105,0.5,0.05,0.2,0,C\nspot,strike\n";
+        second.parse(rows.data(), rows.size(), later);
+        ASSERT_EQ(size_t(1), later.count);
+        ASSERT_EQ(uint64_t(1), later.rejected);
+    });
+    
+    suite->addTest("ParseBinaryRecords", []() {
+        std::vector<QuoteRecord> records;
+        for (size_t i = 0; i < 5; ++i) {
+            records.push_back(pipeline_quote(i));
+        }
+        const char* bytes = reinterpret_cast<const char*>(records.data());
+        const size_t size = records.size() * sizeof(QuoteRecord);
+        
+        // Stops when the batch is full and leaves partial records alone
+        QuoteBatch batch(3, OutputFlags::PRICE);
+        QuoteParser parser(QuoteFormat::BINARY);
+        ASSERT_EQ(3 * sizeof(QuoteRecord), parser.parse(bytes, size - 1, batch));
+        ASSERT_TRUE(batch.full());
+        batch.clear();
+        ASSERT_EQ(sizeof(QuoteRecord), parser.parse(bytes + 3 * sizeof(QuoteRecord), 2 * sizeof(QuoteRecord) - 1, batch));
+        parser.finish(bytes + 4 * sizeof(QuoteRecord), sizeof(QuoteRecord) - 1, batch);
+        ASSERT_EQ(size_t(1), batch.count);
+        ASSERT_EQ(uint64_t(1), batch.rejected);
+        ASSERT_NEAR(records[3].strike_price, batch.strike_price[0], 0.0);
+        ASSERT_EQ(records[3].is_call != 0 ? 1 : 0, batch.is_call[0]);
+    });
+    
+    // Many small batches through several workers; every row arrives once and is priced like quote()
+    suite->addTest("StreamCsvFile", []() {
+        const size_t rows = 5000;
+        {
+            std::ofstream file(PIPELINE_CSV);
+            file.precision(17);
+            file << "spot,strike,expiry,rate,volatility,dividend,type\n";
+            for (size_t i = 0; i < rows; ++i) {
+                const QuoteRecord q = pipeline_quote(i);
+                file << q.spot_price << ',' << q.strike_price << ',' << q.time_to_expiry << ','
+                     << q.risk_free_rate << ',' << q.volatility << ',' << q.dividend_yield << ','
+                     << (q.is_call != 0 ? 'C' : 'P') << '\n';
+                if (i == 1234) {
+                    file << "not,a,quote\n";
+                }
+            }
+        }
+        
+        QuotePipelineOptions options;
+        options.batch_size = 128;
+        options.queue_depth = 2;
+        options.workers = 3;
+        options.outputs = OutputFlags::PRICE;
+        QuotePipeline pipeline(options);
+        PipelineCollector collector(rows);
+        
+        QuoteSource source = QuoteSource::open_file(PIPELINE_CSV);
+        const PipelineStats stats = pipeline.run(source, [&](const QuoteBatch& batch) { collector(batch); });
+        std::remove(PIPELINE_CSV);
+        
+        collector.check(rows);
+        const size_t batches = (rows + options.batch_size - 1) / options.batch_size;
+        ASSERT_EQ(batches, collector.sequences.size());
+        ASSERT_EQ(uint64_t(rows), stats.parse.rows);
+        ASSERT_EQ(uint64_t(rows), stats.price.rows);
+        ASSERT_EQ(uint64_t(rows), stats.sink.rows);
+        ASSERT_EQ(uint64_t(batches), stats.price.batches);
+        ASSERT_EQ(uint64_t(1), stats.rejected_rows);
+        ASSERT_EQ(uint64_t((rows + 96) / 97), stats.invalid_rows);
+        ASSERT_EQ(size_t(0), stats.parsed_depth);
+        ASSERT_EQ(size_t(0), stats.priced_depth);
+        ASSERT_LE(stats.parsed_high_water, size_t(2));
+        ASSERT_GT(stats.elapsed_seconds, 0.0);
+        
+        // A missing file is reported up front
+        ASSERT_THROWS(QuoteSource::open_file(PIPELINE_CSV), std::runtime_error);
+    });
+    
+    // Binary records through a pipe, written in pieces that split records
+    suite->addTest("StreamBinaryPipe", []() {
+        const size_t rows = 3000;
+        std::vector<QuoteRecord> records;
+        for (size_t i = 0; i < rows; ++i) {
+            records.push_back(pipeline_quote(i));
+        }
+        
+        int fds[2];
+        ASSERT_EQ(0, ::pipe(fds));
+        std::thread writer([&]() {
+            const char* bytes = reinterpret_cast<const char*>(records.data());
+            size_t left = records.size() * sizeof(QuoteRecord);
+            while (left > 0) {
+                const size_t piece = std::min<size_t>(left, 1000);
+                const ssize_t written = ::write(fds[1], bytes, piece);
+                if (written <= 0) {
+                    break;
+                }
+                bytes += written;
+                left -= static_cast<size_t>(written);
+            }
+            ::close(fds[1]);
+        });
+        
+        QuotePipelineOptions options;
+        options.format = QuoteFormat::BINARY;
+        options.batch_size = 500;
+        options.workers = 2;
+        QuotePipeline pipeline(options);
+        PipelineCollector collector(rows);
+        QuoteSource source(fds[0], true);
+        const PipelineStats stats = pipeline.run(source, [&](const QuoteBatch& batch) {
+            ASSERT_FALSE(batch.delta.empty());      // Every output requested
+            collector(batch);
+        });
+        writer.join();
+        
+        collector.check(rows);
+        ASSERT_EQ(uint64_t(rows), stats.sink.rows);
+        ASSERT_EQ(uint64_t(0), stats.rejected_rows);
+        ASSERT_EQ(uint64_t(0), stats.warning_rows);
+    });
+    
+    // A throwing sink stops the pipeline and its exception reaches the caller (socket source)
+    suite->addTest("SinkErrorStopsPipeline", []() {
+        int fds[2];
+        ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+        std::thread writer([&]() {
+            std::vector<QuoteRecord> records(64, pipeline_quote(1));
+            for (int i = 0; i < 200; ++i) {
+                if (::send(fds[1], records.data(), records.size() * sizeof(QuoteRecord), MSG_NOSIGNAL) <= 0) {
+                    break;      // Reader closed the stream
+                }
+            }
+            ::close(fds[1]);
+        });
+        
+        QuotePipelineOptions options;
+        options.format = QuoteFormat::BINARY;
+        options.batch_size = 64;
+        options.queue_depth = 1;
+        QuotePipeline pipeline(options);
+        QuoteSource source(fds[0], true);
+        size_t delivered = 0;
+        ASSERT_THROWS(pipeline.run(source, [&](const QuoteBatch&) {
+            if (++delivered == 3) {
+                throw std::runtime_error("sink failed");
+            }
+        }), std::runtime_error);
+        ASSERT_EQ(size_t(3), delivered);
+        
+        source = QuoteSource();     // Closing the read end unblocks the writer
+        writer.join();
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}
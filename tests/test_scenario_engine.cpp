@@ -0,0 +1,214 @@
+#include "test_framework.hpp"
+#include "../src/models/scenario_engine.hpp"
+#include "../src/models/black_scholes.hpp"
+#include "../src/utils/thread_pool.hpp"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace BlackScholes;
+using namespace Testing;
+
+/**
+ * @file test_scenario_engine.cpp
+ * @brief Unit tests for the bump-and-reprice scenario engine
+ *
+ * Test Coverage:
+ * - P&L matrix against full reprices, ladders and input validation
+ * - Historical and parametric VaR and the stress report
+ * - Parallel runs matching a serial run
+ * - Adjoint sensitivities against analytic Greeks and central differences
+ */
+
+// Scenario engine tests
+TEST_SUITE(ScenarioEngineTests) {
+    auto suite = std::make_unique<TestSuite>("ScenarioEngine");
+    
+    // Every matrix cell equals quantity times the change in a full reprice
+    suite->addTest("RepriceMatchesQuotes", []() {
+        std::vector<Position> book;
+        for (size_t i = 0; i < 150; ++i) {
+            const Parameters params(100.0, 70.0 + 0.4 * static_cast<double>(i), 0.1 + 0.01 * static_cast<double>(i % 50),
+                                    0.03, 0.15 + 0.002 * static_cast<double>(i % 40), i % 3 == 0 ? 0.02 : 0.0);
+            book.emplace_back(params, i % 2 == 0, i % 5 == 0 ? -2.0 : 1.5);
+        }
+        ScenarioOptions options;
+        const ScenarioEngine engine(book, options);
+        const std::vector<Scenario> scenarios = ScenarioEngine::grid({-0.1, 0.0, 0.05}, {-0.03, 0.0, 0.04},
+                                                                     {-0.01, 0.0, 0.0025});
+        ASSERT_EQ(size_t(27), scenarios.size());
+        const std::vector<double> pnl = engine.run(scenarios);
+        ASSERT_EQ(scenarios.size() * book.size(), pnl.size());
+        
+        for (size_t s = 0; s < scenarios.size(); ++s) {
+            const Scenario& scenario = scenarios[s];
+            const bool zero = scenario.spot_shift == 0.0 && scenario.vol_shift == 0.0 && scenario.rate_shift == 0.0;
+            for (size_t p = 0; p < book.size(); ++p) {
+                const Parameters& base = book[p].params;
+                if (zero) {
+                    ASSERT_EQ(0.0, pnl[s * book.size() + p]);
+                    continue;
+                }
+                const PricingResult before = OptionPricer::evaluate(base, book[p].is_call, OutputFlags::PRICE);
+                const QuoteResult after = OptionPricer::quote(
+                    base.spot_price * (1.0 + scenario.spot_shift), base.strike_price, base.time_to_expiry,
+                    base.risk_free_rate + scenario.rate_shift, base.volatility + scenario.vol_shift,
+                    base.dividend_yield, book[p].is_call, OutputFlags::PRICE);
+                ASSERT_EQ(BatchStatus::OK, after.status);
+                ASSERT_NEAR(book[p].quantity * (after.price - before.price), pnl[s * book.size() + p], 1e-9);
+            }
+        }
+        
+        // The ladder sums each scenario row and matches the base valuation
+        std::vector<double> totals(scenarios.size());
+        engine.ladder(pnl.data(), scenarios.size(), totals.data());
+        double expected = 0.0;
+        for (size_t p = 0; p < book.size(); ++p) {
+            expected += pnl[p];
+        }
+        ASSERT_NEAR(expected, totals[0], 1e-12);
+        double base_value = 0.0;
+        for (const Position& position : book) {
+            base_value += position.quantity * OptionPricer::evaluate(position.params, position.is_call).price;
+        }
+        ASSERT_NEAR(base_value, engine.base_value(), 1e-9);
+        
+        Scenario crash;
+        crash.spot_shift = -1.0;
+        ASSERT_THROWS(engine.run({crash}), std::invalid_argument);
+        crash.spot_shift = std::numeric_limits<double>::quiet_NaN();
+        ASSERT_THROWS(engine.run({crash}), std::invalid_argument);
+    });
+    
+    // Historical VaR is read from the tail; parametric VaR scales with the Greeks
+    suite->addTest("ValueAtRisk", []() {
+        std::vector<double> totals(100);
+        for (size_t i = 0; i < totals.size(); ++i) {
+            totals[(i * 37) % totals.size()] = static_cast<double>(i) - 50.0;
+        }
+        ASSERT_NEAR(45.0, ScenarioEngine::historical_var(totals.data(), totals.size(), 0.95), 1e-12);
+        ASSERT_NEAR(49.0, ScenarioEngine::historical_var(totals.data(), totals.size(), 0.99), 1e-12);
+        ASSERT_THROWS(ScenarioEngine::historical_var(totals.data(), 0, 0.95), std::invalid_argument);
+        ASSERT_THROWS(ScenarioEngine::historical_var(totals.data(), totals.size(), 1.0), std::invalid_argument);
+        
+        const Parameters params(100.0, 100.0, 0.5, 0.03, 0.2);
+        ScenarioOptions options;
+        const ScenarioEngine engine({Position(params, true, 10.0)}, options);
+        const PricingResult greeks = OptionPricer::evaluate(params, true);
+        ASSERT_NEAR(10.0 * greeks.greeks.delta * 100.0, engine.dollar_delta(), 1e-9);
+        ASSERT_NEAR(10.0 * greeks.greeks.vega * 100.0, engine.vega(), 1e-9);
+        
+        const double z95 = MathUtils::normal_inv_cdf(0.95);
+        ASSERT_NEAR(z95 * engine.dollar_delta() * 0.02, engine.parametric_var(0.02, 0.0, 0.95), 1e-9);
+        const double both = engine.parametric_var(0.02, 0.01, 0.95);
+        ASSERT_NEAR(z95 * std::hypot(engine.dollar_delta() * 0.02, engine.vega() * 0.01), both, 1e-9);
+        ASSERT_GT(engine.parametric_var(0.02, 0.01, 0.99), both);
+        
+        // A small daily move: both VaR estimates agree to first order
+        std::vector<Scenario> history;
+        for (size_t i = 0; i < 500; ++i) {
+            Scenario day;
+            day.spot_shift = 0.01 * MathUtils::normal_inv_cdf((static_cast<double>(i) + 0.5) / 500.0);
+            history.push_back(day);
+        }
+        const RiskReport report = engine.report(history, 0.01, 0.0);
+        ASSERT_NEAR(engine.base_value(), report.base_value, 1e-12);
+        ASSERT_NEAR(report.parametric_var_95, report.var_95, 0.1 * report.parametric_var_95);
+        ASSERT_GT(report.var_99, report.var_95);
+        
+        // Long calls lose most with spot down 20% and volatility down 5 points
+        const Scenario worst = ScenarioEngine::stress_scenarios()[report.stress_scenario];
+        ASSERT_EQ(-0.20, worst.spot_shift);
+        ASSERT_EQ(-0.05, worst.vol_shift);
+        ASSERT_GT(report.stress_loss, report.var_99);
+        
+        options.enable_stress_testing = false;
+        const ScenarioEngine unstressed({Position(params, true, 10.0)}, options);
+        ASSERT_EQ(0.0, unstressed.report(history, 0.01, 0.0).stress_loss);
+    });
+    
+    // Scenarios split across threads fill the same matrix as a serial run
+    suite->addTest("ParallelMatchesSerial", []() {
+        std::vector<Position> book;
+        for (size_t i = 0; i < 300; ++i) {
+            const Parameters params(50.0 + 0.3 * static_cast<double>(i), 100.0, 0.05 + 0.003 * static_cast<double>(i),
+                                    0.02, 0.3);
+            book.emplace_back(params, i % 3 != 0, 1.0);
+        }
+        std::vector<Scenario> scenarios;
+        for (size_t i = 0; i < 97; ++i) {
+            Scenario scenario;
+            scenario.spot_shift = 0.002 * static_cast<double>(i) - 0.1;
+            scenario.vol_shift = i % 4 == 0 ? 0.01 : 0.0;
+            scenarios.push_back(scenario);
+        }
+        
+        ScenarioOptions serial_options;
+        serial_options.max_threads = 1;
+        Utils::ThreadPool pool(3);
+        const ScenarioEngine serial(book, serial_options, &pool);
+        const ScenarioEngine parallel(book, ScenarioOptions(), &pool);
+        
+        const std::vector<double> expected = serial.run(scenarios);
+        std::vector<double> pnl(scenarios.size() * book.size());
+        parallel.run(scenarios.data(), scenarios.size(), pnl.data());
+        for (size_t i = 0; i < pnl.size(); ++i) {
+            ASSERT_EQ(expected[i], pnl[i]);
+        }
+    });
+    
+    // One backward sweep gives the aggregate figures and every position's analytic Greeks
+    suite->addTest("AdjointGreeks", []() {
+        std::vector<Position> book;
+        for (size_t i = 0; i < 60; ++i) {
+            const Parameters params(100.0, 80.0 + static_cast<double>(i), 0.2 + 0.02 * static_cast<double>(i % 10),
+                                    0.03, 0.18 + 0.003 * static_cast<double>(i % 20), i % 4 == 0 ? 0.01 : 0.0);
+            book.emplace_back(params, i % 3 != 0, i % 7 == 0 ? -3.0 : 2.0);
+        }
+        const ScenarioEngine engine(book, ScenarioOptions());
+        
+        const ScenarioGreeks base = engine.greeks();
+        ASSERT_NEAR(engine.base_value(), base.value, 1e-9);
+        ASSERT_NEAR(engine.dollar_delta(), base.spot_shift, 1e-9);
+        ASSERT_NEAR(engine.vega(), base.vol_shift, 1e-9);
+        double rate = 0.0;
+        for (size_t i = 0; i < book.size(); ++i) {
+            const Greeks expected = book[i].is_call ? OptionPricer::calculate_call_greeks(book[i].params)
+                                                    : OptionPricer::calculate_put_greeks(book[i].params);
+            ASSERT_NEAR(book[i].quantity * expected.delta, base.delta[i], 1e-10);
+            ASSERT_NEAR(book[i].quantity * expected.vega * 100.0, base.vega[i], 1e-9);
+            ASSERT_NEAR(book[i].quantity * expected.rho * 100.0, base.rho[i], 1e-9);
+            rate += base.rho[i];
+        }
+        ASSERT_NEAR(rate, base.rate_shift, 1e-9);
+        
+        // Under a shifted scenario the sensitivities match central differences of run()
+        Scenario scenario;
+        scenario.spot_shift = -0.08;
+        scenario.vol_shift = 0.03;
+        scenario.rate_shift = 0.005;
+        const ScenarioGreeks shifted = engine.greeks(scenario);
+        const auto total = [&](Scenario s) {
+            std::vector<double> totals(1);
+            engine.ladder(engine.run({s}).data(), 1, totals.data());
+            return totals[0] + engine.base_value();
+        };
+        ASSERT_NEAR(total(scenario), shifted.value, 1e-8);
+        const double h = 1e-5;
+        Scenario up = scenario, down = scenario;
+        up.spot_shift += h;
+        down.spot_shift -= h;
+        ASSERT_NEAR((total(up) - total(down)) / (2.0 * h), shifted.spot_shift, 1e-3);
+        up = down = scenario;
+        up.vol_shift += h;
+        down.vol_shift -= h;
+        ASSERT_NEAR((total(up) - total(down)) / (2.0 * h), shifted.vol_shift, 1e-3);
+        
+        Scenario crash;
+        crash.spot_shift = -1.0;
+        ASSERT_THROWS(engine.greeks(crash), std::invalid_argument);
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}
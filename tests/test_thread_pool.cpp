@@ -0,0 +1,150 @@
+#include "test_framework.hpp"
+#include "../src/utils/thread_pool.hpp"
+#include <atomic>
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace Utils;
+using namespace Testing;
+
+/**
+ * @file test_thread_pool.cpp
+ * @brief Unit tests for the worker thread pool
+ *
+ * Test Coverage:
+ * - Every task index runs exactly once
+ * - Thread limits and nested loops
+ * - Exception propagation
+ * - Range chunking and concurrent callers sharing one pool
+ * - Worker placement for each affinity policy
+ */
+
+// Test suite for ThreadPool::parallel_for()
+TEST_SUITE(ThreadPoolTests) {
+    auto suite = std::make_unique<TestSuite>("ThreadPool");
+    
+    suite->addTest("EveryTaskRunsOnce", []() {
+        ThreadPool pool(3);
+        std::vector<std::atomic<int>> hits(1000);
+        for (int round = 0; round < 20; ++round) {
+            pool.parallel_for(hits.size(), [&](size_t i) { hits[i].fetch_add(1); });
+        }
+        for (const std::atomic<int>& count : hits) {
+            ASSERT_EQ(20, count.load());
+        }
+        ASSERT_EQ(3u, pool.size());
+    });
+    
+    // A limit of one thread runs the loop on the caller; nested loops run inline
+    suite->addTest("ThreadLimitAndNesting", []() {
+        ThreadPool pool(2);
+        std::atomic<int> total{0};
+        pool.parallel_for(8, [&](size_t) {
+            pool.parallel_for(4, [&](size_t) { total.fetch_add(1); });
+        });
+        ASSERT_EQ(32, total.load());
+        
+        const std::thread::id caller = std::this_thread::get_id();
+        std::atomic<bool> off_caller{false};
+        pool.parallel_for(64, [&](size_t) {
+            if (std::this_thread::get_id() != caller) {
+                off_caller = true;
+            }
+        }, 1);
+        ASSERT_FALSE(off_caller.load());
+    });
+    
+    suite->addTest("ExceptionIsRethrown", []() {
+        ThreadPool pool(2);
+        ASSERT_THROWS(pool.parallel_for(100, [](size_t i) {
+            if (i == 37) {
+                throw std::runtime_error("task failed");
+            }
+        }), std::runtime_error);
+        
+        // The pool stays usable afterwards
+        std::atomic<int> count{0};
+        pool.parallel_for(10, [&](size_t) { count.fetch_add(1); });
+        ASSERT_EQ(10, count.load());
+    });
+    
+    // Chunks cover the range exactly once, aligned to the grain
+    suite->addTest("RangeChunksCoverOnce", []() {
+        ThreadPool pool(3);
+        const size_t count = 10007;
+        const size_t grain = 64;
+        std::vector<std::atomic<int>> hits(count);
+        std::atomic<size_t> misaligned{0};
+        pool.parallel_for_range(count, [&](size_t begin, size_t end) {
+            ASSERT_LT(begin, end);
+            if (begin % grain != 0 || ((end - begin) % grain != 0 && end != count)) {
+                misaligned.fetch_add(1);
+            }
+            for (size_t i = begin; i < end; ++i) {
+                hits[i].fetch_add(1);
+            }
+        }, grain);
+        for (const std::atomic<int>& count_i : hits) {
+            ASSERT_EQ(1, count_i.load());
+        }
+        ASSERT_EQ(size_t(0), misaligned.load());
+    });
+    
+    // Several threads run loops on one pool at the same time
+    suite->addTest("ConcurrentCallersShareWorkers", []() {
+        ThreadPool pool(2);
+        std::vector<std::atomic<long>> sums(4);
+        std::vector<std::thread> callers;
+        for (size_t c = 0; c < sums.size(); ++c) {
+            callers.emplace_back([&, c]() {
+                for (int round = 0; round < 25; ++round) {
+                    pool.parallel_for_range(1000, [&](size_t begin, size_t end) {
+                        long partial = 0;
+                        for (size_t i = begin; i < end; ++i) {
+                            partial += static_cast<long>(i);
+                        }
+                        sums[c].fetch_add(partial);
+                    }, 16);
+                }
+            });
+        }
+        for (std::thread& caller : callers) {
+            caller.join();
+        }
+        for (const std::atomic<long>& sum : sums) {
+            ASSERT_EQ(25L * 999 * 1000 / 2, sum.load());
+        }
+    });
+    
+    suite->addTest("AffinityPlacement", []() {
+        const std::vector<int> none = ThreadPool::placement(4, AffinityPolicy::NONE);
+        ASSERT_EQ(4u, none.size());
+        ASSERT_TRUE(std::all_of(none.begin(), none.end(), [](int cpu) { return cpu == -1; }));
+        
+        const size_t cpus = std::max(1u, std::thread::hardware_concurrency());
+        const size_t threads = std::max<size_t>(1, cpus / 2);
+        for (AffinityPolicy policy : {AffinityPolicy::COMPACT, AffinityPolicy::SCATTER}) {
+            std::vector<int> placed = ThreadPool::placement(threads, policy);
+            ASSERT_EQ(threads, placed.size());
+            if (placed[0] < 0) {
+                continue;   // No affinity support on this platform
+            }
+            std::sort(placed.begin(), placed.end());
+            ASSERT_TRUE(std::adjacent_find(placed.begin(), placed.end()) == placed.end() || threads > cpus - 1);
+        }
+        
+        ThreadPoolOptions options;
+        options.threads = 2;
+        options.affinity = AffinityPolicy::COMPACT;
+        ThreadPool pool(options);
+        ASSERT_EQ(2u, pool.worker_cpus().size());
+        std::atomic<int> count{0};
+        pool.parallel_for(100, [&](size_t) { count.fetch_add(1); });
+        ASSERT_EQ(100, count.load());
+        ASSERT_TRUE(std::string(to_string(AffinityPolicy::SCATTER)) == "SCATTER");
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}
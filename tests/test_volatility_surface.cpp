@@ -0,0 +1,271 @@
+#include "test_framework.hpp"
+#include "../src/models/volatility_surface.hpp"
+#include "../src/models/black_scholes.hpp"
+#include "../src/models/implied_volatility.hpp"
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace BlackScholes;
+using namespace Testing;
+
+/**
+ * @file test_volatility_surface.cpp
+ * @brief Unit tests for the interpolated implied volatility surface
+ *
+ * Test Coverage:
+ * - Fitted nodes reproduced exactly and a smooth smile recovered between them
+ * - Flat extrapolation and NaN for invalid or unfitted lookups
+ * - Building from solver output and refitting only the changed expiries
+ * - Batch pricing with σ taken from the surface
+ * - Axis validation
+ */
+
+namespace {
+
+// Smooth smile with a term structure
+double smile(double K, double T) {
+    const double m = std::log(K / 100.0);
+    return 0.20 + 0.10 * m * m + 0.02 * std::sqrt(T);
+}
+
+// Surface on 60..140 with every slice fitted to smile() quoted at each integer strike
+VolatilitySurface fitted_surface(const std::vector<double>& expiries) {
+    std::vector<double> nodes;
+    for (double K = 60.0; K <= 140.0; K += 2.5) {
+        nodes.push_back(K);
+    }
+    VolatilitySurface surface(nodes, expiries);
+    std::vector<double> strikes;
+    std::vector<double> vols;
+    for (size_t slice = 0; slice < expiries.size(); ++slice) {
+        strikes.clear();
+        vols.clear();
+        for (double K = 60.0; K <= 140.0; K += 1.0) {
+            strikes.push_back(K);
+            vols.push_back(smile(K, expiries[slice]));
+        }
+        surface.fit_slice(slice, strikes.data(), vols.data(), strikes.size());
+    }
+    return surface;
+}
+
+// Option chain priced at smile() and solved back to implied volatilities
+struct SolvedChain {
+    std::vector<double> spot, strike, expiry, rate, price, iv;
+    std::vector<uint8_t> is_call;
+    std::vector<IVFailure> failure;
+    
+    explicit SolvedChain(double bump = 0.0, double bumped_expiry = 0.0) {
+        for (const double T : {0.25, 0.5, 1.0, 2.0}) {
+            for (double K = 70.0; K <= 130.0; K += 5.0) {
+                const double vol = smile(K, T) + (T == bumped_expiry ? bump : 0.0);
+                spot.push_back(100.0);
+                strike.push_back(K);
+                expiry.push_back(T);
+                rate.push_back(0.03);
+                is_call.push_back(K >= 100.0 ? 1 : 0);
+                const Parameters params(100.0, K, T, 0.03, vol, 0.0);
+                price.push_back(K >= 100.0 ? OptionPricer::price_call(params).price : OptionPricer::price_put(params).price);
+            }
+        }
+        iv.resize(price.size());
+        failure.resize(price.size());
+        ImpliedVolatilitySolver::solve_batch(input(), output());
+    }
+    
+    IVBatchInput input() const {
+        IVBatchInput in;
+        in.market_price = price.data();
+        in.spot_price = spot.data();
+        in.strike_price = strike.data();
+        in.time_to_expiry = expiry.data();
+        in.risk_free_rate = rate.data();
+        in.is_call = is_call.data();
+        in.count = price.size();
+        return in;
+    }
+    
+    IVBatchOutput output() { return IVBatchOutput{iv.data(), nullptr, failure.data()}; }
+};
+
+} // namespace
+
+// Test suite for the implied volatility surface
+TEST_SUITE(VolatilitySurfaceTests) {
+    auto suite = std::make_unique<TestSuite>("VolatilitySurface");
+    
+    // Lookups at a grid node return the fitted σ
+    suite->addTest("NodesReproduced", []() {
+        const std::vector<double> expiries = {0.25, 0.5, 1.0, 2.0};
+        VolatilitySurface surface = fitted_surface(expiries);
+        for (size_t slice = 0; slice < expiries.size(); ++slice) {
+            ASSERT_TRUE(surface.fitted(slice));
+            for (size_t i = 0; i < surface.strikes().size(); ++i) {
+                const double K = surface.strikes()[i];
+                ASSERT_NEAR(surface.node(slice, i), surface.volatility(K, expiries[slice]), 1e-14);
+                ASSERT_NEAR(smile(K, expiries[slice]), surface.node(slice, i), 1e-3);
+            }
+        }
+    });
+    
+    // Between nodes and slices the interpolant follows the smooth smile
+    suite->addTest("SmoothSmileAccuracy", []() {
+        VolatilitySurface surface = fitted_surface({0.25, 0.5, 1.0, 2.0});
+        for (const double T : {0.3, 0.75, 1.5}) {
+            for (double K = 61.3; K < 140.0; K += 3.7) {
+                ASSERT_NEAR(smile(K, T), surface.volatility(K, T), 2e-3);
+            }
+        }
+        
+        // The batch lookup matches the scalar one
+        std::vector<double> K = {80.0, 95.5, 101.0, 120.0, 80.0, 133.3};
+        std::vector<double> T = {0.75, 0.75, 0.75, 0.75, 1.5, 1.5};
+        std::vector<double> vols(K.size());
+        surface.volatility(K.data(), T.data(), vols.data(), K.size());
+        for (size_t i = 0; i < K.size(); ++i) {
+            ASSERT_EQ(surface.volatility(K[i], T[i]), vols[i]);
+        }
+    });
+    
+    // Flat beyond the grid; NaN for invalid inputs and unfitted slices
+    suite->addTest("ExtrapolationAndInvalid", []() {
+        VolatilitySurface surface = fitted_surface({0.5, 1.0});
+        ASSERT_NEAR(surface.volatility(60.0, 0.5), surface.volatility(40.0, 0.5), 1e-15);
+        ASSERT_NEAR(surface.volatility(140.0, 1.0), surface.volatility(200.0, 1.0), 1e-15);
+        ASSERT_NEAR(surface.volatility(100.0, 0.5), surface.volatility(100.0, 0.1), 1e-15);
+        ASSERT_NEAR(surface.volatility(100.0, 1.0), surface.volatility(100.0, 3.0), 1e-15);
+        
+        ASSERT_TRUE(std::isnan(surface.volatility(-1.0, 0.5)));
+        ASSERT_TRUE(std::isnan(surface.volatility(100.0, 0.0)));
+        ASSERT_TRUE(std::isnan(surface.volatility(100.0, std::nan(""))));
+        
+        ASSERT_TRUE(surface.fit_slice(1, nullptr, nullptr, 0));
+        ASSERT_FALSE(surface.fitted(1));
+        ASSERT_TRUE(std::isnan(surface.volatility(100.0, 0.75)));
+        ASSERT_TRUE(std::isfinite(surface.volatility(100.0, 0.4)));
+        
+        const double bad_strike = -5.0;
+        const double vol = 0.2;
+        ASSERT_FALSE(surface.fit_slice(0, &bad_strike, &vol, 1));
+        ASSERT_FALSE(surface.fit_slice(2, &vol, &vol, 1));
+    });
+    
+    // A surface built from solver output has a slice per expiry and recovers the smile
+    // (the quotes fall between strike nodes, so they are matched closely rather than exactly)
+    suite->addTest("BuildFromSolvedChain", []() {
+        SolvedChain chain;
+        VolatilitySurface surface = VolatilitySurface::build(chain.input(), chain.output());
+        ASSERT_EQ(4u, surface.expiries().size());
+        ASSERT_EQ(VolatilitySurface::DEFAULT_STRIKE_NODES, surface.strikes().size());
+        ASSERT_NEAR(70.0, surface.strikes().front(), 1e-12);
+        ASSERT_NEAR(130.0, surface.strikes().back(), 1e-12);
+        ASSERT_EQ(4u, surface.refits());
+        for (size_t i = 0; i < chain.price.size(); ++i) {
+            ASSERT_NEAR(chain.iv[i], surface.volatility(chain.strike[i], chain.expiry[i]), 1e-4);
+        }
+        ASSERT_NEAR(smile(97.5, 0.75), surface.volatility(97.5, 0.75), 2e-3);
+        
+        std::vector<IVFailure> failed(chain.price.size(), IVFailure::MAX_ITERATIONS);
+        IVBatchOutput none{chain.iv.data(), nullptr, failed.data()};
+        ASSERT_THROWS(VolatilitySurface::build(chain.input(), none), std::invalid_argument);
+    });
+    
+    // An update refits only the expiries it quotes
+    suite->addTest("IncrementalRefit", []() {
+        SolvedChain chain;
+        VolatilitySurface surface = VolatilitySurface::build(chain.input(), chain.output());
+        std::vector<double> before(surface.strikes().size() * 4);
+        for (size_t slice = 0; slice < 4; ++slice) {
+            for (size_t i = 0; i < surface.strikes().size(); ++i) {
+                before[slice * surface.strikes().size() + i] = surface.node(slice, i);
+            }
+        }
+        
+        // Only the 1y quotes move: pass just those rows
+        SolvedChain moved(0.05, 1.0);
+        const size_t per_expiry = moved.price.size() / 4;
+        IVBatchInput quotes = moved.input();
+        IVBatchOutput solved = moved.output();
+        quotes.market_price += 2 * per_expiry;
+        quotes.spot_price += 2 * per_expiry;
+        quotes.strike_price += 2 * per_expiry;
+        quotes.time_to_expiry += 2 * per_expiry;
+        quotes.risk_free_rate += 2 * per_expiry;
+        quotes.is_call += 2 * per_expiry;
+        quotes.count = per_expiry;
+        solved.implied_vol += 2 * per_expiry;
+        solved.failure += 2 * per_expiry;
+        
+        ASSERT_EQ(1u, surface.update(quotes, solved));
+        ASSERT_EQ(5u, surface.refits());
+        for (size_t slice = 0; slice < 4; ++slice) {
+            for (size_t i = 0; i < surface.strikes().size(); ++i) {
+                const double previous = before[slice * surface.strikes().size() + i];
+                if (slice == 2) {
+                    ASSERT_NEAR(previous + 0.05, surface.node(slice, i), 1e-6);
+                } else {
+                    ASSERT_EQ(previous, surface.node(slice, i));
+                }
+            }
+        }
+    });
+    
+    // Pricing from the surface equals pricing with its σ as a column
+    suite->addTest("BatchPricingFromSurface", []() {
+        VolatilitySurface surface = fitted_surface({0.25, 0.5, 1.0, 2.0});
+        const size_t n = 1000;
+        std::vector<double> S(n, 100.0), K(n), T(n), r(n, 0.03), vol(n);
+        std::vector<uint8_t> call(n);
+        for (size_t i = 0; i < n; ++i) {
+            K[i] = 55.0 + static_cast<double>(i % 91);
+            T[i] = 0.1 + 0.2 * static_cast<double>(i / 91);
+            call[i] = static_cast<uint8_t>(i % 2);
+        }
+        K[7] = -1.0;
+        surface.volatility(K.data(), T.data(), vol.data(), n);
+        
+        BatchInput in{S.data(), K.data(), T.data(), r.data(), vol.data(), nullptr, call.data(), n};
+        std::vector<double> price(n), delta(n), surface_price(n), surface_delta(n);
+        std::vector<uint32_t> status(n), surface_status(n);
+        BatchOutput expected;
+        expected.price = price.data();
+        expected.delta = delta.data();
+        expected.status = status.data();
+        BatchOutput actual;
+        actual.price = surface_price.data();
+        actual.delta = surface_delta.data();
+        actual.status = surface_status.data();
+        
+        const size_t priced = OptionPricer::price_batch(in, expected);
+        in.volatility = nullptr;
+        ASSERT_EQ(priced, OptionPricer::price_batch(in, surface, actual));
+        ASSERT_EQ(n - 1, priced);
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(status[i], surface_status[i]);
+            if (status[i] == BatchStatus::OK) {
+                ASSERT_EQ(price[i], surface_price[i]);
+                ASSERT_EQ(delta[i], surface_delta[i]);
+            }
+        }
+        ASSERT_TRUE((surface_status[7] & BatchStatus::INVALID_STRIKE) != 0);
+        
+        in.strike_price = nullptr;
+        ASSERT_EQ(0u, OptionPricer::price_batch(in, surface, actual));
+        ASSERT_TRUE((surface_status[0] & BatchStatus::MISSING_INPUT) != 0);
+    });
+    
+    // Axes must be long enough, positive and strictly increasing
+    suite->addTest("InvalidAxes", []() {
+        ASSERT_THROWS(VolatilitySurface({100.0}, {1.0}), std::invalid_argument);
+        ASSERT_THROWS(VolatilitySurface({90.0, 110.0}, {}), std::invalid_argument);
+        ASSERT_THROWS(VolatilitySurface({110.0, 90.0}, {1.0}), std::invalid_argument);
+        ASSERT_THROWS(VolatilitySurface({90.0, 110.0}, {1.0, 1.0}), std::invalid_argument);
+        ASSERT_THROWS(VolatilitySurface({-90.0, 110.0}, {1.0}), std::invalid_argument);
+        ASSERT_THROWS(VolatilitySurface({90.0, 110.0}, {0.5, std::nan("")}), std::invalid_argument);
+        ASSERT_NO_THROW(VolatilitySurface({90.0, 110.0}, {1.0}));
+    });
+    
+    TestRegistry::getInstance().registerSuite(std::move(suite));
+}